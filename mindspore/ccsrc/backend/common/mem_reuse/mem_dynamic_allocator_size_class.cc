@@ -0,0 +1,757 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "include/backend/mem_reuse/mem_dynamic_allocator_size_class.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The size classes are 512 bytes apart up to 4K, then there are 4 size classes for each power of 2 up to 128K.
+constexpr size_t kLinearSizeClassNum = 8;
+constexpr size_t kLinearSizeClassLimit = kLinearSizeClassNum * kDynamicMemAlignSize;
+constexpr size_t kLinearSizeClassLimitLog2 = 12;
+constexpr size_t kSizeClassNumPerPowerOf2 = 4;
+constexpr size_t kSizeClassNum = 28;
+// The arenas are allocated from the best fit pool, and are cut into slabs, each of which is cut into the memory bufs
+// of a size class.
+constexpr size_t kSlabSize = 1 << 20;
+constexpr size_t kArenaSize = 32 << 20;
+constexpr size_t kSlabNumPerArena = kArenaSize / kSlabSize;
+constexpr size_t kMaxArenaNum = 1024;
+// The idle memory of a size class cached by each thread, which is exchanged in halves with the list of the size class.
+constexpr size_t kThreadCacheSizePerClass = 1 << 20;
+constexpr size_t kMinThreadCacheNum = 2;
+constexpr size_t kCacheLineSize = 64;
+constexpr char kArenaAllocatorName[] = "SizeClassArena";
+
+struct Slab;
+struct Arena;
+
+// The header of a memory buf of a size class, which is kept in the host memory since the device memory may not be
+// accessible.
+struct MemBufHeader {
+  DeviceMemPtr device_addr_{nullptr};
+  Slab *slab_{nullptr};
+  // The next idle memory buf in a thread cache or in the list of the size class.
+  MemBufHeader *next_{nullptr};
+  size_t size_class_{0};
+  DynamicMemBufStatus status_{DynamicMemBufStatus::kMemBufIdle};
+  AllocatorType allocator_type_{AllocatorType::kOther};
+};
+
+struct Slab {
+  DeviceMemPtr device_addr_{nullptr};
+  size_t size_class_{0};
+  // The arena of the slab and its index in the arena.
+  Arena *arena_{nullptr};
+  size_t index_{0};
+  std::vector<MemBufHeader> headers_;
+};
+
+struct Arena {
+  explicit Arena(DeviceMemPtr device_addr) : device_addr_(device_addr) {
+    for (auto &slab : slabs_) {
+      slab.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  DeviceMemPtr device_addr_;
+  // The number of the slabs cut from the arena, and the indexes of the reclaimed ones, guarded by the grow mutex of
+  // the state.
+  size_t slab_num_{0};
+  std::vector<size_t> free_slab_indexes_;
+  // The slabs are published once they are cut, so that the memory bufs are found without lock when they are freed.
+  std::atomic<Slab *> slabs_[kSlabNumPerArena];
+
+  bool HasFreeSlab() const { return slab_num_ < kSlabNumPerArena || !free_slab_indexes_.empty(); }
+  bool IsIdle() const { return slab_num_ == free_slab_indexes_.size(); }
+};
+
+struct alignas(kCacheLineSize) SizeClassList {
+  std::mutex mutex_;
+  MemBufHeader *head_{nullptr};
+  // Written under the mutex, and read by the statistics.
+  std::atomic<size_t> idle_num_{0};
+  std::atomic<size_t> buf_num_{0};
+  std::atomic<size_t> slab_num_{0};
+};
+
+// The same alignment as the best fit pool, so that the memory bufs of the size classes are aligned.
+size_t AlignSize(size_t size) {
+  if (size == 0) {
+    return kDynamicMemAlignSize;
+  }
+  return ((size + kDynamicMemAlignSize - 1) / kDynamicMemAlignSize) * kDynamicMemAlignSize;
+}
+
+size_t ThreadCacheCapacity(size_t size_class) {
+  return std::max(kThreadCacheSizePerClass / DynamicMemPoolSizeClass::SizeOfClass(size_class), kMinThreadCacheNum);
+}
+}  // namespace
+
+struct ThreadCache {
+  ThreadCache(uint64_t state_id, const SizeClassStatePtr &state) : state_id_(state_id), state_(state) {
+    for (auto &idle_num : idle_nums_) {
+      idle_num.store(0, std::memory_order_relaxed);
+    }
+  }
+  uint64_t state_id_;
+  std::weak_ptr<SizeClassState> state_;
+  MemBufHeader *heads_[kSizeClassNum] = {nullptr};
+  // Only written by the owner thread, and read by the statistics.
+  std::atomic<size_t> idle_nums_[kSizeClassNum];
+};
+
+struct SizeClassState {
+  SizeClassState() : id_(NextId()) {}
+
+  static uint64_t NextId() {
+    static std::atomic<uint64_t> next_id{0};
+    return ++next_id;
+  }
+
+  // Push the idle memory bufs linked from head to tail to the list of the size class.
+  void PushIdleMemBufs(size_t size_class, MemBufHeader *head, MemBufHeader *tail, size_t num) {
+    auto &list = lists_[size_class];
+    std::lock_guard<std::mutex> locker(list.mutex_);
+    tail->next_ = list.head_;
+    list.head_ = head;
+    list.idle_num_.store(list.idle_num_.load(std::memory_order_relaxed) + num, std::memory_order_relaxed);
+  }
+
+  // Pop at most max_num idle memory bufs from the list of the size class, return the number of them.
+  size_t PopIdleMemBufs(size_t size_class, size_t max_num, MemBufHeader **head) {
+    auto &list = lists_[size_class];
+    std::lock_guard<std::mutex> locker(list.mutex_);
+    if (list.head_ == nullptr) {
+      return 0;
+    }
+    *head = list.head_;
+    MemBufHeader *tail = list.head_;
+    size_t num = 1;
+    while (num < max_num && tail->next_ != nullptr) {
+      tail = tail->next_;
+      ++num;
+    }
+    list.head_ = tail->next_;
+    tail->next_ = nullptr;
+    list.idle_num_.store(list.idle_num_.load(std::memory_order_relaxed) - num, std::memory_order_relaxed);
+    return num;
+  }
+
+  // Find the header of a memory buf of the size classes by its device address, return nullptr if the memory buf is
+  // not cut from the slabs.
+  MemBufHeader *FindMemBuf(const DeviceMemPtr &device_addr) const {
+    auto addr = static_cast<const uint8_t *>(device_addr);
+    // The memory bufs of the best fit pool out of the range of the arenas are rejected without lock.
+    auto addr_value = reinterpret_cast<uintptr_t>(addr);
+    if (addr_value < arenas_begin_.load(std::memory_order_acquire) ||
+        addr_value >= arenas_end_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    const Arena *arena = nullptr;
+    const uint8_t *arena_addr = nullptr;
+    {
+      // The arena may be released once the lock is dropped, unless the memory buf is cut from it.
+      std::shared_lock<std::shared_mutex> locker(arena_index_mutex_);
+      auto iter = arena_index_.upper_bound(addr);
+      if (iter == arena_index_.begin()) {
+        return nullptr;
+      }
+      arena_addr = std::prev(iter)->first;
+      if (addr >= arena_addr + kArenaSize) {
+        return nullptr;
+      }
+      arena = std::prev(iter)->second;
+    }
+    auto slab_index = static_cast<size_t>(addr - arena_addr) / kSlabSize;
+    auto slab = arena->slabs_[slab_index].load(std::memory_order_acquire);
+    if (slab == nullptr) {
+      return nullptr;
+    }
+    auto offset = static_cast<size_t>(addr - static_cast<const uint8_t *>(slab->device_addr_));
+    auto index = offset / DynamicMemPoolSizeClass::SizeOfClass(slab->size_class_);
+    if (index >= slab->headers_.size() || slab->headers_[index].device_addr_ != device_addr) {
+      return nullptr;
+    }
+    return const_cast<MemBufHeader *>(&slab->headers_[index]);
+  }
+
+  // Index the arena by its device address, called with the grow mutex held.
+  void IndexArena(const Arena *arena) {
+    auto arena_addr = static_cast<const uint8_t *>(arena->device_addr_);
+    {
+      std::unique_lock<std::shared_mutex> locker(arena_index_mutex_);
+      (void)arena_index_.emplace(arena_addr, arena);
+    }
+    auto begin = reinterpret_cast<uintptr_t>(arena_addr);
+    auto end = begin + kArenaSize;
+    if (begin < arenas_begin_.load(std::memory_order_relaxed)) {
+      arenas_begin_.store(begin, std::memory_order_release);
+    }
+    if (end > arenas_end_.load(std::memory_order_relaxed)) {
+      arenas_end_.store(end, std::memory_order_release);
+    }
+  }
+
+  // Remove the arena from the index before it is released, called with the grow mutex held.
+  void UnindexArena(const Arena *arena) {
+    std::unique_lock<std::shared_mutex> locker(arena_index_mutex_);
+    (void)arena_index_.erase(static_cast<const uint8_t *>(arena->device_addr_));
+  }
+
+  // Take back the slabs whose memory bufs are all idle in the lists of the size classes, so that they are cut again
+  // for any size class. The idle memory bufs in the thread caches keep their slabs. Called with the grow mutex held,
+  // return the number of the reclaimed slabs.
+  size_t ReclaimIdleSlabs() {
+    size_t reclaimed_num = 0;
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      auto &list = lists_[i];
+      if (list.slab_num_.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      std::unordered_set<Slab *> idle_slabs;
+      {
+        std::lock_guard<std::mutex> locker(list.mutex_);
+        std::unordered_map<Slab *, size_t> idle_nums;
+        for (auto header = list.head_; header != nullptr; header = header->next_) {
+          if (++idle_nums[header->slab_] == header->slab_->headers_.size()) {
+            (void)idle_slabs.insert(header->slab_);
+          }
+        }
+        if (idle_slabs.empty()) {
+          continue;
+        }
+        size_t removed_num = 0;
+        for (auto link = &list.head_; *link != nullptr;) {
+          if (idle_slabs.count((*link)->slab_) > 0) {
+            *link = (*link)->next_;
+            ++removed_num;
+          } else {
+            link = &(*link)->next_;
+          }
+        }
+        list.idle_num_.store(list.idle_num_.load(std::memory_order_relaxed) - removed_num, std::memory_order_relaxed);
+        (void)list.buf_num_.fetch_sub(removed_num, std::memory_order_relaxed);
+        (void)list.slab_num_.fetch_sub(idle_slabs.size(), std::memory_order_relaxed);
+      }
+      for (auto slab : idle_slabs) {
+        slab->arena_->slabs_[slab->index_].store(nullptr, std::memory_order_release);
+        slab->arena_->free_slab_indexes_.push_back(slab->index_);
+        free_slabs_.push_back(slab);
+      }
+      (void)uncut_size_.fetch_add(idle_slabs.size() * kSlabSize, std::memory_order_relaxed);
+      reclaimed_num += idle_slabs.size();
+    }
+    return reclaimed_num;
+  }
+
+  // The arena which has a slab to cut, called with the grow mutex held.
+  Arena *FindArenaWithFreeSlab() const {
+    size_t arena_num = arena_num_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < arena_num; ++i) {
+      if (arenas_[i] != nullptr && arenas_[i]->HasFreeSlab()) {
+        return arenas_[i].get();
+      }
+    }
+    return nullptr;
+  }
+
+  // The idle memory of the size classes, including the memory of the arenas not cut into slabs yet and the tails of
+  // the slabs.
+  size_t IdleMemSize() {
+    size_t idle_size = uncut_size_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      auto buf_size = DynamicMemPoolSizeClass::SizeOfClass(i);
+      idle_size += lists_[i].slab_num_.load(std::memory_order_relaxed) * (kSlabSize % buf_size);
+      idle_size += IdleMemBufNum(i) * buf_size;
+    }
+    return idle_size;
+  }
+
+  size_t IdleMemBufNum(size_t size_class) {
+    size_t idle_num = lists_[size_class].idle_num_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> locker(caches_mutex_);
+    for (auto cache : caches_) {
+      idle_num += cache->idle_nums_[size_class].load(std::memory_order_relaxed);
+    }
+    return idle_num;
+  }
+
+  uint64_t id_;
+  SizeClassList lists_[kSizeClassNum];
+
+  // Guard the growth of the arenas and slabs.
+  std::mutex grow_mutex_;
+  std::unique_ptr<Arena> arenas_[kMaxArenaNum];
+  std::atomic<size_t> arena_num_{0};
+  // The arenas ordered by their device addresses, and the address range covering them.
+  mutable std::shared_mutex arena_index_mutex_;
+  std::map<const uint8_t *, const Arena *> arena_index_;
+  std::atomic<uintptr_t> arenas_begin_{UINTPTR_MAX};
+  std::atomic<uintptr_t> arenas_end_{0};
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  // The reclaimed slabs, whose host memory is reused for the slabs cut later.
+  std::vector<Slab *> free_slabs_;
+  std::atomic<size_t> uncut_size_{0};
+
+  // The thread caches of this state, for the statistics.
+  std::mutex caches_mutex_;
+  std::vector<ThreadCache *> caches_;
+};
+
+namespace {
+// The thread caches of the memory pools used by a thread, which return their idle memory bufs to the pools when the
+// thread exits.
+class ThreadCaches {
+ public:
+  ThreadCaches() = default;
+  ~ThreadCaches() {
+    destroyed_ = true;
+    for (auto &cache : caches_) {
+      Release(cache.get());
+    }
+  }
+
+  ThreadCache *Get(const SizeClassStatePtr &state) {
+    if (destroyed_) {
+      return nullptr;
+    }
+    if (last_ != nullptr && last_->state_id_ == state->id_) {
+      return last_;
+    }
+    for (auto &cache : caches_) {
+      if (cache->state_id_ == state->id_) {
+        last_ = cache.get();
+        return last_;
+      }
+    }
+    // The caches of the released states are dropped, their memory bufs are released with the states.
+    auto expired = [](const std::unique_ptr<ThreadCache> &cache) { return cache->state_.expired(); };
+    (void)caches_.erase(std::remove_if(caches_.begin(), caches_.end(), expired), caches_.end());
+    auto cache = std::make_unique<ThreadCache>(state->id_, state);
+    {
+      std::lock_guard<std::mutex> locker(state->caches_mutex_);
+      state->caches_.push_back(cache.get());
+    }
+    last_ = cache.get();
+    caches_.push_back(std::move(cache));
+    return last_;
+  }
+
+  static bool destroyed() { return destroyed_; }
+
+ private:
+  static void Release(ThreadCache *cache) {
+    auto state = cache->state_.lock();
+    if (state == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      auto head = cache->heads_[i];
+      if (head == nullptr) {
+        continue;
+      }
+      auto tail = head;
+      while (tail->next_ != nullptr) {
+        tail = tail->next_;
+      }
+      state->PushIdleMemBufs(i, head, tail, cache->idle_nums_[i].load(std::memory_order_relaxed));
+      cache->heads_[i] = nullptr;
+      cache->idle_nums_[i].store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> locker(state->caches_mutex_);
+    (void)state->caches_.erase(std::remove(state->caches_.begin(), state->caches_.end(), cache), state->caches_.end());
+  }
+
+  std::vector<std::unique_ptr<ThreadCache>> caches_;
+  ThreadCache *last_{nullptr};
+  // The memory bufs freed after the caches are destroyed at the exit of the thread go to the lists directly.
+  static thread_local bool destroyed_;
+};
+
+thread_local bool ThreadCaches::destroyed_ = false;
+thread_local ThreadCaches thread_caches;
+
+// Allocate an arena from the best fit pool, called with the grow mutex held.
+Arena *AddArena(DynamicMemPoolBestFit *best_fit_pool, const SizeClassStatePtr &state) {
+  size_t arena_num = state->arena_num_.load(std::memory_order_relaxed);
+  // The slot of a released arena is reused first.
+  size_t index = 0;
+  while (index < arena_num && state->arenas_[index] != nullptr) {
+    ++index;
+  }
+  if (index == kMaxArenaNum) {
+    MS_LOG(WARNING) << "The number of arenas of the size classes reaches the limit " << kMaxArenaNum << ".";
+    return nullptr;
+  }
+  // The arena is allocated from the best fit pool on behalf of the size classes.
+  auto debug_info = DynamicMemAllocatorDebugInfo::GetDebugInfo();
+  DynamicMemAllocatorDebugInfo::SetDebugInfo(kArenaAllocatorName, AllocatorType::kOther);
+  auto device_addr = best_fit_pool->AllocTensorMem(kArenaSize, false);
+  DynamicMemAllocatorDebugInfo::SetDebugInfo(debug_info.name_, debug_info.type_, debug_info.input_index_,
+                                             debug_info.output_index_);
+  if (device_addr == nullptr) {
+    return nullptr;
+  }
+  state->arenas_[index] = std::make_unique<Arena>(device_addr);
+  state->IndexArena(state->arenas_[index].get());
+  if (index == arena_num) {
+    state->arena_num_.store(arena_num + 1, std::memory_order_release);
+  }
+  (void)state->uncut_size_.fetch_add(kArenaSize, std::memory_order_relaxed);
+  return state->arenas_[index].get();
+}
+
+MemBufHeader *PopFromCache(ThreadCache *cache, size_t size_class) {
+  auto header = cache->heads_[size_class];
+  if (header != nullptr) {
+    cache->heads_[size_class] = header->next_;
+    header->next_ = nullptr;
+    cache->idle_nums_[size_class].store(cache->idle_nums_[size_class].load(std::memory_order_relaxed) - 1,
+                                        std::memory_order_relaxed);
+  }
+  return header;
+}
+
+void PushToCache(ThreadCache *cache, MemBufHeader *header) {
+  auto size_class = header->size_class_;
+  header->next_ = cache->heads_[size_class];
+  cache->heads_[size_class] = header;
+  cache->idle_nums_[size_class].store(cache->idle_nums_[size_class].load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
+}
+}  // namespace
+
+DynamicMemPoolSizeClass::DynamicMemPoolSizeClass(DynamicMemPoolBestFit *best_fit_pool)
+    : best_fit_pool_(best_fit_pool), state_(std::make_shared<SizeClassState>()) {
+  MS_EXCEPTION_IF_NULL(best_fit_pool_);
+}
+
+DynamicMemPoolSizeClass::~DynamicMemPoolSizeClass() = default;
+
+size_t DynamicMemPoolSizeClass::SizeClassNum() { return kSizeClassNum; }
+
+size_t DynamicMemPoolSizeClass::SizeOfClass(size_t size_class) {
+  if (size_class < kLinearSizeClassNum) {
+    return (size_class + 1) * kDynamicMemAlignSize;
+  }
+  size_t power_of_2 = (size_class - kLinearSizeClassNum) / kSizeClassNumPerPowerOf2;
+  size_t step = (size_class - kLinearSizeClassNum) % kSizeClassNumPerPowerOf2 + 1;
+  size_t base = kLinearSizeClassLimit << power_of_2;
+  return base + base / kSizeClassNumPerPowerOf2 * step;
+}
+
+size_t DynamicMemPoolSizeClass::SizeClassOf(size_t align_size) {
+  if (align_size == 0 || align_size > kMaxSizeClassMemSize) {
+    return kNoSizeClass;
+  }
+  if (align_size <= kLinearSizeClassLimit) {
+    return (align_size - 1) / kDynamicMemAlignSize;
+  }
+  // The largest power of 2 less than the size.
+  size_t log2 = kLinearSizeClassLimitLog2;
+  while ((static_cast<size_t>(1) << (log2 + 1)) < align_size) {
+    ++log2;
+  }
+  size_t base = static_cast<size_t>(1) << log2;
+  size_t step_size = base / kSizeClassNumPerPowerOf2;
+  size_t step = (align_size - base + step_size - 1) / step_size;
+  return kLinearSizeClassNum + (log2 - kLinearSizeClassLimitLog2) * kSizeClassNumPerPowerOf2 + step - 1;
+}
+
+bool DynamicMemPoolSizeClass::AddSlab(const SizeClassStatePtr &state, size_t size_class) {
+  std::lock_guard<std::mutex> locker(state->grow_mutex_);
+  // Another thread may have added a slab meanwhile.
+  if (state->lists_[size_class].idle_num_.load(std::memory_order_relaxed) > 0) {
+    return true;
+  }
+  // The idle slabs of the other size classes are reused before a new arena is allocated.
+  auto arena = state->FindArenaWithFreeSlab();
+  if (arena == nullptr && state->ReclaimIdleSlabs() > 0) {
+    arena = state->FindArenaWithFreeSlab();
+  }
+  if (arena == nullptr) {
+    arena = AddArena(best_fit_pool_, state);
+    if (arena == nullptr) {
+      return false;
+    }
+  }
+  size_t slab_index = arena->slab_num_;
+  if (arena->free_slab_indexes_.empty()) {
+    ++arena->slab_num_;
+  } else {
+    slab_index = arena->free_slab_indexes_.back();
+    arena->free_slab_indexes_.pop_back();
+  }
+  Slab *slab = nullptr;
+  if (state->free_slabs_.empty()) {
+    state->slabs_.push_back(std::make_unique<Slab>());
+    slab = state->slabs_.back().get();
+  } else {
+    slab = state->free_slabs_.back();
+    state->free_slabs_.pop_back();
+  }
+  slab->device_addr_ = AddressOffset(arena->device_addr_, slab_index * kSlabSize);
+  slab->size_class_ = size_class;
+  slab->arena_ = arena;
+  slab->index_ = slab_index;
+  size_t buf_size = SizeOfClass(size_class);
+  size_t buf_num = kSlabSize / buf_size;
+  slab->headers_.assign(buf_num, MemBufHeader());
+  for (size_t i = 0; i < buf_num; ++i) {
+    auto &header = slab->headers_[i];
+    header.device_addr_ = AddressOffset(slab->device_addr_, i * buf_size);
+    header.slab_ = slab;
+    header.size_class_ = size_class;
+    header.next_ = i + 1 < buf_num ? &slab->headers_[i + 1] : nullptr;
+  }
+  auto head = &slab->headers_.front();
+  auto tail = &slab->headers_.back();
+  arena->slabs_[slab_index].store(slab, std::memory_order_release);
+  (void)state->uncut_size_.fetch_sub(kSlabSize, std::memory_order_relaxed);
+  auto &list = state->lists_[size_class];
+  (void)list.buf_num_.fetch_add(buf_num, std::memory_order_relaxed);
+  (void)list.slab_num_.fetch_add(1, std::memory_order_relaxed);
+  state->PushIdleMemBufs(size_class, head, tail, buf_num);
+  return true;
+}
+
+size_t DynamicMemPoolSizeClass::ReleaseIdleArenas() {
+  auto state = std::atomic_load(&state_);
+  if (state == nullptr) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> locker(state->grow_mutex_);
+  (void)state->ReclaimIdleSlabs();
+  size_t released_size = 0;
+  size_t arena_num = state->arena_num_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < arena_num; ++i) {
+    auto &arena = state->arenas_[i];
+    if (arena == nullptr || !arena->IsIdle()) {
+      continue;
+    }
+    state->UnindexArena(arena.get());
+    best_fit_pool_->FreeTensorMem(arena->device_addr_);
+    (void)state->uncut_size_.fetch_sub(kArenaSize, std::memory_order_relaxed);
+    arena.reset();
+    released_size += kArenaSize;
+  }
+  return released_size;
+}
+
+DeviceMemPtr DynamicMemPoolSizeClass::AllocTensorMem(size_t size, bool from_persistent_mem) {
+  size_t size_class = from_persistent_mem ? kNoSizeClass : SizeClassOf(AlignSize(size));
+  if (size_class == kNoSizeClass) {
+    auto device_addr = best_fit_pool_->AllocTensorMem(size, from_persistent_mem);
+    // The idle arenas are given back to the best fit pool for the large memory bufs.
+    if (device_addr == nullptr && ReleaseIdleArenas() > 0) {
+      device_addr = best_fit_pool_->AllocTensorMem(size, from_persistent_mem);
+    }
+    return device_addr;
+  }
+  // The state is held until the memory buf is taken, in case the device memory is released meanwhile.
+  auto state = std::atomic_load(&state_);
+  MS_EXCEPTION_IF_NULL(state);
+  auto cache = thread_caches.Get(state);
+  MemBufHeader *header = nullptr;
+  while (header == nullptr) {
+    if (cache != nullptr) {
+      header = PopFromCache(cache, size_class);
+      if (header != nullptr) {
+        break;
+      }
+      // Refill half of the thread cache from the list of the size class.
+      MemBufHeader *head = nullptr;
+      size_t num = state->PopIdleMemBufs(size_class, ThreadCacheCapacity(size_class) / 2, &head);
+      if (num > 0) {
+        cache->heads_[size_class] = head;
+        cache->idle_nums_[size_class].store(num, std::memory_order_relaxed);
+        continue;
+      }
+    } else if (state->PopIdleMemBufs(size_class, 1, &header) > 0) {
+      break;
+    }
+    if (!AddSlab(state, size_class)) {
+      // Try the best fit pool when the arena can not be allocated.
+      return best_fit_pool_->AllocTensorMem(size, from_persistent_mem);
+    }
+  }
+  if (header->status_ != DynamicMemBufStatus::kMemBufIdle) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "Find the mem_buf is not idle, alloc_size[" << size << "] mem_buf_size["
+                      << SizeOfClass(size_class) << "] mem_buf_address[" << header->device_addr_ << "].";
+  }
+  header->status_ = DynamicMemBufStatus::kMemBufUsed;
+  header->allocator_type_ = DynamicMemAllocatorDebugInfo::GetDebugInfo().type_;
+  return header->device_addr_;
+}
+
+void DynamicMemPoolSizeClass::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  MS_EXCEPTION_IF_NULL(device_addr);
+  auto state = std::atomic_load(&state_);
+  auto header = state == nullptr ? nullptr : state->FindMemBuf(device_addr);
+  if (header == nullptr) {
+    best_fit_pool_->FreeTensorMem(device_addr);
+    return;
+  }
+  if (header->status_ != DynamicMemBufStatus::kMemBufUsed) {
+    DumpDynamicMemPoolDebugInfo();
+    MS_LOG(EXCEPTION) << "Find the mem_buf is not used, mem_buf_address[" << header->device_addr_ << "].";
+  }
+  header->status_ = DynamicMemBufStatus::kMemBufIdle;
+  auto cache = thread_caches.Get(state);
+  if (cache == nullptr) {
+    state->PushIdleMemBufs(header->size_class_, header, header, 1);
+    return;
+  }
+  auto size_class = header->size_class_;
+  PushToCache(cache, header);
+  // Return half of the thread cache to the list of the size class when it is full.
+  size_t capacity = ThreadCacheCapacity(size_class);
+  size_t idle_num = cache->idle_nums_[size_class].load(std::memory_order_relaxed);
+  if (idle_num > capacity) {
+    size_t num = idle_num / 2;
+    auto head = cache->heads_[size_class];
+    auto tail = head;
+    for (size_t i = 1; i < num; ++i) {
+      tail = tail->next_;
+    }
+    cache->heads_[size_class] = tail->next_;
+    cache->idle_nums_[size_class].store(idle_num - num, std::memory_order_relaxed);
+    state->PushIdleMemBufs(size_class, head, tail, num);
+  }
+}
+
+void DynamicMemPoolSizeClass::ReleaseDeviceRes() {
+  // The thread caches of the old state are dropped with it.
+  std::atomic_store(&state_, std::make_shared<SizeClassState>());
+  best_fit_pool_->ReleaseDeviceRes();
+}
+
+size_t DynamicMemPoolSizeClass::TotalMemStatistics() const { return best_fit_pool_->TotalMemStatistics(); }
+
+size_t DynamicMemPoolSizeClass::TotalUsedMemStatistics() const {
+  // The arenas are used memory of the best fit pool.
+  size_t used_size = best_fit_pool_->TotalUsedMemStatistics();
+  auto state = std::atomic_load(&state_);
+  size_t idle_size = state == nullptr ? 0 : state->IdleMemSize();
+  return used_size > idle_size ? used_size - idle_size : 0;
+}
+
+size_t DynamicMemPoolSizeClass::UsedMemPeakStatistics() const {
+  // The peak of the best fit pool, in which the arenas are used as a whole.
+  return best_fit_pool_->UsedMemPeakStatistics();
+}
+
+void DynamicMemPoolSizeClass::DumpDynamicMemPoolStateInfo() {
+  best_fit_pool_->DumpDynamicMemPoolStateInfo();
+  auto state = std::atomic_load(&state_);
+  if (state == nullptr) {
+    return;
+  }
+  std::ostringstream buf;
+  for (size_t i = 0; i < kSizeClassNum; ++i) {
+    size_t buf_num = state->lists_[i].buf_num_.load(std::memory_order_relaxed);
+    if (buf_num == 0) {
+      continue;
+    }
+    buf << ", size class[" << SizeOfClass(i) << "] slab counts:" << state->lists_[i].slab_num_
+        << " mem_buf counts:" << buf_num << " idle counts:" << state->IdleMemBufNum(i);
+  }
+  size_t arena_num = 0;
+  {
+    std::lock_guard<std::mutex> locker(state->grow_mutex_);
+    for (size_t i = 0; i < state->arena_num_.load(std::memory_order_relaxed); ++i) {
+      arena_num += state->arenas_[i] != nullptr ? 1 : 0;
+    }
+  }
+  MS_LOG(INFO) << "Size class pool info: arena counts:" << arena_num
+               << ", arena size:" << kArenaSize / kMBToByte << "M, uncut size:" << state->uncut_size_ / kMBToByte
+               << "M, in used mem:" << TotalUsedMemStatistics() / kMBToByte << "M" << buf.str();
+}
+
+void DynamicMemPoolSizeClass::DumpDynamicMemPoolDebugInfo() {
+  best_fit_pool_->DumpDynamicMemPoolDebugInfo();
+  auto state = std::atomic_load(&state_);
+  if (state == nullptr) {
+    return;
+  }
+  MS_LOG(WARNING) << "Start dump size class memory pool debug info.";
+  // The grow mutex keeps the arenas from being released while their slabs are walked.
+  std::lock_guard<std::mutex> locker(state->grow_mutex_);
+  std::vector<const Slab *> slabs;
+  size_t arena_num = state->arena_num_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < arena_num; ++i) {
+    if (state->arenas_[i] == nullptr) {
+      continue;
+    }
+    for (const auto &slab_ptr : state->arenas_[i]->slabs_) {
+      auto slab = slab_ptr.load(std::memory_order_acquire);
+      if (slab != nullptr) {
+        slabs.push_back(slab);
+      }
+    }
+  }
+  for (size_t i = 0; i < kSizeClassNum; ++i) {
+    auto &list = state->lists_[i];
+    size_t buf_num = list.buf_num_.load(std::memory_order_relaxed);
+    if (buf_num == 0) {
+      continue;
+    }
+    size_t used_size_list[kAllocatorTypeNum] = {0};
+    size_t used_num = 0;
+    for (const auto slab : slabs) {
+      if (slab->size_class_ != i) {
+        continue;
+      }
+      for (const auto &header : slab->headers_) {
+        if (header.status_ == DynamicMemBufStatus::kMemBufUsed) {
+          ++used_num;
+          used_size_list[static_cast<int>(header.allocator_type_)] += SizeOfClass(i);
+        }
+      }
+    }
+    size_t idle_num = state->IdleMemBufNum(i);
+    MS_LOG(WARNING) << " Size class info: size[" << SizeOfClass(i) << "] slab_counts[" << list.slab_num_
+                    << "] mem_buf_counts[" << buf_num << "] used_counts[" << used_num << "] idle_counts[" << idle_num
+                    << "] weight_used_size[" << used_size_list[static_cast<int>(AllocatorType::kWeight)]
+                    << "] constant_value_used_size[" << used_size_list[static_cast<int>(AllocatorType::kConstantValue)]
+                    << "] kernel_output_used_size[" << used_size_list[static_cast<int>(AllocatorType::kKernelOutput)]
+                    << "] other_used_size[" << used_size_list[static_cast<int>(AllocatorType::kOther)] << "].";
+    if (used_num + idle_num != buf_num) {
+      MS_LOG(ERROR) << "Check error: the number of the used and idle memory bufs of size class " << SizeOfClass(i)
+                    << " is not equal to the number of all the memory bufs.";
+    }
+  }
+  MS_LOG(WARNING) << "Finish dump size class memory pool debug info.";
+}
+}  // namespace device
+}  // namespace mindspore
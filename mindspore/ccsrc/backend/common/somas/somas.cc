@@ -21,6 +21,7 @@
 #include <memory>
 #include <numeric>
 #include <set>
+#include <sstream>
 #include <random>
 
 #include "backend/common/somas/somas_node.h"
@@ -34,6 +35,7 @@
 #include "debug/rdr/string_recorder.h"
 #endif
 #include "include/common/thread_pool.h"
+#include "utils/hashing.h"
 #ifndef ENABLE_SECURITY
 #include "plugin/device/ascend/hal/profiler/memory_profiling.h"
 
@@ -68,6 +70,10 @@ constexpr auto kLifeStart = "life_start";
 constexpr auto kLifeEnd = "life_end";
 constexpr auto kOffset = "offset";
 constexpr auto kCachedResultThreshold = 2000;
+constexpr auto kTensorKey = "tensor_key";
+constexpr auto kLowerBound = "lower_bound";
+// The gap between the warm start result and the lower bound may exceed the previous one by this ratio of lower bound.
+constexpr auto kWarmStartGapSlack = 0.01;
 constexpr size_t kLogMergedBlockSize = 10;
 
 // set somas result
@@ -201,6 +207,17 @@ bool Somas::GetEnableCacheFlag(const session::KernelGraph &graph) const {
   return graph.execution_order().size() >= kCachedResultThreshold;
 }
 
+size_t Somas::GetTimelineSolverBudget() const {
+  static const auto budget_str = common::GetEnv("MS_DEV_SOMAS_TIMELINE_SOLVER");
+  size_t budget = 0;
+  if (!budget_str.empty()) {
+    std::stringstream stream;
+    stream << budget_str;
+    stream >> budget;
+  }
+  return budget;
+}
+
 std::pair<bool, std::string> Somas::GetDebugConfig() const {
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
@@ -305,6 +322,156 @@ void Somas::SaveSomasResult(const session::KernelGraph &graph) {
   std::string filename = Common::GetCompilerCachePath() + "/somas_meta/somas_graph_" +
                          std::to_string(graph.graph_id()) + "_" + hash_id_ + ".json";
   (void)Common::SaveStringToFile(filename, somas_json.dump());
+  SaveSomasWarmStartInfo(graph);
+}
+
+std::vector<std::string> Somas::GetTensorKeys() const {
+  // The tensors are identified by their source nodes and indexes, which are kept when the graph is recompiled.
+  std::vector<std::string> tensor_keys(tensors_list_.size());
+  auto set_keys = [&tensor_keys](const std::string &prefix, const std::vector<SomasTensorPtr> &tensors) {
+    for (size_t i = 0; i < tensors.size(); i++) {
+      MS_EXCEPTION_IF_NULL(tensors[i]);
+      if (tensors[i]->GetId() < tensor_keys.size()) {
+        tensor_keys[tensors[i]->GetId()] = prefix + std::to_string(i);
+      }
+    }
+  };
+  for (const auto &node : nodes_list_) {
+    MS_EXCEPTION_IF_NULL(node);
+    set_keys(node->scope_full_name_ + ":output:", node->output_tensors_);
+    set_keys(node->scope_full_name_ + ":workspace:", node->workspace_tensors_);
+  }
+  return tensor_keys;
+}
+
+std::string Somas::CalcWarmStartKey() const {
+  // The key covers the tensors and the contiguous ones but neither their sizes nor the reuse constraints, which are
+  // checked by WarmStartSolving, so the graph recompiled with other shapes or another execution order finds its
+  // previous solution, while another graph of the same graph id does not.
+  size_t hash_sum = 0;
+  for (const auto &key : GetTensorKeys()) {
+    hash_sum = hash_combine(hash_sum, std::hash<std::string>()(key));
+  }
+  for (const auto &contiguous_tensors : processed_contiguous_tensors_list_) {
+    hash_sum = hash_combine(hash_sum, contiguous_tensors.size());
+    for (auto id : contiguous_tensors) {
+      hash_sum = hash_combine(hash_sum, id);
+    }
+  }
+  return std::to_string(hash_sum);
+}
+
+void Somas::SaveSomasWarmStartInfo(const session::KernelGraph &graph) const {
+  if (warm_start_key_.empty()) {
+    return;
+  }
+  auto tensor_keys = GetTensorKeys();
+  nlohmann::json somas_json;
+  somas_json[kGraphId] = graph.graph_id();
+  somas_json[kReused_memory_size] = reused_memory_size_;
+  somas_json[kLowerBound] = CalcLowerBound();
+  std::vector<nlohmann::json> tensors_json;
+  for (const auto &pairT : solver_tensor_desc_map_) {
+    auto &tensor = pairT.second;
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->index_ >= tensor_keys.size() || tensor_keys[tensor->index_].empty()) {
+      continue;
+    }
+    nlohmann::json tensor_json;
+    tensor_json[kTensorKey] = tensor_keys[tensor->index_];
+    tensor_json[kSize] = tensor->size_;
+    tensor_json[kOffset] = tensor->offset_;
+    tensors_json.emplace_back(tensor_json);
+  }
+  somas_json[kTensors] = tensors_json;
+  std::string filename =
+    Common::GetCompilerCachePath() + "/somas_meta/somas_warm_start_" + warm_start_key_ + ".json";
+  (void)Common::SaveStringToFile(filename, somas_json.dump());
+}
+
+bool Somas::LoadSomasWarmStartInfo(const session::KernelGraph &graph, std::map<size_t, size_t> *prev_offsets,
+                                   int64_t *prev_gap) const {
+  MS_EXCEPTION_IF_NULL(prev_offsets);
+  MS_EXCEPTION_IF_NULL(prev_gap);
+  std::string filename =
+    Common::GetCompilerCachePath() + "/somas_meta/somas_warm_start_" + warm_start_key_ + ".json";
+  std::ifstream somas_json_fs(filename);
+  if (!somas_json_fs.is_open()) {
+    MS_LOG(INFO) << "Open json file: " << filename << " error, no previous Somas solution to warm start.";
+    return false;
+  }
+  nlohmann::json somas_json;
+  try {
+    somas_json_fs >> somas_json;
+    somas_json_fs.close();
+    // The tensors of the same key are ambiguous, and are solved again.
+    std::map<std::string, size_t> key_to_id;
+    auto tensor_keys = GetTensorKeys();
+    for (size_t i = 0; i < tensor_keys.size(); i++) {
+      if (tensor_keys[i].empty()) {
+        continue;
+      }
+      auto ret = key_to_id.emplace(tensor_keys[i], i);
+      if (!ret.second) {
+        ret.first->second = SIZE_MAX;
+      }
+    }
+    for (const auto &tensor_json : somas_json[kTensors]) {
+      auto iter = key_to_id.find(tensor_json[kTensorKey].get<std::string>());
+      if (iter == key_to_id.end() || iter->second == SIZE_MAX) {
+        continue;
+      }
+      auto desc_iter = solver_tensor_desc_map_.find(iter->second);
+      if (desc_iter != solver_tensor_desc_map_.end() && desc_iter->second->size_ == tensor_json[kSize].get<size_t>()) {
+        (*prev_offsets)[iter->second] = tensor_json[kOffset].get<size_t>();
+      }
+    }
+    *prev_gap = static_cast<int64_t>(somas_json[kReused_memory_size].get<size_t>()) -
+                static_cast<int64_t>(somas_json[kLowerBound].get<size_t>());
+  } catch (std::exception &e) {
+    MS_LOG(INFO) << "Parse json file error: " << filename << ", " << e.what();
+    return false;
+  }
+  MS_LOG(INFO) << "Load previous Somas solution " << filename << " for graph " << graph.graph_id()
+               << ", matched tensors: " << prev_offsets->size() << "/" << solver_tensor_desc_map_.size();
+  return true;
+}
+
+Status Somas::WarmStartSolve(const session::KernelGraph &graph) {
+  std::map<size_t, size_t> prev_offsets;
+  int64_t prev_gap = 0;
+  warm_start_key_ = CalcWarmStartKey();
+  if (!LoadSomasWarmStartInfo(graph, &prev_offsets, &prev_gap)) {
+    return FAILED;
+  }
+  // The result should be as close to the lower bound as the previous one.
+  auto lower_bound = CalcLowerBound();
+  auto limit = static_cast<int64_t>(lower_bound) + prev_gap + static_cast<int64_t>(lower_bound * kWarmStartGapSlack);
+  auto max_offset_limit = limit > 0 ? static_cast<size_t>(limit) : 0;
+  return somas_solver_->WarmStartSolving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
+                                         processed_contiguous_tensors_list_, prev_offsets, max_offset_limit);
+}
+
+TensorsLifetimeMap Somas::GetSolverTensorsLifetime() const {
+  size_t max_node_id = 0;
+  for (const auto &tensor : tensors_list_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    max_node_id = std::max(max_node_id, tensor->lifetime_.end_);
+  }
+  // The semi lifelong tensors live from the start of the graph or to the end of the graph.
+  TensorsLifetimeMap lifetimes;
+  for (const auto &tensor : tensors_list_) {
+    auto start = tensor->lifetime_.start_;
+    auto end = tensor->lifetime_.end_;
+    if (tensor->IsLifelong() || tensor->IsSemiLifelongStart()) {
+      start = 0;
+    }
+    if (tensor->IsLifelong() || tensor->IsSemiLifelongEnd()) {
+      end = max_node_id;
+    }
+    lifetimes[tensor->GetId()] = {start, std::max(start, end)};
+  }
+  return lifetimes;
 }
 
 void Somas::UpdateSomasResultToGraph(const session::KernelGraph &graph) {
@@ -1542,8 +1709,18 @@ void Somas::Solve(const session::KernelGraph &graph) {
   }
 
   somas_solver_ = std::make_shared<SomasSolverPre>();
-  auto status =
-    somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_, processed_contiguous_tensors_list_, false);
+  // The recompiled graph reuses the solution of its previous compilation, and is only solved fully when it fails.
+  auto status = enable_cache_ ? WarmStartSolve(graph) : FAILED;
+  auto timeline_solver_budget = GetTimelineSolverBudget();
+  if (status != SUCCESS && timeline_solver_budget > 0) {
+    status = somas_solver_->TimelineSolving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
+                                            processed_contiguous_tensors_list_, GetSolverTensorsLifetime(),
+                                            timeline_solver_budget);
+  }
+  if (status != SUCCESS) {
+    status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
+                                    processed_contiguous_tensors_list_, false);
+  }
   MS_LOG(INFO) << "End Solving";
 
   GenGraphStatisticInfo();
@@ -1562,6 +1739,13 @@ void Somas::Solve(const session::KernelGraph &graph) {
   UpdateContiguousTensorsOffset(contiguous_list_with_ref_index_map_);
 
   reused_memory_size_ = static_cast<size_t>(somas_solver_->GetMaxOffset());
+  if (lower_bound_ > 0) {
+    constexpr double kPercent = 100.0;
+    MS_LOG(INFO) << "Reused memory size: " << reused_memory_size_ << ", lower bound: " << lower_bound_ << ", gap: "
+                 << (static_cast<double>(reused_memory_size_) - static_cast<double>(lower_bound_)) * kPercent /
+                      static_cast<double>(lower_bound_)
+                 << " %";
+  }
 
   MS_LOG(INFO) << "Somas Assign end.";
 }
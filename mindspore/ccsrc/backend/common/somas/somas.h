@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2022 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
 
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -96,6 +96,8 @@ class BACKEND_EXPORT Somas {
   virtual size_t GetCommunicationReservedSize() const;
 
   virtual bool GetEnableCacheFlag(const session::KernelGraph &graph) const;
+  // The time budget of the timeline solver in milliseconds, which is disabled by zero.
+  virtual size_t GetTimelineSolverBudget() const;
   virtual std::vector<vector<uint32_t>> GetStreamGroupInfo() const;
   virtual bool GetDependExecOrderFlag(const session::KernelGraph &graph) const = 0;
   virtual std::pair<bool, std::string> GetDebugConfig() const;
@@ -125,6 +127,8 @@ class BACKEND_EXPORT Somas {
   std::vector<DynamicBitSet> reuse_matrix_;
   // hash id
   std::string hash_id_;
+  // the key of the previous solution to warm start from, a hash of the tensors and their constraints
+  std::string warm_start_key_;
 
   // Stream groups
   std::vector<vector<uint32_t>> streams_groups_;
@@ -213,6 +217,15 @@ class BACKEND_EXPORT Somas {
   bool CalcSomasModelHash(const session::KernelGraph &graph);
   bool LoadSomasCache(const session::KernelGraph &graph);
 
+  // warm start from the solution of the previous compilation of the graph
+  Status WarmStartSolve(const session::KernelGraph &graph);
+  TensorsLifetimeMap GetSolverTensorsLifetime() const;
+  std::vector<std::string> GetTensorKeys() const;
+  std::string CalcWarmStartKey() const;
+  bool LoadSomasWarmStartInfo(const session::KernelGraph &graph, std::map<size_t, size_t> *prev_offsets,
+                              int64_t *prev_gap) const;
+  void SaveSomasWarmStartInfo(const session::KernelGraph &graph) const;
+
   // log
   std::string Offline() const;
   void DumpOfflineIR(const string &filename) const;
@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2022 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
 
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,15 +14,19 @@
  * limitations under the License.
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include "include/common/thread_pool.h"
 
 #include "backend/common/somas/somas_solver_core.h"
 #include "backend/common/somas/somas_solver_pre.h"
+#include "backend/common/somas/somas_solver_timeline.h"
 #include "include/common/debug/common.h"
 
 namespace mindspore {
@@ -101,6 +105,70 @@ vector<TensorsDescMap> SomasSolverPre::CreateTensorsMaps(const TensorsDescMap &t
   }
   return vecTensorsMap;
 }
+namespace {
+// A block of tensors which are contiguous, placed as a whole by the warm start.
+struct WarmStartBlock {
+  SomasSolverTensorDesc *start_tensor_{nullptr};
+  size_t size_{0};
+  size_t offset_{0};
+  bool lifelong_{false};
+};
+
+bool IsBlocksConflict(const WarmStartBlock &block1, const WarmStartBlock &block2,
+                      const std::vector<DynamicBitSet> &constraints) {
+  if (block1.lifelong_ || block2.lifelong_) {
+    return true;
+  }
+  for (auto t1 = block1.start_tensor_; t1 != nullptr; t1 = t1->right_.get()) {
+    for (auto t2 = block2.start_tensor_; t2 != nullptr; t2 = t2->right_.get()) {
+      if (!constraints[t1->index_].IsBitTrue(t2->index_)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// The block keeps its previous offset only when all of its tensors are still contiguous at the previous offsets.
+bool GetPrevBlockOffset(const WarmStartBlock &block, const std::map<size_t, size_t> &prev_offsets, size_t *offset) {
+  size_t next_offset = 0;
+  for (auto tensor = block.start_tensor_; tensor != nullptr; tensor = tensor->right_.get()) {
+    auto iter = prev_offsets.find(tensor->index_);
+    if (iter == prev_offsets.end() || (tensor != block.start_tensor_ && iter->second != next_offset)) {
+      return false;
+    }
+    if (tensor == block.start_tensor_) {
+      *offset = iter->second;
+    }
+    next_offset = iter->second + tensor->size_;
+  }
+  return true;
+}
+
+// Find the best fit gap among the placed blocks which conflict with the block.
+size_t FindBestFitOffset(const WarmStartBlock &block, const std::vector<WarmStartBlock> &placed_blocks,
+                         const std::vector<DynamicBitSet> &constraints) {
+  std::vector<std::pair<size_t, size_t>> intervals;
+  for (const auto &placed_block : placed_blocks) {
+    if (IsBlocksConflict(block, placed_block, constraints)) {
+      intervals.emplace_back(placed_block.offset_, placed_block.offset_ + placed_block.size_);
+    }
+  }
+  std::sort(intervals.begin(), intervals.end());
+  size_t best_offset = SIZE_MAX;
+  size_t best_gap = SIZE_MAX;
+  size_t current = 0;
+  for (const auto &interval : intervals) {
+    if (interval.first > current && interval.first - current >= block.size_ && interval.first - current < best_gap) {
+      best_gap = interval.first - current;
+      best_offset = current;
+    }
+    current = std::max(current, interval.second);
+  }
+  return best_offset == SIZE_MAX ? current : best_offset;
+}
+}  // namespace
+
 void FindBest(size_t total_sol, const vector<std::shared_ptr<SomasSolverCore>> &solvers, BestInfo *best_info) {
   MS_EXCEPTION_IF_NULL(best_info);
   for (size_t sol = 0; sol < total_sol; sol++) {
@@ -192,6 +260,158 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
   return ret;
 }
 
+Status SomasSolverPre::WarmStartSolving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
+                                         const std::vector<DynamicBitSet> *pConstraints,
+                                         const vector<vector<size_t>> &continuous_v,
+                                         const std::map<size_t, size_t> &prev_offsets, size_t max_offset_limit) {
+  MS_EXCEPTION_IF_NULL(ptensors);
+  MS_EXCEPTION_IF_NULL(pConstraints);
+  if (prev_offsets.empty()) {
+    return FAILED;
+  }
+  auto start = std::chrono::system_clock::now();
+  // Work on a copy of the tensors, which are left untouched for the full solving if the warm start fails.
+  TensorsDescMap tensors;
+  for (auto &pairT : *ptensors) {
+    auto tensor = std::make_shared<SomasSolverTensorDesc>(*(pairT.second.get()));
+    tensor->right_ = nullptr;
+    tensor->left_ = nullptr;
+    (void)tensors.emplace(pairT.first, tensor);
+  }
+  if (AddContiguousInfoInMap(continuous_v, &tensors) == FAILED) {
+    return FAILED;
+  }
+
+  std::vector<WarmStartBlock> blocks;
+  for (auto &pairT : tensors) {
+    auto &tensor = pairT.second;
+    if (tensor->left_ != nullptr) {
+      continue;
+    }
+    WarmStartBlock block;
+    block.start_tensor_ = tensor.get();
+    block.lifelong_ = tensor->lifelong_ && tensor->right_ == nullptr;
+    for (auto t = tensor.get(); t != nullptr; t = t->right_.get()) {
+      block.size_ += t->size_;
+    }
+    blocks.push_back(block);
+  }
+  std::sort(blocks.begin(), blocks.end(), [](const WarmStartBlock &block1, const WarmStartBlock &block2) {
+    return block1.start_tensor_->index_ < block2.start_tensor_->index_;
+  });
+
+  // Keep the previous offsets of the blocks in the order of offset, unless they conflict with the kept ones.
+  std::vector<WarmStartBlock> kept_blocks;
+  std::vector<WarmStartBlock> changed_blocks;
+  for (auto &block : blocks) {
+    if (GetPrevBlockOffset(block, prev_offsets, &block.offset_)) {
+      kept_blocks.push_back(block);
+    } else {
+      changed_blocks.push_back(block);
+    }
+  }
+  std::sort(kept_blocks.begin(), kept_blocks.end(), [](const WarmStartBlock &block1, const WarmStartBlock &block2) {
+    return block1.offset_ < block2.offset_ ||
+           (block1.offset_ == block2.offset_ && block1.start_tensor_->index_ < block2.start_tensor_->index_);
+  });
+  std::vector<WarmStartBlock> placed_blocks;
+  std::vector<size_t> active_blocks;
+  for (const auto &block : kept_blocks) {
+    (void)active_blocks.erase(std::remove_if(active_blocks.begin(), active_blocks.end(),
+                                             [&placed_blocks, &block](size_t index) {
+                                               auto &placed_block = placed_blocks[index];
+                                               return placed_block.offset_ + placed_block.size_ <= block.offset_;
+                                             }),
+                              active_blocks.end());
+    bool conflict = std::any_of(active_blocks.begin(), active_blocks.end(), [&](size_t index) {
+      return IsBlocksConflict(block, placed_blocks[index], *pConstraints);
+    });
+    if (conflict) {
+      changed_blocks.push_back(block);
+    } else {
+      active_blocks.push_back(placed_blocks.size());
+      placed_blocks.push_back(block);
+    }
+  }
+  if (changed_blocks.size() > blocks.size() * kWarmStartMaxChangedRatio) {
+    MS_LOG(INFO) << "Somas warm start is given up, changed blocks: " << changed_blocks.size() << "/" << blocks.size();
+    return FAILED;
+  }
+
+  // Place the changed blocks in the order of greater size and smaller index, like the fast heuristic.
+  auto greater_size = [](const WarmStartBlock &block1, const WarmStartBlock &block2) {
+    return block1.size_ > block2.size_ ||
+           (block1.size_ == block2.size_ && block1.start_tensor_->index_ < block2.start_tensor_->index_);
+  };
+  std::sort(changed_blocks.begin(), changed_blocks.end(), greater_size);
+  for (auto &block : changed_blocks) {
+    block.offset_ = FindBestFitOffset(block, placed_blocks, *pConstraints);
+    placed_blocks.push_back(block);
+  }
+  size_t max_offset = 0;
+  for (const auto &block : placed_blocks) {
+    max_offset = std::max(max_offset, block.offset_ + block.size_);
+  }
+  auto end = std::chrono::system_clock::now();
+  MS_LOG(INFO) << "Somas warm start result: " << max_offset << " Bytes, limit: " << max_offset_limit
+               << " Bytes, changed blocks: " << changed_blocks.size() << "/" << blocks.size() << ", time elapsed: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms";
+  if (max_offset > max_offset_limit) {
+    return FAILED;
+  }
+
+  for (const auto &block : placed_blocks) {
+    size_t offset = block.offset_;
+    for (auto tensor = block.start_tensor_; tensor != nullptr; tensor = tensor->right_.get()) {
+      (*ptensors)[tensor->index_]->offset_ = offset;
+      offset += tensor->size_;
+    }
+  }
+  max_offset_ = max_offset;
+  Log(graph, *ptensors, pConstraints, continuous_v);
+  return SUCCESS;
+}
+
+Status SomasSolverPre::TimelineSolving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
+                                        const std::vector<DynamicBitSet> *pConstraints,
+                                        const vector<vector<size_t>> &continuous_v, const TensorsLifetimeMap &lifetimes,
+                                        size_t time_budget_ms) {
+  MS_EXCEPTION_IF_NULL(ptensors);
+  MS_EXCEPTION_IF_NULL(pConstraints);
+  auto start = std::chrono::system_clock::now();
+  TensorsDescMap tensors;
+  for (auto &pairT : *ptensors) {
+    auto tensor = std::make_shared<SomasSolverTensorDesc>(*(pairT.second.get()));
+    tensor->right_ = nullptr;
+    tensor->left_ = nullptr;
+    (void)tensors.emplace(pairT.first, tensor);
+  }
+  if (AddContiguousInfoInMap(continuous_v, &tensors) == FAILED) {
+    return FAILED;
+  }
+  SomasTimelineSolver solver(tensors, pConstraints, lifetimes);
+  if (solver.MemoryAllocationSolver(time_budget_ms) != SUCCESS) {
+    return FAILED;
+  }
+  solver.UpdateTensorsOffset();
+  for (auto &pairT : tensors) {
+    (*ptensors)[pairT.first]->offset_ = pairT.second->offset_;
+  }
+  max_offset_ = solver.GetUpperbound();
+  lower_bound_ = solver.GetLowerBound();
+  auto end = std::chrono::system_clock::now();
+  constexpr double kPercent = 100.0;
+  auto gap = lower_bound_ == 0 ? 0.0
+                               : (static_cast<double>(max_offset_) - static_cast<double>(lower_bound_)) * kPercent /
+                                   static_cast<double>(lower_bound_);
+  MS_LOG(INFO) << "Somas timeline solver result: " << max_offset_ << " Bytes, lower bound: " << lower_bound_
+               << " Bytes, gap: " << gap << " %, blocks: " << solver.GetBlocksNum()
+               << ", iterations: " << solver.GetIterations() << ", time elapsed: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms";
+  Log(graph, *ptensors, pConstraints, continuous_v);
+  return SUCCESS;
+}
+
 void SomasSolverPre::Log(const session::KernelGraph &graph, const TensorsDescMap &tensors,
                          const std::vector<DynamicBitSet> *pConstraints,
                          const vector<vector<size_t>> &continuous_v) const {
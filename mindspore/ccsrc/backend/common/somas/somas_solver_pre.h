@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2022 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
 
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -44,6 +44,8 @@ constexpr char const *branchingNames[4] = {"bestfit", "smallest", "largest", "wo
 constexpr char const *algorithmTypeNames[2] = {"Shared Objects", "Single Object"};
 constexpr auto kParallelComputeSizeThreshold = 2000;
 constexpr auto kHalfByteSize = 4;
+// The warm start is given up when more blocks than this ratio are changed since the previous solution.
+constexpr auto kWarmStartMaxChangedRatio = 0.3;
 enum Status { FAILED, SUCCESS };
 enum AlgorithmType { kManyObjects = 0, kSingleObject, kNumAlgorithmTypes };
 enum SortingType {
@@ -182,6 +184,14 @@ struct SomasSolverTensorDesc {
 };
 using SomasSolverTensorDescPtr = std::shared_ptr<SomasSolverTensorDesc>;
 typedef mindspore::HashMap<size_t, SomasSolverTensorDescPtr> TensorsDescMap;
+
+// The lifetime of a tensor in the execution order, both of the start and end nodes are included.
+struct SomasSolverTensorLifetime {
+  size_t start_;
+  size_t end_;
+};
+using TensorsLifetimeMap = mindspore::HashMap<size_t, SomasSolverTensorLifetime>;
+
 class SomasSolverPre {
  public:
   SomasSolverPre() = default;
@@ -191,6 +201,7 @@ class SomasSolverPre {
   SomasSolverPre &operator=(const SomasSolverPre &) = delete;
 
   size_t GetMaxOffset() const { return max_offset_; }
+  size_t GetLowerBound() const { return lower_bound_; }
 
   Status Solving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
                  const std::vector<DynamicBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v,
@@ -199,6 +210,19 @@ class SomasSolverPre {
                  SortingType sorting = kGreaterSizeSmallerIndex, FittingType fitting = kBest,
                  AlgorithmType algorithm = kManyObjects);
 
+  // Keep the offsets of the previous solution for the unchanged blocks of tensors which do not conflict with each
+  // other, and only place the others in the gaps. Return FAILED when the previous solution can not be reused or the
+  // result exceeds the max offset limit, then the full solving is needed.
+  Status WarmStartSolving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
+                          const std::vector<DynamicBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v,
+                          const std::map<size_t, size_t> &prev_offsets, size_t max_offset_limit);
+
+  // Pack the tensors on the timeline of their lifetimes, and search for a better order of placing them within the
+  // time budget. The gap between the result and the lower bound of the max live memory is reported.
+  Status TimelineSolving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
+                         const std::vector<DynamicBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v,
+                         const TensorsLifetimeMap &lifetimes, size_t time_budget_ms);
+
   void Log(const session::KernelGraph &graph, const TensorsDescMap &tensors,
            const std::vector<DynamicBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v) const;
 
@@ -209,6 +233,7 @@ class SomasSolverPre {
 
  private:
   size_t max_offset_;
+  size_t lower_bound_{0};
   void SolverInputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors,
                       const vector<vector<size_t>> &continuous_v) const;
   void SolverOutputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors) const;
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "backend/common/somas/somas_solver_timeline.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kBitWidth = 64;
+constexpr uint32_t kTimelineRandomSeed = 0;
+// A worse solution is accepted to escape from the local optimum after this number of iterations without improvement.
+constexpr size_t kMaxStallIterations = 100;
+}  // namespace
+
+SomasTimelineSolver::SomasTimelineSolver(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *constraints,
+                                         const TensorsLifetimeMap &lifetimes)
+    : tensors_(tensors), constraints_(*constraints), lifetimes_(lifetimes) {}
+
+Status SomasTimelineSolver::MemoryAllocationSolver(size_t time_budget_ms) {
+  auto start = std::chrono::steady_clock::now();
+  BuildBlocks();
+  BuildConflicts();
+  CalcLowerBound();
+
+  // Start from the best of the greedy orders, the larger and longer blocks are placed first.
+  std::vector<size_t> blocks_order;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    if (!blocks_[i].lifelong_) {
+      blocks_order.push_back(i);
+    }
+  }
+  auto length = [this](size_t index) { return blocks_[index].end_ - blocks_[index].start_ + 1; };
+  std::vector<std::function<bool(size_t, size_t)>> greedy_orders = {
+    [this](size_t i, size_t j) { return blocks_[i].size_ > blocks_[j].size_; },
+    [this, &length](size_t i, size_t j) { return blocks_[i].size_ * length(i) > blocks_[j].size_ * length(j); },
+    [&length](size_t i, size_t j) { return length(i) > length(j); },
+    [this](size_t i, size_t j) { return blocks_[i].start_ < blocks_[j].start_; }};
+  rank_.assign(blocks_.size(), 0);
+  prefix_peak_.assign(blocks_order.size() + 1, 0);
+  size_t current = SIZE_MAX;
+  std::vector<size_t> best_order;
+  for (const auto &greedy_order : greedy_orders) {
+    order_ = blocks_order;
+    std::stable_sort(order_.begin(), order_.end(), greedy_order);
+    auto peak = Decode(0);
+    if (peak < current) {
+      current = peak;
+      best_order = order_;
+      best_offsets_ = offsets_;
+    }
+  }
+  order_ = best_order;
+  offsets_ = best_offsets_;
+  (void)Decode(0);
+  size_t best = current;
+
+  // Iterated local search on the order, the equal solutions are accepted to walk on the plateaus.
+  std::mt19937 gen(kTimelineRandomSeed);
+  auto budget = std::chrono::milliseconds(time_budget_ms);
+  std::vector<size_t> saved_order;
+  std::vector<size_t> saved_offsets;
+  std::vector<size_t> saved_peak;
+  size_t stall = 0;
+  while (!order_.empty() && lifelong_size_ + best > lower_bound_ &&
+         std::chrono::steady_clock::now() - start < budget) {
+    saved_order = order_;
+    saved_offsets = offsets_;
+    saved_peak = prefix_peak_;
+    auto position = Perturb(gen());
+    if (position == SIZE_MAX) {
+      break;
+    }
+    ++iterations_;
+    auto peak = Decode(position);
+    if (peak < best) {
+      best = peak;
+      best_offsets_ = offsets_;
+    }
+    stall = peak < current ? 0 : stall + 1;
+    if (peak <= current || stall >= kMaxStallIterations) {
+      stall = peak > current ? 0 : stall;
+      current = peak;
+      continue;
+    }
+    order_.swap(saved_order);
+    offsets_.swap(saved_offsets);
+    prefix_peak_.swap(saved_peak);
+    for (size_t i = position; i < order_.size(); ++i) {
+      rank_[order_[i]] = i;
+    }
+  }
+  upperbound_ = lifelong_size_ + best;
+  return SUCCESS;
+}
+
+void SomasTimelineSolver::UpdateTensorsOffset() const {
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    auto &block = blocks_[i];
+    size_t offset = block.lifelong_ ? best_offsets_[i] : lifelong_size_ + best_offsets_[i];
+    for (auto tensor = block.start_tensor_; tensor != nullptr; tensor = tensor->right_.get()) {
+      tensor->offset_ = offset;
+      offset += tensor->size_;
+    }
+  }
+}
+
+void SomasTimelineSolver::BuildBlocks() {
+  for (const auto &pairL : lifetimes_) {
+    max_time_ = std::max(max_time_, pairL.second.end_);
+  }
+  for (const auto &pairT : tensors_) {
+    auto &tensor = pairT.second;
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->left_ != nullptr) {
+      continue;
+    }
+    TimelineBlock block;
+    block.start_tensor_ = tensor.get();
+    block.lifelong_ = tensor->lifelong_ && tensor->right_ == nullptr;
+    block.start_ = block.lifelong_ ? 0 : SIZE_MAX;
+    block.end_ = block.lifelong_ ? max_time_ : 0;
+    for (auto t = tensor.get(); t != nullptr; t = t->right_.get()) {
+      block.size_ += t->size_;
+      // The tensor without lifetime lives through the whole graph.
+      auto iter = lifetimes_.find(t->index_);
+      block.start_ = std::min(block.start_, iter == lifetimes_.end() ? 0 : iter->second.start_);
+      block.end_ = std::max(block.end_, iter == lifetimes_.end() ? max_time_ : iter->second.end_);
+    }
+    blocks_.push_back(block);
+  }
+  std::sort(blocks_.begin(), blocks_.end(), [](const TimelineBlock &block1, const TimelineBlock &block2) {
+    return block1.start_tensor_->index_ < block2.start_tensor_->index_;
+  });
+  offsets_.assign(blocks_.size(), 0);
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    if (blocks_[i].lifelong_) {
+      offsets_[i] = lifelong_size_;
+      lifelong_size_ += blocks_[i].size_;
+    }
+  }
+}
+
+void SomasTimelineSolver::BuildConflicts() {
+  std::vector<size_t> tensor_block(constraints_.size(), SIZE_MAX);
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    for (auto t = blocks_[i].start_tensor_; t != nullptr; t = t->right_.get()) {
+      if (t->index_ >= constraints_.size()) {
+        MS_LOG(EXCEPTION) << "The index of tensor " << t->index_ << " is out of the constraints "
+                          << constraints_.size();
+      }
+      tensor_block[t->index_] = i;
+    }
+  }
+  // The lifelong blocks conflict with all of the others, which is left to the stacking at the bottom. The tensors
+  // which can not share memory are the zero bits of the constraints, and most of the words are all ones.
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    if (blocks_[i].lifelong_) {
+      continue;
+    }
+    for (auto t = blocks_[i].start_tensor_; t != nullptr; t = t->right_.get()) {
+      auto &bits = constraints_[t->index_].bit_;
+      for (size_t word = 0; word < bits.size(); ++word) {
+        auto zeros = ~bits[word];
+        for (size_t bit = 0; zeros != 0 && bit < kBitWidth; ++bit) {
+          auto index = word * kBitWidth + bit;
+          if ((zeros & (static_cast<uint64_t>(0x1) << (kBitWidth - 1 - bit))) == 0 || index >= tensor_block.size()) {
+            continue;
+          }
+          auto other = tensor_block[index];
+          if (other != SIZE_MAX && other != i && !blocks_[other].lifelong_) {
+            blocks_[i].conflicts_.push_back(other);
+            blocks_[other].conflicts_.push_back(i);
+          }
+        }
+      }
+    }
+  }
+  for (auto &block : blocks_) {
+    std::sort(block.conflicts_.begin(), block.conflicts_.end());
+    (void)block.conflicts_.erase(std::unique(block.conflicts_.begin(), block.conflicts_.end()), block.conflicts_.end());
+  }
+}
+
+void SomasTimelineSolver::CalcLowerBound() {
+  // Sweep the timeline for the max live memory, the blocks ending at a time are released before the ones starting.
+  std::vector<std::pair<size_t, int64_t>> events;
+  for (const auto &block : blocks_) {
+    events.emplace_back(block.start_, static_cast<int64_t>(block.size_));
+    events.emplace_back(block.end_ + 1, -static_cast<int64_t>(block.size_));
+  }
+  std::sort(events.begin(), events.end());
+  int64_t live = 0;
+  int64_t max_live = 0;
+  for (const auto &event : events) {
+    live += event.second;
+    max_live = std::max(max_live, live);
+  }
+  lower_bound_ = static_cast<size_t>(max_live);
+}
+
+size_t SomasTimelineSolver::Decode(size_t position) {
+  for (size_t i = position; i < order_.size(); ++i) {
+    rank_[order_[i]] = i;
+  }
+  std::vector<std::pair<size_t, size_t>> intervals;
+  size_t peak = prefix_peak_[position];
+  for (size_t i = position; i < order_.size(); ++i) {
+    auto index = order_[i];
+    offsets_[index] = FindLowestOffset(index, i, &intervals);
+    peak = std::max(peak, offsets_[index] + blocks_[index].size_);
+    prefix_peak_[i + 1] = peak;
+  }
+  return peak;
+}
+
+size_t SomasTimelineSolver::FindLowestOffset(size_t block_index, size_t rank,
+                                             std::vector<std::pair<size_t, size_t>> *intervals) const {
+  intervals->clear();
+  for (auto other : blocks_[block_index].conflicts_) {
+    if (rank_[other] < rank) {
+      intervals->emplace_back(offsets_[other], offsets_[other] + blocks_[other].size_);
+    }
+  }
+  std::sort(intervals->begin(), intervals->end());
+  size_t offset = 0;
+  for (const auto &interval : *intervals) {
+    if (interval.first >= offset + blocks_[block_index].size_) {
+      break;
+    }
+    offset = std::max(offset, interval.second);
+  }
+  return offset;
+}
+
+size_t SomasTimelineSolver::Perturb(uint32_t random) {
+  auto peak = prefix_peak_.back();
+  std::vector<size_t> candidates;
+  for (size_t i = 1; i < order_.size(); ++i) {
+    if (offsets_[order_[i]] + blocks_[order_[i]].size_ == peak) {
+      candidates.push_back(i);
+    }
+  }
+  if (candidates.empty()) {
+    // Only the first block reaches the peak, which can not be lower.
+    return SIZE_MAX;
+  }
+  auto rank = candidates[random % candidates.size()];
+  auto position = (random / candidates.size()) % rank;
+  std::rotate(order_.begin() + position, order_.begin() + rank, order_.begin() + rank + 1);
+  return position;
+}
+}  // namespace somas
+}  // namespace mindspore
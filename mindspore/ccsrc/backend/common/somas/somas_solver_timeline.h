@@ -0,0 +1,93 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_SOLVER_TIMELINE_H_
+#define MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_SOLVER_TIMELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+// A block of contiguous tensors, which is a rectangle on the timeline: its lifetime in the execution order is the
+// width, and its size is the height.
+struct TimelineBlock {
+  SomasSolverTensorDesc *start_tensor_{nullptr};
+  size_t size_{0};
+  size_t start_{0};
+  size_t end_{0};
+  bool lifelong_{false};
+  // The blocks which can not share memory with this one.
+  std::vector<size_t> conflicts_;
+};
+
+// Pack the blocks of tensors on the timeline, which is a 2D strip packing with the fixed lifetimes. A solution is an
+// order of blocks, which is decoded by placing each block at the lowest offset free of the conflicting blocks placed
+// before it. The order is improved by the iterated local search, which moves the blocks on top of the peak earlier,
+// until the time budget runs out or the lower bound of the max live memory is reached.
+class SomasTimelineSolver {
+ public:
+  // The tensors are linked by the contiguous info, and their lifetimes are in the execution order.
+  SomasTimelineSolver(const TensorsDescMap &tensors, const std::vector<DynamicBitSet> *constraints,
+                      const TensorsLifetimeMap &lifetimes);
+  ~SomasTimelineSolver() = default;
+
+  Status MemoryAllocationSolver(size_t time_budget_ms);
+  // Write the offsets of the best solution to the tensors.
+  void UpdateTensorsOffset() const;
+
+  size_t GetLowerBound() const { return lower_bound_; }
+  size_t GetUpperbound() const { return upperbound_; }
+  size_t GetIterations() const { return iterations_; }
+  size_t GetBlocksNum() const { return blocks_.size(); }
+
+ private:
+  void BuildBlocks();
+  void BuildConflicts();
+  void CalcLowerBound();
+  // Place the blocks of the order from the position, the blocks before it keep their offsets, return the peak.
+  size_t Decode(size_t position);
+  size_t FindLowestOffset(size_t block_index, size_t rank, std::vector<std::pair<size_t, size_t>> *intervals) const;
+  // Move a block which reaches the peak to an earlier position of the order, return the first changed position.
+  size_t Perturb(uint32_t random);
+
+  const TensorsDescMap &tensors_;
+  const std::vector<DynamicBitSet> &constraints_;
+  const TensorsLifetimeMap &lifetimes_;
+  std::vector<TimelineBlock> blocks_;
+  // The lifelong blocks are stacked at the bottom, and the others are packed above them.
+  size_t lifelong_size_{0};
+  size_t max_time_{0};
+
+  // The current solution, the rank is the position of a block in the order.
+  std::vector<size_t> order_;
+  std::vector<size_t> rank_;
+  std::vector<size_t> offsets_;
+  // The peak of the blocks before each position of the order.
+  std::vector<size_t> prefix_peak_;
+  std::vector<size_t> best_offsets_;
+
+  size_t lower_bound_{0};
+  size_t upperbound_{SIZE_MAX};
+  size_t iterations_{0};
+};
+}  // namespace somas
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_SOLVER_TIMELINE_H_
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_SIZE_CLASS_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_SIZE_CLASS_H_
+
+#include <memory>
+#include "include/backend/mem_reuse/mem_dynamic_allocator.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace device {
+// The size classes of the small memory bufs, the larger ones are allocated by the best fit pool.
+constexpr size_t kMaxSizeClassMemSize = 128 << 10;
+constexpr size_t kNoSizeClass = SIZE_MAX;
+
+// The state of the size classes, which is shared with the thread caches.
+struct SizeClassState;
+using SizeClassStatePtr = std::shared_ptr<SizeClassState>;
+
+// The dynamic memory pool which allocates the small memory bufs by size classes, in front of a best fit pool. The
+// memory bufs of a size class are cut from the slabs of the best fit pool, and are tracked by the headers kept in the
+// host memory. The idle memory bufs are cached by each thread without lock, and are exchanged in batches with the lists
+// of their size classes, each of which has its own lock. The slabs whose memory bufs are all idle are cut again for
+// other size classes, and the idle arenas are given back to the best fit pool. The persistent memory and the large
+// memory bufs are allocated by the best fit pool.
+class BACKEND_EXPORT DynamicMemPoolSizeClass {
+ public:
+  // The best fit pool must outlive this pool.
+  explicit DynamicMemPoolSizeClass(DynamicMemPoolBestFit *best_fit_pool);
+  ~DynamicMemPoolSizeClass();
+
+  DeviceMemPtr AllocTensorMem(size_t size, bool from_persistent_mem = false);
+  void FreeTensorMem(const DeviceMemPtr &device_addr);
+  // Drop the size classes and release the device memory of the best fit pool.
+  void ReleaseDeviceRes();
+  // Give the arenas whose memory bufs are all idle back to the best fit pool, except those held by the idle memory bufs
+  // in the thread caches. Return the released memory size.
+  size_t ReleaseIdleArenas();
+
+  // The statistics information. The used memory excludes the idle memory bufs of the size classes, while the total
+  // memory and the peak include them.
+  size_t TotalMemStatistics() const;
+  size_t TotalUsedMemStatistics() const;
+  size_t UsedMemPeakStatistics() const;
+
+  void DumpDynamicMemPoolStateInfo();
+  void DumpDynamicMemPoolDebugInfo();
+
+  // The size class of the aligned memory size, or kNoSizeClass when the size is too large.
+  static size_t SizeClassOf(size_t align_size);
+  // The memory size of the size class.
+  static size_t SizeOfClass(size_t size_class);
+  static size_t SizeClassNum();
+
+ private:
+  // Add a slab to the size class, and put its memory bufs in the list of the size class.
+  bool AddSlab(const SizeClassStatePtr &state, size_t size_class);
+
+  DynamicMemPoolBestFit *best_fit_pool_;
+  // Replaced when the device memory is released, so it is loaded and stored atomically.
+  SizeClassStatePtr state_;
+};
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_SIZE_CLASS_H_
@@ -69,6 +69,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_autotune_memory_budget", &ConfigManager::set_autotune_memory_budget)
+                    .def("get_autotune_memory_budget", &ConfigManager::autotune_memory_budget)
+                    .def("set_autotune_cpu_budget", &ConfigManager::set_autotune_cpu_budget)
+                    .def("get_autotune_cpu_budget", &ConfigManager::autotune_cpu_budget)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
@@ -81,6 +85,22 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_debug_mode", &ConfigManager::get_debug_mode)
                     .def("set_error_samples_mode", &ConfigManager::set_error_samples_mode)
                     .def("get_error_samples_mode", &ConfigManager::get_error_samples_mode)
+                    .def("set_enable_mindrecord_mmap", &ConfigManager::set_enable_mindrecord_mmap)
+                    .def("get_enable_mindrecord_mmap", &ConfigManager::enable_mindrecord_mmap)
+                    .def("set_enable_jpeg_scaled_decode", &ConfigManager::set_enable_jpeg_scaled_decode)
+                    .def("get_enable_jpeg_scaled_decode", &ConfigManager::enable_jpeg_scaled_decode)
+                    .def("set_io_prefetch_depth", &ConfigManager::set_io_prefetch_depth)
+                    .def("get_io_prefetch_depth", &ConfigManager::io_prefetch_depth)
+                    .def("set_batch_buffer_pool_size", &ConfigManager::set_batch_buffer_pool_size)
+                    .def("get_batch_buffer_pool_size", &ConfigManager::batch_buffer_pool_size)
+                    .def("set_shuffle_spill_mem_limit", &ConfigManager::set_shuffle_spill_mem_limit)
+                    .def("get_shuffle_spill_mem_limit", &ConfigManager::shuffle_spill_mem_limit)
+                    .def("set_shuffle_spill_dir", &ConfigManager::set_shuffle_spill_dir)
+                    .def("get_shuffle_spill_dir", &ConfigManager::shuffle_spill_dir)
+                    .def("set_graph_csr_store_dir", &ConfigManager::set_graph_csr_store_dir)
+                    .def("get_graph_csr_store_dir", &ConfigManager::graph_csr_store_dir)
+                    .def("set_numa_partition", &ConfigManager::set_numa_partition)
+                    .def("get_numa_partition", &ConfigManager::numa_partition)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
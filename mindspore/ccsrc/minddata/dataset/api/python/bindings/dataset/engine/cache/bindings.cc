@@ -25,10 +25,11 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
                     .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill,
                                      std::optional<std::string> hostname, std::optional<int32_t> port,
-                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz) {
+                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz,
+                                     bool shared) {
                       std::shared_ptr<CacheClient> cc;
                       CacheClient::Builder builder;
-                      builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill);
+                      builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill).SetShared(shared);
                       if (hostname) builder.SetHostname(hostname.value());
                       if (port) builder.SetPort(port.value());
                       if (num_connections) builder.SetNumConnections(num_connections.value());
@@ -25,8 +25,22 @@ namespace mindspore {
 namespace dataset {
 PYBIND_REGISTER(TreeConsumer, 0, ([](const py::module *m) {
                   (void)py::class_<TreeConsumer, std::shared_ptr<TreeConsumer>>(*m, "TreeConsumer")
-                    .def("Reset", [](TreeConsumer &self, int64_t step, int64_t epoch) {
-                      THROW_IF_ERROR(self.Reset(step, epoch));
+                    .def("Reset",
+                         [](TreeConsumer &self, int64_t step, int64_t epoch) {
+                           THROW_IF_ERROR(self.Reset(step, epoch));
+                         })
+                    .def("GetPipelineState",
+                         [](TreeConsumer &self) {
+                           nlohmann::json pipeline_state;
+                           THROW_IF_ERROR(self.GetPipelineState(&pipeline_state));
+                           return pipeline_state.dump();
+                         })
+                    .def("Restore", [](TreeConsumer &self, const std::string &pipeline_state) {
+                      nlohmann::json state = nlohmann::json::parse(pipeline_state, nullptr, false);
+                      if (state.is_discarded()) {
+                        THROW_IF_ERROR(Status(StatusCode::kMDUnexpectedError, "Invalid pipeline state to restore."));
+                      }
+                      THROW_IF_ERROR(self.Restore(state));
                     });
                 }));
 PYBIND_REGISTER(PythonIteratorConsumer, 1, ([](const py::module *m) {
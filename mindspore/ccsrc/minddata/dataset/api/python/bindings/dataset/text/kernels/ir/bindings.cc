@@ -278,9 +278,10 @@ PYBIND_REGISTER(WordpieceTokenizerOperation, 1, ([](const py::module *m) {
                                    std::shared_ptr<text::WordpieceTokenizerOperation>>(*m,
                                                                                        "WordpieceTokenizerOperation")
                     .def(py::init([](const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
-                                     int32_t max_bytes_per_token, const std::string &unknown_token, bool with_offsets) {
+                                     int32_t max_bytes_per_token, const std::string &unknown_token, bool with_offsets,
+                                     bool output_ids) {
                       auto wordpiece_tokenizer = std::make_shared<text::WordpieceTokenizerOperation>(
-                        vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets);
+                        vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets, output_ids);
                       THROW_IF_ERROR(wordpiece_tokenizer->ValidateParams());
                       return wordpiece_tokenizer;
                     }));
@@ -450,8 +450,9 @@ WordpieceTokenizer::WordpieceTokenizer(const std::shared_ptr<Vocab> &vocab, cons
     : data_(std::make_shared<Data>(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets)) {}
 
 std::shared_ptr<TensorOperation> WordpieceTokenizer::Parse() {
-  return std::make_shared<WordpieceTokenizerOperation>(
-    data_->vocab_, data_->suffix_indicator_, data_->max_bytes_per_token_, data_->unknown_token_, data_->with_offsets_);
+  return std::make_shared<WordpieceTokenizerOperation>(data_->vocab_, data_->suffix_indicator_,
+                                                       data_->max_bytes_per_token_, data_->unknown_token_,
+                                                       data_->with_offsets_, false);
 }
 
 #ifndef _WIN32
@@ -99,6 +99,15 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_num_connections(j.value("numConnections", num_connections_));
   set_cache_prefetch_size(j.value("cachePrefetchSize", cache_prefetch_size_));
   set_debug_mode(j.value("debug_mode_flag", debug_mode_flag_));
+  set_enable_mindrecord_mmap(j.value("enable_mindrecord_mmap", enable_mindrecord_mmap_));
+  set_enable_jpeg_scaled_decode(j.value("enable_jpeg_scaled_decode", enable_jpeg_scaled_decode_));
+  set_io_prefetch_depth(j.value("io_prefetch_depth", io_prefetch_depth_));
+  set_batch_buffer_pool_size(j.value("batch_buffer_pool_size", batch_buffer_pool_size_));
+  set_shuffle_spill_mem_limit(j.value("shuffle_spill_mem_limit", shuffle_spill_mem_limit_));
+  set_shuffle_spill_dir(j.value("shuffle_spill_dir", shuffle_spill_dir_));
+  set_graph_csr_store_dir(j.value("graph_csr_store_dir", graph_csr_store_dir_));
+  set_autotune_memory_budget(j.value("autotune_memory_budget", autotune_memory_budget_));
+  set_autotune_cpu_budget(j.value("autotune_cpu_budget", autotune_cpu_budget_));
   return Status::OK();
 }
 
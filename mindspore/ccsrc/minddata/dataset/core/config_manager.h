@@ -260,6 +260,24 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // setter function
+  // @param memory_budget - Max bytes of the rows buffered by the pipeline, a positive value of it or of the CPU budget
+  //     switches AutoTune to solve the configuration from a throughput model instead of tuning one op at a time
+  void set_autotune_memory_budget(int64_t memory_budget) { autotune_memory_budget_ = memory_budget; }
+
+  // getter function
+  // @return - Max bytes of the rows buffered by the pipeline for the model-based AutoTune, 0 means no limit
+  int64_t autotune_memory_budget() const { return autotune_memory_budget_; }
+
+  // setter function
+  // @param cpu_budget - Max total number of threads of the ops for the model-based AutoTune, 0 means all the cores. A
+  //     positive value switches AutoTune to the model-based tuning like the memory budget
+  void set_autotune_cpu_budget(int32_t cpu_budget) { autotune_cpu_budget_ = cpu_budget; }
+
+  // getter function
+  // @return - Max total number of threads of the ops for the model-based AutoTune
+  int32_t autotune_cpu_budget() const { return autotune_cpu_budget_; }
+
   // setter function
   // @param enable - To enable watchdog python thread
   void set_enable_watchdog(bool enable) { enable_watchdog_ = enable; }
@@ -295,6 +313,88 @@ class ConfigManager {
   // @return - Flag to indicate whether md pipeline recovers fast in failover reset
   bool fast_recovery() const { return fast_recovery_; }
 
+  // setter function
+  // @notes When enabled, MindRecord files are mapped into memory and the blob data of each row is not copied
+  //     (System default = false)
+  // @param enable - Set whether MindRecord files are read through memory mapping
+  void set_enable_mindrecord_mmap(const bool enable) { enable_mindrecord_mmap_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether MindRecord files are read through memory mapping
+  bool enable_mindrecord_mmap() const { return enable_mindrecord_mmap_; }
+
+  // setter function
+  // @notes When enabled, the decode operations which know the size their output is resized to decode JPEG images at
+  //     the smallest scale of 1/8, 1/4 or 1/2 which still covers that size. (System default = false)
+  // @param enable - Set whether JPEG images are decoded at a reduced scale when they are resized afterwards
+  void set_enable_jpeg_scaled_decode(const bool enable) { enable_jpeg_scaled_decode_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether JPEG images are decoded at a reduced scale when they are resized afterwards
+  bool enable_jpeg_scaled_decode() const { return enable_jpeg_scaled_decode_; }
+
+  // setter function
+  // @notes When it is greater than 0, the files of the non-mappable leaf ops are read ahead by an I/O engine which
+  //     keeps up to this number of block reads in flight. (System default = 0, the files are read by the workers)
+  // @param io_prefetch_depth - The max number of blocks read ahead by each non-mappable leaf op
+  void set_io_prefetch_depth(int32_t io_prefetch_depth) { io_prefetch_depth_ = io_prefetch_depth; }
+
+  // getter function
+  // @return - The max number of blocks read ahead by each non-mappable leaf op
+  int32_t io_prefetch_depth() const { return io_prefetch_depth_; }
+
+  // setter function
+  // @notes When it is greater than 0, the batch operations assemble numeric columns in pooled buffers, and up to this
+  //     number of idle buffers are kept for each column for reuse. (System default = 0, the buffers are not pooled)
+  // @param batch_buffer_pool_size - The max number of idle buffers kept for each column of a batch operation
+  void set_batch_buffer_pool_size(int32_t batch_buffer_pool_size) { batch_buffer_pool_size_ = batch_buffer_pool_size; }
+
+  // getter function
+  // @return - The max number of idle buffers kept for each column of a batch operation
+  int32_t batch_buffer_pool_size() const { return batch_buffer_pool_size_; }
+
+  // setter function
+  // @notes When it is greater than 0, the shuffle operations keep their buffered rows serialized and spill the rows
+  //     beyond this number of bytes to shuffle_spill_dir. (System default = 0, the rows are kept in memory as they are)
+  // @param shuffle_spill_mem_limit - The max number of bytes of the buffered rows kept in memory by a shuffle operation
+  void set_shuffle_spill_mem_limit(int64_t shuffle_spill_mem_limit) {
+    shuffle_spill_mem_limit_ = shuffle_spill_mem_limit;
+  }
+
+  // getter function
+  // @return - The max number of bytes of the buffered rows kept in memory by a shuffle operation
+  int64_t shuffle_spill_mem_limit() const { return shuffle_spill_mem_limit_; }
+
+  // setter function
+  // @param shuffle_spill_dir - The directory the shuffle operations spill their buffered rows to
+  void set_shuffle_spill_dir(const std::string &shuffle_spill_dir) { shuffle_spill_dir_ = shuffle_spill_dir; }
+
+  // getter function
+  // @return - The directory the shuffle operations spill their buffered rows to
+  std::string shuffle_spill_dir() const { return shuffle_spill_dir_; }
+
+  // setter function
+  // @notes When it is not empty, the graphs loaded from MindRecord files are kept in CSR arrays in a file under this
+  //     directory, which is memory mapped by later loads of the same graph. (System default = "", the graphs are kept
+  //     as node and edge objects)
+  // @param graph_csr_store_dir - The directory the CSR stores of the graphs are kept in
+  void set_graph_csr_store_dir(const std::string &graph_csr_store_dir) { graph_csr_store_dir_ = graph_csr_store_dir; }
+
+  // getter function
+  // @return - The directory the CSR stores of the graphs are kept in
+  std::string graph_csr_store_dir() const { return graph_csr_store_dir_; }
+
+  // setter function
+  // @notes When it is true, the workers of each parallel operation are spread over the NUMA nodes of the host, pinned
+  //     to the cpus of their node, and allocate the rows they produce from a memory pool of their node.
+  //     (System default = false, the workers float over all the cpus and allocate from the global pool)
+  // @param numa_partition - Whether the pipelines run partitioned over the NUMA nodes
+  void set_numa_partition(bool numa_partition) { numa_partition_ = numa_partition; }
+
+  // getter function
+  // @return - Whether the pipelines run partitioned over the NUMA nodes
+  bool numa_partition() const { return numa_partition_; }
+
   // setter function
   // @param debug_mode_flag - Set whether debug mode is on. When enabled, the dataset pipeline runs synchronously and
   //    sequentially.
@@ -354,8 +454,19 @@ class ConfigManager {
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
   bool dynamic_shape_{false};
-  bool fast_recovery_{true};     // Used for failover scenario to recover quickly or produce same augmentations
-  bool debug_mode_flag_{false};  // Indicator for debug mode
+  bool fast_recovery_{true};            // Used for failover scenario to recover quickly or produce same augmentations
+  bool debug_mode_flag_{false};         // Indicator for debug mode
+  bool enable_mindrecord_mmap_{false};  // Read MindRecord files through memory mapping
+  int32_t io_prefetch_depth_{0};        // Max number of blocks read ahead by each non-mappable leaf op
+  int32_t batch_buffer_pool_size_{0};   // Max number of idle buffers kept for each column of a batch op
+  int64_t shuffle_spill_mem_limit_{0};  // Max bytes of buffered rows kept in memory by a shuffle op
+  std::string shuffle_spill_dir_;       // Directory the shuffle ops spill their buffered rows to
+  std::string graph_csr_store_dir_;     // Directory the CSR stores of the graphs are kept in
+  bool numa_partition_{false};          // Spread the workers and their memory over the NUMA nodes
+  int64_t autotune_memory_budget_{0};   // Max bytes of buffered rows for the model-based AutoTune
+  int32_t autotune_cpu_budget_{0};      // Max threads of the ops for the model-based AutoTune
+  // Decode JPEG images at a reduced scale when they are resized afterwards
+  bool enable_jpeg_scaled_decode_{false};
   ErrorSamplesMode error_samples_mode_{ErrorSamplesMode::kReturn};  // The method to process erroneous samples
 };
 }  // namespace dataset
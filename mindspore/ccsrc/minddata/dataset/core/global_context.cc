@@ -35,6 +35,7 @@ namespace dataset {
 // Global static pointer for the singleton GlobalContext
 std::unique_ptr<GlobalContext> GlobalContext::global_context_ = nullptr;
 std::once_flag GlobalContext::init_instance_flag_;
+thread_local std::shared_ptr<MemoryPool> GlobalContext::thread_mem_pool_ = nullptr;
 
 constexpr int GlobalContext::kArenaSize;
 constexpr int GlobalContext::kMaxSize;
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
 
 #include "include/api/status.h"
 #include "minddata/dataset/core/config_manager.h"
@@ -83,8 +84,13 @@ class GlobalContext {
   static std::shared_ptr<ProfilingManager> profiling_manager() { return Instance()->profiler_manager_; }
 #endif
   // Getter method
-  // @return the mem pool
-  std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
+  // @return the mem pool of the calling thread, which is the global one unless the thread has set its own
+  std::shared_ptr<MemoryPool> mem_pool() const { return thread_mem_pool_ != nullptr ? thread_mem_pool_ : mem_pool_; }
+
+  // Let the calling thread allocate from its own mem pool instead of the global one, e.g. the pool of the NUMA node
+  // the thread is pinned to. The memory keeps a reference to the pool it comes from, so it can be freed by any thread.
+  // @param pool - The mem pool of the calling thread, nullptr to go back to the global one
+  static void SetThreadMemPool(std::shared_ptr<MemoryPool> pool) { thread_mem_pool_ = std::move(pool); }
 
   // Getter method
   // @return the tensor allocator as raw pointer
@@ -121,6 +127,8 @@ class GlobalContext {
 #ifndef ENABLE_SECURITY
   std::shared_ptr<ProfilingManager> profiler_manager_;  // ProfilerManager instance for all trees
 #endif
+
+  static thread_local std::shared_ptr<MemoryPool> thread_mem_pool_;  // The mem pool of the calling thread
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -69,9 +69,11 @@ Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape),
 Tensor::Tensor(Tensor &&other) noexcept
     : shape_(other.shape()),
       type_(other.type()),
-      data_(other.GetMutableBuffer()),
+      data_(other.data_),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      data_owner_(std::move(other.data_owner_)),
+      copy_on_write_(other.copy_on_write_) {
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -85,9 +87,11 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
   if (&other != this) {
     shape_ = other.shape();
     type_ = other.type();
-    data_ = other.GetMutableBuffer();
+    data_ = other.data_;
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    data_owner_ = std::move(other.data_owner_);
+    copy_on_write_ = other.copy_on_write_;
     yuv_shape_ = other.yuv_shape_;
 #ifdef ENABLE_PYTHON
     if (type_.value() == DataType::DE_PYTHON) {
@@ -395,9 +399,55 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryView(const TensorShape &shape, const DataType &type, uchar *src, const dsize_t &length,
+                                    std::shared_ptr<void> owner, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Failed to create tensor view, only numeric type is supported.");
+  RETURN_UNEXPECTED_IF_NULL(owner);
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED(out != nullptr, "Allocate memory failed.");
+  CHECK_FAIL_RETURN_UNEXPECTED((*out)->SizeInBytes() == length, "Length of source data does not match the shape.");
+  if (length == 0) {
+    return Status::OK();
+  }
+  RETURN_UNEXPECTED_IF_NULL(src);
+  (*out)->data_ = src;
+  (*out)->data_end_ = src + length;
+  (*out)->data_owner_ = std::move(owner);
+  return Status::OK();
+}
+
+Status Tensor::CreateFromReadOnlyMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                            const dsize_t &length, std::shared_ptr<void> owner, TensorPtr *out) {
+  RETURN_IF_NOT_OK(CreateFromMemoryView(shape, type, const_cast<uchar *>(src), length, std::move(owner), out));
+  (*out)->copy_on_write_ = length > 0;
+  return Status::OK();
+}
+
+Status Tensor::CopyViewData() {
+  // Keep the owner until the data is copied
+  std::shared_ptr<void> owner = std::move(data_owner_);
+  const uchar *src = data_;
+  dsize_t length = data_end_ - data_;
+  data_ = nullptr;
+  data_end_ = nullptr;
+  copy_on_write_ = false;
+  RETURN_IF_NOT_OK(AllocateBuffer(length));
+  int ret_code = memcpy_s(data_, length, src, length);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy data of a read-only tensor view.");
+  return Status::OK();
+}
+
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
+  if (data_owner_ != nullptr) {
+    // the memory is not allocated by the tensor, just drop the reference to its owner
+    data_ = nullptr;
+    data_end_ = nullptr;
+    data_owner_ = nullptr;
+  }
   if (data_ != nullptr) {
     if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
@@ -570,6 +620,8 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  data_owner_ = nullptr;
+  copy_on_write_ = false;
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
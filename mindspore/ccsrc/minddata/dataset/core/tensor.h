@@ -107,6 +107,31 @@ class DATASET_API Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor on top of memory owned by someone else. Data will not be copied, the tensor keeps a
+  /// reference to the owner instead so that the memory stays valid for the lifetime of the tensor.
+  /// \note The memory must be writable, since the tensor might be modified in place by the following operations
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] src pointer to the source data
+  /// \param[in] length length of the src data
+  /// \param[in] owner the object which owns the memory
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryView(const TensorShape &shape, const DataType &type, uchar *src, const dsize_t &length,
+                                     std::shared_ptr<void> owner, TensorPtr *out);
+
+  /// Create a numeric tensor on top of read-only memory owned by someone else. Data will not be copied until the
+  /// tensor is about to be modified, then it is copied into a buffer of the tensor and the owner is released.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] src pointer to the source data
+  /// \param[in] length length of the src data
+  /// \param[in] owner the object which owns the memory
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromReadOnlyMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                             const dsize_t &length, std::shared_ptr<void> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -338,6 +363,7 @@ class DATASET_API Tensor {
   /// \param[in] value of type `T`
   template <typename T>
   Status SetItemAt(const std::vector<dsize_t> &index, const T &value) {
+    RETURN_IF_NOT_OK(CopyOnWrite());
     T *ptr = nullptr;
     RETURN_IF_NOT_OK(GetItemPtr<T>(&ptr, index));
     *ptr = value;
@@ -349,6 +375,7 @@ class DATASET_API Tensor {
   /// \param[in] value of type std::string
   Status SetItemAt(const std::vector<dsize_t> &index, const std::string &value) {
     RETURN_UNEXPECTED_IF_NULL(data_);
+    RETURN_IF_NOT_OK(CopyOnWrite());
     uchar *ptr = nullptr;
     offset_t length = 0;
     RETURN_IF_NOT_OK(GetItemPtr(&ptr, index, &length));
@@ -376,6 +403,7 @@ class DATASET_API Tensor {
   template <typename T>
   Status Fill(const T &value) {
     CHECK_FAIL_RETURN_UNEXPECTED(!type_.IsString(), "Can not fill on tensor of type string or bytes.");
+    RETURN_IF_NOT_OK(CopyOnWrite());
     int64_t cellSize = type_.SizeInBytes();
     if ((data_ != nullptr) && type_.IsCompatible<T>()) {
       for (dsize_t i = 0; i < Size(); i++) {
@@ -765,6 +793,7 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> begin() {
+    (void)CopyOnWrite();
     return TensorIterator<T>(data_);
   }
 
@@ -773,6 +802,7 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> end() {
+    (void)CopyOnWrite();
     return TensorIterator<T>(data_end_);
   }
 
@@ -783,9 +813,14 @@ class DATASET_API Tensor {
   Status CopyLastDimAt(const std::shared_ptr<Tensor> &src, const std::vector<dsize_t> &index);
 
   /// Get the starting memory address for the data of the tensor.  This potentially
-  /// drives an allocation if the data is null.
+  /// drives an allocation if the data is null, or a copy if the tensor is a read-only view.
   /// \return unsigned char*
-  unsigned char *GetMutableBuffer() { return data_; }
+  unsigned char *GetMutableBuffer() {
+    if (CopyOnWrite().IsError()) {
+      return nullptr;
+    }
+    return data_;
+  }
 
  protected:
   /// Allocate memory for the tensor using the data_allocator
@@ -793,6 +828,18 @@ class DATASET_API Tensor {
   /// \return Error Status
   Status AllocateBuffer(const dsize_t &length);
 
+  /// Copy the data of a read-only view into a buffer of the tensor, so that it can be modified. No-op otherwise.
+  /// \return Error Status
+  Status CopyOnWrite() {
+    if (!copy_on_write_) {
+      return Status::OK();
+    }
+    return CopyViewData();
+  }
+
+  /// The slow path of CopyOnWrite
+  Status CopyViewData();
+
   /// A function that prints Tensor recursively, first called by print
   /// \param[in] out
   /// \param[in] cur_dim
@@ -845,6 +892,10 @@ class DATASET_API Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// the owner of data_ if the tensor is a view of memory it does not allocate
+  std::shared_ptr<void> data_owner_;
+  /// whether data_ is a read-only view which has to be copied before it is modified
+  bool copy_on_write_ = false;
 
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
@@ -24,7 +24,15 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      zero_copy_(true),
+      shared_(false) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -36,7 +44,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+                                       prefetch_size_, zero_copy_, shared_);
   return Status::OK();
 }
 
@@ -55,7 +63,7 @@ Status CacheClient::Builder::SanityCheck() {
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+                         int32_t port, int32_t num_connections, int32_t prefetch_size, bool zero_copy, bool shared)
     : cache_mem_sz_(cache_mem_sz),
       spill_(spill),
       server_connection_id_(0),
@@ -63,13 +71,39 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
+      zero_copy_(zero_copy),
+      shared_(shared),
+      num_rows_fetched_(0),
+      bytes_copied_(0),
+      bytes_in_place_(0),
       fetch_all_keys_(true) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname, port, num_connections_);
+  lease_releaser_ = std::make_shared<LeaseReleaser>(this);
+}
+
+void CacheClient::LeaseReleaser::Release(int64_t lease_id) {
+  std::unique_lock<std::mutex> lock(mux_);
+  if (cc_ == nullptr) {
+    return;
+  }
+  auto rq = std::make_shared<ReleaseRowsRequest>(cc_->server_connection_id_, cc_->client_id_, lease_id);
+  // We won't wait for the result for the sake of performance.
+  Status rc = cc_->PushRequest(rq);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to release the rows read in place. " << rc;
+  }
+}
+
+void CacheClient::LeaseReleaser::Detach() {
+  std::unique_lock<std::mutex> lock(mux_);
+  cc_ = nullptr;
 }
 
 CacheClient::~CacheClient() {
   cache_miss_keys_wp_.Set();
+  // The server drops the leases of the client when it disconnects below.
+  lease_releaser_->Detach();
   // Manually release the async buffer because we need the comm layer.
   if (async_buffer_stream_) {
     Status rc = async_buffer_stream_->ReleaseBuffer();
@@ -102,7 +136,8 @@ void CacheClient::Print(std::ostream &out) const {
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << GetCacheMemSz()
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Number of rpc workers: " << GetNumConnections()
       << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << SupportLocalClient() << "\n  Zero copy: " << std::boolalpha << isZeroCopy() << "\n  Shared: " << std::boolalpha
+      << isShared();
 }
 
 std::string CacheClient::GetHostname() const { return comm_->GetHostname(); }
@@ -134,6 +169,11 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   RETURN_IF_NOT_OK(rq->Wait());
   int64_t mem_addr;
   Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
+  if (rc.IsOk()) {
+    num_rows_fetched_ += static_cast<int64_t>(out->size());
+    bytes_copied_ += rq->BytesCopied();
+    bytes_in_place_ += rq->BytesInPlace();
+  }
   // Free the memory by sending a request back to the server.
   if (mem_addr != -1) {
     auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, mem_addr);
@@ -197,6 +237,9 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     if (generate_id) {
       createFlag |= CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
     }
+    if (shared_) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kShared;
+    }
     // Start the comm layer to receive reply
     RETURN_IF_NOT_OK(comm_->ServiceStart());
     // Initiate connection
@@ -226,7 +269,7 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
 
 Status CacheClient::DestroyCache() {
   UniqueLock lck(&mux_);
-  auto rq = std::make_shared<DestroyCacheRequest>(server_connection_id_);
+  auto rq = std::make_shared<DestroyCacheRequest>(server_connection_id_, cinfo_);
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
   return Status::OK();
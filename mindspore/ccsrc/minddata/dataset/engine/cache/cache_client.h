@@ -117,6 +117,22 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to let a local client read the rows in place from the shared memory of the server
+    /// \param zero_copy
+    /// \return Builder object itself
+    Builder &SetZeroCopy(bool zero_copy) {
+      zero_copy_ = zero_copy;
+      return *this;
+    }
+
+    /// Setter function to share the cache with the other sessions whose pipelines below the cache are the same
+    /// \param shared
+    /// \return Builder object itself
+    Builder &SetShared(bool shared) {
+      shared_ = shared;
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -125,6 +141,8 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    bool isZeroCopy() const { return zero_copy_; }
+    bool isShared() const { return shared_; }
 
     Status SanityCheck();
 
@@ -138,14 +156,25 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    bool zero_copy_;
+    bool shared_;
+  };
+
+  /// \brief Statistics of the rows fetched by a client
+  struct FetchStat {
+    int64_t num_rows;        // number of rows fetched
+    int64_t bytes_copied;    // bytes of tensor data copied out of the replies of the server
+    int64_t bytes_in_place;  // bytes of tensor data read in place from the shared memory of the server
   };
 
   /// \brief Constructor
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param zero_copy Read the rows in place from the shared memory of the server if it is local
+  /// \param shared Share the cache with the other sessions whose pipelines below the cache are the same
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+              int32_t num_connections, int32_t prefetch_size, bool zero_copy = true, bool shared = false);
 
   /// \brief Destructor
   ~CacheClient();
@@ -232,6 +261,13 @@ class CacheClient {
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
   int32_t GetClientId() const { return client_id_; }
+  bool isZeroCopy() const { return zero_copy_; }
+  bool isShared() const { return shared_; }
+
+  /// \brief Get the statistics of the rows fetched so far
+  FetchStat GetFetchStat() const {
+    return FetchStat{num_rows_fetched_.load(), bytes_copied_.load(), bytes_in_place_.load()};
+  }
   std::string GetHostname() const;
   int32_t GetPort() const;
 
@@ -287,6 +323,28 @@ class CacheClient {
   int32_t num_connections_;
   int32_t prefetch_size_;
   mutable std::shared_ptr<CacheClientGreeter> comm_;
+  bool zero_copy_;
+  bool shared_;
+  mutable std::atomic<int64_t> num_rows_fetched_;
+  mutable std::atomic<int64_t> bytes_copied_;
+  mutable std::atomic<int64_t> bytes_in_place_;
+  /// The rows a local client reads in place are leased to it by the server. All the tensors of a batch share
+  /// the lease, and the last of them to go releases it through this structure. Once the client is gone, the
+  /// server has dropped all its leases and there is nothing left to release.
+  class LeaseReleaser {
+   public:
+    explicit LeaseReleaser(const CacheClient *cc) : cc_(cc) {}
+    ~LeaseReleaser() = default;
+    /// Send a request to the server to release a lease without waiting for the result
+    void Release(int64_t lease_id);
+    /// Called by the client when it goes away
+    void Detach();
+
+   private:
+    std::mutex mux_;
+    const CacheClient *cc_;
+  };
+  std::shared_ptr<LeaseReleaser> lease_releaser_;
   std::atomic<bool> fetch_all_keys_;
   WaitPost cache_miss_keys_wp_;
   /// A structure shared by all the prefetchers to know what keys are missing at the server.
@@ -53,6 +53,13 @@ constexpr static uint32_t kLocalClientSupport = 1;
 /// \brief A flag used by CacheRow request (client side) and BatchFetch (server side) reply to indicate if the data is
 /// inline in the protobuf. This also implies kLocalClientSupport is also true.
 constexpr static uint32_t kDataIsInSharedMemory = 2;
+/// \brief A flag used by the BatchFetch request (client side) if it can read the rows in place from shared memory,
+/// and by the BatchFetch reply (server side) to indicate the rows are leased to the client instead of being copied.
+/// This also implies kLocalClientSupport is also true.
+constexpr static uint32_t kDataIsZeroCopy = 4;
+/// \brief Max ratio of the shared memory the server uses to keep cached rows for local clients to read in place.
+/// The rest is left for transferring rows.
+constexpr static float kZeroCopyMemoryRatio = 0.5;
 /// \brief Size of each message used in message queue.
 constexpr static int32_t kSharedMessageSize = 2048;
 /// \brief The default common path for all users
@@ -39,8 +39,10 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \param col_ts A serialized version of Tensor meta data
 /// \param data Tensor data wrapped in a slice
 /// \param out Tensor
+/// \param owner Optional. The owner of read-only data which a numeric tensor can be a view on instead of a copy
 /// \return Status object
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        const std::shared_ptr<void> &owner = nullptr);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
@@ -50,6 +50,10 @@ Status CacheClientGreeter::AttachToSharedMemory(bool *local_bypass) {
   // Attach to the shared memory
   mem_.SetPublicKey(shm_key);
   RETURN_IF_NOT_OK(mem_.Attach());
+  // A second mapping which can only be read, for the rows the client reads in place
+  auto read_only_mem = std::make_shared<SharedMemory>(shm_key);
+  RETURN_IF_NOT_OK(read_only_mem->Attach(true));
+  read_only_mem_ = std::move(read_only_mem);
   *local_bypass = true;
 #endif
   return Status::OK();
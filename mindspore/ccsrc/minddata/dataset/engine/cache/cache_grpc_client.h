@@ -88,6 +88,15 @@ class CacheClientGreeter : public Service {
   /// \return Base address of the shared memory.
   const void *SharedMemoryBaseAddr() const { return mem_.SharedMemoryBaseAddr(); }
 
+  /// \brief Return a read-only mapping of the shared memory, null if there is none. The pointer is the base address
+  /// and the mapping stays as long as a reference is held, even after this object is gone.
+  std::shared_ptr<void> ReadOnlySharedMemory() const {
+    if (read_only_mem_ == nullptr) {
+      return nullptr;
+    }
+    return std::shared_ptr<void>(read_only_mem_, read_only_mem_->SharedMemoryBaseAddr());
+  }
+
   std::string GetHostname() const { return hostname_; }
   int32_t GetPort() const { return port_; }
 
@@ -101,6 +110,7 @@ class CacheClientGreeter : public Service {
   mutable std::mutex mux_;
   std::map<int64_t, std::unique_ptr<CacheClientRequestTag>> req_;
   SharedMemory mem_;
+  std::shared_ptr<SharedMemory> read_only_mem_;
   std::string hostname_;
   int32_t port_;
 };
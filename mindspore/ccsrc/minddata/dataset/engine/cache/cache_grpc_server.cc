@@ -151,7 +151,7 @@ Status CacheServerRequest::operator()(CacheServerGreeter::AsyncService *svc, grp
     // Also some requests are urgent that we want to process them here too.
     if (type_ == BaseRequest::RequestType::kBatchFetchRows || type_ == BaseRequest::RequestType::kBatchCacheRows ||
         type_ == BaseRequest::RequestType::kStopService || type_ == BaseRequest::RequestType::kAllocateSharedBlock ||
-        type_ == BaseRequest::RequestType::kFreeSharedBlock) {
+        type_ == BaseRequest::RequestType::kFreeSharedBlock || type_ == BaseRequest::RequestType::kReleaseRows) {
       RETURN_IF_NOT_OK(cs.ProcessRequest(this));
       // WARNING. After we call ProcessRequest, the memory of 'this' is being recycled by ReturnRequestTag
       // asynchronously. Further access of 'this' is unpredictable.
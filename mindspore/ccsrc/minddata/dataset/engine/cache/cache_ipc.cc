@@ -112,12 +112,12 @@ Status SharedMemory::Create(int64_t sz) {
   return Status::OK();
 }
 
-Status SharedMemory::Attach() {
+Status SharedMemory::Attach(bool read_only) {
   shm_id_ = shmget(shm_key_, 0, 0);
   if (shm_id_ == -1) {
     RETURN_STATUS_UNEXPECTED("Shmget failed. Errno " + std::to_string(errno));
   }
-  shmat_addr_ = shmat(shm_id_, nullptr, 0);
+  shmat_addr_ = shmat(shm_id_, nullptr, read_only ? SHM_RDONLY : 0);
   if (shmat_addr_ == reinterpret_cast<void *>(-1)) {
     RETURN_STATUS_UNEXPECTED("Shared memory attach failed. Errno " + std::to_string(errno));
   }
@@ -169,8 +169,9 @@ class SharedMemory : public BaseIPC {
   void *SharedMemoryBaseAddr() { return shmat_addr_; }
 
   /// \brief Attach to shared memory
+  /// \param read_only Attach with read access only
   /// \return Status object
-  Status Attach();
+  Status Attach(bool read_only = false);
 
   /// Detach from shared memory
   /// \return Status object
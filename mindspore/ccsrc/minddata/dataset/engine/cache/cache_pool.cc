@@ -21,8 +21,45 @@
 
 namespace mindspore {
 namespace dataset {
+CachePool::SharedRows::~SharedRows() {
+  auto &cs = CacheServer::GetInstance();
+  for (auto &block : blocks_) {
+    cs.DeallocateZeroCopyMemory(block.first, block.second);
+  }
+  blocks_.clear();
+}
+
+Status CachePool::SharedRows::Allocate(size_t sz, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  auto &cs = CacheServer::GetInstance();
+  RETURN_IF_NOT_OK(cs.AllocateZeroCopyMemory(sz, p));
+  std::unique_lock<std::mutex> lock(mux_);
+  try {
+    blocks_.emplace(*p, sz);
+  } catch (const std::bad_alloc &e) {
+    cs.DeallocateZeroCopyMemory(*p, sz);
+    *p = nullptr;
+    RETURN_STATUS_OOM("Out of memory.");
+  }
+  return Status::OK();
+}
+
+void CachePool::SharedRows::Deallocate(void *p) {
+  std::unique_lock<std::mutex> lock(mux_);
+  auto it = blocks_.find(p);
+  if (it != blocks_.end()) {
+    CacheServer::GetInstance().DeallocateZeroCopyMemory(it->first, it->second);
+    (void)blocks_.erase(it);
+  }
+}
+
 CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+    : mp_(std::move(mp)),
+      shared_rows_(nullptr),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -40,6 +77,10 @@ Status CachePool::DoServiceStart() {
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
   }
+#ifdef CACHE_LOCAL_CLIENT
+  // Keep the buffers in shared memory as long as there is room, so that local clients can read them in place.
+  shared_rows_ = std::make_shared<SharedRows>();
+#endif
   return Status::OK();
 }
 
@@ -58,7 +99,9 @@ Status CachePool::DoServiceStop() {
   // since all of them are coming from NumaMemoryPool and we will
   // skip this and release the whole NumaMemoryPool instead. Otherwise
   // release each buffer in the DataLocator one by one.
-
+  // The buffers in shared memory may still be read by local clients. They are returned when the last client
+  // releases its lease on them.
+  shared_rows_.reset();
   tree_.reset();
   if (!root_.ToString().empty()) {
     Path spill = GetSpillPath();
@@ -96,7 +139,14 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
                     << ". The cache server will not cache any more data.";
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
   } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
+    rc = Status(StatusCode::kMDOutOfMemory);
+    if (shared_rows_ != nullptr) {
+      rc = shared_rows_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
+      bl.shared = rc.IsOk();
+    }
+    if (rc.IsError()) {
+      rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
+    }
     // Adjust the soft limit and usage counting when every 100M memory are used.
     if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
       soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
@@ -106,7 +156,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   if (rc.IsOk()) {
     temp_mem_usage_ += sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
-    if (CacheServerHW::numa_enabled()) {
+    if (CacheServerHW::numa_enabled() && !bl.shared) {
       auto &cs = CacheServer::GetInstance();
       auto node_id = cs.GetHWControl()->GetMyNode();
       bl.node_id = mp_->FindNode(bl.ptr);
@@ -125,7 +175,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       pos += v.GetSize();
     }
     if (rc.IsError()) {
-      mp_->Deallocate(bl.ptr);
+      FreeBuffer(bl);
       bl.ptr = nullptr;
       return rc;
     }
@@ -150,7 +200,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   }
   // Duplicate key is treated as error and we will also free the memory.
   if (rc.IsError() && bl.ptr != nullptr) {
-    mp_->Deallocate(bl.ptr);
+    FreeBuffer(bl);
     bl.ptr = nullptr;
     return rc;
   }
@@ -183,6 +233,14 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   return Status::OK();
 }
 
+void CachePool::FreeBuffer(const DataLocator &bl) {
+  if (bl.shared) {
+    shared_rows_->Deallocate(bl.ptr);
+  } else {
+    mp_->Deallocate(bl.ptr);
+  }
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -48,7 +49,7 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), shared(false), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
@@ -57,6 +58,7 @@ class CachePool : public Service {
       sz = other.sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
+      shared = other.shared;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
@@ -68,6 +70,7 @@ class CachePool : public Service {
         sz = other.sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
+        shared = other.shared;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
@@ -79,9 +82,34 @@ class CachePool : public Service {
     size_t sz;
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
+    bool shared;        // the memory is in the shared memory of the server
     StorageManager::key_type storage_key;
   };
 
+  /// \brief The buffers of a CachePool which are kept in the shared memory of the server, so that local clients can
+  /// read them in place. A client holds a reference to it while it reads, and the buffers are returned to the shared
+  /// memory only when both the pool and all the clients have let go of it.
+  class SharedRows {
+   public:
+    SharedRows() = default;
+    ~SharedRows();
+    SharedRows(const SharedRows &) = delete;
+    SharedRows &operator=(const SharedRows &) = delete;
+
+    /// \brief Allocate a buffer from the shared memory of the server
+    /// \param[in] sz Size of the buffer
+    /// \param[out] p Address of the buffer
+    /// \return Status object, kMDOutOfMemory if the server can't give out more shared memory for cached rows
+    Status Allocate(size_t sz, void **p);
+
+    /// \brief Return a buffer which is no longer needed
+    void Deallocate(void *p);
+
+   private:
+    std::mutex mux_;
+    std::map<void *, size_t> blocks_;
+  };
+
   using data_index = BPlusTree<int64_t, DataLocator>;
   using key_type = data_index::key_type;
   using bl_alloc_type = typename value_allocator::template rebind<DataLocator>::other;
@@ -143,8 +171,12 @@ class CachePool : public Service {
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
+  /// \brief Get the buffers kept in shared memory, null if the pool doesn't use shared memory
+  std::shared_ptr<SharedRows> GetSharedRows() const { return shared_rows_; }
+
  private:
   std::shared_ptr<NumaMemoryPool> mp_;
+  std::shared_ptr<SharedRows> shared_rows_;
   Path root_;
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
@@ -154,6 +186,9 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  /// \brief Return the memory of a buffer to where it is allocated from
+  void FreeBuffer(const DataLocator &bl);
 };
 }  // namespace dataset
 }  // namespace mindspore
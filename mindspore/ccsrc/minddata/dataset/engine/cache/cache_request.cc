@@ -139,10 +139,24 @@ CacheRowRequest::CacheRowRequest(const CacheClient *cc)
 }
 
 BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id)
-    : BaseRequest(RequestType::kBatchFetchRows), support_local_bypass_(cc->local_bypass_), row_id_(row_id) {
+    : BaseRequest(RequestType::kBatchFetchRows),
+      support_local_bypass_(cc->local_bypass_),
+      row_id_(row_id),
+      bytes_copied_(0),
+      bytes_in_place_(0) {
   rq_.set_connection_id(cc->server_connection_id_);
   rq_.set_client_id(cc->client_id_);
-  rq_.set_flag(support_local_bypass_ ? kLocalClientSupport : 0);
+  uint32_t flag = support_local_bypass_ ? kLocalClientSupport : 0;
+  if (support_local_bypass_ && cc->isZeroCopy()) {
+    read_only_mem_ = cc->comm_->ReadOnlySharedMemory();
+  }
+  if (read_only_mem_ != nullptr) {
+    // The releaser outlives the client if the tensors do.
+    auto releaser = cc->lease_releaser_;
+    release_rows_ = [releaser](int64_t lease_id) { releaser->Release(lease_id); };
+    flag |= kDataIsZeroCopy;
+  }
+  rq_.set_flag(flag);
   // Convert the row id into a flatbuffer
   flatbuffers::FlatBufferBuilder fbb;
   auto off_t = fbb.CreateVector(row_id);
@@ -161,6 +175,10 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
   // Tap into the reply flag to see where we can find the data. Server may decide the amount is
   // so small that it doesn't use shared memory method.
   auto flag = reply_.flag();
+  if (read_only_mem_ != nullptr && BitTest(flag, kDataIsZeroCopy)) {
+    *out_addr = -1;
+    return RestoreRowsInPlace(out);
+  }
   bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
   if (dataOnSharedMemory) {
     auto addr = strtoll(reply_.result().data(), nullptr, kDecimal);
@@ -196,6 +214,55 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
         row.push_back(ts);
         ts_offset += data.GetSize();
+        bytes_copied_ += static_cast<int64_t>(data.GetSize());
+      }
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(len == 0, "Data corruption detected.");
+    }
+    tbl.push_back(std::move(row));
+  }
+  *out = std::move(tbl);
+  return Status::OK();
+}
+
+Status BatchFetchRequest::RestoreRowsInPlace(TensorTable *out) {
+  auto num_elements = row_id_.size();
+  // The reply is the lease id followed by the offset and the size of each row in the shared memory.
+  const auto &result = reply_.result();
+  CHECK_FAIL_RETURN_UNEXPECTED(result.length() == sizeof(int64_t) * (2 * num_elements + 1), "Length mismatch");
+  auto *lease_array = reinterpret_cast<const int64_t *>(result.data());
+  auto lease_id = lease_array[0];
+  // All the tensors of the batch share the lease. The last of them to go releases the rows at the server, and
+  // keeps the shared memory mapped until then.
+  auto mem = read_only_mem_;
+  auto release_rows = release_rows_;
+  std::shared_ptr<void> lease(mem.get(), [mem, release_rows, lease_id](void *) { release_rows(lease_id); });
+  auto base = reinterpret_cast<const char *>(mem.get());
+  TensorTable tbl;
+  tbl.reserve(num_elements);
+  for (auto i = 0; i < num_elements; ++i) {
+    auto offset = lease_array[2 * i + 1];
+    auto len = lease_array[2 * i + 2];
+    TensorRow row;
+    row.setId(row_id_.at(i));
+    if (len > 0) {
+      ReadableSlice row_data(base + offset, len);
+      auto msg = GetTensorRowHeaderMsg(row_data.GetPointer());
+      auto ts_offset = msg->size_of_this();
+      row.reserve(msg->column()->size());
+      for (auto k = 0; k < msg->column()->size(); ++k) {
+        auto col_ts = msg->column()->Get(k);
+        std::shared_ptr<Tensor> ts;
+        ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts, lease));
+        row.push_back(ts);
+        ts_offset += data.GetSize();
+        // Strings are still copied
+        if (ts->type().IsNumeric()) {
+          bytes_in_place_ += static_cast<int64_t>(data.GetSize());
+        } else {
+          bytes_copied_ += static_cast<int64_t>(data.GetSize());
+        }
       }
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(len == 0, "Data corruption detected.");
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_REQ_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <iostream>
 #include <string>
@@ -87,6 +88,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kReleaseRows = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -148,7 +150,8 @@ class BaseRequest {
            type_ == RequestType::kCacheSchema || type_ == RequestType::kFetchSchema ||
            type_ == RequestType::kBuildPhaseDone || type_ == RequestType::kToggleWriteMode ||
            type_ == RequestType::kConnectReset || type_ == RequestType::kStopService ||
-           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys;
+           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys ||
+           type_ == RequestType::kReleaseRows;
   }
 
   /// \brief Return if the request is of session request type
@@ -179,6 +182,19 @@ class FreeSharedBlockRequest : public BaseRequest {
   ~FreeSharedBlockRequest() override = default;
 };
 
+/// \brief Request to release the rows leased to a local client by a BatchFetch request
+class ReleaseRowsRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  explicit ReleaseRowsRequest(connection_id_type connection_id, int32_t client_id, int64_t lease_id)
+      : BaseRequest(RequestType::kReleaseRows) {
+    rq_.set_connection_id(connection_id);
+    rq_.add_buf_data(std::to_string(lease_id));
+    rq_.set_client_id(client_id);
+  }
+  ~ReleaseRowsRequest() override = default;
+};
+
 /// \brief Request to cache a single TensorRow
 class CacheRowRequest : public BaseRequest {
  public:
@@ -235,16 +251,30 @@ class BatchFetchRequest : public BaseRequest {
   ~BatchFetchRequest() override = default;
   Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
 
+  /// \brief Bytes of tensor data restored by copying them out of the reply
+  int64_t BytesCopied() const { return bytes_copied_; }
+
+  /// \brief Bytes of tensor data restored in place from the shared memory of the server
+  int64_t BytesInPlace() const { return bytes_in_place_; }
+
  private:
   bool support_local_bypass_;
   std::vector<row_id_type> row_id_;
+  // Read-only mapping of the shared memory and the function to release the rows leased to us when the server
+  // lets us read them in place. Both are null if zero copy is not enabled.
+  std::shared_ptr<void> read_only_mem_;
+  std::function<void(int64_t)> release_rows_;
+  int64_t bytes_copied_;
+  int64_t bytes_in_place_;
+
+  Status RestoreRowsInPlace(TensorTable *out);
 };
 
 /// \brief Request to create a cache for the current connection
 class CreateCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L };
+  enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L, kShared = 1u << 2L };
 
   /// \brief Constructor
   /// \param connection_id
@@ -275,12 +305,14 @@ class GetCacheMissKeysRequest : public BaseRequest {
   ~GetCacheMissKeysRequest() override = default;
 };
 
-/// \brief Request to destroy a cache
+/// \brief Request to destroy a cache. A cache shared by other sessions is only detached from the session of the client.
 class DestroyCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  explicit DestroyCacheRequest(connection_id_type connection_id) : BaseRequest(RequestType::kDestroyCache) {
+  DestroyCacheRequest(connection_id_type connection_id, const CacheClientInfo &cinfo)
+      : BaseRequest(RequestType::kDestroyCache) {
     rq_.set_connection_id(connection_id);
+    rq_.mutable_connection_info()->operator=(cinfo);
   }
   ~DestroyCacheRequest() override = default;
 };
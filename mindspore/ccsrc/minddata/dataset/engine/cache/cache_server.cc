@@ -125,6 +125,11 @@ Status CacheServer::DoServiceStop() {
     }
     ++it;
   }
+  // Return the rows still leased to the clients to the shared memory.
+  {
+    std::unique_lock<std::mutex> lease_lock(lease_mux_);
+    leases_.clear();
+  }
   // Also remove the path we use to generate ftok.
   Path p(PortToUnixSocketPath(port_));
   (void)p.Remove();
@@ -210,6 +215,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     (flag & CreateCacheRequest::CreateCacheFlag::kSpillToDisk) == CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
   bool generate_id =
     (flag & CreateCacheRequest::CreateCacheFlag::kGenerateRowId) == CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
+  bool shared = (flag & CreateCacheRequest::CreateCacheFlag::kShared) == CreateCacheRequest::CreateCacheFlag::kShared;
   if (spill && top_.empty()) {
     RETURN_STATUS_UNEXPECTED("Server is not set up with spill support.");
   }
@@ -218,6 +224,14 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   // The first create will be successful and be given a special cookie.
   UniqueLock lck(&rwLock_);
   bool duplicate = false;
+  // A shared cache is keyed by the crc alone, so a session with the same pipeline below the cache attaches to the cache
+  // created by another session.
+  if (shared) {
+    auto shared_it = shared_caches_.find(crc);
+    if (shared_it != shared_caches_.end()) {
+      connection_id = shared_it->second;
+    }
+  }
   CacheService *curr_cs = GetService(connection_id);
   if (curr_cs != nullptr) {
     duplicate = true;
@@ -243,6 +257,13 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
       RETURN_STATUS_OOM("Out of memory.");
     }
   }
+  if (shared) {
+    (void)shared_caches_.emplace(crc, connection_id);
+    auto &sessions = shared_cache_sessions_[connection_id];
+    (void)sessions.insert(session_id);
+    MS_LOG(INFO) << "Session " << session_id << " shares cache " << connection_id << " with " << sessions.size() - 1
+                 << " other sessions";
+  }
 
   // Shuffle the worker threads. But we need to release the locks or we will deadlock when calling
   // the following function
@@ -277,6 +298,12 @@ Status CacheServer::DestroyCache(CacheRequest *rq) {
   CacheService *cs = GetService(id);
   // it is already destroyed. Ignore it.
   if (cs != nullptr) {
+    // A shared cache is only dropped when the last session using it lets it go
+    auto session_id = rq->has_connection_info() ? rq->connection_info().session_id() : GetSessionID(id);
+    if (!DetachSession(id, session_id)) {
+      MS_LOG(INFO) << "Session " << session_id << " detached from shared cache " << id << ", which is still in use";
+      return Status::OK();
+    }
     MS_LOG(WARNING) << "Dropping cache with connection id " << std::to_string(id);
     // std::map will invoke the destructor of CacheService. So we don't need to do anything here.
     auto n = all_caches_.erase(id);
@@ -510,10 +537,21 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     }
     std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
     RETURN_IF_NOT_OK(cs->PreBatchFetch(connection_id, row_id, fbb));
+    // A local client which can read the rows in place takes a reference on the rows in shared memory, which
+    // keeps them even if the cache is destroyed.
+    std::shared_ptr<CachePool::SharedRows> shared_rows =
+      BitTest(rq->flag(), kDataIsZeroCopy) ? cs->GetSharedRows() : nullptr;
     // Let go of the shared lock. We don't need to interact with the CacheService anymore.
     // We shouldn't be holding any lock while we can wait for a long time for the rows to come back.
     lck.Unlock();
     auto locator = flatbuffers::GetRoot<BatchDataLocatorMsg>(fbb->GetBufferPointer());
+    if (shared_rows != nullptr) {
+      bool leased = false;
+      RETURN_IF_NOT_OK(LeaseRows(rq, shared_rows, locator, reply, &leased));
+      if (leased) {
+        return Status::OK();
+      }
+    }
     int64_t mem_sz = sizeof(int64_t) * (sz + 1);
     for (auto i = 0; i < sz; ++i) {
       auto row_sz = locator->rows()->Get(i)->size();
@@ -564,6 +602,62 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
   return Status::OK();
 }
 
+Status CacheServer::LeaseRows(const CacheRequest *rq, const std::shared_ptr<CachePool::SharedRows> &rows,
+                              const BatchDataLocatorMsg *locator, CacheReply *reply, bool *leased) {
+  RETURN_UNEXPECTED_IF_NULL(locator);
+  RETURN_UNEXPECTED_IF_NULL(leased);
+  *leased = false;
+  const auto num_elements = locator->rows()->size();
+  auto base = reinterpret_cast<int64_t>(SharedMemoryBaseAddr());
+  // The lease id followed by the offset and the size of each row. A row not in the cache has a size of 0.
+  std::string mem;
+  try {
+    mem.resize(sizeof(int64_t) * (2 * num_elements + 1));
+  } catch (const std::bad_alloc &e) {
+    RETURN_STATUS_OOM("Out of memory.");
+  }
+  auto *lease_array = reinterpret_cast<int64_t *>(mem.data());
+  for (uint32_t i = 0; i < num_elements; ++i) {
+    auto data_locator = locator->rows()->Get(i);
+    auto *addr = reinterpret_cast<const void *>(data_locator->addr());
+    size_t sz = data_locator->size();
+    // Rows which are spilled or don't fit in the shared memory are copied as usual.
+    if (sz > 0 && !IsInSharedMemory(addr, sz)) {
+      return Status::OK();
+    }
+    lease_array[2 * i + 1] = sz > 0 ? reinterpret_cast<int64_t>(addr) - base : 0;
+    lease_array[2 * i + 2] = static_cast<int64_t>(sz);
+  }
+  {
+    std::unique_lock<std::mutex> lock(lease_mux_);
+    lease_array[0] = next_lease_id_++;
+    (void)leases_.emplace(lease_array[0], RowLease{rq->connection_id(), rq->client_id(), rows});
+  }
+  reply->set_flag(kDataIsZeroCopy);
+  reply->set_result(std::move(mem));
+  *leased = true;
+  return Status::OK();
+}
+
+Status CacheServer::ReleaseRows(CacheRequest *rq) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!rq->buf_data().empty(), "Missing lease id");
+  std::shared_ptr<CachePool::SharedRows> rows;
+  try {
+    auto lease_id = strtoll(rq->buf_data(0).data(), nullptr, kDecimal);
+    std::unique_lock<std::mutex> lock(lease_mux_);
+    auto it = leases_.find(lease_id);
+    // The lease is gone already if the client has disconnected.
+    if (it != leases_.end()) {
+      // Let the rows go after we unlock, the last reference returns them to the shared memory.
+      rows = std::move(it->second.rows);
+      (void)leases_.erase(it);
+    }
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED(e.what());
+  }
+  return Status::OK();
+}
+
 Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   // Hold the shared lock to prevent the cache from being dropped.
@@ -710,7 +804,7 @@ Status CacheServer::ListSessions(CacheReply *reply) {
     bool found = false;
     for (auto const &it : all_caches_) {
       auto current_conn_id = it.first;
-      if (GetSessionID(current_conn_id) == current_session_id) {
+      if (IsCacheOfSession(current_conn_id, current_session_id)) {
         found = true;
         auto &cs = it.second;
         CacheService::ServiceStat svc_stat;
@@ -755,6 +849,15 @@ Status CacheServer::ConnectReset(CacheRequest *rq) {
     auto client_id = rq->client_id();
     MS_LOG(WARNING) << "Client id " << client_id << " with connection id " << connection_id << " disconnects";
     cs->num_clients_--;
+    // The client won't release the rows it still holds.
+    std::unique_lock<std::mutex> lease_lock(lease_mux_);
+    for (auto lease = leases_.begin(); lease != leases_.end();) {
+      if (lease->second.connection_id == connection_id && lease->second.client_id == client_id) {
+        lease = leases_.erase(lease);
+      } else {
+        ++lease;
+      }
+    }
   }
   return Status::OK();
 }
@@ -911,6 +1014,10 @@ Status CacheServer::ProcessAdminRequest(CacheServerRequest *cache_req) {
       cache_req->rc_ = FreeSharedMemory(&rq);
       break;
     }
+    case BaseRequest::RequestType::kReleaseRows: {
+      cache_req->rc_ = ReleaseRows(&rq);
+      break;
+    }
     case BaseRequest::RequestType::kStopService: {
       // This command shutdowns everything.
       // But we first reply back to the client that we receive the request.
@@ -998,6 +1105,29 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
   return static_cast<session_id_type>(connection_id >> 32u);
 }
 
+bool CacheServer::IsCacheOfSession(connection_id_type connection_id, session_id_type session_id) const {
+  auto it = shared_cache_sessions_.find(connection_id);
+  if (it == shared_cache_sessions_.end()) {
+    return GetSessionID(connection_id) == session_id;
+  }
+  return it->second.count(session_id) > 0;
+}
+
+bool CacheServer::DetachSession(connection_id_type connection_id, session_id_type session_id) {
+  auto it = shared_cache_sessions_.find(connection_id);
+  if (it == shared_cache_sessions_.end()) {
+    return true;
+  }
+  (void)it->second.erase(session_id);
+  if (!it->second.empty()) {
+    return false;
+  }
+  (void)shared_cache_sessions_.erase(it);
+  // The crc is the lower half of the connection id
+  (void)shared_caches_.erase(static_cast<uint32_t>(connection_id));
+  return true;
+}
+
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
                          int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
                          std::shared_ptr<CacheServerHW> hw_info)
@@ -1010,7 +1140,10 @@ CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int
       memory_cap_ratio_(memory_cap_ratio),
       numa_affinity_(true),
       log_level_(log_level),
-      hw_info_(std::move(hw_info)) {
+      hw_info_(std::move(hw_info)),
+      zero_copy_mem_usage_(0),
+      zero_copy_slot_(0),
+      next_lease_id_(0) {
   // If we are not linked with numa library (i.e. NUMA_ENABLED is false), turn off cpu
   // affinity which can make performance worse.
   if (!CacheServerHW::numa_enabled()) {
@@ -1074,16 +1207,19 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   bool found = false;
   for (auto it = all_caches_.begin(); it != all_caches_.end();) {
     auto connection_id = it->first;
-    auto session_id = GetSessionID(connection_id);
     // We can just call DestroyCache() but we are holding a lock already. Doing so will cause deadlock.
     // So we will just manually do it.
-    if (session_id == drop_session_id) {
+    if (IsCacheOfSession(connection_id, drop_session_id)) {
       found = true;
-      it = all_caches_.erase(it);
-      MS_LOG(INFO) << "Destroy cache with id " << connection_id;
-    } else {
-      ++it;
+      // A cache shared with other sessions stays until the last of them is dropped
+      if (DetachSession(connection_id, drop_session_id)) {
+        it = all_caches_.erase(it);
+        MS_LOG(INFO) << "Destroy cache with id " << connection_id;
+        continue;
+      }
+      MS_LOG(INFO) << "Session " << drop_session_id << " detached from shared cache " << connection_id;
     }
+    ++it;
   }
   // Finally remove the session itself
   auto n = active_sessions_.erase(drop_session_id);
@@ -1226,6 +1362,37 @@ Status CacheServer::AllocateSharedMemory(int32_t client_id, size_t sz, void **p)
 
 void CacheServer::DeallocateSharedMemory(int32_t client_id, void *p) { shm_->DeallocateSharedMemory(client_id, p); }
 
+Status CacheServer::AllocateZeroCopyMemory(size_t sz, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  CHECK_FAIL_RETURN_UNEXPECTED(shm_ != nullptr, "Shared memory is not set up.");
+  const auto limit = static_cast<int64_t>(shared_memory_sz_in_gb_ * 1073741824L * kZeroCopyMemoryRatio);
+  if (zero_copy_mem_usage_.fetch_add(sz) + static_cast<int64_t>(sz) > limit) {
+    zero_copy_mem_usage_ -= sz;
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  // Spread the rows over all the sub pools of the shared memory.
+  Status rc = AllocateSharedMemory(zero_copy_slot_.fetch_add(1) & std::numeric_limits<int32_t>::max(), sz, p);
+  if (rc.IsError()) {
+    zero_copy_mem_usage_ -= sz;
+  }
+  return rc;
+}
+
+void CacheServer::DeallocateZeroCopyMemory(void *p, size_t sz) {
+  DeallocateSharedMemory(0, p);
+  zero_copy_mem_usage_ -= sz;
+}
+
+bool CacheServer::IsInSharedMemory(const void *p, size_t sz) const {
+  if (shm_ == nullptr || p == nullptr) {
+    return false;
+  }
+  auto base = reinterpret_cast<uintptr_t>(SharedMemoryBaseAddr());
+  auto addr = reinterpret_cast<uintptr_t>(p);
+  auto shm_sz = static_cast<uintptr_t>(shared_memory_sz_in_gb_) * 1073741824L;
+  return addr >= base && addr - base <= shm_sz && sz <= shm_sz - (addr - base);
+}
+
 Status CacheServer::Builder::IpcResourceCleanup() {
   Status rc;
   SharedMemory::shm_key_t shm_key;
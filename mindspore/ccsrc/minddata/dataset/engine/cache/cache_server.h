@@ -275,7 +275,27 @@ class CacheServer : public Service {
 
   void DeallocateSharedMemory(int32_t client_id, void *p);
 
+  /// \brief Allocate a block of shared memory to keep a cached row in, so that local clients can read it in place.
+  /// At most kZeroCopyMemoryRatio of the shared memory is given out this way.
+  /// \param[in] sz Size of the block
+  /// \param[out] p Address of the block
+  /// \return Status object, kMDOutOfMemory if the limit is reached
+  Status AllocateZeroCopyMemory(size_t sz, void **p);
+
+  /// \brief Return a block allocated by AllocateZeroCopyMemory
+  void DeallocateZeroCopyMemory(void *p, size_t sz);
+
+  /// \brief Check if a buffer lies in the shared memory
+  bool IsInSharedMemory(const void *p, size_t sz) const;
+
  private:
+  /// \brief The rows of a cache which a local client reads in place, they are kept until the client releases them
+  struct RowLease {
+    connection_id_type connection_id;
+    int32_t client_id;
+    std::shared_ptr<CachePool::SharedRows> rows;
+  };
+
   static std::once_flag init_instance_flag_;
   static CacheServer *instance_;
   mutable RWLock rwLock_;
@@ -283,6 +303,10 @@ class CacheServer : public Service {
   std::string top_;
   cache_index all_caches_;
   std::set<session_id_type> active_sessions_;
+  // The caches shared across sessions keyed by the crc of the pipeline below the cache, and the sessions using each of
+  // them. A shared cache is dropped with the last session using it. Both are protected by rwLock_.
+  std::map<uint32_t, connection_id_type> shared_caches_;
+  std::map<connection_id_type, std::set<session_id_type>> shared_cache_sessions_;
   std::shared_ptr<QueueList<CacheServerRequest *>> cache_q_;
   std::shared_ptr<CacheServerGreeterImpl> comm_layer_;
   TaskGroup vg_;
@@ -298,6 +322,11 @@ class CacheServer : public Service {
   bool numa_affinity_;
   std::vector<int32_t> shutdown_qIDs_;
   std::unique_ptr<CachedSharedMemory> shm_;
+  std::atomic<int64_t> zero_copy_mem_usage_;
+  std::atomic<int32_t> zero_copy_slot_;
+  std::mutex lease_mux_;
+  int64_t next_lease_id_;
+  std::map<int64_t, RowLease> leases_;
 
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
@@ -346,6 +375,15 @@ class CacheServer : public Service {
   /// \return session id
   session_id_type GetSessionID(connection_id_type connection_id) const;
 
+  /// \brief Check if a session is using a cache, either it has created the cache or it shares it.
+  /// \note Caller must hold rwLock_
+  bool IsCacheOfSession(connection_id_type connection_id, session_id_type session_id) const;
+
+  /// \brief Detach a session from a cache it is using
+  /// \note Caller must hold rwLock_
+  /// \return true if no session uses the cache any more and it can be dropped
+  bool DetachSession(connection_id_type connection_id, session_id_type session_id);
+
   /// \brief Generate a session ID for the client
   /// \return Session ID
   session_id_type GenerateSessionID();
@@ -361,6 +399,22 @@ class CacheServer : public Service {
   /// \return Status object
   Status FreeSharedMemory(CacheRequest *rq);
 
+  /// \brief Handle kReleaseRows request
+  /// \param rq
+  /// \return Status object
+  Status ReleaseRows(CacheRequest *rq);
+
+  /// \brief Lease the rows of a batch to a local client if all of them are in shared memory. The reply carries the
+  /// lease id followed by the offset and the size of each row instead of the rows.
+  /// \param[in] rq The BatchFetch request
+  /// \param[in] rows The buffers of the cache in shared memory
+  /// \param[in] locator Where the rows are
+  /// \param[out] reply The BatchFetch reply
+  /// \param[out] leased If the rows are leased. The rows are copied into the reply as usual if not.
+  /// \return Status object
+  Status LeaseRows(const CacheRequest *rq, const std::shared_ptr<CachePool::SharedRows> &rows,
+                   const BatchDataLocatorMsg *locator, CacheReply *reply, bool *leased);
+
   /// \brief Handle CacheRow request
   /// \note There are two different implementation depends if shared memory is used for transportation.
   /// \return Status object
@@ -123,6 +123,8 @@ class CacheService : public Service {
   Status BuildPhaseDone();
   /// \brief For kToggleWriteMode request
   Status ToggleWriteMode(bool on_off);
+  /// \brief The rows of the cache kept in shared memory, null if there is none
+  std::shared_ptr<CachePool::SharedRows> GetSharedRows() const { return cp_ ? cp_->GetSharedRows() : nullptr; }
 
  private:
   mutable RWLock rw_lock_;
@@ -30,6 +30,8 @@
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/sig_handler.h"
 
+constexpr int64_t kMBToBytes = 1048576;
+constexpr int64_t kSecToMs = 1000;
 constexpr int64_t field_width_ten = 10;
 constexpr int64_t field_width_eleven = 11;
 constexpr int64_t field_width_twelve = 12;
@@ -66,6 +68,8 @@ void CachePerfRun::PrintHelp() {
             << " (Mb)\n"
                "       --spill:          Set spill to disk to True. Default = "
             << std::boolalpha << kDftSpill << "\n"
+            << "       --no_zero_copy:   Copy the rows out of the shared memory of a local server instead of reading "
+               "them in place\n"
             << "    -w,--workers:        Set the number of parallel workers. Default = " << cfg_.num_parallel_workers()
             << "\n"
                "       --connection:     Set number of TCP/IP connections per pipeline. Default = "
@@ -206,6 +210,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 
   int shuffle = 0;
   int spill = 0;
+  int no_zero_copy = 0;
 
   const char *const short_opts = ":n:e:p:a:s:r:w:";
   const option long_opts[] = {{"pipeline", required_argument, nullptr, 'n'},
@@ -219,6 +224,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
                               {"port", required_argument, nullptr, port_opt},
                               {"hostname", required_argument, nullptr, hostname_opt},
                               {"spill", no_argument, &spill, 1},
+                              {"no_zero_copy", no_argument, &no_zero_copy, 1},
                               {"connection", required_argument, nullptr, connect_opt},
                               {"help", no_argument, nullptr, 'h'},
                               {nullptr, no_argument, nullptr, 0}};
@@ -257,6 +263,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
           shuffle_ = true;
         } else if (long_opts[option_indxex].flag == &spill) {
           cache_builder_.SetSpill(true);
+        } else if (long_opts[option_indxex].flag == &no_zero_copy) {
+          cache_builder_.SetZeroCopy(false);
         }
         continue;
       }
@@ -301,7 +309,10 @@ CachePerfRun::CachePerfRun()
       shuffle_(kDftShuffle),
       session_(0),
       crc_(0),
-      epoch_sync_cnt_(0) {
+      epoch_sync_cnt_(0),
+      epoch_rows_(0),
+      epoch_bytes_copied_(0),
+      epoch_bytes_in_place_(0) {
   cache_builder_.SetSpill(kDftSpill).SetCacheMemSz(kDftCacheSize);
 }
 
@@ -395,6 +406,12 @@ Status CachePerfRun::ListenToPipeline(int32_t workerId) {
       case CachePerfMsg::MessageType::kEpochEnd: {
         EpochDone proto;
         CHECK_FAIL_RETURN_UNEXPECTED(proto.ParseFromArray(p, msg.GetProtoBufSz()), "Parse fail");
+        {
+          std::unique_lock<std::mutex> lock(mux_);
+          epoch_rows_ += proto.rows();
+          epoch_bytes_copied_ += proto.bytes_copied();
+          epoch_bytes_in_place_ += proto.bytes_in_place();
+        }
         auto n = epoch_sync_cnt_.fetch_add(1);
         if (n + 1 == num_pipelines_) {
           pipeline_wp_.Set();
@@ -465,7 +482,9 @@ Status CachePerfRun::StartPipelines() {
                                std::to_string(cache_builder_.GetPrefetchSize()) + "," +
                                std::to_string(cache_builder_.GetCacheMemSz()) + "," +
                                std::to_string(cache_builder_.GetNumConnections()) + "," +
-                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data());
+                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data()) +
+                               "," +
+                               (cache_builder_.isZeroCopy() ? std::string("true").data() : std::string("false").data());
       char *argv[4];
       argv[0] = const_cast<char *>(kCachePipelineBinary);
       argv[1] = pipeline_cfg.data();
@@ -591,6 +610,9 @@ Status CachePerfRun::Run() {
     epoch_sync_cnt_ = 0;
     pipeline_wp_.Clear();
     epoch_results_.clear();
+    epoch_rows_ = 0;
+    epoch_bytes_copied_ = 0;
+    epoch_bytes_in_place_ = 0;
     start_tick = std::chrono::steady_clock::now();
     // Signal each pipeline to start
     for (auto msg_qid : msg_send_lists_) {
@@ -603,6 +625,11 @@ Status CachePerfRun::Run() {
     end_tick = std::chrono::steady_clock::now();
     elapse_time = std::chrono::duration_cast<std::chrono::seconds>(end_tick - start_tick).count();
     std::cout << "Epoch " << epoch_num << " elapsed time " << elapse_time << " seconds" << std::endl;
+    auto elapse_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_tick - start_tick).count();
+    std::cout << "Epoch " << epoch_num << " fetched " << epoch_rows_ << " rows, "
+              << epoch_bytes_copied_ / kMBToBytes << " MB copied, " << epoch_bytes_in_place_ / kMBToBytes
+              << " MB read in place, "
+              << (elapse_ms > 0 ? epoch_rows_ * kSecToMs / elapse_ms : epoch_rows_) << " rows/s" << std::endl;
     std::cout << "Epoch " << epoch_num
               << " (read phase) per pipeline per worker summary. Buffer size = " << cc_->GetPrefetchSize() << std::endl;
     PrintEpochSummary();
@@ -85,6 +85,9 @@ class CachePerfRun {
   std::vector<int32_t> msg_recv_lists_;
   TaskGroup vg_;
   std::atomic<int32_t> epoch_sync_cnt_;
+  int64_t epoch_rows_;
+  int64_t epoch_bytes_copied_;
+  int64_t epoch_bytes_in_place_;
   WaitPost pipeline_wp_;
   std::map<std::pair<int32_t, int32_t>, PipelineWorkerEpochSummary> epoch_results_;
   ConfigManager cfg_;
@@ -88,11 +88,13 @@ int32_t CachePipelineRun::ProcessClientArgs(char *argv) {
         cache_builder_.SetNumConnections(std::stoi(s));
       } else if (numArgs == 5) {
         cache_builder_.SetSpill(strcmp(s.data(), "true") == 0);
+      } else if (numArgs == 6) {
+        cache_builder_.SetZeroCopy(strcmp(s.data(), "true") == 0);
       }
       ++numArgs;
     }
-    if (numArgs != 6) {
-      std::cerr << "Incomplete arguments. Expect 6. But get " << numArgs << std::endl;
+    if (numArgs != 7) {
+      std::cerr << "Incomplete arguments. Expect 7. But get " << numArgs << std::endl;
       return -1;
     }
   } catch (const std::exception &e) {
@@ -351,6 +353,7 @@ Status CachePipelineRun::RunReadEpoch() {
   std::vector<row_id_type> keys;
   auto num_workers = cfg_.num_parallel_workers();
   keys.reserve(1);
+  auto fetch_stat = cc_->GetFetchStat();
   // Spawn workers
   auto f = std::bind(&CachePipelineRun::ReaderWorkerEntry, this, std::placeholders::_1);
   std::vector<Task *> worker_threads;
@@ -392,9 +395,13 @@ Status CachePipelineRun::RunReadEpoch() {
     RETURN_IF_NOT_OK(pTask->Join(Task::WaitFlag::kBlocking));
   }
 
-  // Send a message saying epoch one done for this pipeline.
+  // Send a message saying epoch one done for this pipeline, with what we have fetched in this epoch.
+  auto end_stat = cc_->GetFetchStat();
   EpochDone proto;
   proto.set_pipeline(my_pipeline_);
+  proto.set_rows(end_stat.num_rows - fetch_stat.num_rows);
+  proto.set_bytes_copied(end_stat.bytes_copied - fetch_stat.bytes_copied);
+  proto.set_bytes_in_place(end_stat.bytes_in_place - fetch_stat.bytes_in_place);
   CachePerfMsg msg;
   RETURN_IF_NOT_OK(SendMessage(&msg, CachePerfMsg::MessageType::kEpochEnd, &proto));
   return Status::OK();
@@ -151,6 +151,24 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::ReadRange(StorageManager::key_type key, size_t offset, WritableSlice *dest) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  auto r = index_.Search(key);
+  if (!r.second) {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  value_type v = *(r.first);
+  size_t sz = v.second.second;
+  if (offset > sz || dest->GetSize() > sz - offset) {
+    std::string errMsg = "Range out of bound. Offset = " + std::to_string(offset) +
+                         ", length = " + std::to_string(dest->GetSize()) + ", size = " + std::to_string(sz);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  auto cont = containers_.at(v.first);
+  RETURN_IF_NOT_OK(cont->Read(dest, v.second.first + static_cast<off_t>(offset)));
+  return Status::OK();
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
@@ -66,6 +66,13 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Read a range of a value
+  /// \param[in] key The key returned by Write
+  /// \param[in] offset The offset of the range within the value
+  /// \param[in] dest The destination, whose size is the length of the range
+  /// \return Status object
+  Status ReadRange(key_type key, size_t offset, WritableSlice *dest) const;
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
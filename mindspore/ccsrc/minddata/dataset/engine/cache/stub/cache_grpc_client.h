@@ -32,6 +32,7 @@ class CacheClientGreeter : public Service {
   Status DoServiceStop() override { RETURN_STATUS_UNEXPECTED("Not supported"); }
 
   void *SharedMemoryBaseAddr() { return nullptr; }
+  std::shared_ptr<void> ReadOnlySharedMemory() const { return nullptr; }
   Status HandleRequest(std::shared_ptr<BaseRequest> rq) { RETURN_STATUS_UNEXPECTED("Not supported"); }
   Status AttachToSharedMemory(bool *local_bypass) { RETURN_STATUS_UNEXPECTED("Not supported"); }
   std::string GetHostname() const { return "Not supported"; }
@@ -22,6 +22,7 @@
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
 
@@ -43,6 +44,9 @@ namespace dataset {
 //      i.e., the thread-id0 must have the first element, thread-id1 has the second element,
 //      and so on; then each of this worker can push to the Connector class async in parallel.
 //
+// Since each internal queue has a single producer and the consumers pop from it one at a time under the lock of the
+// Connector, the internal queues are lock-free ring buffers (see RingQueue).
+//
 // Blocking conditions:
 //   1. Connector.push(int, T) can block when the internal queue it's trying to push is full.
 //   2. Connector.pop(int) can block when
@@ -84,7 +88,10 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    queues_.reserve(num_producers_);
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      queues_.emplace_back(std::make_unique<RingQueue<T>>(queue_capacity));
+    }
   }
 
   // Destructor of Connector
@@ -178,18 +185,18 @@ class Connector {
   // @param vg
   // @return
   Status Register(TaskGroup *vg) {
-    Status rc = queues_.Register(vg);
-    if (rc.IsOk()) {
-      rc = cv_.Register(vg->GetIntrpService());
+    RETURN_UNEXPECTED_IF_NULL(vg);
+    for (auto &queue : queues_) {
+      RETURN_IF_NOT_OK(queue->Register(vg));
     }
-    return rc;
+    return cv_.Register(vg->GetIntrpService());
   }
 
  protected:
   std::string my_name_;
 
-  // A list of Queues that are thread safe.
-  QueueList<T> queues_;
+  // A list of single producer queues, one for each producer.
+  std::vector<std::unique_ptr<RingQueue<T>>> queues_;
 
   // The consumer that we allow to get the next data from pop()
   int32_t expect_consumer_;
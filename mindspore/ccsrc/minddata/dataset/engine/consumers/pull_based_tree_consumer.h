@@ -74,6 +74,24 @@ class PullBasedIteratorConsumer : public TreeConsumer {
       "Failover reset is not supported for pull-based iterators (including when Debug mode is enabled).");
   }
 
+  /// Function to get the state of the pipeline.
+  /// \note Getting the pipeline state is NOT supported for pull-based iterators.
+  /// \param[out] pipeline_state the pipeline state.
+  /// \return Status error code
+  Status GetPipelineState(nlohmann::json *pipeline_state) override {
+    RETURN_STATUS_UNEXPECTED(
+      "Pipeline state is not supported for pull-based iterators (including when Debug mode is enabled).");
+  }
+
+  /// Function to restore the current consumer to a pipeline state.
+  /// \note Restore is NOT supported for pull-based iterators.
+  /// \param pipeline_state the pipeline state to restore to.
+  /// \return Status error code
+  Status Restore(const nlohmann::json &pipeline_state) override {
+    RETURN_STATUS_UNEXPECTED(
+      "Pipeline state is not supported for pull-based iterators (including when Debug mode is enabled).");
+  }
+
  protected:
   /// Method to return the name of the consumer
   /// \return string
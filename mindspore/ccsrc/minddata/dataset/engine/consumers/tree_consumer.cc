@@ -370,8 +370,36 @@ Status ToDevice::Terminate() {
 Status TreeConsumer::Reset(int64_t step, const int64_t epoch_num) {
   MS_LOG(INFO) << "Resetting TreeConsumer";
 
-  MS_LOG(INFO) << "Terminating pipeline with UUID:" << tree_adapter_->tree_->GetUniqueId();
   std::shared_ptr<DatasetNode> old_root = tree_adapter_->input_ir_;
+  RETURN_IF_NOT_OK(TerminateForReset());
+  tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
+  RETURN_IF_NOT_OK(tree_adapter_->Compile(old_root, num_epochs_, step, epoch_num));
+  RETURN_IF_NOT_OK(tree_adapter_->Launch());
+  MS_LOG(INFO) << "Launched a new pipeline after reset. UUID: " << tree_adapter_->tree_->GetUniqueId();
+  std::shared_ptr<DatasetOp> root2 = std::shared_ptr<DatasetOp>(tree_adapter_->GetRoot());
+  CHECK_FAIL_RETURN_UNEXPECTED(root2 != nullptr, "Root is a nullptr.");
+  return Status::OK();
+}
+
+Status TreeConsumer::GetPipelineState(nlohmann::json *pipeline_state) {
+  RETURN_UNEXPECTED_IF_NULL(tree_adapter_);
+  return tree_adapter_->GetPipelineState(pipeline_state);
+}
+
+Status TreeConsumer::Restore(const nlohmann::json &pipeline_state) {
+  MS_LOG(INFO) << "Restoring TreeConsumer to the pipeline state: " << pipeline_state.dump();
+
+  std::shared_ptr<DatasetNode> old_root = tree_adapter_->input_ir_;
+  RETURN_IF_NOT_OK(TerminateForReset());
+  tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
+  RETURN_IF_NOT_OK(tree_adapter_->CompileFromPipelineState(old_root, num_epochs_, pipeline_state));
+  RETURN_IF_NOT_OK(tree_adapter_->Launch());
+  MS_LOG(INFO) << "Launched a new pipeline after restore. UUID: " << tree_adapter_->tree_->GetUniqueId();
+  return Status::OK();
+}
+
+Status TreeConsumer::TerminateForReset() {
+  MS_LOG(INFO) << "Terminating pipeline with UUID:" << tree_adapter_->tree_->GetUniqueId();
   RETURN_IF_NOT_OK(this->Stop());
   {
 #ifdef ENABLE_PYTHON
@@ -392,12 +420,6 @@ Status TreeConsumer::Reset(int64_t step, const int64_t epoch_num) {
     }
   }
 #endif
-  tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
-  RETURN_IF_NOT_OK(tree_adapter_->Compile(old_root, num_epochs_, step, epoch_num));
-  RETURN_IF_NOT_OK(tree_adapter_->Launch());
-  MS_LOG(INFO) << "Launched a new pipeline after reset. UUID: " << tree_adapter_->tree_->GetUniqueId();
-  std::shared_ptr<DatasetOp> root2 = std::shared_ptr<DatasetOp>(tree_adapter_->GetRoot());
-  CHECK_FAIL_RETURN_UNEXPECTED(root2 != nullptr, "Root is a nullptr.");
   return Status::OK();
 }
 
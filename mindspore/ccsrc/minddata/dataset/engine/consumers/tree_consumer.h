@@ -64,6 +64,17 @@ class TreeConsumer {
   /// \return Status error code
   virtual Status Reset(int64_t step, const int64_t epoch_num);
 
+  /// Function to get the state of the pipeline, which the consumer can be restored to later.
+  /// \param[out] pipeline_state The epoch and the step in it of the next row, and the states of the ops.
+  /// \return Status error code
+  virtual Status GetPipelineState(nlohmann::json *pipeline_state);
+
+  /// Function to restore the current consumer to a pipeline state, which is got by GetPipelineState().
+  /// The consumer will terminate the pipeline and create a new one, which resumes from the next row of the state.
+  /// \param pipeline_state the pipeline state to restore to.
+  /// \return Status error code
+  virtual Status Restore(const nlohmann::json &pipeline_state);
+
   /// Function to stop the consumer.
   /// \return Status error code
   virtual Status Stop() { return Status::OK(); }
@@ -112,6 +123,11 @@ class TreeConsumer {
   virtual std::string Name() = 0;
 
   int32_t num_epochs_;
+
+ private:
+  /// Stops and terminates the pipeline before a new one is created for a reset or restore.
+  /// \return Status error code
+  Status TerminateForReset();
 };
 
 /// Consumer that iterates over the dataset and returns the rows one by one as a vector or a map
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_buffer_pool.h"
+
+#include <utility>
+
+#include "minddata/dataset/core/global_context.h"
+
+namespace mindspore {
+namespace dataset {
+// An idle buffer is not reused for a tensor smaller than 1 / kMaxBufferSlack of its capacity.
+constexpr dsize_t kMaxBufferSlack = 2;
+
+BatchBufferPool::BatchBufferPool(int32_t max_cached)
+    : max_cached_(max_cached),
+      mem_pool_(GlobalContext::Instance()->mem_pool()),
+      num_allocated_(0),
+      num_reused_(0) {}
+
+BatchBufferPool::~BatchBufferPool() {
+  for (auto &buffers : idle_) {
+    for (auto &buffer : buffers) {
+      mem_pool_->Deallocate(buffer.data);
+    }
+  }
+}
+
+Status BatchBufferPool::CreateTensor(size_t column, const TensorShape &shape, const DataType &type,
+                                     std::shared_ptr<Tensor> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known() && type.IsNumeric(),
+                               "[Internal ERROR] Batch buffer can only hold numeric tensor of known shape.");
+  dsize_t length = shape.NumOfElements() * type.SizeInBytes();
+  if (length == 0) {
+    return Tensor::CreateEmpty(shape, type, out);
+  }
+  Buffer buffer{};
+  RETURN_IF_NOT_OK(Acquire(column, length, &buffer));
+  // the buffer goes back to the pool when the last tensor on top of it is dropped, or it is freed if the pool is
+  // gone by then
+  std::weak_ptr<BatchBufferPool> weak_pool = shared_from_this();
+  std::shared_ptr<MemoryPool> mem_pool = mem_pool_;
+  std::shared_ptr<void> owner(buffer.data, [weak_pool, mem_pool, column, buffer](void *) {
+    auto pool = weak_pool.lock();
+    if (pool != nullptr) {
+      pool->Recycle(column, buffer);
+    } else {
+      mem_pool->Deallocate(buffer.data);
+    }
+  });
+  return Tensor::CreateFromMemoryView(shape, type, buffer.data, length, std::move(owner), out);
+}
+
+Status BatchBufferPool::Acquire(size_t column, dsize_t length, Buffer *buffer) {
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    if (idle_.size() <= column) {
+      idle_.resize(column + 1);
+    }
+    auto &buffers = idle_[column];
+    auto best = buffers.end();
+    for (auto itr = buffers.begin(); itr != buffers.end(); ++itr) {
+      if (itr->capacity >= length && itr->capacity <= length * kMaxBufferSlack &&
+          (best == buffers.end() || itr->capacity < best->capacity)) {
+        best = itr;
+      }
+    }
+    if (best != buffers.end()) {
+      *buffer = *best;
+      (void)buffers.erase(best);
+      num_reused_++;
+      return Status::OK();
+    }
+    // none of the idle buffers fits, e.g. the shape of the column has changed, drop the oldest one to make room
+    if (!buffers.empty() && buffers.size() >= static_cast<size_t>(max_cached_)) {
+      mem_pool_->Deallocate(buffers.front().data);
+      buffers.pop_front();
+    }
+    num_allocated_++;
+  }
+  void *data = nullptr;
+  Status rc = mem_pool_->Allocate(static_cast<size_t>(length), &data);
+  if (rc.IsError() || data == nullptr) {
+    RETURN_STATUS_OOM("Failed to allocate batch buffer of " + std::to_string(length) + " bytes.");
+  }
+  buffer->data = static_cast<uchar *>(data);
+  buffer->capacity = length;
+  return Status::OK();
+}
+
+void BatchBufferPool::Recycle(size_t column, const Buffer &buffer) {
+  std::unique_lock<std::mutex> lock(mux_);
+  if (column < idle_.size() && idle_[column].size() < static_cast<size_t>(max_cached_)) {
+    idle_[column].push_back(buffer);
+    return;
+  }
+  mem_pool_->Deallocate(buffer.data);
+}
+
+int64_t BatchBufferPool::num_allocated() const {
+  std::unique_lock<std::mutex> lock(mux_);
+  return num_allocated_;
+}
+
+int64_t BatchBufferPool::num_reused() const {
+  std::unique_lock<std::mutex> lock(mux_);
+  return num_reused_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/memory_pool.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A pool of the contiguous buffers which BatchOp assembles the columns of its output in. A buffer goes back
+///     to the pool when the last tensor on top of it is dropped, e.g. after DataQueueOp has sent the batch to the
+///     device, so in steady state the batches are written into recycled memory instead of fresh allocations.
+class BatchBufferPool : public std::enable_shared_from_this<BatchBufferPool> {
+ public:
+  /// \brief Constructor
+  /// \param[in] max_cached The max number of idle buffers kept for each column
+  explicit BatchBufferPool(int32_t max_cached);
+
+  ~BatchBufferPool();
+
+  /// \brief Create a numeric tensor of a column on top of a pooled buffer, the content of the tensor is not
+  ///     initialized. The pool must be owned by a shared_ptr.
+  /// \param[in] column The index of the column
+  /// \param[in] shape The shape of the tensor
+  /// \param[in] type The type of the tensor
+  /// \param[out] out The tensor created
+  /// \return Status The status code returned
+  Status CreateTensor(size_t column, const TensorShape &shape, const DataType &type, std::shared_ptr<Tensor> *out);
+
+  /// \brief Getter of the number of buffers allocated from the memory pool
+  int64_t num_allocated() const;
+
+  /// \brief Getter of the number of times an idle buffer is reused
+  int64_t num_reused() const;
+
+ private:
+  struct Buffer {
+    uchar *data;
+    dsize_t capacity;
+  };
+
+  // Take an idle buffer of the column which fits the length, or allocate a new one.
+  Status Acquire(size_t column, dsize_t length, Buffer *buffer);
+
+  // Put the buffer back to the idle buffers of the column, it is freed if there are enough idle buffers.
+  void Recycle(size_t column, const Buffer &buffer);
+
+  int32_t max_cached_;
+  std::shared_ptr<MemoryPool> mem_pool_;
+  std::vector<std::deque<Buffer>> idle_;  // idle buffers of each column, in the order they are recycled
+  int64_t num_allocated_;
+  int64_t num_reused_;
+  mutable std::mutex mux_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/pybind_support.h"
 #endif
 
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -55,6 +56,10 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     // Ensure there are at least 2 queue slots for whole operation.  If only 1 worker, increase queue size to 2.
     worker_connector_size_ = std::max(2, worker_connector_size_);
   }
+  int32_t buffer_pool_size = GlobalContext::config_manager()->batch_buffer_pool_size();
+  if (buffer_pool_size > 0) {
+    buffer_pool_ = std::make_shared<BatchBufferPool>(buffer_pool_size);
+  }
 }
 
 Status BatchOp::operator()() {
@@ -125,7 +130,7 @@ Status BatchOp::operator()() {
     worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(BatchCtrl::kEOF))));
   // EOF received, send quit signal to all workers
   for (int32_t ind = 0; ind < num_workers_; ind++) {
-    RETURN_IF_NOT_OK(SendQuitFlagToWorker(NextWorkerID()));
+    RETURN_IF_NOT_OK(SendQuitFlagToWorker(ind));
   }
   return Status::OK();
 }
@@ -185,6 +190,25 @@ Status CopyTensorToBatch(const std::shared_ptr<Tensor> &element_tensor, std::sha
   return Status::OK();
 }
 
+Status InconsistentShapeError(const TensorShape &expected, const TensorShape &actual, size_t column_index) {
+  std::stringstream shape1, shape2;
+  expected.Print(shape1);
+  actual.Print(shape2);
+  RETURN_STATUS_UNEXPECTED(
+    "Inconsistent batch shapes, batch operation expects same shape for each data row, "
+    "but got inconsistent shape in column " +
+    std::to_string(column_index) + ", expected shape for this column is:" + shape1.str() +
+    ", got shape:" + shape2.str());
+}
+
+Status InconsistentTypeError(const DataType &expected, const DataType &actual, size_t column_index) {
+  RETURN_STATUS_UNEXPECTED(
+    "Inconsistent batch type, batch operation expects same type for each data row, "
+    "but got inconsistent type in column " +
+    std::to_string(column_index) + ", expected type for this column is:" + expected.ToString() +
+    ", got type:" + actual.ToString());
+}
+
 Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *tensor_row_dequeue,
                                     std::shared_ptr<Tensor> *batched_tensor, dsize_t batch_size, size_t column_index,
                                     bool contains_per_batch_map) {
@@ -207,22 +231,9 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *tensor_
         }
         // Don't do anything if the tensor has no data
       } else if (old_tensor->shape() != first_shape) {  // newly popped rows have different dim
-        std::stringstream shape1, shape2;
-        first_shape.Print(shape1);
-        old_tensor->shape().Print(shape2);
-        RETURN_STATUS_UNEXPECTED(
-          "Inconsistent batch shapes, batch operation expects same shape for each data row, "
-          "but got inconsistent shape in column " +
-          std::to_string(column_index) + ", expected shape for this column is:" + shape1.str() +
-          ", got shape:" + shape2.str());
+        return InconsistentShapeError(first_shape, old_tensor->shape(), column_index);
       } else {  // newly popped rows have different type
-        std::string type1, type2;
-        type1 = first_type.ToString();
-        type2 = old_tensor->type().ToString();
-        RETURN_STATUS_UNEXPECTED(
-          "Inconsistent batch type, batch operation expects same type for each data row, "
-          "but got inconsistent type in column " +
-          std::to_string(column_index) + ", expected type for this column is:" + type1 + ", got type:" + type2);
+        return InconsistentTypeError(first_type, old_tensor->type(), column_index);
       }
     }
 #ifdef ENABLE_PYTHON
@@ -354,6 +365,9 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
     RETURN_IF_NOT_OK(MapColumns(&tensor_info_pair, &concat_batch));
   }  // pass it through pyfunc
 #endif
+  if (buffer_pool_ != nullptr && !concat_batch && tensor_info_pair.first->size() > 1) {
+    return BatchRowsToPool(&tensor_info_pair.first, batched_tensor_row, contains_per_batch_map);
+  }  // copy and pad the rows straight into pooled buffers if enabled
   if (pad_) {
     RETURN_IF_NOT_OK(PadColumns(&tensor_info_pair.first, pad_info_, column_name_id_map_));
   }  // do padding if needed
@@ -361,6 +375,85 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
   return Status::OK();
 }
 
+Status GetNumericPadValue(const std::shared_ptr<Tensor> &pad_val, const DataType &type, float *val) {
+  RETURN_UNEXPECTED_IF_NULL(val);
+  *val = 0;
+  if (pad_val == nullptr) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(pad_val->type().IsNumeric(),
+                               "PadEnd: can not pad numeric and string tensors together, but got: " +
+                                 pad_val->type().ToString() + " and " + type.ToString() + ".");
+  std::shared_ptr<Tensor> float_pad_value;
+  RETURN_IF_NOT_OK(TypeCast(pad_val, &float_pad_value, DataType(DataType::DE_FLOAT32)));
+  return float_pad_value->GetItemAt<float>(val, {});
+}
+
+Status BatchOp::BatchRowsToPool(const std::unique_ptr<TensorQTable> *table, TensorRow *batched_tensor_row,
+                                bool contains_per_batch_map) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(batched_tensor_row);
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  if (pad_) {
+    RETURN_IF_NOT_OK(GetPadShapes(table, pad_info_, column_name_id_map_, &pad_cols, &pad_vals, &pad_shapes));
+  }
+  auto batch_size = (*table)->size();
+  auto num_columns = (*table)->front().size();
+  for (size_t col_id = 0; col_id < num_columns; col_id++) {
+    std::shared_ptr<Tensor> first_tensor = (*table)->front()[col_id];
+    bool padded = pad_cols.find(static_cast<int32_t>(col_id)) != pad_cols.end();
+    std::shared_ptr<Tensor> batched_tensor;
+    if (!first_tensor->type().IsNumeric()) {  // string and python columns are not pooled
+      if (padded) {
+        for (TensorRow &row : **table) {
+          std::shared_ptr<Tensor> pad_tensor;
+          RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
+          row[col_id] = pad_tensor;
+        }
+      }
+      RETURN_IF_NOT_OK(ConvertRowsToTensor(table, &batched_tensor, batch_size, col_id, contains_per_batch_map));
+      batched_tensor_row->emplace_back(batched_tensor);
+      continue;
+    }
+
+    DataType type = first_tensor->type();
+    TensorShape row_shape = padded ? TensorShape(pad_shapes[col_id]) : first_tensor->shape();
+    float pad_val = 0;
+    if (padded) {
+      RETURN_IF_NOT_OK(GetNumericPadValue(pad_vals[col_id], type, &pad_val));
+    }
+    RETURN_IF_NOT_OK(buffer_pool_->CreateTensor(col_id, row_shape.PrependDim(static_cast<int64_t>(batch_size)), type,
+                                                &batched_tensor));
+    auto slot_size = row_shape.NumOfElements() * type.SizeInBytes();
+    for (size_t row_id = 0; row_id < batch_size; row_id++) {
+      std::shared_ptr<Tensor> row_tensor = (**table)[row_id][col_id];
+      if (row_tensor->type() != type) {
+        return InconsistentTypeError(type, row_tensor->type(), col_id);
+      }
+      if (slot_size == 0) {
+        continue;
+      }
+      uchar *slot = batched_tensor->GetMutableBuffer() + row_id * slot_size;
+      if (row_tensor->shape() == row_shape) {
+        errno_t copy_status = memcpy_s(slot, slot_size, row_tensor->GetBuffer(), slot_size);
+        CHECK_FAIL_RETURN_UNEXPECTED(copy_status == EOK,
+                                     "Failed to copy tensor to batch, got error_t: " + std::to_string(copy_status));
+      } else if (padded) {
+        // pad the row in its slot of the batch rather than in a new tensor
+        std::shared_ptr<Tensor> slot_tensor;
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemoryView(row_shape, type, slot, slot_size, batched_tensor, &slot_tensor));
+        RETURN_IF_NOT_OK(PadEndNumericInto(row_tensor, slot_tensor, pad_val));
+      } else {
+        return InconsistentShapeError(row_shape, row_tensor->shape(), col_id);
+      }
+    }
+    batched_tensor_row->emplace_back(batched_tensor);
+  }
+  return Status::OK();
+}
+
 Status BatchOp::EofReceived(int32_t) { return Status::OK(); }
 
 Status BatchOp::EoeReceived(int32_t) {
@@ -595,32 +688,58 @@ Status BatchOp::InvokeBatchMapFunc(TensorTable *input, TensorTable *output, CBat
 Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
                            const std::unordered_map<std::string, int32_t> &column_name_id_map) {
   RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  // shape to pad each column to, which is either provided by user or the maximum shape of current batch of tensors
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  RETURN_IF_NOT_OK(GetPadShapes(table, pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+
+  // call pad on each tensor that needs to be padded
+  for (TensorRow &row : **table) {
+    for (size_t col_id : pad_cols) {
+      std::shared_ptr<Tensor> pad_tensor;
+      RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
+      row[col_id] = pad_tensor;
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchOp::GetPadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                             const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                             std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                             std::vector<std::vector<dsize_t>> *pad_shapes) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(pad_cols);
+  RETURN_UNEXPECTED_IF_NULL(pad_vals);
+  RETURN_UNEXPECTED_IF_NULL(pad_shapes);
   CHECK_FAIL_RETURN_UNEXPECTED(
     (*table)->front().size() == column_name_id_map.size(),
     "Invalid parameter, size of column_name_id_map must be equal to num of data columns. map size: " +
       std::to_string(column_name_id_map.size()) + ", column nums: " + std::to_string((*table)->front().size()));
-  std::vector<std::shared_ptr<Tensor>> pad_vals(column_name_id_map.size(),
-                                                nullptr);  // value to pad each column's tensor with, default nullptr
-  std::set<int32_t> pad_cols;
+  // value to pad each column's tensor with, default nullptr
+  pad_vals->assign(column_name_id_map.size(), nullptr);
+  pad_cols->clear();
   // padded_shape provided by user, maximum shapes of current batch of tensors
-  std::vector<std::vector<dsize_t>> pad_shapes(column_name_id_map.size()), max_shapes(column_name_id_map.size());
-  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+  pad_shapes->assign(column_name_id_map.size(), {});
+  std::vector<std::vector<dsize_t>> max_shapes(column_name_id_map.size());
+  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, pad_cols, pad_vals, pad_shapes));
 
   // init each shape in max_shape to {-1,-1...} init each unspecified shape in pad_shape to -1 as well
-  for (size_t col_id : pad_cols) {
+  for (size_t col_id : *pad_cols) {
     max_shapes[col_id] = std::vector<dsize_t>((*table)->front()[col_id]->Rank(), -1);
-    if (pad_shapes[col_id].empty()) {
-      pad_shapes[col_id] = max_shapes[col_id];  // fill pad shape with -1
+    if ((*pad_shapes)[col_id].empty()) {
+      (*pad_shapes)[col_id] = max_shapes[col_id];  // fill pad shape with -1
     }
     CHECK_FAIL_RETURN_UNEXPECTED(
-      pad_shapes[col_id].size() == max_shapes[col_id].size(),
+      (*pad_shapes)[col_id].size() == max_shapes[col_id].size(),
       "Invalid pad_info, rank of pad_shape must be equal to rank of specified column. pad_shapes rank:" +
-        std::to_string(pad_shapes[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
+        std::to_string((*pad_shapes)[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
   }
 
   // calculate maximum shape for each column that needs to be padded
   for (const TensorRow &row : **table) {  // iterator each row in a batch
-    for (size_t col_id : pad_cols) {      // iterator each tensor in a row
+    for (size_t col_id : *pad_cols) {     // iterator each tensor in a row
       CHECK_FAIL_RETURN_UNEXPECTED(
         row[col_id]->Rank() == max_shapes[col_id].size(),
         "Invalid data, data to be padded together need to have the same rank, got shape 1: " +
@@ -632,22 +751,13 @@ Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const Pad
   }
 
   // if user sets a dimension to -1 (None in python), use the max value for current dimension
-  for (size_t col_id : pad_cols) {
-    for (size_t dim = 0; dim < pad_shapes[col_id].size(); dim++) {
-      if (pad_shapes[col_id][dim] < 0) {
-        pad_shapes[col_id][dim] = max_shapes[col_id][dim];
+  for (size_t col_id : *pad_cols) {
+    for (size_t dim = 0; dim < (*pad_shapes)[col_id].size(); dim++) {
+      if ((*pad_shapes)[col_id][dim] < 0) {
+        (*pad_shapes)[col_id][dim] = max_shapes[col_id][dim];
       }
     }
   }
-
-  // call pad on each tensor that needs to be padded
-  for (TensorRow &row : **table) {
-    for (size_t col_id : pad_cols) {
-      std::shared_ptr<Tensor> pad_tensor;
-      RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
-      row[col_id] = pad_tensor;
-    }
-  }
   return Status::OK();
 }
 
@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_buffer_pool.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -178,6 +179,14 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   Status MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> tensor_info_pair,
                         TensorRow *batched_tensor_row);
 
+  // batch the rows in src table into the pooled buffers, the rows are padded straight into their slots if needed
+  // @param const std::unique_ptr<TensorQTable> *table - table that has the rows for batching
+  // @param TensorRow *batched_tensor_row - dest_table to hold batched rows
+  // @param bool contains_per_batch_map - whether user has provided per_batch_map
+  // @return Status The status code returned
+  Status BatchRowsToPool(const std::unique_ptr<TensorQTable> *table, TensorRow *batched_tensor_row,
+                         bool contains_per_batch_map);
+
 #ifdef ENABLE_PYTHON
   // Function that calls pyfunc to perform map on batch
   // @param (std::pair<std::unique_ptr<TensorQTable>, batch_stats> *table_pair - contains un-batched tensor
@@ -196,6 +205,18 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
                               std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
                               std::vector<std::vector<dsize_t>> *pad_shapes);
 
+  // @param table
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param std::set<int32_t> *pad_cols, col ids to perform pad on
+  // @param std::vector<std::shared_ptr<Tensor>> *pad_vals, padding value for each column
+  // @param std::vector<std::vector<dsize_t>> *pad_shapes, shape to pad each column to in current batch
+  // @return Status The status code returned
+  static Status GetPadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                             const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                             std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                             std::vector<std::vector<dsize_t>> *pad_shapes);
+
   // get the batch size for next batch
   // @return Status The status code returned
   Status GetBatchSize(int32_t *batch_size, CBatchInfo info);
@@ -236,6 +257,7 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   py::function batch_map_func_;   // Function pointer of per batch map function
 #endif
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
+  std::shared_ptr<BatchBufferPool> buffer_pool_;              // pooled buffers to batch rows in, null if not pooled
 
  protected:
   Status Launch() override;
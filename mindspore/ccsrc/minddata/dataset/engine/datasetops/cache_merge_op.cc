@@ -73,7 +73,7 @@ Status CacheMergeOp::operator()() {
   int64_t ctr = 0;
   do {
     RETURN_IF_NOT_OK(child_iterator->FetchNextTensorRow(&new_row));
-    RETURN_IF_NOT_OK(worker_in_queues_[static_cast<const int>(ctr++ % num_workers_)]->EmplaceBack(std::move(new_row)));
+    RETURN_IF_NOT_OK(worker_in_queues_[WorkerOfRow(ctr++, num_workers_)]->EmplaceBack(std::move(new_row)));
   } while (!new_row.eof());
 
   return Status::OK();
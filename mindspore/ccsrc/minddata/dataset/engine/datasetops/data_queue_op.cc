@@ -210,6 +210,15 @@ Status DataQueueOp::operator()() {
     RETURN_IF_NOT_OK(SendDataToGPU());
 #endif
   } else if (device_type_ == DeviceType::CPU) {
+#ifdef WITH_BACKEND
+    if (create_data_info_queue_) {
+      std::unique_lock<std::mutex> lock(data_info_mutex_);
+      if (data_info_queue_ptr_ == nullptr) {
+        data_info_queue_ptr_ = std::make_unique<DATA_INFO_QUEUE>(kDataInfoQueueCapacity);
+        RETURN_IF_NOT_OK(data_info_queue_ptr_->Register(tree_->AllTasks()));
+      }
+    }
+#endif
     RETURN_IF_NOT_OK(SendDataToCPU());
   }
 
@@ -283,7 +292,11 @@ Status DataQueueOp::SendDataToAscend() {
       }
       RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "PushToAscend"));
       RETURN_IF_NOT_OK(SendRowToTdt(curr_row, is_profiling_enable, &tdt_cost));
-      RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "PushToAscend", {{"TensorRowFlags", curr_row.FlagName()}}));
+      std::string flag_name = curr_row.FlagName();
+      // the data has been pushed to the device, drop the tensors so that pooled batch buffers are recycled now
+      // rather than after the next row is fetched
+      curr_row.clear();
+      RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "PushToAscend", {{"TensorRowFlags", flag_name}}));
       PrintEndInfoWhenFirstBatch(&first_push_flag_);
 #ifndef ENABLE_SECURITY
       ProfilingRecorder(is_profiling_enable, profiling_node, send_batch, tdt_cost, &batch_start_time, &end_time,
@@ -693,6 +706,8 @@ Status DataQueueOp::WorkerEntry(int32_t worker_id) {
       }
 
       RETURN_IF_NOT_OK(MallocForGPUData(&items, current_row, worker_id));
+      // the data has been copied, drop the tensors so that pooled batch buffers are recycled
+      current_row.clear();
       connector_item.data_item = std::move(items);
       batch_num++;
     } else {
@@ -823,6 +838,12 @@ Status DataQueueOp::ClearDevice() {
 
 Status DataQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
+#ifdef WITH_BACKEND
+  // The data queue is created by InitDataSetQueue in dataset sink mode, then GetNext takes the batches from it
+  if (device::DataQueueMgr::GetInstance().IsCreated(channel_name_)) {
+    return PushDataToCPU();
+  }
+#endif
   int64_t total_batch = 0;
 
   while (!(child_iterator_->EofHandled())) {
@@ -848,6 +869,86 @@ Status DataQueueOp::SendDataToCPU() {
   return Status::OK();
 }
 
+Status DataQueueOp::PushDataToCPU() {
+#ifdef WITH_BACKEND
+  auto release_function = std::bind(&DataQueueOp::ReleaseCPUData, this, std::placeholders::_1, std::placeholders::_2);
+  auto ret = device::DataQueueMgr::GetInstance().Open(channel_name_, release_function);
+  if (ret != DataQueueStatus::SUCCESS) {
+    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to open channel for sending data.");
+  }
+#ifndef ENABLE_SECURITY
+  uint64_t batch_record_start = ProfilingTime::GetCurMilliSecond();
+  uint64_t batch_record_end = 0;
+#endif
+  TensorRow curr_row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+  first_fetch_flag_ = true;
+  int64_t send_batch = 0;
+  uint64_t push_cost = 0;
+  bool is_break_loop = false;
+  MS_LOG(INFO) << "Begin to send data to device, channel name: " << channel_name_;
+
+  while (!curr_row.eof() && !is_break_loop && NoExceptionRaised()) {
+    while (!curr_row.eoe() && !is_break_loop && NoExceptionRaised()) {
+      RETURN_IF_NOT_OK(FilterMetadata(&curr_row));
+      RETURN_IF_NOT_OK(CheckExceptions(curr_row));
+#ifndef ENABLE_SECURITY
+      DetectPerBatchTime(&batch_record_start, &batch_record_end);
+#endif
+      if (create_data_info_queue_) {
+        DATA_INFO data_info;
+        (void)std::transform(curr_row.begin(), curr_row.end(), std::back_inserter(data_info),
+                             [](const std::shared_ptr<Tensor> &ts) { return std::make_pair(ts->type(), ts->shape()); });
+        RETURN_IF_NOT_OK(data_info_queue_ptr_->Add(data_info));
+      }
+      auto items = ConvertTensorRowToDataQueueItem(curr_row);
+      {
+        // Held before it is pushed, since GetNext may release it as soon as it is in the queue
+        std::unique_lock<std::mutex> lock(cpu_sent_rows_mutex_);
+        (void)cpu_sent_rows_.emplace_back(std::move(curr_row), items.size());
+      }
+      PrintBeginInfoWhenFirstBatch(first_push_flag_);
+      RETURN_IF_NOT_OK(RetryPushData(items, false, &push_cost));
+      PrintEndInfoWhenFirstBatch(&first_push_flag_);
+      send_batch++;
+#ifndef ENABLE_SECURITY
+      batch_record_start = ProfilingTime::GetCurMilliSecond();
+#endif
+      if (total_batch_ > 0 && send_batch >= total_batch_) {
+        is_break_loop = true;
+        break;
+      }
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+    }
+    if (curr_row.eoe()) {
+      MS_LOG(INFO) << "EOE Detected";
+    }
+    if (!is_break_loop && NoExceptionRaised()) {
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+    }
+  }
+
+  // now we use this flag to judge whether exception raised.
+  if (NoExceptionRaised()) {
+    send_finished_ = true;
+  }
+  tree_->SetFinished();
+  MS_LOG(INFO) << "ExecutionTree finished. Device queue sent number of batches: " << send_batch;
+
+  device::DataQueueMgr::GetInstance().Close(channel_name_);
+  device::DataQueueMgr::GetInstance().CloseConfirm();
+#endif
+  return Status::OK();
+}
+
+void DataQueueOp::ReleaseCPUData(void *, int32_t) {
+  // The columns are released in the order they are pushed, and a batch is dropped with its last column
+  std::unique_lock<std::mutex> lock(cpu_sent_rows_mutex_);
+  if (!cpu_sent_rows_.empty() && --cpu_sent_rows_.front().second == 0) {
+    cpu_sent_rows_.pop_front();
+  }
+}
+
 void DataQueueOp::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
     // Call the super class for displaying any common 1-liner info
@@ -18,6 +18,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -160,6 +161,13 @@ class DataQueueOp : public PipelineOp {
   uint32_t queue_capacity_;
 
   Status SendDataToCPU();
+  // Push the batches into the data queue of GetNext in dataset sink mode on CPU. The batches are not copied, they are
+  // held until GetNext releases them.
+  Status PushDataToCPU();
+  void ReleaseCPUData(void *addr, int32_t worker_id);
+  // The batches pushed to CPU and the number of their columns which are not released yet, in the order of the queue
+  std::deque<std::pair<TensorRow, size_t>> cpu_sent_rows_;
+  std::mutex cpu_sent_rows_mutex_;
 #ifndef ENABLE_SECURITY
   // Create async thread to detect whether it takes too long and unable to fetch first batch
   Status DetectFirstBatch();
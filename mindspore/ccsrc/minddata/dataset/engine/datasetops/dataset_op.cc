@@ -449,6 +449,11 @@ uint32_t DatasetOp::GenerateCRC(const std::shared_ptr<DatasetOp> &op) {
   ss_str = std::regex_replace(ss_str, std::regex("Cache crc.*\n"), "");
   ss_str = std::regex_replace(ss_str, std::regex("Server cache id.*\n"), "");
 
+  // The crc is the content key of a cache shared across sessions, so it must not depend on the session. The connection
+  // id still tells apart the caches which are not shared.
+  ss_str = std::regex_replace(ss_str, std::regex("Session id.*\n"), "");
+  ss_str = std::regex_replace(ss_str, std::regex("Shared:.*\n"), "");
+
   MS_LOG(DEBUG) << "Printing the tree for generating crc:\n" << ss_str;
 
   uint32_t cache_crc = system::Crc32c::GetMaskCrc32cValue(ss_str.c_str(), ss_str.length());
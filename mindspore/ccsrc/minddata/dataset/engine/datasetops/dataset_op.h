@@ -23,6 +23,8 @@
 #include <vector>
 #include <utility>
 
+#include <nlohmann/json.hpp>
+
 #include "minddata/dataset/callback/callback_manager.h"
 #include "minddata/dataset/include/dataset/constants.h"
 #include "minddata/dataset/engine/operator_connector.h"
@@ -225,6 +227,23 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // \return - Status
   Status SetEpoch(const int64_t epoch);
 
+  // \brief Save the state the op needs to restart an epoch exactly, beyond the epoch number, for example the state of
+  //     a random generator which is not reseeded for each epoch. The default is no state.
+  // \param[in] epoch The epoch to save the state for, which is not finished by the consumer yet
+  // \param[out] state The state, null if the op has no state to save
+  // \return - Status
+  virtual Status SaveEpochState(int64_t epoch, nlohmann::json *state) {
+    RETURN_UNEXPECTED_IF_NULL(state);
+    *state = nullptr;
+    return Status::OK();
+  }
+
+  // \brief Restore the state saved by SaveEpochState(). This is only used in reset mode, after SetEpoch().
+  // \param[in] epoch The epoch to restart the pipeline from
+  // \param[in] state The state saved for the epoch
+  // \return - Status
+  virtual Status RestoreEpochState(int64_t epoch, const nlohmann::json &state) { return Status::OK(); }
+
   // \brief Setter function, set the number of total repeats for the operator
   void SetTotalRepeats(int32_t total_repeats) { op_total_repeats_ = total_repeats; }
 
@@ -272,6 +291,11 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return out_connector_ == nullptr ? int64_t(-1) : static_cast<int64_t>(out_connector_->out_rows_count());
   }
 
+  /// \brief Average bytes of the rows sent out by a connector, sampled as they are popped
+  int64_t ConnectorAvgRowBytes() const {
+    return out_connector_ == nullptr ? int64_t(0) : out_connector_->avg_row_bytes();
+  }
+
   // \brief Getter function
   // \return connector size of current op
   int32_t ConnectorCapacity() const {
@@ -30,6 +30,7 @@
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
@@ -49,10 +50,8 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
   // Build TensorOp from TensorOperation vector
   // This is to ensure each iterator holds its own copy of the TensorOp objects.
   for (int32_t i = 0; i < num_workers; i++) {
-    tfuncs_.push_back(std::vector<std::shared_ptr<TensorOp>>());
-    (void)std::transform(
-      tensor_operations_.begin(), tensor_operations_.end(), std::back_inserter(tfuncs_[i]),
-      [](std::shared_ptr<TensorOperation> operation) -> std::shared_ptr<TensorOp> { return operation->Build(); });
+    worker_seeds_.emplace_back();
+    tfuncs_.push_back(BuildTFuncs(&worker_seeds_.back()));
   }
 
   if (out_columns_.empty() || out_columns_[0].empty()) {
@@ -180,7 +179,7 @@ Status MapOp::operator()() {
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
-    RETURN_IF_NOT_OK(SendQuitFlagToWorker(NextWorkerID()));
+    RETURN_IF_NOT_OK(SendQuitFlagToWorker(wkr_id));
   }
 
   return Status::OK();
@@ -463,10 +462,8 @@ Status MapOp::SendQuitFlagToWorker(int32_t worker_id) {
 Status MapOp::AddNewWorkers(int32_t num_new_workers) {
   RETURN_IF_NOT_OK(ParallelOp::AddNewWorkers(num_new_workers));
   for (int32_t i = 0; i < num_new_workers; i++) {
-    tfuncs_.push_back(std::vector<std::shared_ptr<TensorOp>>());
-    (void)std::transform(
-      tensor_operations_.begin(), tensor_operations_.end(), std::back_inserter(tfuncs_[tfuncs_.size() - 1]),
-      [](std::shared_ptr<TensorOperation> operation) -> std::shared_ptr<TensorOp> { return operation->Build(); });
+    worker_seeds_.emplace_back();
+    tfuncs_.push_back(BuildTFuncs(&worker_seeds_.back()));
   }
   if (python_mp_ != nullptr) {
     CHECK_FAIL_RETURN_UNEXPECTED(num_new_workers > 0, "Number of workers added should be greater than 0.");
@@ -479,6 +476,7 @@ Status MapOp::RemoveWorkers(int32_t num_workers) {
   RETURN_IF_NOT_OK(ParallelOp::RemoveWorkers(num_workers));
   for (int32_t i = 0; i < num_workers; i++) {
     tfuncs_.pop_back();
+    worker_seeds_.pop_back();
   }
   if (python_mp_ != nullptr) {
     CHECK_FAIL_RETURN_UNEXPECTED(num_workers > 0, "Number of workers removed should be greater than 0.");
@@ -486,6 +484,39 @@ Status MapOp::RemoveWorkers(int32_t num_workers) {
   }
   return Status::OK();
 }
+std::vector<std::shared_ptr<TensorOp>> MapOp::BuildTFuncs(std::vector<uint32_t> *seeds) const {
+  SeedLog seed_log(seeds);
+  std::vector<std::shared_ptr<TensorOp>> tfuncs;
+  (void)std::transform(
+    tensor_operations_.begin(), tensor_operations_.end(), std::back_inserter(tfuncs),
+    [](std::shared_ptr<TensorOperation> operation) -> std::shared_ptr<TensorOp> { return operation->Build(); });
+  return tfuncs;
+}
+
+Status MapOp::SaveEpochState(int64_t epoch, nlohmann::json *state) {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  // The state is saved even without seeds, so the map ops of the pipeline keep their order in the saved states
+  *state = {{"seeds", worker_seeds_}};
+  return Status::OK();
+}
+
+Status MapOp::RestoreEpochState(int64_t epoch, const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(state.is_object() && state.contains("seeds") && state["seeds"].is_array(),
+                               "Map: invalid state to restore: " + state.dump());
+  std::vector<std::vector<uint32_t>> saved_seeds;
+  try {
+    saved_seeds = state["seeds"].get<std::vector<std::vector<uint32_t>>>();
+  } catch (const nlohmann::json::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Map: invalid seeds to restore: " + std::string(e.what()));
+  }
+  // The workers added by autotune after the state was saved keep their own seeds
+  for (size_t i = 0; i < saved_seeds.size() && i < tfuncs_.size(); ++i) {
+    worker_seeds_[i] = saved_seeds[i];
+    tfuncs_[i] = BuildTFuncs(&worker_seeds_[i]);
+  }
+  return Status::OK();
+}
+
 void MapOp::SetPythonMp(std::shared_ptr<PythonMultiprocessingRuntime> python_mp) { python_mp_ = std::move(python_mp); }
 
 Status MapOp::Launch() {
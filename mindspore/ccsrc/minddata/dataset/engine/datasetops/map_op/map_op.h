@@ -151,7 +151,22 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   Status GetNextRowPullMode(TensorRow *const row) override;
 
+  /// Save the seeds the random TensorOps of each worker are built with
+  /// \param[in] epoch The epoch to save the state for
+  /// \param[out] state The seeds of the workers
+  /// \return Status code
+  Status SaveEpochState(int64_t epoch, nlohmann::json *state) override;
+
+  /// Build the TensorOps of the workers again with the saved seeds
+  /// \param[in] epoch The epoch to restart the pipeline from
+  /// \param[in] state The seeds of the workers
+  /// \return Status code
+  Status RestoreEpochState(int64_t epoch, const nlohmann::json &state) override;
+
  private:
+  // A helper function to build the TensorOps of a worker, the seeds of the random ones are logged in seeds.
+  std::vector<std::shared_ptr<TensorOp>> BuildTFuncs(std::vector<uint32_t> *seeds) const;
+
   // A helper function to create jobs for workers.
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job, int32_t worker_id);
 
@@ -164,6 +179,9 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   // TensorOps to be applied by worker threads
   std::vector<std::vector<std::shared_ptr<TensorOp>>> tfuncs_;
 
+  // The seeds the random TensorOps of each worker are built with
+  std::vector<std::vector<uint32_t>> worker_seeds_;
+
   // Variable to store the column name that the tensorOps are consuming
   std::vector<std::string> in_columns_;
 
@@ -49,7 +49,7 @@ class ParallelOp : public DatasetOp {
         num_workers_paused_(0),
         epoch_sync_flag_(false),
         num_workers_(num_workers),
-        next_worker_id_(0),
+        next_row_id_(0),
         worker_connector_size_(op_connector_size),
         strategy_{nullptr} {
     // reduce excessive memory usage with high parallelism
@@ -96,11 +96,11 @@ class ParallelOp : public DatasetOp {
     num_workers_paused_ = 0;
     uint32_t num_workers = NumWorkers();
     for (int32_t wkr_id = 0; wkr_id < num_workers; wkr_id++) {
-      RETURN_IF_NOT_OK(SendWaitFlagToWorker(NextWorkerID()));
+      RETURN_IF_NOT_OK(SendWaitFlagToWorker(wkr_id));
     }
     // wait until all workers are done processing their work in local_queue_
     RETURN_IF_NOT_OK(wait_for_workers_post_.Wait());
-    next_worker_id_ = 0;
+    next_row_id_ = 0;
     // clear the WaitPost for the next Wait()
     wait_for_workers_post_.Clear();
     return Status::OK();
@@ -134,8 +134,12 @@ class ParallelOp : public DatasetOp {
 
     for (int32_t i = 0; i < num_new_workers; i++) {
       Task *new_task;
-      RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(
-        Name() + "::WorkerEntry", std::bind(&ParallelOp::WorkerEntry, this, num_workers_), &new_task, id()));
+      int32_t worker_id = num_workers_;
+      auto entry = [this, worker_id]() -> Status {
+        RETURN_IF_NOT_OK(tree_->BindWorkerToNumaNode(worker_id));
+        return WorkerEntry(worker_id);
+      };
+      RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(Name() + "::WorkerEntry", entry, &new_task, id()));
       CHECK_FAIL_RETURN_UNEXPECTED(new_task != nullptr, "Cannot create a new worker.");
       worker_tasks_.push_back(new_task);
       {
@@ -362,16 +366,22 @@ class ParallelOp : public DatasetOp {
     ep_step_ = 0, total_step_ = 0;
     do {
       TensorRow row;
-      RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % NumWorkers())]->PopFront(&row));
+      int32_t worker_id = WorkerOfRow(num_rows++, NumWorkers());
+      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->PopFront(&row));
       if (row.wait()) {
-        // When collector receives the signal from worker thread, it increments an atomic int
-        // If num_worker signals are received, wakes up the main thread
-        if (++num_workers_paused_ == num_workers_) {
-          wait_for_workers_post_.Set();
-          RETURN_IF_NOT_OK(wait_for_collector_.Wait());
-          wait_for_collector_.Clear();
-          num_rows = 0;
+        // The wait signals are sent to all the workers after the rows collected so far, so the next row of every other
+        // worker is its wait signal. Once all of them are received, wakes up the main thread
+        for (int32_t wkr_id = 0; wkr_id < NumWorkers(); wkr_id++) {
+          if (wkr_id != worker_id) {
+            RETURN_IF_NOT_OK(worker_out_queues_[wkr_id]->PopFront(&row));
+            CHECK_FAIL_RETURN_UNEXPECTED(row.wait(), "[Internal Error] Worker " + std::to_string(wkr_id) +
+                                                       " sent a row after its wait signal.");
+          }
         }
+        wait_for_workers_post_.Set();
+        RETURN_IF_NOT_OK(wait_for_collector_.Wait());
+        wait_for_collector_.Clear();
+        num_rows = 0;
         continue;
       } else if (row.eoe()) {
         RETURN_IF_NOT_OK(strategy_->HandleEOE(&row));
@@ -406,10 +416,15 @@ class ParallelOp : public DatasetOp {
 
   std::vector<Task *> worker_tasks_;
 
-  int32_t NextWorkerID() {
-    int32_t next_worker = next_worker_id_;
-    next_worker_id_ = (next_worker_id_ + 1) % num_workers_;
-    return next_worker;
+  int32_t NextWorkerID() { return WorkerOfRow(next_row_id_++, num_workers_); }
+
+  /// The worker a row is dispatched to and collected from, in turn unless the rows are routed to the workers of their
+  /// NUMA nodes
+  /// \param row The index of the row, counted from the start or the last pause of the workers
+  /// \param num_workers The number of workers
+  /// \return The id of the worker
+  int32_t WorkerOfRow(int64_t row, int32_t num_workers) const {
+    return tree_ == nullptr ? static_cast<int32_t>(row % num_workers) : tree_->WorkerOfRow(row, num_workers);
   }
 
  public:
@@ -438,7 +453,7 @@ class ParallelOp : public DatasetOp {
   }
 
  protected:
-  std::atomic_int next_worker_id_;
+  std::atomic<int64_t> next_row_id_;
 
   std::map<int32_t, std::atomic_bool> quit_ack_;
 
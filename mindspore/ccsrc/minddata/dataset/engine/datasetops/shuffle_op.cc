@@ -16,13 +16,17 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <stdlib.h>
 #endif
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <sstream>
 #include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 
@@ -36,6 +40,10 @@ constexpr int32_t ShuffleOp::kShuffleStateInit;
 constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
+// The number of recent repeats to keep the random generator state for. The consumer may be a few epochs behind when
+// the epochs are short, since the rows of the later epochs are queued in the connectors.
+constexpr size_t kNumRepeatStates = 32;
+
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch)
     : PipelineOp(op_connector_size),
@@ -43,9 +51,33 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       shuffle_seed_(shuffle_seed),
       reshuffle_each_epoch_(reset_every_epoch),
       rng_(shuffle_seed),
-      shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit) {
+  CreateShuffleBuffer();
+  RecordRepeatState();
+}
+
+// Private function to create an empty shuffle buffer, which spills to disk if a memory limit is configured.
+void ShuffleOp::CreateShuffleBuffer() {
+  shuffle_buffer_ = std::make_unique<TensorTable>();
+#ifndef ENABLE_ANDROID
+  // the previous buffer removes its spilled rows from disk when it is destroyed
+  spill_buffer_.reset();
+  auto cfg = GlobalContext::config_manager();
+  if (cfg->shuffle_spill_mem_limit() > 0) {
+    spill_buffer_ = std::make_unique<ShuffleSpillBuffer>(cfg->shuffle_spill_mem_limit(), cfg->shuffle_spill_dir());
+  }
+#endif
+}
+
+int64_t ShuffleOp::ShuffleBufferSize() const {
+#ifndef ENABLE_ANDROID
+  if (spill_buffer_ != nullptr) {
+    return spill_buffer_->size();
+  }
+#endif
+  return static_cast<int64_t>(shuffle_buffer_->size());
+}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -58,13 +90,98 @@ Status ShuffleOp::SelfReset() {
   if (!reshuffle_each_epoch_) {
     rng_ = std::mt19937_64(shuffle_seed_);
   }
+  RecordRepeatState();
 
-  shuffle_buffer_ = std::make_unique<TensorTable>();
+  CreateShuffleBuffer();
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
   return Status::OK();
 }
 
+void ShuffleOp::RecordRepeatState() {
+  std::unique_lock<std::mutex> lock(repeat_rngs_mutex_);
+  repeat_rngs_[op_current_repeats_] = rng_;
+  while (repeat_rngs_.size() > kNumRepeatStates) {
+    (void)repeat_rngs_.erase(repeat_rngs_.begin());
+  }
+}
+
+Status ShuffleOp::SaveEpochState(int64_t epoch, nlohmann::json *state) {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  int64_t repeat = epoch * op_num_repeats_per_epoch_;
+  std::stringstream rng_state;
+  {
+    std::unique_lock<std::mutex> lock(repeat_rngs_mutex_);
+    auto iter = repeat_rngs_.find(repeat);
+    CHECK_FAIL_RETURN_UNEXPECTED(iter != repeat_rngs_.end(), "Shuffle: the state of epoch " + std::to_string(epoch) +
+                                                               " is not kept, the pipeline is too far ahead of it.");
+    rng_state << iter->second;
+  }
+  *state = {{"seed", shuffle_seed_}, {"rng", rng_state.str()}};
+  return Status::OK();
+}
+
+Status ShuffleOp::RestoreEpochState(int64_t epoch, const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(state.is_object() && state.contains("seed") && state["seed"].is_number_unsigned() &&
+                                 state.contains("rng") && state["rng"].is_string(),
+                               "Shuffle: invalid state to restore: " + state.dump());
+  CHECK_FAIL_RETURN_UNEXPECTED(state["seed"].get<uint32_t>() == shuffle_seed_,
+                               "Shuffle: the state to restore is from a pipeline with a different shuffle seed.");
+  std::mt19937_64 rng;
+  std::stringstream rng_state(state["rng"].get<std::string>());
+  rng_state >> rng;
+  CHECK_FAIL_RETURN_UNEXPECTED(!rng_state.fail(), "Shuffle: invalid random generator state to restore.");
+  rng_ = rng;
+  {
+    std::unique_lock<std::mutex> lock(repeat_rngs_mutex_);
+    repeat_rngs_.clear();
+  }
+  op_current_repeats_ = epoch * op_num_repeats_per_epoch_;
+  RecordRepeatState();
+
+  if (resume_skip_plan_ == nullptr) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(resume_count_ >= 0 && resume_count_ < resume_num_rows_,
+                               "Shuffle: invalid resume point: " + std::to_string(resume_count_) +
+                                 ", the number of rows in the epoch: " + std::to_string(resume_num_rows_));
+  std::vector<int64_t> buffer;
+  ReplayShuffle(shuffle_size_, resume_num_rows_, resume_count_, &rng, &buffer, &resume_skip_plan_->count,
+                &resume_active_);
+  // The child sends the rows of the buffer in the order of their positions, find the slot of each of them
+  std::vector<int64_t> slots(buffer.size());
+  std::iota(slots.begin(), slots.end(), 0);
+  std::sort(slots.begin(), slots.end(), [&buffer](int64_t a, int64_t b) { return buffer[a] < buffer[b]; });
+  resume_skip_plan_->keep.resize(buffer.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    resume_skip_plan_->keep[i] = buffer[slots[i]];
+  }
+  resume_slots_ = std::move(slots);
+  resume_rng_ = rng;
+  return Status::OK();
+}
+
+void ShuffleOp::ReplayShuffle(int32_t shuffle_size, int64_t num_rows, int64_t count, std::mt19937_64 *rng,
+                              std::vector<int64_t> *buffer, int64_t *next_row, bool *active) {
+  // Same as InitShuffleBuffer() and GetShuffledRowImpl(), with the positions of the rows instead of the rows
+  *next_row = std::min(static_cast<int64_t>(shuffle_size), num_rows);
+  buffer->resize(*next_row);
+  std::iota(buffer->begin(), buffer->end(), 0);
+  *active = num_rows >= shuffle_size;
+  for (int64_t i = 0; i < count && !buffer->empty(); ++i) {
+    auto slot = static_cast<size_t>((*rng)() % buffer->size());
+    (*buffer)[slot] = buffer->back();
+    buffer->pop_back();
+    if (*active) {
+      if (*next_row < num_rows) {
+        buffer->push_back((*next_row)++);
+      } else {
+        *active = false;
+      }
+    }
+  }
+}
+
 // A print method typically used for debugging
 void ShuffleOp::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
@@ -77,12 +194,27 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nShuffle buffer state: " << shuffle_buffer_state_
-        << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle seed: " << shuffle_seed_;
+#ifndef ENABLE_ANDROID
+    if (spill_buffer_ != nullptr) {
+      out << "\nShuffle buffer resident bytes: " << spill_buffer_->resident_bytes()
+          << "\nShuffle buffer spilled blocks: " << spill_buffer_->num_spilled_blocks();
+    }
+#endif
+    out << "\n\n";
   }
 }
 
 // Private function to add a new row to the shuffle buffer.
 Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
+#ifndef ENABLE_ANDROID
+  // The spill buffer does not keep a vacant last slot, the new row is always appended.
+  if (spill_buffer_ != nullptr) {
+    RETURN_IF_NOT_OK(spill_buffer_->Add(new_shuffle_row));
+    shuffle_last_row_idx_ = static_cast<int32_t>(spill_buffer_->size()) - 1;
+    return Status::OK();
+  }
+#endif
   // If the last slot of our shuffle buffer was not the full size of the shuffle buffer then we are
   // filling it during the initial fill codepath and thus growing it's size. In that case, we push
   // back the new row to grow our shuffle buffer size by 1.
@@ -107,17 +239,13 @@ Status ShuffleOp::GetShuffledRowImpl(TensorRow *const row, bool is_pull_mode) {
   // Randomly select a slot from our shuffle buffer and copy that row into the output
   // tensor table. We remove the data from the shuffle buffer, leaving that slot
   // in the table as an empty vector
-  int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-  TensorRow random_row = std::move((*shuffle_buffer_)[random_slot]);
-  *row = std::move(random_row);
-
+  //
   // Step 2)
   // Take the last row from shuffle buffer, and swap it into the row position that was
   // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
   // tail of the shuffle buffer.
-  if (random_slot != shuffle_last_row_idx_) {
-    (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
-  }
+  int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
+  RETURN_IF_NOT_OK(TakeRowFromShuffleBuffer(random_slot, row));
 
   // Step 3)
   // Refill the last slot of the shuffle buffer with the next row from input if we are in the
@@ -147,6 +275,19 @@ Status ShuffleOp::GetShuffledRowImpl(TensorRow *const row, bool is_pull_mode) {
   return Status::OK();
 }
 
+Status ShuffleOp::TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row) {
+#ifndef ENABLE_ANDROID
+  if (spill_buffer_ != nullptr) {
+    return spill_buffer_->Take(slot, row);
+  }
+#endif
+  *row = std::move((*shuffle_buffer_)[slot]);
+  if (slot != shuffle_last_row_idx_) {
+    (*shuffle_buffer_)[slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
+  }
+  return Status::OK();
+}
+
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
@@ -181,15 +322,17 @@ Status ShuffleOp::operator()() {
       RETURN_IF_NOT_OK(out_connector_->Add(std::move(row)));
     }
 
-    // Since we overloaded eoeReceived function, we are responsible to flow the EOE up the
-    // pipeline manually now that we are done draining the shuffle buffer
-    MS_LOG(DEBUG) << "Shuffle operator sending EOE.";
-    RETURN_IF_NOT_OK(out_connector_->SendEOE());
-
     // Do not wait for any reset to be flown down from operators above us.
     // Instead, manually update ourselves and then go reloop to start fetching from child operator
     // right away.  Any Reset() from the parent will still perform common reset actions.
+    // The reset is done before the EOE is sent, so the state of the next epoch is kept once the consumer gets to it.
+    UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(this->SelfReset());
+
+    // Since we overloaded eoeReceived function, we are responsible to flow the EOE up the
+    // pipeline manually now that we are done draining the shuffle buffer
+    MS_LOG(DEBUG) << "Shuffle operator sending EOE.";
+    RETURN_IF_NOT_OK(out_connector_->SendEOE());
   }
 
   return Status::OK();
@@ -210,6 +353,9 @@ Status ShuffleOp::InitShuffleBuffer(bool is_pull_mode) {
     RETURN_STATUS_UNEXPECTED(
       "[Internal ERROR] Invalid shuffle buffer state, shuffle buffer should be init first or reset after each epoch.");
   }
+  if (!resume_slots_.empty()) {
+    return InitResumedShuffleBuffer(is_pull_mode);
+  }
 
   // Before we drop into the fetching loop, call the fetch once for the first time
   // to fill the first row and grab the first buffer.
@@ -236,7 +382,7 @@ Status ShuffleOp::InitShuffleBuffer(bool is_pull_mode) {
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
   // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  while (!new_row.empty() && ShuffleBufferSize() < static_cast<int64_t>(shuffle_size_ - 1)) {
     // Add the previously fetched row
     RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
 
@@ -263,6 +409,29 @@ Status ShuffleOp::InitShuffleBuffer(bool is_pull_mode) {
   return Status::OK();
 }
 
+Status ShuffleOp::InitResumedShuffleBuffer(bool is_pull_mode) {
+  MS_LOG(INFO) << "Shuffle operator resuming with " << resume_slots_.size() << " rows in the shuffle buffer.";
+  TensorTable rows(resume_slots_.size());
+  for (auto slot : resume_slots_) {
+    TensorRow new_row;
+    if (!is_pull_mode) {
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    } else {
+      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(&new_row));
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(!new_row.empty(),
+                                 "[Internal ERROR] Unable to fetch the rows of the shuffle buffer to resume from.");
+    rows[slot] = std::move(new_row);
+  }
+  for (auto &row : rows) {
+    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(row)));
+  }
+  shuffle_buffer_state_ = resume_active_ ? kShuffleStateActive : kShuffleStateDrain;
+  rng_ = resume_rng_;
+  resume_slots_.clear();
+  return Status::OK();
+}
+
 Status ShuffleOp::EoeReceived(int32_t worker_id) {
   state_ = OpState::kDeOpIdle;
   return Status::OK();
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -28,6 +29,10 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/datasetops/shuffle_spill_buffer.h"
+#endif
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -92,6 +97,41 @@ class ShuffleOp : public PipelineOp {
   /// \return Status The status code returned
   Status GetNextRowPullMode(TensorRow *const row) override;
 
+  /// \brief Base-class override, saves the state of the random generator at the start of an epoch.
+  /// \param[in] epoch The epoch to save the state for, which is not finished by the consumer yet.
+  /// \param[out] state The state
+  /// \return Status The status code returned
+  Status SaveEpochState(int64_t epoch, nlohmann::json *state) override;
+
+  /// \brief Base-class override, restores the state of the random generator at the start of an epoch. If the skip
+  ///     of the resume point was pushed down to this op, the skip plan below is worked out as well.
+  /// \param[in] epoch The epoch to restart from
+  /// \param[in] state The state saved for the epoch
+  /// \return Status The status code returned
+  Status RestoreEpochState(int64_t epoch, const nlohmann::json &state) override;
+
+  /// \brief Resume in the middle of the epoch which is restarted. The rows before the resume point are not fetched
+  ///     again, the child skips them by the skip plan, except the ones which were in the shuffle buffer.
+  /// \param[in] count The number of rows this op has sent in the epoch before the resume point
+  /// \param[in] num_rows The number of rows in an epoch of the child
+  /// \param[in] skip_plan The skip plan of the child, it is filled in by RestoreEpochState()
+  void SetResumeSkip(int64_t count, int64_t num_rows, const std::shared_ptr<SkipPlan> &skip_plan) {
+    resume_count_ = count;
+    resume_num_rows_ = num_rows;
+    resume_skip_plan_ = skip_plan;
+  }
+
+  /// \brief Replays the shuffle of the first rows of an epoch on the positions of the child rows.
+  /// \param[in] shuffle_size The size of the shuffle buffer
+  /// \param[in] num_rows The number of rows in an epoch of the child
+  /// \param[in] count The number of rows to shuffle out
+  /// \param[in, out] rng The random generator at the start of the epoch, it is left after the draws of the rows
+  /// \param[out] buffer The position of the child row in each slot of the shuffle buffer after the rows are sent
+  /// \param[out] next_row The position of the next child row to fetch
+  /// \param[out] active Whether the shuffle buffer is still refilled from the child
+  static void ReplayShuffle(int32_t shuffle_size, int64_t num_rows, int64_t count, std::mt19937_64 *rng,
+                            std::vector<int64_t> *buffer, int64_t *next_row, bool *active);
+
  protected:
   /// \brief Gets the implementation status for operator in pull mode
   /// \return implementation status
@@ -102,12 +142,33 @@ class ShuffleOp : public PipelineOp {
   // @return Status The status code returned
   Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
 
+  // Private function to take the row at a slot out of the shuffle buffer, the last row of the buffer is moved into
+  // the vacated slot.
+  // @return Status The status code returned
+  Status TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row);
+
+  // Private function to create an empty shuffle buffer, which spills to disk if a memory limit is configured.
+  void CreateShuffleBuffer();
+
+  // @return The number of rows in the shuffle buffer, including the vacant last slot if any
+  int64_t ShuffleBufferSize() const;
+
   /// \brief Private function to populate the shuffle buffer initially by fetching from the child output
   ///     connector until the shuffle buffer is full (or there is no more data coming).
   /// \param is_pull_mode - flag to indicate if pull mode is on
   /// \return Status The status code returned
   Status InitShuffleBuffer(bool is_pull_mode);
 
+  /// \brief Private function to populate the shuffle buffer as it was at the resume point. The child sends the rows
+  ///     which were in the buffer first, they are put back into their slots.
+  /// \param is_pull_mode - flag to indicate if pull mode is on
+  /// \return Status The status code returned
+  Status InitResumedShuffleBuffer(bool is_pull_mode);
+
+  // Private function to keep the state of the random generator at the start of the current repeat, for the epoch
+  // states to be saved later. Only the most recent repeats are kept.
+  void RecordRepeatState();
+
   /// \brief Gets one row out of the shuffle buffer and fills the vacant row with the last row in the buffer. This
   ///     implemented function is for both pull mode and non-pull mode. If it's in non-pull mode, fetch data from the
   ///     internal child iterator. Otherwise, fetch by calling GetNextRowPullMode() of its child node.
@@ -132,11 +193,28 @@ class ShuffleOp : public PipelineOp {
   std::mt19937_64 rng_;
   // A single (potentially large) buffer of tensor rows for performing shuffling.
   std::unique_ptr<TensorTable> shuffle_buffer_;
+#ifndef ENABLE_ANDROID
+  // Used instead of shuffle_buffer_ when shuffle_spill_mem_limit is set, it holds the rows serialized and spills them
+  // beyond the memory limit.
+  std::unique_ptr<ShuffleSpillBuffer> spill_buffer_;
+#endif
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
   bool eof_received_{false};                       // flag to indicate if eof is reached in pull mode.
+
+  // The random generator at the start of each recent repeat, keyed by the repeat count
+  std::map<int64_t, std::mt19937_64> repeat_rngs_;
+  std::mutex repeat_rngs_mutex_;
+
+  // The resume point in the middle of an epoch, see SetResumeSkip()
+  int64_t resume_count_{0};
+  int64_t resume_num_rows_{0};
+  std::shared_ptr<SkipPlan> resume_skip_plan_;
+  std::vector<int64_t> resume_slots_;  // The slot for each row sent by the child first, empty if not resuming
+  bool resume_active_{false};
+  std::mt19937_64 resume_rng_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,338 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/shuffle_spill_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Blocks are sized from the memory limit so that a small limit still spills in several steps, but kept above the
+// minimum allocation of the storage containers.
+constexpr int64_t kMinBlockSize = 32 * 1024;
+constexpr int64_t kMaxBlockSize = 4 * 1024 * 1024;
+constexpr int64_t kBlocksPerLimit = 8;
+// A spill file takes this many blocks before the next one is started, so that it is removed soon after the rows of
+// its blocks are taken.
+constexpr int64_t kBlocksPerSpillFile = 16;
+
+template <typename T>
+void Put(uchar **dest, T value) {
+  (void)std::memcpy(*dest, &value, sizeof(T));
+  *dest += sizeof(T);
+}
+
+template <typename T>
+Status Get(const uchar **src, const uchar *end, T *value) {
+  CHECK_FAIL_RETURN_UNEXPECTED(end - *src >= static_cast<int64_t>(sizeof(T)),
+                               "[Internal ERROR] Serialized row of shuffle buffer is truncated.");
+  (void)std::memcpy(value, *src, sizeof(T));
+  *src += sizeof(T);
+  return Status::OK();
+}
+}  // namespace
+
+ShuffleSpillBuffer::ShuffleSpillBuffer(int64_t mem_limit, const std::string &spill_dir)
+    : mem_limit_(mem_limit),
+      block_size_(std::min(std::max(mem_limit / kBlocksPerLimit, kMinBlockSize), kMaxBlockSize)),
+      spill_path_(Path(spill_dir) / ("shuffle_" + Services::GetUniqueID())),
+      open_block_(-1),
+      next_block_id_(0),
+      open_spill_file_(-1),
+      next_spill_file_id_(0),
+      resident_bytes_(0),
+      num_spilled_blocks_(0) {}
+
+ShuffleSpillBuffer::~ShuffleSpillBuffer() {
+  Status rc = RemoveSpillFiles();
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to remove the spilled shuffle buffer: " << rc.ToString();
+  }
+}
+
+Status ShuffleSpillBuffer::Add(const TensorRow &row) {
+  int64_t length = SerializedSize(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(length <= std::numeric_limits<uint32_t>::max(),
+                               "Row of " + std::to_string(length) + " bytes is too large for the shuffle buffer.");
+  if (open_block_ >= 0) {
+    Block &open = blocks_.at(open_block_);
+    if (open.used + length > open.capacity) {
+      RETURN_IF_NOT_OK(SealOpenBlock());
+    }
+  }
+  if (open_block_ < 0) {
+    Block block{};
+    block.capacity = std::max(block_size_, length);
+    block.data.reset(new (std::nothrow) uchar[block.capacity]);
+    if (block.data == nullptr) {
+      RETURN_STATUS_OOM("Failed to allocate shuffle buffer block of " + std::to_string(block.capacity) + " bytes.");
+    }
+    resident_bytes_ += block.capacity;
+    open_block_ = next_block_id_++;
+    blocks_[open_block_] = std::move(block);
+  }
+  Block &block = blocks_.at(open_block_);
+  RETURN_IF_NOT_OK(Serialize(row, block.data.get() + block.used));
+  slots_.push_back({open_block_, static_cast<uint32_t>(block.used), static_cast<uint32_t>(length)});
+  block.used += length;
+  block.live++;
+  return SpillIfNeeded();
+}
+
+Status ShuffleSpillBuffer::Take(int64_t index, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(index >= 0 && index < size(),
+                               "[Internal ERROR] Index " + std::to_string(index) + " is out of shuffle buffer.");
+  Slot slot = slots_[index];
+  slots_[index] = slots_.back();
+  slots_.pop_back();
+  auto itr = blocks_.find(slot.block);
+  CHECK_FAIL_RETURN_UNEXPECTED(itr != blocks_.end(), "[Internal ERROR] Block of shuffle buffer is released.");
+  Block &block = itr->second;
+  if (block.data != nullptr) {
+    RETURN_IF_NOT_OK(Deserialize(block.data.get() + slot.offset, slot.length, row));
+  } else {
+    // only the row itself is read back, the rest of the block stays on disk
+    std::vector<uchar> buffer(slot.length);
+    WritableSlice dest(buffer.data(), buffer.size());
+    RETURN_IF_NOT_OK(spill_files_.at(block.spill_file).sm->ReadRange(block.key, slot.offset, &dest));
+    RETURN_IF_NOT_OK(Deserialize(buffer.data(), slot.length, row));
+  }
+  block.live--;
+  if (block.live == 0) {
+    RETURN_IF_NOT_OK(ReleaseBlock(slot.block));
+  }
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::SealOpenBlock() {
+  if (blocks_.at(open_block_).live == 0) {
+    return ReleaseBlock(open_block_);
+  }
+  (void)sealed_resident_.insert(open_block_);
+  open_block_ = -1;
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::SpillIfNeeded() {
+  while (resident_bytes_ > mem_limit_ && !sealed_resident_.empty()) {
+    RETURN_IF_NOT_OK(SpillBlock(*sealed_resident_.begin()));
+  }
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::SpillBlock(int32_t id) {
+  if (open_spill_file_ < 0 || spill_files_.at(open_spill_file_).bytes >= block_size_ * kBlocksPerSpillFile) {
+    RETURN_IF_NOT_OK(OpenSpillFile());
+  }
+  SpillFile &file = spill_files_.at(open_spill_file_);
+  Block &block = blocks_.at(id);
+  RETURN_IF_NOT_OK(file.sm->Write(&block.key, {ReadableSlice(block.data.get(), static_cast<size_t>(block.used))}));
+  block.data.reset();
+  block.spill_file = open_spill_file_;
+  file.bytes += block.used;
+  file.live_blocks++;
+  resident_bytes_ -= block.capacity;
+  (void)sealed_resident_.erase(id);
+  num_spilled_blocks_++;
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::OpenSpillFile() {
+  if (next_spill_file_id_ == 0) {
+    RETURN_IF_NOT_OK(spill_path_.CreateDirectories());
+    MS_LOG(INFO) << "Shuffle buffer exceeds " << mem_limit_ << " bytes, spilling to " << spill_path_.ToString();
+  }
+  // the previous spill file is full, and is removed right away if all its blocks are taken already
+  int32_t prev = open_spill_file_;
+  open_spill_file_ = -1;
+  if (prev >= 0 && spill_files_.at(prev).live_blocks == 0) {
+    RETURN_IF_NOT_OK(RemoveSpillFile(prev));
+  }
+  int32_t id = next_spill_file_id_++;
+  SpillFile file{nullptr, spill_path_ / ("spill_" + std::to_string(id)), 0, 0};
+  RETURN_IF_NOT_OK(file.path.CreateDirectories());
+  auto sm = std::make_shared<StorageManager>(file.path);
+  RETURN_IF_NOT_OK(sm->ServiceStart());
+  file.sm = std::move(sm);
+  (void)spill_files_.emplace(id, std::move(file));
+  open_spill_file_ = id;
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::ReleaseBlock(int32_t id) {
+  auto itr = blocks_.find(id);
+  if (id == open_block_) {
+    open_block_ = -1;
+  }
+  if (itr->second.data != nullptr) {
+    resident_bytes_ -= itr->second.capacity;
+    (void)sealed_resident_.erase(id);
+    (void)blocks_.erase(itr);
+    return Status::OK();
+  }
+  // the StorageManager only appends, so the disk space of a spilled block is given back with its whole spill file
+  int32_t spill_file = itr->second.spill_file;
+  (void)blocks_.erase(itr);
+  SpillFile &file = spill_files_.at(spill_file);
+  file.live_blocks--;
+  if (file.live_blocks == 0 && spill_file != open_spill_file_) {
+    RETURN_IF_NOT_OK(RemoveSpillFile(spill_file));
+  }
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::RemoveSpillFile(int32_t id) {
+  auto itr = spill_files_.find(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(itr != spill_files_.end(), "[Internal ERROR] Spill file of shuffle buffer is removed.");
+  SpillFile file = std::move(itr->second);
+  (void)spill_files_.erase(itr);
+  if (id == open_spill_file_) {
+    open_spill_file_ = -1;
+  }
+  Status rc = file.sm->ServiceStop();
+  file.sm.reset();
+  auto it = Path::DirIterator::OpenDirectory(&file.path);
+  while (it != nullptr && it->HasNext()) {
+    Status rc2 = it->Next().Remove();
+    if (rc2.IsError() && rc.IsOk()) {
+      rc = rc2;
+    }
+  }
+  Status rc2 = file.path.Remove();
+  if (rc2.IsError() && rc.IsOk()) {
+    rc = rc2;
+  }
+  return rc;
+}
+
+Status ShuffleSpillBuffer::RemoveSpillFiles() {
+  if (next_spill_file_id_ == 0) {
+    return Status::OK();
+  }
+  Status rc;
+  while (!spill_files_.empty()) {
+    Status rc2 = RemoveSpillFile(spill_files_.begin()->first);
+    if (rc2.IsError() && rc.IsOk()) {
+      rc = rc2;
+    }
+  }
+  Status rc2 = spill_path_.Remove();
+  if (rc2.IsError() && rc.IsOk()) {
+    rc = rc2;
+  }
+  return rc;
+}
+
+// A row is serialized as its id, its paths and then each tensor as type, shape and the bytes of the buffer. Fields
+// are copied unaligned, the layout only has to be read back by the same process.
+int64_t ShuffleSpillBuffer::SerializedSize(const TensorRow &row) {
+  int64_t length = sizeof(row_id_type) + sizeof(uint32_t);
+  for (const auto &path : row.getPath()) {
+    length += sizeof(uint32_t) + static_cast<int64_t>(path.size());
+  }
+  length += sizeof(uint32_t);
+  for (const auto &tensor : row) {
+    length += sizeof(uint8_t) + sizeof(uint32_t) + tensor->Rank() * sizeof(dsize_t) + sizeof(dsize_t);
+    length += tensor->HasData() ? tensor->SizeInBytes() : 0;
+  }
+  return length;
+}
+
+Status ShuffleSpillBuffer::Serialize(const TensorRow &row, uchar *dest) {
+  Put<row_id_type>(&dest, row.getId());
+  std::vector<std::string> paths = row.getPath();
+  Put<uint32_t>(&dest, static_cast<uint32_t>(paths.size()));
+  for (const auto &path : paths) {
+    Put<uint32_t>(&dest, static_cast<uint32_t>(path.size()));
+    (void)std::memcpy(dest, path.data(), path.size());
+    dest += path.size();
+  }
+  Put<uint32_t>(&dest, static_cast<uint32_t>(row.size()));
+  for (const auto &tensor : row) {
+    CHECK_FAIL_RETURN_UNEXPECTED(tensor->type() != DataType::DE_PYTHON,
+                                 "Python object can not be held by the spillable shuffle buffer.");
+    Put<uint8_t>(&dest, static_cast<uint8_t>(tensor->type().value()));
+    Put<uint32_t>(&dest, static_cast<uint32_t>(tensor->Rank()));
+    for (auto dim : tensor->shape().AsVector()) {
+      Put<dsize_t>(&dest, dim);
+    }
+    dsize_t nbytes = tensor->HasData() ? tensor->SizeInBytes() : 0;
+    Put<dsize_t>(&dest, nbytes);
+    if (nbytes > 0) {
+      (void)std::memcpy(dest, tensor->GetBuffer(), static_cast<size_t>(nbytes));
+      dest += nbytes;
+    }
+  }
+  return Status::OK();
+}
+
+Status ShuffleSpillBuffer::Deserialize(const uchar *src, int64_t length, TensorRow *row) {
+  const uchar *end = src + length;
+  row_id_type id = 0;
+  RETURN_IF_NOT_OK(Get(&src, end, &id));
+  uint32_t num_paths = 0;
+  RETURN_IF_NOT_OK(Get(&src, end, &num_paths));
+  std::vector<std::string> paths;
+  paths.reserve(num_paths);
+  for (uint32_t i = 0; i < num_paths; ++i) {
+    uint32_t path_size = 0;
+    RETURN_IF_NOT_OK(Get(&src, end, &path_size));
+    CHECK_FAIL_RETURN_UNEXPECTED(end - src >= static_cast<int64_t>(path_size),
+                                 "[Internal ERROR] Serialized row of shuffle buffer is truncated.");
+    paths.emplace_back(reinterpret_cast<const char *>(src), path_size);
+    src += path_size;
+  }
+  uint32_t num_tensors = 0;
+  RETURN_IF_NOT_OK(Get(&src, end, &num_tensors));
+  TensorRow out;
+  for (uint32_t i = 0; i < num_tensors; ++i) {
+    uint8_t type = 0;
+    RETURN_IF_NOT_OK(Get(&src, end, &type));
+    uint32_t rank = 0;
+    RETURN_IF_NOT_OK(Get(&src, end, &rank));
+    std::vector<dsize_t> dims(rank);
+    for (auto &dim : dims) {
+      RETURN_IF_NOT_OK(Get(&src, end, &dim));
+    }
+    dsize_t nbytes = 0;
+    RETURN_IF_NOT_OK(Get(&src, end, &nbytes));
+    CHECK_FAIL_RETURN_UNEXPECTED(nbytes >= 0 && end - src >= nbytes,
+                                 "[Internal ERROR] Serialized row of shuffle buffer is truncated.");
+    std::shared_ptr<Tensor> tensor;
+    TensorShape shape(dims);
+    DataType data_type(static_cast<DataType::Type>(type));
+    if (nbytes == 0) {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, data_type, &tensor));
+    } else {
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, data_type, src, nbytes, &tensor));
+    }
+    src += nbytes;
+    out.push_back(std::move(tensor));
+  }
+  out.setId(id);
+  out.setPath(paths);
+  *row = std::move(out);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_SPILL_BUFFER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_SPILL_BUFFER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/cache/storage_manager.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A shuffle buffer which keeps the rows serialized in blocks instead of as TensorRows. Once the resident
+///     blocks exceed the memory limit, the oldest full blocks are spilled to local disk through a StorageManager, and
+///     a row of a spilled block is read back on its own when it is taken. Rows are addressed by a dense index like a
+///     TensorTable, so the shuffle can draw uniformly from the resident and the spilled rows. The StorageManager only
+///     appends, so the blocks are spilled to a series of spill files, and a full spill file is removed once all its
+///     blocks are taken.
+class ShuffleSpillBuffer {
+ public:
+  /// \brief Constructor
+  /// \param[in] mem_limit The max number of bytes of the blocks kept in memory, the block being filled is never
+  ///     spilled and may exceed it
+  /// \param[in] spill_dir The directory under which the spilled blocks are stored
+  ShuffleSpillBuffer(int64_t mem_limit, const std::string &spill_dir);
+
+  ~ShuffleSpillBuffer();
+
+  ShuffleSpillBuffer(const ShuffleSpillBuffer &) = delete;
+
+  ShuffleSpillBuffer &operator=(const ShuffleSpillBuffer &) = delete;
+
+  /// \brief Append a row at the end of the buffer
+  /// \param[in] row The row to add
+  /// \return Status The status code returned
+  Status Add(const TensorRow &row);
+
+  /// \brief Remove the row at the index from the buffer, the last row of the buffer takes its place
+  /// \param[in] index The index of the row
+  /// \param[out] row The row removed
+  /// \return Status The status code returned
+  Status Take(int64_t index, TensorRow *row);
+
+  /// \brief Getter of the number of rows in the buffer
+  int64_t size() const { return static_cast<int64_t>(slots_.size()); }
+
+  /// \brief Getter of the number of bytes of the blocks in memory
+  int64_t resident_bytes() const { return resident_bytes_; }
+
+  /// \brief Getter of the number of blocks spilled to disk
+  int64_t num_spilled_blocks() const { return num_spilled_blocks_; }
+
+  /// \brief Getter of the number of spill files on disk
+  int64_t num_spill_files() const { return static_cast<int64_t>(spill_files_.size()); }
+
+ private:
+  // Where a row is serialized, 12 bytes per row so that the index of a large buffer stays small.
+  struct Slot {
+    int32_t block;
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct Block {
+    std::unique_ptr<uchar[]> data;  // null once the block is spilled
+    int64_t capacity;
+    int64_t used;
+    int32_t live;        // number of rows not taken yet
+    int32_t spill_file;  // the spill file of the block once it is spilled
+    StorageManager::key_type key;
+  };
+
+  // A directory of a StorageManager which the blocks are spilled to.
+  struct SpillFile {
+    std::shared_ptr<StorageManager> sm;
+    Path path;
+    int64_t bytes;        // number of bytes spilled to it
+    int32_t live_blocks;  // number of its blocks not released yet
+  };
+
+  // Close the block being filled, no more rows are added to it.
+  Status SealOpenBlock();
+
+  // Spill the oldest full blocks until the resident blocks fit in the memory limit.
+  Status SpillIfNeeded();
+
+  // Write a resident block to disk and release its memory.
+  Status SpillBlock(int32_t id);
+
+  // Release a block whose rows are all taken.
+  Status ReleaseBlock(int32_t id);
+
+  // Start a new spill file which the next blocks are spilled to.
+  Status OpenSpillFile();
+
+  // Stop the StorageManager of a spill file and remove its files.
+  Status RemoveSpillFile(int32_t id);
+
+  // Remove the files of the spilled blocks.
+  Status RemoveSpillFiles();
+
+  static int64_t SerializedSize(const TensorRow &row);
+
+  static Status Serialize(const TensorRow &row, uchar *dest);
+
+  static Status Deserialize(const uchar *src, int64_t length, TensorRow *row);
+
+  int64_t mem_limit_;
+  int64_t block_size_;
+  Path spill_path_;
+  std::vector<Slot> slots_;
+  std::unordered_map<int32_t, Block> blocks_;
+  std::set<int32_t> sealed_resident_;  // full blocks in memory, the oldest first
+  int32_t open_block_;                 // the block being filled, -1 if there is none
+  int32_t next_block_id_;
+  std::map<int32_t, SpillFile> spill_files_;  // created on the first spill
+  int32_t open_spill_file_;                   // the spill file being written, -1 if there is none
+  int32_t next_spill_file_id_;
+  int64_t resident_bytes_;
+  int64_t num_spilled_blocks_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_SPILL_BUFFER_H_
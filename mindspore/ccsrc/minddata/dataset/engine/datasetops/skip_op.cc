@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 #include "minddata/dataset/util/log_adapter.h"
 
 namespace mindspore {
@@ -43,11 +44,40 @@ void SkipOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
+Status SkipOp::PrepareOperator() {
+  RETURN_IF_NOT_OK(PipelineOp::PrepareOperator());
+  if (!once_only_ || child_.size() != 1) {
+    return Status::OK();
+  }
+  auto leaf = std::dynamic_pointer_cast<NonMappableLeafOp>(child_[0]);
+  if (leaf == nullptr || !leaf->SupportSeek()) {
+    return Status::OK();
+  }
+  // The leaf seeks past the rows up to the first row to keep, the ones after are skipped here.
+  int64_t seek_rows = max_skips_ - skip_count_;
+  if (skip_plan_ != nullptr) {
+    seek_rows = skip_plan_->keep.empty() ? skip_plan_->count : skip_plan_->keep.front();
+    plan_position_ = seek_rows;
+  } else {
+    skip_count_ = max_skips_;
+  }
+  if (seek_rows > 0) {
+    MS_LOG(INFO) << "Seeking past " << seek_rows << " rows in " << leaf->NameWithID() << " instead of skipping them.";
+    leaf->SetSeekRows(seek_rows);
+  }
+  return Status::OK();
+}
+
 Status SkipOp::operator()() { RETURN_STATUS_UNEXPECTED("[Internal ERROR] SkipOp is an inlined operator."); }
 
 Status SkipOp::GetNextRow(TensorRow *row) {
   RETURN_UNEXPECTED_IF_NULL(row);
   RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "GetFromPreviousOp"));
+  if (skip_plan_ != nullptr) {
+    RETURN_IF_NOT_OK(GetNextPlannedRow(row, false));
+    RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "GetFromPreviousOp", {{"TensorRowFlags", row->FlagName()}}));
+    return Status::OK();
+  }
   bool eoe_received = false;
   while (skip_count_ < max_skips_) {
     RETURN_IF_NOT_OK(child_[0]->GetNextRow(row));
@@ -79,6 +109,9 @@ Status SkipOp::GetNextRow(TensorRow *row) {
 
 Status SkipOp::GetNextRowPullMode(TensorRow *const row) {
   RETURN_UNEXPECTED_IF_NULL(row);
+  if (skip_plan_ != nullptr) {
+    return GetNextPlannedRow(row, true);
+  }
   bool eoe_received = false;
   while (skip_count_ < max_skips_) {
     RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(row));
@@ -104,5 +137,33 @@ Status SkipOp::GetNextRowPullMode(TensorRow *const row) {
   }
   return Status::OK();
 }
+
+Status SkipOp::GetNextPlannedRow(TensorRow *const row, bool is_pull_mode) {
+  while (true) {
+    if (is_pull_mode) {
+      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(row));
+    } else {
+      RETURN_IF_NOT_OK(child_[0]->GetNextRow(row));
+    }
+    if (row->eof()) {
+      return Status::OK();
+    }
+    if (row->eoe()) {
+      // The plan is for the first epoch only
+      UpdateRepeatAndEpochCounter();
+      skip_plan_.reset();
+      return Status::OK();
+    }
+    int64_t position = plan_position_++;
+    if (position >= skip_plan_->count) {
+      skip_plan_.reset();
+      return Status::OK();
+    }
+    if (plan_next_keep_ < skip_plan_->keep.size() && skip_plan_->keep[plan_next_keep_] == position) {
+      ++plan_next_keep_;
+      return Status::OK();
+    }
+  }
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 
 namespace mindspore {
@@ -50,8 +51,17 @@ class SkipOp : public PipelineOp {
   std::string Name() const override { return kSkipOp; }
   Status GetNextRow(TensorRow *row) override;
 
+  // During tree prepare phase, a skip for the first epoch only is handed to the non-mappable leaf below which can
+  // seek past the rows, so that they are not read.
+  // @return Status The status code returned
+  Status PrepareOperator() override;
+
   void SetOnceOnly(bool once_only) { once_only_ = once_only; }
 
+  /// \brief Skip the rows of a plan instead of the first max_skips rows, only once.
+  /// \param[in] skip_plan The plan filled in by the ShuffleOp above before the pipeline is launched.
+  void SetSkipPlan(const std::shared_ptr<SkipPlan> &skip_plan) { skip_plan_ = skip_plan; }
+
   /// \brief Gets the next row
   /// \param row[out] - Fetched TensorRow
   /// \return Status The status code returned
@@ -63,11 +73,21 @@ class SkipOp : public PipelineOp {
   ImplementedPullMode PullModeImplementationStatus() const override { return ImplementedPullMode::Implemented; }
 
  private:
+  /// \brief Gets the next row which is not skipped by the skip plan, and drops the plan once it is done.
+  /// \param row[out] - Fetched TensorRow
+  /// \param is_pull_mode - flag to indicate if pull mode is on
+  /// \return Status The status code returned
+  Status GetNextPlannedRow(TensorRow *const row, bool is_pull_mode);
+
   int32_t max_skips_;   // The number of skips that the user requested
   int32_t skip_count_;  // A counter for the current number of executed skips
 
   bool once_only_ = false;  // skip for skip_count_ steps only once
 
+  std::shared_ptr<SkipPlan> skip_plan_;  // The rows to skip in the first epoch, instead of max_skips_
+  int64_t plan_position_ = 0;            // The position of the next row in the first epoch
+  size_t plan_next_keep_ = 0;            // The index of the next position to keep in the skip plan
+
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
 };
 }  // namespace dataset
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SKIP_PLAN_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SKIP_PLAN_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+/// \brief The rows to skip below a ShuffleOp which resumes in the middle of an epoch. The ShuffleOp works it out when
+///     its state is restored, which is before the pipeline is launched. Then the SkipOp or SkipFirstEpochSampler below
+///     the ShuffleOp skips the first count rows of the epoch, except the rows to keep, which were still in the shuffle
+///     buffer at the resume point.
+struct SkipPlan {
+  int64_t count = 0;
+  std::vector<int64_t> keep;  // The positions of the rows to keep in ascending order, all less than count
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SKIP_PLAN_H_
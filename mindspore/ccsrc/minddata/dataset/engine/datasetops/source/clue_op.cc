@@ -88,15 +88,16 @@ Status ClueOp::LoadFile(const std::string &file, int64_t start_offset, int64_t e
     LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
 
-  std::ifstream handle(realpath.value());
-  if (!handle.is_open()) {
+  std::unique_ptr<std::istream> handle;
+  RETURN_IF_NOT_OK(OpenFileStream(realpath.value(), worker_id, &handle));
+  if (handle->fail()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open " + file + ", the file is damaged or permission denied.");
   }
 
   int64_t rows_total = 0;
   std::string line;
 
-  while (getline(handle, line)) {
+  while (getline(*handle, line)) {
     if (line.empty()) {
       continue;
     }
@@ -90,6 +90,10 @@ class CoNLL2000Op : public TextFileOp {
   /// \param[in] worker_id The id of the worker that is executing this function.
   /// \return Status The error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
+
+  /// \brief The file is read by its own stream instead of OpenFileStream, it is not read ahead.
+  /// \return False.
+  bool SupportIOPrefetch() const override { return false; }
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -478,22 +478,22 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + file + " does not exist.");
   }
 
-  std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
-  if (!ifs.is_open()) {
+  std::unique_ptr<std::istream> ifs;
+  RETURN_IF_NOT_OK(OpenFileStream(realpath.value(), worker_id, &ifs));
+  if (ifs->fail()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open " + file + ", the file is damaged or permission denied.");
   }
   if (column_name_list_.empty()) {
     std::string tmp;
-    getline(ifs, tmp);
+    getline(*ifs, tmp);
   }
   csv_parser.Reset();
   try {
-    while (ifs.good()) {
+    while (ifs->good()) {
       // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
       // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
       // int to receive its return value.
-      int chr = ifs.get();
+      int chr = ifs->get();
       int err = csv_parser.ProcessMessage(chr);
       if (err != 0) {
         // if error code is -2, the returned error is interrupted
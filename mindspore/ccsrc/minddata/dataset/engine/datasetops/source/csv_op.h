@@ -203,6 +203,10 @@ class CsvOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // The file is read through OpenFileStream, so it can be read ahead.
+  // @return - true.
+  bool SupportIOPrefetch() const override { return true; }
+
   // Fill the IOBlockQueue.
   // @para i_keys - keys of file to fill to the IOBlockQueue
   // @return Status - the error code returned.
@@ -66,6 +66,10 @@ class EnWik9Op : public TextFileOp {
   /// \return Status The error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  /// \brief The file is read by its own stream instead of OpenFileStream, it is not read ahead.
+  /// \return False.
+  bool SupportIOPrefetch() const override { return false; }
+
  private:
   /// \brief Count number of rows in each file.
   /// \param[in] file Txt file name.
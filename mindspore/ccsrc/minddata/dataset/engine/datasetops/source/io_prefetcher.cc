@@ -0,0 +1,330 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/io_prefetcher.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+PrefetchedFile::~PrefetchedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (fd_ >= 0) {
+    (void)close(fd_);
+    fd_ = -1;
+  }
+#endif
+}
+
+// A stream buffer over the blocks of a prefetched file. It holds one block at a time.
+class IOPrefetcher::StreamBuf : public std::streambuf {
+ public:
+  StreamBuf(IOPrefetcher *prefetcher, std::shared_ptr<PrefetchedFile> file)
+      : prefetcher_(prefetcher), file_(std::move(file)) {}
+
+  ~StreamBuf() override = default;
+
+ protected:
+  int_type underflow() override {
+    if (gptr() != nullptr && gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    Status rc = prefetcher_->NextBlock(file_.get(), &block_);
+    if (rc.IsError()) {
+      // the error is reported when the file is released
+      prefetcher_->RecordError(file_.get(), rc);
+    }
+    if (rc.IsError() || block_.empty()) {
+      setg(nullptr, nullptr, nullptr);
+      return traits_type::eof();
+    }
+    setg(block_.data(), block_.data(), block_.data() + block_.size());
+    return traits_type::to_int_type(*gptr());
+  }
+
+ private:
+  IOPrefetcher *prefetcher_;
+  std::shared_ptr<PrefetchedFile> file_;
+  std::vector<char> block_;
+};
+
+// A stream which owns its stream buffer.
+class PrefetchStream : public std::istream {
+ public:
+  explicit PrefetchStream(std::unique_ptr<std::streambuf> buf) : std::istream(buf.get()), buf_(std::move(buf)) {}
+
+  ~PrefetchStream() override = default;
+
+ private:
+  std::unique_ptr<std::streambuf> buf_;
+};
+
+IOPrefetcher::IOPrefetcher(int32_t max_in_flight, int32_t max_per_file, int64_t block_size)
+    : max_in_flight_(std::max(max_in_flight, 1)),
+      max_per_file_(std::max(max_per_file, 1)),
+      block_size_(std::max(block_size, static_cast<int64_t>(1))),
+      outstanding_(0),
+      stop_(false) {}
+
+Status IOPrefetcher::Register(TaskGroup *vg) {
+  RETURN_UNEXPECTED_IF_NULL(vg);
+  return cv_.Register(vg->GetIntrpService());
+}
+
+Status IOPrefetcher::IOWorkerEntry(int32_t worker_id) {
+  // must be called first if called by worker spawned by taskgroup
+  TaskManager::FindMe()->Post();
+
+  std::unique_lock<std::mutex> lock(mux_);
+  while (true) {
+    std::shared_ptr<PrefetchedFile> file;
+    RETURN_IF_NOT_OK(cv_.Wait(&lock, [this, &file]() {
+      if (stop_) {
+        return true;
+      }
+      file = PickFile();
+      return file != nullptr;
+    }));
+    if (stop_) {
+      break;
+    }
+
+    if (file->state_ == PrefetchedFile::State::kPending) {
+      RETURN_IF_NOT_OK(WaitOpen(&lock, file.get()));
+      continue;
+    }
+
+    // claim the next block of the file, then read it without the lock held
+    int64_t offset = file->issue_offset_;
+    file->issue_offset_ += block_size_;
+    file->outstanding_++;
+    outstanding_++;
+    lock.unlock();
+    std::vector<char> block;
+    Status rc = ReadBlock(file.get(), offset, &block);
+    lock.lock();
+    if (file->state_ == PrefetchedFile::State::kReleased || rc.IsError()) {
+      file->outstanding_--;
+      outstanding_--;
+      if (rc.IsError() && file->rc_.IsOk()) {
+        file->rc_ = rc;
+      }
+    } else {
+      file->ready_[offset] = std::move(block);
+    }
+    cv_.NotifyAll();
+  }
+  MS_LOG(DEBUG) << "IOPrefetcher I/O thread " << worker_id << " quits.";
+  return Status::OK();
+}
+
+std::shared_ptr<PrefetchedFile> IOPrefetcher::Submit(const std::string &path) {
+  auto file = std::make_shared<PrefetchedFile>(path);
+  std::unique_lock<std::mutex> lock(mux_);
+  pending_.push_back(file);
+  cv_.NotifyAll();
+  return file;
+}
+
+Status IOPrefetcher::OpenStream(const std::shared_ptr<PrefetchedFile> &file, std::unique_ptr<std::istream> *stream) {
+  RETURN_UNEXPECTED_IF_NULL(file);
+  RETURN_UNEXPECTED_IF_NULL(stream);
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    RETURN_IF_NOT_OK(WaitOpen(&lock, file.get()));
+  }
+  *stream = std::make_unique<PrefetchStream>(std::make_unique<StreamBuf>(this, file));
+  if (file->state_ != PrefetchedFile::State::kOpen) {
+    (*stream)->setstate(std::ios::failbit);
+  }
+  return Status::OK();
+}
+
+Status IOPrefetcher::Release(const std::shared_ptr<PrefetchedFile> &file) {
+  RETURN_UNEXPECTED_IF_NULL(file);
+  std::unique_lock<std::mutex> lock(mux_);
+  if (file->state_ != PrefetchedFile::State::kReleased) {
+    // the blocks being read are dropped by the I/O threads once they are done
+    auto dropped = static_cast<int32_t>(file->ready_.size());
+    file->outstanding_ -= dropped;
+    outstanding_ -= dropped;
+    file->ready_.clear();
+    file->state_ = PrefetchedFile::State::kReleased;
+    pending_.remove(file);
+    cv_.NotifyAll();
+  }
+  return file->rc_;
+}
+
+void IOPrefetcher::RecordError(PrefetchedFile *file, const Status &rc) {
+  std::unique_lock<std::mutex> lock(mux_);
+  if (file->rc_.IsOk()) {
+    file->rc_ = rc;
+  }
+}
+
+void IOPrefetcher::Stop() {
+  std::unique_lock<std::mutex> lock(mux_);
+  stop_ = true;
+  cv_.NotifyAll();
+}
+
+Status IOPrefetcher::OpenFile(PrefetchedFile *file) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file->path_.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, failed to open " + file->path_ +
+                                          ", the file is damaged or permission denied: " + strerror(errno));
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to get the size of " + file->path_ + ": " + strerror(errno));
+  }
+#if !defined(__APPLE__)
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  file->fd_ = fd;
+  file->size_ = static_cast<int64_t>(st.st_size);
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Reading files ahead by IOPrefetcher is not supported on Windows.");
+#endif
+}
+
+Status IOPrefetcher::WaitOpen(std::unique_lock<std::mutex> *lock, PrefetchedFile *file) {
+  while (true) {
+    if (file->state_ == PrefetchedFile::State::kPending) {
+      file->state_ = PrefetchedFile::State::kOpening;
+      lock->unlock();
+      Status rc = OpenFile(file);
+      lock->lock();
+      // the file may be released while it is being opened
+      if (file->state_ == PrefetchedFile::State::kOpening) {
+        file->state_ = rc.IsOk() ? PrefetchedFile::State::kOpen : PrefetchedFile::State::kFailed;
+      }
+      if (rc.IsError() && file->rc_.IsOk()) {
+        file->rc_ = rc;
+      }
+      cv_.NotifyAll();
+    } else if (file->state_ == PrefetchedFile::State::kOpening) {
+      RETURN_IF_NOT_OK(cv_.Wait(lock, [file]() { return file->state_ != PrefetchedFile::State::kOpening; }));
+    } else {
+      return Status::OK();
+    }
+  }
+}
+
+Status IOPrefetcher::ReadBlock(const PrefetchedFile *file, int64_t offset, std::vector<char> *block) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int64_t length = std::min(block_size_, file->size_ - offset);
+  block->resize(static_cast<size_t>(std::max(length, static_cast<int64_t>(0))));
+  int64_t done = 0;
+  while (done < length) {
+    ssize_t ret = pread(file->fd_, block->data() + done, static_cast<size_t>(length - done), offset + done);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(ret >= 0, "Invalid file, failed to read " + file->path_ + " at offset " +
+                                             std::to_string(offset + done) + ": " + strerror(errno));
+    if (ret == 0) {
+      // the file is truncated after it is opened
+      block->resize(static_cast<size_t>(done));
+      break;
+    }
+    done += ret;
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Reading files ahead by IOPrefetcher is not supported on Windows.");
+#endif
+}
+
+Status IOPrefetcher::NextBlock(PrefetchedFile *file, std::vector<char> *block) {
+  RETURN_UNEXPECTED_IF_NULL(file);
+  RETURN_UNEXPECTED_IF_NULL(block);
+  std::unique_lock<std::mutex> lock(mux_);
+  RETURN_IF_NOT_OK(WaitOpen(&lock, file));
+  while (true) {
+    RETURN_IF_NOT_OK(file->rc_);
+    CHECK_FAIL_RETURN_UNEXPECTED(file->state_ == PrefetchedFile::State::kOpen,
+                                 "[Internal ERROR] " + file->path_ + " is read after it is released.");
+    int64_t offset = file->consume_offset_;
+    if (offset >= file->size_) {
+      block->clear();
+      return Status::OK();
+    }
+    auto it = file->ready_.find(offset);
+    if (it != file->ready_.end()) {
+      *block = std::move(it->second);
+      (void)file->ready_.erase(it);
+      file->consume_offset_ = std::min(offset + block_size_, file->size_);
+      file->outstanding_--;
+      outstanding_--;
+      // a slot is free for the I/O threads to read ahead
+      cv_.NotifyAll();
+      return Status::OK();
+    }
+    if (offset < file->issue_offset_) {
+      // the block is being read by an I/O thread
+      RETURN_IF_NOT_OK(cv_.Wait(&lock, [file, offset]() {
+        return file->ready_.count(offset) > 0 || file->rc_.IsError() ||
+               file->state_ != PrefetchedFile::State::kOpen;
+      }));
+      continue;
+    }
+    // the I/O threads fall behind, read the block by the worker itself
+    file->issue_offset_ = offset + block_size_;
+    lock.unlock();
+    Status rc = ReadBlock(file, offset, block);
+    lock.lock();
+    RETURN_IF_NOT_OK(rc);
+    file->consume_offset_ = std::min(offset + block_size_, file->size_);
+    return Status::OK();
+  }
+}
+
+std::shared_ptr<PrefetchedFile> IOPrefetcher::PickFile() {
+  auto it = pending_.begin();
+  while (it != pending_.end()) {
+    auto &file = *it;
+    if (file->state_ == PrefetchedFile::State::kReleased || file->state_ == PrefetchedFile::State::kFailed ||
+        (file->state_ == PrefetchedFile::State::kOpen && file->issue_offset_ >= file->size_)) {
+      // nothing left to read ahead in this file
+      it = pending_.erase(it);
+      continue;
+    }
+    if (file->state_ == PrefetchedFile::State::kPending) {
+      return file;
+    }
+    if (file->state_ == PrefetchedFile::State::kOpen && outstanding_ < max_in_flight_ &&
+        file->outstanding_ < max_per_file_) {
+      return file;
+    }
+    ++it;
+  }
+  return nullptr;
+}
+}  // namespace dataset
+}  // namespace mindspore
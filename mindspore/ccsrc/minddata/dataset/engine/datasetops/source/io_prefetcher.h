@@ -0,0 +1,143 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_IO_PREFETCHER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_IO_PREFETCHER_H_
+
+#include <istream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class TaskGroup;
+
+/// \brief A file submitted to IOPrefetcher. The blocks of the file are read ahead by the I/O threads of the
+///     prefetcher and consumed in order by the worker which opens the file through IOPrefetcher::OpenStream.
+class PrefetchedFile {
+ public:
+  explicit PrefetchedFile(const std::string &path) : path_(path) {}
+
+  ~PrefetchedFile();
+
+  /// \brief Getter of the path of the file
+  const std::string &path() const { return path_; }
+
+ private:
+  friend class IOPrefetcher;
+
+  enum class State { kPending = 0, kOpening, kOpen, kFailed, kReleased };
+
+  std::string path_;
+  State state_{State::kPending};
+  int fd_{-1};
+  int64_t size_{0};
+  int64_t issue_offset_{0};    // offset of the next block to be read
+  int64_t consume_offset_{0};  // offset of the next block to be consumed
+  int32_t outstanding_{0};     // blocks read by the I/O threads but not consumed yet
+  std::map<int64_t, std::vector<char>> ready_;
+  Status rc_;
+};
+
+/// \brief A shared asynchronous I/O engine for the non-mappable leaf ops. Files are submitted in the order the
+///     workers are going to read them, and a fixed number of I/O threads keep up to max_in_flight block reads
+///     outstanding across these files, so a worker mostly consumes blocks which are already in memory instead of
+///     waiting on a blocking read of its own. A block which is not fetched yet is read by the worker itself.
+class IOPrefetcher {
+ public:
+  /// \brief Constructor
+  /// \param[in] max_in_flight The max number of blocks being read or waiting to be consumed
+  /// \param[in] max_per_file The max number of blocks of a file being read or waiting to be consumed
+  /// \param[in] block_size The size of each read in bytes
+  IOPrefetcher(int32_t max_in_flight, int32_t max_per_file, int64_t block_size);
+
+  ~IOPrefetcher() = default;
+
+  /// \brief Register the wait condition to the task group, so that the waiting threads are woken up on interrupt
+  /// \param[in] vg The task group
+  /// \return Status The status code returned
+  Status Register(TaskGroup *vg);
+
+  /// \brief The entry point of the I/O threads
+  /// \param[in] worker_id The id of the I/O thread
+  /// \return Status The status code returned
+  Status IOWorkerEntry(int32_t worker_id);
+
+  /// \brief Submit a file to be read ahead
+  /// \param[in] path The real path of the file
+  /// \return The handle of the submitted file
+  std::shared_ptr<PrefetchedFile> Submit(const std::string &path);
+
+  /// \brief Open a stream over the blocks of a submitted file. The fail bit of the stream is set if the file
+  ///     can not be opened.
+  /// \param[in] file The handle returned by Submit
+  /// \param[out] stream The stream to read the file
+  /// \return Status The status code returned
+  Status OpenStream(const std::shared_ptr<PrefetchedFile> &file, std::unique_ptr<std::istream> *stream);
+
+  /// \brief Stop reading ahead a file and drop the blocks which are not consumed.
+  /// \param[in] file The handle returned by Submit
+  /// \return Status The error which happens while the file is read, if any
+  Status Release(const std::shared_ptr<PrefetchedFile> &file);
+
+  /// \brief Let the I/O threads quit
+  void Stop();
+
+  /// \brief Getter of the max number of blocks being read or waiting to be consumed
+  int32_t max_in_flight() const { return max_in_flight_; }
+
+  /// \brief Getter of the size of each read
+  int64_t block_size() const { return block_size_; }
+
+ private:
+  class StreamBuf;
+
+  // Open the file and get its size, called without the lock held.
+  Status OpenFile(PrefetchedFile *file);
+
+  // Wait until the file is opened or failed to open, open it by the calling thread if no I/O thread did.
+  Status WaitOpen(std::unique_lock<std::mutex> *lock, PrefetchedFile *file);
+
+  // Read a block of the file at the offset, called without the lock held.
+  Status ReadBlock(const PrefetchedFile *file, int64_t offset, std::vector<char> *block) const;
+
+  // Get the next block of the file in order, an empty block is returned at the end of the file.
+  Status NextBlock(PrefetchedFile *file, std::vector<char> *block);
+
+  // Keep the first error which happens while the file is read.
+  void RecordError(PrefetchedFile *file, const Status &rc);
+
+  // Pick a file whose next block can be read ahead, the lock must be held.
+  std::shared_ptr<PrefetchedFile> PickFile();
+
+  int32_t max_in_flight_;
+  int32_t max_per_file_;
+  int64_t block_size_;
+  int32_t outstanding_;
+  bool stop_;
+  std::list<std::shared_ptr<PrefetchedFile>> pending_;  // files with blocks left to read ahead, in submit order
+  std::mutex mux_;
+  CondVar cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_IO_PREFETCHER_H_
@@ -80,6 +80,7 @@ Status MappableLeafOp::operator()() {
     }
     while (sample_row.eoe() == false) {
       std::shared_ptr<Tensor> sample_ids = sample_row[0];
+      PrefetchSamples(sample_ids);
       for (auto itr = sample_ids->begin<int64_t>(); itr != sample_ids->end<int64_t>(); ++itr) {
         if ((*itr) >= num_rows_) {
           MS_LOG(WARNING) << "Skipping sample with ID: " << *itr << " since it is out of bound: " << num_rows_;
@@ -104,7 +105,7 @@ Status MappableLeafOp::operator()() {
   }
   RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::make_unique<IOBlock>(IOBlock::kFlagEOF)));
   for (int32_t i = 0; i < num_workers_; ++i) {
-    RETURN_IF_NOT_OK(SendQuitFlagToWorker(NextWorkerID()));
+    RETURN_IF_NOT_OK(SendQuitFlagToWorker(i));
   }
   return Status::OK();
 }
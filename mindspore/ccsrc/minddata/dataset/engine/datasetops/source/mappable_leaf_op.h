@@ -111,6 +111,11 @@ class MappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>, p
   /// \return Status The status code returned
   virtual Status LoadTensorRow(row_id_type row_id, TensorRow *row) = 0;
 
+  /// Virtual function called with every batch of sample ids before they are dispatched to the workers, so that the
+  /// leaf can start reading them ahead. The default does nothing.
+  /// \param sample_ids - ids of the upcoming rows, in the order they will be loaded
+  virtual void PrefetchSamples(const std::shared_ptr<Tensor> &sample_ids) {}
+
   /// Reset function to be called after every epoch to reset the source op after
   /// \return Status The status code returned
   Status Reset() override;
@@ -1,5 +1,5 @@
 /**
- * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ * Copyright 2019-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -62,6 +62,7 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  shard_reader_->SetMmapMode(GlobalContext::config_manager()->enable_mindrecord_mmap());
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
 
@@ -205,13 +206,37 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
   RETURN_UNEXPECTED_IF_NULL(fetched_row);
   *fetched_row = {};
+  // compressed blobs are decompressed into owned buffers by the reader, so they are not read as views
+  if (shard_reader_->GetMmapMode() && !shard_reader_->GetBlobCompressed()) {
+    auto task_content_ptr = std::make_shared<mindrecord::TASK_CONTENT_VIEW>(
+      mindrecord::TaskType::kCommonTask, std::vector<std::tuple<mindrecord::ShardBlobView, mindrecord::json>>());
+    RETURN_IF_NOT_OK(shard_reader_->GetNextViewById(row_id, worker_id, &task_content_ptr));
+    auto task_type = task_content_ptr->first;
+    if (task_type == mindrecord::TaskType::kPaddedTask) {
+      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, nullptr, 0, mindrecord::json(), task_type));
+      std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+      fetched_row->setPath(file_path);
+      fetched_row->setId(row_id);
+    } else if (task_type == mindrecord::TaskType::kCommonTask) {
+      for (const auto &tupled_row : task_content_ptr->second) {
+        const mindrecord::ShardBlobView &view = std::get<0>(tupled_row);
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(fetched_row, view.data, view.size, std::get<1>(tupled_row), task_type, view.holder));
+        std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+        fetched_row->setPath(file_path);
+        fetched_row->setId(row_id);
+      }
+    }
+    return Status::OK();
+  }
+
   auto task_content_ptr = std::make_shared<mindrecord::TASK_CONTENT>(
     mindrecord::TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>());
   RETURN_IF_NOT_OK(shard_reader_->GetNextById(row_id, worker_id, &task_content_ptr));
   auto task_type = task_content_ptr->first;
   auto tupled_buffer = task_content_ptr->second;
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, nullptr, 0, mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -221,9 +246,9 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob.data(), columns_blob.size(), columns_json, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -233,8 +258,24 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                                   const std::shared_ptr<mindrecord::ShardMappedFile> &blob_holder) {
+  // Numeric columns which are stored uncompressed in a mapped blob are wrapped without copying,
+  // the tensor keeps the mapping alive. Everything else is copied as before.
+  auto create_tensor = [&columns_blob, &blob_size, &blob_holder](const TensorShape &shape, const DataType &type,
+                                                                 const unsigned char *data, uint64_t n_bytes,
+                                                                 std::shared_ptr<Tensor> *out) {
+    bool in_blob = blob_holder != nullptr && data != nullptr && data >= columns_blob &&
+                   static_cast<uint64_t>(data - columns_blob) <= blob_size &&
+                   n_bytes <= blob_size - static_cast<uint64_t>(data - columns_blob);
+    if (in_blob && type.IsNumeric() && shape.NumOfElements() * type.SizeInBytes() == static_cast<dsize_t>(n_bytes)) {
+      return Tensor::CreateFromMemoryView(shape, type, const_cast<unsigned char *>(data),
+                                          static_cast<dsize_t>(n_bytes), blob_holder, out);
+    }
+    return Tensor::CreateFromMemory(shape, type, data, out);
+  };
+
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
 
@@ -270,9 +311,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
     } else {
-      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
-                                                          &n_bytes, &column_data_type, &column_data_type_size,
-                                                          &column_shape));
+      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data,
+                                                          &data_ptr, &n_bytes, &column_data_type,
+                                                          &column_data_type_size, &column_shape));
     }
 
     std::shared_ptr<Tensor> tensor;
@@ -294,11 +335,11 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       } else {
         RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(create_tensor(new_shape, type, data, n_bytes, &tensor));
     } else {
       std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
       auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(create_tensor(new_shape, type, data, n_bytes, &tensor));
     }
     tensor_row->push_back(std::move(tensor));
   }
@@ -329,6 +370,20 @@ Status MindRecordOp::PrepareData() {
   return Status::OK();
 }
 
+void MindRecordOp::PrefetchSamples(const std::shared_ptr<Tensor> &sample_ids) {
+  if (sample_ids == nullptr || !shard_reader_->GetMmapMode()) {
+    return;
+  }
+  std::vector<int64_t> ids;
+  ids.reserve(static_cast<size_t>(sample_ids->Size()));
+  for (auto itr = sample_ids->begin<int64_t>(); itr != sample_ids->end<int64_t>(); ++itr) {
+    if (*itr < num_rows_) {
+      ids.push_back(*itr);
+    }
+  }
+  shard_reader_->PrefetchByIds(ids);
+}
+
 Status MindRecordOp::RegisterAndLaunchThreads() {
   RETURN_IF_NOT_OK(ParallelOp::RegisterAndLaunchThreads());
   RETURN_IF_NOT_OK(shard_reader_->Launch(true));
@@ -371,8 +426,12 @@ Status MindRecordOp::AddNewWorkers(int32_t num_new_workers) {
   // launch new workers
   for (int32_t i = 0; i < num_new_workers; i++) {
     Task *new_task;
-    RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(
-      Name() + "::WorkerEntry", std::bind(&MindRecordOp::WorkerEntry, this, num_workers_), &new_task, id()));
+    int32_t worker_id = num_workers_;
+    auto entry = [this, worker_id]() -> Status {
+      RETURN_IF_NOT_OK(tree_->BindWorkerToNumaNode(worker_id));
+      return WorkerEntry(worker_id);
+    };
+    RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(Name() + "::WorkerEntry", entry, &new_task, id()));
     CHECK_FAIL_RETURN_UNEXPECTED(new_task != nullptr, "Cannot create a new worker.");
     worker_tasks_.push_back(new_task);
     num_workers_++;
@@ -123,9 +123,12 @@ class MindRecordOp : public MappableLeafOp {
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
   /// @param columns_blob - the blob data received from the reader
+  /// @param blob_size - the size of the blob data in bytes
   /// @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
+  /// @param blob_holder - the mapped file owning the blob data, if set the numeric columns are not copied
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                       const std::shared_ptr<mindrecord::ShardMappedFile> &blob_holder = nullptr);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
     return Status(StatusCode::kMDSyntaxError, "[Internal ERROR] Cannot call this method.");
@@ -134,6 +137,9 @@ class MindRecordOp : public MappableLeafOp {
   // @return - Status
   Status ComputeColMap() override;
 
+  /// Hint the shard reader about the rows which will be read next, only effective when the files are mapped.
+  void PrefetchSamples(const std::shared_ptr<Tensor> &sample_ids) override;
+
  protected:
   Status PrepareData() override;
 
@@ -78,6 +78,10 @@ class Multi30kOp : public TextFileOp {
   /// \param[in] worker_id The id of the worker that is executing this function.
   Status LoadFile(const std::string &file_en, int64_t start_offset, int64_t end_offset, int32_t worker_id);
 
+  /// \brief The file is read by its own stream instead of OpenFileStream, it is not read ahead.
+  /// \return False.
+  bool SupportIOPrefetch() const override { return false; }
+
   std::vector<std::string> language_pair_;
 };
 }  // namespace dataset
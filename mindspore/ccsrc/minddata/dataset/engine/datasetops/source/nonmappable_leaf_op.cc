@@ -15,6 +15,8 @@
  */
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 
+#include <algorithm>
+#include <fstream>
 #include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
@@ -25,9 +27,13 @@
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/wait_post.h"
+#include "utils/file_utils.h"
 
 namespace mindspore {
 namespace dataset {
+// Size of each read of the I/O engine
+constexpr int64_t kIOPrefetchBlockSize = 1024 * 1024;
+
 NonMappableLeafOp::NonMappableLeafOp(int32_t num_workers, int32_t worker_connector_size, int64_t total_num_rows,
                                      int32_t op_connector_size, bool shuffle_files, int32_t num_devices,
                                      int32_t device_id, const CompressionType &compression_type)
@@ -58,7 +64,9 @@ Status NonMappableLeafOp::operator()() {
   RETURN_IF_NOT_OK(PrepareData());
   while (!finished_reading_dataset_) {
     int32_t workers_done = 0;
-    int64_t rows_read = 0;
+    // the rows sought past in the first epoch are read already
+    int64_t rows_read = skipped_rows_;
+    skipped_rows_ = 0;
     {
       std::unique_lock<std::mutex> lock(load_io_block_queue_mutex_);
       load_io_block_queue_ = true;
@@ -134,16 +142,19 @@ Status NonMappableLeafOp::WorkerEntry(int32_t worker_id) {
 
   while (!io_block->eof()) {
     if (!io_block->eoe()) {
+      bool loaded = false;
       if (GetLoadJaggedConnector()) {
         std::string filename;
         RETURN_IF_NOT_OK(io_block->GetFilename(&filename, *filename_index_));
         int64_t start_offset = io_block->GetStartOffset();
         int64_t end_offset = io_block->GetEndOffset();
         RETURN_IF_NOT_OK(LoadFile(filename, start_offset, end_offset, worker_id));
+        loaded = true;
         RETURN_IF_NOT_OK(
           CollectOpInfoEnd(this->NameWithID(), "WorkerProcess", {{"TensorRowFlags", io_block->FlagName()}}));
         MS_LOG(DEBUG) << Name() << " operator worker " << worker_id << " loaded file " << filename << ".";
       }
+      RETURN_IF_NOT_OK(ReleasePrefetchedFile(worker_id, loaded));
     } else {
       TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
       RETURN_IF_NOT_OK(
@@ -173,6 +184,9 @@ Status NonMappableLeafOp::PostEndOfData() {
 // Pushes a control indicator onto the IOBlockQueue for each worker to consume. When the worker
 // pops this control indicator, it will wait until the next epoch starts and then resume execution.
 Status NonMappableLeafOp::PostEndOfEpoch(int32_t queue_index) {
+  if (seek_rows_ > 0) {
+    RETURN_IF_NOT_OK(PushSoughtIoBlocks());
+  }
   for (int i = 0; i < num_workers_; ++i) {
     std::unique_ptr<FilenameBlock> eoe = std::make_unique<FilenameBlock>(IOBlock::kFlagEOE);
     RETURN_IF_NOT_OK(PushIoBlockQueue((queue_index + i) % num_workers_, std::move(eoe)));
@@ -181,21 +195,166 @@ Status NonMappableLeafOp::PostEndOfEpoch(int32_t queue_index) {
   return Status::OK();
 }
 
+Status NonMappableLeafOp::PushSoughtIoBlocks() {
+  int64_t seek_rows = seek_rows_;
+  seek_rows_ = 0;
+  auto num_workers = static_cast<size_t>(num_workers_);
+  held_io_blocks_.resize(num_workers);
+  // the rows left in the blocks of each worker
+  std::vector<int64_t> rows_left(num_workers, 0);
+  for (size_t i = 0; i < num_workers; ++i) {
+    for (const auto &io_block : held_io_blocks_[i]) {
+      int64_t start_offset = io_block->GetStartOffset();
+      int64_t end_offset = io_block->GetEndOffset();
+      CHECK_FAIL_RETURN_UNEXPECTED(start_offset >= 0 && end_offset >= start_offset,
+                                   "[Internal ERROR] The rows of an io block to seek past are unknown.");
+      rows_left[i] += end_offset - start_offset;
+    }
+  }
+  // Replay the pops of the master from the jagged connector, which takes a row from each worker in turn, and drops a
+  // worker once it pops the eoe sent after the rows of the worker.
+  std::vector<bool> finished(num_workers, false);
+  std::vector<int64_t> rows_taken(num_workers, 0);
+  size_t pop_from = 0;
+  int64_t rows_skipped = 0;
+  while (rows_skipped < seek_rows &&
+         std::any_of(finished.begin(), finished.end(), [](bool worker_finished) { return !worker_finished; })) {
+    if (rows_left[pop_from] == 0) {
+      finished[pop_from] = true;
+    } else {
+      --rows_left[pop_from];
+      ++rows_taken[pop_from];
+      ++rows_skipped;
+    }
+    for (size_t offset = 1; offset <= num_workers; ++offset) {
+      size_t next = (pop_from + offset) % num_workers;
+      if (!finished[next]) {
+        pop_from = next;
+        break;
+      }
+    }
+  }
+  MS_LOG(INFO) << Name() << " seeks past " << rows_skipped << " rows of the epoch.";
+
+  // Drop the blocks taken by the replay and cut the block taken in part. The worker which pops next becomes the first
+  // worker, so that the master takes the rows left in the same order.
+  std::vector<std::vector<std::unique_ptr<FilenameBlock>>> io_blocks(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    auto &worker_blocks = held_io_blocks_[(pop_from + i) % num_workers];
+    int64_t rows_to_drop = rows_taken[(pop_from + i) % num_workers];
+    for (auto &io_block : worker_blocks) {
+      int64_t start_offset = io_block->GetStartOffset();
+      int64_t end_offset = io_block->GetEndOffset();
+      if (rows_to_drop >= end_offset - start_offset) {
+        rows_to_drop -= end_offset - start_offset;
+        continue;
+      }
+      if (rows_to_drop > 0) {
+        int64_t key = 0;
+        RETURN_IF_NOT_OK(io_block->GetKey(&key));
+        io_block = std::make_unique<FilenameBlock>(key, start_offset + rows_to_drop, end_offset, IOBlock::kFlagNone);
+        rows_to_drop = 0;
+      }
+      io_blocks[i].push_back(std::move(io_block));
+    }
+    worker_blocks.clear();
+  }
+  // Push the blocks in turn as FillIOBlockQueue does, so that no worker waits for the blocks of another one.
+  size_t max_num_blocks = 0;
+  for (const auto &worker_blocks : io_blocks) {
+    max_num_blocks = std::max(max_num_blocks, worker_blocks.size());
+  }
+  for (size_t j = 0; j < max_num_blocks; ++j) {
+    for (size_t i = 0; i < num_workers; ++i) {
+      if (j < io_blocks[i].size()) {
+        RETURN_IF_NOT_OK(PushIoBlockQueue(static_cast<int32_t>(i), std::move(io_blocks[i][j])));
+      }
+    }
+  }
+  return Status::OK();
+}
+
 // Notifies the thread which called WaitToFillIOBlockQueue to resume execution.
 void NonMappableLeafOp::NotifyToFillIOBlockQueue() { io_block_queue_wait_post_.Set(); }
 
 // Pops an element from a queue in io_block_queues
 Status NonMappableLeafOp::PopIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> *out_block) {
   RETURN_IF_NOT_OK(io_block_queues_[index]->PopFront(out_block));
+  if (io_prefetcher_ != nullptr && !(*out_block)->eoe() && !(*out_block)->eof()) {
+    // the file of the block is submitted to the I/O engine before the block is pushed
+    std::unique_lock<std::mutex> lock(prefetched_files_mutex_);
+    CHECK_FAIL_RETURN_UNEXPECTED(!prefetched_files_[index].empty(),
+                                 "[Internal ERROR] The file to load is not submitted to the I/O engine.");
+    loading_files_[index] = std::move(prefetched_files_[index].front());
+    prefetched_files_[index].pop_front();
+  }
   return Status::OK();
 }
 
 // Pushes an element to a queue in io_block_queues
 Status NonMappableLeafOp::PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> &&io_block) {
+  if (seek_rows_ > 0 && !io_block->eoe() && !io_block->eof()) {
+    // the blocks are held until the position to seek to is worked out at the end of the epoch
+    held_io_blocks_.resize(num_workers_);
+    held_io_blocks_[index].push_back(std::move(io_block));
+    return Status::OK();
+  }
+  if (io_prefetcher_ != nullptr && !io_block->eoe() && !io_block->eof()) {
+    std::string filename;
+    RETURN_IF_NOT_OK(io_block->GetFilename(&filename, *filename_index_));
+    auto realpath = FileUtils::GetRealPath(filename.c_str());
+    // a file which does not exist is not read ahead, the error is reported when it is loaded
+    std::shared_ptr<PrefetchedFile> file = realpath.has_value() ? io_prefetcher_->Submit(realpath.value()) : nullptr;
+    std::unique_lock<std::mutex> lock(prefetched_files_mutex_);
+    prefetched_files_[index].push_back(std::move(file));
+  }
   RETURN_IF_NOT_OK(io_block_queues_[index]->Add(std::move(io_block)));
   return Status::OK();
 }
 
+Status NonMappableLeafOp::OpenFileStream(const std::string &realpath, int32_t worker_id,
+                                         std::unique_ptr<std::istream> *stream, std::ios_base::openmode mode) {
+  RETURN_UNEXPECTED_IF_NULL(stream);
+  if (io_prefetcher_ != nullptr && worker_id >= 0 && static_cast<size_t>(worker_id) < loading_files_.size() &&
+      loading_files_[worker_id] != nullptr && loading_files_[worker_id]->path() == realpath) {
+    return io_prefetcher_->OpenStream(loading_files_[worker_id], stream);
+  }
+  *stream = std::make_unique<std::ifstream>(realpath, mode);
+  return Status::OK();
+}
+
+Status NonMappableLeafOp::LaunchIOPrefetcher() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int32_t depth = GlobalContext::config_manager()->io_prefetch_depth();
+  if (depth <= 0 || !SupportIOPrefetch()) {
+    return Status::OK();
+  }
+  // spread the blocks in flight over the files being loaded by the workers
+  int32_t max_per_file = (depth + num_workers_ - 1) / num_workers_;
+  io_prefetcher_ = std::make_unique<IOPrefetcher>(depth, max_per_file, kIOPrefetchBlockSize);
+  prefetched_files_.resize(num_workers_);
+  loading_files_.resize(num_workers_);
+  RETURN_IF_NOT_OK(io_prefetcher_->Register(tree_->AllTasks()));
+  // one I/O thread for each block read in flight, but no more than the cpu threads
+  int32_t num_io_workers = std::min(depth, GlobalContext::config_manager()->num_cpu_threads());
+  RETURN_IF_NOT_OK(tree_->LaunchWorkers(
+    num_io_workers, std::bind(&IOPrefetcher::IOWorkerEntry, io_prefetcher_.get(), std::placeholders::_1),
+    Name() + "::IOWorkerEntry", id()));
+#endif
+  return Status::OK();
+}
+
+Status NonMappableLeafOp::ReleasePrefetchedFile(int32_t worker_id, bool loaded) {
+  if (io_prefetcher_ == nullptr || loading_files_[worker_id] == nullptr) {
+    return Status::OK();
+  }
+  std::shared_ptr<PrefetchedFile> file = std::move(loading_files_[worker_id]);
+  loading_files_[worker_id] = nullptr;
+  Status rc = io_prefetcher_->Release(file);
+  // the error of a skipped file is ignored, it is not read by the worker
+  return loaded ? rc : Status::OK();
+}
+
 // Overrides base class reset method. Cleans up any state info from it's previous execution and
 // reinitializes itself so that it can be executed again, as if it was just created.
 Status NonMappableLeafOp::Reset() {
@@ -314,6 +473,9 @@ Status NonMappableLeafOp::PrepareData() {
   // Put here to avoid register failed when Worker_Entry thread exits unexpected
   RETURN_IF_NOT_OK(io_block_queue_wait_post_.Register(tree_->AllTasks()));
 
+  // launch the I/O engine before any io block is pushed
+  RETURN_IF_NOT_OK(LaunchIOPrefetcher());
+
   // launch one thread, responsible for filling IOBlockQueue
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(1, std::bind(&NonMappableLeafOp::WaitToFillIOBlockQueue, this), "", id()));
 
@@ -401,6 +563,9 @@ Status NonMappableLeafOp::ResetAndUpdateRepeat() {
   if (IsLastIteration()) {
     finished_reading_dataset_ = true;
     NotifyToFillIOBlockQueue();
+    if (io_prefetcher_ != nullptr) {
+      io_prefetcher_->Stop();
+    }
   } else {
     jagged_rows_connector_->DoReset();
     // Self-reset to start a new iteration
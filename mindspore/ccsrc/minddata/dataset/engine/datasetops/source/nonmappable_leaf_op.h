@@ -17,6 +17,8 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_NONMAPPABLE_LEAF_OP_H_
 
 #include <algorithm>
+#include <deque>
+#include <istream>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,6 +30,7 @@
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/datasetops/source/io_prefetcher.h"
 
 namespace mindspore {
 namespace dataset {
@@ -111,6 +114,21 @@ class NonMappableLeafOp : public ParallelOp<TensorRow, TensorRow> {
   /// \return Status The status code returned
   Status GetNextRowPullMode(TensorRow *const row) override;
 
+  /// \brief Whether the op can start its first epoch past a number of rows without reading them, which needs the
+  ///     exact number of rows of each io block.
+  /// \return True if SetSeekRows() can be called
+  virtual bool SupportSeek() const { return false; }
+
+  /// \brief Start the first epoch after the launch past the given number of rows. The io blocks of the epoch are held
+  ///     until all of them are filled, then the file and the row offset in it where each worker resumes are worked out
+  ///     from the row counts of the blocks. The files before are not read, and the rows before the offset are not
+  ///     loaded. Only called before the launch, and only if SupportSeek() is true.
+  /// \param[in] rows The number of rows to seek past
+  void SetSeekRows(int64_t rows) {
+    seek_rows_ = rows;
+    skipped_rows_ = rows;
+  }
+
  protected:
   // The entry point for when workers are launched.
   // @param worker_id - the id of the worker that is executing this function.
@@ -127,6 +145,11 @@ class NonMappableLeafOp : public ParallelOp<TensorRow, TensorRow> {
   // @return Status - the error code returned.
   Status PostEndOfEpoch(int32_t queue_index);
 
+  // Pushes the io blocks held for the seek, without the rows to seek past. The blocks are assigned to the workers so
+  // that the rows after the seek are sent in the same order as they would be without it.
+  // @return Status - the error code returned.
+  Status PushSoughtIoBlocks();
+
   // Called asynchronously by another thread. Will wait until notified to fill the IOBlockQueue.
   // @return Status - the error code returned.
   Status WaitToFillIOBlockQueue();
@@ -163,6 +186,21 @@ class NonMappableLeafOp : public ParallelOp<TensorRow, TensorRow> {
   bool NeedPushFileToBlockQueue(const std::string &file_name, int64_t *start_offset, int64_t *end_offset,
                                 const int64_t &pre_count);
 
+  /// \brief Whether LoadFile reads the file through OpenFileStream, so that the file can be read ahead by the
+  ///     I/O engine of the op when the io prefetch depth is set.
+  /// \return True if the file read by LoadFile can be read ahead
+  virtual bool SupportIOPrefetch() const { return false; }
+
+  /// \brief Open the file which is being loaded by the worker. When the file is read ahead by the I/O engine, the
+  ///     stream reads the blocks fetched ahead, otherwise the file is opened as a std::ifstream.
+  /// \param[in] realpath The real path of the file
+  /// \param[in] worker_id The id of the worker that is loading the file
+  /// \param[out] stream The stream to read the file, its fail bit is set if the file can not be opened
+  /// \param[in] mode The mode to open the file
+  /// \return Status The status code returned
+  Status OpenFileStream(const std::string &realpath, int32_t worker_id, std::unique_ptr<std::istream> *stream,
+                        std::ios_base::openmode mode = std::ios_base::in);
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   virtual Status CalculateNumRowsPerShard() = 0;
@@ -204,6 +242,16 @@ class NonMappableLeafOp : public ParallelOp<TensorRow, TensorRow> {
   /// \return Status The status code returned
   Status ResetAndUpdateRepeat();
 
+  /// \brief Create the I/O engine and launch its threads if the io prefetch depth is set.
+  /// \return Status The status code returned
+  Status LaunchIOPrefetcher();
+
+  /// \brief Release the file read ahead for the worker after it is loaded or skipped.
+  /// \param[in] worker_id The id of the worker
+  /// \param[in] loaded Whether the file is loaded by the worker
+  /// \return Status The error which happens while the loaded file is read, if any
+  Status ReleasePrefetchedFile(int32_t worker_id, bool loaded);
+
   int32_t device_id_;
   int32_t num_devices_;
   bool load_jagged_connector_;
@@ -228,6 +276,15 @@ class NonMappableLeafOp : public ParallelOp<TensorRow, TensorRow> {
   uint32_t curr_row_;      // current row number count for pull mode
   uint32_t workers_done_;  // how many workers have done the tensors reading work for pull mode
 
+  std::unique_ptr<IOPrefetcher> io_prefetcher_;  // reads the files ahead, only set when io prefetch depth is set
+  std::mutex prefetched_files_mutex_;
+  std::vector<std::deque<std::shared_ptr<PrefetchedFile>>> prefetched_files_;  // files submitted for each worker
+  std::vector<std::shared_ptr<PrefetchedFile>> loading_files_;                  // file being loaded by each worker
+
+  int64_t seek_rows_{0};     // rows to seek past when the io blocks of the first epoch are filled, see SetSeekRows()
+  int64_t skipped_rows_{0};  // rows sought past, counted as read by the master in the first epoch
+  std::vector<std::vector<std::unique_ptr<FilenameBlock>>> held_io_blocks_;  // io blocks of each worker for the seek
+
  private:
   std::vector<int64_t> shuffled_keys_;  // to store shuffled filename indices
   uint32_t seed_;                       // used to shuffle filename indices
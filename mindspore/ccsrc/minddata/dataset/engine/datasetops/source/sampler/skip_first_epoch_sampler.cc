@@ -15,10 +15,63 @@
  */
 
 #include "minddata/dataset/engine/datasetops/source/sampler/skip_first_epoch_sampler.h"
+#include <algorithm>
 #include <string>
 
 namespace mindspore {
 namespace dataset {
+Status SkipFirstEpochSamplerRT::InitSampler() {
+  // A pipeline state may be restored after all the rows of an epoch are got, then the whole epoch is skipped
+  if (is_initialized || (skip_plan_ == nullptr && start_index_ < num_rows_)) {
+    return SequentialSamplerRT::InitSampler();
+  }
+  if (skip_plan_ != nullptr) {
+    start_index_ = skip_plan_->count;
+    keep_ = skip_plan_->keep;
+  }
+  current_id_ = start_index_;
+  CHECK_FAIL_RETURN_UNEXPECTED(start_index_ >= 0 && start_index_ <= num_rows_,
+                               "[Internal ERROR] Invalid number of rows to skip in the first epoch: " +
+                                 std::to_string(start_index_) + ", num_rows: " + std::to_string(num_rows_));
+  num_samples_ = num_rows_ - start_index_ + static_cast<int64_t>(keep_.size());
+  if (num_samples_ > 0) {
+    samples_per_tensor_ = std::min(samples_per_tensor_, num_samples_);
+  }
+  is_initialized = true;
+  return Status::OK();
+}
+
+Status SkipFirstEpochSamplerRT::GetNextSample(TensorRow *out) {
+  if (first_epoch_done_ || keep_.empty()) {
+    return SequentialSamplerRT::GetNextSample(out);
+  }
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (id_count_ == num_samples_) {
+    (*out) = TensorRow(TensorRow::kFlagEOE);
+    return Status::OK();
+  }
+  if (HasChildSampler()) {
+    RETURN_IF_NOT_OK(child_[0]->GetNextSample(&child_ids_));
+  }
+  std::shared_ptr<Tensor> sample_ids;
+  int64_t num_elements = std::min(num_samples_ - id_count_, samples_per_tensor_);
+  RETURN_IF_NOT_OK(CreateSamplerTensor(&sample_ids, num_elements));
+  auto id_ptr = sample_ids->begin<int64_t>();
+  for (int64_t i = 0; i < num_elements; i++) {
+    // The kept ids come first, then the ids from start_index_ on
+    int64_t position = id_count_ + i;
+    int64_t sampled_id = position < static_cast<int64_t>(keep_.size()) ? keep_[position] : current_id_++;
+    if (HasChildSampler()) {
+      RETURN_IF_NOT_OK(GetAssociatedChildId(&sampled_id, sampled_id));
+    }
+    *id_ptr = sampled_id;
+    ++id_ptr;
+  }
+  id_count_ += num_elements;
+  (*out) = {sample_ids};
+  return Status::OK();
+}
+
 Status SkipFirstEpochSamplerRT::ResetSampler(const bool failover_reset) {
   // This is a special sampler for Failover Reset, its internal state should
   // not reset when failover_reset is set to true.
@@ -34,7 +87,8 @@ Status SkipFirstEpochSamplerRT::ResetSampler(const bool failover_reset) {
     id_count_ = 0;
 
     if (!first_epoch_done_) {
-      num_samples_ += start_index_;
+      num_samples_ += start_index_ - static_cast<int64_t>(keep_.size());
+      keep_.clear();
       start_index_ = 0;
       samples_per_tensor_ = num_samples_;
       first_epoch_done_ = true;
@@ -16,8 +16,12 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_SKIP_FIRST_EPOCH_SAMPLER_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_SKIP_FIRST_EPOCH_SAMPLER_H_
 
+#include <memory>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sequential_sampler.h"
 
 namespace mindspore {
@@ -30,6 +34,15 @@ class SkipFirstEpochSamplerRT : public SequentialSamplerRT {
   // Destructor.
   ~SkipFirstEpochSamplerRT() = default;
 
+  /// \brief Init sampler, taking the start index and the rows to keep from the skip plan if there is one.
+  /// \return Status The status code returned
+  Status InitSampler() override;
+
+  /// \brief Gets the next sample ids, the first epoch starts with the rows kept by the skip plan.
+  /// \param[out] out The sample ids
+  /// \return Status The status code returned
+  Status GetNextSample(TensorRow *out) override;
+
   /// \brief Reset for next epoch.
   /// \param[in] failover_reset A boolean to show whether we are resetting the pipeline
   /// \return Status The status code returned
@@ -52,8 +65,14 @@ class SkipFirstEpochSamplerRT : public SequentialSamplerRT {
   /// \return Status of the function
   Status to_json(nlohmann::json *out_json) override;
 
+  /// \brief Skip the rows of a plan in the first epoch instead of the rows before start_index.
+  /// \param[in] skip_plan The plan filled in by the ShuffleOp above before the pipeline is launched.
+  void SetSkipPlan(const std::shared_ptr<SkipPlan> &skip_plan) { skip_plan_ = skip_plan; }
+
  private:
   bool first_epoch_done_ = false;
+  std::shared_ptr<SkipPlan> skip_plan_;
+  std::vector<int64_t> keep_;  // The ids before start_index_ which are sampled first in the first epoch
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -78,6 +78,10 @@ class SST2Op : public CsvOp {
   /// @return Status The error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  /// \brief The file is read by its own stream instead of OpenFileStream, it is not read ahead.
+  /// \return False.
+  bool SupportIOPrefetch() const override { return false; }
+
   std::string usage_;
 };
 }  // namespace dataset
@@ -84,8 +84,9 @@ Status TextFileOp::LoadFile(const std::string &file, int64_t start_offset, int64
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + file + " does not exist.");
   }
 
-  std::ifstream handle(realpath.value());
-  if (!handle.is_open()) {
+  std::unique_ptr<std::istream> handle;
+  RETURN_IF_NOT_OK(OpenFileStream(realpath.value(), worker_id, &handle));
+  if (handle->fail()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open text:" + file +
                              ", the file is damaged or permission denied.");
   }
@@ -93,7 +94,7 @@ Status TextFileOp::LoadFile(const std::string &file, int64_t start_offset, int64
   int64_t rows_total = 0;
   std::string line;
 
-  while (getline(handle, line)) {
+  while (getline(*handle, line)) {
     if (line.empty()) {
       continue;
     }
@@ -98,6 +98,14 @@ class TextFileOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // The file is read through OpenFileStream, so it can be read ahead.
+  // @return - true.
+  bool SupportIOPrefetch() const override { return true; }
+
+  // The io blocks are cut by the rows counted in each file, so the op can seek past the rows of its first epoch.
+  // @return - true.
+  bool SupportSeek() const override { return true; }
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard() override;
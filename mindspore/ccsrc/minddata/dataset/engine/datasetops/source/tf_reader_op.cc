@@ -133,7 +133,9 @@ Status TFReaderOp::operator()() {
   RETURN_IF_NOT_OK(PrepareData());
   while (!finished_reading_dataset_) {
     int32_t workers_done = 0;
-    int64_t rows_read = 0;
+    // the rows sought past in the first epoch are read already
+    int64_t rows_read = skipped_rows_;
+    skipped_rows_ = 0;
     {
       std::unique_lock<std::mutex> lock(load_io_block_queue_mutex_);
       load_io_block_queue_ = true;
@@ -312,38 +314,49 @@ Status TFReaderOp::SendRecordBytesRow(const std::string &filename, const std::st
 
 Status TFReaderOp::HelperLoadNonCompFile(const std::string &filename, int64_t start_offset, int64_t end_offset,
                                          int32_t worker_id, const std::string &realpath_value) {
-  std::ifstream reader;
-  reader.open(realpath_value);
-  if (!reader) {
+  std::unique_ptr<std::istream> reader;
+  RETURN_IF_NOT_OK(OpenFileStream(realpath_value, worker_id, &reader));
+  if (reader->fail()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
   }
 
   int64_t rows_total = 0;
 
-  while (reader.peek() != EOF) {
+  while (reader->peek() != EOF) {
     if (!GetLoadJaggedConnector()) {
       break;
     }
     RETURN_IF_INTERRUPTED();
+    // the records after the end offset are not read
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
 
     // read length
     std::streamsize record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), kTFRecordRecLenSize);
+    (void)reader->read(reinterpret_cast<char *>(&record_length), kTFRecordRecLenSize);
 
     // ignore crc header
-    (void)reader.ignore(kTFRecordHeadFootSize);
+    (void)reader->ignore(kTFRecordHeadFootSize);
+
+    // the records before the start offset are passed over without being copied
+    if (start_offset != kInvalidOffset && rows_total < start_offset) {
+      (void)reader->ignore(static_cast<std::streamsize>(record_length + kTFRecordHeadFootSize));
+      rows_total++;
+      continue;
+    }
 
     // read serialized Example
     std::string serialized_example;
     serialized_example.resize(static_cast<size_t>(record_length));
-    (void)reader.read(&serialized_example[0], record_length);
+    (void)reader->read(&serialized_example[0], record_length);
 
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
       RETURN_IF_NOT_OK(SendRecordBytesRow(filename, serialized_example, worker_id));
     }
 
     // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(kTFRecordHeadFootSize));
+    (void)reader->ignore(static_cast<std::streamsize>(kTFRecordHeadFootSize));
     rows_total++;
   }
   return Status::OK();
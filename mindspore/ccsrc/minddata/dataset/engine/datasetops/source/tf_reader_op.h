@@ -151,6 +151,14 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // The uncompressed file is read through OpenFileStream, so it can be read ahead.
+  // @return - true if the files are not compressed.
+  bool SupportIOPrefetch() const override { return compression_type_ == CompressionType::NONE; }
+
+  // The rows of the io blocks are known when the files are not compressed and each shard reads an equal number of rows.
+  // @return - true if the op can seek past the rows of its first epoch.
+  bool SupportSeek() const override { return compression_type_ == CompressionType::NONE && equal_rows_per_shard_; }
+
   /// \brief Create a TensorRow with the given example string and send it to parsing workers.
   /// \param[in] filename The file from which the example string originated.
   /// \param[in] serialized_example The example string.
@@ -21,6 +21,7 @@
 
 #include "minddata/dataset/engine/datasetops/data_queue_op.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/numa_partition.h"
 #include "minddata/dataset/engine/perf/info_collector.h"
 #include "minddata/dataset/util/task_manager.h"
 #ifdef WITH_BACKEND
@@ -175,6 +176,19 @@ Status ExecutionTree::Launch() {
     MS_LOG(INFO) << "Numa bind memory and cpu successful.";
   }
 #endif
+  // In NUMA partitioned mode, the workers of the parallel ops are spread over the NUMA nodes instead, see
+  // BindWorkerToNumaNode. It does not apply when the whole process is bound to one node above.
+  bool numa_partition = GlobalContext::config_manager()->numa_partition();
+#ifdef WITH_BACKEND
+  if (numa_partition && numa_enable_ && rank_id_ >= 0) {
+    MS_LOG(WARNING) << "The process is bound to one numa node, the pipeline is not partitioned over the numa nodes.";
+    numa_partition = false;
+  }
+#endif
+  if (numa_partition) {
+    num_numa_nodes_ = NumaPartition::GetInstance()->NumNodes();
+    MS_LOG(INFO) << "The pipeline is partitioned over " << num_numa_nodes_ << " numa node(s).";
+  }
   int32_t thread_num = get_nprocs();
   if (thread_num == 0) {
     std::string err_msg = "Invalid thread number, got 0.";
@@ -196,6 +210,12 @@ Status ExecutionTree::Launch() {
   ss << *this;
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    // The rows are routed to the workers of their NUMA nodes, see NumaPartition::WorkerOfRow, which needs a worker on
+    // every node.
+    if (num_numa_nodes_ > 1 && itr->NumWorkers() > 1 && itr->NumWorkers() < num_numa_nodes_) {
+      MS_LOG(INFO) << itr->NameWithID() << " has " << itr->NumWorkers() << " workers, which is fewer than the "
+                   << num_numa_nodes_ << " numa nodes, so its rows move across the nodes.";
+    }
     // An inlined operator is one that has an output connector size of 0, and it does not
     // require a thread to execute.  Instead, the work of this operator is executed inlined
     // from the tree node directly above it (or in the case of a root node, it runs from within
@@ -245,9 +265,17 @@ Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(ui
                     << std::to_string(num_cpu_threads) << ", the maximum number of threads on this CPU.";
   }
   worker_tasks->resize(num_workers);
+  // A single worker, e.g. the collector of an op, keeps floating over all the nodes
+  auto entry = func;
+  if (num_numa_nodes_ > 1 && num_workers > 1) {
+    entry = [this, func](uint32_t worker_id) -> Status {
+      RETURN_IF_NOT_OK(BindWorkerToNumaNode(static_cast<int32_t>(worker_id)));
+      return func(worker_id);
+    };
+  }
   for (size_t i = 0; i < num_workers; ++i) {
     Task *task = nullptr;
-    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, std::bind(func, i), &task, operator_id));
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, std::bind(entry, i), &task, operator_id));
     CHECK_FAIL_RETURN_UNEXPECTED(task != nullptr, "Failed to create a new worker");
     (*worker_tasks)[i] = task;
   }
@@ -262,6 +290,21 @@ Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(ui
   return LaunchWorkers(num_workers, func, &tasks, name, operator_id);
 }
 
+Status ExecutionTree::BindWorkerToNumaNode(int32_t worker_id) {
+  if (num_numa_nodes_ <= 1) {
+    return Status::OK();
+  }
+  auto numa_partition = NumaPartition::GetInstance();
+  return numa_partition->BindThread(numa_partition->NodeOfWorker(worker_id));
+}
+
+int32_t ExecutionTree::WorkerOfRow(int64_t row, int32_t num_workers) const {
+  if (num_numa_nodes_ <= 1) {
+    return static_cast<int32_t>(row % num_workers);
+  }
+  return NumaPartition::WorkerOfRow(row, num_workers, num_numa_nodes_);
+}
+
 // Walks the tree to perform modifications to the tree in post-order to get it ready for execution.
 Status ExecutionTree::Prepare(bool is_pull_mode) {
   if (root_ == nullptr) {
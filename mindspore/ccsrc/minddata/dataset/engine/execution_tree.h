@@ -1,5 +1,5 @@
 /**
- * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ * Copyright 2019-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -180,6 +180,19 @@ class ExecutionTree {
   Status LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name = "",
                        int32_t operator_id = -1);
 
+  /// \brief In NUMA partitioned mode, pin the calling worker thread of a parallel op to the NUMA node of the worker,
+  ///     and let it allocate from the memory pool of that node. Otherwise do nothing.
+  /// \param worker_id - The id of the worker in its op
+  /// \return Status The status code returned
+  Status BindWorkerToNumaNode(int32_t worker_id);
+
+  /// \brief The worker of a parallel op a row is dispatched to, in turn unless the rows are routed to the workers of
+  ///     their NUMA nodes, see NumaPartition::WorkerOfRow
+  /// \param row The index of the row in the op
+  /// \param num_workers The number of workers of the op
+  /// \return The id of the worker
+  int32_t WorkerOfRow(int64_t row, int32_t num_workers) const;
+
   /// \brief Getter method
   /// \return shared_ptr to the root operator
   std::shared_ptr<DatasetOp> root() const { return root_; }
@@ -236,6 +249,7 @@ class ExecutionTree {
   uint32_t prepare_flags_;           // Flags used during tree prepare
   TreeState tree_state_;             // Tracking the current tree state
   std::string unique_id_;            // A unique identifier for the tree
+  int32_t num_numa_nodes_{1};        // Number of NUMA nodes the workers are spread over, 1 unless NUMA partitioned
 
 #ifdef WITH_BACKEND
   // Constructor for if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
@@ -0,0 +1,504 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr_store.h"
+
+#include <sys/stat.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/path.h"
+#include "utils/file_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+constexpr char kCsrMagic[8] = {'M', 'S', 'G', 'N', 'N', 'C', 'S', 'R'};
+constexpr uint32_t kCsrVersion = 1;
+constexpr uint64_t kCsrAlignment = 8;
+constexpr int kMaxFeatureRank = 8;
+
+// The arrays of the file, each starting at an offset recorded in the header
+enum CsrSection : int {
+  kNodeIds = 0,
+  kNodeTypes,
+  kRowOffsets,
+  kNeighborNodes,
+  kNeighborEdges,
+  kNeighborWeights,
+  kEdgeIds,
+  kEdgeTypes,
+  kEdgeSrc,
+  kEdgeDst,
+  kFeatureTable,
+  kNumSections
+};
+
+struct CsrHeader {
+  char magic[sizeof(kCsrMagic)];
+  uint32_t version;
+  uint32_t num_features;
+  int64_t num_nodes;
+  int64_t num_edges;
+  int64_t source_size;
+  int64_t source_mtime;
+  uint64_t sections[kNumSections];
+};
+
+struct CsrFeatureRecord {
+  int32_t is_edge;
+  FeatureType type;
+  uint8_t data_type;
+  uint8_t rank;
+  int64_t dims[kMaxFeatureRank];
+  uint64_t present_offset;
+  uint64_t data_offset;
+};
+
+Status GetSourceStat(const std::string &source, int64_t *size, int64_t *mtime) {
+  struct stat source_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(source.c_str(), &source_stat) == 0,
+                               "Invalid file, failed to get the status of graph file: " + source);
+  *size = static_cast<int64_t>(source_stat.st_size);
+  *mtime = static_cast<int64_t>(source_stat.st_mtime);
+  return Status::OK();
+}
+
+// Appends the arrays to the file, each aligned for the type of its elements
+class CsrFileWriter {
+ public:
+  explicit CsrFileWriter(const std::string &path) : path_(path), out_(path, std::ios::binary | std::ios::trunc) {}
+
+  Status Append(const void *data, uint64_t len, uint64_t *offset = nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(out_.good(), "Failed to write graph CSR store: " + path_);
+    static const char padding[kCsrAlignment] = {0};
+    uint64_t pad = (kCsrAlignment - pos_ % kCsrAlignment) % kCsrAlignment;
+    (void)out_.write(padding, static_cast<std::streamsize>(pad));
+    pos_ += pad;
+    if (offset != nullptr) {
+      *offset = pos_;
+    }
+    (void)out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(len));
+    pos_ += len;
+    CHECK_FAIL_RETURN_UNEXPECTED(out_.good(), "Failed to write graph CSR store: " + path_);
+    return Status::OK();
+  }
+
+  // Append without aligning, to pack the items of an array written one at a time
+  Status AppendPacked(const void *data, uint64_t len) {
+    (void)out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(len));
+    pos_ += len;
+    CHECK_FAIL_RETURN_UNEXPECTED(out_.good(), "Failed to write graph CSR store: " + path_);
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status Append(const std::vector<T> &data, uint64_t *offset) {
+    return Append(data.data(), data.size() * sizeof(T), offset);
+  }
+
+  Status WriteHeader(const CsrHeader &header) {
+    (void)out_.seekp(0);
+    (void)out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out_.close();
+    CHECK_FAIL_RETURN_UNEXPECTED(!out_.fail(), "Failed to write graph CSR store: " + path_);
+    return Status::OK();
+  }
+
+ private:
+  std::string path_;
+  std::ofstream out_;
+  uint64_t pos_ = 0;
+};
+
+// Write the presence flags and the data of a feature of all the nodes or all the edges
+template <typename T>
+Status WriteFeature(const std::vector<std::shared_ptr<T>> &items, const std::shared_ptr<Feature> &default_feature,
+                    bool is_edge, CsrFileWriter *writer, CsrFeatureRecord *record) {
+  const std::shared_ptr<Tensor> &default_value = default_feature->Value();
+  const FeatureType type = default_feature->type();
+  CHECK_FAIL_RETURN_UNEXPECTED(default_value->type().IsNumeric() && default_value->Rank() <= kMaxFeatureRank,
+                               "Feature " + std::to_string(type) + " of type " + default_value->type().ToString() +
+                                 " and rank " + std::to_string(default_value->Rank()) + " is not supported by CSR.");
+  record->is_edge = is_edge ? 1 : 0;
+  record->type = type;
+  record->data_type = static_cast<uint8_t>(default_value->type().value());
+  record->rank = static_cast<uint8_t>(default_value->Rank());
+  for (int i = 0; i < kMaxFeatureRank; ++i) {
+    record->dims[i] = i < record->rank ? default_value->shape()[i] : 0;
+  }
+
+  std::vector<std::shared_ptr<Tensor>> values(items.size());
+  std::vector<uint8_t> present(items.size(), 0);
+  for (size_t i = 0; i < items.size(); ++i) {
+    std::shared_ptr<Feature> feature;
+    if (!items[i]->GetFeatures(type, &feature).IsOk()) {
+      continue;
+    }
+    values[i] = feature->Value();
+    CHECK_FAIL_RETURN_UNEXPECTED(values[i]->type() == default_value->type() &&
+                                   values[i]->shape() == default_value->shape(),
+                                 "Feature " + std::to_string(type) + " of " + std::to_string(items[i]->id()) +
+                                   " differs in type or shape from the other ones, which is not supported by CSR.");
+    present[i] = 1;
+  }
+  RETURN_IF_NOT_OK(writer->Append(present, &record->present_offset));
+
+  const uint64_t item_bytes = static_cast<uint64_t>(default_value->SizeInBytes());
+  const std::vector<uint8_t> zeros(item_bytes, 0);
+  RETURN_IF_NOT_OK(writer->Append(nullptr, 0, &record->data_offset));
+  for (size_t i = 0; i < items.size(); ++i) {
+    const uint8_t *data = values[i] != nullptr ? values[i]->GetBuffer() : zeros.data();
+    RETURN_UNEXPECTED_IF_NULL(data);
+    RETURN_IF_NOT_OK(writer->AppendPacked(data, item_bytes));
+  }
+  return Status::OK();
+}
+
+// Binary search in a sorted array of ids, -1 if the id is not found
+template <typename T>
+int64_t FindId(const T *ids, int64_t num, T id) {
+  const T *itr = std::lower_bound(ids, ids + num, id);
+  return (itr != ids + num && *itr == id) ? static_cast<int64_t>(itr - ids) : -1;
+}
+}  // namespace
+
+GraphCsrStore::~GraphCsrStore() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_ && data_ != nullptr) {
+    if (munmap(const_cast<uint8_t *>(data_), static_cast<size_t>(size_)) != 0) {
+      MS_LOG(WARNING) << "Failed to unmap graph CSR store, errno: " << errno;
+    }
+  }
+#endif
+}
+
+Status GraphCsrStore::Write(const std::string &path, const std::string &source,
+                            const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+                            const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+                            const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_node_features,
+                            const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_edge_features) {
+  CHECK_FAIL_RETURN_UNEXPECTED(nodes.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()) &&
+                                 edges.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "Too many nodes or edges for the graph CSR store.");
+  CsrHeader header{};
+  (void)std::copy(std::begin(kCsrMagic), std::end(kCsrMagic), header.magic);
+  header.version = kCsrVersion;
+  header.num_nodes = static_cast<int64_t>(nodes.size());
+  header.num_edges = static_cast<int64_t>(edges.size());
+  RETURN_IF_NOT_OK(GetSourceStat(source, &header.source_size, &header.source_mtime));
+
+  // Nodes sorted by id
+  std::vector<NodeIdType> node_ids;
+  node_ids.reserve(nodes.size());
+  for (const auto &node : nodes) {
+    node_ids.push_back(node.first);
+  }
+  std::sort(node_ids.begin(), node_ids.end());
+  std::vector<std::shared_ptr<Node>> node_objs(node_ids.size());
+  std::vector<NodeType> node_types(node_ids.size());
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    node_objs[i] = nodes.at(node_ids[i]);
+    node_types[i] = node_objs[i]->type();
+  }
+  auto node_index = [&node_ids](NodeIdType id) { return FindId(node_ids.data(), node_ids.size(), id); };
+
+  // Edges sorted by id
+  std::vector<EdgeIdType> edge_ids;
+  edge_ids.reserve(edges.size());
+  for (const auto &edge : edges) {
+    edge_ids.push_back(edge.first);
+  }
+  std::sort(edge_ids.begin(), edge_ids.end());
+  std::vector<std::shared_ptr<Edge>> edge_objs(edge_ids.size());
+  std::vector<EdgeType> edge_types(edge_ids.size());
+  std::vector<int32_t> edge_src(edge_ids.size());
+  std::vector<int32_t> edge_dst(edge_ids.size());
+  std::vector<int64_t> row_offsets(node_ids.size() + 1, 0);
+  for (size_t i = 0; i < edge_ids.size(); ++i) {
+    edge_objs[i] = edges.at(edge_ids[i]);
+    edge_types[i] = edge_objs[i]->type();
+    NodeIdType src_id = 0;
+    NodeIdType dst_id = 0;
+    RETURN_IF_NOT_OK(edge_objs[i]->GetNode(&src_id, &dst_id));
+    int64_t src = node_index(src_id);
+    int64_t dst = node_index(dst_id);
+    CHECK_FAIL_RETURN_UNEXPECTED(src >= 0 && dst >= 0,
+                                 "Invalid data, node of edge " + std::to_string(edge_ids[i]) + " does not exist.");
+    edge_src[i] = static_cast<int32_t>(src);
+    edge_dst[i] = static_cast<int32_t>(dst);
+    row_offsets[src + 1]++;
+  }
+
+  // Edges out of each node, in the order of their ids and then by the type of the neighbor
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    row_offsets[i + 1] += row_offsets[i];
+  }
+  std::vector<int32_t> neighbor_edges(edge_ids.size());
+  std::vector<int64_t> fill(row_offsets.begin(), row_offsets.end() - 1);
+  for (size_t i = 0; i < edge_ids.size(); ++i) {
+    neighbor_edges[fill[edge_src[i]]++] = static_cast<int32_t>(i);
+  }
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    std::stable_sort(neighbor_edges.begin() + row_offsets[i], neighbor_edges.begin() + row_offsets[i + 1],
+                     [&](int32_t a, int32_t b) { return node_types[edge_dst[a]] < node_types[edge_dst[b]]; });
+  }
+  std::vector<int32_t> neighbor_nodes(edge_ids.size());
+  std::vector<WeightType> neighbor_weights(edge_ids.size());
+  for (size_t pos = 0; pos < neighbor_edges.size(); ++pos) {
+    neighbor_nodes[pos] = edge_dst[neighbor_edges[pos]];
+    neighbor_weights[pos] = edge_objs[neighbor_edges[pos]]->weight();
+  }
+
+  // Write to a temporary file renamed at the end, so a reader never sees a partial store
+  const std::string tmp_path = path + ".tmp" + std::to_string(GetRandomDevice()());
+  CsrFileWriter writer(tmp_path);
+  RETURN_IF_NOT_OK(writer.Append(&header, sizeof(header)));
+  RETURN_IF_NOT_OK(writer.Append(node_ids, &header.sections[kNodeIds]));
+  RETURN_IF_NOT_OK(writer.Append(node_types, &header.sections[kNodeTypes]));
+  RETURN_IF_NOT_OK(writer.Append(row_offsets, &header.sections[kRowOffsets]));
+  RETURN_IF_NOT_OK(writer.Append(neighbor_nodes, &header.sections[kNeighborNodes]));
+  RETURN_IF_NOT_OK(writer.Append(neighbor_edges, &header.sections[kNeighborEdges]));
+  RETURN_IF_NOT_OK(writer.Append(neighbor_weights, &header.sections[kNeighborWeights]));
+  RETURN_IF_NOT_OK(writer.Append(edge_ids, &header.sections[kEdgeIds]));
+  RETURN_IF_NOT_OK(writer.Append(edge_types, &header.sections[kEdgeTypes]));
+  RETURN_IF_NOT_OK(writer.Append(edge_src, &header.sections[kEdgeSrc]));
+  RETURN_IF_NOT_OK(writer.Append(edge_dst, &header.sections[kEdgeDst]));
+
+  std::vector<CsrFeatureRecord> records;
+  std::map<FeatureType, std::shared_ptr<Feature>> sorted_node_features(default_node_features.begin(),
+                                                                        default_node_features.end());
+  for (const auto &feature : sorted_node_features) {
+    CsrFeatureRecord record{};
+    RETURN_IF_NOT_OK(WriteFeature(node_objs, feature.second, false, &writer, &record));
+    records.push_back(record);
+  }
+  std::map<FeatureType, std::shared_ptr<Feature>> sorted_edge_features(default_edge_features.begin(),
+                                                                        default_edge_features.end());
+  for (const auto &feature : sorted_edge_features) {
+    CsrFeatureRecord record{};
+    RETURN_IF_NOT_OK(WriteFeature(edge_objs, feature.second, true, &writer, &record));
+    records.push_back(record);
+  }
+  header.num_features = static_cast<uint32_t>(records.size());
+  RETURN_IF_NOT_OK(writer.Append(records, &header.sections[kFeatureTable]));
+  RETURN_IF_NOT_OK(writer.WriteHeader(header));
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to write graph CSR store: " + path + ", errno: " + std::to_string(errno));
+  }
+  MS_LOG(INFO) << "Graph CSR store of " << nodes.size() << " nodes and " << edges.size() << " edges written to "
+               << path;
+  return Status::OK();
+}
+
+Status GraphCsrStore::Load(const std::string &path, const std::string &source, std::unique_ptr<GraphCsrStore> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto realpath = FileUtils::GetRealPath(path.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Invalid file, failed to get the realpath of: " + path);
+  auto store = std::make_unique<GraphCsrStore>();
+#if defined(_WIN32) || defined(_WIN64)
+  std::ifstream in(realpath.value(), std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Invalid file, failed to open graph CSR store: " + path);
+  store->buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  store->data_ = store->buffer_.data();
+  store->size_ = store->buffer_.size();
+#else
+  int fd = open(realpath.value().c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, failed to open graph CSR store: " + path);
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to get the size of graph CSR store: " + path);
+  }
+  // Shared read-only pages, which all the processes mapping the store use without a copy
+  void *addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED,
+                               "Failed to map graph CSR store: " + path + ", errno: " + std::to_string(errno));
+  store->data_ = static_cast<const uint8_t *>(addr);
+  store->size_ = static_cast<uint64_t>(file_stat.st_size);
+  store->mapped_ = true;
+#endif
+  RETURN_IF_NOT_OK(store->Parse(source));
+  MS_LOG(INFO) << "Graph CSR store of " << store->num_nodes_ << " nodes and " << store->num_edges_
+               << " edges loaded from " << path;
+  *out = std::move(store);
+  return Status::OK();
+}
+
+Status GraphCsrStore::Parse(const std::string &source) {
+  CHECK_FAIL_RETURN_UNEXPECTED(size_ >= sizeof(CsrHeader), "Invalid graph CSR store, the file is truncated.");
+  CsrHeader header{};
+  (void)std::memcpy(&header, data_, sizeof(header));
+  CHECK_FAIL_RETURN_UNEXPECTED(std::equal(std::begin(kCsrMagic), std::end(kCsrMagic), header.magic) &&
+                                 header.version == kCsrVersion,
+                               "Invalid graph CSR store, unknown format or version.");
+  int64_t source_size = 0;
+  int64_t source_mtime = 0;
+  RETURN_IF_NOT_OK(GetSourceStat(source, &source_size, &source_mtime));
+  CHECK_FAIL_RETURN_UNEXPECTED(source_size == header.source_size && source_mtime == header.source_mtime,
+                               "Graph CSR store is stale, graph file has changed since: " + source);
+  CHECK_FAIL_RETURN_UNEXPECTED(header.num_nodes >= 0 && header.num_edges >= 0,
+                               "Invalid graph CSR store, the number of nodes or edges is negative.");
+  num_nodes_ = header.num_nodes;
+  num_edges_ = header.num_edges;
+  const uint64_t num_nodes = static_cast<uint64_t>(num_nodes_);
+  const uint64_t num_edges = static_cast<uint64_t>(num_edges_);
+
+  // Check that an array lies in the file at an offset aligned for its elements
+  auto section = [this](uint64_t offset, uint64_t len, const uint8_t **ptr) -> Status {
+    CHECK_FAIL_RETURN_UNEXPECTED(offset % kCsrAlignment == 0 && offset <= size_ && len <= size_ - offset,
+                                 "Invalid graph CSR store, the file is truncated or corrupted.");
+    *ptr = data_ + offset;
+    return Status::OK();
+  };
+  const uint8_t *ptr = nullptr;
+  RETURN_IF_NOT_OK(section(header.sections[kNodeIds], num_nodes * sizeof(NodeIdType), &ptr));
+  node_ids_ = reinterpret_cast<const NodeIdType *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kNodeTypes], num_nodes * sizeof(NodeType), &ptr));
+  node_types_ = reinterpret_cast<const NodeType *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kRowOffsets], (num_nodes + 1) * sizeof(int64_t), &ptr));
+  row_offsets_ = reinterpret_cast<const int64_t *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kNeighborNodes], num_edges * sizeof(int32_t), &ptr));
+  neighbor_nodes_ = reinterpret_cast<const int32_t *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kNeighborEdges], num_edges * sizeof(int32_t), &ptr));
+  neighbor_edges_ = reinterpret_cast<const int32_t *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kNeighborWeights], num_edges * sizeof(WeightType), &ptr));
+  neighbor_weights_ = reinterpret_cast<const WeightType *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kEdgeIds], num_edges * sizeof(EdgeIdType), &ptr));
+  edge_ids_ = reinterpret_cast<const EdgeIdType *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kEdgeTypes], num_edges * sizeof(EdgeType), &ptr));
+  edge_types_ = reinterpret_cast<const EdgeType *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kEdgeSrc], num_edges * sizeof(int32_t), &ptr));
+  edge_src_ = reinterpret_cast<const int32_t *>(ptr);
+  RETURN_IF_NOT_OK(section(header.sections[kEdgeDst], num_edges * sizeof(int32_t), &ptr));
+  edge_dst_ = reinterpret_cast<const int32_t *>(ptr);
+  CHECK_FAIL_RETURN_UNEXPECTED(row_offsets_[0] == 0 && row_offsets_[num_nodes_] == num_edges_,
+                               "Invalid graph CSR store, the neighbor arrays are corrupted.");
+
+  // Ids are sorted and unique, so they are dense if the first and the last ones are
+  dense_node_ids_ = num_nodes_ > 0 && node_ids_[0] == 0 && node_ids_[num_nodes_ - 1] == num_nodes_ - 1;
+
+  RETURN_IF_NOT_OK(section(header.sections[kFeatureTable], header.num_features * sizeof(CsrFeatureRecord), &ptr));
+  for (uint32_t i = 0; i < header.num_features; ++i) {
+    CsrFeatureRecord record{};
+    (void)std::memcpy(&record, ptr + i * sizeof(CsrFeatureRecord), sizeof(record));
+    CHECK_FAIL_RETURN_UNEXPECTED(record.rank <= kMaxFeatureRank && record.data_type < DataType::NUM_OF_TYPES,
+                                 "Invalid graph CSR store, the feature table is corrupted.");
+    FeatureInfo feature;
+    feature.type = record.type;
+    feature.data_type = DataType(static_cast<DataType::Type>(record.data_type));
+    feature.shape = TensorShape(std::vector<dsize_t>(record.dims, record.dims + record.rank));
+    feature.item_bytes = feature.shape.NumOfElements() * feature.data_type.SizeInBytes();
+    const uint64_t num_items = record.is_edge != 0 ? num_edges : num_nodes;
+    RETURN_IF_NOT_OK(section(record.present_offset, num_items, &feature.present));
+    // The items are packed, so only the first one is aligned, the features are copied out byte by byte
+    CHECK_FAIL_RETURN_UNEXPECTED(record.data_offset <= size_ && feature.item_bytes >= 0 &&
+                                   num_items * static_cast<uint64_t>(feature.item_bytes) <= size_ - record.data_offset,
+                                 "Invalid graph CSR store, the file is truncated or corrupted.");
+    feature.data = data_ + record.data_offset;
+    (record.is_edge != 0 ? edge_features_ : node_features_).push_back(feature);
+  }
+
+  for (int64_t i = 0; i < num_edges_; ++i) {
+    edge_type_counts_[edge_types_[i]]++;
+  }
+  return Status::OK();
+}
+
+Status GraphCsrStore::GetStorePath(const std::string &store_dir, const std::string &source, std::string *path) {
+  RETURN_UNEXPECTED_IF_NULL(path);
+  auto realpath = FileUtils::GetRealPath(source.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Invalid file, failed to get the realpath of: " + source);
+  Path dir(store_dir);
+  if (!dir.Exists()) {
+    RETURN_IF_NOT_OK(dir.CreateDirectories());
+  }
+  // The name of the graph file and a hash of its full path, so graphs of the same name do not collide
+  std::stringstream name;
+  name << Path(realpath.value()).Basename() << "_" << std::hex << std::hash<std::string>{}(realpath.value())
+       << ".csr";
+  *path = (dir / name.str()).ToString();
+  return Status::OK();
+}
+
+int64_t GraphCsrStore::FindNode(NodeIdType id) const {
+  if (dense_node_ids_) {
+    return (id >= 0 && id < num_nodes_) ? id : -1;
+  }
+  return FindId(node_ids_, num_nodes_, id);
+}
+
+int64_t GraphCsrStore::FindEdge(EdgeIdType id) const { return FindId(edge_ids_, num_edges_, id); }
+
+void GraphCsrStore::GetNeighborRange(int64_t node, int64_t *begin, int64_t *end) const {
+  *begin = row_offsets_[node];
+  *end = row_offsets_[node + 1];
+}
+
+void GraphCsrStore::GetNeighborRange(int64_t node, NodeType neighbor_type, int64_t *begin, int64_t *end) const {
+  // The neighbors of a node are sorted by type
+  int64_t lo = row_offsets_[node];
+  int64_t hi = row_offsets_[node + 1];
+  auto type_of = [this](int64_t pos) { return node_types_[neighbor_nodes_[pos]]; };
+  int64_t first = lo;
+  int64_t count = hi - lo;
+  while (count > 0) {
+    int64_t step = count / 2;
+    if (type_of(first + step) < neighbor_type) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  int64_t last = first;
+  while (last < hi && type_of(last) == neighbor_type) {
+    ++last;
+  }
+  *begin = first;
+  *end = last;
+}
+
+const GraphCsrStore::FeatureInfo *GraphCsrStore::FindNodeFeature(FeatureType type) const {
+  auto itr = std::find_if(node_features_.begin(), node_features_.end(),
+                          [type](const FeatureInfo &feature) { return feature.type == type; });
+  return itr != node_features_.end() ? &(*itr) : nullptr;
+}
+
+const GraphCsrStore::FeatureInfo *GraphCsrStore::FindEdgeFeature(FeatureType type) const {
+  auto itr = std::find_if(edge_features_.begin(), edge_features_.end(),
+                          [type](const FeatureInfo &feature) { return feature.type == type; });
+  return itr != edge_features_.end() ? &(*itr) : nullptr;
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_STORE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_STORE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// The nodes, edges and features of a graph in compressed sparse row (CSR) arrays of plain types. All the arrays are
+// kept in a single file written by GraphLoader and mapped into memory, so loading a graph needs no parsing and the
+// pages are shared by the processes reading the same graph. Nodes and edges are addressed by their index in the
+// arrays, which are sorted by id. The neighbors of a node are sorted by their type and then by the id of the edge, so
+// the neighbors of a type are a contiguous range of the neighbor arrays.
+class GraphCsrStore {
+ public:
+  // A feature of all the nodes or all the edges, of a fixed type and shape
+  struct FeatureInfo {
+    FeatureType type;
+    DataType data_type;
+    TensorShape shape = TensorShape::CreateScalar();
+    int64_t item_bytes = 0;           // Number of bytes of the feature of a node or an edge
+    const uint8_t *present = nullptr;  // Whether each node or edge has the feature
+    const uint8_t *data = nullptr;     // item_bytes bytes for each node or edge, zero if it does not have the feature
+  };
+
+  GraphCsrStore() = default;
+
+  ~GraphCsrStore();
+
+  GraphCsrStore(const GraphCsrStore &) = delete;
+
+  GraphCsrStore &operator=(const GraphCsrStore &) = delete;
+
+  // Write a graph loaded as node and edge objects to a file
+  // @param std::string path - The file to write
+  // @param std::string source - The file the graph is loaded from, recorded to detect a stale store
+  // @param nodes - All the nodes of the graph
+  // @param edges - All the edges of the graph, whose nodes are in nodes
+  // @param default_node_features - The default feature of each type of node feature, which gives its shape and type
+  // @param default_edge_features - The default feature of each type of edge feature, which gives its shape and type
+  // @return Status The status code returned, an error if a feature does not fit in the arrays, e.g. is a string
+  static Status Write(const std::string &path, const std::string &source,
+                      const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+                      const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+                      const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_node_features,
+                      const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_edge_features);
+
+  // Map a file written by Write into memory
+  // @param std::string path - The file to map
+  // @param std::string source - The file the graph is loaded from, the store is rejected if it changed since
+  // @param std::unique_ptr<GraphCsrStore> *out - Returned store
+  // @return Status The status code returned
+  static Status Load(const std::string &path, const std::string &source, std::unique_ptr<GraphCsrStore> *out);
+
+  // The file the store of a graph is kept in, under the store directory and named after the path of the graph
+  // @param std::string store_dir - The directory of the stores
+  // @param std::string source - The file the graph is loaded from
+  // @param std::string *path - Returned path of the store
+  // @return Status The status code returned
+  static Status GetStorePath(const std::string &store_dir, const std::string &source, std::string *path);
+
+  int64_t NumNodes() const { return num_nodes_; }
+
+  int64_t NumEdges() const { return num_edges_; }
+
+  // @return int64_t - The index of the node of the id, -1 if there is no such node
+  int64_t FindNode(NodeIdType id) const;
+
+  // @return int64_t - The index of the edge of the id, -1 if there is no such edge
+  int64_t FindEdge(EdgeIdType id) const;
+
+  NodeIdType GetNodeId(int64_t node) const { return node_ids_[node]; }
+
+  NodeType GetNodeType(int64_t node) const { return node_types_[node]; }
+
+  EdgeIdType GetEdgeId(int64_t edge) const { return edge_ids_[edge]; }
+
+  EdgeType GetEdgeType(int64_t edge) const { return edge_types_[edge]; }
+
+  // @return int64_t - The index of the source node of the edge
+  int64_t GetEdgeSrc(int64_t edge) const { return edge_src_[edge]; }
+
+  // @return int64_t - The index of the destination node of the edge
+  int64_t GetEdgeDst(int64_t edge) const { return edge_dst_[edge]; }
+
+  // Get the neighbors of a node, as a range of the neighbor arrays
+  // @param int64_t node - Index of the node
+  // @param int64_t *begin - Returned start of the range
+  // @param int64_t *end - Returned end of the range
+  void GetNeighborRange(int64_t node, int64_t *begin, int64_t *end) const;
+
+  // Get the neighbors of a type of a node, as a range of the neighbor arrays
+  // @param int64_t node - Index of the node
+  // @param NodeType neighbor_type - Type of the neighbors
+  // @param int64_t *begin - Returned start of the range
+  // @param int64_t *end - Returned end of the range
+  void GetNeighborRange(int64_t node, NodeType neighbor_type, int64_t *begin, int64_t *end) const;
+
+  // @return int64_t - The index of the node of a position in the neighbor arrays
+  int64_t GetNeighborNode(int64_t pos) const { return neighbor_nodes_[pos]; }
+
+  // @return int64_t - The index of the edge to the node of a position in the neighbor arrays
+  int64_t GetNeighborEdge(int64_t pos) const { return neighbor_edges_[pos]; }
+
+  // @return const WeightType * - The weights of the edges to the neighbors, in the order of the neighbor arrays
+  const WeightType *GetNeighborWeights() const { return neighbor_weights_; }
+
+  // @return const FeatureInfo * - The node feature of the type, nullptr if there is no such feature
+  const FeatureInfo *FindNodeFeature(FeatureType type) const;
+
+  // @return const FeatureInfo * - The edge feature of the type, nullptr if there is no such feature
+  const FeatureInfo *FindEdgeFeature(FeatureType type) const;
+
+  const std::vector<FeatureInfo> &GetNodeFeatures() const { return node_features_; }
+
+  const std::vector<FeatureInfo> &GetEdgeFeatures() const { return edge_features_; }
+
+  // @return const uint8_t * - The feature of a node or an edge, nullptr if it does not have the feature
+  static const uint8_t *GetFeature(const FeatureInfo &feature, int64_t index) {
+    return feature.present[index] != 0 ? feature.data + index * feature.item_bytes : nullptr;
+  }
+
+  // @return std::map<EdgeType, int64_t> - The number of edges of each type
+  const std::map<EdgeType, int64_t> &GetEdgeTypeCounts() const { return edge_type_counts_; }
+
+ private:
+  // Check the layout of the mapped file and set the arrays to point into it
+  Status Parse(const std::string &source);
+
+  const uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<uint8_t> buffer_;  // The content of the file where it can not be mapped
+
+  int64_t num_nodes_ = 0;
+  int64_t num_edges_ = 0;
+  bool dense_node_ids_ = false;  // Whether the id of each node is its index
+  const NodeIdType *node_ids_ = nullptr;
+  const NodeType *node_types_ = nullptr;
+  const int64_t *row_offsets_ = nullptr;  // Start of the neighbors of each node, num_nodes_ + 1 of them
+  const int32_t *neighbor_nodes_ = nullptr;
+  const int32_t *neighbor_edges_ = nullptr;
+  const WeightType *neighbor_weights_ = nullptr;
+  const EdgeIdType *edge_ids_ = nullptr;
+  const EdgeType *edge_types_ = nullptr;
+  const int32_t *edge_src_ = nullptr;
+  const int32_t *edge_dst_ = nullptr;
+  std::vector<FeatureInfo> node_features_;
+  std::vector<FeatureInfo> edge_features_;
+  std::map<EdgeType, int64_t> edge_type_counts_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_STORE_H_
@@ -18,13 +18,17 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/engine/gnn/graph_loader_array.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
@@ -102,6 +106,20 @@ Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t
 
 Status GraphDataImpl::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
+  if (csr_store_ != nullptr) {
+    auto count = csr_store_->GetEdgeTypeCounts().find(edge_type);
+    CHECK_FAIL_RETURN_UNEXPECTED(count != csr_store_->GetEdgeTypeCounts().end(),
+                                 "Invalid edge type:" + std::to_string(edge_type));
+    // The edges of the store are sorted by id, unlike the edge objects which keep the order they are loaded in
+    std::vector<EdgeIdType> edges;
+    edges.reserve(count->second);
+    for (int64_t i = 0; i < csr_store_->NumEdges(); ++i) {
+      if (csr_store_->GetEdgeType(i) == edge_type) {
+        edges.push_back(csr_store_->GetEdgeId(i));
+      }
+    }
+    return CreateTensorByVector<EdgeIdType>({edges}, DataType(DataType::DE_INT32), out);
+  }
   auto itr = edge_type_map_.find(edge_type);
   if (itr == edge_type_map_.end()) {
     std::string err_msg = "Invalid edge type:" + std::to_string(edge_type);
@@ -121,6 +139,13 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
+    if (csr_store_ != nullptr) {
+      int64_t edge = csr_store_->FindEdge(edge_id);
+      CHECK_FAIL_RETURN_UNEXPECTED(edge >= 0, "Invalid edge id:" + std::to_string(edge_id));
+      node_list.push_back({csr_store_->GetNodeId(csr_store_->GetEdgeSrc(edge)),
+                           csr_store_->GetNodeId(csr_store_->GetEdgeDst(edge))});
+      continue;
+    }
     auto itr = edge_id_map_.find(edge_id);
     if (itr == edge_id_map_.end()) {
       std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
@@ -147,11 +172,8 @@ Status GraphDataImpl::GetEdgesFromNodes(const std::vector<std::pair<NodeIdType,
   edge_list.reserve(node_list.size());
 
   for (const auto &node_id : node_list) {
-    std::shared_ptr<Node> src_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
-
     EdgeIdType edge_id;
-    src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    RETURN_IF_NOT_OK(GetEdgeByNodes(node_id.first, node_id.second, &edge_id));
 
     std::vector<EdgeIdType> connection_edge = {edge_id};
     (void)edge_list.emplace_back(std::move(connection_edge));
@@ -176,16 +198,14 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   // Collect information of adjacent table
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
     if (format == OutputFormat::kNormal) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i]));
       max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
     } else if (format == OutputFormat::kCoo) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
     } else {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
       if (i < node_list.size() - 1) {
         offset_table[i + 1] = total_edge_num;
@@ -262,54 +282,94 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
   RETURN_UNEXPECTED_IF_NULL(out);
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    (void)neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            (void)neighbors.emplace_back(kDefaultNodeId);
+  // The row of a node holds the node, then the neighbors of each hop sampled from those of the hop before
+  int64_t row_size = 1;
+  int64_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    CHECK_FAIL_RETURN_UNEXPECTED(hop_size <= std::numeric_limits<int32_t>::max() / num,
+                                 "The number of sampled neighbors is too large.");
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  auto *data = reinterpret_cast<NodeIdType *>(tensor->GetMutableBuffer());
+  RETURN_UNEXPECTED_IF_NULL(data);
+  const uint64_t key = NewRandomKey();
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t begin, size_t end) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      RETURN_IF_NOT_OK(CheckNodeId(node_list[node_idx]));
+      CounterBasedRandom rnd(key, node_idx);
+      NodeIdType *row = data + node_idx * row_size;
+      row[0] = node_list[node_idx];
+      int64_t input_begin = 0;
+      int64_t input_end = 1;
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        NodeIdType *neighbors = row + input_end;
+        for (int64_t j = input_begin; j < input_end; ++j, neighbors += neighbor_nums[i]) {
+          if (row[j] == kDefaultNodeId) {
+            std::fill(neighbors, neighbors + neighbor_nums[i], kDefaultNodeId);
+          } else {
+            RETURN_IF_NOT_OK(SampleNeighbors(row[j], neighbor_types[i], neighbor_nums[i], strategy, &rnd, neighbors));
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &out, &rnd_));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
         }
+        int64_t num_neighbors = (input_end - input_begin) * neighbor_nums[i];
+        input_begin = input_end;
+        input_end += num_neighbors;
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                                     size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
-                                     int32_t samples_num, std::vector<NodeIdType> *out_samples) {
-  CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  RETURN_UNEXPECTED_IF_NULL(start_index);
+Status GraphDataImpl::NegativeSample(NodeIdType id, const std::vector<NodeIdType> &all_nodes,
+                                     NodeType neg_neighbor_type, int32_t samples_num, CounterBasedRandom *rnd,
+                                     NodeIdType *out_samples) {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
   RETURN_UNEXPECTED_IF_NULL(out_samples);
-  size_t index = *start_index;
-  for (size_t i = index; i < shuffled_ids.size(); ++i) {
-    ++index;
-    if (exclude_data.find(data[shuffled_ids[i]]) != exclude_data.end()) {
-      continue;
-    }
-    (void)out_samples->emplace_back(data[shuffled_ids[i]]);
-    if (out_samples->size() >= samples_num) {
-      break;
+  std::vector<NodeIdType> neighbors;
+  RETURN_IF_NOT_OK(GetNeighbors(id, neg_neighbor_type, &neighbors));
+  std::unordered_set<NodeIdType> exclude_nodes(neighbors.begin(), neighbors.end());
+  NodeType node_type;
+  RETURN_IF_NOT_OK(GetNodeType(id, &node_type));
+  // The node itself is among all_nodes only if it is of the type
+  size_t num_excluded = exclude_nodes.size() - (node_type == neg_neighbor_type ? 0 : 1);
+  size_t num_candidates = all_nodes.size() > num_excluded ? all_nodes.size() - num_excluded : 0;
+  if (num_candidates == 0) {
+    MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << id << " neg_neighbor_type:" << neg_neighbor_type;
+    // If there are no negative neighbors, they are filled with kDefaultNodeId
+    std::fill(out_samples, out_samples + samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  if ((num_excluded + static_cast<size_t>(samples_num)) * 2 > all_nodes.size()) {
+    // Most draws from all_nodes would be rejected, so draw from a list of the candidates by a partial shuffle
+    std::vector<NodeIdType> candidates;
+    candidates.reserve(num_candidates);
+    std::copy_if(all_nodes.begin(), all_nodes.end(), std::back_inserter(candidates),
+                 [&exclude_nodes](NodeIdType node) { return exclude_nodes.find(node) == exclude_nodes.end(); });
+    for (int32_t i = 0; i < samples_num; ++i) {
+      size_t pos = i % candidates.size();
+      std::uniform_int_distribution<size_t> distribution(pos, candidates.size() - 1);
+      std::swap(candidates[pos], candidates[distribution(*rnd)]);
+      out_samples[i] = candidates[pos];
     }
+    return Status::OK();
+  }
+  // Otherwise draw from all_nodes, rejecting the excluded nodes and those already drawn
+  std::uniform_int_distribution<size_t> distribution(0, all_nodes.size() - 1);
+  std::unordered_set<NodeIdType> drawn_nodes;
+  for (int32_t i = 0; i < samples_num; ++i) {
+    NodeIdType node;
+    do {
+      node = all_nodes[distribution(*rnd)];
+    } while (exclude_nodes.find(node) != exclude_nodes.end() || drawn_nodes.find(node) != drawn_nodes.end());
+    (void)drawn_nodes.insert(node);
+    out_samples[i] = node;
   }
-  *start_index = index;
   return Status::OK();
 }
 
@@ -321,48 +381,24 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_UNEXPECTED_IF_NULL(out);
 
   const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-  std::vector<NodeIdType> shuffled_id(all_nodes.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  size_t start_index = 0;
-  bool need_shuffle = false;
-
-  std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
-  neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    (void)std::transform(neighbors.begin(), neighbors.end(),
-                         std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                         [](const NodeIdType node) { return node; });
-    (void)neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
-                                        &neg_neighbors_vec[node_idx]));
-        if (start_index >= shuffled_id.size()) {
-          start_index = start_index % shuffled_id.size();
-          need_shuffle = true;
-        }
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        (void)neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
-      }
-    }
-    if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-      start_index = 0;
-      need_shuffle = false;
+  const int64_t row_size = static_cast<int64_t>(samples_num) + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  auto *data = reinterpret_cast<NodeIdType *>(tensor->GetMutableBuffer());
+  RETURN_UNEXPECTED_IF_NULL(data);
+  const uint64_t key = NewRandomKey();
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t begin, size_t end) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      CounterBasedRandom rnd(key, node_idx);
+      NodeIdType *row = data + node_idx * row_size;
+      row[0] = node_list[node_idx];
+      RETURN_IF_NOT_OK(NegativeSample(node_list[node_idx], all_nodes, neg_neighbor_type, samples_num, &rnd, row + 1));
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
@@ -371,9 +407,7 @@ Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const
                                  std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
-  std::vector<std::vector<NodeIdType>> walks;
-  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
+  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(NewRandomKey(), out));
   return Status::OK();
 }
 
@@ -423,6 +457,12 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
 
     dsize_t index = 0;
     for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+      if (csr_store_ != nullptr) {
+        RETURN_IF_NOT_OK(InsertCsrFeature(csr_store_->FindNodeFeature(f_type), csr_store_->FindNode(*node_itr),
+                                          default_feature->Value(), index, fea_tensor));
+        index++;
+        continue;
+      }
       std::shared_ptr<Feature> feature;
       if (*node_itr == kDefaultNodeId) {
         feature = default_feature;
@@ -513,6 +553,12 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
 
     dsize_t index = 0;
     for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+      if (csr_store_ != nullptr) {
+        RETURN_IF_NOT_OK(InsertCsrFeature(csr_store_->FindEdgeFeature(f_type), csr_store_->FindEdge(*edge_itr),
+                                          default_feature->Value(), index, fea_tensor));
+        index++;
+        continue;
+      }
       std::shared_ptr<Edge> edge;
       std::shared_ptr<Feature> feature;
 
@@ -591,6 +637,11 @@ Status GraphDataImpl::Init() {
   if (data_format_ != "mindrecord") {
     RETURN_STATUS_UNEXPECTED("Data Format should be `mindrecord` as dataset file is provided.");
   }
+  // The features of the server are kept in shared memory for the clients, which the CSR store does not do
+  std::string store_dir = GlobalContext::config_manager()->graph_csr_store_dir();
+  if (!store_dir.empty() && !server_mode_) {
+    return InitCsrStore(store_dir);
+  }
   GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
 
   // ask graph_loader to load everything into memory
@@ -613,6 +664,65 @@ Status GraphDataImpl::Init(int32_t num_nodes, const std::shared_ptr<Tensor> &edg
   return Status::OK();
 }
 
+Status GraphDataImpl::InitCsrStore(const std::string &store_dir) {
+  std::string store_path;
+  RETURN_IF_NOT_OK(GraphCsrStore::GetStorePath(store_dir, dataset_file_, &store_path));
+  Status rc = GraphCsrStore::Load(store_path, dataset_file_, &csr_store_);
+  if (rc.IsError()) {
+    MS_LOG(INFO) << "Build the CSR store of the graph: " << store_path << ", as it can not be loaded: " << rc;
+    GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
+    RETURN_IF_NOT_OK(gl.InitAndLoad());
+    RETURN_IF_NOT_OK(gl.GetNodesAndEdges());
+    rc = gl.WriteCsrStore(store_path);
+    if (rc.IsOk()) {
+      rc = GraphCsrStore::Load(store_path, dataset_file_, &csr_store_);
+    }
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "The graph is kept as node and edge objects, as it can not be stored in CSR arrays: " << rc;
+      csr_store_.reset();
+      return Status::OK();
+    }
+  }
+
+  // The arrays replace the node and edge objects
+  node_id_map_.clear();
+  edge_id_map_.clear();
+  node_type_map_.clear();
+  edge_type_map_.clear();
+  node_feature_map_.clear();
+  edge_feature_map_.clear();
+  default_node_feature_map_.clear();
+  default_edge_feature_map_.clear();
+  // The nodes of the store are sorted by id, so GetAllNodes returns them in that order
+  for (int64_t i = 0; i < csr_store_->NumNodes(); ++i) {
+    node_type_map_[csr_store_->GetNodeType(i)].push_back(csr_store_->GetNodeId(i));
+  }
+  auto load_features = [](const std::vector<GraphCsrStore::FeatureInfo> &features, int64_t num_items,
+                          const std::function<int8_t(int64_t)> &item_type,
+                          std::unordered_map<int8_t, std::unordered_set<FeatureType>> *feature_map,
+                          std::unordered_map<FeatureType, std::shared_ptr<Feature>> *default_features) -> Status {
+    for (const auto &feature : features) {
+      std::shared_ptr<Tensor> zero_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(feature.shape, feature.data_type, &zero_tensor));
+      RETURN_IF_NOT_OK(zero_tensor->Zero());
+      (*default_features)[feature.type] = std::make_shared<Feature>(feature.type, zero_tensor);
+      for (int64_t i = 0; i < num_items; ++i) {
+        if (feature.present[i] != 0) {
+          (*feature_map)[item_type(i)].insert(feature.type);
+        }
+      }
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(load_features(
+    csr_store_->GetNodeFeatures(), csr_store_->NumNodes(), [this](int64_t i) { return csr_store_->GetNodeType(i); },
+    &node_feature_map_, &default_node_feature_map_));
+  RETURN_IF_NOT_OK(load_features(
+    csr_store_->GetEdgeFeatures(), csr_store_->NumEdges(), [this](int64_t i) { return csr_store_->GetEdgeType(i); },
+    &edge_feature_map_, &default_edge_feature_map_));
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetMetaInfo(MetaInfo *meta_info) {
   RETURN_UNEXPECTED_IF_NULL(meta_info);
   meta_info->node_type.resize(node_type_map_.size());
@@ -620,9 +730,15 @@ Status GraphDataImpl::GetMetaInfo(MetaInfo *meta_info) {
                        [](auto itr) { return itr.first; });
   std::sort(meta_info->node_type.begin(), meta_info->node_type.end());
 
-  meta_info->edge_type.resize(edge_type_map_.size());
-  (void)std::transform(edge_type_map_.begin(), edge_type_map_.end(), meta_info->edge_type.begin(),
-                       [](auto itr) { return itr.first; });
+  if (csr_store_ != nullptr) {
+    for (const auto &edge : csr_store_->GetEdgeTypeCounts()) {
+      meta_info->edge_type.push_back(edge.first);
+      meta_info->edge_num[edge.first] = static_cast<EdgeIdType>(edge.second);
+    }
+  }
+  for (const auto &edge : edge_type_map_) {
+    meta_info->edge_type.push_back(edge.first);
+  }
   std::sort(meta_info->edge_type.begin(), meta_info->edge_type.end());
 
   for (const auto &node : node_type_map_) {
@@ -697,6 +813,169 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
   return Status::OK();
 }
 
+Status GraphDataImpl::CheckNodeId(NodeIdType id) {
+  if (csr_store_ != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(csr_store_->FindNode(id) >= 0, "Invalid node id:" + std::to_string(id));
+    return Status::OK();
+  }
+  std::shared_ptr<Node> node;
+  return GetNodeByNodeId(id, &node);
+}
+
+Status GraphDataImpl::GetNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                                   bool exclude_itself) {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  if (csr_store_ == nullptr) {
+    std::shared_ptr<Node> node;
+    RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+    return node->GetAllNeighbors(neighbor_type, out_neighbors, exclude_itself);
+  }
+  int64_t node = csr_store_->FindNode(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(node >= 0, "Invalid node id:" + std::to_string(id));
+  int64_t begin = 0;
+  int64_t end = 0;
+  csr_store_->GetNeighborRange(node, neighbor_type, &begin, &end);
+  std::vector<NodeIdType> neighbors;
+  neighbors.reserve(end - begin + 1);
+  if (!exclude_itself) {
+    neighbors.push_back(id);
+  }
+  for (int64_t pos = begin; pos < end; ++pos) {
+    neighbors.push_back(csr_store_->GetNodeId(csr_store_->GetNeighborNode(pos)));
+  }
+  *out_neighbors = std::move(neighbors);
+  return Status::OK();
+}
+
+Status GraphDataImpl::SampleNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num,
+                                      SamplingStrategy strategy, CounterBasedRandom *rnd, NodeIdType *out_neighbors) {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  if (csr_store_ == nullptr) {
+    std::shared_ptr<Node> node;
+    RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+    std::vector<NodeIdType> neighbors;
+    RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_type, samples_num, strategy, &neighbors, rnd));
+    CHECK_FAIL_RETURN_UNEXPECTED(neighbors.size() == static_cast<size_t>(samples_num),
+                                 "[Internal ERROR] The number of sampled neighbors is not samples_num.");
+    std::copy(neighbors.begin(), neighbors.end(), out_neighbors);
+    return Status::OK();
+  }
+  int64_t node = csr_store_->FindNode(id);
+  CHECK_FAIL_RETURN_UNEXPECTED(node >= 0, "Invalid node id:" + std::to_string(id));
+  int64_t begin = 0;
+  int64_t end = 0;
+  csr_store_->GetNeighborRange(node, neighbor_type, &begin, &end);
+  if (begin == end) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << id << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    std::fill(out_neighbors, out_neighbors + samples_num, kDefaultNodeId);
+  } else if (strategy == SamplingStrategy::kRandom) {
+    // Draw the neighbors without replacement by a partial shuffle, over again once all of them are drawn
+    std::vector<int64_t> positions(end - begin);
+    std::iota(positions.begin(), positions.end(), begin);
+    for (int32_t i = 0; i < samples_num; ++i) {
+      size_t pos = i % positions.size();
+      std::uniform_int_distribution<size_t> distribution(pos, positions.size() - 1);
+      std::swap(positions[pos], positions[distribution(*rnd)]);
+      out_neighbors[i] = csr_store_->GetNodeId(csr_store_->GetNeighborNode(positions[pos]));
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    const WeightType *weights = csr_store_->GetNeighborWeights();
+    std::discrete_distribution<int64_t> distribution(weights + begin, weights + end);
+    for (int32_t i = 0; i < samples_num; ++i) {
+      out_neighbors[i] = csr_store_->GetNodeId(csr_store_->GetNeighborNode(begin + distribution(*rnd)));
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::GetNodeType(NodeIdType id, NodeType *type) {
+  RETURN_UNEXPECTED_IF_NULL(type);
+  if (csr_store_ != nullptr) {
+    int64_t node = csr_store_->FindNode(id);
+    CHECK_FAIL_RETURN_UNEXPECTED(node >= 0, "Invalid node id:" + std::to_string(id));
+    *type = csr_store_->GetNodeType(node);
+    return Status::OK();
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  *type = node->type();
+  return Status::OK();
+}
+
+uint64_t GraphDataImpl::NewRandomKey() {
+  constexpr int kHighBits = 32;
+  uint64_t high = rnd_();
+  return (high << kHighBits) | rnd_();
+}
+
+Status GraphDataImpl::ParallelFor(size_t num_items, const std::function<Status(size_t begin, size_t end)> &func) {
+  size_t num_parts = std::min(static_cast<size_t>(std::max(num_workers_, 1)), num_items / kMinNodesPerWorker);
+  if (num_parts <= 1) {
+    return func(0, num_items);
+  }
+  TaskGroup vg;
+  size_t part_size = (num_items + num_parts - 1) / num_parts;
+  Status rc;
+  for (size_t begin = 0; begin < num_items && rc.IsOk(); begin += part_size) {
+    size_t end = std::min(begin + part_size, num_items);
+    rc = vg.CreateAsyncTask("GraphDataImpl", [&func, begin, end]() -> Status {
+      TaskManager::FindMe()->Post();
+      return func(begin, end);
+    });
+  }
+  // wait for the threads which are launched even if launching the others failed, as they run func
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  RETURN_IF_NOT_OK(rc);
+  return vg.GetTaskErrorIfAny();
+}
+
+Status GraphDataImpl::GetEdgeByNodes(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *edge_id) {
+  RETURN_UNEXPECTED_IF_NULL(edge_id);
+  if (csr_store_ == nullptr) {
+    std::shared_ptr<Node> src_node;
+    RETURN_IF_NOT_OK(GetNodeByNodeId(src_id, &src_node));
+    return src_node->GetEdgeByAdjNodeId(dst_id, edge_id);
+  }
+  int64_t src = csr_store_->FindNode(src_id);
+  CHECK_FAIL_RETURN_UNEXPECTED(src >= 0, "Invalid node id:" + std::to_string(src_id));
+  int64_t dst = csr_store_->FindNode(dst_id);
+  int64_t begin = 0;
+  int64_t end = 0;
+  csr_store_->GetNeighborRange(src, &begin, &end);
+  for (int64_t pos = begin; pos < end && dst >= 0; ++pos) {
+    if (csr_store_->GetNeighborNode(pos) == dst) {
+      *edge_id = csr_store_->GetEdgeId(csr_store_->GetNeighborEdge(pos));
+      return Status::OK();
+    }
+  }
+  *edge_id = -1;
+  MS_LOG(WARNING) << "Number " << dst_id << " node is not adjacent to number " << src_id << " node.";
+  return Status::OK();
+}
+
+Status GraphDataImpl::InsertCsrFeature(const GraphCsrStore::FeatureInfo *feature, int64_t index,
+                                       const std::shared_ptr<Tensor> &default_value, dsize_t row,
+                                       const std::shared_ptr<Tensor> &out) {
+  const uint8_t *data = (feature != nullptr && index >= 0) ? GraphCsrStore::GetFeature(*feature, index) : nullptr;
+  if (data == nullptr) {
+    return out->InsertTensor({row}, default_value);
+  }
+  // The row is filled straight from the arrays, without a tensor of the feature in between
+  const size_t item_bytes = static_cast<size_t>(feature->item_bytes);
+  const size_t offset = static_cast<size_t>(row) * item_bytes;
+  uint8_t *dst = out->GetMutableBuffer();
+  RETURN_UNEXPECTED_IF_NULL(dst);
+  CHECK_FAIL_RETURN_UNEXPECTED(offset + item_bytes <= static_cast<size_t>(out->SizeInBytes()),
+                               "[Internal ERROR] Feature is out of the bounds of the output tensor.");
+  int ret_code = memcpy_s(dst + offset, static_cast<size_t>(out->SizeInBytes()) - offset, data, item_bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret_code == EOK, "Failed to copy feature, memcpy_s errno: " + std::to_string(ret_code));
+  return Status::OK();
+}
+
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
     : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
 
@@ -741,20 +1020,22 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, CounterBasedRandom *rnd,
+                                                   NodeIdType *walk_path) {
+  RETURN_UNEXPECTED_IF_NULL(rnd);
   RETURN_UNEXPECTED_IF_NULL(walk_path);
   // Simulate a random walk starting from start node.
-  auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
+  const size_t walk_length = meta_path_.size() + 1;
+  walk_path[0] = start_node;
+  size_t walk_size = 1;
   // walk simulate
-  while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
-    auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
+  while (walk_size < walk_length) {
+    // current node
+    auto cur_node_id = walk_path[walk_size - 1];
 
     // current neighbors
     std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
+    RETURN_IF_NOT_OK(graph_->GetNeighbors(cur_node_id, meta_path_[walk_size - 1], &cur_neighbors, true));
     std::sort(cur_neighbors.begin(), cur_neighbors.end());
 
     // break if no neighbors
@@ -764,65 +1045,65 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
 
     // walk by the fist node, then by the previous 2 nodes
     std::shared_ptr<StochasticIndex> stochastic_index;
-    if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+    if (walk_size == 1) {
+      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], rnd, &stochastic_index));
     } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      NodeIdType prev_node_id = walk_path[walk_size - 2];
+      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk_size - 2, rnd, &stochastic_index));
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
+    walk_path[walk_size++] = cur_neighbors[WalkToNextNode(*stochastic_index, rnd)];
   }
 
-  while (walk.size() - 1 < meta_path_.size()) {
-    walk.push_back(default_node_);
-  }
-
-  *walk_path = std::move(walk);
+  std::fill(walk_path + walk_size, walk_path + walk_length, default_node_);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
+Status GraphDataImpl::RandomWalkBase::SimulateWalk(uint64_t key, std::shared_ptr<Tensor> *walks) {
   RETURN_UNEXPECTED_IF_NULL(walks);
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+  const size_t num_walks = static_cast<size_t>(num_walks_) * node_list_.size();
+  const int64_t walk_length = static_cast<int64_t>(meta_path_.size()) + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(num_walks), walk_length}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  auto *data = reinterpret_cast<NodeIdType *>(tensor->GetMutableBuffer());
+  RETURN_UNEXPECTED_IF_NULL(data);
+  // The walks of each round follow those of the round before, and each walk draws from its own random stream
+  RETURN_IF_NOT_OK(graph_->ParallelFor(num_walks, [&](size_t begin, size_t end) -> Status {
+    for (size_t walk_idx = begin; walk_idx < end; ++walk_idx) {
+      CounterBasedRandom rnd(key, walk_idx);
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[walk_idx % node_list_.size()], &rnd, data + walk_idx * walk_length));
     }
-  }
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *walks = std::move(tensor);
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+                                                         CounterBasedRandom *rnd,
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   RETURN_UNEXPECTED_IF_NULL(node_probability);
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
   std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(node_id, node_type, &neighbors, true));
   std::sort(neighbors.begin(), neighbors.end());
   auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
   *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
+                                                         uint32_t meta_path_index, CounterBasedRandom *rnd,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   RETURN_UNEXPECTED_IF_NULL(edge_probability);
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(src, meta_path_[meta_path_index], &src_neighbors, true));
 
-  std::shared_ptr<Node> dst_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
   std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(dst, meta_path_[meta_path_index + 1], &dst_neighbors, true));
 
   CHECK_FAIL_RETURN_UNEXPECTED(std::fabs(step_home_param_) > std::numeric_limits<float>::epsilon(),
                                "Invalid data, step home parameter can't be zero.");
@@ -846,21 +1127,21 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
   }
 
   *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
+StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability,
+                                                                   CounterBasedRandom *rnd) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
   float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
+    float threshold_one = distribution(*rnd);
     accumulate_threshold += threshold_one;
     weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
@@ -878,18 +1159,18 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index,
+                                                       CounterBasedRandom *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(0.0, 1.0);
 
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  uint32_t random_idx = std::floor(distribution(*rnd) * size_of_index);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
@@ -25,6 +26,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr_store.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,6 +39,9 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+// The least number of nodes a worker thread of the sampling and the random walk takes, below which starting the
+// thread costs more than it saves
+const size_t kMinNodesPerWorker = 64;
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -202,20 +207,24 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
-    Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
+    // Walk num_walks times from each node of node_list
+    // @param uint64_t key - The key of the random streams, each walk takes the stream of its index
+    // @param std::shared_ptr<Tensor> *walks - Returned walks, one in each row
+    // @return Status The status code returned
+    Status SimulateWalk(uint64_t key, std::shared_ptr<Tensor> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
+    Status Node2vecWalk(const NodeIdType &start_node, CounterBasedRandom *rnd, NodeIdType *walk_path);
 
     Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
+                              CounterBasedRandom *rnd, std::shared_ptr<StochasticIndex> *node_probability);
 
     Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+                              CounterBasedRandom *rnd, std::shared_ptr<StochasticIndex> *edge_probability);
 
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
+    static StochasticIndex GenerateProbability(const std::vector<float> &probability, CounterBasedRandom *rnd);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, CounterBasedRandom *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -265,21 +274,88 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node);
 
+  // Get the type of a node, from the node object or from the CSR store
+  // @param NodeIdType id -
+  // @param NodeType *type - Returned node type
+  // @return Status The status code returned
+  Status GetNodeType(NodeIdType id, NodeType *type);
+
   // Find edge object using edge id
   // @param EdgeIdType id -
   // @param std::shared_ptr<Node> *edge - Returned edge object
   // @return Status The status code returned
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
-  // Negative sampling
-  // @param std::vector<NodeIdType> &input_data - The data set to be sampled
-  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
-  // @param int32_t samples_num -
-  // @param std::vector<NodeIdType> *out_samples - Sampling results returned
+  // Check that a node exists, in the node objects or in the CSR store
+  // @param NodeIdType id -
+  // @return Status The status code returned
+  Status CheckNodeId(NodeIdType id);
+
+  // Get the neighbors of a node, from the node object or from the CSR store
+  // @param NodeIdType id - The node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id, led by the node unless exclude_itself
+  // @param bool exclude_itself - Whether to leave the node out
+  // @return Status The status code returned
+  Status GetNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                      bool exclude_itself = false);
+
+  // Sample the neighbors of a node, from the node object or from the CSR store
+  // @param NodeIdType id - The node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param SamplingStrategy strategy - Sampling strategy
+  // @param CounterBasedRandom *rnd - The random number generator to sample with
+  // @param NodeIdType *out_neighbors - Returned neighbors id, samples_num of them
+  // @return Status The status code returned
+  Status SampleNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                         CounterBasedRandom *rnd, NodeIdType *out_neighbors);
+
+  // Run a function over a range of items split into contiguous parts, each of which is run by a worker thread
+  // @param size_t num_items - Number of items
+  // @param std::function func - The function to run on the items from begin to end
+  // @return Status The status code returned, the error of a part if any
+  Status ParallelFor(size_t num_items, const std::function<Status(size_t begin, size_t end)> &func);
+
+  // Get the edge from a node to another one, -1 if they are not adjacent
+  // @param NodeIdType src_id - The source node
+  // @param NodeIdType dst_id - The destination node
+  // @param EdgeIdType *edge_id - Returned edge id
+  // @return Status The status code returned
+  Status GetEdgeByNodes(NodeIdType src_id, NodeIdType dst_id, EdgeIdType *edge_id);
+
+  // Copy the feature of a node or an edge in the CSR store into a row of a tensor, or the default value if the node
+  // or the edge does not have the feature
+  // @param GraphCsrStore::FeatureInfo *feature - The feature, nullptr if no node or edge has it
+  // @param int64_t index - Index of the node or the edge in the CSR store, -1 if it does not exist
+  // @param std::shared_ptr<Tensor> default_value - The default value of the feature
+  // @param dsize_t row - The row of the tensor to fill
+  // @param std::shared_ptr<Tensor> out - The tensor to fill
+  // @return Status The status code returned
+  Status InsertCsrFeature(const GraphCsrStore::FeatureInfo *feature, int64_t index,
+                          const std::shared_ptr<Tensor> &default_value, dsize_t row,
+                          const std::shared_ptr<Tensor> &out);
+
+  // Load the graph from its CSR store in the directory, which is written from the graph file first if needed. The
+  // graph is kept as node and edge objects if it can not be stored in CSR arrays.
+  // @param std::string store_dir - The directory of the CSR stores
   // @return Status The status code returned
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                        size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                        std::vector<NodeIdType> *out_samples);
+  Status InitCsrStore(const std::string &store_dir);
+
+  // Sample the nodes of a type which are not the neighbors of a node, nor the node itself. They are drawn without
+  // replacement until all of them are drawn, and over again after that
+  // @param NodeIdType id - The node
+  // @param std::vector<NodeIdType> &all_nodes - All the nodes of the type
+  // @param NodeType neg_neighbor_type - The type
+  // @param int32_t samples_num - Number of nodes to be acquired
+  // @param CounterBasedRandom *rnd - The random number generator to sample with
+  // @param NodeIdType *out_samples - Sampling results returned, filled with kDefaultNodeId if there are none
+  // @return Status The status code returned
+  Status NegativeSample(NodeIdType id, const std::vector<NodeIdType> &all_nodes, NodeType neg_neighbor_type,
+                        int32_t samples_num, CounterBasedRandom *rnd, NodeIdType *out_samples);
+
+  // Draw the key of the random streams of a call, from which each node of the call gets its own stream
+  uint64_t NewRandomKey();
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -307,6 +383,9 @@ class GraphDataImpl : public GraphData {
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> graph_feature_map_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_node_feature_map_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_edge_feature_map_;
+
+  // The nodes, edges and their features in CSR arrays, in place of node_id_map_ and edge_id_map_ when it is loaded
+  std::unique_ptr<GraphCsrStore> csr_store_;
 };
 }  // namespace gnn
 }  // namespace dataset
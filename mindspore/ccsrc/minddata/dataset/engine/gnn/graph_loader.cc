@@ -15,10 +15,12 @@
  */
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
+#include <algorithm>
 #include <future>
 #include <tuple>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr_store.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/local_edge.h"
 #include "minddata/dataset/engine/gnn/local_node.h"
@@ -48,38 +50,46 @@ Status GraphLoader::GetNodesAndEdges() {
   MS_LOG(INFO) << "Start to fill node and edges into graph.";
   NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
   EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
+  // The nodes and edges are added in the order of their ids rather than the order the workers loaded them in, so the
+  // neighbors of each node are in the same order from load to load, and so are the samples drawn with a given seed
+  std::vector<std::shared_ptr<Node>> nodes;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
-    while (!dq.empty()) {
-      std::shared_ptr<Node> node_ptr = dq.front();
-      n_id_map->insert({node_ptr->id(), node_ptr});
-      graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
-      dq.pop_front();
-    }
+    nodes.insert(nodes.end(), dq.begin(), dq.end());
+    dq.clear();
+  }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const std::shared_ptr<Node> &a, const std::shared_ptr<Node> &b) { return a->id() < b->id(); });
+  for (const auto &node_ptr : nodes) {
+    n_id_map->insert({node_ptr->id(), node_ptr});
+    graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
   }
 
+  std::vector<std::shared_ptr<Edge>> edges;
   for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
-    while (!dq.empty()) {
-      std::shared_ptr<Edge> edge_ptr = dq.front();
-      NodeIdType src_id, dst_id;
-      RETURN_IF_NOT_OK(edge_ptr->GetNode(&src_id, &dst_id));
-      auto src_itr = n_id_map->find(src_id), dst_itr = n_id_map->find(dst_id);
+    edges.insert(edges.end(), dq.begin(), dq.end());
+    dq.clear();
+  }
+  std::sort(edges.begin(), edges.end(),
+            [](const std::shared_ptr<Edge> &a, const std::shared_ptr<Edge> &b) { return a->id() < b->id(); });
+  for (const auto &edge_ptr : edges) {
+    NodeIdType src_id, dst_id;
+    RETURN_IF_NOT_OK(edge_ptr->GetNode(&src_id, &dst_id));
+    auto src_itr = n_id_map->find(src_id), dst_itr = n_id_map->find(dst_id);
 
-      CHECK_FAIL_RETURN_UNEXPECTED(
-        src_itr != n_id_map->end(),
-        "[Internal Error] src node with id '" + std::to_string(src_id) + "' has not been created yet.");
-      CHECK_FAIL_RETURN_UNEXPECTED(
-        dst_itr != n_id_map->end(),
-        "[Internal Error] dst node with id '" + std::to_string(dst_id) + "' has not been created yet.");
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      src_itr != n_id_map->end(),
+      "[Internal Error] src node with id '" + std::to_string(src_id) + "' has not been created yet.");
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      dst_itr != n_id_map->end(),
+      "[Internal Error] dst node with id '" + std::to_string(dst_id) + "' has not been created yet.");
 
-      RETURN_IF_NOT_OK(edge_ptr->SetNode(src_itr->second->id(), dst_itr->second->id()));
+    RETURN_IF_NOT_OK(edge_ptr->SetNode(src_itr->second->id(), dst_itr->second->id()));
 
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second, edge_ptr->weight()));
-      RETURN_IF_NOT_OK(src_itr->second->AddAdjacent(dst_itr->second, edge_ptr));
+    RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second, edge_ptr->weight()));
+    RETURN_IF_NOT_OK(src_itr->second->AddAdjacent(dst_itr->second, edge_ptr));
 
-      e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
-      graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
-      dq.pop_front();
-    }
+    e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
+    graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
   }
 
   for (auto &itr : graph_impl_->node_type_map_) {
@@ -93,6 +103,11 @@ Status GraphLoader::GetNodesAndEdges() {
   return Status::OK();
 }
 
+Status GraphLoader::WriteCsrStore(const std::string &store_path) {
+  return GraphCsrStore::Write(store_path, mr_path_, graph_impl_->node_id_map_, graph_impl_->edge_id_map_,
+                              graph_impl_->default_node_feature_map_, graph_impl_->default_edge_feature_map_);
+}
+
 Status GraphLoader::InitAndLoad() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
   CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
@@ -69,6 +69,11 @@ class GraphLoader {
   // features attached to each node and edge are expected to be filled correctly
   Status GetNodesAndEdges();
 
+  // Write the nodes and edges constructed by GetNodesAndEdges to a CSR store
+  // @param std::string store_path - The file of the store
+  // @return Status - the status code
+  Status WriteCsrStore(const std::string &store_path);
+
  protected:
   // merge NodeFeatureMap and EdgeFeatureMap of each worker into 1
   void MergeFeatureMaps();
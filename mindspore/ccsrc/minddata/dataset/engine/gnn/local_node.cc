@@ -66,7 +66,7 @@ Status LocalNode::GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType
 }
 
 Status LocalNode::GetRandomSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
-                                            std::vector<NodeIdType> *out, std::mt19937 *rnd) {
+                                            std::vector<NodeIdType> *out, CounterBasedRandom *rnd) {
   std::vector<NodeIdType> shuffled_id(neighbors.size());
   std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
   std::shuffle(shuffled_id.begin(), shuffled_id.end(), *rnd);
@@ -79,7 +79,7 @@ Status LocalNode::GetRandomSampledNeighbors(const std::vector<std::shared_ptr<No
 
 Status LocalNode::GetWeightSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors,
                                             const std::vector<WeightType> &weights, int32_t samples_num,
-                                            std::vector<NodeIdType> *out, std::mt19937 *rnd) {
+                                            std::vector<NodeIdType> *out, CounterBasedRandom *rnd) {
   CHECK_FAIL_RETURN_UNEXPECTED(neighbors.size() == weights.size(),
                                "The number of neighbors does not match the weight.");
   std::discrete_distribution<NodeIdType> discrete_dist(weights.begin(), weights.end());
@@ -91,7 +91,7 @@ Status LocalNode::GetWeightSampledNeighbors(const std::vector<std::shared_ptr<No
 }
 
 Status LocalNode::GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
-                                      std::vector<NodeIdType> *out_neighbors, std::mt19937 *rnd) {
+                                      std::vector<NodeIdType> *out_neighbors, CounterBasedRandom *rnd) {
   std::vector<NodeIdType> neighbors;
   neighbors.reserve(samples_num);
   auto itr = neighbor_nodes_.find(neighbor_type);
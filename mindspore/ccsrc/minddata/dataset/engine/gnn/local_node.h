@@ -58,7 +58,7 @@ class LocalNode : public Node {
   // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
   // @return Status The status code returned
   Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
-                             std::vector<NodeIdType> *out_neighbors, std::mt19937 *rnd) override;
+                             std::vector<NodeIdType> *out_neighbors, CounterBasedRandom *rnd) override;
 
   // Add neighbor of node
   // @param std::shared_ptr<Node> node -
@@ -84,11 +84,11 @@ class LocalNode : public Node {
 
  private:
   Status GetRandomSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
-                                   std::vector<NodeIdType> *out, std::mt19937 *rnd);
+                                   std::vector<NodeIdType> *out, CounterBasedRandom *rnd);
 
   Status GetWeightSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors,
                                    const std::vector<WeightType> &weights, int32_t samples_num,
-                                   std::vector<NodeIdType> *out, std::mt19937 *rnd);
+                                   std::vector<NodeIdType> *out, CounterBasedRandom *rnd);
 
   uint32_t rnd_seed_;
   std::vector<std::pair<FeatureType, std::shared_ptr<Feature>>> features_;
@@ -73,9 +73,10 @@ class Node {
   // @param int32_t samples_num - Number of neighbors to be acquired
   // @param SamplingStrategy strategy - Sampling strategy
   // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @param CounterBasedRandom *rnd - The random number generator to sample with
   // @return Status The status code returned
   virtual Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
-                                     std::vector<NodeIdType> *out_neighbors, std::mt19937 *rnd) = 0;
+                                     std::vector<NodeIdType> *out_neighbors, CounterBasedRandom *rnd) = 0;
 
   // Add neighbor of node
   // @param std::shared_ptr<Node> node
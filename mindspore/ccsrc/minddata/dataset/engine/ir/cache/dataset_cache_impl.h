@@ -43,15 +43,18 @@ class DatasetCacheImpl : public DatasetCache {
   /// \param port optional port (default=50052).
   /// \param num_connections optional number of connections (default=12).
   /// \param prefetch_sz optional prefetch size (default=20).
+  /// \param shared Share the cache with the other sessions whose pipelines below the cache are the same
+  ///     (default=False).
   DatasetCacheImpl(session_id_type id, uint64_t mem_sz, bool spill, std::optional<std::vector<char>> hostname,
                    std::optional<int32_t> port, std::optional<int32_t> num_connections,
-                   std::optional<int32_t> prefetch_sz)
+                   std::optional<int32_t> prefetch_sz, bool shared = false)
       : session_id_(id),
         cache_mem_sz_(mem_sz),
         spill_(spill),
         port_(std::move(port)),
         num_connections_(std::move(num_connections)),
-        prefetch_sz_(std::move(prefetch_sz)) {
+        prefetch_sz_(std::move(prefetch_sz)),
+        shared_(shared) {
     if (hostname == std::nullopt) {
       hostname_ = std::nullopt;
     } else {
@@ -86,6 +89,7 @@ class DatasetCacheImpl : public DatasetCache {
   std::optional<int32_t> port_;
   std::optional<int32_t> num_connections_;
   std::optional<int32_t> prefetch_sz_;
+  bool shared_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -166,6 +166,11 @@ Status MapNode::to_json(nlohmann::json *out_json) {
     RETURN_IF_NOT_OK(op->to_json(&op_args));
     if (op->Name() == "PyFuncOp") {
       ops.push_back(op_args);
+    } else if (op->Name() == kFusedChainOp) {
+      // a chain fused by the optimizer is saved as the ops it is fused from
+      for (const auto &op_item : op_args["tensor_ops"]) {
+        ops.push_back(op_item);
+      }
     } else {
       nlohmann::json op_item;
       op_item["tensor_op_params"] = op_args;
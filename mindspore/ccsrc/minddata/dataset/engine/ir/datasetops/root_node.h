@@ -63,6 +63,19 @@ class RootNode : public DatasetNode {
   /// \brief Setter of number of epochs
   void SetStep(int64_t step) { step_ = step; }
 
+  /// \brief Getter of the number of rows to skip in the epoch the pipeline is reset to
+  int64_t step_in_epoch() const { return step_in_epoch_; }
+
+  /// \brief Setter of the number of rows to skip in the epoch the pipeline is reset to
+  void SetStepInEpoch(int64_t step_in_epoch) { step_in_epoch_ = step_in_epoch; }
+
+  /// \brief Getter of whether the pipeline is reset to a saved pipeline state
+  bool from_pipeline_state() const { return from_pipeline_state_; }
+
+  /// \brief Setter of whether the pipeline is reset to a saved pipeline state, the op states are restored after
+  ///     the pipeline is built, so the skip can be pushed down through the shuffle nodes
+  void SetFromPipelineState(bool from_pipeline_state) { from_pipeline_state_ = from_pipeline_state; }
+
   /// \brief Setter of number of epochs
   void SetNumEpochs(int32_t num_epochs) override { num_epochs_ = num_epochs; }
 
@@ -85,6 +98,8 @@ class RootNode : public DatasetNode {
  private:
   int32_t num_epochs_;
   int64_t step_;  // to support reset
+  int64_t step_in_epoch_ = 0;
+  bool from_pipeline_state_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
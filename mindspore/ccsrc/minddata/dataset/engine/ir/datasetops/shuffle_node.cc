@@ -48,6 +48,9 @@ Status ShuffleNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_op
   auto op = std::make_shared<ShuffleOp>(shuffle_size_, shuffle_seed_, connector_que_size_, reset_every_epoch_);
   op->SetTotalRepeats(GetTotalRepeats());
   op->SetNumRepeatsPerEpoch(GetNumRepeatsPerEpoch());
+  if (resume_skip_plan_ != nullptr) {
+    op->SetResumeSkip(resume_count_, resume_num_rows_, resume_skip_plan_);
+  }
   node_ops->push_back(op);
   return Status::OK();
 }
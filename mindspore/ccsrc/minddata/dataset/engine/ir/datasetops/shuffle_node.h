@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 
 namespace mindspore {
@@ -61,6 +62,16 @@ class ShuffleNode : public DatasetNode {
   /// \param[in] shuffle_seed The shuffle seed value to be set
   void SetShuffleSeed(uint32_t shuffle_seed) { shuffle_seed_ = shuffle_seed; }
 
+  /// \brief Resume in the middle of the epoch which is restarted, see ShuffleOp::SetResumeSkip()
+  /// \param[in] count The number of rows sent in the epoch before the resume point
+  /// \param[in] num_rows The number of rows in an epoch of the child
+  /// \param[in] skip_plan The skip plan of the child
+  void SetResumeSkip(int64_t count, int64_t num_rows, const std::shared_ptr<SkipPlan> &skip_plan) {
+    resume_count_ = count;
+    resume_num_rows_ = num_rows;
+    resume_skip_plan_ = skip_plan;
+  }
+
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
   /// \return Status of the function
@@ -90,6 +101,9 @@ class ShuffleNode : public DatasetNode {
   int32_t shuffle_size_;
   uint32_t shuffle_seed_;
   bool reset_every_epoch_;
+  int64_t resume_count_ = 0;
+  int64_t resume_num_rows_ = 0;
+  std::shared_ptr<SkipPlan> resume_skip_plan_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -49,6 +49,9 @@ Status SkipNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops)
   if (once_only_) {
     op->SetOnceOnly(true);
   }
+  if (skip_plan_ != nullptr) {
+    op->SetSkipPlan(skip_plan_);
+  }
   node_ops->push_back(op);
   return Status::OK();
 }
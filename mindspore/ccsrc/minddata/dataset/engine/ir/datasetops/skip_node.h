@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 
 namespace mindspore {
@@ -102,9 +103,17 @@ class SkipNode : public DatasetNode {
   /// \brief Getter functions
   const bool OnceOnly() const { return once_only_; }
 
+  /// \brief Skip the rows of a plan instead of the first skip_count rows, only once.
+  /// \param[in] skip_plan The plan filled in by the ShuffleOp above before the pipeline is launched.
+  void SetSkipPlan(const std::shared_ptr<SkipPlan> &skip_plan) { skip_plan_ = skip_plan; }
+
+  /// \brief Getter functions
+  const std::shared_ptr<SkipPlan> &GetSkipPlan() const { return skip_plan_; }
+
  private:
   int32_t skip_count_;
   bool once_only_ = false;
+  std::shared_ptr<SkipPlan> skip_plan_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -48,7 +48,11 @@ Status SkipFirstEpochSamplerObj::from_json(nlohmann::json json_obj, std::shared_
 
 Status SkipFirstEpochSamplerObj::SamplerBuild(std::shared_ptr<SamplerRT> *sampler) {
   // runtime sampler object
-  *sampler = std::make_shared<dataset::SkipFirstEpochSamplerRT>(start_index_, 0);
+  auto sampler_rt = std::make_shared<dataset::SkipFirstEpochSamplerRT>(start_index_, 0);
+  if (skip_plan_ != nullptr) {
+    sampler_rt->SetSkipPlan(skip_plan_);
+  }
+  *sampler = sampler_rt;
   Status s = BuildChildren(sampler);
   sampler = s.IsOk() ? sampler : nullptr;
   return s;
@@ -56,6 +60,7 @@ Status SkipFirstEpochSamplerObj::SamplerBuild(std::shared_ptr<SamplerRT> *sample
 
 std::shared_ptr<SamplerObj> SkipFirstEpochSamplerObj::SamplerCopy() {
   auto sampler = std::make_shared<SkipFirstEpochSamplerObj>(start_index_);
+  sampler->SetSkipPlan(skip_plan_);
   for (const auto &child : children_) {
     Status rc = sampler->AddChildSampler(child);
     if (rc.IsError()) {
@@ -20,6 +20,7 @@
 #include <memory>
 #include <nlohmann/json.hpp>
 
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/sequential_sampler_ir.h"
 #include "include/api/status.h"
 
@@ -50,6 +51,13 @@ class SkipFirstEpochSamplerObj : public SequentialSamplerObj {
   /// \return Status of the function
   static Status from_json(nlohmann::json json_obj, std::shared_ptr<SamplerObj> *sampler);
 #endif
+
+  /// \brief Skip the rows of a plan in the first epoch instead of the rows before start_index.
+  /// \param[in] skip_plan The plan filled in by the ShuffleOp above before the pipeline is launched.
+  void SetSkipPlan(const std::shared_ptr<SkipPlan> &skip_plan) { skip_plan_ = skip_plan; }
+
+ private:
+  std::shared_ptr<SkipPlan> skip_plan_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,234 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/numa_partition.h"
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && !defined(ENABLE_ANDROID)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "./securec.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/path.h"
+
+namespace mindspore {
+namespace dataset {
+Status NumaNodePool::CreateNumaNodePool(std::shared_ptr<MemoryPool> *out_pool, int arena_size, int max_size_in_gb) {
+  RETURN_UNEXPECTED_IF_NULL(out_pool);
+  CHECK_FAIL_RETURN_UNEXPECTED(max_size_in_gb > 0, "Invalid max size of numa node pool: " +
+                                                     std::to_string(max_size_in_gb) + " GB, it should be positive.");
+  std::shared_ptr<MemoryPool> arenas;
+  RETURN_IF_NOT_OK(CircularPool::CreateCircularPool(&arenas, max_size_in_gb, arena_size, true));
+  *out_pool = std::shared_ptr<MemoryPool>(new NumaNodePool(std::static_pointer_cast<CircularPool>(arenas)));
+  return Status::OK();
+}
+
+Status NumaNodePool::Allocate(size_t n, void **p) {
+  Status rc = arenas_->Allocate(n, p);
+  if (rc == StatusCode::kMDOutOfMemory) {
+    // The block does not fit in an arena
+    return system_pool_.Allocate(n, p);
+  }
+  return rc;
+}
+
+Status NumaNodePool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (!arenas_->Owns(*p)) {
+    return system_pool_.Reallocate(p, old_sz, new_sz);
+  }
+  Status rc = arenas_->Reallocate(p, old_sz, new_sz);
+  if (rc != StatusCode::kMDOutOfMemory) {
+    return rc;
+  }
+  // The new size does not fit in an arena, move the block to the system pool
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(system_pool_.Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err) {
+    system_pool_.Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  arenas_->Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void NumaNodePool::Deallocate(void *p) {
+  if (arenas_->Owns(p)) {
+    arenas_->Deallocate(p);
+  } else {
+    system_pool_.Deallocate(p);
+  }
+}
+
+NumaPartition *NumaPartition::GetInstance() {
+  static std::once_flag init_flag;
+  static std::unique_ptr<NumaPartition> instance;
+  std::call_once(init_flag, []() {
+    instance.reset(new NumaPartition());
+    instance->Init();
+  });
+  return instance.get();
+}
+
+Status NumaPartition::ParseCpuList(const std::string &cpu_list, std::vector<int32_t> *cpus) {
+  RETURN_UNEXPECTED_IF_NULL(cpus);
+  cpus->clear();
+  std::stringstream ss(cpu_list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), [](unsigned char c) { return std::isspace(c); }),
+                range.end());
+    if (range.empty()) {
+      continue;
+    }
+    auto pos = range.find('-');
+    try {
+      int32_t first = std::stoi(range.substr(0, pos));
+      int32_t last = pos == std::string::npos ? first : std::stoi(range.substr(pos + 1));
+      CHECK_FAIL_RETURN_UNEXPECTED(first >= 0 && first <= last, "Invalid range in cpu list: " + cpu_list);
+      for (int32_t cpu = first; cpu <= last; ++cpu) {
+        cpus->push_back(cpu);
+      }
+    } catch (const std::exception &) {
+      RETURN_STATUS_UNEXPECTED("Invalid cpu list: " + cpu_list);
+    }
+  }
+  return Status::OK();
+}
+
+int32_t NumaPartition::NodePoolMaxSizeInGB(int64_t node_mem_in_mb, int64_t memory_budget, int32_t num_nodes) {
+  const int64_t kGB = 1024 * 1024 * 1024;
+  const int64_t kMBInGB = 1024;
+  int64_t max_size_in_gb = kDefaultNodePoolSizeInGB;
+  if (memory_budget > 0) {
+    max_size_in_gb = memory_budget / std::max(num_nodes, 1) / kGB;
+  } else if (node_mem_in_mb > 0) {
+    max_size_in_gb = node_mem_in_mb / 2 / kMBInGB;
+  }
+  return static_cast<int32_t>(std::min<int64_t>(std::max<int64_t>(max_size_in_gb, 1),
+                                                std::numeric_limits<int32_t>::max() / kMBInGB));
+}
+
+int32_t NumaPartition::WorkerOfRow(int64_t row, int32_t num_workers, int32_t num_nodes) {
+  // A node without a worker can not take its rows, so they go round robin.
+  if (num_nodes <= 1 || num_workers < num_nodes) {
+    return static_cast<int32_t>(row % num_workers);
+  }
+  // The workers of the node are node, node + num_nodes, node + 2 * num_nodes and so on.
+  auto node = static_cast<int32_t>(row % num_nodes);
+  int64_t num_node_workers = (num_workers - node + num_nodes - 1) / num_nodes;
+  return static_cast<int32_t>((row / num_nodes) % num_node_workers) * num_nodes + node;
+}
+
+void NumaPartition::Init() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && !defined(ENABLE_ANDROID)
+  const char kSysNodePath[] = "/sys/devices/system/node";
+  const char kNodeName[] = "node";
+  Path node_dir(kSysNodePath);
+  auto it = Path::DirIterator::OpenDirectory(&node_dir);
+  if (it == nullptr) {
+    MS_LOG(INFO) << "Unable to open directory " << kSysNodePath << ", the host is taken as a single numa node.";
+    return;
+  }
+  while (it->HasNext()) {
+    Path p = it->Next();
+    const std::string entry = p.Basename();
+    const size_t prefix_len = strlen(kNodeName);
+    if (entry.size() <= prefix_len || entry.compare(0, prefix_len, kNodeName) != 0 ||
+        !std::all_of(entry.begin() + prefix_len, entry.end(), [](unsigned char c) { return std::isdigit(c); })) {
+      continue;
+    }
+    std::ifstream fs((p / "cpulist").ToString());
+    std::string cpu_list;
+    if (fs.fail() || !std::getline(fs, cpu_list)) {
+      MS_LOG(WARNING) << "Unable to read the cpu list of numa " << entry << ", skip it.";
+      continue;
+    }
+    NumaNode node;
+    node.id = std::stoi(entry.substr(prefix_len));
+    Status rc = ParseCpuList(cpu_list, &node.cpus);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Unable to parse the cpu list of numa " << entry << ", skip it. " << rc.GetErrDescription();
+      continue;
+    }
+    // The first line is like "Node 0 MemTotal:       65690248 kB"
+    std::ifstream mem_fs((p / "meminfo").ToString());
+    std::string token;
+    int64_t mem_in_kb = 0;
+    if (mem_fs >> token >> token >> token >> mem_in_kb && token == "MemTotal:") {
+      const int64_t kKBInMB = 1024;
+      node.mem_in_mb = mem_in_kb / kKBInMB;
+    }
+    // A node without cpus only has memory, e.g. high bandwidth memory, and no worker runs on it
+    if (!node.cpus.empty()) {
+      nodes_.push_back(std::move(node));
+    }
+  }
+  std::sort(nodes_.begin(), nodes_.end(), [](const NumaNode &a, const NumaNode &b) { return a.id < b.id; });
+  MS_LOG(INFO) << "Number of numa nodes with cpus: " << nodes_.size();
+#endif
+}
+
+Status NumaPartition::BindThread(int32_t node) {
+  CHECK_FAIL_RETURN_UNEXPECTED(node >= 0 && node < NumNodes(), "Invalid numa node: " + std::to_string(node));
+  if (nodes_.empty()) {
+    return Status::OK();
+  }
+  NumaNode &numa_node = nodes_[node];
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && !defined(ENABLE_ANDROID)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (auto cpu : numa_node.cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+  auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+  if (err != 0) {
+    // E.g. none of the cpus of the node is allowed to the process
+    MS_LOG(WARNING) << "Unable to pin the thread to numa node " << numa_node.id << ", errno: " << err
+                    << ". The thread runs on all the cpus and allocates from the global memory pool.";
+    return Status::OK();
+  }
+#endif
+  // The pool is created after the thread is pinned, so that its first arena is touched on the node
+  std::shared_ptr<MemoryPool> pool;
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    if (numa_node.pool == nullptr) {
+      // The pool is capped, so that the arenas held by the pool do not grow with the peak of the pipeline
+      auto max_size_in_gb = NodePoolMaxSizeInGB(
+        numa_node.mem_in_mb, GlobalContext::config_manager()->autotune_memory_budget(), NumNodes());
+      MS_LOG(INFO) << "Create the memory pool of numa node " << numa_node.id << ", max size: " << max_size_in_gb
+                   << " GB.";
+      RETURN_IF_NOT_OK(NumaNodePool::CreateNumaNodePool(&numa_node.pool, kNodeArenaSizeInMB, max_size_in_gb));
+    }
+    pool = numa_node.pool;
+  }
+  GlobalContext::SetThreadMemPool(pool);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,137 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_NUMA_PARTITION_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_NUMA_PARTITION_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/util/circular_pool.h"
+#include "minddata/dataset/util/memory_pool.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/system_pool.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief The memory pool of a NUMA node. The blocks come from the arenas of a CircularPool, whose pages are placed
+///     on the node by the first touch of the workers pinned to it. A block larger than an arena, or beyond the max size
+///     of the arenas, comes from the system pool instead.
+class NumaNodePool : public MemoryPool {
+ public:
+  ~NumaNodePool() override = default;
+
+  /// \brief Create the memory pool of a NUMA node
+  /// \param[out] out_pool The memory pool created
+  /// \param arena_size The size of an arena in MB
+  /// \param max_size_in_gb The max size of the arenas in GB, the blocks beyond it come from the system pool
+  /// \return Status The status code returned
+  static Status CreateNumaNodePool(std::shared_ptr<MemoryPool> *out_pool, int arena_size, int max_size_in_gb);
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return std::numeric_limits<uint64_t>::max(); }
+
+  int PercentFree() const override { return arenas_->PercentFree(); }
+
+ private:
+  explicit NumaNodePool(std::shared_ptr<CircularPool> arenas) : arenas_(std::move(arenas)) {}
+
+  std::shared_ptr<CircularPool> arenas_;
+  SystemPool system_pool_;
+};
+
+/// \brief The NUMA nodes of the host, for the ExecutionTree running in NUMA partitioned mode. The workers of a parallel
+///     op are pinned to the nodes in turn, and allocate the rows they produce from the memory pool of their node. Row r
+///     of an op is dispatched to a worker of node r % num_nodes, so it stays on one node from an op to the next unless
+///     an op has fewer workers than nodes. The nodes and their pools are shared by all the trees of the process.
+class NumaPartition {
+ public:
+  /// \brief Get the NUMA nodes of the host, which are detected at the first call
+  /// \return The single instance of the process
+  static NumaPartition *GetInstance();
+
+  ~NumaPartition() = default;
+
+  /// \brief The number of NUMA nodes with cpus, which is 1 when the host is not a NUMA system or the nodes can not be
+  ///     detected
+  /// \return The number of nodes
+  int32_t NumNodes() const { return nodes_.empty() ? 1 : static_cast<int32_t>(nodes_.size()); }
+
+  /// \brief The node a worker of a parallel op is pinned to
+  /// \param worker_id The id of the worker in its op
+  /// \return The index of the node
+  int32_t NodeOfWorker(int32_t worker_id) const { return worker_id % NumNodes(); }
+
+  /// \brief The worker of a parallel op a row is dispatched to. The rows of a node are spread over its workers in turn,
+  ///     which is the plain round robin when the number of workers is a multiple of the number of nodes. Otherwise the
+  ///     workers of the nodes with fewer workers take more rows
+  /// \param row The index of the row in the op
+  /// \param num_workers The number of workers of the op
+  /// \param num_nodes The number of nodes the workers are pinned to
+  /// \return The id of the worker
+  static int32_t WorkerOfRow(int64_t row, int32_t num_workers, int32_t num_nodes);
+
+  /// \brief Pin the calling thread to the cpus of a node, and let it allocate from the memory pool of the node
+  /// \param node The index of the node
+  /// \return Status The status code returned
+  Status BindThread(int32_t node);
+
+  /// \brief Parse a cpu list of sysfs, e.g. "0-23,48-71"
+  /// \param cpu_list The cpu list
+  /// \param[out] cpus The ids of the cpus
+  /// \return Status The status code returned
+  static Status ParseCpuList(const std::string &cpu_list, std::vector<int32_t> *cpus);
+
+  /// \brief The max size of the arenas of a node pool. The memory budget of AutoTune is shared by the nodes when it is
+  ///     set, otherwise a pool takes up to half of the memory of its node
+  /// \param node_mem_in_mb The memory of the node in MB, 0 if unknown
+  /// \param memory_budget The memory budget of AutoTune in bytes, 0 if not set
+  /// \param num_nodes The number of nodes
+  /// \return The max size in GB, at least 1
+  static int32_t NodePoolMaxSizeInGB(int64_t node_mem_in_mb, int64_t memory_budget, int32_t num_nodes);
+
+ private:
+  struct NumaNode {
+    int32_t id;
+    std::vector<int32_t> cpus;
+    int64_t mem_in_mb{0};              // The memory of the node, 0 if unknown
+    std::shared_ptr<MemoryPool> pool;  // Created by the first thread bound to the node
+  };
+
+  NumaPartition() = default;
+
+  /// \brief Detect the nodes and their cpus from sysfs
+  void Init();
+
+  // The arenas of the node pools are smaller than the ones of the global CircularPool, since a pool is created per node
+  static constexpr int kNodeArenaSizeInMB = 256;
+  // The max size of a node pool when neither the memory budget nor the memory of the node is known
+  static constexpr int32_t kDefaultNodePoolSizeInGB = 4;
+
+  std::vector<NumaNode> nodes_;
+  std::mutex mux_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_NUMA_PARTITION_H_
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPERATOR_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPERATOR_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -31,14 +32,23 @@ class OperatorConnector : public Queue<TensorRow> {
  public:
   /// Constructor of OperatorConnector
   /// \param queue_capacity The number of element (TensorRows) for the queue.
-  explicit OperatorConnector(int32_t queue_capacity) : Queue<TensorRow>(queue_capacity), out_rows_count_(0) {}
+  explicit OperatorConnector(int32_t queue_capacity)
+      : Queue<TensorRow>(queue_capacity), out_rows_count_(0), avg_row_bytes_(0) {}
 
   /// Destructor of -OperatorConnector
   ~OperatorConnector() = default;
 
   Status PopFront(TensorRow *row) override {
     out_rows_count_++;
-    return Queue::PopFront(row);
+    RETURN_IF_NOT_OK(Queue::PopFront(row));
+    // Sample the size of the rows now and then for the memory model of AutoTune
+    if (out_rows_count_ % kRowBytesSampleInterval == 1 && !row->empty()) {
+      int64_t row_bytes = row->SizeInBytes();
+      int64_t avg = avg_row_bytes_.load(std::memory_order_relaxed);
+      avg_row_bytes_.store(avg == 0 ? row_bytes : (avg * (kRowBytesSmoothing - 1) + row_bytes) / kRowBytesSmoothing,
+                           std::memory_order_relaxed);
+    }
+    return Status::OK();
   }
   Status SendEOE() noexcept {
     TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
@@ -51,8 +61,15 @@ class OperatorConnector : public Queue<TensorRow> {
   }
   auto out_rows_count() const { return out_rows_count_; }
 
+  /// \brief Getter of the moving average of the bytes of the rows popped, 0 if no row is sampled yet
+  int64_t avg_row_bytes() const { return avg_row_bytes_.load(std::memory_order_relaxed); }
+
  private:
+  static constexpr int64_t kRowBytesSampleInterval = 16;
+  static constexpr int64_t kRowBytesSmoothing = 8;
+
   int64_t out_rows_count_;
+  std::atomic<int64_t> avg_row_bytes_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2021 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,55 +16,128 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/fused_chain_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
 
 namespace mindspore {
 namespace dataset {
 
-Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
-  RETURN_UNEXPECTED_IF_NULL(node);
-  RETURN_UNEXPECTED_IF_NULL(modified);
-  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
-
+namespace {
+// Fuse Decode followed by RandomResizedCrop into RandomCropDecodeResize, which only decodes the crop
+Status FuseDecodeRandomResizedCrop(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
-  auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  auto itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                          [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
-  if (itr != ops.end()) {
+  if (itr != ops->end()) {
     MS_LOG(WARNING) << "Fusing pre-build Decode and RandomCropResize into one pre-build.";
     auto fused_op = dynamic_cast<RandomCropAndResizeOp *>((*(itr + 1))->Build().get());
     RETURN_UNEXPECTED_IF_NULL(fused_op);
     (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<RandomCropDecodeResizeOp>(*fused_op));
-    ops.erase(itr + 1);
-    node->setOperations(ops);
+    ops->erase(itr + 1);
     *modified = true;
     return Status::OK();
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
-  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
 
   // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
+  RETURN_OK_IF_TRUE(itr == ops->end());
   auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
   RETURN_UNEXPECTED_IF_NULL(fused_ir);
   // fuse the two ops
   (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
+  ops->erase(itr + 1);
   *modified = true;
   return Status::OK();
 }
+
+// Whether the TensorOp built from the op may describe its computation as a fusable stage. Only these ops are built
+// to find the chains, a pre-built op is already built.
+bool MayBeFusable(const std::shared_ptr<TensorOperation> &op) {
+  static const std::set<std::string> fusable_ops = {vision::kRescaleOperation, vision::kNormalizeOperation,
+                                                    vision::kHwcToChwOperation, transforms::kTypeCastOperation};
+  return op != nullptr && !op->IsRandomOp() &&
+         (fusable_ops.count(op->Name()) > 0 || std::dynamic_pointer_cast<transforms::PreBuiltOperation>(op) != nullptr);
+}
+
+// Fuse each run of ops which describe their computation as a fusable stage into a FusedChainOp
+Status FuseChains(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  std::vector<std::shared_ptr<TensorOperation>> fused_ops;
+  size_t i = 0;
+  while (i < ops->size()) {
+    std::vector<std::shared_ptr<TensorOp>> chain;
+    std::vector<FusableStage> stages;
+    size_t j = i;
+    // a single op is never worth fusing, so it is not built
+    if (i + 1 < ops->size() && MayBeFusable((*ops)[i]) && MayBeFusable((*ops)[i + 1])) {
+      for (; j < ops->size() && MayBeFusable((*ops)[j]); ++j) {
+        std::shared_ptr<TensorOp> op = (*ops)[j]->Build();
+        FusableStage stage;
+        if (op == nullptr || !op->GetFusableStage(&stage) || !FusedChainOp::CanAppend(stages, stage)) {
+          break;
+        }
+        chain.push_back(std::move(op));
+        stages.push_back(std::move(stage));
+      }
+    }
+    if (FusedChainOp::Worthwhile(stages)) {
+      MS_LOG(INFO) << "Fusing a chain of " << chain.size() << " ops starting with " << (*ops)[i]->Name() << ".";
+      // the chain is serialized as the ops it is fused from, like MapNode serializes them
+      std::vector<nlohmann::json> ops_json;
+      for (size_t k = i; k < j; ++k) {
+        nlohmann::json op_item;
+        nlohmann::json op_args;
+        RETURN_IF_NOT_OK((*ops)[k]->to_json(&op_args));
+        op_item["tensor_op_params"] = op_args;
+        op_item["tensor_op_name"] = (*ops)[k]->Name();
+        ops_json.push_back(op_item);
+      }
+      auto fused_op = std::make_shared<FusedChainOp>(chain, stages);
+      fused_op->SetOpsJson(std::move(ops_json));
+      fused_ops.push_back(std::make_shared<transforms::PreBuiltOperation>(std::move(fused_op)));
+      i = j;
+      *modified = true;
+    } else {
+      fused_ops.push_back((*ops)[i]);
+      ++i;
+    }
+  }
+  *ops = std::move(fused_ops);
+  return Status::OK();
+}
+}  // namespace
+
+Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool fused = false;
+  RETURN_IF_NOT_OK(FuseDecodeRandomResizedCrop(&ops, &fused));
+  RETURN_IF_NOT_OK(FuseChains(&ops, &fused));
+  if (fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
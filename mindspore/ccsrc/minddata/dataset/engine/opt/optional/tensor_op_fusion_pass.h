@@ -1,5 +1,5 @@
 /**
- * Copyright 2020 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -24,7 +24,10 @@ namespace dataset {
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
-///     tensor ops within MapOp
+///     tensor ops within MapOp. Decode followed by RandomResizedCrop is fused into RandomCropDecodeResize,
+///     and each run of consecutive ops which describe their computation as a FusableStage (e.g. TypeCast, Rescale,
+///     Normalize and HWC2CHW) is fused into a FusedChainOp computing it in a single pass over an image or a whole
+///     batch.
 class TensorOpFusionPass : public IRNodePass {
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
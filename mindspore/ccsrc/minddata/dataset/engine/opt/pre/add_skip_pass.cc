@@ -90,8 +90,11 @@ Status AddSkipPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const
   // The finder can make updates to the AddSkipPass object.
   AddSkipPass::InjectionFinder finder(root_ir);
   RETURN_IF_NOT_OK(finder.Run(root_ir, modified));
-  // If we detect a shuffle node in the pipeline, we disable fast-recovery
-  if (GlobalContext::config_manager()->fast_recovery() && finder.HasShuffleNode()) {
+  // If we detect a shuffle node in the pipeline, we disable fast-recovery, unless the states of the shuffle ops are
+  // restored from a saved pipeline state
+  auto root = std::dynamic_pointer_cast<RootNode>(root_ir);
+  RETURN_UNEXPECTED_IF_NULL(root);
+  if (GlobalContext::config_manager()->fast_recovery() && finder.HasShuffleNode() && !root->from_pipeline_state()) {
     GlobalContext::config_manager()->set_fast_recovery(false);
     MS_LOG(WARNING) << "Disabling fast recovery of Dataset pipeline since shuffle node is detected.";
   }
@@ -114,12 +117,16 @@ Status AddSkipPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const
     MS_LOG(ERROR) << err_msg;
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The step of a pipeline state is already in its epoch, and it is the dataset size if all the rows of the epoch are
+  // got but the end of it, then the whole epoch is skipped
+  int64_t step_in_epoch = root->from_pipeline_state() ? step : step % dataset_size;
+  root->SetStepInEpoch(step_in_epoch);
   if (step == 0) {
     return Status::OK();
   }
   // in fast recovery, we start from current epoch and skip remaining steps (skip node will also be pushed down)
   if (GlobalContext::config_manager()->fast_recovery()) {
-    int64_t skip_num = step % dataset_size;
+    int64_t skip_num = step_in_epoch;
     auto skip_node = std::make_shared<SkipNode>(skip_num);
     skip_node->SetOnceOnly(true);
     RETURN_IF_NOT_OK(node->InsertAbove(skip_node));
@@ -36,7 +36,7 @@ Status NodeRemovalPass::RemovalNodes::Visit(std::shared_ptr<RepeatNode> node, bo
 // Perform SkipNode removal check.
 Status NodeRemovalPass::RemovalNodes::Visit(std::shared_ptr<SkipNode> node, bool *const modified) {
   *modified = false;
-  if (node->Count() == 0) {
+  if (node->Count() == 0 && node->GetSkipPlan() == nullptr) {
     nodes_to_remove_.push_back(std::static_pointer_cast<DatasetNode>(node));
   }
   return Status::OK();
@@ -20,6 +20,8 @@
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/engine/ir/datasetops/project_node.h"
 #include "minddata/dataset/engine/ir/datasetops/rename_node.h"
+#include "minddata/dataset/engine/ir/datasetops/root_node.h"
+#include "minddata/dataset/engine/ir/datasetops/shuffle_node.h"
 #include "minddata/dataset/engine/ir/datasetops/skip_node.h"
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
@@ -28,7 +30,8 @@
 
 namespace mindspore {
 namespace dataset {
-SkipPushdownPass::SkipNodes::SkipNodes() : skip_count_(0) {}
+SkipPushdownPass::SkipNodes::SkipNodes(bool from_pipeline_state)
+    : skip_count_(0), from_pipeline_state_(from_pipeline_state) {}
 
 // activate the optimization steps, and increase skip_count_ (if not the first skip node in the pipeline)
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<SkipNode> node, bool *const modified) {
@@ -44,7 +47,7 @@ Status SkipPushdownPass::SkipNodes::VisitAfter(std::shared_ptr<SkipNode> node, b
   if (node->OnceOnly() == false) {
     return VisitAfter(std::static_pointer_cast<DatasetNode>(node), modified);
   }
-  CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ == 0, "The skip_count_ cannot be non-zero here.");
+  CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ == 0 && skip_plan_ == nullptr, "The skip_count_ cannot be non-zero here.");
   return Status::OK();
 }
 
@@ -54,8 +57,12 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<BatchNode> node, bool
     return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
   }
 #endif
+  // The rows of a skip plan are not whole batches
+  if (skip_plan_ != nullptr) {
+    return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
+  }
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
@@ -67,7 +74,7 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<BatchNode> node, bool
 
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
@@ -76,7 +83,7 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<ProjectNode> node, boo
 
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<RenameNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
@@ -85,12 +92,15 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<RenameNode> node, bool
 
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MappableSourceNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
   // we have an active skip node above.
   auto new_sampler = std::make_shared<SkipFirstEpochSamplerObj>(skip_count_);
+  if (skip_plan_ != nullptr) {
+    new_sampler->SetSkipPlan(skip_plan_);
+  }
   MS_LOG(INFO) << "Adding SkipFirstEpochSampler(" << skip_count_ << ")";
   auto sampler = node->Sampler();
   if (sampler != nullptr) {
@@ -98,13 +108,14 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MappableSourceNode> no
   }
   node->SetSampler(new_sampler);
   skip_count_ = 0;
+  skip_plan_ = nullptr;
 
   return Status::OK();
 }
 
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
@@ -116,12 +127,36 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MapNode> node, bool *c
 
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<NonMappableSourceNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
   // insert a skip node above
-  (void)insert_skip_above_.emplace_back(node, skip_count_);
+  (void)insert_skip_above_.emplace_back(node, skip_count_, skip_plan_);
+  skip_count_ = 0;
+  skip_plan_ = nullptr;
+  return Status::OK();
+}
+
+// The skip goes through a shuffle node only when the pipeline is reset to a saved pipeline state. The shuffle op then
+// works out the rows it sent before the resume point from the state of its random generator, and the child skips them.
+Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) {
+  CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
+    return Status::OK();
+  }  // no active skip node above. normal flow
+
+  if (!from_pipeline_state_ || skip_plan_ != nullptr) {
+    return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
+  }
+  int64_t num_rows = -1;
+  RETURN_IF_NOT_OK(node->Children()[0]->GetDatasetSize(std::make_shared<DatasetSizeGetter>(), false, &num_rows));
+  if (num_rows <= skip_count_) {
+    return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
+  }
+  MS_LOG(INFO) << "Pushing down Skip(" << skip_count_ << ") through the shuffle node.";
+  skip_plan_ = std::make_shared<SkipPlan>();
+  node->SetResumeSkip(skip_count_, num_rows, skip_plan_);
   skip_count_ = 0;
   return Status::OK();
 }
@@ -130,13 +165,14 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<NonMappableSourceNode>
 // Since MindDataset requires its own SkipFirstEpochSampler (which is not implemented) we insert the skip node above it.
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MindDataNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
   // insert a skip node above
-  (void)insert_skip_above_.emplace_back(node, skip_count_);
+  (void)insert_skip_above_.emplace_back(node, skip_count_, skip_plan_);
   skip_count_ = 0;
+  skip_plan_ = nullptr;
   return Status::OK();
 }
 #endif
@@ -144,13 +180,14 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MindDataNode> node, bo
 // This functions is used for Ops that are random, and the ones in which Visit is Not Implemented yet;
 Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<DatasetNode> node, bool *const modified) {
   CHECK_FAIL_RETURN_UNEXPECTED(skip_count_ >= 0, "The skip size cannot be negative.");
-  if (skip_count_ == 0) {
+  if (skip_count_ == 0 && skip_plan_ == nullptr) {
     return Status::OK();
   }  // no active skip node above. normal flow
 
   // insert a skip node above
-  (void)insert_skip_above_.emplace_back(node, skip_count_);
+  (void)insert_skip_above_.emplace_back(node, skip_count_, skip_plan_);
   skip_count_ = 0;
+  skip_plan_ = nullptr;
   return Status::OK();
 }
 
@@ -169,7 +206,10 @@ Status SkipPushdownPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *c
   // Assumption: The total skip counts in the first_epoch_only skip node is less than the size of the dataset. This
   // assumption is not validated here.
   // Create the skip node pass which can identify which nodes need to be removed and which ones added.
-  std::unique_ptr<SkipPushdownPass::SkipNodes> skip_nodes = std::make_unique<SkipPushdownPass::SkipNodes>();
+  auto root = std::dynamic_pointer_cast<RootNode>(root_ir);
+  bool from_pipeline_state = root != nullptr && root->from_pipeline_state();
+  std::unique_ptr<SkipPushdownPass::SkipNodes> skip_nodes =
+    std::make_unique<SkipPushdownPass::SkipNodes>(from_pipeline_state);
   if (root_ir->IsSizeDefined()) {
     RETURN_IF_NOT_OK(skip_nodes->Run(root_ir, modified));
   }
@@ -180,11 +220,14 @@ Status SkipPushdownPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *c
   }
 
   // Add skip node(s) to the tree (if any)
-  for (auto iter : skip_nodes->insert_skip_above()) {
-    MS_LOG(INFO) << "Inserting a Skip(" << iter.second << ") node above this node: " << iter.first->Name();
-    auto new_skip_node = std::make_shared<SkipNode>(iter.second);
+  for (const auto &[node, count, skip_plan] : skip_nodes->insert_skip_above()) {
+    MS_LOG(INFO) << "Inserting a Skip(" << count << ") node above this node: " << node->Name();
+    auto new_skip_node = std::make_shared<SkipNode>(count);
     new_skip_node->SetOnceOnly(true);
-    RETURN_IF_NOT_OK(iter.first->InsertAbove(new_skip_node));
+    if (skip_plan != nullptr) {
+      new_skip_node->SetSkipPlan(skip_plan);
+    }
+    RETURN_IF_NOT_OK(node->InsertAbove(new_skip_node));
   }
 
   // Then, execute the removal of any nodes that were set up for removal
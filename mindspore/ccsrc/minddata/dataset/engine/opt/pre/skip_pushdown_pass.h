@@ -18,8 +18,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_SKIP_PUSHDOWN_PASS_H_
 
 #include <memory>
-#include <utility>
+#include <tuple>
 #include <vector>
+#include "minddata/dataset/engine/datasetops/skip_plan.h"
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
@@ -35,6 +36,7 @@ class MindDataNode;
 class NonMappableSourceNode;
 class ProjectNode;
 class RenameNode;
+class ShuffleNode;
 class SkipNode;
 
 /// \class SkipPushdownPass skip_pushdown_pass.h
@@ -48,7 +50,8 @@ class SkipPushdownPass : public IRTreePass {
   class SkipNodes : public IRNodePass {
    public:
     /// \brief Constructor
-    SkipNodes();
+    /// \param[in] from_pipeline_state Whether the pipeline is reset to a saved pipeline state
+    explicit SkipNodes(bool from_pipeline_state = false);
 
     /// \brief Destructor
     ~SkipNodes() = default;
@@ -83,6 +86,12 @@ class SkipPushdownPass : public IRTreePass {
     /// \return Status The status code returned
     Status Visit(std::shared_ptr<RenameNode> node, bool *const modified) override;
 
+    /// \brief Perform skip node pushdown check on a ShuffleNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) override;
+
     /// \brief Perform skip node pushdown check on a MappableSourceNode
     /// \param[in] node The node being visited
     /// \param[in, out] modified Indicator if the node was changed at all
@@ -122,8 +131,9 @@ class SkipPushdownPass : public IRTreePass {
     Status VisitAfter(std::shared_ptr<DatasetNode> node, bool *const modified) override { return Status::OK(); };
 
     /// \brief Getter
-    /// \return All the nodes where a skip node needs to be inserted above (and the skip count).
-    const std::vector<std::pair<std::shared_ptr<DatasetNode>, int64_t>> &insert_skip_above() const {
+    /// \return All the nodes where a skip node needs to be inserted above (and the skip count or the skip plan).
+    const std::vector<std::tuple<std::shared_ptr<DatasetNode>, int64_t, std::shared_ptr<SkipPlan>>> &insert_skip_above()
+      const {
       return insert_skip_above_;
     }
 
@@ -132,9 +142,12 @@ class SkipPushdownPass : public IRTreePass {
     const std::vector<std::shared_ptr<DatasetNode>> &nodes_to_remove() const { return nodes_to_remove_; }
 
    private:
-    std::vector<std::pair<std::shared_ptr<DatasetNode>, int64_t>> insert_skip_above_;
+    std::vector<std::tuple<std::shared_ptr<DatasetNode>, int64_t, std::shared_ptr<SkipPlan>>> insert_skip_above_;
     std::vector<std::shared_ptr<DatasetNode>> nodes_to_remove_;
     int64_t skip_count_;
+    // The skip below a shuffle node, which skips the rows the shuffle op sent before the resume point
+    std::shared_ptr<SkipPlan> skip_plan_;
+    bool from_pipeline_state_;
   };
 
  public:
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/pre/tensor_op_setup_pass.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Tell each Decode followed by Resize the size it is resized to, so that a JPEG image is decoded at a reduced scale
+Status SetDecodeTargetSize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  RETURN_OK_IF_TRUE(!GlobalContext::config_manager()->enable_jpeg_scaled_decode());
+  auto is_op = [](const std::shared_ptr<TensorOperation> &op, const std::string &ir_name, const std::string &op_name) {
+    return op != nullptr && (op->Name() == ir_name || op->Name() == op_name);
+  };
+  for (size_t i = 0; i + 1 < ops->size(); ++i) {
+    if (!is_op((*ops)[i], vision::kDecodeOperation, kDecodeOp) ||
+        !is_op((*ops)[i + 1], vision::kResizeOperation, kResizeOp)) {
+      continue;
+    }
+    std::shared_ptr<TensorOp> resize = (*ops)[i + 1]->Build();
+    auto *resize_op = dynamic_cast<ResizeOp *>(resize.get());
+    if (resize_op == nullptr) {
+      continue;
+    }
+    int32_t target_height = 0;
+    int32_t target_width = 0;
+    resize_op->GetMinOutputSize(&target_height, &target_width);
+    auto *decode_ir = dynamic_cast<vision::DecodeOperation *>((*ops)[i].get());
+    if (decode_ir != nullptr) {
+      // A copy, as the op may be shared with another pipeline. The op stays an IR, so the pipeline is still serialized
+      auto scaled_decode_ir = std::make_shared<vision::DecodeOperation>(*decode_ir);
+      scaled_decode_ir->SetTargetSize(target_height, target_width);
+      (*ops)[i] = std::move(scaled_decode_ir);
+    } else {
+      // A DecodeOp built already
+      std::shared_ptr<TensorOp> decode = (*ops)[i]->Build();
+      auto *decode_op = dynamic_cast<DecodeOp *>(decode.get());
+      if (decode_op == nullptr) {
+        continue;
+      }
+      decode_op->SetTargetSize(target_height, target_width);
+    }
+    MS_LOG(INFO) << "Decoding JPEG images at a reduced scale for Resize to " << target_height << "x" << target_width
+                 << ".";
+    *modified = true;
+  }
+  return Status::OK();
+}
+
+// Let the random ops in a map right after a batch draw their random parameters for each sample of the batch
+Status SetBatchMode(const MapNode &node, std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  std::vector<std::shared_ptr<DatasetNode>> children = node.Children();
+  RETURN_OK_IF_TRUE(children.size() != 1 || children[0] == nullptr || children[0]->Name() != kBatchNode);
+  for (auto &op : *ops) {
+    auto *flip_ir = dynamic_cast<vision::RandomHorizontalFlipOperation *>(op.get());
+    if (flip_ir == nullptr) {
+      continue;
+    }
+    // A copy, as the op may be shared with another pipeline
+    auto batch_flip_ir = std::make_shared<vision::RandomHorizontalFlipOperation>(*flip_ir);
+    batch_flip_ir->SetBatchMode(true);
+    op = std::move(batch_flip_ir);
+    *modified = true;
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status TensorOpSetupPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool changed = false;
+  RETURN_IF_NOT_OK(SetDecodeTargetSize(&ops, &changed));
+  RETURN_IF_NOT_OK(SetBatchMode(*node, &ops, &changed));
+  if (changed) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASET_ENGINE_OPT_PRE_TENSOR_OP_SETUP_PASS_H_
+#define DATASET_ENGINE_OPT_PRE_TENSOR_OP_SETUP_PASS_H_
+
+#include <memory>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+/// \class TensorOpSetupPass tensor_op_setup_pass.h
+/// \brief This is a pre pass that sets up the tensor ops of each map by the pipeline around it. Unlike the optional
+///     TensorOpFusionPass, it always runs, as the behavior of the ops depends on it: Decode followed by Resize is
+///     told the target size when JPEG scaled decoding is enabled, and the random ops in a map right after a batch
+///     are set to batch mode, so that each sample of a batch draws its own random parameters.
+class TensorOpSetupPass : public IRNodePass {
+ public:
+  /// \brief Constructor
+  TensorOpSetupPass() {}
+
+  /// \brief Destructor
+  ~TensorOpSetupPass() = default;
+
+  /// \brief Sets up the tensor ops of a MapNode
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates if the node was changed at all
+  /// \return Status The status code returned
+  Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_OPT_PRE_TENSOR_OP_SETUP_PASS_H_
@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <thread>
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 #include "minddata/dataset/engine/serdes.h"
@@ -53,14 +54,28 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       phase_3_ID_(0),
       avg_batch_time(0.0),
       phase_3_prev_avg_(0.0),
+      model_(nullptr),
+      model_round_(0),
+      model_best_throughput_(0.0),
       save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()) {
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
+  int64_t memory_budget = GlobalContext::config_manager()->autotune_memory_budget();
+  int32_t cpu_budget = GlobalContext::config_manager()->autotune_cpu_budget();
+  // Either budget switches to the model-based tuning, the other one is then not limited
+  if (memory_budget > 0 || cpu_budget > 0) {
+    model_ = std::make_unique<AutoTuneModel>(cpu_budget > 0 ? cpu_budget : max_workers_, memory_budget, max_workers_,
+                                             MAX_QUEUE_SIZE);
+  }
 }
 
 Status AutoTune::Main() {
   TaskManager::FindMe()->Post();
   MS_LOG(INFO) << "Dataset AutoTune thread has started.";
+  if (model_ != nullptr && step_gap_ == 0) {
+    // The model is fitted over windows of steps so that it converges within the first epoch
+    step_gap_ = MODEL_WINDOW_STEPS;
+  }
   if (step_gap_ != 0) {
     mode_ = AutoTuneMode::kAutoTuneModeStep;
   } else {
@@ -161,6 +176,9 @@ Status AutoTune::SaveAutotuneConfig(const std::string &file_name) {
   nlohmann::json out_json;
   out_json["summary"] = summary;
   out_json["tree"] = autotune_config_json_;
+  if (model_ != nullptr && model_->NumFits() > 0) {
+    out_json["model"] = model_->ToJson();
+  }
   std::string remark_value = "The following file has been auto-generated by the Dataset AutoTune.";
   if (tree_modifier_->GetRequestsCount() == 0) {
     remark_value += " Dataset Pipeline is not the bottleneck. No configuration changes were made by Dataset AutoTune.";
@@ -368,9 +386,10 @@ bool AutoTune::WarmupSkipCheck() {
       return false;
     }
   } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
-    int64_t skip_value = std::max(STEP_WARMUP, step_gap_);
+    int64_t step_warmup = model_ != nullptr ? MODEL_STEP_WARMUP : STEP_WARMUP;
+    int64_t skip_value = std::max(step_warmup, step_gap_);
     if (cur_step_running_ > skip_value) {
-      last_step_autotuned_ = std::min(STEP_WARMUP, step_gap_);
+      last_step_autotuned_ = std::min(step_warmup, step_gap_);
       skip_flag_ = false;
       return false;
     }
@@ -472,6 +491,9 @@ Status AutoTune::TrackPipelineTime() {
 }
 
 Status AutoTune::RunIteration() {
+  if (model_ != nullptr) {
+    return RunModelIteration();
+  }
   RETURN_IF_NOT_OK(TrackPipelineTime());
   if (AT_phase_ == AutoTunePhase::kAutoTunePhaseTime) {
     RETURN_IF_NOT_OK(AnalyseTime());
@@ -481,6 +503,91 @@ Status AutoTune::RunIteration() {
   return Status::OK();
 }
 
+Status AutoTune::GetOpsStats(std::vector<AutoTuneModel::OpStats> *ops_stats) {
+  std::map<int32_t, double> ops_cpu_util;
+  RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  // The utilization is a percentage of all the cores
+  const double num_cores = static_cast<double>(std::max(std::thread::hardware_concurrency(), 1U));
+  for (const auto &item : ops_) {
+    int32_t op_id = item.first;
+    const auto &op = item.second;
+    if (op->inlined() || op->Name() == "DataQueueOp") {
+      continue;
+    }
+    bool tunable = std::find(parallel_ops_ids_.begin(), parallel_ops_ids_.end(), op_id) != parallel_ops_ids_.end() &&
+                   !SkipOpsCheck(op_id);
+    AutoTuneModel::OpStats stats;
+    stats.op_id = op_id;
+    stats.name = op->NameWithID();
+    stats.tunable = tunable;
+    stats.num_workers = std::max(op->NumWorkers(), 1);
+    stats.prefetch_size = op->ConnectorCapacity();
+    stats.cpu_cores = ops_cpu_util[op_id] / TO_PERCENT * num_cores;
+    stats.row_bytes = op->ConnectorAvgRowBytes();
+    ops_stats->push_back(stats);
+  }
+  return Status::OK();
+}
+
+Status AutoTune::RunModelIteration() {
+  std::vector<int32_t> batch_times;
+  RETURN_IF_NOT_OK(profiling_manager_->GetBatchTimeByStep(last_step_autotuned_, cur_step_running_ - 1, &batch_times));
+  double avg_batch_time = Mean(batch_times);
+  std::vector<AutoTuneModel::OpStats> ops_stats;
+  RETURN_IF_NOT_OK(GetOpsStats(&ops_stats));
+  double total_cores = 0;
+  for (const auto &stats : ops_stats) {
+    total_cores += stats.cpu_cores;
+  }
+  if (avg_batch_time <= 0 || total_cores <= 0) {
+    MS_LOG(INFO) << "Not enough statistics are collected at step # " << cur_step_running_
+                 << ", skip fitting the AutoTune model.";
+    return Status::OK();
+  }
+  double throughput = MS_PER_SECOND / avg_batch_time;
+  MS_LOG(INFO) << "Step # " << cur_step_running_ << ". Pipeline throughput: " << throughput << " batches per second.";
+  // Go back to the best configuration seen if the one solved last time turns out slower
+  if (model_round_ > 0 && throughput < model_best_throughput_ * (1 - MODEL_ROLLBACK_THRESHOLD)) {
+    MS_LOG(INFO) << "Throughput drops from " << model_best_throughput_ << " to " << throughput
+                 << " batches per second, restore the best configuration and stop Dataset AutoTune.";
+    RETURN_IF_NOT_OK(ResetWorkersQueue());
+    AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+    return Status::OK();
+  }
+  if (throughput >= model_best_throughput_) {
+    model_best_throughput_ = throughput;
+    phase_1_best_workers.clear();
+    phase_1_best_queue.clear();
+    RETURN_IF_NOT_OK(RegisterWorkersQueue());
+  }
+  RETURN_IF_NOT_OK(model_->Fit(ops_stats, throughput));
+  if (model_round_ >= MODEL_MAX_ROUNDS) {
+    AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+    return Status::OK();
+  }
+  std::vector<AutoTuneModel::OpConfig> configs;
+  RETURN_IF_NOT_OK(model_->Solve(&configs));
+  bool changed = false;
+  for (const auto &config : configs) {
+    const auto &op = ops_[config.op_id];
+    if (op->NumWorkers() > 0 && config.num_workers != op->NumWorkers()) {
+      int32_t requested_workers = config.num_workers;
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(config.op_id, op->NumWorkers(), &requested_workers));
+      changed = true;
+    }
+    if (config.prefetch_size != op->ConnectorCapacity()) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(config.op_id, op->ConnectorCapacity(), config.prefetch_size));
+      changed = true;
+    }
+  }
+  model_round_++;
+  if (!changed) {
+    MS_LOG(INFO) << "Dataset AutoTune model converges, optimization complete.";
+    AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+  }
+  return Status::OK();
+}
+
 Status AutoTune::GetConnectorSize(std::vector<int32_t> *sizes) const {
   if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
     RETURN_IF_NOT_OK(profiling_manager_->GetConnectorSizeByEpoch(cur_epoch_running_, sizes));
@@ -27,6 +27,7 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/engine/tree_modifier.h"
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 
 namespace mindspore {
@@ -92,6 +93,15 @@ class AutoTune {
   /// \return status code
   Status RunIteration();
 
+  /// The model-based AutoTune logic, fits the model from the last window and solves for the whole tree at once
+  /// \return status code
+  Status RunModelIteration();
+
+  /// Collect the statistics of the ops in the last window to fit the model
+  /// \param[out] ops_stats The statistics of each op which is not inlined
+  /// \return status code
+  Status GetOpsStats(std::vector<AutoTuneModel::OpStats> *ops_stats);
+
   /// Fetches connector size for steps or epoch based on mode
   /// \return status code
   Status GetConnectorSize(std::vector<int32_t> *sizes) const;
@@ -155,6 +165,12 @@ class AutoTune {
   const float MEMORY_COMPARISON_LOWER_BOUND_PERCENT = 0.02;
   const float QUEUE_REDUCTION_PERCENTAGE_EPOCH = 0.5;
   const float QUEUE_REDUCTION_PERCENTAGE_STEP = 0.8;
+  // Model specifics
+  const int64_t MODEL_STEP_WARMUP = 10;
+  const int64_t MODEL_WINDOW_STEPS = 20;
+  const int32_t MODEL_MAX_ROUNDS = 3;
+  const double MODEL_ROLLBACK_THRESHOLD = 0.05;
+  const double MS_PER_SECOND = 1000.0;
 
   /// Get the out connector capacity of the operator
   /// \param[in] op_id operator id
@@ -289,6 +305,11 @@ class AutoTune {
   double phase_3_prev_avg_;
   std::vector<int32_t> OP_values;
 
+  // Model-based tuning, only used when a memory budget is set
+  std::unique_ptr<AutoTuneModel> model_;
+  int32_t model_round_;
+  double model_best_throughput_;
+
   /// True if should save AutoTune configuration
   bool save_autoconfig_;
 
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+AutoTuneModel::AutoTuneModel(int32_t cpu_budget, int64_t memory_budget, int32_t max_workers, int32_t max_prefetch_size)
+    : cpu_budget_(std::max(cpu_budget, 1)),
+      memory_budget_(std::max<int64_t>(memory_budget, 0)),
+      max_workers_(std::max(max_workers, 1)),
+      max_prefetch_size_(std::max(max_prefetch_size, 1)),
+      num_fits_(0),
+      predicted_throughput_(0.0),
+      predicted_memory_(0) {}
+
+Status AutoTuneModel::Fit(const std::vector<OpStats> &ops, double throughput) {
+  CHECK_FAIL_RETURN_UNEXPECTED(throughput > 0, "Throughput of the pipeline should be positive to fit the model.");
+  for (const auto &stats : ops) {
+    double cost = std::max(stats.cpu_cores, 0.0) / throughput;
+    auto itr = ops_.find(stats.op_id);
+    if (itr == ops_.end()) {
+      ops_[stats.op_id] = OpModel{stats.name, stats.tunable, std::max(stats.num_workers, 1), stats.prefetch_size, cost,
+                                  stats.row_bytes, 1};
+      continue;
+    }
+    OpModel &op = itr->second;
+    op.cost = (op.cost * op.num_fits + cost) / (op.num_fits + 1);
+    op.num_fits++;
+    op.num_workers = std::max(stats.num_workers, 1);
+    op.prefetch_size = stats.prefetch_size;
+    if (stats.row_bytes > 0) {
+      op.row_bytes = stats.row_bytes;
+    }
+  }
+  num_fits_++;
+  return Status::OK();
+}
+
+double AutoTuneModel::Capacity(const OpModel &op, int32_t num_workers) {
+  if (op.cost <= 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return num_workers / op.cost;
+}
+
+double AutoTuneModel::CpuBound() const {
+  double total_cost = 0;
+  for (const auto &op : ops_) {
+    total_cost += op.second.cost;
+  }
+  if (total_cost <= 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return cpu_budget_ / total_cost;
+}
+
+Status AutoTuneModel::Solve(std::vector<OpConfig> *configs) {
+  RETURN_UNEXPECTED_IF_NULL(configs);
+  CHECK_FAIL_RETURN_UNEXPECTED(!ops_.empty(), "AutoTune model should be fitted before it is solved.");
+  // Start from the least resources, the ops which can not be tuned keep what they have
+  std::vector<OpConfig> solution;
+  int32_t num_threads = 0;
+  for (const auto &op : ops_) {
+    int32_t num_workers = op.second.tunable ? 1 : op.second.num_workers;
+    int32_t prefetch_size = op.second.tunable ? 1 : op.second.prefetch_size;
+    solution.push_back({op.first, num_workers, prefetch_size});
+    num_threads += num_workers;
+  }
+  if (memory_budget_ > 0 && PredictMemory(solution) > memory_budget_) {
+    MS_LOG(WARNING) << "Dataset AutoTune memory budget of " << memory_budget_ << " bytes is too small, the pipeline "
+                    << "needs " << PredictMemory(solution) << " bytes with a single worker and prefetch slot per op.";
+  }
+  const double cpu_bound = CpuBound();
+  while (num_threads < cpu_budget_) {
+    auto bottleneck = solution.end();
+    double min_capacity = std::numeric_limits<double>::infinity();
+    for (auto itr = solution.begin(); itr != solution.end(); ++itr) {
+      double capacity = Capacity(ops_.at(itr->op_id), itr->num_workers);
+      if (bottleneck == solution.end() || capacity < min_capacity) {
+        bottleneck = itr;
+        min_capacity = capacity;
+      }
+    }
+    // Stop once the slowest op can not be tuned or the pipeline is bound by the cores instead of the slowest op
+    if (!ops_.at(bottleneck->op_id).tunable || min_capacity >= cpu_bound || bottleneck->num_workers >= max_workers_) {
+      break;
+    }
+    // A worker holds a row in flight and needs a prefetch slot to hand it over without waiting
+    OpConfig prev = *bottleneck;
+    bottleneck->num_workers++;
+    bottleneck->prefetch_size =
+      std::min(std::max(bottleneck->prefetch_size, bottleneck->num_workers), max_prefetch_size_);
+    if (memory_budget_ > 0 && PredictMemory(solution) > memory_budget_) {
+      *bottleneck = prev;
+      break;
+    }
+    num_threads++;
+  }
+  // Spend the memory left on prefetching to absorb the jitter of the ops, a slot at a time for each op in turn
+  bool grown = true;
+  while (grown) {
+    grown = false;
+    for (auto &config : solution) {
+      if (!ops_.at(config.op_id).tunable ||
+          config.prefetch_size >= std::min(kPrefetchPerWorker * config.num_workers, max_prefetch_size_)) {
+        continue;
+      }
+      config.prefetch_size++;
+      if (memory_budget_ > 0 && PredictMemory(solution) > memory_budget_) {
+        config.prefetch_size--;
+        continue;
+      }
+      grown = true;
+    }
+  }
+  predicted_throughput_ = PredictThroughput(solution);
+  predicted_memory_ = PredictMemory(solution);
+  MS_LOG(INFO) << "Dataset AutoTune model predicts " << predicted_throughput_ << " batches per second with "
+               << predicted_memory_ << " bytes of buffered rows.";
+  solution_ = solution;
+  *configs = std::move(solution);
+  return Status::OK();
+}
+
+double AutoTuneModel::PredictThroughput(const std::vector<OpConfig> &configs) const {
+  double throughput = CpuBound();
+  for (const auto &config : configs) {
+    auto itr = ops_.find(config.op_id);
+    if (itr != ops_.end()) {
+      throughput = std::min(throughput, Capacity(itr->second, config.num_workers));
+    }
+  }
+  return throughput;
+}
+
+int64_t AutoTuneModel::PredictMemory(const std::vector<OpConfig> &configs) const {
+  int64_t memory = 0;
+  for (const auto &config : configs) {
+    auto itr = ops_.find(config.op_id);
+    if (itr != ops_.end()) {
+      memory += static_cast<int64_t>(config.num_workers + config.prefetch_size) * itr->second.row_bytes;
+    }
+  }
+  return memory;
+}
+
+nlohmann::json AutoTuneModel::ToJson() const {
+  nlohmann::json out_json;
+  out_json["cpu_budget"] = cpu_budget_;
+  out_json["memory_budget"] = memory_budget_;
+  out_json["num_fits"] = num_fits_;
+  out_json["predicted_throughput"] = predicted_throughput_;
+  out_json["predicted_memory"] = predicted_memory_;
+  nlohmann::json ops_json = nlohmann::json::array();
+  for (const auto &config : solution_) {
+    const OpModel &op = ops_.at(config.op_id);
+    nlohmann::json op_json;
+    op_json["op_id"] = config.op_id;
+    op_json["name"] = op.name;
+    op_json["tunable"] = op.tunable;
+    op_json["cost"] = op.cost;
+    op_json["row_bytes"] = op.row_bytes;
+    op_json["num_parallel_workers"] = config.num_workers;
+    op_json["prefetch_size"] = config.prefetch_size;
+    ops_json.push_back(op_json);
+  }
+  out_json["ops"] = ops_json;
+  return out_json;
+}
+}  // namespace dataset
+}  // namespace mindspore
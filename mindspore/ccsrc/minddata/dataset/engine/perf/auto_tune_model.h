@@ -0,0 +1,120 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A throughput and memory model of a data pipeline, fitted from the statistics collected by the profiler.
+///     The CPU cost of each op is the number of cores it keeps busy per output batch per second, so an op with n
+///     workers can sustain at most n / cost batches per second, and the pipeline runs at the rate of its slowest op.
+///     Each worker holds a row in flight and each slot of a connector holds a queued row, which gives the memory of a
+///     configuration from the average row size of each connector. AutoTune solves the model for the num_workers and
+///     the prefetch_size of all the ops at once instead of changing one op at a time.
+class AutoTuneModel {
+ public:
+  /// \brief The statistics of an op over a profiled window
+  struct OpStats {
+    int32_t op_id;
+    std::string name;
+    bool tunable;           // whether num_workers and prefetch_size of the op can be changed
+    int32_t num_workers;    // number of threads of the op during the window, at least 1
+    int32_t prefetch_size;  // capacity of the output connector
+    double cpu_cores;       // average number of cores used by the op
+    int64_t row_bytes;      // average bytes of a row in the output connector, 0 if unknown
+  };
+
+  /// \brief The configuration of an op solved from the model
+  struct OpConfig {
+    int32_t op_id;
+    int32_t num_workers;
+    int32_t prefetch_size;
+  };
+
+  /// \brief Constructor
+  /// \param[in] cpu_budget The max total number of threads of the ops
+  /// \param[in] memory_budget The max bytes of the rows held by the workers and the connectors, 0 means no limit
+  /// \param[in] max_workers The max num_workers of an op
+  /// \param[in] max_prefetch_size The max prefetch_size of an op
+  AutoTuneModel(int32_t cpu_budget, int64_t memory_budget, int32_t max_workers, int32_t max_prefetch_size);
+
+  ~AutoTuneModel() = default;
+
+  /// \brief Fit the cost of each op from the statistics of a window. The costs of the windows fitted so far are
+  ///     averaged, so that a refit after a change of the configuration smooths out the noise of a single window.
+  /// \param[in] ops The statistics of the ops in the window
+  /// \param[in] throughput The number of batches per second produced by the pipeline in the window
+  /// \return Status The status code returned
+  Status Fit(const std::vector<OpStats> &ops, double throughput);
+
+  /// \brief Solve for the configuration with the highest throughput within the budgets. Workers are given one at a
+  ///     time to the tunable op with the lowest capacity, then the memory left is spent on prefetching, up to
+  ///     kPrefetchPerWorker slots per worker.
+  /// \param[out] configs The configuration of each op fitted
+  /// \return Status The status code returned
+  Status Solve(std::vector<OpConfig> *configs);
+
+  /// \brief Predict the number of batches per second of the pipeline with a configuration
+  double PredictThroughput(const std::vector<OpConfig> &configs) const;
+
+  /// \brief Predict the bytes of the rows held by the pipeline with a configuration
+  int64_t PredictMemory(const std::vector<OpConfig> &configs) const;
+
+  /// \brief Getter of the number of windows fitted
+  int32_t NumFits() const { return num_fits_; }
+
+  /// \brief Serialize the model and the last configuration solved
+  nlohmann::json ToJson() const;
+
+  static constexpr int32_t kPrefetchPerWorker = 4;
+
+ private:
+  struct OpModel {
+    std::string name;
+    bool tunable;
+    int32_t num_workers;
+    int32_t prefetch_size;
+    double cost;  // cores per batch per second, i.e. CPU seconds per output batch
+    int64_t row_bytes;
+    int32_t num_fits;
+  };
+
+  // Max number of batches per second of an op with the number of workers
+  static double Capacity(const OpModel &op, int32_t num_workers);
+
+  // Max number of batches per second the cores of the budget can sustain
+  double CpuBound() const;
+
+  int32_t cpu_budget_;
+  int64_t memory_budget_;
+  int32_t max_workers_;
+  int32_t max_prefetch_size_;
+  int32_t num_fits_;
+  std::map<int32_t, OpModel> ops_;
+  std::vector<OpConfig> solution_;
+  double predicted_throughput_;
+  int64_t predicted_memory_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
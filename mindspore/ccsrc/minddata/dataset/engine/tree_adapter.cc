@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2022 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -37,6 +37,7 @@
 #include "minddata/dataset/engine/opt/pre/input_validation_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_removal_pass.h"
 #include "minddata/dataset/engine/opt/pre/skip_pushdown_pass.h"
+#include "minddata/dataset/engine/opt/pre/tensor_op_setup_pass.h"
 #include "minddata/dataset/engine/perf/info_collector.h"
 
 namespace mindspore {
@@ -50,7 +51,9 @@ TreeAdapter::TreeAdapter(UsageFlag usage)
       // Initialize profiling parameters
       cur_batch_num_(0),
       cur_connector_size_(0),
-      cur_connector_capacity_(0) {}
+      cur_connector_capacity_(0),
+      cur_epoch_(0),
+      cur_step_(0) {}
 
 Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
   RETURN_UNEXPECTED_IF_NULL(ir);
@@ -71,6 +74,7 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
   if (usage_ == kDeGetter) {
     (void)actions.emplace_back(std::make_unique<GetterPass>());
   }
+  (void)actions.emplace_back(std::make_unique<TensorOpSetupPass>());
 #ifndef ENABLE_ANDROID
   (void)actions.emplace_back(std::make_unique<CacheTransformPass>());
 
@@ -183,6 +187,7 @@ Status TreeAdapter::Build(std::shared_ptr<DatasetNode> root_ir, int64_t epoch_nu
 
   if (usage_ == kDeReset) {
     RETURN_IF_NOT_OK(AdjustReset(epoch_num));
+    RETURN_IF_NOT_OK(RestorePipelineState(epoch_num));
   }
 
   // Prepare the tree
@@ -215,12 +220,17 @@ Status TreeAdapter::Compile(const std::shared_ptr<DatasetNode> &input_ir, int32_
   std::shared_ptr<RootNode> root_ir = cloning_tree.Root();
   root_ir->SetNumEpochs(num_epochs);
   root_ir->SetStep(step);
+  root_ir->SetFromPipelineState(!pipeline_state_.is_null());
 
   tree_state_ = kCompileStateIRTreeCloned;
   MS_LOG(INFO) << "Plan before optimization:" << '\n' << *root_ir << '\n';
 
   // Pre-pass of the IR tree
   RETURN_IF_NOT_OK(PrePass(root_ir));
+  if (usage_ == kDeReset) {
+    cur_epoch_ = epoch_num;
+    cur_step_ = root_ir->step_in_epoch();
+  }
 
   // Optional phase of optimization
   if (optimize_) {
@@ -241,6 +251,64 @@ Status TreeAdapter::Compile(const std::shared_ptr<DatasetNode> &input_ir, int32_
   return Status::OK();
 }
 
+Status TreeAdapter::CompileFromPipelineState(const std::shared_ptr<DatasetNode> &input_ir, int32_t num_epochs,
+                                             const nlohmann::json &pipeline_state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(usage_ == kDeReset, "[Internal ERROR] A pipeline state is only restored in reset mode.");
+  CHECK_FAIL_RETURN_UNEXPECTED(GlobalContext::config_manager()->fast_recovery(),
+                               "Cannot restore the pipeline state, fast recovery is disabled.");
+  CHECK_FAIL_RETURN_UNEXPECTED(pipeline_state.is_object() && pipeline_state.contains("epoch") &&
+                                 pipeline_state["epoch"].is_number_integer() && pipeline_state.contains("step") &&
+                                 pipeline_state["step"].is_number_integer() && pipeline_state.contains("ops") &&
+                                 pipeline_state["ops"].is_array(),
+                               "Cannot restore the pipeline state, invalid pipeline state: " + pipeline_state.dump());
+  auto epoch_num = pipeline_state["epoch"].get<int64_t>();
+  auto step = pipeline_state["step"].get<int64_t>();
+  CHECK_FAIL_RETURN_UNEXPECTED(epoch_num >= 0 && step >= 0,
+                               "Cannot restore the pipeline state, epoch and step must be >= 0. epoch: " +
+                                 std::to_string(epoch_num) + ", step: " + std::to_string(step));
+  pipeline_state_ = pipeline_state;
+  // The op states are of the start of the epoch, so only the rows in the epoch are skipped
+  return Compile(input_ir, num_epochs, step, epoch_num);
+}
+
+Status TreeAdapter::GetPipelineState(nlohmann::json *pipeline_state) {
+  RETURN_UNEXPECTED_IF_NULL(pipeline_state);
+  CHECK_FAIL_RETURN_UNEXPECTED(tree_ != nullptr, "Tree is a nullptr.");
+  nlohmann::json op_states = nlohmann::json::array();
+  for (auto op = tree_->begin(); op != tree_->end(); ++op) {
+    nlohmann::json op_state;
+    RETURN_IF_NOT_OK(op->SaveEpochState(cur_epoch_, &op_state));
+    if (!op_state.is_null()) {
+      op_states.push_back({{"op", op->Name()}, {"state", op_state}});
+    }
+  }
+  *pipeline_state = {{"epoch", cur_epoch_}, {"step", cur_step_}, {"ops", op_states}};
+  return Status::OK();
+}
+
+Status TreeAdapter::RestorePipelineState(const int64_t epoch_num) {
+  if (pipeline_state_.is_null()) {
+    return Status::OK();
+  }
+  MS_LOG(INFO) << "Restoring the op states of the dataset pipeline to epoch: " << (epoch_num + 1);
+  // The ops with a state are matched in the order of the tree, the skip ops injected by reset have no state
+  const auto &op_states = pipeline_state_["ops"];
+  size_t i = 0;
+  for (auto op = tree_->begin(); op != tree_->end() && i < op_states.size(); ++op) {
+    const auto &op_state = op_states[i];
+    CHECK_FAIL_RETURN_UNEXPECTED(op_state.is_object() && op_state.contains("op") && op_state["op"].is_string() &&
+                                   op_state.contains("state"),
+                                 "Cannot restore the pipeline state, invalid op state: " + op_state.dump());
+    if (op->Name() == op_state["op"].get<std::string>()) {
+      RETURN_IF_NOT_OK(op->RestoreEpochState(epoch_num, op_state["state"]));
+      ++i;
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(i == op_states.size(),
+                               "Cannot restore the pipeline state, it does not match the ops of the pipeline.");
+  return Status::OK();
+}
+
 Status TreeAdapter::AdjustReset(const int64_t epoch_num) {
   if (GlobalContext::config_manager()->fast_recovery() && epoch_num > 0) {
     MS_LOG(INFO) << "Adjusting dataset pipeline for failover reset to start on epoch: " << (epoch_num + 1);
@@ -272,6 +340,8 @@ Status TreeAdapter::GetNext(TensorRow *row) {
   RETURN_IF_NOT_OK(tree_->root()->GetNextRow(row));  // first buf can't be eof or empty buf with none flag
   if (row->eoe()) {                                  // return empty tensor if 1st buf is a ctrl buf (no rows)
     MS_LOG(INFO) << "End of data iteration.  cur_batch_num_: " << cur_batch_num_;
+    cur_epoch_++;
+    cur_step_ = 0;
 #ifndef ENABLE_SECURITY
     if (profiling_manager_ != nullptr) {
       tree_->SetEpochEnd();
@@ -286,6 +356,7 @@ Status TreeAdapter::GetNext(TensorRow *row) {
     std::string err = "EOF buffer encountered. User tries to fetch data beyond the specified number of epochs.";
     RETURN_STATUS_UNEXPECTED(err);
   }
+  cur_step_++;
 
   // Record profiling info
 #ifndef ENABLE_SECURITY
@@ -60,6 +60,15 @@ class TreeAdapter {
   Status Compile(const std::shared_ptr<DatasetNode> &input_ir, int32_t num_epochs = -1, int64_t step = 0,
                  const int64_t epoch_num = 0);
 
+  // This function compiles the IR tree in reset mode to resume from a pipeline state got by GetPipelineState(). The
+  // pipeline restarts the epoch of the state with the op states restored, and skips the rows before the step of it.
+  Status CompileFromPipelineState(const std::shared_ptr<DatasetNode> &input_ir, int32_t num_epochs,
+                                  const nlohmann::json &pipeline_state);
+
+  // Get the state to resume the pipeline from the next row of GetNext(), which is the epoch and the step in it of the
+  // row, and the states of the ops at the start of the epoch. It is called between the calls of GetNext().
+  Status GetPipelineState(nlohmann::json *pipeline_state);
+
   // Return the root node of the IR after cloned from the parsed IR tree
   std::shared_ptr<DatasetNode> RootIRNode() const { return root_ir_; }
 
@@ -124,6 +133,9 @@ class TreeAdapter {
   // Adjust the pipeline (eg, move rng_ forward) if in reset mode
   Status AdjustReset(const int64_t epoch_num);
 
+  // Restore the op states of the pipeline state if the pipeline is compiled from one
+  Status RestorePipelineState(const int64_t epoch_num);
+
   std::unordered_map<std::string, int32_t> column_name_map_;
   std::shared_ptr<DatasetNode> input_ir_;
   std::shared_ptr<DatasetNode> root_ir_;
@@ -137,6 +149,9 @@ class TreeAdapter {
   int32_t cur_connector_size_;      // current connector size of root op, used for profiling
   int32_t cur_connector_capacity_;  // current connector capacity of root op, used for profiling
   UsageFlag usage_;                 // usage of this tree adapter (type of consumer)
+  int64_t cur_epoch_;               // current epoch number of GetNext(), for the pipeline state
+  int64_t cur_step_;                // number of rows got in the current epoch, for the pipeline state
+  nlohmann::json pipeline_state_;   // the pipeline state to restore, null if not compiled from one
   bool launched_;
   // State flags for the lifecycle of the tree
   enum CompileState {
@@ -91,6 +91,13 @@ Status PadEnd(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> *dst,
 Status PadEndNumeric(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> *dst,
                      const std::vector<dsize_t> &pad_shape, float pad_val);
 
+// Pad input numeric tensor into a tensor which already has the pad shape, e.g. a slot of a batch buffer.
+// @param std::shared_ptr<Tensor> src - tensor to pad from
+// @param std::shared_ptr<Tensor> dst - tensor to pad to, need to have same rank and type as src
+// @param float pad_val - value to pad with
+// @return Status The status code returned
+Status PadEndNumericInto(const std::shared_ptr<Tensor> &src, const std::shared_ptr<Tensor> &dst, float pad_val);
+
 // recursive helper function for padding numric tensors. This function could be very expensive if called on a
 // multi-dimensional tensor it is only meant to be called by PadEndNumeric.
 // @tparam T - type of tensor and fill value
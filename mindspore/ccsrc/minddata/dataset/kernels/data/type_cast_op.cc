@@ -29,6 +29,15 @@ Status TypeCastOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   IO_CHECK(input, output);
   return TypeCast(input, output, type_);
 }
+bool TypeCastOp::GetFusableStage(FusableStage *stage) const {
+  // Only a cast to float32 keeps the values the other stages compute on
+  if (stage == nullptr || type_ != DataType(DataType::DE_FLOAT32)) {
+    return false;
+  }
+  stage->kind = FusableStage::Kind::kCastToFloat;
+  return true;
+}
+
 Status TypeCastOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = type_;
@@ -43,6 +43,8 @@ class TypeCastOp : public TensorOp {
 
   std::string Name() const override { return kTypeCastOp; }
 
+  bool GetFusableStage(FusableStage *stage) const override;
+
  private:
   DataType type_;
 };
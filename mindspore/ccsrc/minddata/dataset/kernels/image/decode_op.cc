@@ -42,7 +42,11 @@ Status DecodeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
                              std::to_string(input->Rank()));
   }
   if (is_rgb_format_) {  // RGB color mode
+#ifndef ENABLE_ANDROID
+    return Decode(input, output, target_height_, target_width_);
+#else
     return Decode(input, output);
+#endif
   } else {  // BGR color mode
     RETURN_STATUS_UNEXPECTED(
       "Decode: only support Decoded into RGB image, check input parameter 'rgb' first, its value should be 'True'.");
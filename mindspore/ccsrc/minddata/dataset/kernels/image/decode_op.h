@@ -42,8 +42,19 @@ class DecodeOp : public TensorOp {
 
   std::string Name() const override { return kDecodeOp; }
 
+  /// \brief Tell the size the decoded images are resized to afterwards, so that a JPEG image is decoded at the
+  ///     smallest scale whose output still covers it
+  /// \param[in] target_height The height the images are resized to, 0 if unknown
+  /// \param[in] target_width The width the images are resized to, 0 if unknown
+  void SetTargetSize(int32_t target_height, int32_t target_width) {
+    target_height_ = target_height;
+    target_width_ = target_width;
+  }
+
  private:
   bool is_rgb_format_ = true;
+  int32_t target_height_ = 0;
+  int32_t target_width_ = 0;
 };
 }  // namespace dataset
 }  // namespace mindspore
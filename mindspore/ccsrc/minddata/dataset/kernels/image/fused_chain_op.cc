@@ -0,0 +1,298 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_chain_op.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr dsize_t kHwcRank = 3;
+constexpr dsize_t kHwRank = 2;
+
+bool PerChannel(const FusableStage &stage) {
+  return (stage.kind == FusableStage::Kind::kScaleShift || stage.kind == FusableStage::Kind::kNormalize) &&
+         stage.a.size() > 1;
+}
+
+bool HasHwcToChw(const std::vector<FusableStage> &stages) {
+  return std::any_of(stages.begin(), stages.end(),
+                     [](const FusableStage &s) { return s.kind == FusableStage::Kind::kHwcToChw; });
+}
+
+// Whether the channel is the last dimension of the input. Without a change of layout, the input has the layout the
+// stages with a value per channel expect
+bool InputIsHwc(const std::vector<FusableStage> &stages) {
+  if (HasHwcToChw(stages)) {
+    return true;
+  }
+  auto itr = std::find_if(stages.begin(), stages.end(), PerChannel);
+  return itr == stages.end() || itr->is_hwc;
+}
+
+// Apply a stage to a tile of n pixels of num_channels channels each, the channel being the last dimension
+void ApplyStage(FusableStage::Kind kind, const float *a, const float *b, int64_t n, int64_t num_channels,
+                float *tile) {
+  if (kind == FusableStage::Kind::kScaleShift) {
+    for (int64_t p = 0; p < n; ++p) {
+      for (int64_t c = 0; c < num_channels; ++c) {
+        tile[p * num_channels + c] = tile[p * num_channels + c] * a[c] + b[c];
+      }
+    }
+  } else if (kind == FusableStage::Kind::kNormalize) {
+    for (int64_t p = 0; p < n; ++p) {
+      for (int64_t c = 0; c < num_channels; ++c) {
+        tile[p * num_channels + c] = (tile[p * num_channels + c] - a[c]) / b[c];
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedChainOp::FusedChainOp(std::vector<std::shared_ptr<TensorOp>> ops, std::vector<FusableStage> stages)
+    : ops_(std::move(ops)), stages_(std::move(stages)) {}
+
+bool FusedChainOp::CanAppend(const std::vector<FusableStage> &stages, const FusableStage &stage) {
+  bool to_chw = HasHwcToChw(stages);
+  if (stage.kind == FusableStage::Kind::kHwcToChw) {
+    // Only one change of layout, and only from an input whose channel is the last dimension
+    return !to_chw && std::none_of(stages.begin(), stages.end(),
+                                   [](const FusableStage &s) { return PerChannel(s) && !s.is_hwc; });
+  }
+  if (!PerChannel(stage)) {
+    return true;
+  }
+  if (to_chw) {
+    return !stage.is_hwc;
+  }
+  // All the stages before a change of layout see the same layout
+  return std::all_of(stages.begin(), stages.end(),
+                     [&stage](const FusableStage &s) { return !PerChannel(s) || s.is_hwc == stage.is_hwc; });
+}
+
+bool FusedChainOp::Worthwhile(const std::vector<FusableStage> &stages) {
+  return stages.size() > 1 && !std::all_of(stages.begin(), stages.end(), [](const FusableStage &s) {
+    return s.kind == FusableStage::Kind::kHwcToChw;
+  });
+}
+
+void FusedChainOp::Print(std::ostream &out) const {
+  out << Name() << ":";
+  for (const auto &op : ops_) {
+    out << " " << op->Name();
+  }
+  out << std::endl;
+}
+
+Status FusedChainOp::to_json(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  (*out_json)["tensor_ops"] = ops_json_;
+  return Status::OK();
+}
+
+Status FusedChainOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  bool computed = false;
+  RETURN_IF_NOT_OK(ComputeStages(stages_, input, output, &computed));
+  if (!computed) {
+    return ComputeUnfused(input, output);
+  }
+  return Status::OK();
+}
+
+Status FusedChainOp::ComputeStages(const std::vector<FusableStage> &stages, const std::shared_ptr<Tensor> &input,
+                                   std::shared_ptr<Tensor> *output, bool *computed) {
+  IO_CHECK(input, output);
+  RETURN_UNEXPECTED_IF_NULL(computed);
+  *computed = false;
+  dsize_t rank = input->Rank();
+  if (rank < kHwRank || input->Size() == 0) {
+    return Status::OK();
+  }
+  // The dimensions before the last three are a batch of images
+  int64_t num_channels = 1;
+  int64_t num_images = 1;
+  if (rank >= kHwcRank) {
+    const TensorShape &shape = input->shape();
+    num_channels = InputIsHwc(stages) ? shape[-1] : shape[-kHwcRank];
+    num_images = input->Size() / (shape[-1] * shape[-2] * shape[-kHwcRank]);
+  }
+  std::vector<std::vector<float>> a, b;
+  if (!ExpandParams(stages, num_channels, &a, &b)) {
+    return Status::OK();
+  }
+  *computed = true;
+  switch (input->type().value()) {
+    case DataType::DE_INT8:
+      return ComputeFused<int8_t>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_UINT8:
+      return ComputeFused<uint8_t>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_INT16:
+      return ComputeFused<int16_t>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_UINT16:
+      return ComputeFused<uint16_t>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_INT32:
+      return ComputeFused<int32_t>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_FLOAT32:
+      return ComputeFused<float>(stages, input, num_images, num_channels, a, b, output);
+    case DataType::DE_FLOAT64:
+      return ComputeFused<double>(stages, input, num_images, num_channels, a, b, output);
+    default:
+      // Let the ops tell whether they support the type
+      *computed = false;
+      return Status::OK();
+  }
+}
+
+Status FusedChainOp::ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> in = input;
+  for (const auto &op : ops_) {
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(op->Compute(in, &out));
+    in = std::move(out);
+  }
+  *output = std::move(in);
+  return Status::OK();
+}
+
+bool FusedChainOp::ExpandParams(const std::vector<FusableStage> &stages, int64_t num_channels,
+                                std::vector<std::vector<float>> *a, std::vector<std::vector<float>> *b) {
+  a->resize(stages.size());
+  b->resize(stages.size());
+  for (size_t i = 0; i < stages.size(); ++i) {
+    const FusableStage &stage = stages[i];
+    if (stage.kind != FusableStage::Kind::kScaleShift && stage.kind != FusableStage::Kind::kNormalize) {
+      continue;
+    }
+    if (stage.a.size() != stage.b.size() || stage.a.empty() ||
+        (stage.a.size() != 1 && static_cast<int64_t>(stage.a.size()) != num_channels)) {
+      return false;
+    }
+    (*a)[i] = stage.a.size() == 1 ? std::vector<float>(num_channels, stage.a[0]) : stage.a;
+    (*b)[i] = stage.b.size() == 1 ? std::vector<float>(num_channels, stage.b[0]) : stage.b;
+  }
+  return true;
+}
+
+template <typename T>
+Status FusedChainOp::ComputeFused(const std::vector<FusableStage> &stages, const std::shared_ptr<Tensor> &input,
+                                  int64_t num_images, int64_t num_channels, const std::vector<std::vector<float>> &a,
+                                  const std::vector<std::vector<float>> &b, std::shared_ptr<Tensor> *output) {
+  const TensorShape &shape = input->shape();
+  bool hwc = input->Rank() >= kHwcRank;
+  bool is_hwc = InputIsHwc(stages);
+  bool to_chw = HasHwcToChw(stages);
+  int64_t image_size = input->Size() / num_images;
+  int64_t num_pixels = image_size / num_channels;
+  TensorShape out_shape = shape;
+  if (hwc && to_chw) {
+    std::vector<dsize_t> dims = shape.AsVector();
+    size_t rank = dims.size();
+    std::rotate(dims.begin() + (rank - kHwcRank), dims.end() - 1, dims.end());
+    out_shape = TensorShape(dims);
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, DataType(DataType::DE_FLOAT32), output));
+  const T *src = reinterpret_cast<const T *>(input->GetBuffer());
+  auto *dst = reinterpret_cast<float *>((*output)->GetMutableBuffer());
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(dst);
+
+  if (!is_hwc) {
+    // A plane per channel, so each stage has a single value over a tile, which is written in place
+    std::vector<float> a_c(stages.size()), b_c(stages.size());
+    for (int64_t c = 0; c < num_channels; ++c) {
+      for (size_t i = 0; i < stages.size(); ++i) {
+        a_c[i] = a[i].empty() ? 0 : a[i][c];
+        b_c[i] = b[i].empty() ? 0 : b[i][c];
+      }
+      for (int64_t n = 0; n < num_images; ++n) {
+        int64_t plane = n * image_size + c * num_pixels;
+        for (int64_t p0 = 0; p0 < num_pixels; p0 += kTilePixels) {
+          int64_t len = std::min(kTilePixels, num_pixels - p0);
+          float *tile = dst + plane + p0;
+          const T *in = src + plane + p0;
+          for (int64_t k = 0; k < len; ++k) {
+            tile[k] = static_cast<float>(in[k]);
+          }
+          for (size_t i = 0; i < stages.size(); ++i) {
+            ApplyStage(stages[i].kind, &a_c[i], &b_c[i], len, 1, tile);
+          }
+        }
+      }
+    }
+    return Status::OK();
+  }
+
+  bool transpose = hwc && to_chw && num_channels > 1;
+  std::vector<float> buf(transpose ? static_cast<size_t>(std::min(kTilePixels, num_pixels) * num_channels) : 0);
+  // Without a change of layout the images of a batch are contiguous pixels, which are processed as a single image
+  if (!transpose) {
+    num_pixels *= num_images;
+    num_images = 1;
+  }
+  for (int64_t n = 0; n < num_images; ++n) {
+    const T *image_src = src + n * image_size;
+    float *image_dst = dst + n * image_size;
+    for (int64_t p0 = 0; p0 < num_pixels; p0 += kTilePixels) {
+      int64_t len = std::min(kTilePixels, num_pixels - p0);
+      // Without a change of layout the tile is computed in place in the output
+      float *tile = transpose ? buf.data() : image_dst + p0 * num_channels;
+      const T *in = image_src + p0 * num_channels;
+      for (int64_t k = 0; k < len * num_channels; ++k) {
+        tile[k] = static_cast<float>(in[k]);
+      }
+      for (size_t i = 0; i < stages.size(); ++i) {
+        ApplyStage(stages[i].kind, a[i].data(), b[i].data(), len, num_channels, tile);
+      }
+      if (transpose) {
+        for (int64_t c = 0; c < num_channels; ++c) {
+          float *plane = image_dst + c * num_pixels + p0;
+          for (int64_t p = 0; p < len; ++p) {
+            plane[p] = tile[p * num_channels + c];
+          }
+        }
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status FusedChainOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> in = inputs;
+  for (const auto &op : ops_) {
+    std::vector<TensorShape> out;
+    RETURN_IF_NOT_OK(op->OutputShape(in, out));
+    in = std::move(out);
+  }
+  outputs = std::move(in);
+  return Status::OK();
+}
+
+Status FusedChainOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  std::vector<DataType> in = inputs;
+  for (const auto &op : ops_) {
+    std::vector<DataType> out;
+    RETURN_IF_NOT_OK(op->OutputType(in, out));
+    in = std::move(out);
+  }
+  outputs = std::move(in);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
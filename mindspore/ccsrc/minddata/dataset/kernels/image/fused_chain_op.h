@@ -0,0 +1,102 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_CHAIN_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_CHAIN_OP_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A chain of TensorOps fused into a single pass over an image or a batch of images. The images are processed
+///     a tile of pixels at a time: a tile is converted to float32, then each stage of the chain is applied to it
+///     while it stays in cache, and the tile is written to the output in its final layout. No intermediate tensor is
+///     created. An input the fused kernel does not handle, e.g. of type bool, goes through the ops one by one.
+class FusedChainOp : public TensorOp {
+ public:
+  /// \brief Constructor
+  /// \param[in] ops The ops of the chain in order, each of which is described by the stage of the same index
+  /// \param[in] stages The stages of the ops
+  FusedChainOp(std::vector<std::shared_ptr<TensorOp>> ops, std::vector<FusableStage> stages);
+
+  ~FusedChainOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedChainOp; }
+
+  /// \brief Set the ops of the chain as a Map serializes them, so that the chain is saved unfused
+  /// \param[in] ops_json The serialized ops of the chain in order
+  void SetOpsJson(std::vector<nlohmann::json> ops_json) { ops_json_ = std::move(ops_json); }
+
+  /// \brief Serialize the ops of the chain under "tensor_ops", which a Map saves in place of the fused op
+  Status to_json(nlohmann::json *out_json) override;
+
+  /// \brief Check whether a stage can be appended to a chain
+  /// \param[in] stages The stages of the chain so far
+  /// \param[in] stage The stage to be appended
+  /// \return true if the chain with the stage can be fused
+  static bool CanAppend(const std::vector<FusableStage> &stages, const FusableStage &stage);
+
+  /// \brief Check whether fusing a chain saves anything, i.e. it has more than one stage and computes on the data
+  static bool Worthwhile(const std::vector<FusableStage> &stages);
+
+  /// \brief Compute the stages with the fused kernel, which is also how the ops of a single stage handle a batch
+  /// \param[in] stages The stages to compute in order
+  /// \param[in] input An image of shape <H,W> or <H,W,C>, or a batch of images of shape <...,H,W,C>. The channel is
+  ///     the third to last dimension instead if the stages with a value per channel expect the <C,H,W> layout
+  /// \param[out] output The output of type float32
+  /// \param[out] computed false if the fused kernel does not handle the input, in which case nothing is computed
+  /// \return Status code
+  static Status ComputeStages(const std::vector<FusableStage> &stages, const std::shared_ptr<Tensor> &input,
+                              std::shared_ptr<Tensor> *output, bool *computed);
+
+  /// \brief Number of pixels in a tile, small enough for a tile of 4 channels in float32 to stay in the L1 cache
+  static constexpr int64_t kTilePixels = 1024;
+
+ private:
+  // Run the ops of the chain one by one
+  Status ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  // Expand the parameters of the stages to a value per channel, false if they don't match the number of channels
+  static bool ExpandParams(const std::vector<FusableStage> &stages, int64_t num_channels,
+                           std::vector<std::vector<float>> *a, std::vector<std::vector<float>> *b);
+
+  // The fused kernel for an input of type T, which holds num_images images of num_channels channels each
+  template <typename T>
+  static Status ComputeFused(const std::vector<FusableStage> &stages, const std::shared_ptr<Tensor> &input,
+                             int64_t num_images, int64_t num_channels, const std::vector<std::vector<float>> &a,
+                             const std::vector<std::vector<float>> &b, std::shared_ptr<Tensor> *output);
+
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::vector<FusableStage> stages_;
+  std::vector<nlohmann::json> ops_json_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_CHAIN_OP_H_
@@ -15,6 +15,8 @@
  */
 #include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
 
+#include <algorithm>
+
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/kernels/image/image_utils.h"
 #else
@@ -28,23 +30,39 @@ Status HwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   IO_CHECK(input, output);
   // input.shape == HWC
   // output.shape == CHW
+#ifndef ENABLE_ANDROID
+  if (input->Rank() > kDefaultImageRank) {
+    // input.shape == <..., H, W, C>, a batch of images
+    return BatchHwcToChw(input, output);
+  }
+#endif
   return HwcToChw(input, output);
 }
+bool HwcToChwOp::GetFusableStage(FusableStage *stage) const {
+  if (stage == nullptr) {
+    return false;
+  }
+  stage->kind = FusableStage::Kind::kHwcToChw;
+  return true;
+}
+
 Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
   CHECK_FAIL_RETURN_UNEXPECTED(inputs.size() > 0, "HwcToChwOp::OutputShape inputs size should > 0");
   TensorShape in = inputs[0];
-  TensorShape out = TensorShape{in[2], in[0], in[1]};
-  if (inputs[0].Rank() == 3) {
-    (void)outputs.emplace_back(out);
+  if (in.Rank() >= 3) {
+    // <..., H, W, C> to <..., C, H, W>
+    std::vector<dsize_t> dims = in.AsVector();
+    std::rotate(dims.end() - 3, dims.end() - 1, dims.end());
+    (void)outputs.emplace_back(TensorShape(dims));
   }
   if (!outputs.empty()) {
     return Status::OK();
   }
-  return Status(
-    StatusCode::kMDUnexpectedError,
-    "HWC2CHW: invalid input shape, expected 3D input, but got input dimension is:" + std::to_string(inputs[0].Rank()));
+  return Status(StatusCode::kMDUnexpectedError,
+                "HWC2CHW: invalid input shape, expected at least 3D input, but got input dimension is:" +
+                  std::to_string(inputs[0].Rank()));
 }
 }  // namespace dataset
 }  // namespace mindspore
@@ -32,6 +32,8 @@ class HwcToChwOp : public TensorOp {
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
   std::string Name() const override { return kHwcToChwOp; }
+
+  bool GetFusableStage(FusableStage *stage) const override;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -252,6 +252,101 @@ Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *outp
   return Flip(std::move(input), output, 0);
 }
 
+// Get the number of images of a batch of shape <...,H,W,C> and the size of an image
+static Status GetBatchImageSize(const std::shared_ptr<Tensor> &input, const std::string &op_name,
+                                int64_t *num_images, int64_t *image_size) {
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type().IsNumeric(),
+                               op_name + ": input tensor type should be numeric, but got: " + input->type().ToString());
+  CHECK_FAIL_RETURN_UNEXPECTED(input->Rank() > kDefaultImageRank,
+                               op_name + ": input tensor should be a batch of images of shape <...,H,W,C>, but got: " +
+                                 input->shape().ToString());
+  const TensorShape &shape = input->shape();
+  *image_size = shape[-1] * shape[-2] * shape[-kDefaultImageRank];
+  *num_images = *image_size == 0 ? 0 : input->Size() / *image_size;
+  return Status::OK();
+}
+
+// Reverse the order of the pixels of each row of the images, pixel by pixel of num_channels elements of type T
+template <typename T>
+static void BatchHorizontalFlipImpl(const T *src, const std::vector<bool> &flip, int64_t images_per_sample,
+                                    int64_t num_images, int64_t height, int64_t width, int64_t num_channels, T *dst) {
+  const int64_t row_size = width * num_channels;
+  for (int64_t n = 0; n < num_images; ++n) {
+    const T *image_src = src + n * height * row_size;
+    T *image_dst = dst + n * height * row_size;
+    size_t sample = static_cast<size_t>(n / images_per_sample);
+    if (sample >= flip.size() || !flip[sample]) {
+      std::copy(image_src, image_src + height * row_size, image_dst);
+      continue;
+    }
+    for (int64_t h = 0; h < height; ++h) {
+      const T *row_src = image_src + h * row_size;
+      T *row_dst = image_dst + h * row_size;
+      for (int64_t w = 0; w < width; ++w) {
+        std::copy(row_src + (width - 1 - w) * num_channels, row_src + (width - w) * num_channels,
+                  row_dst + w * num_channels);
+      }
+    }
+  }
+}
+
+// Transpose the images from <H,W,C> to <C,H,W>, element by element of type T
+template <typename T>
+static void BatchHwcToChwImpl(const T *src, int64_t num_images, int64_t num_pixels, int64_t num_channels, T *dst) {
+  const int64_t image_size = num_pixels * num_channels;
+  for (int64_t n = 0; n < num_images; ++n) {
+    const T *image_src = src + n * image_size;
+    T *image_dst = dst + n * image_size;
+    for (int64_t p = 0; p < num_pixels; ++p) {
+      for (int64_t c = 0; c < num_channels; ++c) {
+        image_dst[c * num_pixels + p] = image_src[p * num_channels + c];
+      }
+    }
+  }
+}
+
+Status BatchHorizontalFlip(const std::shared_ptr<Tensor> &input, const std::vector<bool> &flip,
+                           std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  int64_t num_images = 0;
+  int64_t image_size = 0;
+  RETURN_IF_NOT_OK(GetBatchImageSize(input, "HorizontalFlip", &num_images, &image_size));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), input->type(), output));
+  if (num_images == 0) {
+    return Status::OK();
+  }
+  const TensorShape &shape = input->shape();
+  const int64_t height = shape[-kDefaultImageRank];
+  const int64_t width = shape[-2];
+  const int64_t num_channels = shape[-1];
+  const int64_t per_sample = num_images / shape[0];
+  const uint8_t *src = input->GetBuffer();
+  uint8_t *dst = (*output)->GetMutableBuffer();
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(dst);
+  // Only the size of the elements matters to move them
+  switch (input->type().SizeInBytes()) {
+    case sizeof(uint8_t):
+      BatchHorizontalFlipImpl(src, flip, per_sample, num_images, height, width, num_channels, dst);
+      break;
+    case sizeof(uint16_t):
+      BatchHorizontalFlipImpl(reinterpret_cast<const uint16_t *>(src), flip, per_sample, num_images, height, width,
+                              num_channels, reinterpret_cast<uint16_t *>(dst));
+      break;
+    case sizeof(uint32_t):
+      BatchHorizontalFlipImpl(reinterpret_cast<const uint32_t *>(src), flip, per_sample, num_images, height, width,
+                              num_channels, reinterpret_cast<uint32_t *>(dst));
+      break;
+    case sizeof(uint64_t):
+      BatchHorizontalFlipImpl(reinterpret_cast<const uint64_t *>(src), flip, per_sample, num_images, height, width,
+                              num_channels, reinterpret_cast<uint64_t *>(dst));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HorizontalFlip: unsupported input tensor type: " + input->type().ToString());
+  }
+  return Status::OK();
+}
+
 Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t output_height,
               int32_t output_width, double fx, double fy, InterpolationMode mode) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -333,12 +428,13 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input) {
   return input->SizeInBytes() > kPngMagicLen && memcmp(input->GetBuffer(), kPngMagic, kPngMagicLen) == 0;
 }
 
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int target_height,
+              int target_width) {
   RETURN_IF_NOT_OK(CheckUnsupportedImage(input));
 
   Status ret;
   if (IsNonEmptyJPEG(input)) {
-    ret = JpegCropAndDecode(input, output);
+    ret = JpegCropAndDecode(input, output, 0, 0, 0, 0, target_width, target_height);
   } else {
     ret = DecodeCv(input, output);
   }
@@ -514,8 +610,22 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
     STATUS_ERROR(StatusCode::kMDUnexpectedError, "Error raised by libjpeg: " + std::string(jpeg_error_msg)));
 }
 
+int JpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h) {
+  // The scales libjpeg supports in the DCT domain, from the smallest
+  constexpr int kScaleDenoms[] = {8, 4, 2};
+  if (target_w <= 0 || target_h <= 0) {
+    return 1;
+  }
+  for (int denom : kScaleDenoms) {
+    if (crop_w / denom >= target_w && crop_h / denom >= target_h) {
+      return denom;
+    }
+  }
+  return 1;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int target_w, int target_h) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -529,7 +639,6 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
-    jpeg_calc_output_dimensions(&cinfo);
     RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -541,15 +650,34 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
                                "JpegCropAndDecode: addition(crop y and crop height) out of bounds, got crop y:" +
                                  std::to_string(crop_y) + ", and crop height:" + std::to_string(crop_h));
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
-    crop_w = cinfo.output_width;
-    crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+    crop_w = cinfo.image_width;
+    crop_h = cinfo.image_height;
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError(
       "Crop: invalid crop size, corresponding crop value equal to 0 or too big, got crop width: " +
       std::to_string(crop_w) + ", crop height:" + std::to_string(crop_h) +
       ", and crop x coordinate:" + std::to_string(crop_x) + ", crop y coordinate:" + std::to_string(crop_y));
   }
+  const int scale_denom = JpegScaleDenom(crop_w, crop_h, target_w, target_h);
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
+  try {
+    jpeg_calc_output_dimensions(&cinfo);
+    RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
+  } catch (std::runtime_error &e) {
+    return DestroyDecompressAndReturnError(e.what());
+  }
+  if (scale_denom > 1) {
+    // Map the crop to the scaled image, covering all the pixels the crop touches
+    int crop_right = std::min((crop_x + crop_w + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_width));
+    int crop_bottom =
+      std::min((crop_y + crop_h + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_height));
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = crop_right - crop_x;
+    crop_h = crop_bottom - crop_y;
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -717,6 +845,46 @@ Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output)
   }
 }
 
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  int64_t num_images = 0;
+  int64_t image_size = 0;
+  RETURN_IF_NOT_OK(GetBatchImageSize(input, "HWC2CHW", &num_images, &image_size));
+  std::vector<dsize_t> dims = input->shape().AsVector();
+  std::rotate(dims.end() - kDefaultImageRank, dims.end() - 1, dims.end());
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(dims), input->type(), output));
+  if (num_images == 0) {
+    return Status::OK();
+  }
+  const int64_t num_channels = input->shape()[-1];
+  const int64_t num_pixels = image_size / num_channels;
+  const uint8_t *src = input->GetBuffer();
+  uint8_t *dst = (*output)->GetMutableBuffer();
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(dst);
+  // Only the size of the elements matters to move them
+  switch (input->type().SizeInBytes()) {
+    case sizeof(uint8_t):
+      BatchHwcToChwImpl(src, num_images, num_pixels, num_channels, dst);
+      break;
+    case sizeof(uint16_t):
+      BatchHwcToChwImpl(reinterpret_cast<const uint16_t *>(src), num_images, num_pixels, num_channels,
+                        reinterpret_cast<uint16_t *>(dst));
+      break;
+    case sizeof(uint32_t):
+      BatchHwcToChwImpl(reinterpret_cast<const uint32_t *>(src), num_images, num_pixels, num_channels,
+                        reinterpret_cast<uint32_t *>(dst));
+      break;
+    case sizeof(uint64_t):
+      BatchHwcToChwImpl(reinterpret_cast<const uint64_t *>(src), num_images, num_pixels, num_channels,
+                        reinterpret_cast<uint64_t *>(dst));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HWC2CHW: unsupported input tensor type: " + input->type().ToString());
+  }
+  return Status::OK();
+}
+
 Status MaskWithTensor(const std::shared_ptr<Tensor> &sub_mat, std::shared_ptr<Tensor> *input, int x, int y,
                       int crop_width, int crop_height, ImageFormat image_format) {
   constexpr int64_t input_shape = 2;
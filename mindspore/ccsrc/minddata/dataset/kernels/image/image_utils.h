@@ -127,6 +127,14 @@ Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int
 /// The flipping happens in place.
 Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+/// \brief Returns a batch of images of which the selected ones are horizontally flipped, in a single pass
+/// \param input: Tensor of shape <...,H,W,C> and any numeric type, the dimensions before <H,W,C> are the batch
+/// \param flip: whether to flip the images of each sample along the first dimension, the samples beyond its size
+///     are not flipped
+/// \param output: Tensor of the same shape and type as the input
+Status BatchHorizontalFlip(const std::shared_ptr<Tensor> &input, const std::vector<bool> &flip,
+                           std::shared_ptr<Tensor> *output);
+
 /// \brief Returns Vertically flipped image
 /// \param input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \note The flipping happens in place.
@@ -151,7 +159,11 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 /// supported by opencv, if user need more image analysis capabilities, please compile opencv particularlly.
 /// \param input: CVTensor containing the not decoded image 1D bytes
 /// \param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+/// \param target_height: the height the image is resized to afterwards, 0 if unknown. When both the target height
+///     and width are given, a JPEG image is decoded at the smallest scale whose output still covers them
+/// \param target_width: the width the image is resized to afterwards, 0 if unknown
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int target_height = 0,
+              int target_width = 0);
 
 Status DecodeCv(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
@@ -161,8 +173,20 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Returns the denominator of the smallest scale 1/8, 1/4 or 1/2 at which libjpeg can decode a crop while the
+///     decoded crop still covers the target size, or 1 if the crop can only be decoded at full resolution
+/// \param crop_w: width of the crop at full resolution
+/// \param crop_h: height of the crop at full resolution
+/// \param target_w: width the crop is resized to afterwards
+/// \param target_h: height the crop is resized to afterwards
+int JpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h);
+
+/// \brief Decodes a crop of a JPEG image, only the iMCU rows and columns which cover the crop are decoded
+/// \param x, y, w, h: the crop at full resolution, all 0 for the whole image
+/// \param target_w, target_h: the size the crop is resized to afterwards, 0 if unknown. When both are given the crop
+///     is decoded in the DCT domain at the scale returned by JpegScaleDenom, so the output is smaller than the crop
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int target_w = 0, int target_h = 0);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -191,6 +215,11 @@ Status ConvertColor(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor
 /// \param output: Tensor of shape <C,H,W> or <H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+/// \brief Swaps the channels of a batch of images in a single pass, i.e. converts <...,H,W,C> to <...,C,H,W>
+/// \param input: Tensor of shape <...,H,W,C> and any numeric type, the dimensions before <H,W,C> are the batch
+/// \param output: Tensor of shape <...,C,H,W> and same input type.
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
 /// \brief Masks the given part of the input image with a another image (sub_mat)
 /// \param[in] sub_mat The image we want to mask with
 /// \param[in] input The pointer to the image we want to mask
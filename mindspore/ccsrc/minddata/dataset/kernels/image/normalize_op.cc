@@ -20,6 +20,7 @@
 
 #include "minddata/dataset/kernels/data/data_utils.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/fused_chain_op.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #else
 #include "minddata/dataset/kernels/image/lite_image_utils.h"
@@ -47,6 +48,17 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
     return Normalize(input, output, mean_, std_);
 #endif
   } else {
+#ifndef ENABLE_ANDROID
+    // normalize the whole batch in a single pass over its contiguous pixels
+    FusableStage stage;
+    bool computed = false;
+    if (GetFusableStage(&stage)) {
+      RETURN_IF_NOT_OK(FusedChainOp::ComputeStages({stage}, input, output, &computed));
+    }
+    if (computed) {
+      return Status::OK();
+    }
+#endif
     // reshape [..., H, W, C] to [N, H, W, C]
     dsize_t num_batch = input->Size() / (input_shape[-3] * input_shape[-2] * input_shape[-1]);
     TensorShape new_shape({num_batch, input_shape[-3], input_shape[-2], input_shape[-1]});
@@ -71,6 +83,17 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   }
 }
 
+bool NormalizeOp::GetFusableStage(FusableStage *stage) const {
+  if (stage == nullptr || mean_.empty() || mean_.size() != std_.size()) {
+    return false;
+  }
+  stage->kind = FusableStage::Kind::kNormalize;
+  stage->a = mean_;
+  stage->b = std_;
+  stage->is_hwc = is_hwc_;
+  return true;
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: ";
   for (const auto &m : mean_) {
@@ -38,6 +38,8 @@ class NormalizeOp : public TensorOp {
 
   std::string Name() const override { return kNormalizeOp; }
 
+  bool GetFusableStage(FusableStage *stage) const override;
+
  private:
   std::vector<float> mean_;
   std::vector<float> std_;
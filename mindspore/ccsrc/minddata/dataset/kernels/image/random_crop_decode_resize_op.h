@@ -35,7 +35,7 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
                            InterpolationMode interpolation = kDefInterpolation, int32_t max_attempts = kDefMaxIter);
 
-  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs) : RandomCropAndResizeOp(rhs) {}
+  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs);
 
   ~RandomCropDecodeResizeOp() override = default;
 
@@ -46,6 +46,10 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+ private:
+  // Whether a JPEG crop is decoded at the smallest scale which still covers the target size
+  bool scaled_decode_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,7 +15,9 @@
  */
 #include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 
-#include "minddata/dataset/kernels/data/data_utils.h"
+#include <algorithm>
+#include <vector>
+
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -32,35 +34,35 @@ Status RandomHorizontalFlipOp::Compute(const TensorRow &input, TensorRow *output
     RETURN_IF_NOT_OK(ValidateImage(image, "RandomHorizontalFlip", {1, 2, 3, 4, 5, 6, 10, 11, 12}));
   }
 
-  if (distribution_(rnd_)) {
-    for (dsize_t i = 0; i < output_count; ++i) {
-      auto input_shape = input[i]->shape();
-      dsize_t rank = input_shape.Rank();
-      if (rank <= kDefaultImageRank) {
-        // [H, W] or [H, W, C]
-        RETURN_IF_NOT_OK(HorizontalFlip(input[i], &(*output)[i]));
-      } else {
-        // reshape [..., H, W, C] to [N, H, W, C]
-        dsize_t num_batch = input[i]->Size() / (input_shape[-3] * input_shape[-2] * input_shape[-1]);
-        TensorShape new_shape({num_batch, input_shape[-3], input_shape[-2], input_shape[-1]});
-        RETURN_IF_NOT_OK(input[i]->Reshape(new_shape));
-
-        // split [N, H, W, C] to N [H, W, C], and flip N [H, W, C]
-        std::vector<std::shared_ptr<Tensor>> input_vector_hwc, output_vector_hwc;
-        RETURN_IF_NOT_OK(BatchTensorToTensorVector(input[i], &input_vector_hwc));
-        for (auto input_hwc : input_vector_hwc) {
-          std::shared_ptr<Tensor> flip;
-          RETURN_IF_NOT_OK(HorizontalFlip(input_hwc, &flip));
-          output_vector_hwc.push_back(flip);
-        }
-        // integrate N [H, W, C] to [N, H, W, C], and reshape [..., H, W, C]
-        RETURN_IF_NOT_OK(TensorVectorToBatchTensor(output_vector_hwc, &(*output)[i]));
-        RETURN_IF_NOT_OK((*output)[i]->Reshape(input_shape));
+  // In batch mode each sample along the first dimension is flipped with its own chance, otherwise all or none
+  size_t num_samples = 1;
+  if (batch_mode_) {
+    for (const auto &image : input) {
+      if (image->Rank() > kDefaultImageRank) {
+        num_samples = std::max(num_samples, static_cast<size_t>(image->shape()[0]));
       }
     }
-    return Status::OK();
   }
-  *output = input;
+  std::vector<bool> flip(num_samples);
+  for (size_t n = 0; n < num_samples; ++n) {
+    flip[n] = distribution_(rnd_);
+  }
+
+  for (dsize_t i = 0; i < output_count; ++i) {
+    const bool batched = input[i]->Rank() > kDefaultImageRank;
+    if (batched && batch_mode_) {
+      // [N, ..., H, W, C], each sample flipped or copied in a single pass
+      RETURN_IF_NOT_OK(BatchHorizontalFlip(input[i], flip, &(*output)[i]));
+    } else if (!flip[0]) {
+      (*output)[i] = input[i];
+    } else if (batched) {
+      // [..., H, W, C], flipped as a whole in a single pass
+      RETURN_IF_NOT_OK(BatchHorizontalFlip(input[i], std::vector<bool>(input[i]->shape()[0], true), &(*output)[i]));
+    } else {
+      // [H, W] or [H, W, C]
+      RETURN_IF_NOT_OK(HorizontalFlip(input[i], &(*output)[i]));
+    }
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -53,9 +53,15 @@ class RandomHorizontalFlipOp : public TensorOp {
 
   uint32_t NumOutput() override { return 1; }
 
+  /// \brief Set whether the input is a batch made by a batch operation. In batch mode, each sample along the first
+  ///     dimension of an input of shape <..., H, W, C> is flipped with its own chance, otherwise the whole input is.
+  /// \param[in] batch_mode Whether the input is a batch
+  void SetBatchMode(bool batch_mode) { batch_mode_ = batch_mode; }
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
+  bool batch_mode_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/kernels/image/rescale_op.h"
 
+#include "minddata/dataset/kernels/image/fused_chain_op.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -22,8 +23,28 @@ namespace mindspore {
 namespace dataset {
 Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
+  if (input->Rank() > kDefaultImageRank) {
+    // rescale a batch of images [..., H, W, C] in a single pass over its contiguous pixels
+    FusableStage stage;
+    bool computed = false;
+    (void)GetFusableStage(&stage);
+    RETURN_IF_NOT_OK(FusedChainOp::ComputeStages({stage}, input, output, &computed));
+    if (computed) {
+      return Status::OK();
+    }
+  }
   return Rescale(input, output, rescale_, shift_);
 }
+bool RescaleOp::GetFusableStage(FusableStage *stage) const {
+  if (stage == nullptr) {
+    return false;
+  }
+  stage->kind = FusableStage::Kind::kScaleShift;
+  stage->a = {rescale_};
+  stage->b = {shift_};
+  return true;
+}
+
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = DataType(DataType::DE_FLOAT32);
@@ -41,6 +41,8 @@ class RescaleOp : public TensorOp {
 
   std::string Name() const override { return kRescaleOp; }
 
+  bool GetFusableStage(FusableStage *stage) const override;
+
  private:
   float rescale_;
   float shift_;
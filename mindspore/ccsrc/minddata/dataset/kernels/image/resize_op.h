@@ -58,6 +58,15 @@ class ResizeOp : public TensorOp {
 
   std::string Name() const override { return kResizeOp; }
 
+  // Get the size the output is at least, which is the output size if two values are provided, and the size of the
+  // smaller dimension on both dimensions if only one is provided
+  // @param height: the min height of the output
+  // @param width: the min width of the output
+  void GetMinOutputSize(int32_t *height, int32_t *width) const {
+    *height = size1_;
+    *width = size2_ > 0 ? size2_ : size1_;
+  }
+
  protected:
   int32_t size1_;
   int32_t size2_;
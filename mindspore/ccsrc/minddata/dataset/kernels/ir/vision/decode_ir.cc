@@ -32,7 +32,11 @@ std::string DecodeOperation::Name() const { return kDecodeOperation; }
 
 Status DecodeOperation::ValidateParams() { return Status::OK(); }
 
-std::shared_ptr<TensorOp> DecodeOperation::Build() { return std::make_shared<DecodeOp>(rgb_); }
+std::shared_ptr<TensorOp> DecodeOperation::Build() {
+  auto tensor_op = std::make_shared<DecodeOp>(rgb_);
+  tensor_op->SetTargetSize(target_height_, target_width_);
+  return tensor_op;
+}
 
 Status DecodeOperation::to_json(nlohmann::json *out_json) {
   (*out_json)["rgb"] = rgb_;
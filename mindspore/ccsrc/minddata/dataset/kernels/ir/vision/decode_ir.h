@@ -49,8 +49,19 @@ class DecodeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  /// \brief Tell the size the decoded images are resized to afterwards, which is passed to the DecodeOp built. It is
+  ///     set by the optimizer pass and not serialized, as the pass sets it again for the pipeline loaded.
+  /// \param[in] target_height The height the images are resized to, 0 if unknown
+  /// \param[in] target_width The width the images are resized to, 0 if unknown
+  void SetTargetSize(int32_t target_height, int32_t target_width) {
+    target_height_ = target_height;
+    target_width_ = target_width;
+  }
+
  private:
   bool rgb_;
+  int32_t target_height_ = 0;
+  int32_t target_width_ = 0;
 };
 
 }  // namespace vision
@@ -40,6 +40,7 @@ Status RandomHorizontalFlipOperation::ValidateParams() {
 
 std::shared_ptr<TensorOp> RandomHorizontalFlipOperation::Build() {
   std::shared_ptr<RandomHorizontalFlipOp> tensor_op = std::make_shared<RandomHorizontalFlipOp>(probability_);
+  tensor_op->SetBatchMode(batch_mode_);
   return tensor_op;
 }
 
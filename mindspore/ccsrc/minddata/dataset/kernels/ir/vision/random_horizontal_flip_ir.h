@@ -1,5 +1,5 @@
 /**
- * Copyright 2020-2022 Huawei Technologies Co., Ltd
+ * Copyright 2020-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -49,8 +49,13 @@ class RandomHorizontalFlipOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  /// \brief Set whether the op runs right after a batch operation, where each sample of a batch is flipped with its
+  ///     own chance. It is set by TensorOpSetupPass from the pipeline, so it is not serialized.
+  void SetBatchMode(bool batch_mode) { batch_mode_ = batch_mode; }
+
  private:
   float probability_;
+  bool batch_mode_ = false;
 };
 
 }  // namespace vision
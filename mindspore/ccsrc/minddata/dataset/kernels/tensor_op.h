@@ -228,10 +228,28 @@ constexpr char kUniqueOp[] = "UniqueOp";
 
 // other
 constexpr char kCFuncOp[] = "CFuncOp";
+constexpr char kFusedChainOp[] = "FusedChainOp";
 constexpr char kPyFuncOp[] = "PyFuncOp";
 constexpr char kPluginOp[] = "PluginOp";
 constexpr char kNoOp[] = "NoOp";
 
+// The computation of a TensorOp which can be fused with the ops next to it in a MapOp, so that a chain of such ops
+// is computed in a single pass over the data instead of producing a full tensor after each op. See FusedChainOp.
+struct FusableStage {
+  enum class Kind {
+    kCastToFloat,  // convert to float32
+    kScaleShift,   // out = in * a + b, and the output is float32
+    kNormalize,    // out = (in - a) / b, and the output is float32
+    kHwcToChw      // change the layout of an image from <H,W,C> to <C,H,W>
+  };
+  Kind kind = Kind::kCastToFloat;
+  // parameters of the stage, either a single value or a value per channel
+  std::vector<float> a;
+  std::vector<float> b;
+  // whether the channel is the last dimension of the image, for the stages with a value per channel
+  bool is_hwc = true;
+};
+
 // A class that does a computation on a Tensor
 class TensorOp {
  public:
@@ -307,6 +325,12 @@ class TensorOp {
 
   virtual Status SetAscendResource(const std::shared_ptr<DeviceResource> &resource);
 
+  // Function to describe the computation of the TensorOp as a stage which can be fused with its neighbours.
+  // If a subclass did not override this function, it means that the TensorOp can not be fused.
+  // @param stage out: the stage to be filled.
+  // @return true if the TensorOp can be fused
+  virtual bool GetFusableStage(FusableStage *stage) const { return false; }
+
  protected:
   bool is_deterministic_{true};
 };
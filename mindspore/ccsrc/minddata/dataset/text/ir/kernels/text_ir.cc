@@ -638,12 +638,13 @@ std::shared_ptr<TensorOp> UnicodeCharTokenizerOperation::Build() {
 WordpieceTokenizerOperation::WordpieceTokenizerOperation(const std::shared_ptr<Vocab> &vocab,
                                                          const std::string &suffix_indicator,
                                                          int32_t max_bytes_per_token, const std::string &unknown_token,
-                                                         bool with_offsets)
+                                                         bool with_offsets, bool output_ids)
     : vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
+      with_offsets_(with_offsets),
+      output_ids_(output_ids) {}
 
 Status WordpieceTokenizerOperation::ValidateParams() {
   if (vocab_ == nullptr) {
@@ -656,12 +657,17 @@ Status WordpieceTokenizerOperation::ValidateParams() {
       std::to_string(max_bytes_per_token_);
     LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
+  if (output_ids_ && vocab_->TokensToIds(unknown_token_) == Vocab::kNoTokenExists) {
+    std::string err_msg = "WordpieceTokenizer: the parameter unknown_token must be a word of the vocab when output_ids "
+                          "is true, but got: " + unknown_token_;
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
   return Status::OK();
 }
 
 std::shared_ptr<TensorOp> WordpieceTokenizerOperation::Build() {
   std::shared_ptr<WordpieceTokenizerOp> tensor_op = std::make_shared<WordpieceTokenizerOp>(
-    vocab_, suffix_indicator_, max_bytes_per_token_, unknown_token_, with_offsets_);
+    vocab_, suffix_indicator_, max_bytes_per_token_, unknown_token_, with_offsets_, output_ids_);
   return tensor_op;
 }
 
@@ -408,7 +408,7 @@ class WordpieceTokenizerOperation : public TensorOperation {
  public:
   explicit WordpieceTokenizerOperation(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                        int32_t max_bytes_per_token, const std::string &unknown_token,
-                                       bool with_offsets);
+                                       bool with_offsets, bool output_ids);
 
   ~WordpieceTokenizerOperation() = default;
 
@@ -424,6 +424,7 @@ class WordpieceTokenizerOperation : public TensorOperation {
   int32_t max_bytes_per_token_;
   std::string unknown_token_;
   bool with_offsets_;
+  bool output_ids_;
 };
 
 #ifndef _WIN32
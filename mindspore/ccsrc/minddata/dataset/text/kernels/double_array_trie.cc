@@ -0,0 +1,119 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/kernels/double_array_trie.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+Status DoubleArrayTrie::Build(const std::unordered_map<std::string, int32_t> &keys) {
+  std::vector<std::pair<std::string, int32_t>> sorted_keys;
+  sorted_keys.reserve(keys.size());
+  for (const auto &[key, value] : keys) {
+    CHECK_FAIL_RETURN_UNEXPECTED(value >= 0, "DoubleArrayTrie: the value of key: " + key + " is negative.");
+    sorted_keys.emplace_back(key, value);
+  }
+  // std::string compares the bytes as unsigned char, so the keys sharing a prefix are next to each other in the order
+  // of the byte after the prefix
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+
+  base_.assign(1, 0);
+  check_.assign(1, kNoValue);
+  value_.assign(1, kNoValue);
+  first_free_ = 1;
+  // Each entry is a state and the range of the keys under it, which share the first depth bytes
+  std::vector<std::tuple<int32_t, size_t, size_t, size_t>> pending = {{kRoot, 0, sorted_keys.size(), 0}};
+  std::vector<uint8_t> labels;
+  std::vector<size_t> starts;
+  while (!pending.empty()) {
+    auto [state, begin, end, depth] = pending.back();
+    pending.pop_back();
+    if (begin < end && sorted_keys[begin].first.size() == depth) {
+      value_[state] = sorted_keys[begin].second;
+      ++begin;
+    }
+    if (begin == end) {
+      continue;
+    }
+    labels.clear();
+    starts.clear();
+    for (size_t i = begin; i < end; ++i) {
+      auto label = static_cast<uint8_t>(sorted_keys[i].first[depth]);
+      if (labels.empty() || labels.back() != label) {
+        labels.push_back(label);
+        starts.push_back(i);
+      }
+    }
+    starts.push_back(end);
+    int32_t base = FindBase(labels);
+    CHECK_FAIL_RETURN_UNEXPECTED(base >= 0, "DoubleArrayTrie: too many keys to build the trie.");
+    base_[state] = base;
+    for (size_t i = 0; i < labels.size(); ++i) {
+      size_t child = static_cast<size_t>(base) + labels[i] + 1;
+      check_[child] = state;
+      pending.emplace_back(static_cast<int32_t>(child), starts[i], starts[i + 1], depth + 1);
+    }
+    while (first_free_ < check_.size() && check_[first_free_] != kNoValue) {
+      ++first_free_;
+    }
+  }
+  return Status::OK();
+}
+
+void DoubleArrayTrie::Walk(int32_t *state, const std::string &str) const {
+  for (char c : str) {
+    if (*state == kNoValue) {
+      return;
+    }
+    if (!Next(state, static_cast<uint8_t>(c))) {
+      *state = kNoValue;
+    }
+  }
+}
+
+int32_t DoubleArrayTrie::FindBase(const std::vector<uint8_t> &labels) {
+  size_t base = first_free_ > labels[0] ? first_free_ - labels[0] - 1 : 0;
+  for (;; ++base) {
+    bool free = std::all_of(labels.begin(), labels.end(), [this, base](uint8_t label) {
+      size_t pos = base + label + 1;
+      return pos >= check_.size() || check_[pos] == kNoValue;
+    });
+    if (free) {
+      break;
+    }
+  }
+  if (base + labels.back() + 1 > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return kNoValue;
+  }
+  Reserve(base + labels.back() + 1);
+  return static_cast<int32_t>(base);
+}
+
+void DoubleArrayTrie::Reserve(size_t pos) {
+  if (pos < check_.size()) {
+    return;
+  }
+  // Grow by half at least, so that the arrays are not copied for each state
+  size_t size = std::max(pos + 1, check_.size() + check_.size() / 2);
+  base_.resize(size, 0);
+  check_.resize(size, kNoValue);
+  value_.resize(size, kNoValue);
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_DOUBLE_ARRAY_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_DOUBLE_ARRAY_TRIE_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \brief A trie of byte strings kept in two arrays. The child of state s by byte c is t = base[s] + c + 1 when
+///     check[t] == s, so a key is matched with one array access per byte and without any allocation.
+class DoubleArrayTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNoValue = -1;
+
+  DoubleArrayTrie() = default;
+
+  ~DoubleArrayTrie() = default;
+
+  /// \brief Build the trie of the keys, replacing any keys built before.
+  /// \param[in] keys The keys and their values, the values must not be negative.
+  /// \return Status code.
+  Status Build(const std::unordered_map<std::string, int32_t> &keys);
+
+  /// \brief Move a state to its child by a byte.
+  /// \param[in, out] state The state to move, unchanged if it has no child by the byte.
+  /// \param[in] c The byte.
+  /// \return Whether the state has a child by the byte.
+  bool Next(int32_t *state, uint8_t c) const {
+    auto next = static_cast<int64_t>(base_[*state]) + c + 1;
+    if (next >= static_cast<int64_t>(check_.size()) || check_[next] != *state) {
+      return false;
+    }
+    *state = static_cast<int32_t>(next);
+    return true;
+  }
+
+  /// \brief Move a state along the bytes of a string.
+  /// \param[in, out] state The state to move, kNoValue if the string leaves the trie.
+  /// \param[in] str The string.
+  void Walk(int32_t *state, const std::string &str) const;
+
+  /// \return The value of the key ending at the state, kNoValue if no key ends there.
+  int32_t Value(int32_t state) const { return value_[state]; }
+
+  /// \return The number of states, including the unused ones.
+  size_t Size() const { return check_.size(); }
+
+ private:
+  // Find a base for the children of a state, so that base + label + 1 is free for each of the labels
+  int32_t FindBase(const std::vector<uint8_t> &labels);
+
+  // Make sure the arrays have the position
+  void Reserve(size_t pos);
+
+  std::vector<int32_t> base_ = {0};
+  std::vector<int32_t> check_ = {kNoValue};  // kNoValue marks a free position
+  std::vector<int32_t> value_ = {kNoValue};
+  size_t first_free_ = 1;  // No position before it is free, to start the search for a base
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_DOUBLE_ARRAY_TRIE_H_
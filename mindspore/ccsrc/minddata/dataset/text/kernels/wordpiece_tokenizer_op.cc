@@ -25,73 +25,106 @@ namespace dataset {
 const char WordpieceTokenizerOp::kDefSuffixIndicator[] = "##";
 const int WordpieceTokenizerOp::kDefMaxBytesPerToken = 100;
 const char WordpieceTokenizerOp::kDefUnknownToken[] = "[UNK]";
+const bool WordpieceTokenizerOp::kDefOutputIds = false;
 
 WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                            const int &max_bytes_per_token, const std::string &unknown_token,
-                                           const bool &with_offsets)
+                                           const bool &with_offsets, const bool &output_ids)
     : TokenizerOp(with_offsets),
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
+      unknown_token_(unknown_token),
+      output_ids_(output_ids),
+      unknown_id_(Vocab::kNoTokenExists),
+      suffix_state_(DoubleArrayTrie::kNoValue) {
+  if (vocab_ == nullptr) {
+    trie_status_ = STATUS_ERROR(StatusCode::kMDUnexpectedError, "WordpieceTokenizer: vocab can not be null.");
+    return;
+  }
+  trie_status_ = trie_.Build(vocab_->GetVocab());
+  suffix_state_ = DoubleArrayTrie::kRoot;
+  trie_.Walk(&suffix_state_, suffix_indicator_);
+  unknown_id_ = vocab_->TokensToIds(unknown_token_);
+  if (output_ids_ && unknown_id_ == Vocab::kNoTokenExists && trie_status_.IsOk()) {
+    trie_status_ = STATUS_ERROR(StatusCode::kMDUnexpectedError, "WordpieceTokenizer: unknown_token: " +
+                                                                  unknown_token_ + " must be a word of the vocab.");
+  }
+}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(const std::string_view &input_token, const RuneStrArray &runes,
+                                        const int start, bool *out_found, int *out_end, WordIdType *out_id) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
+  int32_t state = start > 0 ? suffix_state_ : DoubleArrayTrie::kRoot;
+  if (state == DoubleArrayTrie::kNoValue) {
+    return Status::OK();
+  }
+  // the runes ending after start, the word found must end at the end of one of them
+  auto rune = std::upper_bound(runes.begin(), runes.end(), static_cast<uint32_t>(start),
+                               [](uint32_t pos, const cppjieba::RuneStr &r) { return pos < r.offset + r.len; });
+  int pos = start;
+  for (; rune != runes.end(); ++rune) {
+    int rune_end = static_cast<int>(rune->offset + rune->len);
+    for (; pos < rune_end; ++pos) {
+      if (!trie_.Next(&state, static_cast<uint8_t>(input_token[pos]))) {
+        return Status::OK();
+      }
     }
-    if (vocab_->TokensToIds(word) != Vocab::kNoTokenExists) {
+    WordIdType id = trie_.Value(state);
+    if (id != DoubleArrayTrie::kNoValue) {
       *out_found = true;
-      break;
+      *out_end = rune_end;
+      *out_id = id;
     }
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
-                                          std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
-                                          std::vector<uint32_t> *offsets_limit) const {
-  out_tokens->clear();
-  offsets_start->push_back(basic_start);
-  if (unknown_token_.empty()) {
-    (void)out_tokens->emplace_back(input_token);
-    offsets_limit->push_back(basic_start + input_token.length());
+Status WordpieceTokenizerOp::FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
+                                          TokenBuffer *out) const {
+  out->offsets_start.push_back(basic_start);
+  if (output_ids_) {
+    out->ids.push_back(unknown_id_);
+  } else if (unknown_token_.empty()) {
+    (void)out->tokens.emplace_back(input_token);
   } else {
-    (void)out_tokens->emplace_back(unknown_token_);
-    offsets_limit->push_back(basic_start + input_token.length());
+    (void)out->tokens.emplace_back(unknown_token_);
   }
+  out->offsets_limit.push_back(basic_start + input_token.length());
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
-                                        std::vector<std::string> *out_tokens) const {
+Status WordpieceTokenizerOp::AddSubword(const std::string_view &input_token, const int &start, const int &end,
+                                        const WordIdType &id, TokenBuffer *out) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= static_cast<int>(input_token.size()),
                                "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  if (output_ids_) {
+    out->ids.push_back(id);
+    return Status::OK();
+  }
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword = suffix_indicator_;
   }
-  (void)out_tokens->emplace_back(subword);
+  (void)subword.append(input_token.substr(start, end - start));
+  (void)out->tokens.emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
-                                       std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
-                                       std::vector<uint32_t> *offsets_limit) const {
+Status WordpieceTokenizerOp::GetTokens(const std::string_view &input_token, const uint32_t &basic_start,
+                                       TokenBuffer *out) const {
   if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
-    offsets_start->push_back(basic_start);
-    if (!unknown_token_.empty()) {
-      offsets_limit->push_back(basic_start + unknown_token_.size());
-      (void)out_tokens->emplace_back(unknown_token_);
+    out->offsets_start.push_back(basic_start);
+    if (output_ids_) {
+      out->ids.push_back(unknown_id_);
+      out->offsets_limit.push_back(basic_start + unknown_token_.size());
+    } else if (!unknown_token_.empty()) {
+      out->offsets_limit.push_back(basic_start + unknown_token_.size());
+      (void)out->tokens.emplace_back(unknown_token_);
     } else {
-      (void)out_tokens->emplace_back(input_token);
-      offsets_limit->push_back(basic_start + input_token.size());
+      (void)out->tokens.emplace_back(input_token);
+      out->offsets_limit.push_back(basic_start + input_token.size());
     }
     return Status::OK();
   }
@@ -99,17 +132,28 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
   }
+  // the subwords of a word are dropped if a part of the word is not found
+  size_t num_tokens = output_ids_ ? out->ids.size() : out->tokens.size();
+  size_t num_offsets = out->offsets_start.size();
   int end = 0;
+  WordIdType id = Vocab::kNoTokenExists;
   for (int start = 0; start < static_cast<int>(input_token.size());) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end, &id));
     if (found) {
-      RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
-      offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
-      offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
+      RETURN_IF_NOT_OK(AddSubword(input_token, start, end, id, out));
+      out->offsets_start.push_back(static_cast<uint32_t>(basic_start + start));
+      out->offsets_limit.push_back(static_cast<uint32_t>(basic_start + end));
       start = end;
     } else {
-      return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+      if (output_ids_) {
+        out->ids.resize(num_tokens);
+      } else {
+        out->tokens.resize(num_tokens);
+      }
+      out->offsets_start.resize(num_offsets);
+      out->offsets_limit.resize(num_offsets);
+      return FoundNoToken(input_token, basic_start, out);
     }
   }
   return Status::OK();
@@ -117,33 +161,40 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
 
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  RETURN_IF_NOT_OK(trie_status_);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED(
       "WordpieceTokenizer: The input shape should be 1D scalar the input datatype should be string.");
   }
   dsize_t count = 0;
-  std::vector<std::string> out_tokens;
-  std::vector<uint32_t> offsets_start, offsets_limit;
+  TokenBuffer out;
   std::shared_ptr<Tensor> token_tensor;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &out));
     count++;
   }
-  if (out_tokens.empty()) {
-    (void)out_tokens.emplace_back("");
-    offsets_start.push_back(0);
-    offsets_limit.push_back(0);
+  if (out.offsets_start.empty()) {
+    if (output_ids_) {
+      WordIdType id = vocab_->TokensToIds("");
+      out.ids.push_back(id == Vocab::kNoTokenExists ? unknown_id_ : id);
+    } else {
+      (void)out.tokens.emplace_back("");
+    }
+    out.offsets_start.push_back(0);
+    out.offsets_limit.push_back(0);
+  }
+  if (output_ids_) {
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.ids, &token_tensor));
+  } else {
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.tokens, &token_tensor));
   }
-  RETURN_IF_NOT_OK(Tensor::CreateFromVector(out_tokens, &token_tensor));
   output->push_back(token_tensor);
   if (with_offsets_) {
-    RETURN_IF_NOT_OK(AppendOffsetsHelper(offsets_start, offsets_limit, output));
+    RETURN_IF_NOT_OK(AppendOffsetsHelper(out.offsets_start, out.offsets_limit, output));
   }
   return Status::OK();
 }
@@ -25,6 +25,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/include/dataset/text.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/kernels/double_array_trie.h"
 #include "minddata/dataset/text/kernels/tokenizer_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -38,23 +39,33 @@ class WordpieceTokenizerOp : public TokenizerOp {
   static const char kDefSuffixIndicator[];
   static const int kDefMaxBytesPerToken;
   static const char kDefUnknownToken[];
+  static const bool kDefOutputIds;
   WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator = kDefSuffixIndicator,
                        const int &max_bytes_per_token = kDefMaxBytesPerToken,
-                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets);
+                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets,
+                       const bool &output_ids = kDefOutputIds);
 
   ~WordpieceTokenizerOp() override = default;
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
-                    std::vector<std::string> *out_tokens) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                   std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  // The tokens of the words split so far, as strings or as ids of the vocab, and their offsets
+  struct TokenBuffer {
+    std::vector<std::string> tokens;
+    std::vector<WordIdType> ids;
+    std::vector<uint32_t> offsets_start;
+    std::vector<uint32_t> offsets_limit;
+  };
+
+  Status AddSubword(const std::string_view &input_token, const int &start, const int &end, const WordIdType &id,
+                    TokenBuffer *out) const;
+  Status FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start, TokenBuffer *out) const;
+  // Find the longest word of the vocab starting at a byte of the token and ending at the end of a rune of it, with a
+  // single pass of the trie over the bytes of the token
+  Status LookupWord(const std::string_view &input_token, const RuneStrArray &runes, const int start, bool *out_found,
+                    int *out_end, WordIdType *out_id) const;
+  Status GetTokens(const std::string_view &input_token, const uint32_t &basic_start, TokenBuffer *out) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -63,6 +74,11 @@ class WordpieceTokenizerOp : public TokenizerOp {
   const std::string suffix_indicator_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  const bool output_ids_;
+  WordIdType unknown_id_;
+  DoubleArrayTrie trie_;  // Trie of the words of the vocab, built once when the op is created
+  int32_t suffix_state_;  // State of the trie after the suffix indicator, DoubleArrayTrie::kNoValue if no word has it
+  Status trie_status_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -144,6 +144,15 @@ void CircularPool::Deallocate(void *p) {
   it->get()->Deallocate(p);
 }
 
+bool CircularPool::Owns(const void *p) {
+  SharedLock lock(&rw_lock_);
+  auto *q = reinterpret_cast<const char *>(p);
+  return std::any_of(mem_segments_.begin(), mem_segments_.end(), [this, q](const std::shared_ptr<Arena> &b) -> bool {
+    auto *base = reinterpret_cast<const char *>(b->get_base_addr());
+    return (q > base && q < base + arena_size_ * 1048576L);
+  });
+}
+
 Status CircularPool::Reallocate(void **pp, size_t old_sz, size_t new_sz) {
   // Lock in the chain in shared mode and find out which
   // segment it comes from
@@ -1,5 +1,5 @@
 /**
- * Copyright 2019 Huawei Technologies Co., Ltd
+ * Copyright 2019-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -73,6 +73,9 @@ class CircularPool : public MemoryPool {
 
   void Deallocate(void *) override;
 
+  // Check if a block of memory comes from one of the arenas of this pool
+  bool Owns(const void *p);
+
   uint64_t get_max_size() const override;
 
   int PercentFree() const override;
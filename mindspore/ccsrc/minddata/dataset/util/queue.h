@@ -35,6 +35,8 @@
 namespace mindspore {
 namespace dataset {
 // A simple thread safe queue using a fixed size array
+// Unlike the RingQueue of a Connector, it takes several producers and consumers and is resized by AutoTune, so it
+// stays on a mutex, and so do OperatorConnector and QueueList. Moving them to a lock-free ring is a follow-up.
 template <typename T>
 class Queue {
  public:
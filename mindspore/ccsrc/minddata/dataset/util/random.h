@@ -28,6 +28,7 @@
 #include <random>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/global_context.h"
@@ -64,14 +65,78 @@ inline uint32_t GetNewSeed() {
   return distribution(random_device);
 }
 
+// Logs the seeds GetSeed() gives on this thread while it is in scope. The seeds already in the log are given again
+// in their order before any new seed, so the random TensorOps built with a saved log draw the same numbers.
+class SeedLog {
+ public:
+  explicit SeedLog(std::vector<uint32_t> *seeds) : seeds_(seeds), position_(0), outer_(Current()) { Current() = this; }
+
+  ~SeedLog() { Current() = outer_; }
+
+  SeedLog(const SeedLog &) = delete;
+
+  SeedLog &operator=(const SeedLog &) = delete;
+
+  static SeedLog *&Current() {
+    static thread_local SeedLog *current = nullptr;
+    return current;
+  }
+
+  uint32_t Log(uint32_t seed) {
+    if (position_ < seeds_->size()) {
+      return (*seeds_)[position_++];
+    }
+    seeds_->push_back(seed);
+    ++position_;
+    return seed;
+  }
+
+ private:
+  std::vector<uint32_t> *seeds_;
+  size_t position_;
+  SeedLog *outer_;
+};
+
 inline uint32_t GetSeed() {
   uint32_t seed = GlobalContext::config_manager()->seed();
   if (seed == std::mt19937::default_seed) {
     seed = GetNewSeed();
   }
-  return seed;
+  SeedLog *seed_log = SeedLog::Current();
+  return seed_log == nullptr ? seed : seed_log->Log(seed);
 }
 
+// A counter-based random number generator: the n-th number of a stream is a hash of the key, the index of the stream
+// and n, so there is no state shared between the streams of a key. A task split across threads gives each part of it
+// its own stream, and draws the same numbers whichever thread runs which part.
+class CounterBasedRandom {
+ public:
+  using result_type = uint32_t;
+
+  CounterBasedRandom(uint64_t key, uint64_t stream) : key_(Mix(key ^ Mix(stream + kIncrement))), counter_(0) {}
+
+  static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() {
+    constexpr int kHighBits = 32;
+    return static_cast<result_type>(Mix(key_ + (++counter_) * kIncrement) >> kHighBits);
+  }
+
+ private:
+  // The finalizer of SplitMix64
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  static constexpr uint64_t kIncrement = 0x9e3779b97f4a7c15ULL;
+  uint64_t key_;
+  uint64_t counter_;
+};
+
 }  // namespace dataset
 }  // namespace mindspore
 
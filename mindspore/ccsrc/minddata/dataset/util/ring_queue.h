@@ -0,0 +1,253 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A bounded lock-free ring buffer for exactly one producer and one consumer at a time. Several consumer
+///     threads may take turns as long as they are serialized by the caller, e.g. under the lock of a Connector.
+///     An element is handed over through a pair of atomic indices instead of a mutex. A side which finds the ring
+///     full or empty spins for a while, then parks on a CondVar, and the other side only takes the lock to wake it
+///     up when it has parked. The spin count adapts to how often spinning is enough.
+template <typename T>
+class RingQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_reference = const T &;
+
+  explicit RingQueue(int32_t capacity)
+      : sz_(static_cast<uint64_t>(std::max(capacity, 1))),
+        slots_(sz_),
+        my_name_(Services::GetUniqueID()),
+        head_(0),
+        cached_tail_(0),
+        consumer_spin_(kInitSpin),
+        tail_(0),
+        cached_head_(0),
+        producer_spin_(kInitSpin),
+        consumer_parked_(false),
+        producer_parked_(false) {
+    MS_LOG(DEBUG) << "Create ring queue with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  ~RingQueue() = default;
+
+  RingQueue(const RingQueue &) = delete;
+
+  RingQueue &operator=(const RingQueue &) = delete;
+
+  size_t size() const {
+    // head is loaded first, so the tail loaded after it is never behind it
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    return static_cast<size_t>(std::min(tail - head, sz_));
+  }
+
+  size_t capacity() const { return static_cast<size_t>(sz_); }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer
+  Status Add(const_reference ele) {
+    T copy(ele);
+    return Add(std::move(copy));
+  }
+
+  Status Add(T &&ele) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    RETURN_IF_NOT_OK(WaitNotFull(tail));
+    slots_[tail % sz_] = std::move(ele);
+    Publish(&tail_, tail + 1, &consumer_parked_, &not_empty_cv_);
+    return Status::OK();
+  }
+
+  /// \brief Add all the elements in order, as many as there is room for are published at a time.
+  /// \param[in, out] eles The elements to add, it is cleared on success
+  /// \return Status The status code returned
+  Status AddBatch(std::vector<T> *eles) {
+    RETURN_UNEXPECTED_IF_NULL(eles);
+    size_t i = 0;
+    while (i < eles->size()) {
+      uint64_t tail = tail_.load(std::memory_order_relaxed);
+      RETURN_IF_NOT_OK(WaitNotFull(tail));
+      uint64_t n = std::min<uint64_t>(sz_ - (tail - cached_head_), eles->size() - i);
+      for (uint64_t k = 0; k < n; ++k) {
+        slots_[(tail + k) % sz_] = std::move((*eles)[i++]);
+      }
+      Publish(&tail_, tail + n, &consumer_parked_, &not_empty_cv_);
+    }
+    eles->clear();
+    return Status::OK();
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    RETURN_UNEXPECTED_IF_NULL(p);
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    RETURN_IF_NOT_OK(WaitNotEmpty(head));
+    *p = std::move(slots_[head % sz_]);
+    Publish(&head_, head + 1, &producer_parked_, &not_full_cv_);
+    return Status::OK();
+  }
+
+  /// \brief Pop at least one and up to max_count elements, waiting only for the first one.
+  /// \param[out] out The elements popped are appended to it
+  /// \param[in] max_count The max number of elements to pop
+  /// \return Status The status code returned
+  Status PopFrontBatch(std::vector<T> *out, size_t max_count) {
+    RETURN_UNEXPECTED_IF_NULL(out);
+    CHECK_FAIL_RETURN_UNEXPECTED(max_count > 0, "max_count should be larger than 0.");
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    RETURN_IF_NOT_OK(WaitNotEmpty(head));
+    if (cached_tail_ - head < max_count) {
+      // the cached tail may be stale, pick up what has been added since
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    uint64_t n = std::min<uint64_t>(cached_tail_ - head, max_count);
+    for (uint64_t k = 0; k < n; ++k) {
+      out->push_back(std::move(slots_[(head + k) % sz_]));
+    }
+    Publish(&head_, head + n, &producer_parked_, &not_full_cv_);
+    return Status::OK();
+  }
+
+  Status Register(TaskGroup *vg) {
+    RETURN_UNEXPECTED_IF_NULL(vg);
+    RETURN_IF_NOT_OK(not_empty_cv_.Register(vg->GetIntrpService()));
+    return not_full_cv_.Register(vg->GetIntrpService());
+  }
+
+  // Drop the elements left, no producer or consumer is supposed to be active.
+  void Reset() {
+    std::unique_lock<std::mutex> lock(mux_);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    for (uint64_t i = head; i < tail; ++i) {
+      slots_[i % sz_] = T();
+    }
+    head_.store(0);
+    tail_.store(0);
+    cached_head_ = 0;
+    cached_tail_ = 0;
+    not_empty_cv_.ResetIntrpState();
+    not_full_cv_.ResetIntrpState();
+  }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr int32_t kMinSpin = 16;
+  static constexpr int32_t kInitSpin = 128;
+  static constexpr int32_t kMaxSpin = 4096;
+
+  // Store the new index of one side, then wake up the other side if it has parked. The store and the load of the
+  // flag are sequentially consistent, pairing with the store of the flag and the load of the index by the parking
+  // side, so that either the parking side sees the new index or this side sees the flag.
+  void Publish(std::atomic<uint64_t> *index, uint64_t value, std::atomic<bool> *parked, CondVar *cv) {
+    index->store(value, std::memory_order_seq_cst);
+    if (parked->load(std::memory_order_seq_cst)) {
+      std::unique_lock<std::mutex> lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  // Spin until ready() returns true or the spin count is used up, then park on the CondVar. The spin count of the
+  // side is doubled if spinning is enough and halved if not.
+  template <typename F>
+  Status SpinThenPark(const F &ready, int32_t *spin, std::atomic<bool> *parked, CondVar *cv, CondVar *other_cv) {
+    for (int32_t i = 0; i < *spin; ++i) {
+      std::this_thread::yield();
+      if (ready()) {
+        *spin = std::min(*spin * 2, kMaxSpin);
+        return Status::OK();
+      }
+    }
+    *spin = std::max(*spin / 2, kMinSpin);
+    std::unique_lock<std::mutex> lock(mux_);
+    parked->store(true, std::memory_order_seq_cst);
+    Status rc = cv->Wait(&lock, ready);
+    parked->store(false, std::memory_order_relaxed);
+    if (rc.IsError()) {
+      other_cv->Interrupt();
+    }
+    return rc;
+  }
+
+  Status WaitNotFull(uint64_t tail) {
+    if (tail - cached_head_ < sz_) {
+      return Status::OK();
+    }
+    auto ready = [this, tail]() -> bool {
+      cached_head_ = head_.load(std::memory_order_seq_cst);
+      return tail - cached_head_ < sz_;
+    };
+    if (ready()) {
+      return Status::OK();
+    }
+    return SpinThenPark(ready, &producer_spin_, &producer_parked_, &not_full_cv_, &not_empty_cv_);
+  }
+
+  Status WaitNotEmpty(uint64_t head) {
+    if (cached_tail_ > head) {
+      return Status::OK();
+    }
+    auto ready = [this, head]() -> bool {
+      cached_tail_ = tail_.load(std::memory_order_seq_cst);
+      return cached_tail_ > head;
+    };
+    if (ready()) {
+      return Status::OK();
+    }
+    return SpinThenPark(ready, &consumer_spin_, &consumer_parked_, &not_empty_cv_, &not_full_cv_);
+  }
+
+  const uint64_t sz_;
+  std::vector<T> slots_;
+  std::string my_name_;
+
+  // consumer side, indices only grow and are taken modulo the capacity
+  alignas(kCacheLineSize) std::atomic<uint64_t> head_;
+  uint64_t cached_tail_;  // the tail last seen by the consumer
+  int32_t consumer_spin_;
+
+  // producer side
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail_;
+  uint64_t cached_head_;  // the head last seen by the producer
+  int32_t producer_spin_;
+
+  alignas(kCacheLineSize) std::atomic<bool> consumer_parked_;
+  std::atomic<bool> producer_parked_;
+  std::mutex mux_;  // only taken to park and to wake up a parked side
+  CondVar not_empty_cv_;
+  CondVar not_full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
@@ -72,8 +72,10 @@ const int kUnsignedInt4 = 4;
 
 enum LabelCategory { kSchemaLabel, kStatisticsLabel, kIndexLabel };
 
-const char kVersion[] = "3.0";
-const std::vector<std::string> kSupportedVersion = {"2.0", kVersion};
+// 3.0 compresses the blob of the samples, 3.1 stores the raw fields in the typed layout of ShardRawCodec
+const char kVersion[] = "3.1";
+const char kCompressBlobVersion[] = "3.0";
+const std::vector<std::string> kSupportedVersion = {"2.0", kCompressBlobVersion, kVersion};
 
 enum ShardType {
   kNLP = 0,
@@ -110,6 +112,9 @@ const uint64_t kInt64Len = 8;
 // Minimum file size
 const uint64_t kMinFileSize = kInt64Len;
 
+// suffix of the binary index file which is written next to the meta file
+const char kBinaryIndexSuffix[] = ".idx";
+
 const int kMinShardCount = 1;
 const int kMaxShardCount = 1000;  // write
 const int kMaxFileCount = 4096;   // read
@@ -127,6 +132,10 @@ const int kMinFreeDiskSize = 10;  // 10M
 // dummy json
 const json kDummyId = R"({"id": 0})"_json;
 
+// codecs of the blob of samples
+const char kBlobCompressionNone[] = "none";
+const char kBlobCompressionZlib[] = "zlib";
+
 // translate type in schema to type in sqlite3(NULL, INTEGER, REAL, TEXT, BLOB)
 const std::unordered_map<std::string, std::string> kDbJsonMap = {
   {"string", "TEXT"},     {"date", "DATE"},       {"date-time", "DATETIME"}, {"null", "NULL"},
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Binary form of the INDEXES table of a shard, written next to its ".db" meta file. Rows are stored in
+///     ROW_ID order so that a row is found by position, and every index field keeps a permutation of the rows sorted
+///     by value so that the rows or pages of a category are found by binary search. The file is mapped read-only.
+///
+///     Layout, every section is aligned to 8 bytes:
+///       magic | row count | field count | shard name
+///       row count x Row
+///       field count x (name | is number | value offsets[row count + 1] | sorted rows[row count] | value pool)
+class MINDRECORD_API ShardBinaryIndex {
+ public:
+  /// \brief the location of one sample, the same as the columns of the INDEXES table
+  struct Row {
+    uint64_t row_group_id;
+    uint64_t page_id_raw;
+    uint64_t page_offset_raw;
+    uint64_t page_offset_raw_end;
+    uint64_t page_id_blob;
+    uint64_t page_offset_blob;
+    uint64_t page_offset_blob_end;
+  };
+
+  /// \brief the name of an index field as the column in INDEXES, and whether its values are numbers
+  using FIELD_INFO = std::pair<std::string, bool>;
+
+  ShardBinaryIndex() = default;
+
+  ~ShardBinaryIndex() = default;
+
+  /// \brief write the binary index of a shard
+  /// \param[in] file_path path of the index file
+  /// \param[in] shard_name file name of the shard, used to check that the index matches the shard
+  /// \param[in] rows the location of every sample, in ROW_ID order
+  /// \param[in] fields the index fields
+  /// \param[in] values values[i][j] is the value of field j of row i
+  /// \return Status
+  static Status Write(const std::string &file_path, const std::string &shard_name, const std::vector<Row> &rows,
+                      const std::vector<FIELD_INFO> &fields, const std::vector<std::vector<std::string>> &values);
+
+  /// \brief map and check the binary index
+  /// \param[in] file_path path of the index file
+  /// \return Status
+  Status Open(const std::string &file_path);
+
+  const std::string &GetShardName() const { return shard_name_; }
+
+  uint64_t GetRowCount() const { return row_count_; }
+
+  /// \brief get the location of the sample with the row id, the row id must be less than the row count
+  const Row &GetRow(uint64_t row_id) const { return rows_[row_id]; }
+
+  /// \brief get the id of a field by its column name, -1 if the field is not indexed
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief get the value of a field in the row as it is returned by SQLite
+  std::string GetValue(int field_id, uint64_t row_id) const;
+
+  /// \brief check if the value of a field in the row equals to the value
+  bool ValueEquals(int field_id, uint64_t row_id, const std::string &value) const;
+
+  /// \brief get the rows whose value of the field equals to the value, in ROW_ID order
+  std::vector<uint64_t> GetRowsByValue(int field_id, const std::string &value) const;
+
+  /// \brief get the distinct blob pages which contain rows whose value of the field equals to the value, in order
+  std::vector<uint64_t> GetPagesByValue(int field_id, const std::string &value) const;
+
+  /// \brief get the distinct values of the field, in ascending order
+  std::vector<std::string> GetDistinctValues(int field_id) const;
+
+ private:
+  struct Field {
+    std::string name;
+    bool is_number;
+    const uint64_t *value_offsets;
+    const uint64_t *sorted_rows;
+    const char *pool;
+  };
+
+  /// \brief compare the value of a field in the row with the value, numbers are compared by value
+  int Compare(const Field &field, uint64_t row_id, const std::string &value) const;
+
+  /// \brief get the range of the sorted rows whose values equal to the value
+  std::pair<uint64_t, uint64_t> EqualRange(const Field &field, const std::string &value) const;
+
+  std::shared_ptr<ShardMappedFile> mapped_file_;
+  std::string shard_name_;
+  uint64_t row_count_ = 0;
+  const Row *rows_ = nullptr;
+  std::vector<Field> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
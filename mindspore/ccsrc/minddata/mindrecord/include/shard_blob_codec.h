@@ -0,0 +1,67 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_CODEC_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Compression of the blob of a sample in the blob page. The codec is recorded in the header as
+///     "blob_compression". Every blob is compressed on its own so that a sample can still be read by its offsets.
+///
+///     Layout of a compressed blob:
+///       raw size (8 bytes) | method (1 byte) | payload
+///     The method is the codec of the payload, or stored when the blob does not get smaller.
+class MINDRECORD_API ShardBlobCodec {
+ public:
+  /// \brief check if the codec is supported on this platform
+  /// \param[in] codec name of the codec, "none" or "zlib"
+  /// \return Status
+  static Status CheckCodec(const std::string &codec);
+
+  /// \brief compress the blob of a sample
+  /// \param[in] codec name of the codec
+  /// \param[in] input the blob
+  /// \param[out] output the compressed blob
+  /// \return Status
+  static Status Compress(const std::string &codec, const std::vector<uint8_t> &input, std::vector<uint8_t> *output);
+
+  /// \brief decompress a blob written by Compress
+  /// \param[in] data the start of the compressed blob
+  /// \param[in] size the size of the compressed blob in bytes
+  /// \param[out] output the blob
+  /// \return Status
+  static Status Decompress(const uint8_t *data, uint64_t size, std::vector<uint8_t> *output);
+
+ private:
+  enum Method : uint8_t { kMethodStored = 0, kMethodZlib = 1 };
+
+  static constexpr uint64_t kHeaderSize = sizeof(uint64_t) + sizeof(uint8_t);
+  // zlib expands a stream by at most 1032 times, a larger raw size in the header means the blob is corrupt
+  static constexpr uint64_t kMaxZlibRatio = 1032;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_CODEC_H_
@@ -130,6 +130,11 @@ class MINDRECORD_API ShardHeader {
 
   void SetCompressionSize(const uint64_t &compression_size) { compression_size_ = compression_size; }
 
+  /// \brief get the codec of the blob of samples, "none" if the blob is not compressed
+  std::string GetBlobCompression() const { return blob_compression_; }
+
+  void SetBlobCompression(const std::string &blob_compression) { blob_compression_ = blob_compression; }
+
   std::vector<std::string> SerializeHeader();
 
   Status PagesToFile(const std::string dump_file_name);
@@ -190,6 +195,7 @@ class MINDRECORD_API ShardHeader {
   uint64_t header_size_;
   uint64_t page_size_;
   uint64_t compression_size_;
+  std::string blob_compression_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
@@ -25,7 +25,9 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_raw_codec.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -99,6 +101,12 @@ class MINDRECORD_API ShardIndexGenerator {
 
   Status CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
+  /// \brief write the rows of the shard into a binary index next to the meta file, so that readers can skip SQLite
+  /// \param shard_no
+  /// \param row_data all the rows of the shard
+  /// \return Status
+  Status WriteBinaryIndex(int shard_no, const ROW_DATA &row_data);
+
   Status AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,   // NOLINT
                          const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,  // NOLINT
                          std::fstream &in);                                                          // NOLINT
@@ -117,6 +125,7 @@ class MINDRECORD_API ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  std::vector<std::shared_ptr<ShardRawCodec>> raw_codecs_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
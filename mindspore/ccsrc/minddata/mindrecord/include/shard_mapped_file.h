@@ -0,0 +1,76 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A whole mindrecord file mapped into memory. The mapping is private and copy-on-write, so the pages can be
+///     handed out as the backing store of tensors which may be modified in place without touching the file.
+class MINDRECORD_API ShardMappedFile {
+ public:
+  ShardMappedFile() = default;
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map the file into memory
+  /// \param[in] file_path the path of the mindrecord file
+  /// \return Status the status of the mapping
+  Status Open(const std::string &file_path);
+
+  /// \brief unmap the file
+  void Close();
+
+  /// \brief get the start address of the mapping
+  uint8_t *GetData() const { return data_; }
+
+  /// \brief get the size of the mapping in bytes
+  uint64_t GetSize() const { return size_; }
+
+  /// \brief check if the range [offset, offset + length) is inside the mapping
+  bool Contains(uint64_t offset, uint64_t length) const { return offset <= size_ && length <= size_ - offset; }
+
+  /// \brief ask the kernel to read ahead the range [offset, offset + length) asynchronously
+  void WillNeed(uint64_t offset, uint64_t length) const;
+
+ private:
+  uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+};
+
+/// \brief A read-only slice of a mapped file. The slice keeps the mapping alive until it is released.
+struct ShardBlobView {
+  const uint8_t *data = nullptr;
+  uint64_t size = 0;
+  std::shared_ptr<ShardMappedFile> holder;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
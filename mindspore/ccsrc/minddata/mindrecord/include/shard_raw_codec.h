@@ -0,0 +1,109 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_schema.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Typed encoding of the raw (non-blob) fields of a sample in the raw page. Records written by older versions
+///     are msgpack encoded json; a typed record starts with a byte that is never used by msgpack, so both kinds can be
+///     told apart record by record and old pages stay readable.
+///
+///     Layout of a typed record:
+///       marker | codec version | numeric columns | string columns
+///     The numeric columns are stored with fixed width in the order of the schema, so every column is at a fixed
+///     offset and is decoded with a plain copy. int32 and int64 take 4 and 8 bytes, float32 and float64 are both
+///     kept as 8 byte doubles which is what the json path holds. Every string column is a 4 byte length and bytes.
+///
+///     The layout is per record rather than one contiguous buffer per column of a row group, since the index, the
+///     lazy load and the index generator address every sample in the raw page by its own offsets. The decoded sample
+///     is still a json, which is what ShardReader hands to MindRecordOp, but only the selected columns are decoded.
+class MINDRECORD_API ShardRawCodec {
+ public:
+  /// \brief build the codec of the raw fields of the schema
+  explicit ShardRawCodec(const std::shared_ptr<Schema> &schema);
+
+  ~ShardRawCodec() = default;
+
+  /// \brief encode the raw fields of a sample, fall back to msgpack if the sample does not match the schema
+  /// \param[in] row the raw fields of a sample
+  /// \param[out] output the encoded record
+  void Encode(const json &row, std::vector<uint8_t> *output) const;
+
+  /// \brief decode a record written by Encode or by older versions
+  /// \param[in] data the start of the record
+  /// \param[in] size the size of the record in bytes
+  /// \param[out] row the raw fields of the sample
+  /// \return Status
+  Status Decode(const uint8_t *data, uint64_t size, json *row) const;
+
+  /// \brief decode the selected columns of a record written by Encode or by older versions
+  /// \param[in] data the start of the record
+  /// \param[in] size the size of the record in bytes
+  /// \param[in] columns the columns to decode, all of them if empty, the ones not in the record are skipped
+  /// \param[out] row the selected raw fields of the sample
+  /// \return Status
+  Status Decode(const uint8_t *data, uint64_t size, const std::vector<std::string> &columns, json *row) const;
+
+  /// \brief check if the record is typed encoded
+  static bool IsTyped(const uint8_t *data, uint64_t size) {
+    return size >= kHeaderSize && data[0] == kTypedMarker && data[1] == kCodecVersion;
+  }
+
+ private:
+  enum ColumnKind { kKindInt32, kKindInt64, kKindFloat, kKindString };
+
+  struct Column {
+    std::string name;
+    ColumnKind kind;
+    uint64_t offset;  // offset of the value in the numeric section
+  };
+
+  /// \brief encode the row in the typed layout, false if the row does not match the schema
+  bool EncodeTyped(const json &row, std::vector<uint8_t> *output) const;
+
+  /// \brief decode a numeric column of a typed record whose numeric section is checked
+  static void DecodeNumeric(const uint8_t *numeric, const Column &column, json *row);
+
+  /// \brief find the string columns of a typed record, in the order of the schema
+  Status FindStrings(const uint8_t *data, uint64_t size, std::vector<std::pair<const char *, uint32_t>> *strings) const;
+
+  // 0xc1 is reserved by the msgpack spec and never starts a msgpack value
+  static constexpr uint8_t kTypedMarker = 0xc1;
+  static constexpr uint8_t kCodecVersion = 1;
+  static constexpr uint64_t kHeaderSize = 2;
+
+  std::vector<Column> numeric_columns_;
+  std::vector<Column> string_columns_;
+  uint64_t numeric_size_ = 0;
+  bool typed_supported_ = true;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
@@ -1,5 +1,5 @@
 /**
- * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ * Copyright 2019-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -42,13 +42,17 @@
 #include <vector>
 #include "minddata/mindrecord/include/common/log_adapter.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
+#include "minddata/mindrecord/include/shard_blob_codec.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
+#include "minddata/mindrecord/include/shard_raw_codec.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
@@ -58,6 +62,7 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
+using TASK_CONTENT_VIEW = std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class MINDRECORD_API ShardReader {
@@ -184,6 +189,27 @@ class MINDRECORD_API ShardReader {
   Status GetNextById(const int64_t &task_id, const int32_t &consumer_id,
                      std::shared_ptr<TASK_CONTENT> *task_content_ptr);
 
+  /// \brief return a row by id without copying the blob, only available in mmap mode
+  /// \param[in] task_id the id of the task to read
+  /// \param[in] consumer_id the id of the consumer thread
+  /// \param[out] task_content_ptr the blob is returned as a view into the mapped file which keeps the mapping alive
+  /// \return MSRStatus the status of MSRStatus
+  Status GetNextViewById(const int64_t &task_id, const int32_t &consumer_id,
+                         std::shared_ptr<TASK_CONTENT_VIEW> *task_content_ptr);
+
+  /// \brief ask the kernel to read ahead the blobs of the given tasks, only takes effect in mmap mode
+  /// \param[in] task_ids the ids of the tasks which will be read soon
+  void PrefetchByIds(const std::vector<int64_t> &task_ids);
+
+  /// \brief read the data files through memory mapping instead of file streams, must be set before Open
+  void SetMmapMode(bool use_mmap) { use_mmap_ = use_mmap; }
+
+  /// \brief check if the data files are read through memory mapping
+  bool GetMmapMode() const { return !mapped_files_.empty(); }
+
+  /// \brief check if the blob of samples is compressed, compressed blobs can not be read as views
+  bool GetBlobCompressed() const { return blob_compressed_; }
+
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -244,6 +270,12 @@ class MINDRECORD_API ShardReader {
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief read all rows in one shard from the binary index, or only the row of sample_id if it is not negative
+  Status ReadAllRowsInShardFromIndex(int shard_id, const int32_t &consumer_id, int64_t sample_id,
+                                     const std::vector<std::string> &columns,
+                                     std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                                     std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -266,6 +298,19 @@ class MINDRECORD_API ShardReader {
   /// \brief verify the validity of dataset
   Status VerifyDataset(sqlite3 **db, const string &file);
 
+  /// \brief open the binary index of the file, return false if there is no valid one
+  bool LoadBinaryIndex(const std::string &file, std::shared_ptr<ShardBinaryIndex> *binary_index_ptr);
+
+  /// \brief check that the binary indexes match the row groups of their shards, drop those which do not
+  Status CheckBinaryIndex(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary);
+
+  /// \brief get the rows of a blob page which match the criteria from the binary index
+  Status GetRowsFromIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                          std::vector<uint64_t> *row_ids);
+
+  /// \brief get the distinct values of a field from the binary indexes, return false if some shard has no index
+  bool GetClassesFromIndex(const std::string &field_name, std::shared_ptr<std::set<std::string>> category_ptr);
+
   /// \brief get column values
   Status GetLabels(int page_id, int shard_id, const std::vector<std::string> &columns,
                    const std::pair<std::string, std::string> &criteria, std::shared_ptr<std::vector<json>> *labels_ptr);
@@ -302,6 +347,18 @@ class MINDRECORD_API ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief locate the blob of one task in the data file
+  Status GetBlobLocation(int64_t task_id, uint32_t consumer_id, TaskType *task_type, uint32_t *shard_id,
+                         uint64_t *file_offset, uint64_t *blob_size, json *var_fields);
+
+  /// \brief map all the data files into memory
+  Status MapFiles();
+
+  /// \brief read the selected columns of the label at the file offset, either typed or msgpack encoded, all of them
+  ///     if no column is selected
+  Status ReadRawLabel(int shard_id, const std::shared_ptr<std::fstream> &fs, uint64_t file_offset, uint64_t len,
+                      const std::vector<std::string> &columns, json *label_json);
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
@@ -319,16 +376,23 @@ class MINDRECORD_API ShardReader {
                  std::shared_ptr<std::vector<std::string>> *addresses_ptr);
 
  protected:
+  /// \brief open the meta file of the shard if it is not opened yet, it is skipped in Init when a binary index exists
+  Status OpenDatabase(int shard_id);
+
   uint64_t header_size_;                       // header size
   uint64_t page_size_;                         // page size
   int shard_count_;                            // number of shards
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
+  std::shared_ptr<ShardRawCodec> raw_codec_;   // decoder of the raw page records
+  bool blob_compressed_ = false;               // whether the blob of samples is compressed
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardBinaryIndex>> binary_indexes_;                // binary index list, may be null
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // mapped file list in mmap mode
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -337,10 +401,12 @@ class MINDRECORD_API ShardReader {
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // data operators, including shuffle, sample and category
   ShardTaskList tasks_;                                    // shard task list
   std::mutex shard_locker_;                                // locker of shard
+  std::mutex database_locker_;                             // locker of opening the meta files
 
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  bool use_mmap_ = false;     // read data files through memory mapping
 
   int64_t num_padded_;  // number of padding samples
 
@@ -39,10 +39,12 @@
 
 #include "minddata/mindrecord/include/common/log_adapter.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_blob_codec.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_raw_codec.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
@@ -80,6 +82,11 @@ class MINDRECORD_API ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   Status SetPageSize(const uint64_t &page_size);
 
+  /// \brief Set the codec to compress the blob of every sample
+  /// \param[in] blob_compression "none" or "zlib"
+  /// \return MSRStatus the status of MSRStatus
+  Status SetBlobCompression(const std::string &blob_compression);
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -132,12 +139,16 @@ class MINDRECORD_API ShardWriter {
 
   /// \brief fill data array in multiple thread run
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,  // NOLINT
-                 std::vector<std::vector<uint8_t>> &bin_data);                    // NOLINT
+                 std::vector<std::vector<uint8_t>> &bin_data,                     // NOLINT
+                 const std::map<uint64_t, std::shared_ptr<ShardRawCodec>> &codecs);
+
+  /// \brief compress the blob of samples in multiple threads by the codec in header
+  Status CompressBlobData(std::vector<std::vector<uint8_t>> *blob_data);
 
-  /// \brief serialized raw data
+  /// \brief serialized raw data, typed_encoding uses the typed layout of the raw page instead of msgpack
   Status SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,  // NOLINT
                           std::vector<std::vector<uint8_t>> &bin_data,      // NOLINT
-                          uint32_t row_count);
+                          uint32_t row_count, bool typed_encoding = false);
 
   /// \brief write all data parallel
   Status ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
@@ -238,11 +249,13 @@ class MINDRECORD_API ShardWriter {
   std::string lock_file_;   // lock file for parallel run
   std::string pages_file_;  // temporary file of pages info for parallel run
 
-  int shard_count_;        // number of files
-  uint64_t header_size_;   // header size
-  uint64_t page_size_;     // page size
-  uint32_t row_count_;     // count of rows
-  uint32_t schema_count_;  // count of schemas
+  int shard_count_;               // number of files
+  uint64_t header_size_;          // header size
+  uint64_t page_size_;            // page size
+  std::string blob_compression_;  // codec of the blob of samples
+  bool is_append_ = false;        // whether the files are opened for append
+  uint32_t row_count_;            // count of rows
+  uint32_t schema_count_;         // count of schemas
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
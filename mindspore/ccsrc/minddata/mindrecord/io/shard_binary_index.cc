@@ -0,0 +1,280 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_binary_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kBinaryIndexMagic[] = "MRIDX001";
+const uint64_t kBinaryIndexMagicLen = 8;
+const uint64_t kAlignment = 8;
+
+uint64_t AlignUp(uint64_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+// the order of a value of number field: a number, NaN, and a value which is not a number
+enum NumberClass : int { kNumber = 0, kNaN = 1, kNotNumber = 2 };
+
+NumberClass ParseNumber(const char *str, double *num) {
+  char *end = nullptr;
+  *num = std::strtod(str, &end);
+  if (end == str || *end != '\0') {
+    return kNotNumber;
+  }
+  return std::isnan(*num) ? kNaN : kNumber;
+}
+
+// values of number fields are compared as double, NaN is greater than all numbers and a value which is not a number
+// is greater than NaN, so that the order is strict weak, the values of the same class other than numbers are compared
+// as string
+int CompareNumber(const char *a, const char *b) {
+  double a_num = 0;
+  double b_num = 0;
+  NumberClass a_class = ParseNumber(a, &a_num);
+  NumberClass b_class = ParseNumber(b, &b_num);
+  if (a_class != b_class) {
+    return a_class < b_class ? -1 : 1;
+  }
+  if (a_class != kNumber) {
+    return std::strcmp(a, b);
+  }
+  return a_num < b_num ? -1 : (a_num > b_num ? 1 : 0);
+}
+
+int CompareValue(bool is_number, const char *a, const char *b) {
+  return is_number ? CompareNumber(a, b) : std::strcmp(a, b);
+}
+
+void WriteUInt64(std::ofstream &out, uint64_t value) {  // NOLINT
+  (void)out.write(reinterpret_cast<const char *>(&value), sizeof(uint64_t));
+}
+
+void WritePadding(std::ofstream &out, uint64_t size) {  // NOLINT
+  static const char padding[kAlignment] = {0};
+  (void)out.write(padding, static_cast<std::streamsize>(AlignUp(size) - size));
+}
+
+void WritePadded(std::ofstream &out, const char *data, uint64_t size) {  // NOLINT
+  (void)out.write(data, static_cast<std::streamsize>(size));
+  WritePadding(out, size);
+}
+}  // namespace
+
+Status ShardBinaryIndex::Write(const std::string &file_path, const std::string &shard_name,
+                               const std::vector<Row> &rows, const std::vector<FIELD_INFO> &fields,
+                               const std::vector<std::vector<std::string>> &values) {
+  static_assert(sizeof(Row) == sizeof(uint64_t) * 7, "ShardBinaryIndex::Row should be packed.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(values.size() == rows.size(),
+                                  "[Internal ERROR] The number of index values is not equal to the number of rows.");
+  std::ofstream out(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(out.good(), "Invalid file, failed to open binary index file: " + file_path);
+
+  (void)out.write(kBinaryIndexMagic, kBinaryIndexMagicLen);
+  WriteUInt64(out, rows.size());
+  WriteUInt64(out, fields.size());
+  WriteUInt64(out, shard_name.size());
+  WritePadded(out, shard_name.data(), shard_name.size());
+  if (!rows.empty()) {
+    (void)out.write(reinterpret_cast<const char *>(rows.data()),
+                    static_cast<std::streamsize>(rows.size() * sizeof(Row)));
+  }
+
+  for (size_t field_id = 0; field_id < fields.size(); ++field_id) {
+    const auto &field_name = fields[field_id].first;
+    bool is_number = fields[field_id].second;
+    WriteUInt64(out, field_name.size());
+    WriteUInt64(out, is_number ? 1 : 0);
+    WritePadded(out, field_name.data(), field_name.size());
+
+    // every value is null terminated in the pool, so that it can be parsed in place
+    std::vector<uint64_t> value_offsets(rows.size() + 1, 0);
+    for (size_t row_id = 0; row_id < rows.size(); ++row_id) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(values[row_id].size() == fields.size(),
+                                      "[Internal ERROR] The number of index values of row " + std::to_string(row_id) +
+                                        " is not equal to the number of index fields.");
+      value_offsets[row_id + 1] = value_offsets[row_id] + values[row_id][field_id].size() + 1;
+    }
+    std::vector<uint64_t> sorted_rows(rows.size());
+    std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+    std::stable_sort(sorted_rows.begin(), sorted_rows.end(), [&values, field_id, is_number](uint64_t a, uint64_t b) {
+      return CompareValue(is_number, values[a][field_id].c_str(), values[b][field_id].c_str()) < 0;
+    });
+    (void)out.write(reinterpret_cast<const char *>(value_offsets.data()),
+                    static_cast<std::streamsize>(value_offsets.size() * sizeof(uint64_t)));
+    if (!sorted_rows.empty()) {
+      (void)out.write(reinterpret_cast<const char *>(sorted_rows.data()),
+                      static_cast<std::streamsize>(sorted_rows.size() * sizeof(uint64_t)));
+    }
+    for (size_t row_id = 0; row_id < rows.size(); ++row_id) {
+      const auto &value = values[row_id][field_id];
+      (void)out.write(value.c_str(), static_cast<std::streamsize>(value.size() + 1));
+    }
+    WritePadding(out, value_offsets.back());
+  }
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!out.fail(), "Invalid file, failed to write binary index file: " + file_path);
+  MS_LOG(DEBUG) << "Succeed to write binary index file, path: " << file_path << ", rows: " << rows.size();
+  return Status::OK();
+}
+
+Status ShardBinaryIndex::Open(const std::string &file_path) {
+  auto mapped_file = std::make_shared<ShardMappedFile>();
+  RETURN_IF_NOT_OK_MR(mapped_file->Open(file_path));
+  const uint8_t *data = mapped_file->GetData();
+  uint64_t size = mapped_file->GetSize();
+  uint64_t cursor = 0;
+  // returns the start of the next section of the given size, or nullptr if the file is truncated
+  auto take = [data, size, &cursor](uint64_t length) -> const uint8_t * {
+    if (data == nullptr || cursor > size || AlignUp(length) > size - cursor || AlignUp(length) < length) {
+      return nullptr;
+    }
+    const uint8_t *section = data + cursor;
+    cursor += AlignUp(length);
+    return section;
+  };
+  auto take_uint64 = [&take](uint64_t *value) {
+    const uint8_t *section = take(sizeof(uint64_t));
+    if (section == nullptr) {
+      return false;
+    }
+    *value = *reinterpret_cast<const uint64_t *>(section);
+    return true;
+  };
+  const std::string invalid_msg = "Invalid file, the binary index file is broken, path: " + file_path;
+
+  const uint8_t *magic = take(kBinaryIndexMagicLen);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(magic != nullptr && std::memcmp(magic, kBinaryIndexMagic, kBinaryIndexMagicLen) == 0,
+                                  invalid_msg);
+  uint64_t row_count = 0;
+  uint64_t field_count = 0;
+  uint64_t name_len = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(take_uint64(&row_count) && take_uint64(&field_count) && take_uint64(&name_len),
+                                  invalid_msg);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(row_count <= size / sizeof(Row), invalid_msg);
+  const uint8_t *name = take(name_len);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(name != nullptr, invalid_msg);
+  const uint8_t *rows = take(row_count * sizeof(Row));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(rows != nullptr, invalid_msg);
+
+  std::vector<Field> fields;
+  for (uint64_t field_id = 0; field_id < field_count; ++field_id) {
+    uint64_t field_name_len = 0;
+    uint64_t is_number = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(take_uint64(&field_name_len) && take_uint64(&is_number), invalid_msg);
+    const uint8_t *field_name = take(field_name_len);
+    const uint8_t *value_offsets = take((row_count + 1) * sizeof(uint64_t));
+    const uint8_t *sorted_rows = take(row_count * sizeof(uint64_t));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(field_name != nullptr && value_offsets != nullptr && sorted_rows != nullptr,
+                                    invalid_msg);
+    Field field{std::string(reinterpret_cast<const char *>(field_name), field_name_len), is_number != 0,
+                reinterpret_cast<const uint64_t *>(value_offsets), reinterpret_cast<const uint64_t *>(sorted_rows),
+                nullptr};
+    const uint8_t *pool = take(field.value_offsets[row_count]);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(pool != nullptr, invalid_msg);
+    field.pool = reinterpret_cast<const char *>(pool);
+    for (uint64_t row_id = 0; row_id < row_count; ++row_id) {
+      uint64_t end = field.value_offsets[row_id + 1];
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field.value_offsets[row_id] < end && field.pool[end - 1] == '\0', invalid_msg);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field.sorted_rows[row_id] < row_count, invalid_msg);
+    }
+    fields.push_back(std::move(field));
+  }
+
+  mapped_file_ = std::move(mapped_file);
+  shard_name_ = std::string(reinterpret_cast<const char *>(name), name_len);
+  row_count_ = row_count;
+  rows_ = reinterpret_cast<const Row *>(rows);
+  fields_ = std::move(fields);
+  MS_LOG(DEBUG) << "Succeed to open binary index file, path: " << file_path << ", rows: " << row_count_;
+  return Status::OK();
+}
+
+int ShardBinaryIndex::GetFieldId(const std::string &field_name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].name == field_name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+std::string ShardBinaryIndex::GetValue(int field_id, uint64_t row_id) const {
+  const auto &field = fields_[field_id];
+  return std::string(field.pool + field.value_offsets[row_id]);
+}
+
+bool ShardBinaryIndex::ValueEquals(int field_id, uint64_t row_id, const std::string &value) const {
+  return Compare(fields_[field_id], row_id, value) == 0;
+}
+
+int ShardBinaryIndex::Compare(const Field &field, uint64_t row_id, const std::string &value) const {
+  return CompareValue(field.is_number, field.pool + field.value_offsets[row_id], value.c_str());
+}
+
+std::pair<uint64_t, uint64_t> ShardBinaryIndex::EqualRange(const Field &field, const std::string &value) const {
+  const uint64_t *begin = field.sorted_rows;
+  const uint64_t *end = field.sorted_rows + row_count_;
+  auto lower = std::lower_bound(begin, end, value, [this, &field](uint64_t row_id, const std::string &v) {
+    return Compare(field, row_id, v) < 0;
+  });
+  auto upper = std::upper_bound(lower, end, value, [this, &field](const std::string &v, uint64_t row_id) {
+    return Compare(field, row_id, v) > 0;
+  });
+  return std::make_pair(static_cast<uint64_t>(lower - begin), static_cast<uint64_t>(upper - begin));
+}
+
+std::vector<uint64_t> ShardBinaryIndex::GetRowsByValue(int field_id, const std::string &value) const {
+  const auto &field = fields_[field_id];
+  auto range = EqualRange(field, value);
+  // the sort is stable, so the rows of the same value are already in ROW_ID order
+  return std::vector<uint64_t>(field.sorted_rows + range.first, field.sorted_rows + range.second);
+}
+
+std::vector<uint64_t> ShardBinaryIndex::GetPagesByValue(int field_id, const std::string &value) const {
+  const auto &field = fields_[field_id];
+  auto range = EqualRange(field, value);
+  std::vector<uint64_t> pages;
+  for (uint64_t i = range.first; i < range.second; ++i) {
+    uint64_t page_id = rows_[field.sorted_rows[i]].page_id_blob;
+    if (pages.empty() || pages.back() != page_id) {
+      pages.push_back(page_id);
+    }
+  }
+  std::sort(pages.begin(), pages.end());
+  pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+  return pages;
+}
+
+std::vector<std::string> ShardBinaryIndex::GetDistinctValues(int field_id) const {
+  const auto &field = fields_[field_id];
+  std::vector<std::string> distinct_values;
+  for (uint64_t i = 0; i < row_count_; ++i) {
+    uint64_t row_id = field.sorted_rows[i];
+    if (distinct_values.empty() || Compare(field, row_id, distinct_values.back()) != 0) {
+      distinct_values.emplace_back(field.pool + field.value_offsets[row_id]);
+    }
+  }
+  return distinct_values;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
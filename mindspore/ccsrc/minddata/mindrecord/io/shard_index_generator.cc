@@ -268,6 +268,8 @@ Status ShardIndexGenerator::GetSchemaDetails(const std::vector<uint64_t> &schema
                                              std::shared_ptr<std::vector<json>> *detail_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(detail_ptr);
   if (schema_count_ <= kMaxSchemaCount) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(raw_codecs_.size() >= static_cast<size_t>(schema_count_),
+                                    "[Internal ERROR] the number of raw data decoders is less than 'schema_count_'.");
     for (int sc = 0; sc < schema_count_; ++sc) {
       std::vector<char> schema_detail(schema_lens[sc]);
       auto &io_read = in.read(&schema_detail[0], schema_lens[sc]);
@@ -275,7 +277,9 @@ Status ShardIndexGenerator::GetSchemaDetails(const std::vector<uint64_t> &schema
         in.close();
         RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
       }
-      auto j = json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end()));
+      json j;
+      RETURN_IF_NOT_OK_MR(
+        raw_codecs_[sc]->Decode(reinterpret_cast<const uint8_t *>(schema_detail.data()), schema_lens[sc], &j));
       (*detail_ptr)->emplace_back(j);
     }
   }
@@ -515,6 +519,7 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   CHECK_FAIL_RETURN_UNEXPECTED_MR(
     sql_code == SQLITE_OK,
     "Execute SQL statement `BEGIN TRANSACTION;` failed, SQLite result code: " + std::to_string(sql_code));
+  ROW_DATA shard_row_data;
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRawSQL(fields_, &sql_ptr), db, in);
@@ -523,6 +528,7 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
+    (void)std::move(row_data_ptr->begin(), row_data_ptr->end(), std::back_inserter(shard_row_data));
   }
   sql_code = sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
   CHECK_FAIL_RETURN_UNEXPECTED_MR(
@@ -533,9 +539,64 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+
+  // the binary index is only an accelerator of the meta file, readers fall back to SQLite without it
+  Status binary_index_status = WriteBinaryIndex(shard_no, shard_row_data);
+  if (binary_index_status.IsError()) {
+    MS_LOG(WARNING) << "Failed to write the binary index of mindrecord file: " << shard_address << ", "
+                    << binary_index_status.ToString();
+    (void)remove(common::SafeCStr(shard_address + kBinaryIndexSuffix));
+  }
   return Status::OK();
 }
 
+Status ShardIndexGenerator::WriteBinaryIndex(int shard_no, const ROW_DATA &row_data) {
+  std::string shard_address = shard_header_.GetShardAddressByID(shard_no);
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(shard_address, &fn_ptr));
+
+  std::vector<ShardBinaryIndex::FIELD_INFO> fields;
+  std::map<std::string, size_t> field_position;
+  for (const auto &field : fields_) {
+    std::shared_ptr<Schema> schema_ptr;
+    RETURN_IF_NOT_OK_MR(shard_header_.GetSchemaByID(field.first, &schema_ptr));
+    std::string field_type = TakeFieldType(field.second, schema_ptr->GetSchema()["schema"]);
+    std::shared_ptr<std::string> field_name_ptr;
+    RETURN_IF_NOT_OK_MR(GenerateFieldName(field, &field_name_ptr));
+    field_position[":" + *field_name_ptr] = fields.size();
+    fields.emplace_back(*field_name_ptr, kNumberFieldTypeSet.find(field_type) != kNumberFieldTypeSet.end());
+  }
+
+  // ROW_ID of a shard starts from 0 and is continuous, so it is used as the position of the row
+  std::vector<ShardBinaryIndex::Row> rows(row_data.size());
+  std::vector<std::vector<std::string>> values(row_data.size(), std::vector<std::string>(fields.size()));
+  std::vector<bool> filled(row_data.size(), false);
+  for (const auto &row : row_data) {
+    std::map<std::string, std::string> columns;
+    for (const auto &column : row) {
+      // a NULL value is returned as an empty string by SQLite
+      columns[std::get<0>(column)] = std::get<1>(column) == "NULL" ? "" : std::get<2>(column);
+    }
+    uint64_t row_id = std::stoull(columns[":ROW_ID"]);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(row_id < rows.size() && !filled[row_id],
+                                    "[Internal ERROR] The row ids of shard " + std::to_string(shard_no) +
+                                      " are not continuous, row id: " + std::to_string(row_id));
+    filled[row_id] = true;
+    auto &index_row = rows[row_id];
+    index_row.row_group_id = std::stoull(columns[":ROW_GROUP_ID"]);
+    index_row.page_id_raw = std::stoull(columns[":PAGE_ID_RAW"]);
+    index_row.page_offset_raw = std::stoull(columns[":PAGE_OFFSET_RAW"]);
+    index_row.page_offset_raw_end = std::stoull(columns[":PAGE_OFFSET_RAW_END"]);
+    index_row.page_id_blob = std::stoull(columns[":PAGE_ID_BLOB"]);
+    index_row.page_offset_blob = std::stoull(columns[":PAGE_OFFSET_BLOB"]);
+    index_row.page_offset_blob_end = std::stoull(columns[":PAGE_OFFSET_BLOB_END"]);
+    for (const auto &position : field_position) {
+      values[row_id][position.second] = columns[position.first];
+    }
+  }
+  return ShardBinaryIndex::Write(shard_address + kBinaryIndexSuffix, *fn_ptr, rows, fields, values);
+}
+
 Status ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.GetFields();
   for (auto &field : fields_) {
@@ -547,6 +608,10 @@ Status ShardIndexGenerator::WriteToDatabase() {
   page_size_ = shard_header_.GetPageSize();
   header_size_ = shard_header_.GetHeaderSize();
   schema_count_ = shard_header_.GetSchemaCount();
+  raw_codecs_.clear();
+  for (const auto &schema : shard_header_.GetSchemas()) {
+    raw_codecs_.push_back(std::make_shared<ShardRawCodec>(schema));
+  }
   CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_header_.GetShardCount() <= kMaxShardCount,
                                   "[Internal ERROR] 'shard_count': " + std::to_string(shard_header_.GetShardCount()) +
                                     "is not in range (0, " + std::to_string(kMaxShardCount) + "].");
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "utils/file_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+ShardMappedFile::~ShardMappedFile() { Close(); }
+
+Status ShardMappedFile::Open(const std::string &file_path) {
+#if defined(_WIN32) || defined(_WIN64)
+  RETURN_STATUS_UNEXPECTED_MR("Memory mapped reading of mindrecord files is not supported on Windows, file: " +
+                              file_path);
+#else
+  Close();
+  auto realpath = FileUtils::GetRealPath(file_path.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(realpath.has_value(),
+                                  "Invalid file, failed to get the realpath of mindrecord files. Please check file: " +
+                                    file_path);
+
+  int fd = open(realpath.value().c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open mindrecord file for mapping: " + file_path);
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to get the size of mindrecord file: " + file_path);
+  }
+  if (file_stat.st_size == 0) {
+    (void)close(fd);
+    return Status::OK();
+  }
+
+  // MAP_PRIVATE makes writes copy-on-write, MAP_NORESERVE avoids charging the whole file against the commit limit.
+  void *addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_NORESERVE, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED,
+                                  "Failed to map mindrecord file into memory: " + file_path +
+                                    ", errno: " + std::to_string(errno));
+  data_ = static_cast<uint8_t *>(addr);
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  MS_LOG(DEBUG) << "Succeed to map file, path: " << file_path << ", size: " << size_;
+  return Status::OK();
+#endif
+}
+
+void ShardMappedFile::Close() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    if (munmap(data_, static_cast<size_t>(size_)) != 0) {
+      MS_LOG(WARNING) << "Failed to unmap mindrecord file, errno: " << errno;
+    }
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+void ShardMappedFile::WillNeed(uint64_t offset, uint64_t length) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ == nullptr || !Contains(offset, length) || length == 0) {
+    return;
+  }
+  // madvise requires a page aligned start address
+  static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t aligned_offset = offset - offset % page_size;
+  (void)madvise(data_ + aligned_offset, static_cast<size_t>(length + offset - aligned_offset), MADV_WILLNEED);
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -1,5 +1,5 @@
 /**
- * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ * Copyright 2019-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -83,9 +83,14 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+    // the meta file is opened on demand when the binary index is available
+    std::shared_ptr<ShardBinaryIndex> binary_index;
     sqlite3 *db = nullptr;
-    RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    if (!LoadBinaryIndex(file, &binary_index)) {
+      RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    }
     database_paths_.push_back(db);
+    binary_indexes_.push_back(binary_index);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK_MR(sh.BuildDataset(file_paths_, load_dataset));
@@ -93,13 +98,16 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
   header_size_ = shard_header_->GetHeaderSize();
   page_size_ = shard_header_->GetPageSize();
   // version < 3.0
-  if ((*first_meta_data_ptr)["version"] < kVersion) {
+  if ((*first_meta_data_ptr)["version"] < kCompressBlobVersion) {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, false);
   } else {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
   }
+  raw_codec_ = std::make_shared<ShardRawCodec>(shard_header_->GetSchemas()[0]);
+  blob_compressed_ = shard_header_->GetBlobCompression() != kBlobCompressionNone;
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
+  RETURN_IF_NOT_OK_MR(CheckBinaryIndex(row_group_summary));
 
   // clear the shard_sample_count_, because it will be insert when Launch func
   shard_sample_count_.clear();
@@ -181,6 +189,60 @@ Status ShardReader::VerifyDataset(sqlite3 **db, const string &file) {
   return Status::OK();
 }
 
+bool ShardReader::LoadBinaryIndex(const std::string &file, std::shared_ptr<ShardBinaryIndex> *binary_index_ptr) {
+  std::string index_path = file + kBinaryIndexSuffix;
+  struct stat index_stat {};
+  if (stat(index_path.c_str(), &index_stat) != 0) {
+    return false;
+  }
+  auto binary_index = std::make_shared<ShardBinaryIndex>();
+  Status status = binary_index->Open(index_path);
+  if (status.IsError()) {
+    MS_LOG(WARNING) << "Failed to open binary index, the meta file will be used instead. " << status.ToString();
+    return false;
+  }
+  std::shared_ptr<std::string> fn_ptr;
+  if (GetFileName(file, &fn_ptr).IsError() || binary_index->GetShardName() != *fn_ptr) {
+    MS_LOG(WARNING) << "The binary index: " << index_path << " does not match the mindrecord file: " << file
+                    << ", the meta file will be used instead.";
+    return false;
+  }
+  MS_LOG(DEBUG) << "Succeed to open binary index, path: " << index_path << ".";
+  *binary_index_ptr = std::move(binary_index);
+  return true;
+}
+
+Status ShardReader::CheckBinaryIndex(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary) {
+  std::vector<uint64_t> shard_rows(binary_indexes_.size(), 0);
+  for (const auto &rg : row_group_summary) {
+    auto shard_id = static_cast<size_t>(std::get<0>(rg));
+    if (shard_id < shard_rows.size()) {
+      shard_rows[shard_id] += std::get<3>(rg);
+    }
+  }
+  for (size_t shard_id = 0; shard_id < binary_indexes_.size(); ++shard_id) {
+    if (binary_indexes_[shard_id] != nullptr && binary_indexes_[shard_id]->GetRowCount() != shard_rows[shard_id]) {
+      MS_LOG(WARNING) << "The binary index of mindrecord file: " << file_paths_[shard_id]
+                      << " is out of date, the meta file will be used instead.";
+      binary_indexes_[shard_id] = nullptr;
+      RETURN_IF_NOT_OK_MR(OpenDatabase(static_cast<int>(shard_id)));
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardReader::OpenDatabase(int shard_id) {
+  std::lock_guard<std::mutex> lck(database_locker_);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id >= 0 && shard_id < static_cast<int>(database_paths_.size()),
+                                  "[Internal ERROR] 'shard_id': " + std::to_string(shard_id) + " is out of range.");
+  if (database_paths_[shard_id] == nullptr) {
+    sqlite3 *db = nullptr;
+    RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file_paths_[shard_id]));
+    database_paths_[shard_id] = db;
+  }
+  return Status::OK();
+}
+
 Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   auto schema_ptr = GetShardHeader()->GetSchemas()[0];
   auto schema = schema_ptr->GetSchema()["schema"];
@@ -224,6 +286,28 @@ Status ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Succeed to open file, path: " << file;
   }
+  if (use_mmap_) {
+    auto rc = MapFiles();
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to map mindrecord files into memory, fall back to read them through file streams. "
+                      << rc.ToString();
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardReader::MapFiles() {
+  mapped_files_.clear();
+  for (const auto &file : file_paths_) {
+    auto mapped_file = std::make_shared<ShardMappedFile>();
+    auto rc = mapped_file->Open(file);
+    if (rc.IsError()) {
+      mapped_files_.clear();
+      return rc;
+    }
+    mapped_files_.push_back(mapped_file);
+  }
+  MS_LOG(INFO) << "Succeed to map " << mapped_files_.size() << " mindrecord files into memory.";
   return Status::OK();
 }
 
@@ -319,6 +403,8 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  // the mapping is released when the last view which refers to it is destroyed
+  mapped_files_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -417,29 +503,10 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
         uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
         uint64_t label_end = std::stoull(labels[i][5]);
         auto len = label_end - label_start;
-        auto label_raw = std::vector<uint8_t>(len);
-        auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-        if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-        }
-        auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-        if (!io_read.good() || io_read.fail() || io_read.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
-        }
-        json label_json = json::from_msgpack(label_raw);
-        json tmp;
-        if (!columns.empty()) {
-          for (const auto &col : columns) {
-            if (label_json.find(col) != label_json.end()) {
-              tmp[col] = label_json[col];
-            }
-          }
-        } else {
-          tmp = label_json;
-        }
-        (*col_val_ptr)[shard_id].emplace_back(tmp);
+        json label_json;
+        RETURN_IF_NOT_OK_MR(ReadRawLabel(shard_id, fs, page_size_ * raw_page_id + header_size_ + label_start, len,
+                                         columns, &label_json));
+        (*col_val_ptr)[shard_id].emplace_back(std::move(label_json));
       } else {
         json construct_json;
         RETURN_IF_NOT_OK_MR(ConvertJsonValue(labels[i], columns, schema, &construct_json));
@@ -462,6 +529,30 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
   return Status::OK();
 }
 
+Status ShardReader::ReadRawLabel(int shard_id, const std::shared_ptr<std::fstream> &fs, uint64_t file_offset,
+                                 uint64_t len, const std::vector<std::string> &columns, json *label_json) {
+  RETURN_UNEXPECTED_IF_NULL_MR(label_json);
+  if (!mapped_files_.empty()) {
+    const auto &mapped_file = mapped_files_[shard_id];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(mapped_file->Contains(file_offset, len),
+                                    "[Internal ERROR] The label is out of the range of file, path: " +
+                                      file_paths_[shard_id]);
+    return raw_codec_->Decode(mapped_file->GetData() + file_offset, len, columns, label_json);
+  }
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(file_offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file, path: " + file_paths_[shard_id]);
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file, path: " + file_paths_[shard_id]);
+  }
+  return raw_codec_->Decode(label_raw.data(), len, columns, label_json);
+}
+
 Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                                      const json &schema, json *value) {
   constexpr int64_t index = 3;
@@ -484,6 +575,7 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id,
                                        const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                                        std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+  RETURN_IF_NOT_OK_MR(OpenDatabase(shard_id));
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
@@ -504,6 +596,75 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id,
                             col_val_ptr);
 }
 
+Status ShardReader::ReadAllRowsInShardFromIndex(
+  int shard_id, const int32_t &consumer_id, int64_t sample_id, const std::vector<std::string> &columns,
+  std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+  std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  RETURN_UNEXPECTED_IF_NULL_MR(binary_index);
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  std::vector<int> field_ids;
+  if (all_in_index_) {
+    for (const auto &col : columns) {
+      int field_id = binary_index->GetFieldId(col + "_" + std::to_string(column_schema_id_[col]));
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field_id >= 0,
+                                      "[Internal ERROR] 'column': " + col + " can not found in the binary index.");
+      field_ids.push_back(field_id);
+    }
+  }
+  uint64_t begin = 0;
+  uint64_t end = binary_index->GetRowCount();
+  if (sample_id >= 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(sample_id) < end,
+                                    "[Internal ERROR] 'sample_id': " + std::to_string(sample_id) +
+                                      " is out of range of shard " + std::to_string(shard_id));
+    begin = static_cast<uint64_t>(sample_id);
+    end = begin + 1;
+  }
+  (*offset_ptr)[shard_id].reserve(end - begin);
+  (*col_val_ptr)[shard_id].reserve(end - begin);
+  try {
+    for (uint64_t row_id = begin; row_id < end; ++row_id) {
+      const auto &row = binary_index->GetRow(row_id);
+      (*offset_ptr)[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), row.row_group_id,
+                                                                 row.page_offset_blob + kInt64Len,
+                                                                 row.page_offset_blob_end});
+      if (!all_in_index_) {
+        uint64_t label_start = row.page_offset_raw + kInt64Len;
+        CHECK_FAIL_RETURN_UNEXPECTED_MR(label_start <= row.page_offset_raw_end,
+                                        "[Internal ERROR] The binary index of shard " + std::to_string(shard_id) +
+                                          " is broken at row " + std::to_string(row_id));
+        json label_json;
+        RETURN_IF_NOT_OK_MR(ReadRawLabel(shard_id, file_streams_random_[consumer_id][shard_id],
+                                         page_size_ * row.page_id_raw + header_size_ + label_start,
+                                         row.page_offset_raw_end - label_start, columns, &label_json));
+        (*col_val_ptr)[shard_id].emplace_back(std::move(label_json));
+      } else {
+        // the same layout as the result of the sql, the values start from the fourth column
+        std::vector<std::string> label(3);
+        for (int field_id : field_ids) {
+          label.emplace_back(binary_index->GetValue(field_id, row_id));
+        }
+        json construct_json;
+        RETURN_IF_NOT_OK_MR(ConvertJsonValue(label, columns, schema, &construct_json));
+        (*col_val_ptr)[shard_id].emplace_back(construct_json);
+      }
+    }
+  } catch (std::out_of_range &e) {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Exception raised in ReadAllRowsInShardFromIndex function, " +
+                                std::string(e.what()));
+  } catch (std::invalid_argument &e) {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Exception raised in ReadAllRowsInShardFromIndex function, " +
+                                std::string(e.what()));
+  } catch (...) {
+    RETURN_STATUS_UNEXPECTED_MR(
+      "[Internal ERROR] Unexpected exception raised in ReadAllRowsInShardFromIndex function.");
+  }
+  MS_LOG(DEBUG) << "Succeed to get " << (end - begin) << " records from shard " << std::to_string(shard_id)
+                << " binary index.";
+  return Status::OK();
+}
+
 Status ShardReader::GetAllClasses(const std::string &category_field,
                                   std::shared_ptr<std::set<std::string>> category_ptr) {
   std::map<std::string, uint64_t> index_columns;
@@ -517,9 +678,13 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::shared_ptr<std::string> fn_ptr;
   RETURN_IF_NOT_OK_MR(
     ShardIndexGenerator::GenerateFieldName(std::make_pair(index_columns[category_field], category_field), &fn_ptr));
+  if (GetClassesFromIndex(*fn_ptr, category_ptr)) {
+    return Status::OK();
+  }
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    RETURN_IF_NOT_OK_MR(OpenDatabase(x));
     threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
   }
 
@@ -529,6 +694,26 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   return Status::OK();
 }
 
+bool ShardReader::GetClassesFromIndex(const std::string &field_name,
+                                      std::shared_ptr<std::set<std::string>> category_ptr) {
+  if (std::any_of(binary_indexes_.begin(), binary_indexes_.end(),
+                  [](const std::shared_ptr<ShardBinaryIndex> &binary_index) { return binary_index == nullptr; })) {
+    return false;
+  }
+  std::set<std::string> categories;
+  for (const auto &binary_index : binary_indexes_) {
+    int field_id = binary_index->GetFieldId(field_name);
+    if (field_id < 0) {
+      return false;
+    }
+    auto values = binary_index->GetDistinctValues(field_id);
+    categories.insert(values.begin(), values.end());
+  }
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  category_ptr->insert(categories.begin(), categories.end());
+  return true;
+}
+
 void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                                     std::shared_ptr<std::set<std::string>> category_ptr) {
   if (db == nullptr) {
@@ -577,14 +762,23 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
+  std::vector<Status> thread_status(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] =
-      std::thread(&ShardReader::ReadAllRowsInShard, this, x, 0, sql, columns, offset_ptr, col_val_ptr);
+    thread_read_db[x] = std::thread([this, x, &sql, &columns, &offset_ptr, &col_val_ptr, &thread_status]() {
+      if (binary_indexes_[x] != nullptr) {
+        thread_status[x] = ReadAllRowsInShardFromIndex(x, 0, -1, columns, offset_ptr, col_val_ptr);
+      } else {
+        thread_status[x] = ReadAllRowsInShard(x, 0, sql, columns, offset_ptr, col_val_ptr);
+      }
+    });
   }
 
   for (int x = 0; x < shard_count_; x++) {
     thread_read_db[x].join();
   }
+  for (const auto &status : thread_status) {
+    RETURN_IF_NOT_OK_MR(status);
+  }
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -597,6 +791,12 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
+  if (binary_indexes_[shard_id] != nullptr) {
+    RETURN_IF_NOT_OK_MR(
+      ReadAllRowsInShardFromIndex(shard_id, consumer_id, sample_id, columns, offset_ptr, col_val_ptr));
+    *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
+    return Status::OK();
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -668,8 +868,53 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
   return 0;
 }
 
+Status ShardReader::GetRowsFromIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                     std::vector<uint64_t> *row_ids) {
+  RETURN_UNEXPECTED_IF_NULL_MR(row_ids);
+  const auto &binary_index = binary_indexes_[shard_id];
+  RETURN_UNEXPECTED_IF_NULL_MR(binary_index);
+  int field_id = -1;
+  if (!criteria.first.empty()) {
+    field_id = binary_index->GetFieldId(criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      field_id >= 0, "[Internal ERROR] 'column': " + criteria.first + " can not found in the binary index.");
+  }
+  // the rows of a blob page are continuous
+  std::shared_ptr<Page> page_ptr;
+  RETURN_IF_NOT_OK_MR(shard_header_->GetPage(shard_id, page_id, &page_ptr));
+  uint64_t end_row_id = std::min(static_cast<uint64_t>(page_ptr->GetEndRowID()), binary_index->GetRowCount());
+  for (uint64_t row_id = page_ptr->GetStartRowID(); row_id < end_row_id; ++row_id) {
+    if (binary_index->GetRow(row_id).page_id_blob != static_cast<uint64_t>(page_id)) {
+      continue;
+    }
+    if (field_id < 0 || binary_index->ValueEquals(field_id, row_id, criteria.second)) {
+      row_ids->push_back(row_id);
+    }
+  }
+  return Status::OK();
+}
+
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (binary_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> row_ids;
+    Status status = GetRowsFromIndex(page_id, shard_id, criteria, &row_ids);
+    if (status.IsError()) {
+      MS_LOG(ERROR) << status.ToString();
+      return std::vector<std::vector<uint64_t>>();
+    }
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row_id : row_ids) {
+      const auto &row = binary_indexes_[shard_id]->GetRow(row_id);
+      res.emplace_back(std::vector<uint64_t>{row.page_offset_blob + kInt64Len, row.page_offset_blob_end});
+    }
+    return res;
+  }
+  Status open_status = OpenDatabase(shard_id);
+  if (open_status.IsError()) {
+    MS_LOG(ERROR) << open_status.ToString();
+    return std::vector<std::vector<uint64_t>>();
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -718,6 +963,26 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(pages_ptr);
+  const auto &binary_index = binary_indexes_[shard_id];
+  if (binary_index != nullptr) {
+    std::vector<uint64_t> page_ids;
+    if (!criteria.first.empty()) {
+      int field_id = binary_index->GetFieldId(criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]));
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(
+        field_id >= 0, "[Internal ERROR] 'column': " + criteria.first + " can not found in the binary index.");
+      page_ids = binary_index->GetPagesByValue(field_id, criteria.second);
+    } else {
+      for (uint64_t row_id = 0; row_id < binary_index->GetRowCount(); ++row_id) {
+        page_ids.push_back(binary_index->GetRow(row_id).page_id_blob);
+      }
+      std::sort(page_ids.begin(), page_ids.end());
+      page_ids.erase(std::unique(page_ids.begin(), page_ids.end()), page_ids.end());
+    }
+    (void)(*pages_ptr)->insert((*pages_ptr)->end(), page_ids.begin(), page_ids.end());
+    MS_LOG(DEBUG) << "Succeed to get " << page_ids.size() << " pages from binary index.";
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK_MR(OpenDatabase(shard_id));
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -828,20 +1093,9 @@ Status ShardReader::GetLabelsFromBinaryFile(int shard_id, const std::vector<std:
     uint64_t label_end = std::stoull(labelOffset[2]);
     int raw_page_id = std::stoi(labelOffset[0]);
     auto len = label_end - label_start;
-    auto label_raw = std::vector<uint8_t>(len);
-    auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-      fs->close();
-      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file, path: " + file_paths_[shard_id]);
-    }
-
-    auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-    if (!io_read.good() || io_read.fail() || io_read.bad()) {
-      fs->close();
-      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file, path: " + file_paths_[shard_id]);
-    }
-
-    json label_json = json::from_msgpack(label_raw);
+    json label_json;
+    RETURN_IF_NOT_OK_MR(
+      ReadRawLabel(shard_id, fs, page_size_ * raw_page_id + header_size_ + label_start, len, {}, &label_json));
     json tmp = label_json;
     for (auto &col : columns) {
       if (label_json.find(col) != label_json.end()) {
@@ -856,7 +1110,19 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
                                       const std::pair<std::string, std::string> &criteria,
                                       std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
+  if (binary_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> row_ids;
+    RETURN_IF_NOT_OK_MR(GetRowsFromIndex(page_id, shard_id, criteria, &row_ids));
+    std::vector<std::vector<std::string>> label_offsets;
+    for (auto row_id : row_ids) {
+      const auto &row = binary_indexes_[shard_id]->GetRow(row_id);
+      label_offsets.emplace_back(std::vector<std::string>{
+        std::to_string(row.page_id_raw), std::to_string(row.page_offset_raw), std::to_string(row.page_offset_raw_end)});
+    }
+    return GetLabelsFromBinaryFile(shard_id, columns, label_offsets, labels_ptr);
+  }
   // get page info from sqlite
+  RETURN_IF_NOT_OK_MR(OpenDatabase(shard_id));
   auto db = database_paths_[shard_id];
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
@@ -889,39 +1155,60 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
                               std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
   if (all_in_index_) {
-    auto db = database_paths_[shard_id];
-    std::string fields;
-    for (unsigned int i = 0; i < columns.size(); ++i) {
-      if (i > 0) {
-        fields += ',';
-      }
-      uint64_t schema_id = column_schema_id_[columns[i]];
-      fields += columns[i] + "_" + std::to_string(schema_id);
-    }
-    if (fields.empty()) {
-      fields = "*";
-    }
     auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
-    std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
-    if (!criteria.first.empty()) {
-      sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
-      RETURN_IF_NOT_OK_MR(QueryWithCriteria(db, sql, criteria.second, labels));
+    if (binary_indexes_[shard_id] != nullptr) {
+      std::vector<uint64_t> row_ids;
+      RETURN_IF_NOT_OK_MR(GetRowsFromIndex(page_id, shard_id, criteria, &row_ids));
+      std::vector<int> field_ids;
+      for (const auto &col : columns) {
+        int field_id = binary_indexes_[shard_id]->GetFieldId(col + "_" + std::to_string(column_schema_id_[col]));
+        CHECK_FAIL_RETURN_UNEXPECTED_MR(field_id >= 0,
+                                        "[Internal ERROR] 'column': " + col + " can not found in the binary index.");
+        field_ids.push_back(field_id);
+      }
+      for (auto row_id : row_ids) {
+        std::vector<std::string> label;
+        for (int field_id : field_ids) {
+          label.emplace_back(binary_indexes_[shard_id]->GetValue(field_id, row_id));
+        }
+        labels->emplace_back(std::move(label));
+      }
     } else {
-      sql += ";";
-      char *errmsg = nullptr;
-      int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, labels.get(), &errmsg);
-      if (rc != SQLITE_OK) {
-        std::ostringstream oss;
-        oss << "[Internal ERROR] Failed to execute the sql [ " << common::SafeCStr(sql)
-            << " ] while reading meta file, " << errmsg;
-        sqlite3_free(errmsg);
-        sqlite3_close(db);
-        db = nullptr;
-        RETURN_STATUS_UNEXPECTED_MR(oss.str());
+      RETURN_IF_NOT_OK_MR(OpenDatabase(shard_id));
+      auto db = database_paths_[shard_id];
+      std::string fields;
+      for (unsigned int i = 0; i < columns.size(); ++i) {
+        if (i > 0) {
+          fields += ',';
+        }
+        uint64_t schema_id = column_schema_id_[columns[i]];
+        fields += columns[i] + "_" + std::to_string(schema_id);
+      }
+      if (fields.empty()) {
+        fields = "*";
+      }
+      std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
+      if (!criteria.first.empty()) {
+        sql +=
+          " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
+        RETURN_IF_NOT_OK_MR(QueryWithCriteria(db, sql, criteria.second, labels));
       } else {
-        MS_LOG(DEBUG) << "Succeed to get " << labels->size() << " records from index.";
+        sql += ";";
+        char *errmsg = nullptr;
+        int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, labels.get(), &errmsg);
+        if (rc != SQLITE_OK) {
+          std::ostringstream oss;
+          oss << "[Internal ERROR] Failed to execute the sql [ " << common::SafeCStr(sql)
+              << " ] while reading meta file, " << errmsg;
+          sqlite3_free(errmsg);
+          sqlite3_close(db);
+          db = nullptr;
+          RETURN_STATUS_UNEXPECTED_MR(oss.str());
+        } else {
+          MS_LOG(DEBUG) << "Succeed to get " << labels->size() << " records from index.";
+        }
+        sqlite3_free(errmsg);
       }
-      sqlite3_free(errmsg);
     }
     for (unsigned int i = 0; i < labels->size(); ++i) {
       (*labels_ptr)->emplace_back(json{});
@@ -973,9 +1260,12 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::shared_ptr<std::string> fn_ptr;
   (void)ShardIndexGenerator::GenerateFieldName(std::make_pair(map_schema_id_fields[category_field], category_field),
                                                &fn_ptr);
+  auto category_ptr = std::make_shared<std::set<std::string>>();
+  if (GetClassesFromIndex(*fn_ptr, category_ptr)) {
+    return category_ptr->size();
+  }
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
-  auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
     std::string path_utf8 = "";
@@ -1352,9 +1642,13 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+Status ShardReader::GetBlobLocation(int64_t task_id, uint32_t consumer_id, TaskType *task_type, uint32_t *shard_id,
+                                    uint64_t *file_offset, uint64_t *blob_size, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_type);
+  RETURN_UNEXPECTED_IF_NULL_MR(shard_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(file_offset);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_size);
+  RETURN_UNEXPECTED_IF_NULL_MR(var_fields);
   if (load_mode_ == LoadMode::kFast || load_mode_ == LoadMode::kLazy) {
     // All tasks are done
     CHECK_FAIL_RETURN_UNEXPECTED_MR(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
@@ -1366,23 +1660,19 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
         " is out of bound: " + std::to_string(num_padded_ + shard_sample_count_[shard_sample_count_.size() - 1]));
   }
 
-  uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (load_mode_ == LoadMode::kLazy || load_mode_ == LoadMode::kSlow) {
     // get scalar variable fields by sample id
@@ -1391,40 +1681,74 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     // read the meta from index
     std::shared_ptr<ROW_GROUPS> row_group_ptr;
     RETURN_IF_NOT_OK_MR(
-      ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
+      ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];        // group_id
+    blob_start = offsets[*shard_id][0][2];      // blob start
+    blob_end = offsets[*shard_id][0][3];        // blob end
+    *var_fields = local_columns[*shard_id][0];  // scalar variable field
   } else {
-    group_id = std::get<1>(std::get<1>(task));  // group id
-    blob_start = std::get<2>(task)[0];          // blob start
-    blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    group_id = std::get<1>(std::get<1>(task));   // group id
+    blob_start = std::get<2>(task)[0];           // blob start
+    blob_end = std::get<2>(task)[1];             // blob end
+    *var_fields = std::move(std::get<3>(task));  // scalar variable field
   }
 
   // read the blob from data file
   std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
+  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, *shard_id, &page_ptr));
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *blob_size = blob_end - blob_start;
+  return Status::OK();
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetBlobLocation(task_id, consumer_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return Status::OK();
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+
+  // Pack image list
+  std::vector<uint8_t> images(blob_size);
+  if (!mapped_files_.empty()) {
+    const auto &mapped_file = mapped_files_[shard_id];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(mapped_file->Contains(file_offset, blob_size),
+                                    "[Internal ERROR] The blob is out of the range of file, path: " +
+                                      file_paths_[shard_id]);
+    (void)std::copy(mapped_file->GetData() + file_offset, mapped_file->GetData() + file_offset + blob_size,
+                    images.begin());
+  } else {
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+    }
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_size);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+    }
+  }
+
+  // every consumer decompresses its own samples, so the blobs are decompressed in parallel
+  if (blob_compressed_) {
+    std::vector<uint8_t> uncompressed;
+    RETURN_IF_NOT_OK_MR(ShardBlobCodec::Decompress(images.data(), images.size(), &uncompressed));
+    images = std::move(uncompressed);
   }
 
   // Deliver batch data to output map
@@ -1520,6 +1844,65 @@ Status ShardReader::GetNextById(const int64_t &task_id, const int32_t &consumer_
   return Status::OK();
 }
 
+Status ShardReader::GetNextViewById(const int64_t &task_id, const int32_t &consumer_id,
+                                    std::shared_ptr<TASK_CONTENT_VIEW> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  if (interrupt_) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!mapped_files_.empty(),
+                                  "[Internal ERROR] Rows can only be read as views when mmap mode is enabled.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!blob_compressed_,
+                                  "[Internal ERROR] Rows can not be read as views when the blob is compressed.");
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetBlobLocation(task_id, consumer_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT_VIEW>(TaskType::kPaddedTask, std::vector<std::tuple<ShardBlobView, json>>());
+    return Status::OK();
+  }
+
+  const auto &mapped_file = mapped_files_[shard_id];
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(mapped_file->Contains(file_offset, blob_size),
+                                  "[Internal ERROR] The blob is out of the range of file, path: " +
+                                    file_paths_[shard_id]);
+  std::vector<std::tuple<ShardBlobView, json>> batch;
+  batch.emplace_back(ShardBlobView{mapped_file->GetData() + file_offset, blob_size, mapped_file},
+                     std::move(var_fields));
+  *task_content_ptr = std::make_shared<TASK_CONTENT_VIEW>(TaskType::kCommonTask, std::move(batch));
+  return Status::OK();
+}
+
+void ShardReader::PrefetchByIds(const std::vector<int64_t> &task_ids) {
+  // the location of blobs is known without querying the index in fast load mode only
+  if (mapped_files_.empty() || load_mode_ != LoadMode::kFast) {
+    return;
+  }
+  for (const auto &task_id : task_ids) {
+    if (task_id < 0 || task_id >= static_cast<int64_t>(tasks_.task_list_.size())) {
+      continue;
+    }
+    const auto &task_info = tasks_.task_list_[task_id];
+    if (std::get<0>(task_info) == TaskType::kPaddedTask) {
+      continue;
+    }
+    auto shard_id = std::get<0>(std::get<1>(task_info));
+    auto group_id = std::get<1>(std::get<1>(task_info));
+    const auto &blob_offset = std::get<0>(tasks_.sample_meta_list_[task_id]);
+    std::shared_ptr<Page> page_ptr;
+    if (shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr).IsError()) {
+      continue;
+    }
+    mapped_files_[shard_id]->WillNeed(header_size_ + page_size_ * page_ptr->GetPageID() + blob_offset[0],
+                                      blob_offset[1] - blob_offset[0]);
+  }
+}
+
 Status ShardReader::UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                                    std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(blob_data_ptr);
@@ -35,6 +35,7 @@ Status ShardSegment::GetCategoryFields(std::shared_ptr<vector<std::string>> *fie
 
   std::string sql = "PRAGMA table_info(INDEXES);";
   std::vector<std::vector<std::string>> field_names;
+  RETURN_IF_NOT_OK_MR(OpenDatabase(0));
 
   char *errmsg = nullptr;
   int rc = sqlite3_exec(database_paths_[0], common::SafeCStr(sql), SelectCallback, &field_names, &errmsg);
@@ -96,7 +97,9 @@ Status ShardSegment::WrapCategoryInfo(std::shared_ptr<CATEGORY_INFO> *category_i
   std::string sql = "SELECT " + current_category_field_ + ", COUNT(" + current_category_field_ +
                     ") AS `value_occurrence` FROM indexes GROUP BY " + current_category_field_ + ";";
 
-  for (auto &db : database_paths_) {
+  for (int shard_id = 0; shard_id < static_cast<int>(database_paths_.size()); ++shard_id) {
+    RETURN_IF_NOT_OK_MR(OpenDatabase(shard_id));
+    auto &db = database_paths_[shard_id];
     std::vector<std::vector<std::string>> field_count;
 
     char *errmsg = nullptr;
@@ -215,6 +218,11 @@ Status ShardSegment::PackImages(int group_id, int shard_id, std::vector<uint64_t
     file_streams_random_[0][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("Failed to read file.");
   }
+  if (blob_compressed_) {
+    std::vector<uint8_t> uncompressed;
+    RETURN_IF_NOT_OK_MR(ShardBlobCodec::Decompress((*images_ptr)->data(), (*images_ptr)->size(), &uncompressed));
+    **images_ptr = std::move(uncompressed);
+  }
   return Status::OK();
 }
 
@@ -23,7 +23,12 @@
 namespace mindspore {
 namespace mindrecord {
 ShardWriter::ShardWriter()
-    : shard_count_(1), header_size_(kDefaultHeaderSize), page_size_(kDefaultPageSize), row_count_(0), schema_count_(1) {
+    : shard_count_(1),
+      header_size_(kDefaultHeaderSize),
+      page_size_(kDefaultPageSize),
+      blob_compression_(kBlobCompressionNone),
+      row_count_(0),
+      schema_count_(1) {
   compression_size_ = 0;
 }
 
@@ -103,6 +108,12 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // the binary index is regenerated along with the meta file, a stale one must not be left behind
+          auto index_file = whole_path.value() + kBinaryIndexSuffix;
+          if (std::remove(index_file.c_str()) == 0) {
+            MS_LOG(WARNING) << "Succeed to remove the old mindrecord binary index files, path: "
+                            << file + kBinaryIndexSuffix;
+          }
         } else {
           RETURN_STATUS_UNEXPECTED_MR(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
@@ -187,6 +198,8 @@ Status ShardWriter::OpenForAppend(const std::string &path) {
   RETURN_IF_NOT_OK_MR(SetHeaderSize(shard_header_->GetHeaderSize()));
   RETURN_IF_NOT_OK_MR(SetPageSize(shard_header_->GetPageSize()));
   compression_size_ = shard_header_->GetCompressionSize();
+  blob_compression_ = shard_header_->GetBlobCompression();
+  is_append_ = true;
   RETURN_IF_NOT_OK_MR(Open(*ds, true));
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
   return Status::OK();
@@ -238,6 +251,7 @@ Status ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data) {
   shard_header_ = header_data;
   shard_header_->SetHeaderSize(header_size_);
   shard_header_->SetPageSize(page_size_);
+  shard_header_->SetBlobCompression(blob_compression_);
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
   return Status::OK();
 }
@@ -266,6 +280,19 @@ Status ShardWriter::SetPageSize(const uint64_t &page_size) {
   return Status::OK();
 }
 
+Status ShardWriter::SetBlobCompression(const std::string &blob_compression) {
+  RETURN_IF_NOT_OK_MR(ShardBlobCodec::CheckCodec(blob_compression));
+  // the blob of all the samples in the files must be written by the same codec
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(!is_append_ || blob_compression_ == blob_compression,
+                                  "Invalid data, blob compression can not be changed to " + blob_compression +
+                                    " when appending to mindrecord files written with " + blob_compression_ + ".");
+  blob_compression_ = blob_compression;
+  if (shard_header_ != nullptr) {
+    shard_header_->SetBlobCompression(blob_compression_);
+  }
+  return Status::OK();
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -469,7 +496,8 @@ Status ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_d
 }
 
 void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                            std::vector<std::vector<uint8_t>> &bin_data) {
+                            std::vector<std::vector<uint8_t>> &bin_data,
+                            const std::map<uint64_t, std::shared_ptr<ShardRawCodec>> &codecs) {
   // Prevent excessive thread opening and cause cross-border
   if (start >= end) {
     flag_ = true;
@@ -481,10 +509,13 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
     int cnt = 0;
     for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
       const json &line = raw_data.at(rawdata_iter->first)[x];
-      std::vector<std::uint8_t> bline = json::to_msgpack(line);
-
       // Storage form is [Sample1-Schema1, Sample1-Schema2, Sample2-Schema1, Sample2-Schema2]
-      bin_data[x * schema_count + cnt] = bline;
+      auto codec = codecs.find(rawdata_iter->first);
+      if (codec != codecs.end()) {
+        codec->second->Encode(line, &bin_data[x * schema_count + cnt]);
+      } else {
+        bin_data[x * schema_count + cnt] = json::to_msgpack(line);
+      }
       cnt++;
     }
   }
@@ -584,6 +615,49 @@ Status ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>> &
   RETURN_IF_NOT_OK_MR(ValidateRawData(raw_data, blob_data, sign, &count_ptr));
   *schema_count = (*count_ptr).first;
   *row_count = (*count_ptr).second;
+
+  // compress the blob of every sample by the codec in header
+  if (shard_header_->GetBlobCompression() != kBlobCompressionNone) {
+    RETURN_IF_NOT_OK_MR(CompressBlobData(&blob_data));
+  }
+  return Status::OK();
+}
+
+Status ShardWriter::CompressBlobData(std::vector<std::vector<uint8_t>> *blob_data) {
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_data);
+  auto codec = shard_header_->GetBlobCompression();
+  uint32_t thread_num = std::thread::hardware_concurrency();
+  if (thread_num == 0) {
+    thread_num = kThreadNumber;
+  }
+  thread_num = std::min(thread_num, static_cast<uint32_t>(kMaxThreadCount));
+  uint64_t row_count = blob_data->size();
+  uint64_t group_num = (row_count + thread_num - 1) / thread_num;
+  std::vector<std::thread> thread_set;
+  std::vector<Status> thread_status(thread_num);
+  std::vector<int64_t> saved_bytes(thread_num, 0);
+  for (uint32_t x = 0; x < thread_num && x * group_num < row_count; ++x) {
+    uint64_t start = x * group_num;
+    uint64_t end = std::min(start + group_num, row_count);
+    thread_set.emplace_back([blob_data, &codec, &thread_status, &saved_bytes, x, start, end]() {
+      for (uint64_t i = start; i < end; ++i) {
+        std::vector<uint8_t> compressed;
+        thread_status[x] = ShardBlobCodec::Compress(codec, (*blob_data)[i], &compressed);
+        if (thread_status[x].IsError()) {
+          return;
+        }
+        saved_bytes[x] += static_cast<int64_t>((*blob_data)[i].size()) - static_cast<int64_t>(compressed.size());
+        (*blob_data)[i] = std::move(compressed);
+      }
+    });
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  for (uint32_t x = 0; x < thread_num; ++x) {
+    RETURN_IF_NOT_OK_MR(thread_status[x]);
+    compression_size_ += saved_bytes[x];
+  }
   return Status::OK();
 }
 Status ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
@@ -641,7 +715,7 @@ Status ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data
   }
   std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
   // Serialize raw data
-  RETURN_IF_NOT_OK_MR(SerializeRawData(raw_data, bin_raw_data, row_count));
+  RETURN_IF_NOT_OK_MR(SerializeRawData(raw_data, bin_raw_data, row_count, true));
   // Set row size of raw data
   RETURN_IF_NOT_OK_MR(SetRawDataSize(bin_raw_data));
   // Set row size of blob data
@@ -1097,7 +1171,16 @@ Status ShardWriter::WriteShardHeader() {
 }
 
 Status ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                                     std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count) {
+                                     std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                                     bool typed_encoding) {
+  std::map<uint64_t, std::shared_ptr<ShardRawCodec>> codecs;
+  if (typed_encoding) {
+    for (const auto &item : raw_data) {
+      std::shared_ptr<Schema> schema_ptr;
+      RETURN_IF_NOT_OK_MR(shard_header_->GetSchemaByID(item.first, &schema_ptr));
+      codecs[item.first] = std::make_shared<ShardRawCodec>(schema_ptr);
+    }
+  }
   // define the number of thread
   uint32_t thread_num = std::thread::hardware_concurrency();
   if (thread_num == 0) {
@@ -1115,7 +1198,8 @@ Status ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_
     }
     // Define the run boundary and start the child thread
     thread_set[x] =
-      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data));
+      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data),
+                  std::cref(codecs));
     work_thread_num++;
   }
   for (uint32_t x = 0; x < work_thread_num; ++x) {
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_blob_codec.h"
+
+#include <cstring>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <zlib.h>
+#endif
+
+namespace mindspore {
+namespace mindrecord {
+Status ShardBlobCodec::CheckCodec(const std::string &codec) {
+  if (codec == kBlobCompressionNone) {
+    return Status::OK();
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (codec == kBlobCompressionZlib) {
+    return Status::OK();
+  }
+#endif
+  RETURN_STATUS_UNEXPECTED_MR("Invalid data, blob compression: " + codec +
+                              " is not supported, it should be 'none' or 'zlib', and 'zlib' is not supported on "
+                              "Windows.");
+}
+
+Status ShardBlobCodec::Compress(const std::string &codec, const std::vector<uint8_t> &input,
+                                std::vector<uint8_t> *output) {
+  RETURN_UNEXPECTED_IF_NULL_MR(output);
+  RETURN_IF_NOT_OK_MR(CheckCodec(codec));
+  uint64_t raw_size = input.size();
+  Method method = kMethodStored;
+  uint64_t payload_size = raw_size;
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (codec == kBlobCompressionZlib && raw_size > 0) {
+    auto bound = compressBound(static_cast<uLong>(raw_size));
+    output->resize(kHeaderSize + bound);
+    uLongf compressed_size = bound;
+    int ret = compress2(output->data() + kHeaderSize, &compressed_size, input.data(), static_cast<uLong>(raw_size),
+                        Z_DEFAULT_COMPRESSION);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == Z_OK, "[Internal ERROR] Failed to compress blob by zlib, error code: " +
+                                                   std::to_string(ret));
+    if (compressed_size < raw_size) {
+      method = kMethodZlib;
+      payload_size = compressed_size;
+    }
+  }
+#endif
+  output->resize(kHeaderSize + payload_size);
+  if (method == kMethodStored && raw_size > 0) {
+    (void)memcpy(output->data() + kHeaderSize, input.data(), raw_size);
+  }
+  (void)memcpy(output->data(), &raw_size, sizeof(uint64_t));
+  (*output)[sizeof(uint64_t)] = method;
+  return Status::OK();
+}
+
+Status ShardBlobCodec::Decompress(const uint8_t *data, uint64_t size, std::vector<uint8_t> *output) {
+  RETURN_UNEXPECTED_IF_NULL_MR(data);
+  RETURN_UNEXPECTED_IF_NULL_MR(output);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(size >= kHeaderSize,
+                                  "Invalid data, the compressed blob is truncated, size: " + std::to_string(size));
+  uint64_t raw_size = 0;
+  (void)memcpy(&raw_size, data, sizeof(uint64_t));
+  uint8_t method = data[sizeof(uint64_t)];
+  const uint8_t *payload = data + kHeaderSize;
+  uint64_t payload_size = size - kHeaderSize;
+  if (method == kMethodStored) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(payload_size == raw_size, "Invalid data, the stored blob is truncated.");
+    output->assign(payload, payload + payload_size);
+    return Status::OK();
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (method == kMethodZlib) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(raw_size <= payload_size * kMaxZlibRatio,
+                                    "Invalid data, the raw size: " + std::to_string(raw_size) +
+                                      " of the compressed blob is larger than its payload size: " +
+                                      std::to_string(payload_size) + " can hold.");
+    output->resize(raw_size);
+    uLongf uncompressed_size = static_cast<uLongf>(raw_size);
+    int ret = uncompress(output->data(), &uncompressed_size, payload, static_cast<uLong>(payload_size));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == Z_OK && uncompressed_size == raw_size,
+                                    "Invalid data, failed to decompress blob by zlib, error code: " +
+                                      std::to_string(ret));
+    return Status::OK();
+  }
+#endif
+  RETURN_STATUS_UNEXPECTED_MR("Invalid data, the compression method: " + std::to_string(method) +
+                              " of blob is not supported.");
+}
+}  // namespace mindrecord
+}  // namespace mindspore
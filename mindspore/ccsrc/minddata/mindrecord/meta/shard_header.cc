@@ -24,13 +24,15 @@
 
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
+#include "minddata/mindrecord/include/shard_blob_codec.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_page.h"
 
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0) {
+ShardHeader::ShardHeader()
+    : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0), blob_compression_(kBlobCompressionNone) {
   index_ = std::make_shared<Index>();
 }
 
@@ -48,6 +50,9 @@ Status ShardHeader::InitializeHeader(const std::vector<json> &headers, bool load
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
       compression_size_ = header.contains("compression_size") ? header["compression_size"].get<uint64_t>() : 0;
+      blob_compression_ =
+        header.contains("blob_compression") ? header["blob_compression"].get<std::string>() : kBlobCompressionNone;
+      RETURN_IF_NOT_OK_MR(ShardBlobCodec::CheckCodec(blob_compression_));
     }
     RETURN_IF_NOT_OK_MR(ParsePage(header["page"], shard_index, load_dataset));
     shard_index++;
@@ -143,10 +148,14 @@ Status ShardHeader::BuildSingleHeader(const std::string &file_path, std::shared_
   RETURN_IF_NOT_OK_MR(ValidateHeader(file_path, &raw_header));
   uint64_t compression_size =
     raw_header->contains("compression_size") ? (*raw_header)["compression_size"].get<uint64_t>() : 0;
+  std::string blob_compression = raw_header->contains("blob_compression")
+                                   ? (*raw_header)["blob_compression"].get<std::string>()
+                                   : kBlobCompressionNone;
   json header = {{"shard_addresses", (*raw_header)["shard_addresses"]},
                  {"header_size", (*raw_header)["header_size"]},
                  {"page_size", (*raw_header)["page_size"]},
                  {"compression_size", compression_size},
+                 {"blob_compression", blob_compression},
                  {"index_fields", (*raw_header)["index_fields"]},
                  {"blob_fields", (*raw_header)["schema"][0]["blob_fields"]},
                  {"schema", (*raw_header)["schema"][0]["schema"]},
@@ -329,6 +338,7 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
       s += "\"compression_size\":" + std::to_string(compression_size_) + ",";
+      s += "\"blob_compression\":\"" + blob_compression_ + "\",";
       s += "\"schema\":" + schema + ",";
       s += "\"shard_addresses\":" + address + ",";
       s += "\"shard_id\":" + std::to_string(shardId) + ",";
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_raw_codec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace mindspore {
+namespace mindrecord {
+ShardRawCodec::ShardRawCodec(const std::shared_ptr<Schema> &schema) {
+  if (schema == nullptr) {
+    typed_supported_ = false;
+    return;
+  }
+  json fields = schema->GetSchema()["schema"];
+  auto blob_fields = schema->GetBlobFields();
+  for (auto it = fields.begin(); it != fields.end(); ++it) {
+    if (std::find(blob_fields.begin(), blob_fields.end(), it.key()) != blob_fields.end()) {
+      continue;
+    }
+    std::string type = it.value().contains("type") ? it.value()["type"].get<std::string>() : "";
+    if (type == "int32") {
+      numeric_columns_.push_back(Column{it.key(), kKindInt32, numeric_size_});
+      numeric_size_ += sizeof(int32_t);
+    } else if (type == "int64") {
+      numeric_columns_.push_back(Column{it.key(), kKindInt64, numeric_size_});
+      numeric_size_ += sizeof(int64_t);
+    } else if (type == "float32" || type == "float64") {
+      numeric_columns_.push_back(Column{it.key(), kKindFloat, numeric_size_});
+      numeric_size_ += sizeof(double);
+    } else if (type == "string") {
+      string_columns_.push_back(Column{it.key(), kKindString, 0});
+    } else {
+      typed_supported_ = false;
+    }
+  }
+}
+
+void ShardRawCodec::Encode(const json &row, std::vector<uint8_t> *output) const {
+  if (!EncodeTyped(row, output)) {
+    *output = json::to_msgpack(row);
+  }
+}
+
+bool ShardRawCodec::EncodeTyped(const json &row, std::vector<uint8_t> *output) const {
+  if (!typed_supported_ || !row.is_object() || row.size() != numeric_columns_.size() + string_columns_.size()) {
+    return false;
+  }
+  uint64_t total_size = kHeaderSize + numeric_size_;
+  for (const auto &column : string_columns_) {
+    auto it = row.find(column.name);
+    if (it == row.end() || !it->is_string() ||
+        it->get_ref<const std::string &>().size() > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    total_size += sizeof(uint32_t) + it->get_ref<const std::string &>().size();
+  }
+
+  output->assign(total_size, 0);
+  uint8_t *numeric = output->data() + kHeaderSize;
+  for (const auto &column : numeric_columns_) {
+    auto it = row.find(column.name);
+    if (it == row.end()) {
+      return false;
+    }
+    if (column.kind == kKindFloat) {
+      // integers are kept in msgpack so that they are read back as integers
+      if (!it->is_number_float()) {
+        return false;
+      }
+      double value = it->get<double>();
+      (void)memcpy(numeric + column.offset, &value, sizeof(double));
+      continue;
+    }
+    if (!it->is_number_integer()) {
+      return false;
+    }
+    if (it->is_number_unsigned() && it->get<uint64_t>() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return false;
+    }
+    int64_t value = it->get<int64_t>();
+    if (column.kind == kKindInt64) {
+      (void)memcpy(numeric + column.offset, &value, sizeof(int64_t));
+      continue;
+    }
+    if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+    auto value_int32 = static_cast<int32_t>(value);
+    (void)memcpy(numeric + column.offset, &value_int32, sizeof(int32_t));
+  }
+
+  uint8_t *strings = numeric + numeric_size_;
+  for (const auto &column : string_columns_) {
+    const auto &value = row[column.name].get_ref<const std::string &>();
+    auto length = static_cast<uint32_t>(value.size());
+    (void)memcpy(strings, &length, sizeof(uint32_t));
+    strings += sizeof(uint32_t);
+    if (length > 0) {
+      (void)memcpy(strings, value.data(), length);
+      strings += length;
+    }
+  }
+  (*output)[0] = kTypedMarker;
+  (*output)[1] = kCodecVersion;
+  return true;
+}
+
+Status ShardRawCodec::Decode(const uint8_t *data, uint64_t size, json *row) const {
+  return Decode(data, size, {}, row);
+}
+
+Status ShardRawCodec::Decode(const uint8_t *data, uint64_t size, const std::vector<std::string> &columns,
+                             json *row) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(data);
+  RETURN_UNEXPECTED_IF_NULL_MR(row);
+  if (!IsTyped(data, size)) {
+    json full_row;
+    try {
+      full_row = json::from_msgpack(data, data + size);
+    } catch (const std::exception &e) {
+      RETURN_STATUS_UNEXPECTED_MR("Invalid data, failed to parse the raw data of the sample, " + std::string(e.what()));
+    }
+    if (columns.empty()) {
+      *row = std::move(full_row);
+      return Status::OK();
+    }
+    *row = json::object();
+    for (const auto &name : columns) {
+      auto it = full_row.find(name);
+      if (it != full_row.end()) {
+        (*row)[name] = std::move(*it);
+      }
+    }
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(typed_supported_ && size >= kHeaderSize + numeric_size_,
+                                  "Invalid data, the raw data of the sample does not match the schema.");
+  std::vector<std::pair<const char *, uint32_t>> strings;
+  RETURN_IF_NOT_OK_MR(FindStrings(data, size, &strings));
+  const uint8_t *numeric = data + kHeaderSize;
+  *row = json::object();
+  if (columns.empty()) {
+    for (const auto &column : numeric_columns_) {
+      DecodeNumeric(numeric, column, row);
+    }
+    for (size_t i = 0; i < string_columns_.size(); ++i) {
+      (*row)[string_columns_[i].name] = std::string(strings[i].first, strings[i].second);
+    }
+    return Status::OK();
+  }
+  // only the selected columns are built, the others are skipped by their offsets
+  auto is_named = [](const std::string &name) { return [&name](const Column &column) { return column.name == name; }; };
+  for (const auto &name : columns) {
+    auto numeric_it = std::find_if(numeric_columns_.begin(), numeric_columns_.end(), is_named(name));
+    if (numeric_it != numeric_columns_.end()) {
+      DecodeNumeric(numeric, *numeric_it, row);
+      continue;
+    }
+    auto string_it = std::find_if(string_columns_.begin(), string_columns_.end(), is_named(name));
+    if (string_it != string_columns_.end()) {
+      const auto &value = strings[static_cast<size_t>(string_it - string_columns_.begin())];
+      (*row)[name] = std::string(value.first, value.second);
+    }
+  }
+  return Status::OK();
+}
+
+void ShardRawCodec::DecodeNumeric(const uint8_t *numeric, const Column &column, json *row) {
+  if (column.kind == kKindInt32) {
+    int32_t value = 0;
+    (void)memcpy(&value, numeric + column.offset, sizeof(int32_t));
+    (*row)[column.name] = value;
+  } else if (column.kind == kKindInt64) {
+    int64_t value = 0;
+    (void)memcpy(&value, numeric + column.offset, sizeof(int64_t));
+    (*row)[column.name] = value;
+  } else {
+    double value = 0;
+    (void)memcpy(&value, numeric + column.offset, sizeof(double));
+    (*row)[column.name] = value;
+  }
+}
+
+Status ShardRawCodec::FindStrings(const uint8_t *data, uint64_t size,
+                                  std::vector<std::pair<const char *, uint32_t>> *strings) const {
+  const uint8_t *end = data + size;
+  const uint8_t *current = data + kHeaderSize + numeric_size_;
+  strings->reserve(string_columns_.size());
+  for (size_t i = 0; i < string_columns_.size(); ++i) {
+    uint32_t length = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - current) >= sizeof(uint32_t),
+                                    "Invalid data, the raw data of the sample is truncated.");
+    (void)memcpy(&length, current, sizeof(uint32_t));
+    current += sizeof(uint32_t);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - current) >= length,
+                                    "Invalid data, the raw data of the sample is truncated.");
+    strings->emplace_back(reinterpret_cast<const char *>(current), length);
+    current += length;
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/hal/device/cpu_data_queue.h"
+#include <utility>
+#include "include/backend/data_queue/data_queue_mgr.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The capacity of the queue if InitDataSetQueue does not give one
+constexpr size_t kDefaultCapacity = 2;
+}  // namespace
+
+CPUDataQueue::CPUDataQueue(const std::string &channel_name, size_t capacity)
+    : DataQueue(channel_name, capacity == 0 ? kDefaultCapacity : capacity), node_info_(nullptr) {
+  node_info_ = std::make_unique<std::vector<DataQueueItem>[]>(capacity_);
+}
+
+DataQueueStatus CPUDataQueue::Push(std::vector<DataQueueItem> data) {
+  if (data.empty()) {
+    return DataQueueStatus::SUCCESS;
+  }
+  if (IsFull()) {
+    return DataQueueStatus::TIMEOUT;
+  }
+  for (auto &item : data) {
+    // A column of size 0 has no data
+    if (item.data_ptr == nullptr && item.data_len != 0) {
+      MS_LOG(ERROR) << "Invalid Input: ptr: " << item.data_ptr << ", len: " << item.data_len;
+      return DataQueueStatus::ERROR_INPUT;
+    }
+    // The host memory is the device memory of CPU
+    item.device_addr = item.data_ptr;
+  }
+  node_info_[tail_] = std::move(data);
+  tail_ = (tail_ + 1) % capacity_;
+  ++size_;
+  return DataQueueStatus::SUCCESS;
+}
+
+DataQueueStatus CPUDataQueue::Front(std::vector<DataQueueItem> *data) const {
+  MS_EXCEPTION_IF_NULL(data);
+  *data = node_info_[head_];
+  return DataQueueStatus::SUCCESS;
+}
+
+DataQueueStatus CPUDataQueue::Pop() {
+  // The data is in use until it is popped, so it is released here rather than in Front()
+  if (host_release_) {
+    for (auto &item : node_info_[head_]) {
+      host_release_(item.data_ptr, item.worker_id);
+    }
+  }
+  node_info_[head_].clear();
+  head_ = (head_ + 1) % capacity_;
+  --size_;
+  return DataQueueStatus::SUCCESS;
+}
+
+namespace {
+std::shared_ptr<DataQueue> CreateCPUDataQueue(const std::string &channel_name, bool, size_t capacity,
+                                              const std::vector<size_t> &) {
+  return std::make_shared<CPUDataQueue>(channel_name, capacity);
+}
+
+REGISTER_DATA_QUEUE_CREATOR(kCPUDevice, CreateCPUDataQueue);
+}  // namespace
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
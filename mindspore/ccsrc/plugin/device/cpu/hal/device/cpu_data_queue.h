@@ -0,0 +1,49 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_DATA_QUEUE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_DATA_QUEUE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "include/backend/data_queue/data_queue.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The data queue of the CPU device for dataset sink mode. The host memory of the pushed data is used by GetNext as it
+// is, so nothing is copied when the data is pushed. The data is released to the sender when it is popped, after
+// GetNext has copied it to its outputs.
+class CPUDataQueue : public DataQueue {
+ public:
+  CPUDataQueue(const std::string &channel_name, size_t capacity);
+  ~CPUDataQueue() override = default;
+
+  DataQueueStatus Push(std::vector<DataQueueItem> data) override;
+  DataQueueStatus Front(std::vector<DataQueueItem> *data) const override;
+  DataQueueStatus FrontAsync(std::vector<DataQueueItem> *data) const override { return Front(data); }
+  DataQueueStatus Pop() override;
+  std::string QueueType() const override { return "CPU"; }
+
+ private:
+  std::unique_ptr<std::vector<DataQueueItem>[]> node_info_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_DATA_QUEUE_H_
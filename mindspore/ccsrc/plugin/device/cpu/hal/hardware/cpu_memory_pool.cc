@@ -1,5 +1,5 @@
 /**
- * Copyright 2021 Huawei Technologies Co., Ltd
+ * Copyright 2021-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,13 +17,78 @@
 #include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
 #include "utils/log_adapter.h"
 #include "include/common/utils/utils.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 const char kMemAvailable[] = "MemAvailable";
+const char kSizeClassEnv[] = "MS_DEV_CPU_MEM_POOL_SIZE_CLASS";
+}  // namespace
+
+CPUMemoryPool::CPUMemoryPool() {
+  if (common::GetEnv(kSizeClassEnv) == "1") {
+    MS_LOG(INFO) << "The small memory bufs of the cpu memory pool are allocated by the size classes.";
+    size_class_pool_ = std::make_unique<DynamicMemPoolSizeClass>(this);
+  }
+}
+
+DeviceMemPtr CPUMemoryPool::AllocTensorMem(size_t size, bool from_persistent_mem) {
+  if (size_class_pool_ != nullptr) {
+    return size_class_pool_->AllocTensorMem(size, from_persistent_mem);
+  }
+  return DynamicMemPoolBestFit::AllocTensorMem(size, from_persistent_mem);
+}
+
+void CPUMemoryPool::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  // The size class pool frees the memory bufs not of the size classes by the best fit pool.
+  if (size_class_pool_ != nullptr) {
+    size_class_pool_->FreeTensorMem(device_addr);
+    return;
+  }
+  DynamicMemPoolBestFit::FreeTensorMem(device_addr);
+}
+
+void CPUMemoryPool::ReleaseDeviceRes() {
+  if (size_class_pool_ != nullptr) {
+    size_class_pool_->ReleaseDeviceRes();
+    return;
+  }
+  DynamicMemPoolBestFit::ReleaseDeviceRes();
+}
+
+size_t CPUMemoryPool::TotalMemStatistics() const {
+  return size_class_pool_ != nullptr ? size_class_pool_->TotalMemStatistics()
+                                     : DynamicMemPoolBestFit::TotalMemStatistics();
+}
+
+size_t CPUMemoryPool::TotalUsedMemStatistics() const {
+  return size_class_pool_ != nullptr ? size_class_pool_->TotalUsedMemStatistics()
+                                     : DynamicMemPoolBestFit::TotalUsedMemStatistics();
+}
+
+size_t CPUMemoryPool::UsedMemPeakStatistics() const {
+  return size_class_pool_ != nullptr ? size_class_pool_->UsedMemPeakStatistics()
+                                     : DynamicMemPoolBestFit::UsedMemPeakStatistics();
+}
+
+void CPUMemoryPool::DumpDynamicMemPoolStateInfo() {
+  if (size_class_pool_ != nullptr) {
+    size_class_pool_->DumpDynamicMemPoolStateInfo();
+    return;
+  }
+  DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo();
+}
+
+void CPUMemoryPool::DumpDynamicMemPoolDebugInfo() {
+  if (size_class_pool_ != nullptr) {
+    size_class_pool_->DumpDynamicMemPoolDebugInfo();
+    return;
+  }
+  DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo();
 }
+
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
     MS_LOG(EXCEPTION) << "The memory alloc size is 0.";
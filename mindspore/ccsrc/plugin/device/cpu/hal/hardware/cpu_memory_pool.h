@@ -1,5 +1,5 @@
 /**
- * Copyright 2021 Huawei Technologies Co., Ltd
+ * Copyright 2021-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include <memory>
 #include "utils/ms_utils.h"
 #include "include/backend/mem_reuse/mem_dynamic_allocator.h"
+#include "include/backend/mem_reuse/mem_dynamic_allocator_size_class.h"
 
 namespace mindspore {
 namespace device {
@@ -33,15 +34,30 @@ class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
     return instance;
   }
 
+  // The small memory bufs are allocated by the size classes in front of the best fit pool when the environment
+  // variable MS_DEV_CPU_MEM_POOL_SIZE_CLASS is set to 1, the others go to the best fit pool.
+  DeviceMemPtr AllocTensorMem(size_t size, bool from_persistent_mem = false);
+  void FreeTensorMem(const DeviceMemPtr &device_addr);
+  void ReleaseDeviceRes();
+
+  size_t TotalMemStatistics() const;
+  size_t TotalUsedMemStatistics() const;
+  size_t UsedMemPeakStatistics() const;
+
+  void DumpDynamicMemPoolStateInfo();
+  void DumpDynamicMemPoolDebugInfo();
+
   size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override;
   bool FreeDeviceMem(const DeviceMemPtr &addr) override;
   size_t free_mem_size() override;
 
  private:
-  CPUMemoryPool() = default;
+  CPUMemoryPool();
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
 
   size_t total_used_memory_{0};
+  // The size class pool in front of this pool, which allocates the arenas through the base class.
+  std::unique_ptr<DynamicMemPoolSizeClass> size_class_pool_{nullptr};
 };
 }  // namespace cpu
 }  // namespace device
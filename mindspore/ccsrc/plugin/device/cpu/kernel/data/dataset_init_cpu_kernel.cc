@@ -0,0 +1,41 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/kernel/data/dataset_init_cpu_kernel.h"
+#include "include/backend/data_queue/data_queue_mgr.h"
+
+namespace mindspore {
+namespace kernel {
+using mindspore::device::DataQueueMgr;
+
+void DatasetInitCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  kernel_name_ = common::AnfAlgo::GetCNodeName(kernel_node);
+  queue_name_ = common::AnfAlgo::GetNodeAttr<std::string>(kernel_node, "queue_name");
+}
+
+bool DatasetInitCpuKernelMod::Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+                                     const std::vector<AddressPtr> &) {
+  // The CPU data queue keeps the host memory of the batches, so the shapes are not needed to allocate a buffer
+  auto status = DataQueueMgr::GetInstance().Create(queue_name_, {}, queue_capacity_);
+  if (status != device::DataQueueStatus::SUCCESS && status != device::DataQueueStatus::QUEUE_EXIST) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', init Dataset Failed, status:" << status;
+  }
+  return true;
+}
+
+MS_KERNEL_FACTORY_REG(NativeCpuKernelMod, InitDataSetQueue, DatasetInitCpuKernelMod);
+}  // namespace kernel
+}  // namespace mindspore
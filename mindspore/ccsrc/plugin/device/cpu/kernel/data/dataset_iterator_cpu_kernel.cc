@@ -0,0 +1,135 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/kernel/data/dataset_iterator_cpu_kernel.h"
+#include <ctime>
+#include "include/backend/data_queue/data_queue_mgr.h"
+#include "utils/ms_context.h"
+#ifdef ENABLE_DUMP_IR
+#include "include/common/debug/rdr/recorder_manager.h"
+#endif
+
+namespace mindspore {
+namespace kernel {
+using mindspore::device::DataQueueMgr;
+namespace {
+constexpr uint32_t kLogIntervalStep = 30;  // log info in each 30s when getnext timeout
+}  // namespace
+
+DatasetIteratorCpuKernelMod::~DatasetIteratorCpuKernelMod() { DataQueueMgr::GetInstance().Close(queue_name_); }
+
+bool DatasetIteratorCpuKernelMod::Init(const BaseOperatorPtr &base_operator, const std::vector<KernelTensorPtr> &,
+                                       const std::vector<KernelTensorPtr> &outputs) {
+  MS_EXCEPTION_IF_NULL(base_operator);
+  kernel_name_ = base_operator->name();
+  queue_name_ = GetValue<std::string>(base_operator->GetAttr("shared_name"));
+  CheckStaticShape(outputs);
+  return true;
+}
+
+int DatasetIteratorCpuKernelMod::Resize(const BaseOperatorPtr &base_operator,
+                                        const std::vector<KernelTensorPtr> &inputs,
+                                        const std::vector<KernelTensorPtr> &outputs,
+                                        const std::map<uint32_t, tensor::TensorPtr> &) {
+  CheckStaticShape(outputs);
+  return KernelMod::Resize(base_operator, inputs, outputs);
+}
+
+void DatasetIteratorCpuKernelMod::CheckStaticShape(const std::vector<KernelTensorPtr> &outputs) const {
+  for (const auto &output : outputs) {
+    MS_EXCEPTION_IF_NULL(output);
+    if (IsDynamic(output->GetShapeVector())) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', dynamic shape is not supported in dataset sink mode on CPU, "
+                        << "please set dataset_sink_mode to False.";
+    }
+  }
+}
+
+bool DatasetIteratorCpuKernelMod::ReadDevice(std::vector<DataQueueItem> *data) {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  uint32_t op_timeout = ms_context->get_param<uint32_t>(MS_CTX_OP_TIMEOUT);
+  uint32_t time_cost = 0;
+  uint32_t log_interval = kLogIntervalStep;
+  while (true) {
+    time_t start_time = time(nullptr);
+    auto ret = DataQueueMgr::GetInstance().Front(queue_name_, data);
+    if (ret == device::DataQueueStatus::SUCCESS) {
+      break;
+    }
+    if (ret == device::DataQueueStatus::TIMEOUT) {
+      time_cost += static_cast<uint32_t>(time(nullptr) - start_time);
+      if (op_timeout == 0 || time_cost < op_timeout) {
+        if (time_cost > log_interval) {
+          MS_LOG(INFO) << "The op_timeout is: " << std::to_string(op_timeout) << ", continue waiting for data...";
+          log_interval += kLogIntervalStep;
+        }
+        continue;
+      }
+#ifdef ENABLE_DUMP_IR
+      mindspore::RDR::TriggerAll();
+#endif
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', get data timeout. Queue name: " << queue_name_;
+    }
+    MS_LOG(ERROR) << "For '" << kernel_name_ << "', get data failed, errcode " << ret
+                  << ", queue name: " << queue_name_;
+    return false;
+  }
+  return true;
+}
+
+bool DatasetIteratorCpuKernelMod::Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+                                         const std::vector<AddressPtr> &outputs) {
+  if (!is_opened_) {
+    auto ret = DataQueueMgr::GetInstance().Open(queue_name_);
+    if (ret != device::DataQueueStatus::SUCCESS) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', cpu Queue(" << queue_name_ << ") Open Failed: " << ret;
+    }
+    is_opened_ = true;
+  }
+
+  if (!ReadDevice(&output_data_)) {
+    return false;
+  }
+  if (output_data_.size() != outputs.size()) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the number of columns of the data: " << output_data_.size()
+                      << " is not the number of outputs: " << outputs.size();
+  }
+  for (size_t i = 0; i < output_data_.size(); i++) {
+    auto output = outputs[i];
+    MS_EXCEPTION_IF_NULL(output);
+    auto data_len = output_data_[i].data_len;
+    if (data_len != output->size) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the size of column " << i << " of the data: " << data_len
+                        << " is not the size of the output: " << output->size << ". Detected that dataset is dynamic "
+                        << "shape, which is not supported in dataset sink mode on CPU.";
+    }
+    if (data_len == 0) {
+      continue;
+    }
+    auto ret = memcpy_s(output->addr, output->size, output_data_[i].device_addr, data_len);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', memcpy_s error. Error no: " << ret;
+    }
+  }
+  // The batch is released to the dataset pipeline when it is popped
+  output_data_.clear();
+  (void)DataQueueMgr::GetInstance().Pop(queue_name_);
+  return true;
+}
+
+MS_KERNEL_FACTORY_REG(NativeCpuKernelMod, GetNext, DatasetIteratorCpuKernelMod);
+}  // namespace kernel
+}  // namespace mindspore
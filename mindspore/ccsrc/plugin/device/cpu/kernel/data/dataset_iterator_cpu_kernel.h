@@ -0,0 +1,60 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_DATA_DATASET_ITERATOR_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_DATA_DATASET_ITERATOR_CPU_KERNEL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "plugin/factory/ms_factory.h"
+#include "include/backend/data_queue/data_queue.h"
+
+namespace mindspore {
+namespace kernel {
+using mindspore::device::DataQueueItem;
+
+// GetNext of dataset sink mode, which takes the next batch from the data queue of the dataset pipeline. The batch is
+// copied to the outputs straight from the memory of the pipeline, and released to it after that.
+class DatasetIteratorCpuKernelMod : public NativeCpuKernelMod {
+ public:
+  DatasetIteratorCpuKernelMod() = default;
+  ~DatasetIteratorCpuKernelMod() override;
+
+  bool Init(const BaseOperatorPtr &base_operator, const std::vector<KernelTensorPtr> &inputs,
+            const std::vector<KernelTensorPtr> &outputs) override;
+
+  int Resize(const BaseOperatorPtr &base_operator, const std::vector<KernelTensorPtr> &inputs,
+             const std::vector<KernelTensorPtr> &outputs, const std::map<uint32_t, tensor::TensorPtr> &) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  std::vector<KernelAttr> GetOpSupport() override { return {KernelAttr().AddSkipCheckAttr(true)}; }
+
+ private:
+  void CheckStaticShape(const std::vector<KernelTensorPtr> &outputs) const;
+  bool ReadDevice(std::vector<DataQueueItem> *data);
+
+  std::string queue_name_;
+  bool is_opened_{false};
+  std::vector<DataQueueItem> output_data_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_DATA_DATASET_ITERATOR_CPU_KERNEL_H_
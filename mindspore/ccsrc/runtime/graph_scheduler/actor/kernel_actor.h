@@ -72,6 +72,8 @@ class KernelActor : public DebugAwareActor {
         inputs_continuous_memory_(false),
         somas_info_(nullptr) {
     (void)device_contexts_.emplace_back(device_context);
+    // The OpData and OpControl messages between the kernel actors are frequent.
+    set_lock_free_mailbox(true);
   }
   ~KernelActor() override = default;
 
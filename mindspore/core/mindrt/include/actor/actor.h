@@ -81,6 +81,10 @@ class MS_CORE_API ActorBase {
 
   void set_thread_pool(ActorThreadPool *pool) { pool_ = pool; }
 
+  // Use the LockFreeMailBox instead of the NonblockingMailBox, which takes effect when the actor is spawned to share
+  // the threads of a pool.
+  void set_lock_free_mailbox(bool lock_free_mailbox) { lock_free_mailbox_ = lock_free_mailbox; }
+
   // Judge if actor running by the received message number, the default is true.
   virtual bool IsActive(int msg_num) { return true; }
 
@@ -216,6 +220,7 @@ class MS_CORE_API ActorBase {
 
   ActorThreadPool *pool_{nullptr};
   std::shared_ptr<ActorMgr> actor_mgr_;
+  bool lock_free_mailbox_{false};
 };
 using ActorReference = std::shared_ptr<ActorBase>;
 };  // namespace mindspore
@@ -1,5 +1,5 @@
 /**
- * Copyright 2021 Huawei Technologies Co., Ltd
+ * Copyright 2021-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <cstddef>
+#include <new>
 #include <utility>
 #include <string>
 
@@ -24,7 +26,7 @@
 
 namespace mindspore {
 class ActorBase;
-class MessageBase {
+class MS_CORE_API MessageBase {
  public:
   enum class Type : char {
     KMSG = 1,
@@ -53,6 +55,13 @@ class MessageBase {
 
   virtual ~MessageBase() {}
 
+  // The messages are allocated from the thread local pools of fixed size blocks, which saves a malloc and a free for
+  // each of the frequent small messages, e.g. the OpData and OpControl messages between the kernel actors.
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept;
+  static void operator delete(void *ptr) noexcept;
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept;
+
   inline std::string &Name() { return name; }
 
   inline void SetName(const std::string &aName) { this->name = aName; }
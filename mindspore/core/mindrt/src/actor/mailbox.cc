@@ -1,5 +1,5 @@
 /**
- * Copyright 2021 Huawei Technologies Co., Ltd
+ * Copyright 2021-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "actor/mailbox.h"
+#include <thread>
 
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
@@ -85,4 +86,118 @@ std::unique_ptr<MessageBase> HQueMailBox::GetMsg() {
   std::unique_ptr<MessageBase> msg(mailbox.Dequeue());
   return msg;
 }
+
+namespace {
+// The nodes are freed by the consumer, which usually sends messages as well, so the cache of each thread is refilled by
+// the messages it receives.
+constexpr size_t kMaxCachedMailNodes = 1024;
+
+struct MailNodeCache {
+  ~MailNodeCache();
+  void *free_list = nullptr;
+  size_t free_count = 0;
+};
+
+thread_local bool mail_node_cache_destroyed = false;
+thread_local MailNodeCache mail_node_cache;
+
+MailNodeCache::~MailNodeCache() {
+  mail_node_cache_destroyed = true;
+  while (free_list != nullptr) {
+    void *node = free_list;
+    free_list = *static_cast<void **>(node);
+    ::operator delete(node);
+  }
+  free_count = 0;
+}
+}  // namespace
+
+void *LockFreeMailBox::Node::operator new(size_t size) {
+  static_assert(sizeof(Node) >= sizeof(void *), "A free node can not keep the next free node.");
+  if (!mail_node_cache_destroyed && mail_node_cache.free_list != nullptr) {
+    void *node = mail_node_cache.free_list;
+    mail_node_cache.free_list = *static_cast<void **>(node);
+    --mail_node_cache.free_count;
+    return node;
+  }
+  return ::operator new(size);
+}
+
+void LockFreeMailBox::Node::operator delete(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (!mail_node_cache_destroyed && mail_node_cache.free_count < kMaxCachedMailNodes) {
+    *static_cast<void **>(ptr) = mail_node_cache.free_list;
+    mail_node_cache.free_list = ptr;
+    ++mail_node_cache.free_count;
+    return;
+  }
+  ::operator delete(ptr);
+}
+
+LockFreeMailBox::~LockFreeMailBox() {
+  Node *node = tail_;
+  while (node != nullptr) {
+    Node *next = node->next.load(std::memory_order_relaxed);
+    delete node->msg;
+    if (node != &stub_) {
+      delete node;
+    }
+    node = next;
+  }
+}
+
+void LockFreeMailBox::Push(MessageBase *msg) {
+  auto node = new Node();
+  node->msg = msg;
+  Node *prev = head_.exchange(node);
+  // the message is not reachable by the consumer until it is linked here
+  prev->next.store(node, std::memory_order_release);
+}
+
+MessageBase *LockFreeMailBox::Pop() {
+  Node *tail = tail_;
+  Node *next = tail->next.load(std::memory_order_acquire);
+  if (next == nullptr) {
+    return nullptr;
+  }
+  // the node of the popped message becomes the one before the next message
+  tail_ = next;
+  MessageBase *msg = next->msg;
+  next->msg = nullptr;
+  if (tail != &stub_) {
+    delete tail;
+  }
+  return msg;
+}
+
+int LockFreeMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  Push(msg.release());
+  // only the producer which switches the actor to scheduled notifies it, the load saves the exchange when the actor is
+  // already scheduled
+  if (!scheduled_.load() && !scheduled_.exchange(true) && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> LockFreeMailBox::GetMsg() {
+  while (true) {
+    auto msg = Pop();
+    if (msg != nullptr) {
+      return std::unique_ptr<MessageBase>(msg);
+    }
+    // tail_ must not be read once the actor is released, since another thread may take the actor and pop, so the
+    // re-check only compares the atomic head_ with the last node seen before the release
+    Node *tail = tail_;
+    // release the actor, and take it back if a message is pushed meanwhile by a producer which finds it scheduled
+    scheduled_.store(false);
+    if (head_.load() == tail || scheduled_.exchange(true)) {
+      return nullptr;
+    }
+    // a producer may be linking its message
+    std::this_thread::yield();
+  }
+}
 }  // namespace mindspore
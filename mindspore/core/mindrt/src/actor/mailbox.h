@@ -1,5 +1,5 @@
 /**
- * Copyright 2021 Huawei Technologies Co., Ltd
+ * Copyright 2021-2023 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -94,6 +95,42 @@ class HQueMailBox : public MailBox {
   HQueue<MessageBase> mailbox;
   static const int32_t MAX_MSG_QUE_SIZE = 4096;
 };
+
+// A multi-producer single-consumer mailbox, which links the messages through the nodes owned by the mailbox without
+// any lock. The nodes are allocated from thread local free lists, and MessageBase keeps no link of its own.
+// refer to https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+class LockFreeMailBox : public MailBox {
+ public:
+  LockFreeMailBox() : head_(&stub_), tail_(&stub_) { takeAllMsgsEachTime = false; }
+  ~LockFreeMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  // return nullptr and release the actor when there is no message
+  std::unique_ptr<MessageBase> GetMsg() override;
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Node {
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr) noexcept;
+
+    std::atomic<Node *> next{nullptr};
+    MessageBase *msg{nullptr};
+  };
+
+  void Push(MessageBase *msg);
+  // return nullptr when the mailbox is empty, or a producer has not linked its message yet
+  MessageBase *Pop();
+
+  // the node pushed last, written by the producers
+  alignas(kCacheLineSize) std::atomic<Node *> head_;
+  // the node before the message to pop next, only accessed by the consumer
+  alignas(kCacheLineSize) Node *tail_;
+  Node stub_;
+  // whether the actor is ready or running, the producer which sets it notifies the actor
+  std::atomic_bool scheduled_{false};
+};
 }  // namespace mindspore
 
 #endif  // MINDSPORE_MAILBOX_H
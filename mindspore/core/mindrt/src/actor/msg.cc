@@ -0,0 +1,113 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "actor/msg.h"
+#include <cstdint>
+#include <cstdlib>
+
+namespace mindspore {
+namespace {
+// Each block starts with a header keeping its size class, and the next free block while it is in a free list.
+constexpr size_t kMsgBlockHeaderSize = alignof(std::max_align_t);
+constexpr size_t kMsgBlockGranularity = 64;
+constexpr size_t kMsgSizeClassNum = 8;
+// The maximum number of free blocks cached by a thread for each size class, the others are returned to the system.
+constexpr size_t kMaxCachedMsgBlocks = 256;
+constexpr uint32_t kNoSizeClass = UINT32_MAX;
+
+struct MsgBlockHeader {
+  uint32_t size_class;
+  MsgBlockHeader *next_free;
+};
+static_assert(sizeof(MsgBlockHeader) <= kMsgBlockHeaderSize, "The header of a message block is too large.");
+
+// The blocks are freed by the thread receiving the messages, which usually sends messages as well, so the cache of
+// each thread is refilled by the messages it receives.
+struct MsgBlockCache {
+  ~MsgBlockCache();
+  MsgBlockHeader *free_lists[kMsgSizeClassNum] = {nullptr};
+  size_t free_counts[kMsgSizeClassNum] = {0};
+};
+
+// The messages freed after the cache is destroyed at the exit of the thread are returned to the system.
+thread_local bool msg_block_cache_destroyed = false;
+thread_local MsgBlockCache msg_block_cache;
+
+MsgBlockCache::~MsgBlockCache() {
+  msg_block_cache_destroyed = true;
+  for (size_t i = 0; i < kMsgSizeClassNum; ++i) {
+    while (free_lists[i] != nullptr) {
+      auto block = free_lists[i];
+      free_lists[i] = block->next_free;
+      free(block);
+    }
+    free_counts[i] = 0;
+  }
+}
+
+void *AllocateMsgBlock(size_t size) noexcept {
+  size_t block_size = size + kMsgBlockHeaderSize;
+  uint32_t size_class = kNoSizeClass;
+  if (block_size <= kMsgBlockGranularity * kMsgSizeClassNum) {
+    size_class = static_cast<uint32_t>((block_size - 1) / kMsgBlockGranularity);
+    block_size = (size_class + 1) * kMsgBlockGranularity;
+  }
+  MsgBlockHeader *block = nullptr;
+  if (size_class != kNoSizeClass && !msg_block_cache_destroyed && msg_block_cache.free_lists[size_class] != nullptr) {
+    block = msg_block_cache.free_lists[size_class];
+    msg_block_cache.free_lists[size_class] = block->next_free;
+    --msg_block_cache.free_counts[size_class];
+  } else {
+    block = static_cast<MsgBlockHeader *>(malloc(block_size));
+    if (block == nullptr) {
+      return nullptr;
+    }
+  }
+  block->size_class = size_class;
+  return reinterpret_cast<char *>(block) + kMsgBlockHeaderSize;
+}
+
+void FreeMsgBlock(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto block = reinterpret_cast<MsgBlockHeader *>(static_cast<char *>(ptr) - kMsgBlockHeaderSize);
+  auto size_class = block->size_class;
+  if (size_class != kNoSizeClass && !msg_block_cache_destroyed &&
+      msg_block_cache.free_counts[size_class] < kMaxCachedMsgBlocks) {
+    block->next_free = msg_block_cache.free_lists[size_class];
+    msg_block_cache.free_lists[size_class] = block;
+    ++msg_block_cache.free_counts[size_class];
+    return;
+  }
+  free(block);
+}
+}  // namespace
+
+void *MessageBase::operator new(size_t size) {
+  void *ptr = AllocateMsgBlock(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *MessageBase::operator new(size_t size, const std::nothrow_t &) noexcept { return AllocateMsgBlock(size); }
+
+void MessageBase::operator delete(void *ptr) noexcept { FreeMsgBlock(ptr); }
+
+void MessageBase::operator delete(void *ptr, const std::nothrow_t &) noexcept { FreeMsgBlock(ptr); }
+}  // namespace mindspore
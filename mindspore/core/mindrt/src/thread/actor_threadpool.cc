@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <memory>
+#include <utility>
 #ifndef _MSC_VER
 #include <sched.h>
 #include <unistd.h>
@@ -24,6 +25,12 @@
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
 
+namespace {
+// the pool and the index of the actor thread which the current thread is, set when an actor thread starts
+thread_local ActorThreadPool *current_actor_pool = nullptr;
+thread_local size_t current_actor_worker = 0;
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::make_unique<std::thread>(&ActorWorker::RunWithSpin, this); }
 
 void ActorWorker::RunWithSpin() {
@@ -39,29 +46,55 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  current_actor_pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  current_actor_worker = worker_id_;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
+      SetSpinning(false);
       spin_count_ = 0;
     } else {
+      SetSpinning(true);
       YieldAndDeactive();
     }
     if (spin_count_ > max_spin_count_) {
-      WaitUntilActive();
+      SetSpinning(false);
+      // an actor pushed to a local queue while this thread was counted as spinning did not wake up any actor thread,
+      // so look for it once more before waiting
+      if (!RunQueueActorTask()) {
+        WaitUntilActive();
+      }
       spin_count_ = 0;
     }
   }
+  SetSpinning(false);
+}
+
+void ActorWorker::SetSpinning(bool spinning) {
+  if (spinning_ == spinning || pool_ == nullptr) {
+    return;
+  }
+  spinning_ = spinning;
+  reinterpret_cast<ActorThreadPool *>(pool_)->UpdateSpinningActorWorkers(spinning);
 }
 
 bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  auto actor = pool->PopActorFromQueue();
   if (actor == nullptr) {
     return false;
   }
 
+  // not looking for actors any more while running one, so it is neither counted as spinning nor woken up as an idle
+  // one, and the ones pushed meanwhile wake up another actor thread
+  SetSpinning(false);
+  status_ = kThreadBusy;
+  // the actor taken may come from the global queue instead of an actor pushed to a local queue without waking up any
+  // actor thread, which is then left behind even if the running actors wait for it
+  pool->ActiveIdleActorWorkerForLocalActors();
   actor->Run();
   return true;
 }
@@ -84,14 +117,7 @@ ActorThreadPool::~ActorThreadPool() {
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueuesEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -109,7 +135,64 @@ ActorThreadPool::~ActorThreadPool() {
 #endif
 }
 
+bool ActorThreadPool::ActorQueuesEmpty() {
+  if (!LocalActorQueuesEmpty(local_actor_queues_.size())) {
+    return false;
+  }
+#ifdef USE_HQUEUE
+  return actor_queue_.Empty();
+#else
+  std::lock_guard<std::mutex> _l(actor_mutex_);
+  return actor_queue_.empty();
+#endif
+}
+
+bool ActorThreadPool::LocalActorQueuesEmpty(size_t except) const {
+  for (size_t i = 0; i < local_actor_queues_.size(); ++i) {
+    if (i != except && !local_actor_queues_[i]->Empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+WorkStealingQueue<ActorBase> *ActorThreadPool::CurrentLocalActorQueue(size_t *index) const {
+  if (current_actor_pool != this || current_actor_worker >= local_actor_queues_.size()) {
+    return nullptr;
+  }
+  *index = current_actor_worker;
+  return local_actor_queues_[current_actor_worker].get();
+}
+
 ActorBase *ActorThreadPool::PopActorFromQueue() {
+  size_t index = 0;
+  auto local_queue = CurrentLocalActorQueue(&index);
+  if (local_queue != nullptr) {
+    auto actor = local_queue->Pop();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  auto actor = PopActorFromGlobalQueue();
+  if (actor != nullptr) {
+    return actor;
+  }
+  // start from the next actor thread, so that the thieves spread over the local queues
+  return StealActor(local_queue != nullptr ? index + 1 : 0);
+}
+
+ActorBase *ActorThreadPool::StealActor(size_t start) const {
+  size_t queue_num = local_actor_queues_.size();
+  for (size_t i = 0; i < queue_num; ++i) {
+    auto actor = local_actor_queues_[(start + i) % queue_num]->Steal();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
+ActorBase *ActorThreadPool::PopActorFromGlobalQueue() {
 #ifdef USE_HQUEUE
   return actor_queue_.Dequeue();
 #else
@@ -127,6 +210,22 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
+  // an actor made ready by an actor thread, e.g. the successor of the actor running on it, is kept on that thread and
+  // runs next with the data of its predecessor still in cache
+  size_t index = 0;
+  auto local_queue = CurrentLocalActorQueue(&index);
+  if (local_queue != nullptr && local_queue->Push(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue to local queue[%zu] success", actor->GetAID().Name().c_str(), index);
+    // the current thread takes the actor pushed last when its running actor is done, but the running actor may last
+    // long or even wait for the pushed one. A spinning actor thread steals it, or wakes up an idle actor thread if it
+    // takes another actor first, so an idle actor thread is woken up here only when none is spinning, or when other
+    // actors are already waiting in the local queue.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (local_queue->Size() > 1 || spinning_actor_workers_.load() == 0) {
+      ActiveIdleActorWorker();
+    }
+    return;
+  }
   {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
@@ -137,6 +236,32 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
 #endif
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
+  ActiveIdleActorWorker();
+}
+
+void ActorThreadPool::UpdateSpinningActorWorkers(bool spinning) {
+  if (spinning) {
+    (void)spinning_actor_workers_.fetch_add(1);
+  } else {
+    (void)spinning_actor_workers_.fetch_sub(1);
+  }
+}
+
+void ActorThreadPool::ActiveIdleActorWorkerForLocalActors() {
+  // pairs with the fence in PushActorToQueue, either the pushing thread sees this thread not spinning any more, or this
+  // thread sees the actor pushed
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  size_t index = 0;
+  // the actors in the local queue of the current actor thread are run by itself
+  if (CurrentLocalActorQueue(&index) == nullptr) {
+    index = local_actor_queues_.size();
+  }
+  if (!LocalActorQueuesEmpty(index)) {
+    ActiveIdleActorWorker();
+  }
+}
+
+void ActorThreadPool::ActiveIdleActorWorker() {
   // active one idle actor thread if exist
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
@@ -156,6 +281,19 @@ int ActorThreadPool::ActorQueueInit() {
   return THREAD_OK;
 }
 
+int ActorThreadPool::LocalActorQueuesInit(size_t actor_thread_num) {
+  local_actor_queues_.clear();
+  for (size_t i = 0; i < actor_thread_num; ++i) {
+    auto local_queue = std::make_unique<WorkStealingQueue<ActorBase>>();
+    if (!local_queue->Init(static_cast<int64_t>(kLocalActorQueueSize))) {
+      THREAD_ERROR("init local actor queue failed.");
+      return THREAD_ERROR;
+    }
+    local_actor_queues_.push_back(std::move(local_queue));
+  }
+  return THREAD_OK;
+}
+
 int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list) {
   if (actor_thread_num > all_thread_num) {
     THREAD_ERROR("thread num is invalid");
@@ -177,6 +315,10 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
   if (TaskQueuesInit(total_thread_num) != THREAD_OK) {
     return THREAD_ERROR;
   }
+  // the local queues are ready before the actor threads start
+  if (LocalActorQueuesInit(actor_thread_num_) != THREAD_OK) {
+    return THREAD_ERROR;
+  }
 
   if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 #define MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 
+#include <memory>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -26,10 +27,13 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/work_stealing_queue.h"
 #ifndef USE_HQUEUE
 #define USE_HQUEUE
 #endif
 namespace mindspore {
+constexpr size_t kLocalActorQueueSize = 1024;
+
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
@@ -62,6 +66,10 @@ class ActorWorker : public Worker {
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  // count this thread in the spinning actor threads of the pool while it is looking for an actor
+  void SetSpinning(bool spinning);
+
+  bool spinning_{false};
 };
 
 class MS_CORE_API ActorThreadPool : public ThreadPool {
@@ -81,12 +89,24 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
   static void set_actor_queue_size(size_t actor_queue_size) { actor_queue_size_ = actor_queue_size; }
 
   virtual int ActorQueueInit();
+  // an actor made ready by an actor thread of this pool is kept in the local queue of that thread, the others go to
+  // the global queue
   virtual void PushActorToQueue(ActorBase *actor);
+  // take an actor from the local queue of the current actor thread, then from the global queue, and at last steal one
+  // from the local queues of the other actor threads
   virtual ActorBase *PopActorFromQueue();
+  // called by an actor thread when it starts or stops spinning to look for an actor
+  void UpdateSpinningActorWorkers(bool spinning);
+  // called by an actor thread before it runs an actor, wakes up an idle actor thread if an actor is waiting in the
+  // local queue of another actor thread
+  void ActiveIdleActorWorkerForLocalActors();
 
  protected:
   ActorThreadPool() = default;
 
+  // whether the global queue and all the local queues are empty
+  bool ActorQueuesEmpty();
+
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
 #ifdef USE_HQUEUE
@@ -97,6 +117,19 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  int LocalActorQueuesInit(size_t actor_thread_num);
+  // the local queue of the current thread if it is an actor thread of this pool, otherwise nullptr
+  WorkStealingQueue<ActorBase> *CurrentLocalActorQueue(size_t *index) const;
+  // whether all the local queues are empty except the one of the actor thread numbered except
+  bool LocalActorQueuesEmpty(size_t except) const;
+  ActorBase *PopActorFromGlobalQueue();
+  ActorBase *StealActor(size_t start) const;
+  void ActiveIdleActorWorker();
+
+  // one queue for each actor thread, which only pushes and pops its own queue, and steals from the others
+  std::vector<std::unique_ptr<WorkStealingQueue<ActorBase>>> local_actor_queues_;
+  // the number of actor threads which are spinning to look for an actor, they steal from the local queues
+  std::atomic<size_t> spinning_actor_workers_{0};
 
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mindspore {
+// implement a bounded lock-free work stealing deque, the owner thread pushes and pops at the bottom, and the other
+// threads steal from the top.
+// refer to https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+template <typename T>
+class WorkStealingQueue {
+  static constexpr size_t kCacheLineSize = 64;
+
+ public:
+  WorkStealingQueue(const WorkStealingQueue &) = delete;
+  WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+  WorkStealingQueue() {}
+  virtual ~WorkStealingQueue() {}
+
+  bool IsInit() const { return buffer_ != nullptr; }
+
+  // the size is rounded up to a power of 2
+  bool Init(int64_t sz) {
+    if (IsInit() || sz <= 0) {
+      return false;
+    }
+    int64_t capacity = 1;
+    while (capacity < sz) {
+      capacity <<= 1;
+    }
+    buffer_ = std::make_unique<std::atomic<T *>[]>(static_cast<size_t>(capacity));
+    mask_ = capacity - 1;
+    return true;
+  }
+
+  // only called by the owner thread, return false when the queue is full
+  bool Push(T *t) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (b - top > mask_) {
+      return false;
+    }
+    buffer_[b & mask_].store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // only called by the owner thread, take the item pushed last
+  T *Pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > b) {
+      // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *t = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (top == b) {
+      // the last item, race with the thieves for it
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        t = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return t;
+  }
+
+  // called by any thread, take the item pushed first
+  T *Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (top >= b) {
+      return nullptr;
+    }
+    T *t = buffer_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      // lost the race with the owner or another thief
+      return nullptr;
+    }
+    return t;
+  }
+
+  bool Empty() const { return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed); }
+
+  int64_t Size() const {
+    int64_t size = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+    return size > 0 ? size : 0;
+  }
+
+ private:
+  // top and bottom are written by different threads, keep them on different cache lines
+  alignas(kCacheLineSize) std::atomic<int64_t> top_{0};
+  alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};
+  std::unique_ptr<std::atomic<T *>[]> buffer_{nullptr};
+  int64_t mask_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
@@ -27,6 +27,7 @@ from enum import IntEnum
 import os
 import platform
 import random
+import tempfile
 import numpy
 import mindspore._c_dataengine as cde
 from mindspore import log as logger
@@ -44,12 +45,20 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_autotune_budget', 'get_autotune_memory_budget', 'get_autotune_cpu_budget',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
            'set_fast_recovery', 'get_fast_recovery',
            'set_debug_mode', 'get_debug_mode',
            'set_error_samples_mode', 'get_error_samples_mode', 'ErrorSamplesMode',
-           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
+           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval',
+           'set_enable_mindrecord_mmap', 'get_enable_mindrecord_mmap',
+           'set_enable_jpeg_scaled_decode', 'get_enable_jpeg_scaled_decode',
+           'set_io_prefetch_depth', 'get_io_prefetch_depth',
+           'set_batch_buffer_pool_size', 'get_batch_buffer_pool_size',
+           'set_shuffle_spill', 'get_shuffle_spill_mem_limit', 'get_shuffle_spill_dir',
+           'set_graph_csr_store_dir', 'get_graph_csr_store_dir',
+           'set_numa_partition', 'get_numa_partition']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -617,6 +626,86 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_autotune_budget(memory_budget, cpu_budget=None):
+    """
+    Set the memory and CPU budget of AutoTune, which switches AutoTune to the model-based tuning.
+
+    By default, AutoTune changes the `num_parallel_workers` or the `prefetch_size` of one operation at a time by
+    heuristics, which may take several epochs to converge. When `memory_budget` is greater than 0 or `cpu_budget` is
+    set, AutoTune instead fits a throughput model of the data pipeline from the CPU utilization of each operation, the
+    size of the rows in each connector and the time of each batch it collects, then solves for the
+    `num_parallel_workers` and the `prefetch_size` of all the operations at once. The workers are given to the
+    slowest operations within `cpu_budget`, and the rows buffered by the workers and the connectors are kept within
+    `memory_budget`. The model is refitted a few times over windows of `get_autotune_interval()` steps, 20 steps if it
+    is 0, so AutoTune converges within the first epoch, and the model is saved with the tuned configuration.
+
+    Note:
+        It only takes effect when AutoTune is enabled by `set_enable_autotune`.
+
+    Args:
+        memory_budget (int): The max number of bytes of the rows buffered by the data pipeline, 0 means no limit.
+            If it is 0 and `cpu_budget` is ``None``, the heuristic AutoTune is used.
+        cpu_budget (int, optional): The max total number of threads of the operations. Default: ``None``,
+            all the CPU cores are used.
+
+    Raises:
+        TypeError: If `memory_budget` is not of type int.
+        ValueError: If `memory_budget` is less than 0.
+        TypeError: If `cpu_budget` is not of type int.
+        ValueError: If `cpu_budget` is not within the range of [1, INT32_MAX].
+
+    Examples:
+        >>> # tune the pipeline with at most 2GB of buffered rows and 16 threads
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_autotune(True)
+        >>> ds.config.set_autotune_budget(2 * 1024 * 1024 * 1024, 16)
+    """
+    if not isinstance(memory_budget, int) or isinstance(memory_budget, bool):
+        raise TypeError("memory_budget must be of type int, but got {}.".format(type(memory_budget)))
+    if memory_budget < 0:
+        raise ValueError("memory_budget should not be less than 0, but got {}.".format(memory_budget))
+    if cpu_budget is None:
+        cpu_budget = 0
+    else:
+        if not isinstance(cpu_budget, int) or isinstance(cpu_budget, bool):
+            raise TypeError("cpu_budget must be of type int, but got {}.".format(type(cpu_budget)))
+        if cpu_budget <= 0 or cpu_budget > INT32_MAX:
+            raise ValueError(
+                "cpu_budget given is not within the required range [1, INT32_MAX(2147483647)].")
+    _config.set_autotune_memory_budget(memory_budget)
+    _config.set_autotune_cpu_budget(cpu_budget)
+
+
+def get_autotune_memory_budget():
+    """
+    Get the memory budget of the model-based AutoTune.
+    It is set to 0 by default, which means no limit, and the heuristic AutoTune is used unless a CPU budget is set.
+
+    Returns:
+        int, the max number of bytes of the rows buffered by the data pipeline.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> memory_budget = ds.config.get_autotune_memory_budget()
+    """
+    return _config.get_autotune_memory_budget()
+
+
+def get_autotune_cpu_budget():
+    """
+    Get the CPU budget of the model-based AutoTune.
+    It is set to 0 by default, which means all the CPU cores are used.
+
+    Returns:
+        int, the max total number of threads of the operations.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> cpu_budget = ds.config.get_autotune_cpu_budget()
+    """
+    return _config.get_autotune_cpu_budget()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -1069,3 +1158,336 @@ def get_error_samples_mode():
         >>> error_samples_mode = ds.config.get_error_samples_mode()
     """
     return _CDE_TO_PYTHON_ERROR_SAMPLES_MODE.get(_config.get_error_samples_mode())
+
+
+def set_enable_mindrecord_mmap(enable):
+    """
+    Set whether MindRecord files are read through memory mapping. When enabled, the blob data of each sample
+    is not copied into the output tensors, and the upcoming samples are read ahead in the order of the sampler.
+
+    Note:
+        Memory mapping is not supported on Windows, MindRecord files are read through file streams there.
+
+    Args:
+        enable (bool): Whether to read MindRecord files through memory mapping.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_mindrecord_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_mindrecord_mmap(enable)
+
+
+def get_enable_mindrecord_mmap():
+    """
+    Get whether MindRecord files are read through memory mapping. It is set to False by default.
+
+    Returns:
+        bool, whether MindRecord files are read through memory mapping.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> enable_mmap = ds.config.get_enable_mindrecord_mmap()
+    """
+    return _config.get_enable_mindrecord_mmap()
+
+
+def set_enable_jpeg_scaled_decode(enable):
+    """
+    Set whether JPEG images are decoded at a reduced scale when they are resized right after they are decoded.
+    When enabled, :class:`mindspore.dataset.vision.RandomCropDecodeResize` , and
+    :class:`mindspore.dataset.vision.Decode` followed by :class:`mindspore.dataset.vision.Resize` in the same map
+    operation, decode a JPEG image at the smallest scale of 1/8, 1/4 or 1/2 whose output is still not smaller than
+    the size it is resized to. The scaled decoding is done in the DCT domain by libjpeg, which is several times
+    faster than decoding the image at full resolution for a large reduction.
+
+    Note:
+        The image is shrunk by the scaled decoding before it is resized, so the output may differ slightly from
+        the output of the full resolution decoding.
+
+    Args:
+        enable (bool): Whether to decode JPEG images at a reduced scale when they are resized afterwards.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_jpeg_scaled_decode(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_jpeg_scaled_decode(enable)
+
+
+def get_enable_jpeg_scaled_decode():
+    """
+    Get whether JPEG images are decoded at a reduced scale when they are resized afterwards.
+    It is set to False by default.
+
+    Returns:
+        bool, whether JPEG images are decoded at a reduced scale when they are resized afterwards.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> enable_scaled_decode = ds.config.get_enable_jpeg_scaled_decode()
+    """
+    return _config.get_enable_jpeg_scaled_decode()
+
+
+def set_io_prefetch_depth(depth):
+    """
+    Set the max number of blocks read ahead by each TFRecordDataset, TextFileDataset, CSVDataset and CLUEDataset.
+    When it is greater than 0, the files of these datasets are read in blocks of 1 MB by a shared I/O engine, which
+    keeps up to `depth` reads in flight across the files to be loaded, and the workers parse the blocks read ahead.
+    It helps when the files are stored on a file system with high latency.
+
+    Note:
+        Compressed TFRecord files are not read ahead, and the files are not read ahead on Windows.
+
+    Args:
+        depth (int): The max number of blocks read ahead, 0 means the files are read by the workers.
+            The value should be in range [0, INT32_MAX]. Default: 0.
+
+    Raises:
+        TypeError: If `depth` is not of type int.
+        ValueError: If `depth` is less than 0 or larger than INT32_MAX.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_io_prefetch_depth(16)
+    """
+    if not isinstance(depth, int) or isinstance(depth, bool):
+        raise TypeError("depth must be of type int, but got {}.".format(type(depth)))
+    if depth < 0 or depth > INT32_MAX:
+        raise ValueError("depth should be in range [0, {}], but got {}.".format(INT32_MAX, depth))
+    _config.set_io_prefetch_depth(depth)
+
+
+def get_io_prefetch_depth():
+    """
+    Get the max number of blocks read ahead by each TFRecordDataset, TextFileDataset, CSVDataset and CLUEDataset.
+    It is set to 0 by default, which means the files are read by the workers.
+
+    Returns:
+        int, the max number of blocks read ahead.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> depth = ds.config.get_io_prefetch_depth()
+    """
+    return _config.get_io_prefetch_depth()
+
+
+def set_batch_buffer_pool_size(size):
+    """
+    Set the max number of idle buffers kept for each column by each batch operation.
+    When it is greater than 0, the batch operation assembles each numeric column of a batch in one contiguous buffer
+    taken from a pool, and pads the rows straight into their slots of the buffer if padding is needed. A buffer goes
+    back to the pool once the batch is released, e.g. after it is sent to the device, so the batches are assembled in
+    recycled memory instead of new allocations.
+
+    Note:
+        Setting it to 2 times the number of parallel workers of the batch operation lets each worker assemble a batch
+        while the previous one is consumed. Batches of a single row, and batches which are concatenated by
+        `per_batch_map` , are not assembled in pooled buffers.
+
+    Args:
+        size (int): The max number of idle buffers kept for each column, 0 means the buffers are not pooled.
+            The value should be in range [0, INT32_MAX]. Default: 0.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` is less than 0 or larger than INT32_MAX.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_batch_buffer_pool_size(16)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size must be of type int, but got {}.".format(type(size)))
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("size should be in range [0, {}], but got {}.".format(INT32_MAX, size))
+    _config.set_batch_buffer_pool_size(size)
+
+
+def get_batch_buffer_pool_size():
+    """
+    Get the max number of idle buffers kept for each column by each batch operation.
+    It is set to 0 by default, which means the buffers are not pooled.
+
+    Returns:
+        int, the max number of idle buffers kept for each column.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> size = ds.config.get_batch_buffer_pool_size()
+    """
+    return _config.get_batch_buffer_pool_size()
+
+
+def set_shuffle_spill(mem_limit, spill_dir=None):
+    """
+    Set the memory limit of the shuffle buffer of each shuffle operation, beyond which the buffered rows are spilled
+    to local disk.
+    When `mem_limit` is greater than 0, the shuffle operation keeps its buffered rows serialized in blocks instead of
+    as tensors. Once the blocks in memory exceed `mem_limit` bytes, the oldest full blocks are written to `spill_dir` ,
+    and a spilled row is read back when it is drawn. Rows are drawn uniformly from the rows in memory and on disk, so
+    a much larger `buffer_size` of shuffle can be used with bounded memory, and the output is the same as that of the
+    shuffle operation without spilling.
+
+    Note:
+        The disk space of the spilled rows is released at the end of each epoch. Rows holding Python objects can not
+        be spilled.
+
+    Args:
+        mem_limit (int): The max number of bytes of the buffered rows kept in memory by each shuffle operation,
+            0 means the rows are kept in memory as they are. Default: 0.
+        spill_dir (str, optional): The directory the rows are spilled to. Default: None, the temporary directory of
+            the system is used.
+
+    Raises:
+        TypeError: If `mem_limit` is not of type int.
+        ValueError: If `mem_limit` is less than 0.
+        TypeError: If `spill_dir` is not of type str.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_shuffle_spill(1024 * 1024 * 1024, "/path/to/spill_dir")
+    """
+    if not isinstance(mem_limit, int) or isinstance(mem_limit, bool):
+        raise TypeError("mem_limit must be of type int, but got {}.".format(type(mem_limit)))
+    if mem_limit < 0:
+        raise ValueError("mem_limit should not be less than 0, but got {}.".format(mem_limit))
+    if spill_dir is None:
+        spill_dir = tempfile.gettempdir()
+    if not isinstance(spill_dir, str):
+        raise TypeError("spill_dir must be of type str, but got {}.".format(type(spill_dir)))
+    _config.set_shuffle_spill_mem_limit(mem_limit)
+    _config.set_shuffle_spill_dir(os.path.realpath(spill_dir))
+
+
+def get_shuffle_spill_mem_limit():
+    """
+    Get the memory limit of the shuffle buffer of each shuffle operation.
+    It is set to 0 by default, which means the buffered rows are not spilled.
+
+    Returns:
+        int, the max number of bytes of the buffered rows kept in memory by each shuffle operation.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> mem_limit = ds.config.get_shuffle_spill_mem_limit()
+    """
+    return _config.get_shuffle_spill_mem_limit()
+
+
+def get_shuffle_spill_dir():
+    """
+    Get the directory the shuffle operations spill their buffered rows to.
+
+    Returns:
+        str, the directory the buffered rows are spilled to.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> spill_dir = ds.config.get_shuffle_spill_dir()
+    """
+    return _config.get_shuffle_spill_dir()
+
+
+def set_graph_csr_store_dir(store_dir):
+    """
+    Set the directory the graphs of :class:`mindspore.dataset.Graph` and :class:`mindspore.dataset.GraphData` are
+    stored in as compressed sparse row (CSR) arrays.
+    When it is set, the first load of a graph from MindRecord files writes its nodes, edges and features to a file
+    under `store_dir` , and the later loads of the same graph map that file into memory instead of parsing the
+    MindRecord files again. The neighbors and features are then read straight from the arrays, which take much less
+    memory than the node and edge objects, and whose pages are shared by the processes loading the same graph.
+
+    Note:
+        The store is rewritten when the MindRecord file changes. It is not used by a graph in server mode, nor by a
+        graph with string features or features of varying shape, which are kept as node and edge objects.
+        The nodes and edges of a stored graph are ordered by their ids, so `get_all_nodes` and `get_all_edges` return
+        them in ascending id order rather than in the order they are loaded from the MindRecord files.
+
+    Args:
+        store_dir (str): The directory the CSR stores are kept in. None or an empty string means the graphs are kept
+            as node and edge objects.
+
+    Raises:
+        TypeError: If `store_dir` is not of type str.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_graph_csr_store_dir("/path/to/store_dir")
+    """
+    if store_dir is None:
+        store_dir = ""
+    if not isinstance(store_dir, str):
+        raise TypeError("store_dir must be of type str, but got {}.".format(type(store_dir)))
+    _config.set_graph_csr_store_dir(os.path.realpath(store_dir) if store_dir else "")
+
+
+def get_graph_csr_store_dir():
+    """
+    Get the directory the graphs are stored in as CSR arrays.
+    It is an empty string by default, which means the graphs are kept as node and edge objects.
+
+    Returns:
+        str, the directory the CSR stores are kept in.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> store_dir = ds.config.get_graph_csr_store_dir()
+    """
+    return _config.get_graph_csr_store_dir()
+
+
+def set_numa_partition(numa_partition):
+    """
+    Set whether the dataset pipelines run partitioned over the NUMA nodes of the host.
+    When it is enabled, the workers of each parallel dataset operation are spread over the NUMA nodes in turn, that is,
+    worker `i` runs on the cpus of node `i % num_nodes` , and the rows a worker produces are allocated from a memory
+    pool of its node. As the rows are dispatched to the workers in turn as well, row `r` is processed on node
+    `r % num_nodes` by every operation whose `num_parallel_workers` is a multiple of the number of nodes, so the rows
+    stay in the memory of the node that reads them.
+
+    Note:
+        It takes no effect on a host with a single NUMA node, nor when the whole process is bound to one node by
+        :func:`mindspore.dataset.config.set_numa_enable` . Set `num_parallel_workers` of the operations to a multiple
+        of the number of NUMA nodes to keep the rows on one node from an operation to the next.
+
+    Args:
+        numa_partition (bool): Whether to run the dataset pipelines partitioned over the NUMA nodes.
+
+    Raises:
+        TypeError: If `numa_partition` is not of type bool.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_numa_partition(True)
+    """
+    if not isinstance(numa_partition, bool):
+        raise TypeError("numa_partition must be of type bool, but got {}.".format(type(numa_partition)))
+    _config.set_numa_partition(numa_partition)
+
+
+def get_numa_partition():
+    """
+    Get whether the dataset pipelines run partitioned over the NUMA nodes of the host.
+    It is disabled by default.
+
+    Returns:
+        bool, whether the dataset pipelines run partitioned over the NUMA nodes.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> numa_partition = ds.config.get_numa_partition()
+    """
+    return _config.get_numa_partition()
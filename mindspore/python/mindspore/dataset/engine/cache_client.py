@@ -39,6 +39,10 @@ class DatasetCache:
         num_connections (int, optional): Number of tcp/ip connections. Default: ``None`` , use default value 12.
         prefetch_size (int, optional): The size of the cache queue between operations.
             Default: ``None`` , use default value 20.
+        shared (bool, optional): Whether or not sharing the cache with other sessions on the same cache server.
+            The cache is keyed by the pipeline below it, so the sessions whose pipelines below the cache are the
+            same read the rows cached by each other, and the cache is destroyed with the last of them.
+            Default: ``False``.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -52,7 +56,7 @@ class DatasetCache:
     """
 
     def __init__(self, session_id, size=0, spilling=False, hostname=None, port=None, num_connections=None,
-                 prefetch_size=None):
+                 prefetch_size=None, shared=False):
         check_pos_uint32(session_id, "session_id")
         type_check(size, (int,), "size")
         if size != 0:
@@ -68,6 +72,7 @@ class DatasetCache:
             check_pos_int32(num_connections, "num_connections")
         if prefetch_size is not None:
             check_pos_int32(prefetch_size, "prefetch_size")
+        type_check(shared, (bool,), "shared")
 
         self.session_id = session_id
         self.size = size
@@ -76,7 +81,9 @@ class DatasetCache:
         self.port = port
         self.prefetch_size = prefetch_size
         self.num_connections = num_connections
-        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size)
+        self.shared = shared
+        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size,
+                                        shared)
 
     def get_stat(self):
         """
@@ -99,5 +106,6 @@ class DatasetCache:
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
         new_cache.num_connections = copy.deepcopy(self.num_connections, memodict)
+        new_cache.shared = copy.deepcopy(self.shared, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
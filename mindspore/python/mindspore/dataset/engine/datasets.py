@@ -269,9 +269,9 @@ def _set_dataset_permissions(file_name, num_files):
     for item in paths:
         if os.path.exists(item):
             os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
 
 
 class Dataset:
@@ -183,6 +183,28 @@ class Iterator:
         """
         self._iterator.Reset(step, epoch)
 
+    def _get_pipeline_state(self):
+        """
+        Get the state of the pipeline, which the iterator can be restored to by `_restore`. It is the epoch and the
+        step in it of the next row, and the states of the operations which are not determined by the epoch, such as
+        the random generator of shuffle.
+
+        Returns:
+            str, the pipeline state in JSON format.
+        """
+        return self._iterator.GetPipelineState()
+
+    def _restore(self, pipeline_state):
+        """
+        Restore the iterator to a pipeline state got by `_get_pipeline_state`. The iterator resumes from the next row
+        of the state. The rows before it in the epoch are skipped as close to the data source as possible, so they are
+        usually not processed by the shuffle and map operations again.
+
+        Args:
+            pipeline_state (str): The pipeline state in JSON format.
+        """
+        self._iterator.Restore(pipeline_state)
+
     def __convert_python(self, obj, to_numpy):
         """
         Attempts to recursively convert a python object to Numpy array(s) or tensor(s).
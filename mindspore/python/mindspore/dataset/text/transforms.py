@@ -860,6 +860,9 @@ class WordpieceTokenizer(TextTensorOperation):
                 unknown word will be directly returned as the output. Otherwise, the set string will be returned as the
                 output. Default: ``'[UNK]'``.
         with_offsets (bool, optional): Whether to return the offsets of tokens. Default: ``False``.
+        output_ids (bool, optional): Whether to output the ids of the tokens in the vocabulary instead of the tokens,
+            which is the same as a following :class:`mindspore.dataset.text.Lookup` but without building the strings
+            of the tokens. The id of `unknown_token` is output for unknown words. Default: ``False``.
 
     Raises:
         TypeError: If `vocab` is not of type :class:`mindspore.dataset.text.Vocab` .
@@ -867,7 +870,9 @@ class WordpieceTokenizer(TextTensorOperation):
         TypeError: If `max_bytes_per_token` is not of type int.
         TypeError: If `unknown_token` is not of type str.
         TypeError: If `with_offsets` is not of type bool.
+        TypeError: If `output_ids` is not of type bool.
         ValueError: If `max_bytes_per_token` is negative.
+        RuntimeError: If `output_ids` is ``True`` and `unknown_token` is not a word of `vocab` .
 
     Supported Platforms:
         ``CPU``
@@ -899,17 +904,18 @@ class WordpieceTokenizer(TextTensorOperation):
 
     @check_wordpiece_tokenizer
     def __init__(self, vocab, suffix_indicator='##', max_bytes_per_token=100, unknown_token='[UNK]',
-                 with_offsets=False):
+                 with_offsets=False, output_ids=False):
         super().__init__()
         self.vocab = vocab
         self.suffix_indicator = suffix_indicator
         self.max_bytes_per_token = max_bytes_per_token
         self.unknown_token = unknown_token
         self.with_offsets = with_offsets
+        self.output_ids = output_ids
 
     def parse(self):
         return cde.WordpieceTokenizerOperation(self.vocab.c_vocab, self.suffix_indicator, self.max_bytes_per_token,
-                                               self.unknown_token, self.with_offsets)
+                                               self.unknown_token, self.with_offsets, self.output_ids)
 
 
 if platform.system().lower() != 'windows':
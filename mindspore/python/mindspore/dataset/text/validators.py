@@ -258,7 +258,7 @@ def check_wordpiece_tokenizer(method):
 
     @wraps(method)
     def new_method(self, *args, **kwargs):
-        [vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets], _ = \
+        [vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets, output_ids], _ = \
             parse_user_args(method, *args, **kwargs)
         if vocab is None:
             raise ValueError("vocab is not provided.")
@@ -270,6 +270,8 @@ def check_wordpiece_tokenizer(method):
             raise TypeError("Wrong input type for unknown_token, should be string.")
         if not isinstance(with_offsets, bool):
             raise TypeError("Wrong input type for with_offsets, should be boolean.")
+        if not isinstance(output_ids, bool):
+            raise TypeError("Wrong input type for output_ids, should be boolean.")
         check_uint32(max_bytes_per_token)
         return method(self, *args, **kwargs)
 
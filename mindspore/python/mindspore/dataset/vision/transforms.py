@@ -1419,12 +1419,13 @@ class HWC2CHW(ImageTensorOperation):
     """
     Transpose the input image from shape <H, W, C> to <C, H, W>.
     If the input image is of shape <H, W>, it will remain unchanged.
+    A batch of images of shape <..., H, W, C> is transposed to <..., C, H, W> in a single pass.
 
     Note:
         This operation supports running on Ascend or GPU platforms by Offload.
 
     Raises:
-        RuntimeError: If shape of the input image is not <H, W> or <H, W, C>.
+        RuntimeError: If shape of the input image is not <H, W>, <H, W, C> or <..., H, W, C>.
 
     Supported Platforms:
         ``CPU``
@@ -1704,6 +1705,7 @@ class Normalize(ImageTensorOperation):
 
     Note:
         This operation supports running on Ascend or GPU platforms by Offload.
+        A batch of images of shape <..., H, W, C> after a batch operation is normalized in a single pass.
 
     Args:
         mean (sequence): List or tuple of mean values for each channel, with respect to channel order.
@@ -3026,6 +3028,8 @@ class RandomGrayscale(PyTensorOperation):
 class RandomHorizontalFlip(ImageTensorOperation, PyTensorOperation):
     """
     Randomly flip the input image horizontally with a given probability.
+    When applied right after a batch operation, each sample of the batch is flipped with the given probability
+    on its own, otherwise a tensor of shape <..., H, W, C> is flipped as a whole.
 
     Args:
         prob (float, optional): Probability of the image being flipped,
@@ -3034,7 +3038,7 @@ class RandomHorizontalFlip(ImageTensorOperation, PyTensorOperation):
     Raises:
         TypeError: If `prob` is not of type float.
         ValueError: If `prob` is not in range [0.0, 1.0].
-        RuntimeError: If given tensor shape is not <H, W> or <H, W, C>.
+        RuntimeError: If given tensor shape is not <H, W>, <H, W, C> or <..., H, W, C>.
 
     Supported Platforms:
         ``CPU``
@@ -3966,6 +3970,7 @@ class Rescale(ImageTensorOperation):
 
     Note:
         This operation supports running on Ascend or GPU platforms by Offload.
+        A batch of images of shape <..., H, W, C> after a batch operation is rescaled in a single pass.
 
     Args:
         rescale (float): Rescale factor.
@@ -103,6 +103,7 @@ class FileWriter:
         self._header = ShardHeader()
         self._writer = ShardWriter()
         self._generator = None
+        self._blob_compression = None
 
         # parallel write mode
         self._parallel_writer = None
@@ -340,6 +341,8 @@ class FileWriter:
             for i, path in enumerate(self._paths):
                 self._writers[i] = ShardWriter()
                 self._writers[i].open([path], self._overwrite)
+                if self._blob_compression is not None:
+                    self._writers[i].set_blob_compression(self._blob_compression)
                 self._writers[i].set_shard_header(self._header)
 
                 # launch the workers for parallel write
@@ -420,6 +423,36 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_blob_compression(self, compression):
+        """
+        Set the codec to compress the blob of every sample, which contains the fields \
+        of bytes type and the arrays. Blobs are decompressed transparently when the \
+        MindRecord files are read. Files which compress the blob can not be read by \
+        older versions of MindSpore.
+
+        Note:
+            It should be called before the first `write_raw_data` .
+
+        Args:
+            compression (str): The codec of the blob, ``'none'`` or ``'zlib'`` .
+                ``'zlib'`` is not supported on Windows.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamValueError: If `compression` is not supported.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> status = writer.set_blob_compression("zlib")
+        """
+        if compression not in ('none', 'zlib'):
+            raise ParamValueError("The blob compression should be 'none' or 'zlib', but got {}.".format(compression))
+        self._blob_compression = compression
+        return self._writer.set_blob_compression(compression)
+
     def commit(self):  # pylint: disable=W0212
         """
         Flush data in memory to disk and generate the corresponding database files.
@@ -460,6 +493,8 @@ class FileWriter:
                 for i, path in enumerate(self._paths):
                     self._writers[i] = ShardWriter()
                     self._writers[i].open(path, self._overwrite)
+                    if self._blob_compression is not None:
+                        self._writers[i].set_blob_compression(self._blob_compression)
                     self._writers[i].set_shard_header(self._header)
 
             self._parallel_commit()
@@ -471,10 +506,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -126,6 +126,18 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_blob_compression(self, blob_compression):
+        """
+        Set the codec to compress the blob of every sample.
+
+        Args:
+           blob_compression (str): The codec of the blob, 'none' or 'zlib'.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+        """
+        return self._writer.set_blob_compression(blob_compression)
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
@@ -185,8 +185,8 @@ def connect_network_with_dataset(network, dataset_helper):
     data channel corresponding to the 'queue_name' and passed to the input network during forward computation.
 
     Note:
-        In the case of running the network on Ascend/GPU in graph mode, this function will wrap the input network with
-        :class:`mindspore.ops.GetNext`. In other cases, the input network will be returned with no change.
+        In the case of running the network on Ascend/GPU/CPU in graph mode, this function will wrap the input network
+        with :class:`mindspore.ops.GetNext`. In other cases, the input network will be returned with no change.
         The :class:`mindspore.ops.GetNext` is required to get data only in sink mode,
         so this function is not applicable to no-sink mode.
         when dataset_helper's dataset_sink_mode is True, it can only be connected to one network.
@@ -197,13 +197,13 @@ def connect_network_with_dataset(network, dataset_helper):
             name of the dataset to wrap the `GetNext`.
 
     Returns:
-        Cell, a new network wrapped with 'GetNext' in the case of running the task on Ascend in graph mode, otherwise
+        Cell, a new network wrapped with 'GetNext' in the case of running the task in graph mode, otherwise
         it is the input network.
 
     Raises:
         RuntimeError: If the API was not called in dataset sink mode.
     Supported Platforms:
-        ``Ascend`` ``GPU``
+        ``Ascend`` ``GPU`` ``CPU``
 
     Examples:
         >>> import numpy as np
@@ -262,7 +262,7 @@ def connect_network_with_dataset(network, dataset_helper):
     if hasattr(aux, '__sink_network__'):
         network = aux.__sink_network__
     else:
-        if context.get_context("device_target") in ("Ascend", "GPU"):
+        if context.get_context("device_target") in ("Ascend", "GPU", "CPU"):
             network = offload.check_add_offload_sink_mode(
                 dataset, dataset_helper, network)
             network = _generate_network_with_dataset(
@@ -328,8 +328,7 @@ class DatasetHelper:
             if context.get_context("mode") == context.GRAPH_MODE:
                 if _is_role_sched():
                     iterclass = _DatasetIterPSServer
-                elif (context.get_context("device_target") == "Ascend") or \
-                        (context.get_context("device_target") == "GPU"):
+                elif context.get_context("device_target") in ("Ascend", "GPU", "CPU"):
                     iterclass = _DatasetIterMSLoopSink
                 else:
                     target = context.get_context("device_target")
@@ -517,8 +516,7 @@ class _DatasetIter:
         if hasattr(self.dataset, '__loop_size__'):
             sink_size = self.dataset.__loop_size__
         else:
-            if context.get_context("enable_ge") or context.get_context("device_target") == "Ascend" \
-                    or context.get_context("device_target") == "GPU":
+            if context.get_context("enable_ge") or context.get_context("device_target") in ("Ascend", "GPU", "CPU"):
                 if self.sink_size > 0:
                     sink_size = self.sink_size
                 else:
@@ -561,7 +559,7 @@ class _DatasetIterPyNative(_DatasetIter):
 
 
 class _DatasetIterMSLoopSink(_DatasetIter):
-    """Iter for context (device_target=Ascend)"""
+    """Iter for context (device_target=Ascend, GPU or CPU)"""
 
     def __init__(self, dataset, sink_size, epoch_num):
         super().__init__(dataset, sink_size, epoch_num)
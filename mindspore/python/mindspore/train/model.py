@@ -1,4 +1,4 @@
-# Copyright 2020-2022 Huawei Technologies Co., Ltd
+# Copyright 2020-2023 Huawei Technologies Co., Ltd
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -47,6 +47,7 @@ from mindspore.context import ParallelMode
 from mindspore.parallel._recovery_context import _set_recovery_context, _get_recovery_context
 from mindspore.train.dataset_helper import DatasetHelper, connect_network_with_dataset
 from mindspore.common.api import _pynative_executor
+from mindspore.common._utils import is_shape_unknown
 from mindspore.dataset.core.config import get_debug_mode
 from mindspore.dataset.engine.datasets import _set_training_dataset, _reset_training_dataset
 from mindspore.train import amp
@@ -63,6 +64,23 @@ def _transfer_tensor_to_tuple(inputs):
     return inputs
 
 
+def _is_dynamic_shape_sink_on_cpu(network, dataset):
+    """
+    Check whether the data of dynamic shape would be sunk on CPU, whose dataset channel only supports static shapes.
+    The shapes are known to be dynamic by the inputs set to the network, or by the estimated shapes of the dataset,
+    which are cached by the dataset once estimated.
+    """
+    if context.get_context("device_target") != "CPU":
+        return False
+    shapes = [inp.shape if inp is not None else None for inp in network.get_inputs() or []]
+    if hasattr(dataset, "output_shapes"):
+        shapes.extend(dataset.output_shapes(estimate=True))
+    for shape in shapes:
+        if shape is None or None in shape or is_shape_unknown(shape):
+            return True
+    return False
+
+
 class _StepSync(Callback):
     @staticmethod
     def step_end(run_context):
@@ -569,8 +587,8 @@ class Model:
             callbacks (list): List of callback objects which should be executed while training. Default: ``None``.
             dataset_sink_mode (bool): Determine whether the data should be passed through the dataset channel.
                                       Default: ``True``.
-                                      Configure pynative mode or CPU, the training process will be performed with
-                                      dataset not sink.
+                                      Configure pynative mode, or CPU with dynamic shape data, the training process
+                                      will be performed with dataset not sink.
             sink_size (int): Control the amount of data in each sink. Default: -1.
             initial_epoch (int): Epoch at which to start train, it used for resuming a previous training run.
                                  Default: 0.
@@ -578,6 +596,10 @@ class Model:
         epoch = Validator.check_positive_int(epoch)
         if self._parameter_broadcast:
             self._train_network.set_broadcast_flag()
+        if dataset_sink_mode and _is_dynamic_shape_sink_on_cpu(self._train_network, train_dataset):
+            dataset_sink_mode = False
+            logger.warning("The CPU cannot support dataset sink mode with dynamic shape data currently. "
+                           "So the training process will be performed with dataset not sink.")
 
         cb_params = _InternalCallbackParam()
         cb_params.train_network = self._train_network
@@ -611,10 +633,6 @@ class Model:
             self._check_reuse_dataset(train_dataset)
             if not dataset_sink_mode:
                 self._train_process(epoch, train_dataset, list_callback, cb_params, initial_epoch, valid_infos)
-            elif context.get_context("device_target") == "CPU":
-                logger.info("The CPU cannot support dataset sink mode currently."
-                            "So the training process will be performed with dataset not sink.")
-                self._train_process(epoch, train_dataset, list_callback, cb_params, initial_epoch, valid_infos)
             else:
                 self._train_dataset_sink_process(epoch, train_dataset, list_callback,
                                                  cb_params, sink_size, initial_epoch, valid_infos)
@@ -955,7 +973,8 @@ class Model:
         """
         Training API.
 
-        When setting pynative mode or CPU, the training process will be performed with dataset not sink.
+        When setting pynative mode, or CPU with dynamic shape data, the training process will be performed with dataset
+        not sink.
 
         Note:
             If dataset_sink_mode is True, data will be sent to device. If the device is Ascend, features
@@ -988,8 +1007,8 @@ class Model:
                                                             which should be executed while training.
                                                             Default: ``None``.
             dataset_sink_mode (bool): Determines whether to pass the data through dataset channel.
-                                      Configure pynative mode or CPU, the training process will be performed with
-                                      dataset not sink. Default: ``False``.
+                                      Configure pynative mode, or CPU with dynamic shape data, the training process
+                                      will be performed with dataset not sink. Default: ``False``.
             sink_size (int): Control the number of steps for each sinking.
                              `sink_size` is invalid if `dataset_sink_mode` is False.
                              If sink_size = -1, sink the complete dataset for each epoch.
@@ -1137,8 +1156,8 @@ class Model:
                                                             which should be executed while training.
                                                             Default: ``None`` .
             dataset_sink_mode (bool): Determines whether to pass the train data through dataset channel.
-                                      Configure pynative mode or CPU, the training process will be performed with
-                                      dataset not sink. Default: ``False`` .
+                                      Configure pynative mode, or CPU with dynamic shape data, the training process
+                                      will be performed with dataset not sink. Default: ``False`` .
             valid_dataset_sink_mode (bool): Determines whether to pass the validation data through dataset channel.
                                       Default: ``False`` .
             sink_size (int): Control the number of steps for each sinking.
@@ -1286,10 +1305,10 @@ class Model:
 
         self._clear_metrics()
 
-        if context.get_context("device_target") == "CPU" and dataset_sink_mode:
+        if dataset_sink_mode and _is_dynamic_shape_sink_on_cpu(self._eval_network, valid_dataset):
             dataset_sink_mode = False
-            logger.info("CPU cannot support dataset sink mode currently."
-                        "So the evaluating process will be performed with dataset non-sink mode.")
+            logger.warning("The CPU cannot support dataset sink mode with dynamic shape data currently. "
+                           "So the evaluating process will be performed with dataset non-sink mode.")
 
         with _CallbackManager(callbacks) as list_callback:
             if dataset_sink_mode:
@@ -1392,7 +1411,8 @@ class Model:
         """
         Evaluation API.
 
-        Configure to pynative mode or CPU, the evaluating process will be performed with dataset non-sink mode.
+        Configure to pynative mode, or CPU with dynamic shape data, the evaluating process will be performed with
+        dataset non-sink mode.
 
         Note:
             If dataset_sink_mode is True, data will be sent to device. At this point, the dataset will be bound to this
@@ -1460,10 +1480,10 @@ class Model:
             cb_params.metrics = metrics
             return metrics
 
-        if context.get_context("device_target") == "CPU" and dataset_sink_mode:
+        if dataset_sink_mode and _is_dynamic_shape_sink_on_cpu(self._eval_network, valid_dataset):
             dataset_sink_mode = False
-            logger.info("CPU cannot support dataset sink mode currently."
-                        "So the evaluating process will be performed with dataset non-sink mode.")
+            logger.warning("The CPU cannot support dataset sink mode with dynamic shape data currently. "
+                           "So the evaluating process will be performed with dataset non-sink mode.")
 
         with _CallbackManager(callbacks) as list_callback:
             if dataset_sink_mode:
@@ -1641,7 +1661,7 @@ class Model:
                          be returned. The data and label would be passed to the network and loss
                          function respectively.
             dataset_sink_mode (bool): Determines whether to pass the data through dataset channel.
-                                      Configure pynative mode or CPU, the training process will be performed with
+                                      Configure pynative mode, the training process will be performed with
                                       dataset not sink. Default: ``True`` .
             sink_size (int): Control the number of steps for each sinking.
                              If sink_size = -1, sink the complete dataset for each epoch.
@@ -0,0 +1,143 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test dataset sink mode on CPU """
+import time
+
+import pytest
+import numpy as np
+
+import mindspore as ms
+from mindspore import Model, Tensor, nn
+from mindspore import dataset as ds
+from mindspore import log as logger
+from mindspore.train.callback import Callback
+
+
+def get_data(num, w=2.0, b=3.0):
+    rng = np.random.default_rng(0)
+    for _ in range(num):
+        x = rng.uniform(-1.0, 1.0, (4,)).astype(np.float32)
+        y = np.array([x.sum() * w + b]).astype(np.float32)
+        yield x, y
+
+
+def create_dataset(num_data, batch_size=32):
+    input_data = ds.GeneratorDataset(list(get_data(num_data)), column_names=['data', 'label'], shuffle=False)
+    return input_data.batch(batch_size, drop_remainder=True)
+
+
+def define_model(dynamic_inputs=False):
+    ms.set_seed(1)
+    net = nn.Dense(4, 1)
+    if dynamic_inputs:
+        net.set_inputs(Tensor(shape=[None, 4], dtype=ms.float32))
+    net_loss = nn.MSELoss()
+    net_opt = nn.Momentum(net.trainable_params(), 0.01, 0.9)
+    return Model(net, loss_fn=net_loss, optimizer=net_opt)
+
+
+class StepRecorder(Callback):
+    """
+    Record the loss and the time of each step, a step of sink mode runs sink_size batches.
+    """
+
+    def __init__(self):
+        super(StepRecorder, self).__init__()
+        self.losses = []
+        self.step_times = []
+        self.begin = 0
+
+    def on_train_step_begin(self, run_context):
+        self.begin = time.time()
+
+    def on_train_step_end(self, run_context):
+        self.step_times.append(time.time() - self.begin)
+        loss = run_context.original_args().net_outputs
+        self.losses.append(float(loss.asnumpy()))
+
+
+def run_train(epoch, sink_mode, sink_size=-1, dynamic_inputs=False):
+    model = define_model(dynamic_inputs)
+    recorder = StepRecorder()
+    model.train(epoch, create_dataset(1024), callbacks=[recorder], dataset_sink_mode=sink_mode, sink_size=sink_size)
+    return recorder
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize('sink_size', [1, 8, -1])
+def test_cpu_sink_mode_same_as_non_sink(sink_size):
+    """
+    Feature: Dataset sink mode on CPU.
+    Description: Train the same network in dataset sink mode with different sink_size and in non-sink mode.
+    Expectation: The loss of each epoch is the same, the time of a batch in both modes is reported.
+    """
+    ms.set_context(mode=ms.GRAPH_MODE, device_target="CPU")
+    epoch = 2
+    non_sink = run_train(epoch, False)
+    sink = run_train(epoch, True, sink_size)
+
+    # A sink epoch is one step which runs sink_size batches, its loss is the one of its last batch
+    steps_per_sink = 32 if sink_size == -1 else sink_size
+    expected = non_sink.losses[steps_per_sink - 1::steps_per_sink][:epoch]
+    assert len(sink.losses) == epoch
+    assert np.allclose(sink.losses, expected, rtol=1e-4, atol=1e-5)
+
+    # The first step contains the compilation
+    non_sink_time = np.mean(non_sink.step_times[1:])
+    sink_time = np.mean(sink.step_times[1:]) / steps_per_sink
+    logger.info("Time of a batch, non-sink mode: {:.6f}s, sink mode with sink_size {}: {:.6f}s".format(
+        non_sink_time, sink_size, sink_time))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_sink_mode_fall_back_for_dynamic_inputs():
+    """
+    Feature: Dataset sink mode on CPU.
+    Description: Train in dataset sink mode a network whose inputs are set to dynamic shapes.
+    Expectation: The training falls back to non-sink mode, and the losses are the same as non-sink mode.
+    """
+    ms.set_context(mode=ms.GRAPH_MODE, device_target="CPU")
+    epoch = 2
+    non_sink = run_train(epoch, False)
+    sink = run_train(epoch, True, dynamic_inputs=True)
+    assert len(sink.losses) == len(non_sink.losses)
+    assert np.allclose(sink.losses, non_sink.losses, rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_sink_mode_dynamic_shape():
+    """
+    Feature: Dataset sink mode on CPU.
+    Description: Train in dataset sink mode with a dataset whose batches have different shapes, which is found by the
+        estimated shapes of the dataset.
+    Expectation: The training falls back to non-sink mode, and runs each batch as a step.
+    """
+    ms.set_context(mode=ms.GRAPH_MODE, device_target="CPU")
+
+    def gen():
+        for i in range(1, 9):
+            yield np.ones((i, 4), np.float32), np.ones((i, 1), np.float32)
+
+    dataset = ds.GeneratorDataset(gen, column_names=['data', 'label'])
+    model = define_model()
+    recorder = StepRecorder()
+    model.train(1, dataset, callbacks=[recorder], dataset_sink_mode=True)
+    assert len(recorder.losses) == 8
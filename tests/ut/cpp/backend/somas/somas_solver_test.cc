@@ -0,0 +1,290 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore::somas {
+constexpr size_t kAlignSize = 512;
+
+// The tensors of a graph, each of which lives between its start and end nodes, and the tensors which live at the same
+// time conflict with each other.
+struct SolverCase {
+  std::vector<std::pair<size_t, size_t>> lifetimes_;
+  std::vector<size_t> sizes_;
+  std::vector<bool> lifelong_;
+  vector<vector<size_t>> continuous_;
+
+  TensorsDescMap CreateTensors() const {
+    TensorsDescMap tensors;
+    for (size_t i = 0; i < sizes_.size(); ++i) {
+      tensors[i] = std::make_shared<SomasSolverTensorDesc>(i, sizes_[i], 0, lifelong_[i]);
+    }
+    return tensors;
+  }
+
+  std::vector<DynamicBitSet> CreateConstraints() const {
+    std::vector<DynamicBitSet> constraints(sizes_.size(), DynamicBitSet(sizes_.size()));
+    for (size_t i = 0; i < sizes_.size(); ++i) {
+      for (size_t j = 0; j < sizes_.size(); ++j) {
+        if (lifetimes_[i].second < lifetimes_[j].first || lifetimes_[j].second < lifetimes_[i].first) {
+          constraints[i].SetBitTrue(j);
+        }
+      }
+    }
+    return constraints;
+  }
+
+  TensorsLifetimeMap CreateLifetimes() const {
+    TensorsLifetimeMap lifetimes;
+    for (size_t i = 0; i < lifetimes_.size(); ++i) {
+      lifetimes[i] = {lifetimes_[i].first, lifetimes_[i].second};
+    }
+    return lifetimes;
+  }
+};
+
+SolverCase GenerateCase(uint32_t seed, size_t tensor_num) {
+  constexpr size_t kMaxLifetime = 20;
+  constexpr size_t kMaxAlignNum = 64;
+  constexpr size_t kLifelongInterval = 50;
+  constexpr size_t kContiguousInterval = 30;
+  std::mt19937 gen(seed);
+  SolverCase solver_case;
+  for (size_t i = 0; i < tensor_num; ++i) {
+    solver_case.lifetimes_.emplace_back(i, i + gen() % kMaxLifetime);
+    solver_case.sizes_.push_back((gen() % kMaxAlignNum + 1) * kAlignSize);
+    solver_case.lifelong_.push_back(i % kLifelongInterval == kLifelongInterval - 1);
+  }
+  // The contiguous tensors are the outputs of the same node.
+  for (size_t i = 0; i + 1 < tensor_num; i += kContiguousInterval) {
+    if (solver_case.lifelong_[i] || solver_case.lifelong_[i + 1]) {
+      continue;
+    }
+    solver_case.lifetimes_[i + 1] = solver_case.lifetimes_[i];
+    solver_case.continuous_.push_back({i, i + 1});
+  }
+  return solver_case;
+}
+
+bool CheckSolution(const SolverCase &solver_case, const TensorsDescMap &tensors, size_t max_offset) {
+  auto constraints = solver_case.CreateConstraints();
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    auto &t1 = tensors.at(i);
+    if (t1->offset_ + t1->size_ > max_offset) {
+      return false;
+    }
+    for (size_t j = i + 1; j < tensors.size(); ++j) {
+      auto &t2 = tensors.at(j);
+      bool conflict = t1->lifelong_ || t2->lifelong_ || !constraints[i].IsBitTrue(j);
+      bool overlap = t1->offset_ < t2->offset_ + t2->size_ && t2->offset_ < t1->offset_ + t1->size_;
+      if (conflict && overlap) {
+        return false;
+      }
+    }
+  }
+  for (const auto &list : solver_case.continuous_) {
+    for (size_t i = 0; i + 1 < list.size(); ++i) {
+      if (tensors.at(list[i])->offset_ + tensors.at(list[i])->size_ != tensors.at(list[i + 1])->offset_) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+class TestSomasSolver : public UT::Common {
+ public:
+  TestSomasSolver() = default;
+};
+
+/// Feature: SomasSolverPre warm start
+/// Description: Solve a graph fully, change the sizes of a few tensors, and warm start from the previous solution
+/// Expectation: The solution is valid, and the unchanged tensors keep their offsets when they are still valid
+TEST_F(TestSomasSolver, TestWarmStartSolving) {
+  constexpr size_t kTensorNum = 1000;
+  constexpr size_t kChangedInterval = 97;
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto solver_case = GenerateCase(0, kTensorNum);
+  auto tensors = solver_case.CreateTensors();
+  auto constraints = solver_case.CreateConstraints();
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(*graph, &tensors, &constraints, solver_case.continuous_, false), SUCCESS);
+  ASSERT_TRUE(CheckSolution(solver_case, tensors, solver.GetMaxOffset()));
+
+  // The changed tensors are not given the previous offsets.
+  std::map<size_t, size_t> prev_offsets;
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    if (i % kChangedInterval == 0) {
+      solver_case.sizes_[i] += kAlignSize;
+    } else {
+      prev_offsets[i] = tensors[i]->offset_;
+    }
+  }
+  auto new_tensors = solver_case.CreateTensors();
+  SomasSolverPre warm_start_solver;
+  ASSERT_EQ(warm_start_solver.WarmStartSolving(*graph, &new_tensors, &constraints, solver_case.continuous_,
+                                               prev_offsets, SIZE_MAX),
+            SUCCESS);
+  EXPECT_TRUE(CheckSolution(solver_case, new_tensors, warm_start_solver.GetMaxOffset()));
+  size_t kept_num = 0;
+  for (const auto &prev_offset : prev_offsets) {
+    kept_num += new_tensors[prev_offset.first]->offset_ == prev_offset.second ? 1 : 0;
+  }
+  EXPECT_GT(kept_num, prev_offsets.size() / 2);
+}
+
+/// Feature: SomasSolverPre warm start
+/// Description: Warm start from the previous offsets which overlap for the conflicting tensors
+/// Expectation: The conflicting tensors are placed again, and the solution is valid
+TEST_F(TestSomasSolver, TestWarmStartConflict) {
+  constexpr size_t kTensorNum = 200;
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto solver_case = GenerateCase(1, kTensorNum);
+  auto tensors = solver_case.CreateTensors();
+  auto constraints = solver_case.CreateConstraints();
+  // All the tensors are at offset 0 previously.
+  std::map<size_t, size_t> prev_offsets;
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    prev_offsets[i] = 0;
+  }
+  SomasSolverPre solver;
+  EXPECT_EQ(solver.WarmStartSolving(*graph, &tensors, &constraints, solver_case.continuous_, prev_offsets, SIZE_MAX),
+            FAILED);
+  for (const auto &pairT : tensors) {
+    EXPECT_EQ(pairT.second->offset_, 0);
+    EXPECT_EQ(pairT.second->right_, nullptr);
+  }
+  // Only a few tensors are at the same offset previously.
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    prev_offsets[i] = i * kAlignSize * kAlignSize;
+  }
+  prev_offsets[1] = prev_offsets[2] = prev_offsets[0];
+  ASSERT_EQ(solver.WarmStartSolving(*graph, &tensors, &constraints, solver_case.continuous_, prev_offsets, SIZE_MAX),
+            SUCCESS);
+  EXPECT_TRUE(CheckSolution(solver_case, tensors, solver.GetMaxOffset()));
+}
+
+/// Feature: SomasSolverPre warm start
+/// Description: Warm start with a limit of max offset lower than the result, and without previous solution
+/// Expectation: The warm start fails
+TEST_F(TestSomasSolver, TestWarmStartLimit) {
+  constexpr size_t kTensorNum = 100;
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto solver_case = GenerateCase(2, kTensorNum);
+  auto tensors = solver_case.CreateTensors();
+  auto constraints = solver_case.CreateConstraints();
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(*graph, &tensors, &constraints, solver_case.continuous_, false), SUCCESS);
+  // The previous solution is kept as a whole.
+  std::map<size_t, size_t> prev_offsets;
+  size_t max_offset = 0;
+  for (const auto &pairT : tensors) {
+    prev_offsets[pairT.first] = pairT.second->offset_;
+    max_offset = std::max(max_offset, pairT.second->offset_ + pairT.second->size_);
+  }
+  auto new_tensors = solver_case.CreateTensors();
+  EXPECT_EQ(solver.WarmStartSolving(*graph, &new_tensors, &constraints, solver_case.continuous_, prev_offsets,
+                                    max_offset - 1),
+            FAILED);
+  EXPECT_EQ(solver.WarmStartSolving(*graph, &new_tensors, &constraints, solver_case.continuous_, {}, SIZE_MAX),
+            FAILED);
+  EXPECT_EQ(solver.WarmStartSolving(*graph, &new_tensors, &constraints, solver_case.continuous_, prev_offsets,
+                                    max_offset),
+            SUCCESS);
+  EXPECT_EQ(solver.GetMaxOffset(), max_offset);
+  EXPECT_TRUE(CheckSolution(solver_case, new_tensors, solver.GetMaxOffset()));
+}
+
+/// Feature: SomasSolverPre timeline solver
+/// Description: Pack the tensors by the timeline solver, and compare with its greedy start, which is the result of
+///     a zero time budget
+/// Expectation: The solution is valid, and it is between the lower bound and the result of the greedy start
+TEST_F(TestSomasSolver, TestTimelineSolving) {
+  constexpr size_t kTensorNum = 1000;
+  constexpr size_t kTimeBudget = 200;
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto solver_case = GenerateCase(3, kTensorNum);
+  auto constraints = solver_case.CreateConstraints();
+  auto greedy_tensors = solver_case.CreateTensors();
+  SomasSolverPre greedy_solver;
+  ASSERT_EQ(greedy_solver.TimelineSolving(*graph, &greedy_tensors, &constraints, solver_case.continuous_,
+                                          solver_case.CreateLifetimes(), 0),
+            SUCCESS);
+  EXPECT_TRUE(CheckSolution(solver_case, greedy_tensors, greedy_solver.GetMaxOffset()));
+
+  auto timeline_tensors = solver_case.CreateTensors();
+  SomasSolverPre timeline_solver;
+  ASSERT_EQ(timeline_solver.TimelineSolving(*graph, &timeline_tensors, &constraints, solver_case.continuous_,
+                                            solver_case.CreateLifetimes(), kTimeBudget),
+            SUCCESS);
+  EXPECT_TRUE(CheckSolution(solver_case, timeline_tensors, timeline_solver.GetMaxOffset()));
+  EXPECT_GT(timeline_solver.GetLowerBound(), 0);
+  EXPECT_GE(timeline_solver.GetMaxOffset(), timeline_solver.GetLowerBound());
+  // the local search only keeps a solution better than its start, however many iterations the budget allows
+  EXPECT_LE(timeline_solver.GetMaxOffset(), greedy_solver.GetMaxOffset());
+  for (const auto &pairT : timeline_tensors) {
+    EXPECT_EQ(pairT.second->right_, nullptr);
+  }
+}
+
+/// Feature: SomasSolverPre timeline solver
+/// Description: Pack the tensors whose optimal solution is the lower bound, and the lifelong tensors
+/// Expectation: The result reaches the lower bound without using up the time budget
+TEST_F(TestSomasSolver, TestTimelineLowerBound) {
+  constexpr size_t kTensorNum = 100;
+  constexpr size_t kTimeBudget = 60000;
+  auto graph = std::make_shared<session::KernelGraph>();
+  // The tensors live one after another, except for the lifelong ones.
+  SolverCase solver_case;
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    solver_case.lifetimes_.emplace_back(i, i + 1);
+    solver_case.sizes_.push_back((i % 7 + 1) * kAlignSize);
+    solver_case.lifelong_.push_back(i % 10 == 0);
+  }
+  size_t lower_bound = 0;
+  size_t lifelong_size = 0;
+  for (size_t i = 0; i < kTensorNum; ++i) {
+    if (solver_case.lifelong_[i]) {
+      lifelong_size += solver_case.sizes_[i];
+    }
+  }
+  for (size_t i = 0; i + 1 < kTensorNum; ++i) {
+    size_t live_size = lifelong_size;
+    live_size += solver_case.lifelong_[i] ? 0 : solver_case.sizes_[i];
+    live_size += solver_case.lifelong_[i + 1] ? 0 : solver_case.sizes_[i + 1];
+    lower_bound = std::max(lower_bound, live_size);
+  }
+  auto tensors = solver_case.CreateTensors();
+  auto constraints = solver_case.CreateConstraints();
+  SomasSolverPre solver;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(solver.TimelineSolving(*graph, &tensors, &constraints, solver_case.continuous_,
+                                   solver_case.CreateLifetimes(), kTimeBudget),
+            SUCCESS);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(kTimeBudget));
+  EXPECT_EQ(solver.GetLowerBound(), lower_bound);
+  EXPECT_EQ(solver.GetMaxOffset(), lower_bound);
+  EXPECT_TRUE(CheckSolution(solver_case, tensors, solver.GetMaxOffset()));
+}
+}  // namespace mindspore::somas
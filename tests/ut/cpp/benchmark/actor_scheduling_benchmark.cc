@@ -0,0 +1,125 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+class BenchmarkActorScheduling : public UT::Common {
+ public:
+  BenchmarkActorScheduling() = default;
+  void SetUp() {}
+};
+
+namespace {
+// An actor of a ring, which forwards a message to the next actor of the ring until the hops run out.
+class RingActor : public ActorBase {
+ public:
+  RingActor(const std::string &name, ActorThreadPool *pool, std::atomic<size_t> *message_count,
+            std::atomic<size_t> *finished_rings, std::promise<void> *all_finished, size_t ring_num)
+      : ActorBase(name, pool),
+        message_count_(message_count),
+        finished_rings_(finished_rings),
+        all_finished_(all_finished),
+        ring_num_(ring_num) {}
+  ~RingActor() override = default;
+
+  void set_next(const AID &next) { next_ = next; }
+
+  void Forward(size_t hops) {
+    (void)message_count_->fetch_add(1, std::memory_order_relaxed);
+    if (hops > 0) {
+      Async(next_, &RingActor::Forward, hops - 1);
+    } else if (finished_rings_->fetch_add(1) + 1 == ring_num_) {
+      all_finished_->set_value();
+    }
+  }
+
+ private:
+  AID next_;
+  std::atomic<size_t> *message_count_;
+  std::atomic<size_t> *finished_rings_;
+  std::promise<void> *all_finished_;
+  size_t ring_num_;
+};
+
+// Run rings of actors forwarding messages, and return the time per message in ns.
+double RunRings(ActorThreadPool *pool, bool lock_free_mailbox) {
+  const size_t kRingNum = 16;
+  const size_t kRingSize = 64;
+  const size_t kHops = 20000;
+  std::atomic<size_t> message_count{0};
+  std::atomic<size_t> finished_rings{0};
+  std::promise<void> all_finished;
+  std::vector<std::vector<std::shared_ptr<RingActor>>> rings(kRingNum);
+  for (size_t r = 0; r < kRingNum; ++r) {
+    for (size_t i = 0; i < kRingSize; ++i) {
+      auto name = "RingActor_" + std::to_string(lock_free_mailbox) + "_" + std::to_string(r) + "_" + std::to_string(i);
+      rings[r].push_back(
+        std::make_shared<RingActor>(name, pool, &message_count, &finished_rings, &all_finished, kRingNum));
+      rings[r][i]->set_lock_free_mailbox(lock_free_mailbox);
+    }
+    for (size_t i = 0; i < kRingSize; ++i) {
+      rings[r][i]->set_next(rings[r][(i + 1) % kRingSize]->GetAID());
+      (void)ActorMgr::GetActorMgrRef()->Spawn(rings[r][i]);
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < kRingNum; ++r) {
+    Async(rings[r][0]->GetAID(), &RingActor::Forward, kHops);
+  }
+  auto finished = all_finished.get_future();
+  EXPECT_EQ(finished.wait_for(std::chrono::seconds(300)), std::future_status::ready);
+  auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(message_count, kRingNum * (kHops + 1));
+
+  for (auto &ring : rings) {
+    for (auto &actor : ring) {
+      ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+    }
+  }
+  return static_cast<double>(cost) / message_count;
+}
+}  // namespace
+
+/// Feature: ActorThreadPool
+/// Description: Benchmark the scheduling overhead per actor message, with rings of actors forwarding messages to their
+///     successors on the actor threads, through the NonblockingMailBox and the LockFreeMailBox
+/// Expectation: All the messages are processed, and the time per message is reported
+TEST_F(BenchmarkActorScheduling, BenchmarkSchedulingOverhead) {
+  const size_t kActorThreadNum = 4;
+  auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kActorThreadNum, {}, BindMode::Power_NoBind);
+  ASSERT_NE(pool, nullptr);
+  pool->SetMaxSpinCount(kDefaultSpinCount);
+  pool->SetSpinCountMaxValue();
+  for (bool lock_free_mailbox : {false, true}) {
+    auto cost = RunRings(pool, lock_free_mailbox);
+    std::cout << (lock_free_mailbox ? "LockFreeMailBox" : "NonblockingMailBox")
+              << ", scheduling overhead per message: " << cost << " ns" << std::endl;
+  }
+  delete pool;
+}
+}  // namespace mindspore
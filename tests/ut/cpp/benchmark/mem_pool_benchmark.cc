@@ -0,0 +1,153 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "include/backend/mem_reuse/mem_dynamic_allocator.h"
+#include "include/backend/mem_reuse/mem_dynamic_allocator_size_class.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kHostPoolUnitSize = 256 << 20;
+constexpr size_t kHostPoolFreeMemSize = static_cast<size_t>(64) << 30;
+
+// The memory pool on the host memory.
+class HostMemPool : public DynamicMemPoolBestFit {
+ public:
+  HostMemPool() { SetMemAllocUintSize(kHostPoolUnitSize, kHostPoolUnitSize); }
+  ~HostMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    return *addr == nullptr ? 0 : size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return kHostPoolFreeMemSize; }
+};
+
+// An operation of the allocation trace, which allocates or frees the memory buf of the id.
+struct TraceOp {
+  bool alloc_;
+  size_t id_;
+  size_t size_;
+};
+
+// Generate the allocation trace of the training steps of a network with dynamic shapes: each kernel allocates its
+// output, which is freed after it is used by the following kernels, and the batch size changes by step.
+std::vector<TraceOp> GenerateTrace(uint32_t seed, size_t step_num, size_t kernel_num) {
+  constexpr size_t kLifetime = 4;
+  constexpr size_t kMaxBatch = 32;
+  constexpr size_t kSmallPercent = 80;
+  constexpr size_t kPercent = 100;
+  std::mt19937 gen(seed);
+  std::vector<size_t> small_sizes;
+  std::vector<size_t> large_sizes;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    small_sizes.push_back(gen() % (4 << 10) + 4);
+    large_sizes.push_back(gen() % (128 << 10) + 4);
+  }
+  std::vector<TraceOp> trace;
+  size_t id = 0;
+  for (size_t step = 0; step < step_num; ++step) {
+    size_t batch = gen() % kMaxBatch + 1;
+    std::vector<std::pair<size_t, size_t>> outputs;
+    for (size_t i = 0; i < kernel_num; ++i) {
+      size_t size = (gen() % kPercent < kSmallPercent ? small_sizes[i] : large_sizes[i]) * batch;
+      trace.push_back({true, id, size});
+      outputs.emplace_back(id++, size);
+      if (outputs.size() > kLifetime) {
+        trace.push_back({false, outputs[outputs.size() - kLifetime - 1].first, 0});
+      }
+    }
+    for (size_t i = outputs.size() > kLifetime ? outputs.size() - kLifetime : 0; i < outputs.size(); ++i) {
+      trace.push_back({false, outputs[i].first, 0});
+    }
+  }
+  return trace;
+}
+
+// Replay the traces on the threads, return the average cost of the operations in nanoseconds.
+template <typename Pool>
+double ReplayTraces(Pool *pool, const std::vector<std::vector<TraceOp>> &traces) {
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &trace : traces) {
+    threads.emplace_back([pool, &trace]() {
+      std::vector<DeviceMemPtr> addrs(trace.size(), nullptr);
+      for (const auto &op : trace) {
+        if (op.alloc_) {
+          addrs[op.id_] = pool->AllocTensorMem(op.size_);
+        } else {
+          pool->FreeTensorMem(addrs[op.id_]);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto cost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  size_t op_num = 0;
+  for (const auto &trace : traces) {
+    op_num += trace.size();
+  }
+  return cost / op_num;
+}
+}  // namespace
+
+class BenchmarkDynamicMemPool : public UT::Common {
+ public:
+  BenchmarkDynamicMemPool() = default;
+};
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Benchmark the allocation traces of the dynamic shape networks on the best fit pool and on the size
+///     class pool in front of it, by one and several threads
+/// Expectation: No memory is in use after the traces, and the cost per operation and the peak memory are reported
+TEST_F(BenchmarkDynamicMemPool, BenchmarkReplayTraces) {
+  constexpr size_t kStepNum = 200;
+  constexpr size_t kKernelNum = 100;
+  for (size_t thread_num : {1, 4}) {
+    std::vector<std::vector<TraceOp>> traces;
+    for (size_t i = 0; i < thread_num; ++i) {
+      traces.push_back(GenerateTrace(static_cast<uint32_t>(i), kStepNum, kKernelNum));
+    }
+    HostMemPool best_fit_pool;
+    auto best_fit_cost = ReplayTraces(&best_fit_pool, traces);
+    EXPECT_EQ(best_fit_pool.TotalUsedMemStatistics(), 0);
+    HostMemPool backing_pool;
+    DynamicMemPoolSizeClass size_class_pool(&backing_pool);
+    auto size_class_cost = ReplayTraces(&size_class_pool, traces);
+    EXPECT_EQ(size_class_pool.TotalUsedMemStatistics(), 0);
+    std::cout << "Threads: " << thread_num << ", best fit pool: " << best_fit_cost
+              << " ns/op, size class pool: " << size_class_cost << " ns/op, peak: "
+              << best_fit_pool.UsedMemPeakStatistics() / kMBToByte << "M vs "
+              << backing_pool.UsedMemPeakStatistics() / kMBToByte << "M" << std::endl;
+  }
+}
+}  // namespace mindspore::device
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+#include "thread/work_stealing_queue.h"
+
+namespace mindspore {
+class TestActorThreadPool : public UT::Common {
+ public:
+  TestActorThreadPool() = default;
+  void SetUp() {}
+};
+
+namespace {
+// An actor which receives the messages of several producers, and checks that the messages of each producer are
+// received in order.
+class CountingActor : public ActorBase {
+ public:
+  CountingActor(const std::string &name, ActorThreadPool *pool, size_t producer_num, size_t total,
+                std::promise<void> *all_received)
+      : ActorBase(name, pool), next_seq_(producer_num, 0), total_(total), all_received_(all_received) {}
+  ~CountingActor() override = default;
+
+  void Receive(std::pair<size_t, size_t> producer_seq) {
+    if (producer_seq.second != next_seq_[producer_seq.first]) {
+      ++disordered_;
+    }
+    next_seq_[producer_seq.first] = producer_seq.second + 1;
+    if (++received_ == total_) {
+      all_received_->set_value();
+    }
+  }
+
+  size_t received() const { return received_; }
+  size_t disordered() const { return disordered_; }
+
+ private:
+  // only accessed on the actor threads, one message at a time
+  std::vector<size_t> next_seq_;
+  size_t received_{0};
+  size_t disordered_{0};
+  size_t total_;
+  std::promise<void> *all_received_;
+};
+
+// An actor which sends a message to the other actor, and waits until the other one has processed it.
+class WaitingActor : public ActorBase {
+ public:
+  WaitingActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~WaitingActor() override = default;
+
+  void set_other(const AID &other, std::promise<void> *other_done) {
+    other_ = other;
+    other_done_ = other_done;
+  }
+  std::future<bool> GetResult() { return result_.get_future(); }
+
+  void Wait();
+
+ private:
+  AID other_;
+  std::promise<void> *other_done_{nullptr};
+  std::promise<bool> result_;
+};
+
+class SignalActor : public ActorBase {
+ public:
+  SignalActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~SignalActor() override = default;
+
+  void Signal(std::promise<void> *done) { done->set_value(); }
+};
+
+// An actor which makes the consumer ready, which is pushed to the local queue of this actor thread, and waits until the
+// consumer has run.
+class BlockingProducer : public ActorBase {
+ public:
+  BlockingProducer(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~BlockingProducer() override = default;
+
+  void Produce(AID consumer, std::promise<void> *consumed, std::shared_future<void> consumed_future,
+               std::promise<void> *produced, std::promise<bool> *result) {
+    Async(consumer, &SignalActor::Signal, consumed);
+    produced->set_value();
+    result->set_value(consumed_future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+  }
+};
+
+// An actor which waits until the consumer has run, it is pushed to the global queue.
+class BlockedActor : public ActorBase {
+ public:
+  BlockedActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~BlockedActor() override = default;
+
+  void Wait(std::shared_future<void> consumed_future, std::promise<bool> *result) {
+    result->set_value(consumed_future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+  }
+};
+
+void WaitingActor::Wait() {
+  // the other actor is pushed to the local queue of this actor thread, which is blocked here
+  Async(other_, &SignalActor::Signal, other_done_);
+  auto other_done = other_done_->get_future();
+  result_.set_value(other_done.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+}
+}  // namespace
+
+/// Feature: WorkStealingQueue
+/// Description: The owner pushes and pops items while other threads steal from the queue
+/// Expectation: The queue is bounded, and every item is taken exactly once
+TEST_F(TestActorThreadPool, TestWorkStealingQueue) {
+  const size_t kItemNum = 20000;
+  const size_t kThiefNum = 3;
+  WorkStealingQueue<size_t> queue;
+  ASSERT_TRUE(queue.Init(100));
+  ASSERT_FALSE(queue.Init(100));
+
+  std::vector<size_t> items(kItemNum);
+  for (size_t i = 0; i < kItemNum; ++i) {
+    items[i] = i;
+  }
+  std::vector<std::atomic<int>> taken(kItemNum);
+  for (auto &t : taken) {
+    t = 0;
+  }
+  std::atomic<size_t> taken_num{0};
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefNum; ++i) {
+    thieves.emplace_back([&]() {
+      while (taken_num < kItemNum) {
+        auto item = queue.Steal();
+        if (item != nullptr) {
+          (void)taken[*item].fetch_add(1);
+          (void)taken_num.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  size_t next = 0;
+  while (next < kItemNum) {
+    // push a batch, and pop a part of it back in the order of last in first out
+    size_t pushed = 0;
+    while (next < kItemNum && pushed < 200 && queue.Push(&items[next])) {
+      ++next;
+      ++pushed;
+    }
+    for (size_t i = 0; i < pushed / 2; ++i) {
+      auto item = queue.Pop();
+      if (item != nullptr) {
+        (void)taken[*item].fetch_add(1);
+        (void)taken_num.fetch_add(1);
+      }
+    }
+  }
+  while (taken_num < kItemNum) {
+    auto item = queue.Pop();
+    if (item != nullptr) {
+      (void)taken[*item].fetch_add(1);
+      (void)taken_num.fetch_add(1);
+    }
+  }
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+  EXPECT_EQ(queue.Steal(), nullptr);
+  for (size_t i = 0; i < kItemNum; ++i) {
+    ASSERT_EQ(taken[i], 1);
+  }
+}
+
+/// Feature: ActorThreadPool
+/// Description: An actor running on an actor thread makes the other actor ready, which is pushed to the local queue of
+///     the actor thread, and waits for it
+/// Expectation: An idle actor thread is woken up to steal and run the other actor
+TEST_F(TestActorThreadPool, TestWakeUpIdleWorkerForLocalActor) {
+  const size_t kActorThreadNum = 2;
+  auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kActorThreadNum, {}, BindMode::Power_NoBind);
+  ASSERT_NE(pool, nullptr);
+  if (pool->actor_thread_num() < kActorThreadNum) {
+    // the actor threads are limited by the number of cores
+    delete pool;
+    return;
+  }
+  pool->SetSpinCountMinValue();
+  auto waiting_actor = std::make_shared<WaitingActor>("WaitingActor", pool);
+  auto signal_actor = std::make_shared<SignalActor>("SignalActor", pool);
+  std::promise<void> signal_done;
+  waiting_actor->set_other(signal_actor->GetAID(), &signal_done);
+  auto result = waiting_actor->GetResult();
+  (void)ActorMgr::GetActorMgrRef()->Spawn(waiting_actor);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(signal_actor);
+  // let the actor threads go idle
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  Async(waiting_actor->GetAID(), &WaitingActor::Wait);
+  EXPECT_TRUE(result.get());
+  ActorMgr::GetActorMgrRef()->Terminate(waiting_actor->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(signal_actor->GetAID());
+  delete pool;
+}
+
+/// Feature: ActorThreadPool
+/// Description: A producer running on an actor thread makes the consumer ready and waits for it, while an actor thread
+///     spinning to steal the consumer may take another actor waiting for the consumer from the global queue first
+/// Expectation: An idle actor thread is woken up to steal and run the consumer in every round
+TEST_F(TestActorThreadPool, TestWakeUpIdleWorkerBehindGlobalActor) {
+  const size_t kActorThreadNum = 3;
+  const size_t kRoundNum = 200;
+  auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kActorThreadNum, {}, BindMode::Power_NoBind);
+  ASSERT_NE(pool, nullptr);
+  if (pool->actor_thread_num() < kActorThreadNum) {
+    // the actor threads are limited by the number of cores
+    delete pool;
+    return;
+  }
+  auto producer = std::make_shared<BlockingProducer>("BlockingProducer", pool);
+  auto blocked_actor = std::make_shared<BlockedActor>("BlockedActor", pool);
+  auto consumer = std::make_shared<SignalActor>("Consumer", pool);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(producer);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(blocked_actor);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(consumer);
+  for (size_t i = 0; i < kRoundNum; ++i) {
+    std::promise<void> consumed;
+    std::promise<void> produced;
+    std::promise<bool> producer_result;
+    std::promise<bool> blocked_result;
+    auto consumed_future = consumed.get_future().share();
+    Async(producer->GetAID(), &BlockingProducer::Produce, consumer->GetAID(), &consumed, consumed_future, &produced,
+          &producer_result);
+    produced.get_future().wait();
+    Async(blocked_actor->GetAID(), &BlockedActor::Wait, consumed_future, &blocked_result);
+    bool producer_done = producer_result.get_future().get();
+    bool blocked_done = blocked_result.get_future().get();
+    ASSERT_TRUE(producer_done);
+    ASSERT_TRUE(blocked_done);
+  }
+  ActorMgr::GetActorMgrRef()->Terminate(producer->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(blocked_actor->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(consumer->GetAID());
+  delete pool;
+}
+
+/// Feature: ActorThreadPool
+/// Description: Several threads send messages to an actor through the NonblockingMailBox and the LockFreeMailBox,
+///     while the actor runs on the actor threads
+/// Expectation: Every message is received, in the order of its producer
+TEST_F(TestActorThreadPool, TestMailBoxOrder) {
+  const size_t kActorThreadNum = 2;
+  const size_t kProducerNum = 4;
+  const size_t kMsgNum = 5000;
+  auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kActorThreadNum, {}, BindMode::Power_NoBind);
+  ASSERT_NE(pool, nullptr);
+  for (bool lock_free_mailbox : {false, true}) {
+    std::promise<void> all_received;
+    auto actor = std::make_shared<CountingActor>("CountingActor_" + std::to_string(lock_free_mailbox), pool,
+                                                 kProducerNum, kProducerNum * kMsgNum, &all_received);
+    actor->set_lock_free_mailbox(lock_free_mailbox);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < kProducerNum; ++p) {
+      producers.emplace_back([&actor, p]() {
+        for (size_t i = 0; i < kMsgNum; ++i) {
+          Async(actor->GetAID(), &CountingActor::Receive, std::make_pair(p, i));
+        }
+      });
+    }
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    auto received = all_received.get_future();
+    ASSERT_EQ(received.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+    EXPECT_EQ(actor->received(), kProducerNum * kMsgNum);
+    EXPECT_EQ(actor->disordered(), 0);
+    ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+  }
+  delete pool;
+}
+}  // namespace mindspore
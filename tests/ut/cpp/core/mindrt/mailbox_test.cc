@@ -0,0 +1,132 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/mailbox.h"
+#include "actor/msg.h"
+
+namespace mindspore {
+class TestMailBox : public UT::Common {
+ public:
+  TestMailBox() = default;
+  void SetUp() {}
+};
+
+namespace {
+class LargeMessage : public MessageBase {
+ public:
+  LargeMessage() : MessageBase("LargeMessage") {}
+  ~LargeMessage() override = default;
+  char payload[1024] = {0};
+};
+}  // namespace
+
+/// Feature: LockFreeMailBox
+/// Description: Several producers enqueue messages while the consumer takes them each time the mailbox notifies
+/// Expectation: Every message is taken once in the order of its producer, and the mailbox notifies once each time it
+///     is released by the consumer
+TEST_F(TestMailBox, TestLockFreeMailBox) {
+  const size_t kProducerNum = 4;
+  const size_t kMsgNum = 50000;
+  LockFreeMailBox mailbox;
+  std::atomic<size_t> notify_num{0};
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notify_num]() { (void)++notify_num; }));
+  EXPECT_FALSE(mailbox.TakeAllMsgsEachTime());
+  EXPECT_EQ(mailbox.GetMsgs(), nullptr);
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < kProducerNum; ++p) {
+    producers.emplace_back([&mailbox, p]() {
+      for (size_t i = 0; i < kMsgNum; ++i) {
+        std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageBase(std::to_string(p)));
+        msg->func_id_ = static_cast<uint32_t>(i);
+        (void)mailbox.EnqueueMessage(std::move(msg));
+      }
+    });
+  }
+
+  std::vector<uint32_t> next_ids(kProducerNum, 0);
+  size_t received = 0;
+  size_t run_num = 0;
+  while (received < kProducerNum * kMsgNum) {
+    if (notify_num == run_num) {
+      std::this_thread::yield();
+      continue;
+    }
+    // the actor runs once for each notification
+    ++run_num;
+    while (auto msg = mailbox.GetMsg()) {
+      auto p = std::stoul(msg->Name());
+      ASSERT_LT(p, kProducerNum);
+      ASSERT_EQ(msg->func_id_, next_ids[p]);
+      ++next_ids[p];
+      ++received;
+    }
+    // only one producer notifies after the mailbox is released
+    ASSERT_LE(notify_num, run_num + 1);
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(received, kProducerNum * kMsgNum);
+  // a producer may notify after its message is taken in the last run
+  if (notify_num > run_num) {
+    ++run_num;
+    EXPECT_EQ(mailbox.GetMsg(), nullptr);
+  }
+  // the released mailbox notifies for the next message, which is freed with the mailbox
+  std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageBase("last"));
+  (void)mailbox.EnqueueMessage(std::move(msg));
+  EXPECT_EQ(notify_num, run_num + 1);
+}
+
+/// Feature: MessageBase
+/// Description: Allocate and free messages of the sizes in the pool and out of it
+/// Expectation: A freed block is reused by the next message of the same size on the thread, and the large messages are
+///     allocated from the system
+TEST_F(TestMailBox, TestMessagePool) {
+  auto msg = new (std::nothrow) MessageBase("msg");
+  ASSERT_NE(msg, nullptr);
+  void *block = msg;
+  delete msg;
+  msg = new MessageBase("msg");
+  EXPECT_EQ(static_cast<void *>(msg), block);
+  delete msg;
+
+  auto large_msg = std::make_unique<LargeMessage>();
+  large_msg->payload[sizeof(large_msg->payload) - 1] = 'a';
+  EXPECT_EQ(large_msg->Name(), "LargeMessage");
+  std::unique_ptr<MessageBase> base_msg = std::move(large_msg);
+  base_msg.reset();
+
+  // the messages freed by another thread are cached by that thread
+  std::vector<MessageBase *> msgs;
+  for (size_t i = 0; i < 1000; ++i) {
+    msgs.push_back(new MessageBase(std::to_string(i)));
+  }
+  std::thread consumer([&msgs]() {
+    for (auto m : msgs) {
+      delete m;
+    }
+  });
+  consumer.join();
+}
+}  // namespace mindspore
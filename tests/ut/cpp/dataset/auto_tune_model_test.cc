@@ -0,0 +1,119 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestAutoTuneModel : public UT::Common {
+ public:
+  MindDataTestAutoTuneModel() {}
+
+  // A leaf which can not be tuned feeding a heavy and a light map, profiled at 10 batches per second
+  static std::vector<AutoTuneModel::OpStats> PipelineStats(int64_t row_bytes) {
+    return {{1, "MapOp(ID:1)", true, 8, 16, 1.0, row_bytes},
+            {2, "MapOp(ID:2)", true, 8, 16, 3.0, row_bytes},
+            {3, "ImageFolderOp(ID:3)", false, 1, 16, 0.1, row_bytes}};
+  }
+
+  static const AutoTuneModel::OpConfig &Find(const std::vector<AutoTuneModel::OpConfig> &configs, int32_t op_id) {
+    for (const auto &config : configs) {
+      if (config.op_id == op_id) {
+        return config;
+      }
+    }
+    return configs.front();
+  }
+};
+
+/// Feature: AutoTuneModel
+/// Description: Test solving a pipeline with a CPU budget only
+/// Expectation: The workers are given in proportion to the cost of the ops and all the budget is used
+TEST_F(MindDataTestAutoTuneModel, TestSolveCpuBudget) {
+  AutoTuneModel model(9, 0, 16, 128);
+  ASSERT_OK(model.Fit(PipelineStats(0), 10.0));
+  std::vector<AutoTuneModel::OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  ASSERT_EQ(configs.size(), 3);
+  EXPECT_EQ(Find(configs, 1).num_workers, 2);
+  EXPECT_EQ(Find(configs, 2).num_workers, 6);
+  // the leaf keeps its configuration
+  EXPECT_EQ(Find(configs, 3).num_workers, 1);
+  EXPECT_EQ(Find(configs, 3).prefetch_size, 16);
+  // without a memory limit the prefetch size grows to the max per worker
+  EXPECT_EQ(Find(configs, 2).prefetch_size, 6 * AutoTuneModel::kPrefetchPerWorker);
+  EXPECT_NEAR(model.PredictThroughput(configs), 20.0, 1e-6);
+}
+
+/// Feature: AutoTuneModel
+/// Description: Test solving a pipeline with a memory budget
+/// Expectation: The memory of the configuration fits in the budget and the heavy op still gets the most workers
+TEST_F(MindDataTestAutoTuneModel, TestSolveMemoryBudget) {
+  const int64_t row_bytes = 1000;
+  const int64_t memory_budget = 40 * row_bytes;
+  AutoTuneModel model(64, memory_budget, 16, 128);
+  ASSERT_OK(model.Fit(PipelineStats(row_bytes), 10.0));
+  std::vector<AutoTuneModel::OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  EXPECT_LE(model.PredictMemory(configs), memory_budget);
+  EXPECT_GT(Find(configs, 2).num_workers, Find(configs, 1).num_workers);
+  EXPECT_GE(Find(configs, 2).prefetch_size, Find(configs, 2).num_workers);
+
+  // a budget too small for a single worker per op keeps the minimum configuration
+  AutoTuneModel small_model(64, row_bytes, 16, 128);
+  ASSERT_OK(small_model.Fit(PipelineStats(row_bytes), 10.0));
+  ASSERT_OK(small_model.Solve(&configs));
+  EXPECT_EQ(Find(configs, 1).num_workers, 1);
+  EXPECT_EQ(Find(configs, 2).num_workers, 1);
+}
+
+/// Feature: AutoTuneModel
+/// Description: Test solving a pipeline whose slowest op can not be tuned
+/// Expectation: No worker is added, as none of them would make the pipeline faster
+TEST_F(MindDataTestAutoTuneModel, TestSolveFixedBottleneck) {
+  AutoTuneModel model(32, 0, 16, 128);
+  std::vector<AutoTuneModel::OpStats> stats = {{1, "MapOp(ID:1)", true, 4, 16, 0.5, 0},
+                                               {2, "GeneratorOp(ID:2)", false, 1, 16, 1.0, 0}};
+  ASSERT_OK(model.Fit(stats, 1.0));
+  std::vector<AutoTuneModel::OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  EXPECT_EQ(Find(configs, 1).num_workers, 1);
+  EXPECT_NEAR(model.PredictThroughput(configs), 1.0, 1e-6);
+}
+
+/// Feature: AutoTuneModel
+/// Description: Test fitting the model over two windows and serializing it
+/// Expectation: The costs are averaged and the json holds the solution
+TEST_F(MindDataTestAutoTuneModel, TestFitAndJson) {
+  AutoTuneModel model(8, 0, 16, 128);
+  std::vector<AutoTuneModel::OpConfig> configs;
+  EXPECT_TRUE(model.Solve(&configs).IsError());
+  EXPECT_TRUE(model.Fit(PipelineStats(0), 0).IsError());
+  ASSERT_OK(model.Fit({{1, "MapOp(ID:1)", true, 2, 4, 1.0, 100}}, 10.0));
+  ASSERT_OK(model.Fit({{1, "MapOp(ID:1)", true, 4, 8, 3.0, 0}}, 10.0));
+  EXPECT_EQ(model.NumFits(), 2);
+  ASSERT_OK(model.Solve(&configs));
+  nlohmann::json out_json = model.ToJson();
+  EXPECT_EQ(out_json["num_fits"], 2);
+  ASSERT_EQ(out_json["ops"].size(), 1);
+  EXPECT_NEAR(out_json["ops"][0]["cost"].get<double>(), 0.2, 1e-6);
+  // the row size of the last window which samples it is kept
+  EXPECT_EQ(out_json["ops"][0]["row_bytes"], 100);
+  EXPECT_EQ(out_json["ops"][0]["num_parallel_workers"], configs[0].num_workers);
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/datasetops/batch_buffer_pool.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBatchBufferPool : public UT::Common {
+ public:
+  MindDataTestBatchBufferPool() {}
+};
+
+/// Feature: BatchBufferPool
+/// Description: Test the buffer of a dropped tensor is reused by the next tensor of the same column which fits it,
+///     and a tensor can outlive the pool
+/// Expectation: The buffers are reused as expected
+TEST_F(MindDataTestBatchBufferPool, TestRecycle) {
+  auto pool = std::make_shared<BatchBufferPool>(2);
+  std::shared_ptr<Tensor> t1;
+  ASSERT_OK(pool->CreateTensor(0, TensorShape({4, 8}), DataType(DataType::DE_FLOAT32), &t1));
+  ASSERT_EQ(t1->shape(), TensorShape({4, 8}));
+  const uchar *buffer = t1->GetBuffer();
+  t1.reset();
+
+  // the same column of the next batch takes the idle buffer
+  std::shared_ptr<Tensor> t2;
+  ASSERT_OK(pool->CreateTensor(0, TensorShape({4, 8}), DataType(DataType::DE_FLOAT32), &t2));
+  EXPECT_EQ(t2->GetBuffer(), buffer);
+  EXPECT_EQ(pool->num_allocated(), 1);
+  EXPECT_EQ(pool->num_reused(), 1);
+
+  // another column does not share the buffers
+  std::shared_ptr<Tensor> t3;
+  ASSERT_OK(pool->CreateTensor(1, TensorShape({4, 8}), DataType(DataType::DE_FLOAT32), &t3));
+  EXPECT_NE(t3->GetBuffer(), buffer);
+  t2.reset();
+
+  // a buffer much larger than the tensor is not taken
+  std::shared_ptr<Tensor> t4;
+  ASSERT_OK(pool->CreateTensor(0, TensorShape({4, 2}), DataType(DataType::DE_FLOAT32), &t4));
+  EXPECT_NE(t4->GetBuffer(), buffer);
+  EXPECT_EQ(pool->num_allocated(), 3);
+
+  // a smaller tensor of the same column fits the idle buffer
+  std::shared_ptr<Tensor> t5;
+  ASSERT_OK(pool->CreateTensor(0, TensorShape({4, 6}), DataType(DataType::DE_FLOAT32), &t5));
+  EXPECT_EQ(t5->GetBuffer(), buffer);
+  EXPECT_EQ(t5->SizeInBytes(), 4 * 6 * sizeof(float));
+
+  // the tensors are still valid after the pool is gone
+  pool.reset();
+  ASSERT_OK(t3->Fill<float>(1.0));
+  t3.reset();
+  t4.reset();
+  t5.reset();
+}
+
+/// Feature: PadEndNumericInto
+/// Description: Test a tensor is padded into a slot of a batch buffer
+/// Expectation: The slot holds the padded tensor and the other slots are not touched
+TEST_F(MindDataTestBatchBufferPool, TestPadIntoSlot) {
+  auto pool = std::make_shared<BatchBufferPool>(1);
+  std::shared_ptr<Tensor> batch;
+  ASSERT_OK(pool->CreateTensor(0, TensorShape({2, 2, 3}), DataType(DataType::DE_INT32), &batch));
+  ASSERT_OK(batch->Fill<int32_t>(7));
+
+  std::shared_ptr<Tensor> row;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{1, 2, 3, 4}, TensorShape({2, 2}), &row));
+  const dsize_t slot_size = 2 * 3 * sizeof(int32_t);
+  std::shared_ptr<Tensor> slot;
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({2, 3}), DataType(DataType::DE_INT32),
+                                         batch->GetMutableBuffer() + slot_size, slot_size, batch, &slot));
+  ASSERT_OK(PadEndNumericInto(row, slot, -1));
+
+  std::shared_ptr<Tensor> expected;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{7, 7, 7, 7, 7, 7, 1, 2, -1, 3, 4, -1},
+                                     TensorShape({2, 2, 3}), &expected));
+  EXPECT_EQ(*batch, *expected);
+}
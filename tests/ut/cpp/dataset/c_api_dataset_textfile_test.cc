@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <set>
+
 #include "common/common.h"
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/include/dataset/datasets.h"
@@ -904,3 +906,54 @@ TEST_F(MindDataTestPipeline, TestTextFileDatasetShuffleGlobal4) {
   GlobalContext::config_manager()->set_seed(original_seed);
   GlobalContext::config_manager()->set_num_parallel_workers(original_num_parallel_workers);
 }
+
+/// Feature: TextFileDataset
+/// Description: Test TextFileDataset with the files read ahead by the I/O engine of the op
+/// Expectation: The data is the same as read by the workers
+TEST_F(MindDataTestPipeline, TestTextFileDatasetIOPrefetch) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestTextFileDatasetIOPrefetch.";
+  // Set configuration
+  uint32_t original_num_parallel_workers = GlobalContext::config_manager()->num_parallel_workers();
+  int32_t original_io_prefetch_depth = GlobalContext::config_manager()->io_prefetch_depth();
+  GlobalContext::config_manager()->set_num_parallel_workers(2);
+  GlobalContext::config_manager()->set_io_prefetch_depth(4);
+
+  // Note: 1.txt has 3 rows
+  // Note: 2.txt has 2 rows
+  std::string tf_file1 = datasets_root_path_ + "/testTextFileDataset/1.txt";
+  std::string tf_file2 = datasets_root_path_ + "/testTextFileDataset/2.txt";
+  std::shared_ptr<Dataset> ds = TextFile({tf_file1, tf_file2}, 0, ShuffleMode::kFalse);
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Repeat(2);
+  EXPECT_NE(ds, nullptr);
+
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  EXPECT_NE(iter, nullptr);
+
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  std::multiset<std::string> expected_result = {"This is a text file.", "Be happy every day.", "Good luck to everyone.",
+                                                "Another file.", "End of file."};
+  std::multiset<std::string> result;
+  while (row.size() != 0) {
+    std::shared_ptr<Tensor> de_text;
+    ASSERT_OK(Tensor::CreateFromMSTensor(row["text"], &de_text));
+    std::string_view sv;
+    ASSERT_OK(de_text->GetItemAt(&sv, {}));
+    (void)result.emplace(sv);
+    ASSERT_OK(iter->GetNextRow(&row));
+  }
+
+  // Expect (3 + 2) * 2 = 10 samples, the rows of the two files are interleaved by the workers
+  EXPECT_EQ(result.size(), 10);
+  for (const auto &text : expected_result) {
+    EXPECT_EQ(result.count(text), 2);
+  }
+
+  // Manually terminate the pipeline
+  iter->Stop();
+
+  // Restore configuration
+  GlobalContext::config_manager()->set_num_parallel_workers(original_num_parallel_workers);
+  GlobalContext::config_manager()->set_io_prefetch_depth(original_io_prefetch_depth);
+}
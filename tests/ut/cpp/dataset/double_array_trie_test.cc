@@ -0,0 +1,68 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <unordered_map>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/text/kernels/double_array_trie.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestDoubleArrayTrie : public UT::Common {
+ public:
+  MindDataTestDoubleArrayTrie() {}
+
+  static int32_t Find(const DoubleArrayTrie &trie, const std::string &key) {
+    int32_t state = DoubleArrayTrie::kRoot;
+    trie.Walk(&state, key);
+    return state == DoubleArrayTrie::kNoValue ? DoubleArrayTrie::kNoValue : trie.Value(state);
+  }
+};
+
+/// Feature: DoubleArrayTrie
+/// Description: Test looking up the keys, their prefixes and other strings in a trie
+/// Expectation: The value of each key is found, and nothing is found for the strings which are not keys
+TEST_F(MindDataTestDoubleArrayTrie, TestLookup) {
+  std::unordered_map<std::string, int32_t> keys = {
+    {"a", 0}, {"ab", 1}, {"abc", 2}, {"b", 3}, {"##ing", 4}, {"##in", 5}, {"\xe4\xb8\xad\xe6\x96\x87", 6}, {"\xff", 7}};
+  DoubleArrayTrie trie;
+  ASSERT_OK(trie.Build(keys));
+  for (const auto &[key, value] : keys) {
+    EXPECT_EQ(Find(trie, key), value);
+  }
+  EXPECT_EQ(Find(trie, ""), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(Find(trie, "abcd"), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(Find(trie, "##i"), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(Find(trie, "\xe4\xb8\xad"), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(Find(trie, "c"), DoubleArrayTrie::kNoValue);
+
+  // walk a prefix once, and continue from its state
+  int32_t suffix = DoubleArrayTrie::kRoot;
+  trie.Walk(&suffix, "##");
+  ASSERT_NE(suffix, DoubleArrayTrie::kNoValue);
+  int32_t state = suffix;
+  for (char c : std::string("in")) {
+    ASSERT_TRUE(trie.Next(&state, static_cast<uint8_t>(c)));
+  }
+  EXPECT_EQ(trie.Value(state), 5);
+  EXPECT_FALSE(trie.Next(&state, static_cast<uint8_t>('x')));
+  EXPECT_TRUE(trie.Next(&state, static_cast<uint8_t>('g')));
+  EXPECT_EQ(trie.Value(state), 4);
+
+  // a negative value is rejected
+  EXPECT_ERROR(trie.Build({{"a", -1}}));
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_chain_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestFusedChainOp : public UT::Common {
+ public:
+  MindDataTestFusedChainOp() {}
+
+  // An image of the shape with pixel values cycling through 0 to 250
+  static std::shared_ptr<Tensor> MakeImage(const TensorShape &shape) {
+    std::vector<uint8_t> data(shape.NumOfElements());
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<uint8_t>((i * 7) % 251);
+    }
+    std::shared_ptr<Tensor> image;
+    EXPECT_OK(Tensor::CreateFromVector(data, shape, &image));
+    return image;
+  }
+
+  // Fuse the ops and check the output is the same as running them one by one
+  static void CheckFused(const std::vector<std::shared_ptr<TensorOp>> &ops, const std::shared_ptr<Tensor> &image) {
+    std::vector<FusableStage> stages;
+    for (const auto &op : ops) {
+      FusableStage stage;
+      ASSERT_TRUE(op->GetFusableStage(&stage));
+      ASSERT_TRUE(FusedChainOp::CanAppend(stages, stage));
+      stages.push_back(stage);
+    }
+    ASSERT_TRUE(FusedChainOp::Worthwhile(stages));
+    std::shared_ptr<Tensor> expected = image;
+    for (const auto &op : ops) {
+      std::shared_ptr<Tensor> out;
+      ASSERT_OK(op->Compute(expected, &out));
+      expected = out;
+    }
+    FusedChainOp fused_op(ops, stages);
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(fused_op.Compute(image, &output));
+    ASSERT_EQ(output->shape(), expected->shape());
+    ASSERT_EQ(output->type(), expected->type());
+    auto itr = expected->begin<float>();
+    for (auto out_itr = output->begin<float>(); out_itr != output->end<float>(); ++out_itr, ++itr) {
+      ASSERT_NEAR(*out_itr, *itr, 1e-5);
+    }
+  }
+};
+
+/// Feature: FusedChainOp
+/// Description: Test fusing Normalize and HWC2CHW on an image larger than a tile
+/// Expectation: The output is the same as running the ops one by one
+TEST_F(MindDataTestFusedChainOp, TestNormalizeHwcToChw) {
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<NormalizeOp>(std::vector<float>{121.0, 115.0, 100.0}, std::vector<float>{70.0, 68.0, 71.0}, true),
+    std::make_shared<HwcToChwOp>()};
+  CheckFused(ops, MakeImage(TensorShape({37, 45, 3})));
+}
+
+/// Feature: FusedChainOp
+/// Description: Test fusing TypeCast, Rescale, HWC2CHW and a Normalize of the <C,H,W> layout
+/// Expectation: The output is the same as running the ops one by one
+TEST_F(MindDataTestFusedChainOp, TestCastRescaleHwcToChwNormalize) {
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32)), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<HwcToChwOp>(),
+    std::make_shared<NormalizeOp>(std::vector<float>{0.485, 0.456, 0.406}, std::vector<float>{0.229, 0.224, 0.225},
+                                  false)};
+  CheckFused(ops, MakeImage(TensorShape({20, 30, 3})));
+  // a gray image
+  ops = {std::make_shared<RescaleOp>(1.0 / 255, -0.5),
+         std::make_shared<NormalizeOp>(std::vector<float>{0.5}, std::vector<float>{0.25}, true)};
+  CheckFused(ops, MakeImage(TensorShape({16, 16})));
+}
+
+/// Feature: FusedChainOp
+/// Description: Test the chains which can not be fused and the inputs the fused kernel does not handle
+/// Expectation: The chains are rejected, and the inputs go through the ops one by one
+TEST_F(MindDataTestFusedChainOp, TestUnfusable) {
+  FusableStage to_chw;
+  to_chw.kind = FusableStage::Kind::kHwcToChw;
+  FusableStage normalize_chw;
+  normalize_chw.kind = FusableStage::Kind::kNormalize;
+  normalize_chw.a = {1, 2, 3};
+  normalize_chw.b = {1, 1, 1};
+  normalize_chw.is_hwc = false;
+  FusableStage normalize_hwc = normalize_chw;
+  normalize_hwc.is_hwc = true;
+  // only one change of layout, and the channel must be last before it and first after it
+  EXPECT_FALSE(FusedChainOp::CanAppend({to_chw}, to_chw));
+  EXPECT_FALSE(FusedChainOp::CanAppend({normalize_chw}, to_chw));
+  EXPECT_FALSE(FusedChainOp::CanAppend({to_chw}, normalize_hwc));
+  EXPECT_FALSE(FusedChainOp::CanAppend({normalize_chw}, normalize_hwc));
+  EXPECT_TRUE(FusedChainOp::CanAppend({normalize_hwc, to_chw}, normalize_chw));
+  // a single op, or only a change of layout, is not worth fusing
+  EXPECT_FALSE(FusedChainOp::Worthwhile({normalize_hwc}));
+  EXPECT_FALSE(FusedChainOp::Worthwhile({to_chw, to_chw}));
+
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<RescaleOp>(2.0, 1.0),
+    std::make_shared<NormalizeOp>(std::vector<float>{1, 2, 3}, std::vector<float>{1, 1, 1}, true)};
+  std::vector<FusableStage> stages(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ASSERT_TRUE(ops[i]->GetFusableStage(&stages[i]));
+  }
+  FusedChainOp fused_op(ops, stages);
+  std::shared_ptr<Tensor> output;
+  // the number of channels does not match the mean, so Normalize reports the error
+  EXPECT_ERROR(fused_op.Compute(MakeImage(TensorShape({4, 4, 2})), &output));
+  ASSERT_OK(fused_op.Compute(MakeImage(TensorShape({4, 4, 3})), &output));
+  float value = 0;
+  ASSERT_OK(output->GetItemAt<float>(&value, {0, 1, 2}));
+  EXPECT_FLOAT_EQ(value, (35 * 2.0 + 1.0) - 3);
+
+  // a cast to another type than float32 is not fusable
+  FusableStage stage;
+  EXPECT_FALSE(TypeCastOp(DataType(DataType::DE_INT32)).GetFusableStage(&stage));
+}
+
+/// Feature: FusedChainOp
+/// Description: Test the fused kernel and the batch kernels of HWC2CHW and Normalize on a batch of images
+/// Expectation: Each image of the output batch is the same as the output of the image computed on its own
+TEST_F(MindDataTestFusedChainOp, TestBatch) {
+  const int64_t num_images = 3;
+  std::shared_ptr<Tensor> batch = MakeImage(TensorShape({num_images, 19, 23, 3}));
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<RescaleOp>(1.0 / 255, 0.0), std::make_shared<HwcToChwOp>(),
+    std::make_shared<NormalizeOp>(std::vector<float>{0.5, 0.4, 0.3}, std::vector<float>{0.2, 0.25, 0.3}, false)};
+  std::vector<FusableStage> stages(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ASSERT_TRUE(ops[i]->GetFusableStage(&stages[i]));
+  }
+  FusedChainOp fused_op(ops, stages);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(fused_op.Compute(batch, &output));
+  ASSERT_EQ(output->shape(), TensorShape({num_images, 3, 19, 23}));
+  std::shared_ptr<Tensor> transposed;
+  ASSERT_OK(BatchHwcToChw(batch, &transposed));
+  ASSERT_EQ(transposed->shape(), output->shape());
+  std::shared_ptr<Tensor> normalized;
+  ASSERT_OK(NormalizeOp(std::vector<float>{1, 2, 3}, std::vector<float>{2, 2, 2}, true).Compute(batch, &normalized));
+  ASSERT_EQ(normalized->shape(), batch->shape());
+
+  for (int64_t n = 0; n < num_images; ++n) {
+    std::shared_ptr<Tensor> image;
+    ASSERT_OK(batch->Slice(&image, {SliceOption(Slice(n, n + 1)), SliceOption(true), SliceOption(true),
+                                    SliceOption(true)}));
+    image->Squeeze();
+    std::shared_ptr<Tensor> expected;
+    ASSERT_OK(fused_op.Compute(image, &expected));
+    for (int64_t c = 0; c < 3; ++c) {
+      for (int64_t h = 0; h < 19; ++h) {
+        for (int64_t w = 0; w < 23; ++w) {
+          float value = 0, expected_value = 0;
+          ASSERT_OK(output->GetItemAt<float>(&value, {n, c, h, w}));
+          ASSERT_OK(expected->GetItemAt<float>(&expected_value, {c, h, w}));
+          ASSERT_NEAR(value, expected_value, 1e-5);
+          uint8_t pixel = 0, transposed_pixel = 0;
+          ASSERT_OK(image->GetItemAt<uint8_t>(&pixel, {h, w, c}));
+          ASSERT_OK(transposed->GetItemAt<uint8_t>(&transposed_pixel, {n, c, h, w}));
+          ASSERT_EQ(transposed_pixel, pixel);
+          ASSERT_OK(normalized->GetItemAt<float>(&value, {n, h, w, c}));
+          ASSERT_NEAR(value, (pixel - (c + 1)) / 2.0, 1e-5);
+        }
+      }
+    }
+  }
+}
@@ -16,13 +16,18 @@
 #include <algorithm>
 #include <string>
 #include <map>
+#include <set>
 #include <memory>
 #include <unordered_set>
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/engine/gnn/graph_csr_store.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
@@ -429,3 +434,185 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+/// Feature: GNNGraph
+/// Description: Test a graph kept in a CSR store, which is written by the first load and mapped by the second
+/// Expectation: The store is used, and the output is the same as that of the graph of node and edge objects
+TEST_F(MindDataTestGNNGraph, TestCsrStore) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph("mindrecord", path, 1);
+  ASSERT_OK(graph.Init());
+
+  auto config = GlobalContext::config_manager();
+  std::string origin_store_dir = config->graph_csr_store_dir();
+  Path store_dir("./gnn_csr_store_test");
+  config->set_graph_csr_store_dir(store_dir.ToString());
+  std::string store_path;
+  ASSERT_OK(GraphCsrStore::GetStorePath(store_dir.ToString(), path, &store_path));
+  Path store_file(store_path);
+  if (store_file.Exists()) {
+    ASSERT_OK(store_file.Remove());
+  }
+  GraphDataImpl written_graph("mindrecord", path, 1);
+  ASSERT_OK(written_graph.Init());
+  ASSERT_TRUE(store_file.Exists());
+  GraphDataImpl csr_graph("mindrecord", path, 1);
+  ASSERT_OK(csr_graph.Init());
+  config->set_graph_csr_store_dir(origin_store_dir);
+
+  for (GraphDataImpl *impl : {&written_graph, &csr_graph}) {
+    MetaInfo meta_info, expected_meta_info;
+    ASSERT_OK(impl->GetMetaInfo(&meta_info));
+    ASSERT_OK(graph.GetMetaInfo(&expected_meta_info));
+    EXPECT_EQ(meta_info.node_type, expected_meta_info.node_type);
+    EXPECT_EQ(meta_info.edge_type, expected_meta_info.edge_type);
+    EXPECT_EQ(meta_info.node_num, expected_meta_info.node_num);
+    EXPECT_EQ(meta_info.edge_num, expected_meta_info.edge_num);
+    EXPECT_EQ(meta_info.node_feature_type, expected_meta_info.node_feature_type);
+    EXPECT_EQ(meta_info.edge_feature_type, expected_meta_info.edge_feature_type);
+
+    std::vector<std::pair<NodeIdType, NodeIdType>> src_dst_list = {{101, 201}, {103, 207}, {108, 208},
+                                                                   {110, 201}, {204, 105}, {208, 108}};
+    std::shared_ptr<Tensor> edges;
+    ASSERT_OK(impl->GetEdgesFromNodes(src_dst_list, &edges));
+    EXPECT_EQ(edges->ToString(), "Tensor (shape: <6>, Type: int32)\n[1,9,17,19,31,37]");
+
+    std::shared_ptr<Tensor> all_edges, expected_all_edges;
+    ASSERT_OK(impl->GetAllEdges(meta_info.edge_type[0], &all_edges));
+    ASSERT_OK(graph.GetAllEdges(meta_info.edge_type[0], &expected_all_edges));
+    std::vector<EdgeIdType> edge_list, expected_edge_list;
+    for (auto itr = all_edges->begin<EdgeIdType>(); itr != all_edges->end<EdgeIdType>(); ++itr) {
+      edge_list.push_back(*itr);
+    }
+    for (auto itr = expected_all_edges->begin<EdgeIdType>(); itr != expected_all_edges->end<EdgeIdType>(); ++itr) {
+      expected_edge_list.push_back(*itr);
+    }
+    // The edges of the store are in ascending id order, while the edge objects keep the order they are loaded in
+    EXPECT_TRUE(std::is_sorted(edge_list.begin(), edge_list.end()));
+    std::sort(expected_edge_list.begin(), expected_edge_list.end());
+    EXPECT_EQ(edge_list, expected_edge_list);
+    std::shared_ptr<Tensor> edge_nodes, expected_edge_nodes;
+    ASSERT_OK(impl->GetNodesFromEdges(edge_list, &edge_nodes));
+    ASSERT_OK(graph.GetNodesFromEdges(edge_list, &expected_edge_nodes));
+    EXPECT_EQ(edge_nodes->ToString(), expected_edge_nodes->ToString());
+    TensorRow edge_features, expected_edge_features;
+    ASSERT_OK(impl->GetEdgeFeature(all_edges, meta_info.edge_feature_type, &edge_features));
+    ASSERT_OK(graph.GetEdgeFeature(all_edges, meta_info.edge_feature_type, &expected_edge_features));
+    ASSERT_EQ(edge_features.size(), expected_edge_features.size());
+    for (size_t i = 0; i < edge_features.size(); ++i) {
+      EXPECT_EQ(edge_features[i]->ToString(), expected_edge_features[i]->ToString());
+    }
+
+    std::shared_ptr<Tensor> nodes;
+    ASSERT_OK(impl->GetAllNodes(meta_info.node_type[0], &nodes));
+    std::vector<NodeIdType> node_list;
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+    // a node which is not in the graph gets the default feature
+    node_list.push_back(kDefaultNodeId);
+    std::shared_ptr<Tensor> feature_nodes;
+    ASSERT_OK(Tensor::CreateFromVector(node_list, &feature_nodes));
+    TensorRow features, expected_features;
+    ASSERT_OK(impl->GetNodeFeature(feature_nodes, meta_info.node_feature_type, &features));
+    ASSERT_OK(graph.GetNodeFeature(feature_nodes, meta_info.node_feature_type, &expected_features));
+    ASSERT_EQ(features.size(), expected_features.size());
+    for (size_t i = 0; i < features.size(); ++i) {
+      EXPECT_EQ(features[i]->ToString(), expected_features[i]->ToString());
+    }
+    node_list.pop_back();
+
+    for (auto format : {OutputFormat::kNormal, OutputFormat::kCoo, OutputFormat::kCsr}) {
+      std::shared_ptr<Tensor> neighbors, expected_neighbors;
+      ASSERT_OK(impl->GetAllNeighbors(node_list, meta_info.node_type[1], format, &neighbors));
+      ASSERT_OK(graph.GetAllNeighbors(node_list, meta_info.node_type[1], format, &expected_neighbors));
+      EXPECT_EQ(neighbors->ToString(), expected_neighbors->ToString());
+    }
+
+    // the sampled neighbors are neighbors of the node, or the default node if it has none
+    for (auto strategy : {SamplingStrategy::kRandom, SamplingStrategy::kEdgeWeight}) {
+      std::shared_ptr<Tensor> sampled;
+      ASSERT_OK(impl->GetSampledNeighbors(node_list, {7}, {meta_info.node_type[1]}, strategy, &sampled));
+      EXPECT_EQ(sampled->shape().ToString(), "<" + std::to_string(node_list.size()) + ",8>");
+      std::shared_ptr<Tensor> neighbors;
+      ASSERT_OK(graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &neighbors));
+      NodeNeighborsMap sampled_map, neighbors_map;
+      ParsingNeighbors(sampled, sampled_map);
+      ParsingNeighbors(neighbors, neighbors_map);
+      for (const auto &node : sampled_map) {
+        for (const auto &neighbor : node.second) {
+          EXPECT_EQ(neighbors_map[node.first].count(neighbor.first), 1);
+        }
+      }
+    }
+    std::shared_ptr<Tensor> neg_neighbors;
+    ASSERT_OK(impl->GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &neg_neighbors));
+    EXPECT_EQ(neg_neighbors->shape().ToString(), "<" + std::to_string(node_list.size()) + ",4>");
+  }
+  EXPECT_OK(store_file.Remove());
+}
+
+/// Feature: GNNGraph
+/// Description: Test GetSampledNeighbors, GetNegSampledNeighbors and RandomWalk split across worker threads
+/// Expectation: The output is the same for the same seed, whatever the number of workers
+TEST_F(MindDataTestGNNGraph, TestParallelSampling) {
+  auto config = GlobalContext::config_manager();
+  uint32_t origin_seed = config->seed();
+  config->set_seed(1024);
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph("mindrecord", path, 1);
+  ASSERT_OK(graph.Init());
+  GraphDataImpl parallel_graph("mindrecord", path, 4);
+  ASSERT_OK(parallel_graph.Init());
+  config->set_seed(origin_seed);
+
+  MetaInfo meta_info;
+  ASSERT_OK(graph.GetMetaInfo(&meta_info));
+  std::shared_ptr<Tensor> nodes;
+  ASSERT_OK(graph.GetAllNodes(meta_info.node_type[0], &nodes));
+  // enough nodes for each worker to take a part of them
+  std::vector<NodeIdType> node_list;
+  for (int32_t i = 0; i < 100; ++i) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+  for (auto strategy : {SamplingStrategy::kRandom, SamplingStrategy::kEdgeWeight}) {
+    std::shared_ptr<Tensor> neighbors, parallel_neighbors;
+    ASSERT_OK(graph.GetSampledNeighbors(node_list, {3, 2}, {meta_info.node_type[1], meta_info.node_type[0]},
+                                        strategy, &neighbors));
+    ASSERT_OK(parallel_graph.GetSampledNeighbors(node_list, {3, 2}, {meta_info.node_type[1], meta_info.node_type[0]},
+                                                 strategy, &parallel_neighbors));
+    EXPECT_EQ(neighbors->shape(), TensorShape({static_cast<dsize_t>(node_list.size()), 10}));
+    EXPECT_EQ(neighbors->ToString(), parallel_neighbors->ToString());
+  }
+
+  std::shared_ptr<Tensor> neg_neighbors, parallel_neg_neighbors;
+  ASSERT_OK(graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &neg_neighbors));
+  ASSERT_OK(parallel_graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &parallel_neg_neighbors));
+  EXPECT_EQ(neg_neighbors->ToString(), parallel_neg_neighbors->ToString());
+  // the negative neighbors of a node are distinct, and none of them is a neighbor of the node
+  std::shared_ptr<Tensor> all_neighbors;
+  ASSERT_OK(graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &all_neighbors));
+  NodeNeighborsMap neg_map, neighbors_map;
+  ParsingNeighbors(all_neighbors, neighbors_map);
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    std::set<NodeIdType> drawn;
+    for (dsize_t j = 1; j < 4; ++j) {
+      NodeIdType node = 0;
+      ASSERT_OK(neg_neighbors->GetItemAt<NodeIdType>(&node, {static_cast<dsize_t>(i), j}));
+      EXPECT_EQ(neighbors_map[node_list[i]].count(node), 0);
+      EXPECT_TRUE(drawn.insert(node).second);
+    }
+  }
+
+  std::vector<NodeType> meta_path(4, meta_info.node_type[1]);
+  for (size_t i = 1; i < meta_path.size(); i += 2) {
+    meta_path[i] = meta_info.node_type[0];
+  }
+  std::shared_ptr<Tensor> walks, parallel_walks;
+  ASSERT_OK(graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walks));
+  ASSERT_OK(parallel_graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &parallel_walks));
+  EXPECT_EQ(walks->shape(), TensorShape({static_cast<dsize_t>(node_list.size()), 5}));
+  EXPECT_EQ(walks->ToString(), parallel_walks->ToString());
+}
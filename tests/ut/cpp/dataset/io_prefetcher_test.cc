@@ -0,0 +1,104 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/datasetops/source/io_prefetcher.h"
+#include "minddata/dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestIOPrefetcher : public UT::Common {
+ public:
+  MindDataTestIOPrefetcher() {}
+
+  void SetUp() override { Services::CreateInstance(); }
+
+  std::string WriteFile(const std::string &name, size_t size) {
+    std::string content;
+    for (size_t i = 0; i < size; ++i) {
+      content.push_back(i % 61 == 60 ? '\n' : static_cast<char>('a' + (i * 7 + name.size()) % 26));
+    }
+    std::string path = "./" + name;
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs << content;
+    ofs.close();
+    files_.push_back(path);
+    return content;
+  }
+
+  void TearDown() override {
+    for (const auto &path : files_) {
+      (void)std::remove(path.c_str());
+    }
+  }
+
+ private:
+  std::vector<std::string> files_;
+};
+
+/// Feature: IOPrefetcher
+/// Description: Test the files submitted to IOPrefetcher are read back by streams in order, including a file that
+///     can not be opened and a file released before it is read to the end
+/// Expectation: The content read from the streams is the same as the files
+TEST_F(MindDataTestIOPrefetcher, TestReadAhead) {
+  std::vector<std::string> contents = {WriteFile("io_prefetcher_test_0.txt", 10000),
+                                       WriteFile("io_prefetcher_test_1.txt", 63),
+                                       WriteFile("io_prefetcher_test_2.txt", 0)};
+  TaskGroup vg;
+  IOPrefetcher prefetcher(4, 2, 64);
+  ASSERT_OK(prefetcher.Register(&vg));
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_OK(vg.CreateAsyncTask("IOWorkerEntry", std::bind(&IOPrefetcher::IOWorkerEntry, &prefetcher, i)));
+  }
+
+  std::vector<std::shared_ptr<PrefetchedFile>> files;
+  for (size_t i = 0; i < contents.size(); ++i) {
+    files.push_back(prefetcher.Submit("./io_prefetcher_test_" + std::to_string(i) + ".txt"));
+  }
+  auto missing = prefetcher.Submit("./io_prefetcher_test_not_exist.txt");
+  auto dropped = prefetcher.Submit("./io_prefetcher_test_0.txt");
+
+  for (size_t i = 0; i < contents.size(); ++i) {
+    std::unique_ptr<std::istream> stream;
+    ASSERT_OK(prefetcher.OpenStream(files[i], &stream));
+    ASSERT_FALSE(stream->fail());
+    std::string content((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, contents[i]);
+    ASSERT_OK(prefetcher.Release(files[i]));
+  }
+
+  std::unique_ptr<std::istream> stream;
+  ASSERT_OK(prefetcher.OpenStream(missing, &stream));
+  EXPECT_TRUE(stream->fail());
+  EXPECT_TRUE(prefetcher.Release(missing).IsError());
+
+  // read a few lines then drop the blocks read ahead
+  ASSERT_OK(prefetcher.OpenStream(dropped, &stream));
+  std::string line;
+  ASSERT_TRUE(std::getline(*stream, line));
+  EXPECT_EQ(line, contents[0].substr(0, 60));
+  ASSERT_OK(prefetcher.Release(dropped));
+
+  prefetcher.Stop();
+  ASSERT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  ASSERT_OK(vg.GetTaskErrorIfAny());
+}
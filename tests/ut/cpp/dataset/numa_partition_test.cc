@@ -0,0 +1,178 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/numa_partition.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/vision.h"
+#include "minddata/dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestNumaPartition : public UT::DatasetOpTesting {
+ protected:
+};
+
+/// Feature: NumaPartition
+/// Description: Parse valid and invalid cpu lists of sysfs
+/// Expectation: The cpus are listed for the valid lists, and error is returned for the invalid ones
+TEST_F(MindDataTestNumaPartition, TestParseCpuList) {
+  std::vector<int32_t> cpus;
+  ASSERT_OK(NumaPartition::ParseCpuList("0-3,8,10-11\n", &cpus));
+  EXPECT_EQ(cpus, std::vector<int32_t>({0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_OK(NumaPartition::ParseCpuList("", &cpus));
+  EXPECT_TRUE(cpus.empty());
+  EXPECT_ERROR(NumaPartition::ParseCpuList("3-1", &cpus));
+  EXPECT_ERROR(NumaPartition::ParseCpuList("a-b", &cpus));
+}
+
+/// Feature: NumaNodePool
+/// Description: Allocate and reallocate blocks which fit in an arena and blocks which do not
+/// Expectation: The blocks are allocated and the content is kept by the reallocation
+TEST_F(MindDataTestNumaPartition, TestNumaNodePool) {
+  const size_t kMB = 1048576;
+  std::shared_ptr<MemoryPool> pool;
+  ASSERT_OK(NumaNodePool::CreateNumaNodePool(&pool, 1, 1));
+
+  void *small = nullptr;
+  ASSERT_OK(pool->Allocate(1024, &small));
+  (void)memset_s(small, 1024, 'a', 1024);
+  // The block is moved out of the arena
+  ASSERT_OK(pool->Reallocate(&small, 1024, 2 * kMB));
+  EXPECT_EQ(static_cast<char *>(small)[1023], 'a');
+
+  void *large = nullptr;
+  ASSERT_OK(pool->Allocate(2 * kMB, &large));
+  (void)memset_s(large, 2 * kMB, 'b', 2 * kMB);
+  ASSERT_OK(pool->Reallocate(&large, 2 * kMB, 3 * kMB));
+  EXPECT_EQ(static_cast<char *>(large)[2 * kMB - 1], 'b');
+
+  pool->Deallocate(small);
+  pool->Deallocate(large);
+}
+
+/// Feature: NumaNodePool
+/// Description: Get the max size of a node pool from the memory budget, from the memory of the node, and from neither
+/// Expectation: The budget is shared by the nodes, a pool takes up to half of its node, and the size is at least 1 GB
+TEST_F(MindDataTestNumaPartition, TestNodePoolMaxSize) {
+  const int64_t kGB = 1024 * 1024 * 1024;
+  EXPECT_EQ(NumaPartition::NodePoolMaxSizeInGB(64 * 1024, 16 * kGB, 2), 8);
+  EXPECT_EQ(NumaPartition::NodePoolMaxSizeInGB(64 * 1024, 0, 2), 32);
+  EXPECT_EQ(NumaPartition::NodePoolMaxSizeInGB(1024, 0, 2), 1);
+  EXPECT_EQ(NumaPartition::NodePoolMaxSizeInGB(0, kGB, 4), 1);
+  EXPECT_GT(NumaPartition::NodePoolMaxSizeInGB(0, 0, 2), 0);
+
+  std::shared_ptr<MemoryPool> pool;
+  EXPECT_ERROR(NumaNodePool::CreateNumaNodePool(&pool, 1, 0));
+}
+
+/// Feature: NumaPartition
+/// Description: Route the rows to the workers of ops whose numbers of workers are and are not multiples of the number of
+///     nodes, or are fewer than the nodes
+/// Expectation: A row goes to a worker of node row % num_nodes when every node has a worker, all the workers take rows,
+///     and the rows go round robin when the number of workers is a multiple of the number of nodes or is too small
+TEST_F(MindDataTestNumaPartition, TestWorkerOfRow) {
+  const int64_t kNumRows = 120;
+  for (int32_t num_nodes : {2, 3}) {
+    for (int32_t num_workers = 1; num_workers <= 8; ++num_workers) {
+      std::vector<int64_t> num_rows(num_workers, 0);
+      for (int64_t row = 0; row < kNumRows; ++row) {
+        int32_t worker_id = NumaPartition::WorkerOfRow(row, num_workers, num_nodes);
+        ASSERT_GE(worker_id, 0);
+        ASSERT_LT(worker_id, num_workers);
+        ++num_rows[worker_id];
+        if (num_workers < num_nodes || num_workers % num_nodes == 0) {
+          EXPECT_EQ(worker_id, row % num_workers);
+        } else {
+          EXPECT_EQ(worker_id % num_nodes, row % num_nodes);
+        }
+      }
+      EXPECT_EQ(std::count(num_rows.begin(), num_rows.end(), 0), 0);
+    }
+  }
+}
+
+/// Feature: NumaPartition
+/// Description: Bind a thread to the first NUMA node and create a tensor on it
+/// Expectation: The tensor is valid after the thread ends, the other threads keep the global pool, and an invalid node
+///     returns error
+TEST_F(MindDataTestNumaPartition, TestBindThread) {
+  auto numa_partition = NumaPartition::GetInstance();
+  ASSERT_GE(numa_partition->NumNodes(), 1);
+  EXPECT_EQ(numa_partition->NodeOfWorker(numa_partition->NumNodes()), 0);
+  EXPECT_ERROR(numa_partition->BindThread(numa_partition->NumNodes()));
+
+  auto global_pool = GlobalContext::Instance()->mem_pool();
+  std::shared_ptr<Tensor> tensor;
+  TaskGroup vg;
+  ASSERT_OK(vg.CreateAsyncTask("BindThread", [numa_partition, &tensor]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(numa_partition->BindThread(0));
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({64, 64}), DataType(DataType::DE_INT32), &tensor));
+    return tensor->Fill<int32_t>(7);
+  }));
+  vg.join_all();
+  ASSERT_OK(vg.GetTaskErrorIfAny());
+  // The calling thread still allocates from the global pool
+  EXPECT_EQ(GlobalContext::Instance()->mem_pool(), global_pool);
+  int32_t value = 0;
+  ASSERT_OK(tensor->GetItemAt<int32_t>(&value, {63, 63}));
+  EXPECT_EQ(value, 7);
+  tensor.reset();
+}
+
+/// Feature: NumaPartition
+/// Description: Run a pipeline with parallel workers partitioned over the NUMA nodes and not partitioned
+/// Expectation: The rows are the same
+TEST_F(MindDataTestNumaPartition, TestPipeline) {
+  auto run_pipeline = [this](bool numa_partition) {
+    GlobalContext::config_manager()->set_numa_partition(numa_partition);
+    std::string folder_path = datasets_root_path_ + "/testPK/data/";
+    std::shared_ptr<Dataset> ds = ImageFolder(folder_path, true, std::make_shared<SequentialSampler>(0, 20));
+    ds = ds->SetNumWorkers(4);
+    auto decode = std::make_shared<vision::Decode>();
+    auto resize = std::make_shared<vision::Resize>(std::vector<int32_t>{32, 32});
+    ds = ds->Map({decode, resize}, {"image"});
+    ds = ds->SetNumWorkers(4);
+    std::shared_ptr<Iterator> iter = ds->CreateIterator();
+    EXPECT_NE(iter, nullptr);
+    std::vector<std::vector<uint8_t>> images;
+    std::unordered_map<std::string, mindspore::MSTensor> row;
+    EXPECT_OK(iter->GetNextRow(&row));
+    while (!row.empty()) {
+      auto image = row["image"];
+      auto data = static_cast<const uint8_t *>(image.Data().get());
+      images.emplace_back(data, data + image.DataSize());
+      EXPECT_OK(iter->GetNextRow(&row));
+    }
+    iter->Stop();
+    GlobalContext::config_manager()->set_numa_partition(false);
+    return images;
+  };
+  auto expected = run_pipeline(false);
+  auto images = run_pipeline(true);
+  EXPECT_EQ(expected.size(), 20);
+  EXPECT_EQ(images, expected);
+}
@@ -30,6 +30,7 @@
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 using namespace mindspore::dataset;
@@ -120,3 +121,49 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass by fusing chains of fusable tensor operations into FusedChainOp
+/// Expectation: Each run of fusable operations is replaced by one FusedChainOp and the other operations are kept
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassFusedChain) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassFusedChain.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode = std::make_shared<vision::Decode>();
+  auto type_cast = std::make_shared<transforms::TypeCast>(mindspore::DataType::kNumberTypeFloat32);
+  auto rescale = std::make_shared<vision::Rescale>(1.0 / 255, 0.0);
+  auto flip = std::make_shared<vision::RandomHorizontalFlip>(0.5);
+  auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{0.485, 0.456, 0.406},
+                                                       std::vector<float>{0.229, 0.224, 0.225});
+  auto hwc_to_chw = std::make_shared<vision::HWC2CHW>();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)->Map({decode, type_cast, rescale, flip, normalize, hwc_to_chw}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  ASSERT_NE(map_node, nullptr);
+  nlohmann::json unfused_json;
+  ASSERT_OK(map_node->to_json(&unfused_json));
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 4);
+  EXPECT_EQ(fused_ops[0]->Name(), vision::kDecodeOperation);
+  EXPECT_EQ(fused_ops[1]->Name(), kFusedChainOp);
+  EXPECT_EQ(fused_ops[2]->Name(), vision::kRandomHorizontalFlipOperation);
+  EXPECT_EQ(fused_ops[3]->Name(), kFusedChainOp);
+  // the fused chains are serialized as the operations they are fused from
+  nlohmann::json fused_json;
+  ASSERT_OK(map_node->to_json(&fused_json));
+  EXPECT_EQ(fused_json["operations"], unfused_json["operations"]);
+
+  // A single fusable operation is left alone
+  root = ImageFolder(folder_path, false)->Map({decode, hwc_to_chw}, {"image"});
+  map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  ASSERT_NE(map_node, nullptr);
+  modified = false;
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  EXPECT_EQ(map_node->operations().size(), 2);
+}
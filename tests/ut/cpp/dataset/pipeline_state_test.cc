@@ -0,0 +1,149 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/datasetops/shuffle_op.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/samplers.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestPipelineState : public UT::DatasetOpTesting {
+ protected:
+  MindDataTestPipelineState() {}
+
+  /// \brief Get the labels of the rows of a tree adapter, until the end of the epochs or up to a number of rows
+  /// \param[in] tree_adapter The tree adapter to get the rows from
+  /// \param[in] max_rows The maximum number of rows to get, -1 for all of them
+  /// \param[out] labels The labels got, -1 for the end of an epoch
+  /// \return Status of the function
+  Status GetLabels(const std::shared_ptr<TreeAdapter> &tree_adapter, int64_t max_rows, std::vector<int32_t> *labels) {
+    TensorRow row;
+    int64_t num_rows = 0;
+    while (max_rows < 0 || num_rows < max_rows) {
+      RETURN_IF_NOT_OK(tree_adapter->GetNext(&row));
+      if (row.empty()) {
+        // GetNext() returns an empty row at the end of an epoch, and fails after the last one
+        labels->push_back(-1);
+        if (++epochs_got_ == num_epochs_) {
+          break;
+        }
+        continue;
+      }
+      int32_t label;
+      RETURN_IF_NOT_OK(row[1]->GetItemAt(&label, {}));
+      labels->push_back(label);
+      ++num_rows;
+    }
+    return Status::OK();
+  }
+
+  /// \brief Get some rows of a pipeline, then restore it from its state and check it produces the remaining rows
+  /// \param[in] ds The dataset of the pipeline
+  /// \param[in] num_rows The number of rows to get before the state is got
+  void CheckRestore(const std::shared_ptr<Dataset> &ds, int64_t num_rows) {
+    // the skip of the resume goes below the shuffle only in fast recovery
+    GlobalContext::config_manager()->set_fast_recovery(true);
+    epochs_got_ = 0;
+    auto tree_adapter = std::make_shared<TreeAdapter>();
+    ASSERT_OK(tree_adapter->Compile(ds->IRNode(), num_epochs_));
+    std::vector<int32_t> labels;
+    ASSERT_OK(GetLabels(tree_adapter, num_rows, &labels));
+    nlohmann::json pipeline_state;
+    ASSERT_OK(tree_adapter->GetPipelineState(&pipeline_state));
+    int32_t epochs_got = epochs_got_;
+    std::vector<int32_t> expected;
+    ASSERT_OK(GetLabels(tree_adapter, -1, &expected));
+
+    // the state survives a round trip through its text form
+    pipeline_state = nlohmann::json::parse(pipeline_state.dump());
+    epochs_got_ = epochs_got;
+    auto restored = std::make_shared<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
+    ASSERT_OK(restored->CompileFromPipelineState(ds->IRNode(), num_epochs_, pipeline_state));
+    std::vector<int32_t> actual;
+    ASSERT_OK(GetLabels(restored, -1, &actual));
+    EXPECT_EQ(actual, expected) << "Restored after " << num_rows << " rows from: " << pipeline_state.dump();
+  }
+
+  int32_t num_epochs_ = 2;
+  int32_t epochs_got_ = 0;
+};
+
+/// Feature: Pipeline state
+/// Description: Test restoring a pipeline with a shuffle over a mappable source in the middle of each epoch
+/// Expectation: The restored pipeline produces the rows which the original one produces after the state is got
+TEST_F(MindDataTestPipelineState, TestShuffleMappable) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  // 44 rows with a shuffle buffer smaller than them, and another one larger than them
+  for (int32_t buffer_size : {4, 64}) {
+    auto ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>())->Shuffle(buffer_size);
+    for (int64_t num_rows : {0, 1, 3, 20, 43, 44, 45, 60}) {
+      CheckRestore(ds, num_rows);
+    }
+  }
+}
+
+/// Feature: Pipeline state
+/// Description: Test restoring a pipeline with a shuffle over a skip, which the skip of the resume is not pushed into
+/// Expectation: The restored pipeline produces the rows which the original one produces after the state is got
+TEST_F(MindDataTestPipelineState, TestShuffleSkip) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>())->Skip(2)->Shuffle(8);
+  for (int64_t num_rows : {5, 30, 50}) {
+    CheckRestore(ds, num_rows);
+  }
+}
+
+/// Feature: Pipeline state
+/// Description: Test replaying the draws of a shuffle buffer
+/// Expectation: The rows left in the buffer are the ones which have not been drawn
+TEST_F(MindDataTestPipelineState, TestReplayShuffle) {
+  const int32_t shuffle_size = 5;
+  const int64_t num_rows = 12;
+  std::mt19937_64 rng(7);
+  std::vector<int64_t> buffer;
+  int64_t next_row = 0;
+  bool active = false;
+  ShuffleOp::ReplayShuffle(shuffle_size, num_rows, 0, &rng, &buffer, &next_row, &active);
+  EXPECT_EQ(buffer, std::vector<int64_t>({0, 1, 2, 3, 4}));
+  EXPECT_EQ(next_row, shuffle_size);
+  EXPECT_TRUE(active);
+
+  // draw the rows one by one, each drawn row leaves the buffer and the next row of the child refills it
+  for (int64_t count = 1; count <= num_rows; ++count) {
+    std::mt19937_64 replay_rng(7);
+    ShuffleOp::ReplayShuffle(shuffle_size, num_rows, count, &replay_rng, &buffer, &next_row, &active);
+    EXPECT_EQ(static_cast<int64_t>(buffer.size()), std::min<int64_t>(shuffle_size, num_rows - count));
+    std::vector<bool> in_buffer(num_rows, false);
+    for (auto row : buffer) {
+      ASSERT_LT(row, next_row);
+      in_buffer[row] = true;
+    }
+    int64_t num_drawn = 0;
+    for (int64_t row = 0; row < next_row; ++row) {
+      num_drawn += in_buffer[row] ? 0 : 1;
+    }
+    EXPECT_EQ(num_drawn, count);
+  }
+  EXPECT_FALSE(active);
+  EXPECT_EQ(next_row, num_rows);
+}
@@ -171,3 +171,46 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+/// Feature: JpegCropAndDecode
+/// Description: Test decoding crops of a JPEG image at a reduced scale for a target size
+/// Expectation: The crop is decoded at the smallest scale which still covers the target size
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestScaledDecode) {
+  EXPECT_EQ(JpegScaleDenom(800, 600, 100, 75), 8);
+  EXPECT_EQ(JpegScaleDenom(800, 600, 100, 76), 4);
+  EXPECT_EQ(JpegScaleDenom(800, 600, 401, 300), 1);
+  EXPECT_EQ(JpegScaleDenom(800, 600, 0, 0), 1);
+
+  std::shared_ptr<Tensor> decoded;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &decoded));
+  const int h = decoded->shape()[0];
+  const int w = decoded->shape()[1];
+  std::shared_ptr<Tensor> scaled;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &scaled, 0, 0, 0, 0, w / 4, h / 4));
+  EXPECT_EQ(scaled->shape(), TensorShape({(h + 3) / 4, (w + 3) / 4, 3}));
+
+  constexpr int x = 37;
+  constexpr int y = 53;
+  constexpr int crop_width = 300;
+  constexpr int crop_height = 250;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &scaled, x, y, crop_width, crop_height, 100, 80));
+  // the crop covers the pixels 18 to 168 and 26 to 151 of the image decoded at half scale
+  ASSERT_EQ(scaled->shape(), TensorShape({152 - 26, 169 - 18, 3}));
+  EXPECT_GE(scaled->shape()[0], 80);
+  EXPECT_GE(scaled->shape()[1], 100);
+
+  // each pixel is close to the mean of the 2x2 pixels it covers at full resolution
+  cv::Mat full = CVTensor::AsCVTensor(decoded)->mat();
+  cv::Mat half = CVTensor::AsCVTensor(scaled)->mat();
+  double diff_sum = 0;
+  for (int i = 0; i < half.rows; ++i) {
+    for (int j = 0; j < half.cols; ++j) {
+      int mean = 0;
+      for (int k = 0; k < 4; ++k) {
+        mean += full.at<cv::Vec3b>((26 + i) * 2 + k / 2, (18 + j) * 2 + k % 2)[1];
+      }
+      diff_sum += std::abs(mean / 4.0 - half.at<cv::Vec3b>(i, j)[1]);
+    }
+  }
+  EXPECT_LT(diff_sum / (half.rows * half.cols), kMseThreshold);
+}
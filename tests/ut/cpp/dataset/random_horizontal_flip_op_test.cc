@@ -117,3 +117,45 @@ TEST_F(MindDataTestRandomHorizontalFlipOp, TestVideo1DOp) {
 
   MS_LOG(INFO) << "TestVideo1DOp end.";
 }
+
+/// Feature: RandomHorizontalFlip
+/// Description: Test RandomHorizontalFlipOp in batch mode on a batch of images
+/// Expectation: Each image of the batch is either flipped or copied, and both happen over a large enough batch
+TEST_F(MindDataTestRandomHorizontalFlipOp, TestBatchMode) {
+  const dsize_t num_images = 32;
+  const dsize_t height = 2, width = 5, num_channels = 3;
+  std::vector<uint8_t> data(num_images * height * width * num_channels);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i % 256);
+  }
+  std::shared_ptr<Tensor> batch;
+  ASSERT_OK(Tensor::CreateFromVector(data, TensorShape({num_images, height, width, num_channels}), &batch));
+  auto op = std::make_unique<RandomHorizontalFlipOp>(0.5);
+  op->SetBatchMode(true);
+  TensorRow output;
+  TensorRow input;
+  input.push_back(batch);
+  ASSERT_OK(op->Compute(input, &output));
+  ASSERT_EQ(output[0]->shape(), batch->shape());
+
+  int32_t num_flipped = 0;
+  for (dsize_t n = 0; n < num_images; ++n) {
+    bool flipped = true, copied = true;
+    for (dsize_t h = 0; h < height; ++h) {
+      for (dsize_t w = 0; w < width; ++w) {
+        for (dsize_t c = 0; c < num_channels; ++c) {
+          uint8_t in = 0, out = 0, in_flipped = 0;
+          ASSERT_OK(batch->GetItemAt<uint8_t>(&in, {n, h, w, c}));
+          ASSERT_OK(batch->GetItemAt<uint8_t>(&in_flipped, {n, h, width - 1 - w, c}));
+          ASSERT_OK(output[0]->GetItemAt<uint8_t>(&out, {n, h, w, c}));
+          copied = copied && out == in;
+          flipped = flipped && out == in_flipped;
+        }
+      }
+    }
+    ASSERT_TRUE(flipped != copied);
+    num_flipped += flipped ? 1 : 0;
+  }
+  EXPECT_GT(num_flipped, 0);
+  EXPECT_LT(num_flipped, num_images);
+}
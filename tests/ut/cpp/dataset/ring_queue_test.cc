@@ -0,0 +1,131 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/util/ring_queue.h"
+#include "minddata/dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestRingQueue : public UT::Common {
+ public:
+  MindDataTestRingQueue() {}
+};
+
+/// Feature: RingQueue
+/// Description: Test single and batched add and pop on a ring queue, across the wrap around of the ring, and reset
+/// Expectation: The elements are popped in the order they are added
+TEST_F(MindDataTestRingQueue, TestAddPop) {
+  RingQueue<std::unique_ptr<int>> que(3);
+  EXPECT_EQ(que.capacity(), 3);
+  EXPECT_TRUE(que.empty());
+  ASSERT_OK(que.Add(std::make_unique<int>(0)));
+  ASSERT_OK(que.Add(std::make_unique<int>(1)));
+  EXPECT_EQ(que.size(), 2);
+  std::unique_ptr<int> v;
+  ASSERT_OK(que.PopFront(&v));
+  EXPECT_EQ(*v, 0);
+
+  std::vector<std::unique_ptr<int>> batch;
+  batch.push_back(std::make_unique<int>(2));
+  batch.push_back(std::make_unique<int>(3));
+  ASSERT_OK(que.AddBatch(&batch));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(que.size(), 3);
+
+  std::vector<std::unique_ptr<int>> out;
+  ASSERT_OK(que.PopFrontBatch(&out, 2));
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_EQ(*out[0], 1);
+  EXPECT_EQ(*out[1], 2);
+  // only what is in the queue is popped
+  ASSERT_OK(que.PopFrontBatch(&out, 8));
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(*out[2], 3);
+  EXPECT_TRUE(que.empty());
+
+  ASSERT_OK(que.Add(std::make_unique<int>(4)));
+  que.Reset();
+  EXPECT_TRUE(que.empty());
+  ASSERT_OK(que.Add(std::make_unique<int>(5)));
+  ASSERT_OK(que.PopFront(&v));
+  EXPECT_EQ(*v, 5);
+}
+
+/// Feature: RingQueue
+/// Description: Test a producer thread and a consumer thread passing many elements through a small ring queue, so
+///     that both sides spin and park
+/// Expectation: The consumer gets all the elements in order
+TEST_F(MindDataTestRingQueue, TestProducerConsumer) {
+  const int32_t num_elements = 200000;
+  RingQueue<int32_t> que(4);
+  TaskGroup vg;
+  ASSERT_OK(que.Register(&vg));
+  ASSERT_OK(vg.CreateAsyncTask("Producer", [&que, num_elements]() -> Status {
+    TaskManager::FindMe()->Post();
+    int32_t i = 0;
+    while (i < num_elements) {
+      if (i % 3 == 0) {
+        std::vector<int32_t> batch;
+        for (int32_t k = 0; k < 7 && i < num_elements; ++k) {
+          batch.push_back(i++);
+        }
+        RETURN_IF_NOT_OK(que.AddBatch(&batch));
+      } else {
+        RETURN_IF_NOT_OK(que.Add(i++));
+      }
+    }
+    return Status::OK();
+  }));
+  std::vector<int32_t> out;
+  while (out.size() < num_elements) {
+    if (out.size() % 2 == 0) {
+      ASSERT_OK(que.PopFrontBatch(&out, 5));
+    } else {
+      int32_t v = 0;
+      ASSERT_OK(que.PopFront(&v));
+      out.push_back(v);
+    }
+  }
+  ASSERT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  ASSERT_OK(vg.GetTaskErrorIfAny());
+  ASSERT_EQ(out.size(), num_elements);
+  for (int32_t i = 0; i < num_elements; ++i) {
+    ASSERT_EQ(out[i], i);
+  }
+}
+
+/// Feature: RingQueue
+/// Description: Test a producer parked on a full ring queue is woken up when the task group is interrupted
+/// Expectation: The add returns an error instead of blocking forever
+TEST_F(MindDataTestRingQueue, TestInterrupt) {
+  RingQueue<int32_t> que(1);
+  TaskGroup vg;
+  ASSERT_OK(que.Register(&vg));
+  ASSERT_OK(que.Add(0));
+  Status add_rc;
+  ASSERT_OK(vg.CreateAsyncTask("Producer", [&que, &add_rc]() -> Status {
+    TaskManager::FindMe()->Post();
+    add_rc = que.Add(1);
+    return Status::OK();
+  }));
+  vg.interrupt_all();
+  ASSERT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  EXPECT_TRUE(add_rc.IsError());
+}
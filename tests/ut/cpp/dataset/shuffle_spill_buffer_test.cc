@@ -0,0 +1,102 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/datasetops/shuffle_spill_buffer.h"
+#include "minddata/dataset/util/path.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestShuffleSpillBuffer : public UT::Common {
+ public:
+  MindDataTestShuffleSpillBuffer() {}
+
+  static TensorRow MakeRow(int64_t id) {
+    std::shared_ptr<Tensor> image;
+    std::vector<uint8_t> pixels(2000 + id % 7 * 100, static_cast<uint8_t>(id));
+    EXPECT_OK(Tensor::CreateFromVector(pixels, &image));
+    std::shared_ptr<Tensor> label;
+    EXPECT_OK(Tensor::CreateScalar(static_cast<int32_t>(id), &label));
+    std::shared_ptr<Tensor> text;
+    EXPECT_OK(Tensor::CreateFromVector(std::vector<std::string>{"row", std::to_string(id)}, &text));
+    TensorRow row(id, {image, label, text});
+    row.setPath({"file_" + std::to_string(id), "", "file_" + std::to_string(id)});
+    return row;
+  }
+
+  static void ExpectRowEq(const TensorRow &row, const TensorRow &expected) {
+    ASSERT_EQ(row.size(), expected.size());
+    EXPECT_EQ(row.getId(), expected.getId());
+    EXPECT_EQ(row.getPath(), expected.getPath());
+    for (size_t i = 0; i < row.size(); ++i) {
+      EXPECT_EQ(*row[i], *expected[i]);
+    }
+  }
+};
+
+/// Feature: ShuffleSpillBuffer
+/// Description: Test rows are taken out of a spill buffer with a small memory limit in the same order as a TensorTable
+///     which moves its last row into the vacated slot, while rows keep being added
+/// Expectation: The rows are the same, the resident blocks are bounded, and the spill files are removed once their rows
+///     are taken and at the end
+TEST_F(MindDataTestShuffleSpillBuffer, TestTakeMatchesTable) {
+  const int64_t mem_limit = 256 * 1024;
+  const int64_t num_rows = 800;
+  const int64_t buffer_size = 300;
+  Path spill_dir("./shuffle_spill_buffer_test");
+  ASSERT_OK(spill_dir.CreateDirectories());
+  {
+    ShuffleSpillBuffer buffer(mem_limit, spill_dir.ToString());
+    TensorTable table;
+    std::mt19937_64 rng(1);
+    int64_t next_id = 0;
+    int64_t max_resident = 0;
+    while (next_id < num_rows || !table.empty()) {
+      while (next_id < num_rows && static_cast<int64_t>(table.size()) < buffer_size) {
+        table.push_back(MakeRow(next_id));
+        ASSERT_OK(buffer.Add(MakeRow(next_id)));
+        max_resident = std::max(max_resident, buffer.resident_bytes());
+        next_id++;
+      }
+      ASSERT_EQ(buffer.size(), static_cast<int64_t>(table.size()));
+      int64_t slot = rng() % table.size();
+      TensorRow row;
+      ASSERT_OK(buffer.Take(slot, &row));
+      ExpectRowEq(row, table[slot]);
+      table[slot] = std::move(table.back());
+      table.pop_back();
+    }
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_GT(buffer.num_spilled_blocks(), 0);
+    // the spill files whose blocks are all taken are removed, only the one being written may be left
+    EXPECT_LE(buffer.num_spill_files(), 1);
+    // the block being filled may go over the limit by one block
+    EXPECT_LE(max_resident, mem_limit + mem_limit / 8);
+    EXPECT_EQ(buffer.resident_bytes(), 0);
+    TensorRow row;
+    EXPECT_TRUE(buffer.Take(0, &row).IsError());
+  }
+  // nothing is left behind in the spill directory
+  auto it = Path::DirIterator::OpenDirectory(&spill_dir);
+  ASSERT_NE(it, nullptr);
+  EXPECT_FALSE(it->HasNext());
+  ASSERT_OK(spill_dir.Remove());
+}
@@ -618,3 +618,66 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+/// Feature: Tensor
+/// Description: Test creating a Tensor which wraps external memory without copying it
+/// Expectation: The tensor shares the buffer and keeps the owner alive until it is released
+TEST_F(MindDataTestTensorDE, TensorFromMemoryView) {
+  auto owner = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{1, 2, 3, 4, 5, 6});
+  auto *src = reinterpret_cast<uchar *>(owner->data());
+  std::shared_ptr<Tensor> t;
+  Status rc = Tensor::CreateFromMemoryView(TensorShape({2, 3}), DataType(DataType::DE_INT32), src,
+                                           static_cast<dsize_t>(owner->size() * sizeof(int32_t)), owner, &t);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(t->GetBuffer(), src);
+  int32_t value = 0;
+  ASSERT_TRUE(t->GetItemAt(&value, {1, 2}).IsOk());
+  ASSERT_EQ(value, 6);
+
+  std::weak_ptr<std::vector<int32_t>> weak_owner = owner;
+  owner.reset();
+  ASSERT_FALSE(weak_owner.expired());
+  t.reset();
+  ASSERT_TRUE(weak_owner.expired());
+
+  // the length must match the shape and type
+  rc = Tensor::CreateFromMemoryView(TensorShape({2, 3}), DataType(DataType::DE_INT32), src, 4, nullptr, &t);
+  ASSERT_FALSE(rc.IsOk());
+}
+
+/// Feature: Tensor
+/// Description: Test creating a Tensor which wraps read-only external memory and then modifying it
+/// Expectation: The tensor shares the buffer until it is modified, then it owns a copy and releases the owner
+TEST_F(MindDataTestTensorDE, TensorFromReadOnlyMemoryView) {
+  auto owner = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{1, 2, 3, 4, 5, 6});
+  auto *src = reinterpret_cast<const uchar *>(owner->data());
+  std::shared_ptr<Tensor> t;
+  ASSERT_OK(Tensor::CreateFromReadOnlyMemoryView(TensorShape({2, 3}), DataType(DataType::DE_INT32), src,
+                                                 static_cast<dsize_t>(owner->size() * sizeof(int32_t)), owner, &t));
+  ASSERT_EQ(t->GetBuffer(), src);
+  std::weak_ptr<std::vector<int32_t>> weak_owner = owner;
+  owner.reset();
+  ASSERT_FALSE(weak_owner.expired());
+
+  // the first write copies the data
+  ASSERT_OK(t->SetItemAt<int32_t>({0, 0}, 10));
+  ASSERT_NE(t->GetBuffer(), src);
+  ASSERT_TRUE(weak_owner.expired());
+  int32_t value = 0;
+  ASSERT_OK(t->GetItemAt(&value, {0, 0}));
+  ASSERT_EQ(value, 10);
+  ASSERT_OK(t->GetItemAt(&value, {1, 2}));
+  ASSERT_EQ(value, 6);
+
+  // a mutable buffer is a copy too, and the source is left unchanged
+  owner = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{1, 2, 3, 4, 5, 6});
+  ASSERT_OK(Tensor::CreateFromReadOnlyMemoryView(TensorShape({2, 3}), DataType(DataType::DE_INT32),
+                                                 reinterpret_cast<const uchar *>(owner->data()),
+                                                 static_cast<dsize_t>(owner->size() * sizeof(int32_t)), owner, &t));
+  auto *buf = reinterpret_cast<int32_t *>(t->GetMutableBuffer());
+  ASSERT_NE(buf, owner->data());
+  buf[1] = 20;
+  ASSERT_EQ((*owner)[1], 2);
+  ASSERT_OK(t->GetItemAt(&value, {0, 1}));
+  ASSERT_EQ(value, 20);
+}
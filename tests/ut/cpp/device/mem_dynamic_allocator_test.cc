@@ -0,0 +1,299 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "include/backend/mem_reuse/mem_dynamic_allocator.h"
+#include "include/backend/mem_reuse/mem_dynamic_allocator_size_class.h"
+
+namespace mindspore::device {
+constexpr size_t kHostPoolUnitSize = 256 << 20;
+constexpr size_t kHostPoolFreeMemSize = static_cast<size_t>(64) << 30;
+
+// The memory pool on the host memory.
+class HostMemPool : public DynamicMemPoolBestFit {
+ public:
+  HostMemPool() { SetMemAllocUintSize(kHostPoolUnitSize, kHostPoolUnitSize); }
+  ~HostMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    return *addr == nullptr ? 0 : size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return kHostPoolFreeMemSize; }
+};
+
+// An operation of the allocation trace, which allocates or frees the memory buf of the id.
+struct TraceOp {
+  bool alloc_;
+  size_t id_;
+  size_t size_;
+};
+
+// Generate the allocation trace of the training steps of a network with dynamic shapes: each kernel allocates its
+// output, which is freed after it is used by the following kernels, and the batch size changes by step.
+std::vector<TraceOp> GenerateTrace(uint32_t seed, size_t step_num, size_t kernel_num) {
+  constexpr size_t kLifetime = 4;
+  constexpr size_t kMaxBatch = 32;
+  constexpr size_t kSmallPercent = 80;
+  constexpr size_t kPercent = 100;
+  std::mt19937 gen(seed);
+  std::vector<size_t> small_sizes;
+  std::vector<size_t> large_sizes;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    small_sizes.push_back(gen() % (4 << 10) + 4);
+    large_sizes.push_back(gen() % (128 << 10) + 4);
+  }
+  std::vector<TraceOp> trace;
+  size_t id = 0;
+  for (size_t step = 0; step < step_num; ++step) {
+    size_t batch = gen() % kMaxBatch + 1;
+    std::vector<std::pair<size_t, size_t>> outputs;
+    for (size_t i = 0; i < kernel_num; ++i) {
+      size_t size = (gen() % kPercent < kSmallPercent ? small_sizes[i] : large_sizes[i]) * batch;
+      trace.push_back({true, id, size});
+      outputs.emplace_back(id++, size);
+      if (outputs.size() > kLifetime) {
+        trace.push_back({false, outputs[outputs.size() - kLifetime - 1].first, 0});
+      }
+    }
+    for (size_t i = outputs.size() > kLifetime ? outputs.size() - kLifetime : 0; i < outputs.size(); ++i) {
+      trace.push_back({false, outputs[i].first, 0});
+    }
+  }
+  return trace;
+}
+
+// Replay the traces on the threads, and check the content of the memory bufs to find the overlapped ones.
+template <typename Pool>
+bool ReplayTraces(Pool *pool, const std::vector<std::vector<TraceOp>> &traces) {
+  std::vector<std::thread> threads;
+  std::vector<size_t> overlapped_nums(traces.size(), 0);
+  for (size_t i = 0; i < traces.size(); ++i) {
+    threads.emplace_back([pool, &trace = traces[i], &overlapped_num = overlapped_nums[i]]() {
+      std::vector<DeviceMemPtr> addrs(trace.size(), nullptr);
+      for (const auto &op : trace) {
+        if (op.alloc_) {
+          addrs[op.id_] = pool->AllocTensorMem(op.size_);
+          *static_cast<size_t *>(addrs[op.id_]) = op.id_;
+        } else {
+          overlapped_num += *static_cast<size_t *>(addrs[op.id_]) == op.id_ ? 0 : 1;
+          pool->FreeTensorMem(addrs[op.id_]);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return std::any_of(overlapped_nums.begin(), overlapped_nums.end(), [](size_t num) { return num > 0; });
+}
+
+class TestDynamicMemPoolSizeClass : public UT::Common {
+ public:
+  TestDynamicMemPoolSizeClass() = default;
+};
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Map the aligned sizes to the size classes
+/// Expectation: Each size maps to the smallest size class which holds it, and the large sizes map to no size class
+TEST_F(TestDynamicMemPoolSizeClass, TestSizeClassOf) {
+  size_t size_class_num = DynamicMemPoolSizeClass::SizeClassNum();
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeOfClass(size_class_num - 1), kMaxSizeClassMemSize);
+  for (size_t i = 0; i < size_class_num; ++i) {
+    auto size = DynamicMemPoolSizeClass::SizeOfClass(i);
+    EXPECT_EQ(size % kDynamicMemAlignSize, 0);
+    EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(size), i);
+    if (i + 1 < size_class_num) {
+      EXPECT_LT(size, DynamicMemPoolSizeClass::SizeOfClass(i + 1));
+      EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(size + kDynamicMemAlignSize), i + 1);
+    }
+  }
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(kMaxSizeClassMemSize + kDynamicMemAlignSize), kNoSizeClass);
+}
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Allocate the memory bufs of the size classes and the large ones, free and allocate them again
+/// Expectation: The memory bufs do not overlap, the idle ones are reused, and no memory is in use after they are freed
+TEST_F(TestDynamicMemPoolSizeClass, TestAllocFree) {
+  HostMemPool best_fit_pool;
+  DynamicMemPoolSizeClass pool(&best_fit_pool);
+  std::mt19937 gen(0);
+  std::vector<std::pair<uint8_t *, size_t>> bufs;
+  size_t total_size = 0;
+  for (size_t i = 0; i < 2000; ++i) {
+    size_t size = gen() % (2 * kMaxSizeClassMemSize) + 1;
+    bufs.emplace_back(static_cast<uint8_t *>(pool.AllocTensorMem(size, i % 100 == 0)), size);
+    ASSERT_NE(bufs.back().first, nullptr);
+    total_size += size;
+  }
+  EXPECT_GE(pool.TotalUsedMemStatistics(), total_size);
+  EXPECT_GE(pool.UsedMemPeakStatistics(), pool.TotalUsedMemStatistics());
+  EXPECT_EQ(pool.TotalMemStatistics(), best_fit_pool.TotalMemStatistics());
+  std::sort(bufs.begin(), bufs.end());
+  for (size_t i = 0; i + 1 < bufs.size(); ++i) {
+    EXPECT_LE(bufs[i].first + bufs[i].second, bufs[i + 1].first);
+  }
+  for (const auto &buf : bufs) {
+    pool.FreeTensorMem(buf.first);
+  }
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  pool.DumpDynamicMemPoolStateInfo();
+
+  // The idle memory buf of the thread cache is reused.
+  auto addr = pool.AllocTensorMem(1000);
+  pool.FreeTensorMem(addr);
+  EXPECT_EQ(pool.AllocTensorMem(1000), addr);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Free the memory bufs on the threads other than the allocating one, which exit afterwards
+/// Expectation: The memory bufs are returned to the pool, and reused by the allocating thread
+TEST_F(TestDynamicMemPoolSizeClass, TestCrossThreadFree) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kBufNum = 3000;
+  HostMemPool best_fit_pool;
+  DynamicMemPoolSizeClass pool(&best_fit_pool);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kThreadNum * kBufNum; ++i) {
+    addrs.push_back(pool.AllocTensorMem(kDynamicMemAlignSize));
+  }
+  size_t total_size = best_fit_pool.TotalMemStatistics();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool, &addrs, i]() {
+      for (size_t j = i * kBufNum; j < (i + 1) * kBufNum; ++j) {
+        pool.FreeTensorMem(addrs[j]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  for (size_t i = 0; i < kThreadNum * kBufNum; ++i) {
+    addrs[i] = pool.AllocTensorMem(kDynamicMemAlignSize);
+  }
+  EXPECT_EQ(best_fit_pool.TotalMemStatistics(), total_size);
+  for (auto addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+}
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Release the device memory while another thread reads the statistics, and allocate again
+/// Expectation: The memory bufs are allocated from the new memory, and freed to the pool
+TEST_F(TestDynamicMemPoolSizeClass, TestReleaseDeviceRes) {
+  HostMemPool best_fit_pool;
+  DynamicMemPoolSizeClass pool(&best_fit_pool);
+  (void)pool.AllocTensorMem(kDynamicMemAlignSize);
+  auto total_size = best_fit_pool.TotalMemStatistics();
+  std::atomic<bool> released{false};
+  std::thread reader([&pool, &released]() {
+    while (!released) {
+      (void)pool.TotalUsedMemStatistics();
+    }
+  });
+  pool.ReleaseDeviceRes();
+  released = true;
+  reader.join();
+  auto addr = pool.AllocTensorMem(kDynamicMemAlignSize);
+  ASSERT_NE(addr, nullptr);
+  *static_cast<size_t *>(addr) = 0;
+  EXPECT_GT(best_fit_pool.TotalMemStatistics(), total_size);
+  pool.FreeTensorMem(addr);
+  EXPECT_EQ(pool.AllocTensorMem(kDynamicMemAlignSize), addr);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Free all the memory bufs of a size class on a thread which exits afterwards, allocate the same memory
+///     by another size class, free them again and release the idle arenas
+/// Expectation: The idle slabs are cut for the other size class without new arenas, and all the arenas are given back
+///     to the best fit pool
+TEST_F(TestDynamicMemPoolSizeClass, TestReuseIdleSlabs) {
+  constexpr size_t kSmallBufSize = 4 << 10;
+  constexpr size_t kLargeBufSize = 8 << 10;
+  constexpr size_t kMemSize = 64 << 20;
+  HostMemPool best_fit_pool;
+  DynamicMemPoolSizeClass pool(&best_fit_pool);
+  auto free_on_thread = [&pool](const std::vector<DeviceMemPtr> &addrs) {
+    std::thread thread([&pool, &addrs]() {
+      for (auto addr : addrs) {
+        pool.FreeTensorMem(addr);
+      }
+    });
+    thread.join();
+  };
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kMemSize / kSmallBufSize; ++i) {
+    addrs.push_back(pool.AllocTensorMem(kSmallBufSize));
+  }
+  auto arenas_size = best_fit_pool.TotalUsedMemStatistics();
+  EXPECT_GE(arenas_size, kMemSize);
+  free_on_thread(addrs);
+
+  addrs.clear();
+  for (size_t i = 0; i < kMemSize / kLargeBufSize; ++i) {
+    addrs.push_back(pool.AllocTensorMem(kLargeBufSize));
+  }
+  EXPECT_EQ(best_fit_pool.TotalUsedMemStatistics(), arenas_size);
+  std::sort(addrs.begin(), addrs.end());
+  for (size_t i = 0; i + 1 < addrs.size(); ++i) {
+    EXPECT_LE(static_cast<uint8_t *>(addrs[i]) + kLargeBufSize, addrs[i + 1]);
+  }
+  free_on_thread(addrs);
+
+  EXPECT_EQ(pool.ReleaseIdleArenas(), arenas_size);
+  EXPECT_EQ(best_fit_pool.TotalUsedMemStatistics(), 0);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  auto addr = pool.AllocTensorMem(kSmallBufSize);
+  ASSERT_NE(addr, nullptr);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: DynamicMemPoolSizeClass
+/// Description: Replay the allocation traces of the dynamic shape networks on the size class pool by several threads
+/// Expectation: The memory bufs do not overlap, and no memory is in use after the traces
+TEST_F(TestDynamicMemPoolSizeClass, TestReplayTraces) {
+  constexpr size_t kStepNum = 50;
+  constexpr size_t kKernelNum = 100;
+  for (size_t thread_num : {1, 4}) {
+    std::vector<std::vector<TraceOp>> traces;
+    for (size_t i = 0; i < thread_num; ++i) {
+      traces.push_back(GenerateTrace(static_cast<uint32_t>(i), kStepNum, kKernelNum));
+    }
+    HostMemPool best_fit_pool;
+    DynamicMemPoolSizeClass size_class_pool(&best_fit_pool);
+    EXPECT_FALSE(ReplayTraces(&size_class_pool, traces));
+    EXPECT_EQ(size_class_pool.TotalUsedMemStatistics(), 0);
+    // The arenas are kept in the best fit pool for reuse, while the large memory bufs are returned to it.
+    EXPECT_GT(best_fit_pool.TotalUsedMemStatistics(), 0);
+  }
+}
+}  // namespace mindspore::device
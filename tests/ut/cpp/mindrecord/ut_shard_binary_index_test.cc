@@ -0,0 +1,107 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
+#include "ut_common.h"
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardBinaryIndex : public UT::Common {
+ public:
+  TestShardBinaryIndex() {}
+
+  void TearDown() override { (void)remove(kIndexFile.c_str()); }
+
+  const std::string kIndexFile = "./test_shard_binary_index.idx";
+};
+
+TEST_F(TestShardBinaryIndex, TestWriteAndLookup) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBinaryIndex write and lookup");
+  // row i is in blob page i / 2
+  std::vector<ShardBinaryIndex::Row> rows;
+  for (uint64_t i = 0; i < 6; ++i) {
+    rows.push_back(ShardBinaryIndex::Row{i / 2, 0, i * 10, i * 10 + 10, i / 2, i * 100, i * 100 + 100});
+  }
+  std::vector<ShardBinaryIndex::FIELD_INFO> fields = {{"label_0", true}, {"file_name_0", false}};
+  std::vector<std::vector<std::string>> values = {{"3", "b.jpg"}, {"1", "a.jpg"}, {"10", "c.jpg"},
+                                                  {"3", "a.jpg"}, {"1.5", "d.jpg"}, {"3", ""}};
+  ASSERT_TRUE(ShardBinaryIndex::Write(kIndexFile, "imagenet.shard01", rows, fields, values).IsOk());
+
+  ShardBinaryIndex index;
+  ASSERT_TRUE(index.Open(kIndexFile).IsOk());
+  ASSERT_EQ(index.GetShardName(), "imagenet.shard01");
+  ASSERT_EQ(index.GetRowCount(), 6);
+  ASSERT_EQ(index.GetRow(4).page_offset_blob, 400);
+  ASSERT_EQ(index.GetFieldId("file_name_0"), 1);
+  ASSERT_EQ(index.GetFieldId("label_1"), -1);
+  ASSERT_EQ(index.GetValue(1, 5), "");
+
+  // numbers are compared by value, not by text
+  int label = index.GetFieldId("label_0");
+  ASSERT_EQ(index.GetRowsByValue(label, "3"), (std::vector<uint64_t>{0, 3, 5}));
+  ASSERT_EQ(index.GetRowsByValue(label, "3.0"), (std::vector<uint64_t>{0, 3, 5}));
+  ASSERT_EQ(index.GetPagesByValue(label, "3"), (std::vector<uint64_t>{0, 1, 2}));
+  ASSERT_TRUE(index.GetRowsByValue(label, "2").empty());
+  ASSERT_EQ(index.GetDistinctValues(label), (std::vector<std::string>{"1", "1.5", "3", "10"}));
+  ASSERT_TRUE(index.ValueEquals(label, 4, "1.5"));
+
+  int file_name = index.GetFieldId("file_name_0");
+  ASSERT_EQ(index.GetRowsByValue(file_name, "a.jpg"), (std::vector<uint64_t>{1, 3}));
+  ASSERT_EQ(index.GetDistinctValues(file_name), (std::vector<std::string>{"", "a.jpg", "b.jpg", "c.jpg", "d.jpg"}));
+}
+
+TEST_F(TestShardBinaryIndex, TestNaNValues) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBinaryIndex with NaN values");
+  std::vector<ShardBinaryIndex::Row> rows(6, ShardBinaryIndex::Row{0, 0, 0, 0, 0, 0, 0});
+  std::vector<std::vector<std::string>> values = {{"nan"}, {"2"}, {"abc"}, {"nan"}, {"-1"}, {"2.0"}};
+  ASSERT_TRUE(ShardBinaryIndex::Write(kIndexFile, "imagenet.shard01", rows, {{"label_0", true}}, values).IsOk());
+
+  ShardBinaryIndex index;
+  ASSERT_TRUE(index.Open(kIndexFile).IsOk());
+  // NaN is after all numbers and before the values which are not numbers, and it does not equal to any number
+  ASSERT_EQ(index.GetDistinctValues(0), (std::vector<std::string>{"-1", "2", "nan", "abc"}));
+  ASSERT_EQ(index.GetRowsByValue(0, "nan"), (std::vector<uint64_t>{0, 3}));
+  ASSERT_EQ(index.GetRowsByValue(0, "2"), (std::vector<uint64_t>{1, 5}));
+  ASSERT_EQ(index.GetRowsByValue(0, "-1"), (std::vector<uint64_t>{4}));
+  ASSERT_TRUE(index.GetRowsByValue(0, "0").empty());
+}
+
+TEST_F(TestShardBinaryIndex, TestOpenBrokenFile) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBinaryIndex open broken file");
+  std::vector<ShardBinaryIndex::Row> rows(4, ShardBinaryIndex::Row{0, 0, 0, 0, 0, 0, 0});
+  std::vector<std::vector<std::string>> values(4, std::vector<std::string>{"1"});
+  ASSERT_TRUE(ShardBinaryIndex::Write(kIndexFile, "imagenet.shard01", rows, {{"label_0", true}}, values).IsOk());
+
+  // truncate the value pool
+  std::ifstream in(kIndexFile, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(kIndexFile, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size() - 8);
+  out.close();
+
+  ShardBinaryIndex index;
+  ASSERT_FALSE(index.Open(kIndexFile).IsOk());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_blob_codec.h"
+#include "ut_common.h"
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardBlobCodec : public UT::Common {
+ public:
+  TestShardBlobCodec() {}
+};
+
+TEST_F(TestShardBlobCodec, TestZlibRoundTrip) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBlobCodec zlib round trip");
+  std::vector<uint8_t> blob;
+  for (int i = 0; i < 4096; ++i) {
+    blob.push_back(static_cast<uint8_t>(i % 16));
+  }
+  std::vector<uint8_t> compressed;
+  ASSERT_TRUE(ShardBlobCodec::Compress(kBlobCompressionZlib, blob, &compressed).IsOk());
+  ASSERT_LT(compressed.size(), blob.size());
+
+  std::vector<uint8_t> uncompressed;
+  ASSERT_TRUE(ShardBlobCodec::Decompress(compressed.data(), compressed.size(), &uncompressed).IsOk());
+  ASSERT_EQ(uncompressed, blob);
+
+  // a raw size larger than the payload can hold is reported without allocating it
+  std::vector<uint8_t> corrupt = compressed;
+  uint64_t raw_size = UINT64_MAX / 2;
+  (void)memcpy(corrupt.data(), &raw_size, sizeof(uint64_t));
+  ASSERT_FALSE(ShardBlobCodec::Decompress(corrupt.data(), corrupt.size(), &uncompressed).IsOk());
+
+  // a broken payload is reported
+  compressed[compressed.size() / 2] ^= 0xff;
+  compressed.pop_back();
+  ASSERT_FALSE(ShardBlobCodec::Decompress(compressed.data(), compressed.size(), &uncompressed).IsOk());
+}
+
+TEST_F(TestShardBlobCodec, TestStoredBlob) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBlobCodec stores incompressible and empty blobs");
+  // the blob does not get smaller, it is stored as it is
+  std::vector<uint8_t> blob = {7, 1, 250, 33};
+  std::vector<uint8_t> compressed;
+  ASSERT_TRUE(ShardBlobCodec::Compress(kBlobCompressionZlib, blob, &compressed).IsOk());
+  ASSERT_EQ(compressed.size(), blob.size() + sizeof(uint64_t) + 1);
+  std::vector<uint8_t> uncompressed;
+  ASSERT_TRUE(ShardBlobCodec::Decompress(compressed.data(), compressed.size(), &uncompressed).IsOk());
+  ASSERT_EQ(uncompressed, blob);
+
+  ASSERT_TRUE(ShardBlobCodec::Compress(kBlobCompressionZlib, {}, &compressed).IsOk());
+  ASSERT_TRUE(ShardBlobCodec::Decompress(compressed.data(), compressed.size(), &uncompressed).IsOk());
+  ASSERT_TRUE(uncompressed.empty());
+
+  ASSERT_FALSE(ShardBlobCodec::CheckCodec("lz4").IsOk());
+  ASSERT_FALSE(ShardBlobCodec::Compress("lz4", blob, &compressed).IsOk());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_raw_codec.h"
+#include "ut_common.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardRawCodec : public UT::Common {
+ public:
+  TestShardRawCodec() {}
+
+  std::shared_ptr<Schema> BuildSchema() {
+    json schema_content = R"({"file_name": {"type": "string"},
+                              "label": {"type": "int32"},
+                              "id": {"type": "int64"},
+                              "score": {"type": "float32"},
+                              "weight": {"type": "float64"},
+                              "data": {"type": "bytes"},
+                              "mask": {"type": "int32", "shape": [-1]}})"_json;
+    return Schema::Build("test raw codec", schema_content);
+  }
+};
+
+TEST_F(TestShardRawCodec, TestTypedRoundTrip) {
+  MS_LOG(INFO) << FormatInfo("Test ShardRawCodec typed encoding round trip");
+  ShardRawCodec codec(BuildSchema());
+  json row = R"({"file_name": "001.jpg", "label": -7, "id": 12345678901, "score": 0.1, "weight": -2.5})"_json;
+  std::vector<uint8_t> record;
+  codec.Encode(row, &record);
+  ASSERT_TRUE(ShardRawCodec::IsTyped(record.data(), record.size()));
+  // marker, version, 4 + 8 + 8 + 8 bytes of numbers, 4 bytes of length and the string
+  ASSERT_EQ(record.size(), 2 + 28 + 4 + 7);
+
+  json decoded;
+  ASSERT_TRUE(codec.Decode(record.data(), record.size(), &decoded).IsOk());
+  ASSERT_EQ(decoded, row);
+  ASSERT_EQ(decoded["score"].get<double>(), 0.1);
+  ASSERT_TRUE(decoded["label"].is_number_integer());
+
+  // a truncated record is reported instead of read out of range
+  ASSERT_FALSE(codec.Decode(record.data(), record.size() - 1, &decoded).IsOk());
+}
+
+TEST_F(TestShardRawCodec, TestMsgpackCompatible) {
+  MS_LOG(INFO) << FormatInfo("Test ShardRawCodec reads and falls back to msgpack");
+  ShardRawCodec codec(BuildSchema());
+  json row = R"({"file_name": "001.jpg", "label": 1, "id": 2, "score": 0.5, "weight": 1.5})"_json;
+
+  // records written by older versions
+  std::vector<uint8_t> old_record = json::to_msgpack(row);
+  json decoded;
+  ASSERT_TRUE(codec.Decode(old_record.data(), old_record.size(), &decoded).IsOk());
+  ASSERT_EQ(decoded, row);
+
+  // rows which do not match the schema are kept in msgpack
+  std::vector<json> mismatched_rows = {
+    R"({"file_name": "001.jpg", "label": 1, "id": 2, "score": 0.5})"_json,
+    R"({"file_name": "001.jpg", "label": 1, "id": 2, "score": 0.5, "weight": 1.5, "extra": 1})"_json,
+    R"({"file_name": "001.jpg", "label": 1, "id": 2, "score": 1, "weight": 1.5})"_json,
+    R"({"file_name": "001.jpg", "label": 4294967296, "id": 2, "score": 0.5, "weight": 1.5})"_json,
+    R"({"file_name": 1, "label": 1, "id": 2, "score": 0.5, "weight": 1.5})"_json, kDummyId};
+  for (const auto &mismatched : mismatched_rows) {
+    std::vector<uint8_t> record;
+    codec.Encode(mismatched, &record);
+    ASSERT_FALSE(ShardRawCodec::IsTyped(record.data(), record.size()));
+    ASSERT_TRUE(codec.Decode(record.data(), record.size(), &decoded).IsOk());
+    ASSERT_EQ(decoded, mismatched);
+  }
+
+  std::vector<uint8_t> broken = {0xde, 0x00};
+  ASSERT_FALSE(codec.Decode(broken.data(), broken.size(), &decoded).IsOk());
+}
+TEST_F(TestShardRawCodec, TestDecodeSelectedColumns) {
+  MS_LOG(INFO) << FormatInfo("Test ShardRawCodec decodes the selected columns only");
+  ShardRawCodec codec(BuildSchema());
+  json row = R"({"file_name": "001.jpg", "label": -7, "id": 12345678901, "score": 0.1, "weight": -2.5})"_json;
+  std::vector<std::string> columns = {"weight", "file_name", "label", "data"};
+  json expected = R"({"file_name": "001.jpg", "label": -7, "weight": -2.5})"_json;
+
+  std::vector<uint8_t> record;
+  codec.Encode(row, &record);
+  ASSERT_TRUE(ShardRawCodec::IsTyped(record.data(), record.size()));
+  json decoded;
+  ASSERT_TRUE(codec.Decode(record.data(), record.size(), columns, &decoded).IsOk());
+  ASSERT_EQ(decoded, expected);
+  ASSERT_FALSE(codec.Decode(record.data(), record.size() - 1, columns, &decoded).IsOk());
+
+  // the same columns are selected from the records written by older versions
+  std::vector<uint8_t> old_record = json::to_msgpack(row);
+  ASSERT_TRUE(codec.Decode(old_record.data(), old_record.size(), columns, &decoded).IsOk());
+  ASSERT_EQ(decoded, expected);
+
+  // all the columns are decoded if none is selected
+  ASSERT_TRUE(codec.Decode(record.data(), record.size(), {}, &decoded).IsOk());
+  ASSERT_EQ(decoded, row);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
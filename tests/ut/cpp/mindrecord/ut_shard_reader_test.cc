@@ -24,6 +24,7 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -39,10 +40,27 @@ class TestShardReader : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string index_name = std::string("./imagenet.shard0") + std::to_string(i) + kBinaryIndexSuffix;
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(index_name));
     }
   }
+
+  std::vector<std::vector<std::tuple<std::vector<uint8_t>, json>>> ReadAll(
+    const std::vector<std::string> &column_list, const std::vector<std::shared_ptr<ShardOperator>> &ops = {}) {
+    std::vector<std::vector<std::tuple<std::vector<uint8_t>, json>>> rows;
+    ShardReader dataset;
+    EXPECT_TRUE(dataset.Open({"./imagenet.shard01"}, true, 4, column_list, ops).IsOk());
+    EXPECT_TRUE(dataset.Launch().IsOk());
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      rows.push_back(x);
+    }
+    dataset.Close();
+    return rows;
+  }
 };
 
 TEST_F(TestShardReader, TestShardReaderGeneral) {
@@ -239,5 +257,119 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with memory mapped files");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  ShardReader stream_reader;
+  ASSERT_TRUE(stream_reader.Open({file_name}, true, 4, column_list).IsOk());
+  ASSERT_FALSE(stream_reader.GetMmapMode());
+  stream_reader.Launch();
+
+  ShardReader mmap_reader;
+  mmap_reader.SetMmapMode(true);
+  ASSERT_TRUE(mmap_reader.Open({file_name}, true, 4, column_list).IsOk());
+  ASSERT_TRUE(mmap_reader.GetMmapMode());
+  mmap_reader.Launch();
+
+  uint32_t count = 0;
+  while (true) {
+    auto x = stream_reader.GetNext();
+    auto y = mmap_reader.GetNext();
+    ASSERT_EQ(x.size(), y.size());
+    if (x.empty()) break;
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_EQ(std::get<0>(x[i]), std::get<0>(y[i]));
+      ASSERT_EQ(std::get<1>(x[i]), std::get<1>(y[i]));
+    }
+    count++;
+  }
+  ASSERT_TRUE(count == 10);
+  stream_reader.Close();
+  mmap_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderMmapView) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet views of memory mapped files");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  ShardReader stream_reader;
+  ASSERT_TRUE(stream_reader.Open({file_name}, true, 1, column_list).IsOk());
+  ASSERT_TRUE(stream_reader.Launch(true).IsOk());
+
+  ShardReader mmap_reader;
+  mmap_reader.SetMmapMode(true);
+  ASSERT_TRUE(mmap_reader.Open({file_name}, true, 1, column_list).IsOk());
+  ASSERT_TRUE(mmap_reader.Launch(true).IsOk());
+  mmap_reader.PrefetchByIds({0, 1, 2});
+
+  std::vector<std::shared_ptr<ShardMappedFile>> holders;
+  for (int64_t task_id = 0; task_id < 10; task_id++) {
+    auto content = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask,
+                                                  std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    ASSERT_TRUE(stream_reader.GetNextById(task_id, 0, &content).IsOk());
+    auto view = std::make_shared<TASK_CONTENT_VIEW>(TaskType::kCommonTask,
+                                                    std::vector<std::tuple<ShardBlobView, json>>());
+    ASSERT_TRUE(mmap_reader.GetNextViewById(task_id, 0, &view).IsOk());
+    ASSERT_EQ(content->second.size(), view->second.size());
+    for (size_t i = 0; i < view->second.size(); i++) {
+      const auto &blob = std::get<0>(content->second[i]);
+      const auto &blob_view = std::get<0>(view->second[i]);
+      ASSERT_NE(blob_view.holder, nullptr);
+      ASSERT_EQ(std::vector<uint8_t>(blob_view.data, blob_view.data + blob_view.size), blob);
+      ASSERT_EQ(std::get<1>(content->second[i]), std::get<1>(view->second[i]));
+      holders.push_back(blob_view.holder);
+    }
+  }
+  stream_reader.Close();
+  mmap_reader.Close();
+
+  // the views keep the mapping alive after the reader is closed
+  for (const auto &holder : holders) {
+    ASSERT_NE(holder->GetData(), nullptr);
+  }
+}
+
+TEST_F(TestShardReader, TestShardReaderBinaryIndex) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with and without binary index");
+  for (int i = 1; i <= 4; i++) {
+    ASSERT_TRUE(std::ifstream(std::string("./imagenet.shard0") + std::to_string(i) + kBinaryIndexSuffix).good());
+  }
+  // the columns are all index fields or some of them are only in the raw page
+  std::vector<std::vector<std::string>> column_lists = {{"file_name", "label"}, {"file_name"}, {}};
+  std::vector<std::vector<std::vector<std::tuple<std::vector<uint8_t>, json>>>> with_index;
+  for (const auto &column_list : column_lists) {
+    with_index.push_back(ReadAll(column_list));
+  }
+
+  std::vector<std::pair<std::string, std::string>> categories = {{"label", "257"}, {"label", "302"}};
+  std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardCategory>(categories)};
+  auto category_with_index = ReadAll({"file_name", "label"}, ops);
+  ASSERT_FALSE(category_with_index.empty());
+
+  for (int i = 1; i <= 4; i++) {
+    remove(common::SafeCStr(std::string("./imagenet.shard0") + std::to_string(i) + kBinaryIndexSuffix));
+  }
+  for (size_t i = 0; i < column_lists.size(); ++i) {
+    ASSERT_EQ(with_index[i], ReadAll(column_lists[i]));
+  }
+  ASSERT_EQ(category_with_index, ReadAll({"file_name", "label"}, ops));
+}
+
+TEST_F(TestShardReader, TestShardReaderStaleBinaryIndex) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with a binary index of another file");
+  std::string index_name = std::string("./imagenet.shard01") + kBinaryIndexSuffix;
+  // an index which does not belong to the file is ignored
+  std::vector<ShardBinaryIndex::Row> rows(1, ShardBinaryIndex::Row{0, 0, 0, 0, 0, 0, 0});
+  ASSERT_TRUE(ShardBinaryIndex::Write(index_name, "imagenet.shard02", rows, {}, {{}}).IsOk());
+  ASSERT_EQ(ReadAll({"file_name"}).size(), 10);
+
+  // an index whose rows do not match the file is ignored
+  ASSERT_TRUE(ShardBinaryIndex::Write(index_name, "imagenet.shard01", rows, {}, {{}}).IsOk());
+  ASSERT_EQ(ReadAll({"file_name"}).size(), 10);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -143,6 +143,26 @@ HandleRcExit $? 0 0
 DestroySession $session_id
 HandleRcExit $? 1 1
 
+# Share a cache across two sessions, it stays until the last of them is destroyed
+GetSession
+HandleRcExit $? 1 1
+export SESSION_ID=$session_id
+GetSession
+HandleRcExit $? 1 1
+export SESSION_ID2=$session_id
+
+PytestCmd "test_cache_map.py" "test_cache_map_shared_sessions1"
+HandleRcExit $? 0 0
+
+DestroySession $SESSION_ID
+HandleRcExit $? 1 1
+
+PytestCmd "test_cache_map.py" "test_cache_map_shared_sessions2"
+HandleRcExit $? 0 0
+
+DestroySession $SESSION_ID2
+HandleRcExit $? 1 1
+
 # Run two parallel pipelines (sharing cache)
 for i in $(seq 1 2)
 do
@@ -245,6 +245,47 @@ class TestAutotuneSaveLoad:
 
         ds.config.set_seed(original_seed)
 
+    @staticmethod
+    def test_autotune_scaled_decode_pipeline(tmp_path):
+        """
+        Feature: Autotuning
+        Description: Test save final config with ImageFolder pipeline of Decode followed by Resize,
+            when the JPEG images are decoded at a reduced scale
+        Expectation: Decode is saved with its parameters, and the final config is loaded and run successfully
+        """
+        original_autotune = ds.config.get_enable_autotune()
+        original_scaled_decode = ds.config.get_enable_jpeg_scaled_decode()
+        ds.config.set_enable_autotune(True, str(tmp_path / "test_autotune_scaled_decode_atfinal"))
+        ds.config.set_enable_jpeg_scaled_decode(True)
+
+        data1 = ds.ImageFolderDataset(DATA_DIR, shuffle=False, decode=False, num_samples=5)
+        data1 = data1.map(operations=[vision.Decode(), vision.Resize((32, 48))], input_columns=["image"])
+
+        for _ in data1.create_dict_iterator(num_epochs=1, output_numpy=True):
+            pass
+
+        ds.config.set_enable_autotune(original_autotune)
+
+        file = tmp_path / ("test_autotune_scaled_decode_atfinal_" + os.environ['RANK_ID'] + ".json")
+        assert validate_jsonfile(file)
+        with file.open() as f:
+            out_json = json.load(f)
+        map_node = out_json["tree"]
+        while map_node["op_type"] != "Map":
+            map_node = map_node["children"][0]
+        decode = map_node["operations"][0]
+        assert decode["tensor_op_name"] == "Decode"
+        assert decode["tensor_op_params"] == {"rgb": True}
+
+        desdata = ds.deserialize(json_filepath=str(file))
+        num = 0
+        for item in desdata.create_dict_iterator(num_epochs=1, output_numpy=True):
+            assert item["image"].shape == (32, 48, 3)
+            num += 1
+        assert num == 5
+
+        ds.config.set_enable_jpeg_scaled_decode(original_scaled_decode)
+
     @staticmethod
     def test_autotune_pipeline_pyfunc(tmp_path):
         """
@@ -300,6 +341,56 @@ class TestAutotuneSaveLoad:
         ds.config.set_enable_autotune(original_autotune)
         ds.config.set_seed(original_seed)
 
+    @staticmethod
+    @pytest.mark.parametrize("memory_budget", [1024 * 1024, 0])
+    def test_autotune_model_budget(tmp_path, memory_budget):
+        """
+        Feature: Autotuning
+        Description: Test the model-based AutoTune with a memory and CPU budget, or with a CPU budget only, for
+            pipeline: Generator -> Map -> Batch, which runs a single epoch
+        Expectation: Pipeline runs successfully, and the model fitted within the epoch is saved with the tuned
+            configuration which fits in the budget
+        """
+        original_autotune = ds.config.get_enable_autotune()
+        original_memory_budget = ds.config.get_autotune_memory_budget()
+        original_cpu_budget = ds.config.get_autotune_cpu_budget()
+        original_interval = ds.config.get_monitor_sampling_interval()
+        ds.config.set_enable_autotune(True, str(tmp_path / "test_autotune_model_budget_atfinal"))
+        ds.config.set_autotune_budget(memory_budget, 4)
+        ds.config.set_monitor_sampling_interval(10)
+
+        def busy(x):
+            y = np.zeros((64, 64), np.float32)
+            for _ in range(20):
+                y = y @ y + 1.0
+            return x + y[0, 0] * 0
+
+        source = [(np.ones((64, 64), np.float32) * x,) for x in range(800)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=busy, input_columns=["data"], num_parallel_workers=8)
+        data1 = data1.batch(4)
+
+        num = 0
+        for _ in data1.create_dict_iterator(num_epochs=1, output_numpy=True):
+            num += 1
+        assert num == 200
+
+        ds.config.set_monitor_sampling_interval(original_interval)
+        ds.config.set_autotune_budget(original_memory_budget, original_cpu_budget if original_cpu_budget else None)
+        ds.config.set_enable_autotune(original_autotune)
+
+        file = tmp_path / ("test_autotune_model_budget_atfinal_" + os.environ['RANK_ID'] + ".json")
+        assert validate_jsonfile(file)
+        with file.open() as f:
+            out_json = json.load(f)
+        model = out_json["model"]
+        assert model["num_fits"] >= 1
+        assert model["memory_budget"] == memory_budget
+        assert model["cpu_budget"] == 4
+        if memory_budget > 0:
+            assert model["predicted_memory"] <= memory_budget
+        assert sum(op["num_parallel_workers"] for op in model["ops"]) <= 4
+
     @staticmethod
     def test_autotune_warning_with_offload(tmp_path, capfd):
         """
@@ -1,4 +1,4 @@
-# Copyright 2020-2022 Huawei Technologies Co., Ltd
+# Copyright 2020-2023 Huawei Technologies Co., Ltd
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -2404,6 +2404,87 @@ def test_cache_map_interrupt_and_rerun():
     logger.info("test_cache_map_interrupt_and_rerun Ended.\n")
 
 
+def build_shared_sessions_pipeline(session_id):
+    """
+    Create the pipeline shared by test_cache_map_shared_sessions1 and test_cache_map_shared_sessions2
+    """
+    some_cache = ds.DatasetCache(session_id=session_id, size=0, shared=True)
+    # This DATA_DIR only has 2 images in it
+    ds1 = ds.ImageFolderDataset(dataset_dir=DATA_DIR, shuffle=False)
+    decode_op = c_vision.Decode()
+    ds1 = ds1.map(input_columns=["image"], operations=decode_op, cache=some_cache)
+    return some_cache, ds1
+
+
+@pytest.mark.skipif(os.environ.get('RUN_CACHE_TEST') != 'TRUE', reason="Require to bring up cache server")
+def test_cache_map_shared_sessions1():
+    """
+    Feature: DatasetCache op
+    Description: Test two sessions sharing a cache, the pipelines below the cache are the same
+
+       Cache
+         |
+     Map(Decode)
+         |
+     ImageFolder
+
+    Expectation: The second session reads the rows cached by the first one, and the output is the same
+    """
+    logger.info("Test cache map shared sessions 1")
+    if "SESSION_ID" in os.environ and "SESSION_ID2" in os.environ:
+        session_id = int(os.environ['SESSION_ID'])
+        session_id2 = int(os.environ['SESSION_ID2'])
+    else:
+        raise RuntimeError("Testcase requires SESSION_ID and SESSION_ID2 environment variable")
+
+    cache1, ds1 = build_shared_sessions_pipeline(session_id)
+    images1 = [row["image"] for row in ds1.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    assert len(images1) == 2
+    assert cache1.get_stat().num_mem_cached == 2
+
+    cache2, ds2 = build_shared_sessions_pipeline(session_id2)
+    # The cache is created when the tree is launched, and it is full already before any row is fetched
+    iter2 = ds2.create_dict_iterator(num_epochs=1, output_numpy=True)
+    assert cache2.get_stat().num_mem_cached == 2
+    images2 = [row["image"] for row in iter2]
+    assert len(images2) == 2
+    for image1, image2 in zip(images1, images2):
+        np.testing.assert_array_equal(image1, image2)
+    assert cache2.get_stat().num_mem_cached == 2
+    logger.info("test_cache_map_shared_sessions1 Ended.\n")
+
+
+@pytest.mark.skipif(os.environ.get('RUN_CACHE_TEST') != 'TRUE', reason="Require to bring up cache server")
+def test_cache_map_shared_sessions2():
+    """
+    Feature: DatasetCache op
+    Description: Test a shared cache after the session which has built it is destroyed (run after
+        test_cache_map_shared_sessions1)
+
+       Cache
+         |
+     Map(Decode)
+         |
+     ImageFolder
+
+    Expectation: The cache is still used by the other session, and its rows are served without building it again
+    """
+    logger.info("Test cache map shared sessions 2")
+    if "SESSION_ID2" in os.environ:
+        session_id2 = int(os.environ['SESSION_ID2'])
+    else:
+        raise RuntimeError("Testcase requires SESSION_ID2 environment variable")
+
+    cache2, ds2 = build_shared_sessions_pipeline(session_id2)
+    iter2 = ds2.create_dict_iterator(num_epochs=1, output_numpy=True)
+    assert cache2.get_stat().num_mem_cached == 2
+    num_iter = 0
+    for _ in iter2:
+        num_iter += 1
+    assert num_iter == 2
+    logger.info("test_cache_map_shared_sessions2 Ended.\n")
+
+
 @pytest.mark.skipif(os.environ.get('RUN_CACHE_TEST') != 'TRUE', reason="Require to bring up cache server")
 def test_cache_map_dataset_size1():
     """
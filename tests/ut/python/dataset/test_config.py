@@ -18,6 +18,7 @@ Testing configuration manager
 import os
 import filecmp
 import glob
+import tempfile
 import numpy as np
 import pytest
 
@@ -603,6 +604,154 @@ def test_error_samples_mode():
     assert "set_error_samples_mode() takes 1 positional argument but 2 were given" in str(error_info.value)
 
 
+def test_enable_jpeg_scaled_decode():
+    """
+    Feature: Test the set_enable_jpeg_scaled_decode and get_enable_jpeg_scaled_decode functions
+    Description: Set valid and invalid values
+    Expectation: The value is set, and error is raised for invalid input
+    """
+    origin_enable = config.get_enable_jpeg_scaled_decode()
+    assert origin_enable is False
+    config.set_enable_jpeg_scaled_decode(True)
+    assert config.get_enable_jpeg_scaled_decode() is True
+
+    config_error_func(config.set_enable_jpeg_scaled_decode, 1, TypeError, "enable must be a boolean dtype")
+    config.set_enable_jpeg_scaled_decode(origin_enable)
+
+
+def test_io_prefetch_depth():
+    """
+    Feature: Test the set_io_prefetch_depth and get_io_prefetch_depth functions
+    Description: Set a valid depth and invalid depths
+    Expectation: The depth is set, and error is raised for invalid input
+    """
+    origin_depth = config.get_io_prefetch_depth()
+    assert origin_depth == 0
+    config.set_io_prefetch_depth(16)
+    assert config.get_io_prefetch_depth() == 16
+
+    config_error_func(config.set_io_prefetch_depth, True, TypeError, "depth must be of type int")
+    config_error_func(config.set_io_prefetch_depth, 1.5, TypeError, "depth must be of type int")
+    config_error_func(config.set_io_prefetch_depth, -1, ValueError, "depth should be in range")
+    config_error_func(config.set_io_prefetch_depth, 2147483648, ValueError, "depth should be in range")
+    config.set_io_prefetch_depth(origin_depth)
+
+
+def test_batch_buffer_pool_size():
+    """
+    Feature: Test the set_batch_buffer_pool_size and get_batch_buffer_pool_size functions
+    Description: Set a valid size and invalid sizes
+    Expectation: The size is set, and error is raised for invalid input
+    """
+    origin_size = config.get_batch_buffer_pool_size()
+    assert origin_size == 0
+    config.set_batch_buffer_pool_size(8)
+    assert config.get_batch_buffer_pool_size() == 8
+
+    config_error_func(config.set_batch_buffer_pool_size, True, TypeError, "size must be of type int")
+    config_error_func(config.set_batch_buffer_pool_size, "8", TypeError, "size must be of type int")
+    config_error_func(config.set_batch_buffer_pool_size, -1, ValueError, "size should be in range")
+    config_error_func(config.set_batch_buffer_pool_size, 2147483648, ValueError, "size should be in range")
+    config.set_batch_buffer_pool_size(origin_size)
+
+
+def test_shuffle_spill():
+    """
+    Feature: Test the set_shuffle_spill, get_shuffle_spill_mem_limit and get_shuffle_spill_dir functions
+    Description: Set a valid memory limit with and without the spill directory, and invalid inputs
+    Expectation: The memory limit and directory are set, and error is raised for invalid input
+    """
+    origin_mem_limit = config.get_shuffle_spill_mem_limit()
+    origin_dir = config.get_shuffle_spill_dir()
+    assert origin_mem_limit == 0
+    config.set_shuffle_spill(1024 * 1024, "./")
+    assert config.get_shuffle_spill_mem_limit() == 1024 * 1024
+    assert config.get_shuffle_spill_dir() == os.path.realpath("./")
+    config.set_shuffle_spill(2048)
+    assert config.get_shuffle_spill_mem_limit() == 2048
+    assert config.get_shuffle_spill_dir() == os.path.realpath(tempfile.gettempdir())
+
+    config_error_func(config.set_shuffle_spill, True, TypeError, "mem_limit must be of type int")
+    config_error_func(config.set_shuffle_spill, 1.5, TypeError, "mem_limit must be of type int")
+    config_error_func(config.set_shuffle_spill, -1, ValueError, "mem_limit should not be less than 0")
+    with pytest.raises(TypeError) as error_info:
+        config.set_shuffle_spill(1024, 1)
+    assert "spill_dir must be of type str" in str(error_info.value)
+    config.set_shuffle_spill(origin_mem_limit, origin_dir if origin_dir else None)
+
+
+def test_autotune_budget():
+    """
+    Feature: Test the set_autotune_budget, get_autotune_memory_budget and get_autotune_cpu_budget functions
+    Description: Set a valid memory budget with and without the CPU budget, and invalid inputs
+    Expectation: The budgets are set, and error is raised for invalid input
+    """
+    origin_memory_budget = config.get_autotune_memory_budget()
+    origin_cpu_budget = config.get_autotune_cpu_budget()
+    assert origin_memory_budget == 0
+    assert origin_cpu_budget == 0
+    config.set_autotune_budget(1024 * 1024 * 1024, 8)
+    assert config.get_autotune_memory_budget() == 1024 * 1024 * 1024
+    assert config.get_autotune_cpu_budget() == 8
+    config.set_autotune_budget(4096)
+    assert config.get_autotune_memory_budget() == 4096
+    assert config.get_autotune_cpu_budget() == 0
+
+    config_error_func(config.set_autotune_budget, True, TypeError, "memory_budget must be of type int")
+    config_error_func(config.set_autotune_budget, 1.5, TypeError, "memory_budget must be of type int")
+    config_error_func(config.set_autotune_budget, -1, ValueError, "memory_budget should not be less than 0")
+    with pytest.raises(TypeError) as error_info:
+        config.set_autotune_budget(1024, "8")
+    assert "cpu_budget must be of type int" in str(error_info.value)
+    with pytest.raises(ValueError) as error_info:
+        config.set_autotune_budget(1024, 0)
+    assert "cpu_budget given is not within the required range" in str(error_info.value)
+    config.set_autotune_budget(origin_memory_budget)
+
+
+def test_graph_csr_store_dir():
+    """
+    Feature: Test the set_graph_csr_store_dir and get_graph_csr_store_dir functions
+    Description: Set a valid directory, disable the store with None and an empty string, and set invalid input
+    Expectation: The directory is set, and error is raised for invalid input
+    """
+    origin_dir = config.get_graph_csr_store_dir()
+    assert origin_dir == ""
+    config.set_graph_csr_store_dir("./")
+    assert config.get_graph_csr_store_dir() == os.path.realpath("./")
+    config.set_graph_csr_store_dir(None)
+    assert config.get_graph_csr_store_dir() == ""
+    config.set_graph_csr_store_dir("./")
+    config.set_graph_csr_store_dir("")
+    assert config.get_graph_csr_store_dir() == ""
+
+    config_error_func(config.set_graph_csr_store_dir, 1, TypeError, "store_dir must be of type str")
+    config_error_func(config.set_graph_csr_store_dir, True, TypeError, "store_dir must be of type str")
+    config.set_graph_csr_store_dir(origin_dir)
+
+
+def test_numa_partition():
+    """
+    Feature: Test the set_numa_partition and get_numa_partition functions
+    Description: Enable and disable the NUMA partitioned mode, and set invalid input
+    Expectation: The mode is set, the pipeline gives the same rows, and error is raised for invalid input
+    """
+    origin_numa_partition = config.get_numa_partition()
+    assert not origin_numa_partition
+    data = ds.GeneratorDataset([(np.array([i]),) for i in range(20)], ["col"], shuffle=False)
+    data = data.map(lambda x: x * 2, input_columns=["col"], num_parallel_workers=4, python_multiprocessing=False)
+    config.set_numa_partition(True)
+    assert config.get_numa_partition()
+    assert [item[0][0] for item in data.create_tuple_iterator(num_epochs=1, output_numpy=True)] == \
+           [i * 2 for i in range(20)]
+    config.set_numa_partition(False)
+    assert not config.get_numa_partition()
+
+    config_error_func(config.set_numa_partition, 1, TypeError, "numa_partition must be of type bool")
+    config_error_func(config.set_numa_partition, "True", TypeError, "numa_partition must be of type bool")
+    config.set_numa_partition(origin_numa_partition)
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -621,3 +770,10 @@ if __name__ == '__main__':
     test_fast_recovery()
     test_debug_mode_error_case()
     test_error_samples_mode()
+    test_enable_jpeg_scaled_decode()
+    test_io_prefetch_depth()
+    test_batch_buffer_pool_size()
+    test_shuffle_spill()
+    test_autotune_budget()
+    test_graph_csr_store_dir()
+    test_numa_partition()
@@ -136,6 +136,49 @@ def test_batch_padding_05():
                                                      [[100, 101, 102], [-2, -2, -2]]])
 
 
+def test_batch_padding_pooled_buffer():
+    """
+    Feature: Batch Padding
+    Description: Test batch and batch padding with rows assembled in pooled buffers, including a string column, a
+        column truncated in one dimension and a batch of a single row
+    Expectation: Output is the same as the output when the buffers are not pooled
+    """
+
+    def gen_mixed_cols(num):
+        for i in range(num):
+            yield (np.array([j for j in range(i % 3 + 1)]), np.array([[i + 100], [i + 200]], dtype=np.float32),
+                   np.array(["s" + str(i)]))
+
+    def run_pipeline():
+        res = []
+        data1 = ds.GeneratorDataset((lambda: gen_mixed_cols(7)), ["col1", "col2", "col3"], shuffle=False)
+        data1 = data1.padded_batch(batch_size=3, drop_remainder=False,
+                                   pad_info={"col1": (None, -1), "col2": ([1, 2], -2), "col3": (None, "")})
+        data1 = data1.repeat(2)
+        for data in data1.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            res.append([col.copy() for col in data])
+        data2 = ds.GeneratorDataset((lambda: gen_2cols(5)), ["col1d", "col2d"], shuffle=False)
+        data2 = data2.batch(batch_size=2, num_parallel_workers=2).repeat(3)
+        for data in data2.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            res.append([col.copy() for col in data])
+        return res
+
+    pool_size_original = ds.config.get_batch_buffer_pool_size()
+    ds.config.set_batch_buffer_pool_size(0)
+    expected = run_pipeline()
+    ds.config.set_batch_buffer_pool_size(2)
+    result = run_pipeline()
+    ds.config.set_batch_buffer_pool_size(pool_size_original)
+
+    assert len(result) == len(expected)
+    for row, expected_row in zip(result, expected):
+        assert len(row) == len(expected_row)
+        for col, expected_col in zip(row, expected_row):
+            assert col.dtype == expected_col.dtype
+            np.testing.assert_array_equal(col, expected_col)
+    np.testing.assert_array_equal(result[0][1], [[[100, -2]], [[101, -2]], [[102, -2]]])
+
+
 def batch_padding_performance_3d():
     data1 = ds.Cifar10Dataset(CIFAR10_DIR, shuffle=False)  # shape = [32,32,3]
     data1 = data1.repeat(24)
@@ -257,6 +300,7 @@ if __name__ == '__main__':
     test_batch_padding_03()
     test_batch_padding_04()
     test_batch_padding_05()
+    test_batch_padding_pooled_buffer()
     # batch_padding_performance_3d()
     # batch_padding_performance_1d()
     # batch_pyfunc_padding_3d()
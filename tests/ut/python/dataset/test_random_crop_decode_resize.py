@@ -15,6 +15,9 @@
 """
 Testing RandomCropDecodeResize op in DE
 """
+import os
+
+import numpy as np
 import pytest
 
 from mindspore import log as logger
@@ -101,7 +104,59 @@ def test_random_crop_decode_resize_invalid():
     assert "not of type (<class 'int'>,)" in str(error_info.value)
 
 
+def test_random_crop_decode_resize_scaled_decode():
+    """
+    Feature: RandomCropDecodeResize op
+    Description: Test RandomCropDecodeResize op, and Decode op followed by Resize op, with JPEG scaled decoding,
+        with the default pipeline and with the optional IR optimization passes enabled
+    Expectation: Output has the same shape as and is close to the output of decoding at full resolution
+    """
+    original_scaled_decode = ds.config.get_enable_jpeg_scaled_decode()
+    original_optimize = os.environ.pop("OPTIMIZE", None)
+    ds.config.set_enable_jpeg_scaled_decode(True)
+    try:
+        # The scaled decoding must not depend on the optional passes, which only run with OPTIMIZE=true
+        for optimize in [None, "true"]:
+            if optimize is not None:
+                os.environ["OPTIMIZE"] = optimize
+            for size in [(32, 64), 48]:
+                data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+                data1 = data1.map(operations=[vision.Decode(), vision.Resize(size)], input_columns=["image"])
+                data2 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+                data2 = data2.map(operations=vision.Decode(), input_columns=["image"])
+                data2 = data2.map(operations=vision.Resize(size), input_columns=["image"])
+                num_iter = 0
+                num_scaled = 0
+                for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                                        data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+                    assert item1["image"].shape == item2["image"].shape
+                    assert diff_mse(item1["image"], item2["image"]) < 1
+                    # The 2268x4032 images are decoded at 1/8 scale, which differs from the full resolution decoding
+                    num_scaled += int(not np.array_equal(item1["image"], item2["image"]))
+                    num_iter += 1
+                assert num_iter == 3
+                assert num_scaled == 3
+
+            data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+            data1 = data1.map(operations=vision.RandomCropDecodeResize((32, 64), (1, 1), (0.5, 0.5)),
+                              input_columns=["image"])
+            data2 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["image"], shuffle=False)
+            data2 = data2.map(operations=vision.Decode(), input_columns=["image"])
+            data2 = data2.map(operations=vision.RandomResizedCrop((32, 64), (1, 1), (0.5, 0.5)),
+                              input_columns=["image"])
+            for item1, item2 in zip(data1.create_dict_iterator(num_epochs=1, output_numpy=True),
+                                    data2.create_dict_iterator(num_epochs=1, output_numpy=True)):
+                assert item1["image"].shape == (32, 64, 3)
+                assert diff_mse(item1["image"], item2["image"]) < 1
+    finally:
+        os.environ.pop("OPTIMIZE", None)
+        if original_optimize is not None:
+            os.environ["OPTIMIZE"] = original_optimize
+        ds.config.set_enable_jpeg_scaled_decode(original_scaled_decode)
+
+
 if __name__ == "__main__":
     test_random_crop_decode_resize_op(plot=True)
     test_random_crop_decode_resize_md5()
     test_random_crop_decode_resize_invalid()
+    test_random_crop_decode_resize_scaled_decode()
@@ -15,6 +15,8 @@
 """
 Testing the random horizontal flip op in DE
 """
+import os
+
 import numpy as np
 import pytest
 
@@ -386,6 +388,38 @@ def test_random_horizontal_flip_video_op_precision_pipeline_c():
         assert mse < 0.001
 
 
+def test_random_horizontal_flip_after_batch_c():
+    """
+    Feature: RandomHorizontalFlip op
+    Description: Test RandomHorizontalFlip op in a map right after a batch operation, with the default pipeline
+        and with the optional IR optimization passes enabled
+    Expectation: Each image of a batch is either flipped or left as is, on its own
+    """
+    logger.info("Test RandomHorizontalFlip after batch")
+    original_seed = config_get_set_seed(0)
+    original_optimize = os.environ.pop("OPTIMIZE", None)
+    images = np.arange(32 * 2 * 5 * 3, dtype=np.uint8).reshape([32, 2, 5, 3])
+    try:
+        # The batch mode must not depend on the optional passes, which only run with OPTIMIZE=true
+        for optimize in [None, "true"]:
+            if optimize is not None:
+                os.environ["OPTIMIZE"] = optimize
+            dataset = ds.NumpySlicesDataset(images, column_names=["image"], shuffle=False)
+            dataset = dataset.batch(32)
+            dataset = dataset.map(operations=vision.RandomHorizontalFlip(0.5), input_columns=["image"])
+            num_flipped = 0
+            for item in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+                assert item["image"].shape == images.shape
+                for image, flipped in zip(images, item["image"]):
+                    assert np.array_equal(flipped, image) or np.array_equal(flipped, image[:, ::-1, :])
+                    num_flipped += int(np.array_equal(flipped, image[:, ::-1, :]))
+            assert 0 < num_flipped < 32
+    finally:
+        os.environ.pop("OPTIMIZE", None)
+        if original_optimize is not None:
+            os.environ["OPTIMIZE"] = original_optimize
+        ds.config.set_seed(original_seed)
+
 if __name__ == "__main__":
     test_random_horizontal_op(plot=True)
     test_random_horizontal_valid_prob_c()
@@ -400,3 +434,4 @@ if __name__ == "__main__":
     test_random_horizontal_flip_video_op_5d_c()
     test_random_horizontal_flip_video_op_precision_eager_c()
     test_random_horizontal_flip_video_op_precision_pipeline_c()
+    test_random_horizontal_flip_after_batch_c()
@@ -15,6 +15,7 @@
 """
 Testing dataset pipeline failover Reset
 """
+import json
 import os
 import numpy as np
 import pytest
@@ -573,6 +574,48 @@ def test_reset_nonmappable():
     ds.config.set_fast_recovery(original_fast_recovery)
 
 
+def test_restore_pipeline_state():
+    """
+    Feature: Dataset recovery
+    Description: Restore an iterator to the pipeline state got in the middle of an epoch of a shuffled pipeline
+    Expectation: The restored iterator produces the rows after the pipeline state
+    """
+    original_seed = ds.config.get_seed()
+    original_fast_recovery = ds.config.get_fast_recovery()
+    ds.config.set_seed(1)
+    ds.config.set_fast_recovery(True)
+
+    source = [(np.array([x])) for x in range(10)]
+    data1 = ds.NumpySlicesDataset(source, ["data"], sampler=ds.SequentialSampler())
+    data1 = data1.shuffle(3)
+    num_epochs = 3
+
+    for state_point in [0, 4, 10, 13, 29]:
+        itr = data1.create_tuple_iterator(num_epochs=num_epochs, output_numpy=True)
+        num_rows = 0
+        state = itr._get_pipeline_state()  # pylint: disable=W0212
+        expected = []
+        for _ in range(num_epochs):
+            for d in itr:
+                num_rows += 1
+                if num_rows > state_point:
+                    expected.append(d)
+                if num_rows == state_point:
+                    state = itr._get_pipeline_state()  # pylint: disable=W0212
+
+        itr2 = data1.create_tuple_iterator(num_epochs=num_epochs, output_numpy=True)
+        itr2._restore(state)  # pylint: disable=W0212
+        restored = []
+        # the state after the last row of an epoch is still in the epoch
+        for _ in range(num_epochs - json.loads(state)["epoch"]):
+            for d in itr2:
+                restored.append(d)
+        np.testing.assert_array_equal(expected, restored)
+
+    ds.config.set_seed(original_seed)
+    ds.config.set_fast_recovery(original_fast_recovery)
+
+
 if __name__ == "__main__":
     test_reset_np()
     test_reset_cifar1()
@@ -586,3 +629,4 @@ if __name__ == "__main__":
     test_reset_sampler(ds.RandomSampler())
     test_reset_batch(False)
     test_reset_nonmappable()
+    test_restore_pipeline_state()
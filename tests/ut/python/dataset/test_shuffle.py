@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
+import tempfile
 import numpy as np
 import mindspore.dataset as ds
 from mindspore import log as logger
@@ -158,6 +160,49 @@ def test_shuffle_06():
     ds.config.set_seed(original_seed)
 
 
+def test_shuffle_spill():
+    """
+    Feature: Shuffle op
+    Description: Test shuffle op with a shuffle buffer spilled to disk over 2 epochs, including a string column
+    Expectation: Output is equal to that of the shuffle op keeping the buffer in memory, and the spill directory is
+        left empty
+    """
+    logger.info("test_shuffle_spill")
+    original_seed = config_get_set_seed(1)
+    original_mem_limit = ds.config.get_shuffle_spill_mem_limit()
+    original_dir = ds.config.get_shuffle_spill_dir()
+
+    images = np.random.randint(0, 255, (2000, 64, 32), dtype=np.uint8)
+    labels = np.arange(2000, dtype=np.int32)
+    texts = np.array([str(i) * (i % 5 + 1) for i in range(2000)])
+
+    def run_pipeline():
+        data = ds.NumpySlicesDataset((images, labels, texts), ["image", "label", "text"], shuffle=False)
+        data = data.shuffle(buffer_size=1500)
+        itr = data.create_tuple_iterator(num_epochs=2, output_numpy=True)
+        rows = [[row for row in itr] for _ in range(2)]
+        # the shuffle op removes its spilled rows once the pipeline is terminated
+        itr.stop()
+        return rows
+
+    expected = run_pipeline()
+    with tempfile.TemporaryDirectory() as spill_dir:
+        ds.config.set_shuffle_spill(256 * 1024, spill_dir)
+        result = run_pipeline()
+        assert not os.listdir(spill_dir)
+
+    assert [row[1] for row in expected[0]] != [row[1] for row in expected[1]]
+    for epoch, expected_epoch in zip(result, expected):
+        assert len(epoch) == 2000
+        for row, expected_row in zip(epoch, expected_epoch):
+            np.testing.assert_array_equal(row[0], expected_row[0])
+            np.testing.assert_array_equal(row[1], expected_row[1])
+            np.testing.assert_array_equal(row[2], expected_row[2])
+
+    ds.config.set_shuffle_spill(original_mem_limit, original_dir if original_dir else None)
+    ds.config.set_seed(original_seed)
+
+
 def test_shuffle_exception_01():
     """
     Feature: Shuffle op
@@ -297,6 +342,7 @@ if __name__ == '__main__':
     test_shuffle_04()
     test_shuffle_05()
     test_shuffle_06()
+    test_shuffle_spill()
     test_shuffle_exception_01()
     test_shuffle_exception_02()
     test_shuffle_exception_03()
@@ -16,6 +16,7 @@
 Testing WordpieceTokenizer op in DE
 """
 import numpy as np
+import pytest
 import mindspore.dataset as ds
 from mindspore import log as logger
 import mindspore.dataset.text as text
@@ -159,6 +160,51 @@ def test_wordpiece_tokenizer_with_offsets():
         check_wordpiece_tokenizer_with_offsets(**paras)
 
 
+def check_wordpiece_tokenizer_output_ids(first, last, expect_str, expected_offsets_start, expected_offsets_limit,
+                                         vocab_list, unknown_token='[UNK]', max_bytes_per_token=100):
+    dataset = ds.TextFileDataset(WORDPIECE_TOKENIZER_FILE, shuffle=False)
+    if first > 1:
+        dataset = dataset.skip(first - 1)
+    if last >= first:
+        dataset = dataset.take(last - first + 1)
+    vocab = text.Vocab.from_list(vocab_list, special_tokens=[unknown_token])
+    tokenizer_op = text.WordpieceTokenizer(vocab=vocab, with_offsets=True, unknown_token=unknown_token,
+                                           max_bytes_per_token=max_bytes_per_token, output_ids=True)
+    dataset = dataset.map(operations=tokenizer_op, input_columns=['text'],
+                          output_columns=['token', 'offsets_start', 'offsets_limit'])
+    count = 0
+    for i in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        expected_ids = vocab.tokens_to_ids(expect_str[count])
+        np.testing.assert_array_equal(i['token'], expected_ids)
+        assert i['token'].dtype == np.int32
+        np.testing.assert_array_equal(i['offsets_start'], expected_offsets_start[count])
+        np.testing.assert_array_equal(i['offsets_limit'], expected_offsets_limit[count])
+        count = count + 1
+
+
+def test_wordpiece_tokenizer_output_ids():
+    """
+    Feature: WordpieceTokenizer
+    Description: Test WordpieceTokenizer by setting output_ids to True
+    Expectation: Output is the ids of the expected tokens, and an unknown_token not in the vocab is rejected
+    """
+    for paras in test_paras:
+        if paras.get('unknown_token', '[UNK]'):
+            check_wordpiece_tokenizer_output_ids(**paras)
+
+    vocab = text.Vocab.from_list(vocab_english)
+    with pytest.raises(TypeError) as error_info:
+        text.WordpieceTokenizer(vocab=vocab, output_ids=1)
+    assert "output_ids" in str(error_info.value)
+    dataset = ds.TextFileDataset(WORDPIECE_TOKENIZER_FILE, shuffle=False)
+    dataset = dataset.map(operations=text.WordpieceTokenizer(vocab=vocab, output_ids=True))
+    with pytest.raises(RuntimeError) as error_info:
+        for _ in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+            pass
+    assert "unknown_token" in str(error_info.value)
+
+
 if __name__ == '__main__':
     test_wordpiece_tokenizer_default()
     test_wordpiece_tokenizer_with_offsets()
+    test_wordpiece_tokenizer_output_ids()
@@ -90,6 +90,54 @@ def test_write_read_process():
     remove_one_file("{}.db".format(mindrecord_file_name))
 
 
+def test_write_read_process_with_blob_compression():
+    """
+    Feature: FileWriter
+    Description: write the blob of samples compressed by zlib, read it by FileReader and MindPage
+    Expectation: the samples are the same as the written ones
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    remove_one_file(mindrecord_file_name)
+    remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
+
+    data = [{"file_name": "{:03d}.jpg".format(i), "label": i % 3,
+             "mask": np.arange(i, i + 64, dtype=np.int64),
+             "data": bytes("image bytes " * (i + 1), encoding='UTF-8')} for i in range(10)]
+    writer = FileWriter(mindrecord_file_name)
+    with pytest.raises(Exception):
+        writer.set_blob_compression("lz4")
+    writer.set_blob_compression("zlib")
+    schema = {"file_name": {"type": "string"},
+              "label": {"type": "int32"},
+              "mask": {"type": "int64", "shape": [-1]},
+              "data": {"type": "bytes"}}
+    writer.add_schema(schema, "data is so cool")
+    writer.add_index(["label"])
+    writer.write_raw_data(data)
+    writer.commit()
+
+    reader = FileReader(mindrecord_file_name)
+    count = 0
+    for x in reader.get_next():
+        assert x["file_name"] == data[count]["file_name"]
+        assert x["data"] == data[count]["data"]
+        assert (x["mask"] == data[count]["mask"]).all()
+        count = count + 1
+    assert count == 10
+    reader.close()
+
+    reader = MindPage(mindrecord_file_name)
+    reader.category_field = "label"
+    row = reader.read_at_page_by_id(1, 0, 1)
+    assert len(row) == 1
+    assert row[0]["data"] == data[1]["data"]
+
+    remove_one_file(mindrecord_file_name)
+    remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
+
+
 def test_write_read_process_with_define_index_field():
     mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
     remove_one_file(mindrecord_file_name)